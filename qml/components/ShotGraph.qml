@@ -39,17 +39,13 @@ ChartView {
     margins.left: Theme.scaled(40)
     margins.right: Theme.scaled(55)
 
-    // Register goal/marker LineSeries with C++ model (infrequent updates, replace() is fine)
+    // Register goal/marker series with C++ model (segmented, append-only updates)
     Component.onCompleted: {
         ShotDataModel.registerSeries(
-            [pressureGoal1, pressureGoal2, pressureGoal3, pressureGoal4, pressureGoal5],
-            [flowGoal1, flowGoal2, flowGoal3, flowGoal4, flowGoal5],
-            temperatureGoalSeries,
-            extractionStartMarker, stopMarker,
-            [frameMarker1, frameMarker2, frameMarker3, frameMarker4, frameMarker5,
-             frameMarker6, frameMarker7, frameMarker8, frameMarker9, frameMarker10]
+            pressureGoal, flowGoal, temperatureGoalSeries,
+            extractionStartMarker, stopMarker, frameMarkers
         )
-        // Register fast renderers (QSGGeometryNode, pre-allocated VBO - no rebuilds)
+        // Register the live series drawn by liveLines (chunked, append-only updates)
         ShotDataModel.registerFastSeries(
             pressureRenderer, flowRenderer, temperatureRenderer,
             weightRenderer, weightFlowRenderer, resistanceRenderer,
@@ -151,174 +147,163 @@ ChartView {
         visible: false
     }
 
-    // === PHASE MARKER LINES ===
-
+    // Empty anchor series to keep the axes registered with ChartView (no data
+    // goes through Qt Charts; required for axis min/max properties to update
+    // correctly and for the pressure axis grid/labels to be drawn)
     LineSeries {
-        id: extractionStartMarker
         name: ""
-        color: Theme.accentColor
-        width: Theme.scaled(2)
-        style: Qt.DashDotLine
         axisX: timeAxis
         axisY: pressureAxis
     }
 
     LineSeries {
-        id: stopMarker
         name: ""
-        color: Theme.stopMarkerColor
-        width: Theme.scaled(2)
-        style: Qt.DashDotLine
-        axisX: timeAxis
-        axisY: pressureAxis
-    }
-
-    LineSeries { id: frameMarker1; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker2; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker3; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker4; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker5; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker6; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker7; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker8; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker9; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-    LineSeries { id: frameMarker10; name: ""; color: Theme.frameMarkerColor; width: Theme.scaled(1); style: Qt.DotLine; axisX: timeAxis; axisY: pressureAxis }
-
-    // === GOAL LINES (dashed) - Multiple segments for clean breaks ===
-
-    // Pressure goal segments (up to 5 segments for mode switches)
-    LineSeries { id: pressureGoal1; name: ""; color: Theme.pressureGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showPressure }
-    LineSeries { id: pressureGoal2; name: ""; color: Theme.pressureGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showPressure }
-    LineSeries { id: pressureGoal3; name: ""; color: Theme.pressureGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showPressure }
-    LineSeries { id: pressureGoal4; name: ""; color: Theme.pressureGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showPressure }
-    LineSeries { id: pressureGoal5; name: ""; color: Theme.pressureGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showPressure }
-
-    // Flow goal segments (up to 5 segments for mode switches)
-    LineSeries { id: flowGoal1; name: ""; color: Theme.flowGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showFlow }
-    LineSeries { id: flowGoal2; name: ""; color: Theme.flowGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showFlow }
-    LineSeries { id: flowGoal3; name: ""; color: Theme.flowGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showFlow }
-    LineSeries { id: flowGoal4; name: ""; color: Theme.flowGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showFlow }
-    LineSeries { id: flowGoal5; name: ""; color: Theme.flowGoalColor; width: Theme.scaled(2); style: Qt.DashLine; axisX: timeAxis; axisY: pressureAxis; visible: chart.showFlow }
-
-    LineSeries {
-        id: temperatureGoalSeries
-        name: "T Goal"
-        color: Theme.temperatureGoalColor
-        width: Theme.scaled(2)
-        style: Qt.DashLine
         axisX: timeAxis
         axisYRight: tempAxis
-        visible: chart.showTemperature
     }
 
-    // Empty anchor series to keep the weight axis registered with ChartView
-    // (required for weightAxis min/max properties to update correctly)
     LineSeries {
         name: ""
         axisX: timeAxis
         axisYRight: weightAxis
     }
 
-    // === ACTUAL LINES (solid) - FastLineRenderer with pre-allocated VBO ===
-    // These render outside Qt Charts via QSGGeometryNode for zero-copy GPU updates
+    // === LIVE LINES - one FastMultiLineRenderer for markers, goals and actuals ===
+    // Drawn outside Qt Charts as chunked, append-only scene graph geometry; all
+    // series share one material so the renderer merges them into a single batch.
+    // Series draw in declaration order: markers, then goals, then actual lines.
 
-    FastLineRenderer {
-        id: pressureRenderer
+    FastMultiLineRenderer {
+        id: liveLines
         x: chart.plotArea.x; y: chart.plotArea.y
         width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.pressureColor
-        lineWidth: Theme.scaled(3)
         minX: timeAxis.min; maxX: timeAxis.max
-        minY: pressureAxis.min; maxY: pressureAxis.max
-        visible: chart.showPressure
-    }
 
-    FastLineRenderer {
-        id: flowRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.flowColor
-        lineWidth: Theme.scaled(3)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: pressureAxis.min; maxY: pressureAxis.max
-        visible: chart.showFlow
-    }
+        // Phase marker lines (each marker is one segment)
+        FastSegmentSeries {
+            id: extractionStartMarker
+            color: Theme.accentColor
+            lineWidth: Theme.scaled(2)
+            style: Qt.DashDotLine
+            minY: pressureAxis.min; maxY: pressureAxis.max
+        }
 
-    FastLineRenderer {
-        id: temperatureRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.temperatureColor
-        lineWidth: Theme.scaled(3)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: tempAxis.min; maxY: tempAxis.max
-        visible: chart.showTemperature
-    }
+        FastSegmentSeries {
+            id: stopMarker
+            color: Theme.stopMarkerColor
+            lineWidth: Theme.scaled(2)
+            style: Qt.DashDotLine
+            minY: pressureAxis.min; maxY: pressureAxis.max
+        }
 
-    FastLineRenderer {
-        id: weightFlowRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.weightFlowColor
-        lineWidth: Theme.scaled(2)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: pressureAxis.min; maxY: pressureAxis.max
-        visible: chart.showWeightFlow
-    }
+        FastSegmentSeries {
+            id: frameMarkers
+            color: Theme.frameMarkerColor
+            lineWidth: Theme.scaled(1)
+            style: Qt.DotLine
+            minY: pressureAxis.min; maxY: pressureAxis.max
+        }
 
-    FastLineRenderer {
-        id: resistanceRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.resistanceColor
-        lineWidth: Theme.scaled(2)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: pressureAxis.min; maxY: pressureAxis.max
-        visible: chart.showResistance && chart.advancedMode
-    }
+        // Goal lines (dashed) - a new segment on every pump-mode switch
+        FastSegmentSeries {
+            id: pressureGoal
+            color: Theme.pressureGoalColor
+            lineWidth: Theme.scaled(2)
+            style: Qt.DashLine
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showPressure
+        }
 
-    FastLineRenderer {
-        id: conductanceRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.conductanceColor
-        lineWidth: Theme.scaled(2)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: pressureAxis.min; maxY: pressureAxis.max
-        visible: chart.showConductance && chart.advancedMode
-    }
+        FastSegmentSeries {
+            id: flowGoal
+            color: Theme.flowGoalColor
+            lineWidth: Theme.scaled(2)
+            style: Qt.DashLine
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showFlow
+        }
 
-    FastLineRenderer {
-        id: darcyResistanceRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.darcyResistanceColor
-        lineWidth: Theme.scaled(2)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: pressureAxis.min; maxY: pressureAxis.max
-        visible: chart.showDarcyResistance && chart.advancedMode
-    }
+        FastSegmentSeries {
+            id: temperatureGoalSeries
+            color: Theme.temperatureGoalColor
+            lineWidth: Theme.scaled(2)
+            style: Qt.DashLine
+            minY: tempAxis.min; maxY: tempAxis.max
+            visible: chart.showTemperature
+        }
 
-    FastLineRenderer {
-        id: temperatureMixRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.temperatureMixColor
-        lineWidth: Theme.scaled(2)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: tempAxis.min; maxY: tempAxis.max
-        visible: chart.showTemperatureMix && chart.advancedMode
-    }
+        // Actual lines (solid)
+        FastLineSeries {
+            id: pressureRenderer
+            color: Theme.pressureColor
+            lineWidth: Theme.scaled(3)
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showPressure
+        }
 
-    FastLineRenderer {
-        id: weightRenderer
-        x: chart.plotArea.x; y: chart.plotArea.y
-        width: chart.plotArea.width; height: chart.plotArea.height
-        color: Theme.weightColor
-        lineWidth: Theme.scaled(3)
-        minX: timeAxis.min; maxX: timeAxis.max
-        minY: weightAxis.min; maxY: weightAxis.max
-        visible: chart.showWeight
+        FastLineSeries {
+            id: flowRenderer
+            color: Theme.flowColor
+            lineWidth: Theme.scaled(3)
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showFlow
+        }
+
+        FastLineSeries {
+            id: temperatureRenderer
+            color: Theme.temperatureColor
+            lineWidth: Theme.scaled(3)
+            minY: tempAxis.min; maxY: tempAxis.max
+            visible: chart.showTemperature
+        }
+
+        FastLineSeries {
+            id: weightFlowRenderer
+            color: Theme.weightFlowColor
+            lineWidth: Theme.scaled(2)
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showWeightFlow
+        }
+
+        FastLineSeries {
+            id: resistanceRenderer
+            color: Theme.resistanceColor
+            lineWidth: Theme.scaled(2)
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showResistance && chart.advancedMode
+        }
+
+        FastLineSeries {
+            id: conductanceRenderer
+            color: Theme.conductanceColor
+            lineWidth: Theme.scaled(2)
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showConductance && chart.advancedMode
+        }
+
+        FastLineSeries {
+            id: darcyResistanceRenderer
+            color: Theme.darcyResistanceColor
+            lineWidth: Theme.scaled(2)
+            minY: pressureAxis.min; maxY: pressureAxis.max
+            visible: chart.showDarcyResistance && chart.advancedMode
+        }
+
+        FastLineSeries {
+            id: temperatureMixRenderer
+            color: Theme.temperatureMixColor
+            lineWidth: Theme.scaled(2)
+            minY: tempAxis.min; maxY: tempAxis.max
+            visible: chart.showTemperatureMix && chart.advancedMode
+        }
+
+        FastLineSeries {
+            id: weightRenderer
+            color: Theme.weightColor
+            lineWidth: Theme.scaled(3)
+            minY: weightAxis.min; maxY: weightAxis.max
+            visible: chart.showWeight
+        }
     }
 
     // Frame marker labels
@@ -124,7 +124,7 @@ ChartView {
         axisYRight: tempAxis
     }
 
-    // === LIVE DATA — FastLineRenderer (pre-allocated VBO) ===
+    // === LIVE DATA — FastLineRenderer (chunked, append-only VBOs) ===
 
     FastLineRenderer {
         id: pressureRenderer
@@ -274,6 +274,41 @@ Page {
         }
     }
 
+    // Live puck-integrity warnings (LiveShotAnalysis) reuse the transition pill
+    Connections {
+        target: MainController.liveShotAnalysis
+        function onChannelingDetected(severity, spikeTimeSec) {
+            _showLiveWarning(severity === "sustained"
+                ? TranslationManager.translate("espresso.live.channelingSustained", "Channeling")
+                : TranslationManager.translate("espresso.live.channelingTransient", "Channel spike"),
+                severity === "sustained" ? Theme.errorColor : Theme.warningColor)
+        }
+        function onGrindIssueDetected(direction, flowDeltaMlPerSec) {
+            var text = direction === "chokedPuck"
+                ? TranslationManager.translate("espresso.live.chokedPuck", "Choking — grind coarser")
+                : direction === "tooFine"
+                    ? TranslationManager.translate("espresso.live.tooFine", "Running slow — grind coarser")
+                    : TranslationManager.translate("espresso.live.tooCoarse", "Running fast — grind finer")
+            _showLiveWarning(text, Theme.warningColor)
+        }
+        function onPourNotPressurizingDetected(peakPressureBar) {
+            _showLiveWarning(TranslationManager.translate("espresso.live.notPressurizing", "Not building pressure"),
+                             Theme.errorColor)
+        }
+    }
+
+    function _showLiveWarning(text, color) {
+        frameTransitionLifecycle.stop()
+        frameTransitionLabel.text = text
+        frameTransitionPill.color = color
+        frameTransitionPill.opacity = 1
+        frameTransitionPill.scale = 1.0
+        frameTransitionLifecycle.start()
+        if (accessibilityEnabled()) {
+            AccessibilityManager.announce(text)
+        }
+    }
+
     function _transitionText(reason) {
         switch (reason) {
             case "weight": return TranslationManager.translate("espresso.transition.weight", "Weight exit")
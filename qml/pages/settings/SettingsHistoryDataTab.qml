@@ -973,7 +973,7 @@ KeyboardAwareContainer {
             importCompletePopup.open()
 
             // Refresh profiles list
-            ProfileManager.refreshProfiles()
+            ProfileManager.refreshProfilesInBackground()
         }
 
         function onConnectionFailed(error) {
@@ -601,7 +601,11 @@ KeyboardAwareContainer {
                                 accessibleLabel: TranslationManager.translate("settings.preferences.darkTheme", "Dark theme")
                                 model: Settings.theme.themeNames
                                 currentIndex: Math.max(0, Settings.theme.themeNames.indexOf(Settings.theme.darkThemeName))
-                                onActivated: Settings.theme.applyDarkTheme(Settings.theme.themeNames[currentIndex])
+                                onActivated: {
+                                    Settings.beginTransaction("applyDarkTheme")
+                                    Settings.theme.applyDarkTheme(Settings.theme.themeNames[currentIndex])
+                                    Settings.commitTransaction()
+                                }
                             }
                         }
 
@@ -625,7 +629,11 @@ KeyboardAwareContainer {
                                 accessibleLabel: TranslationManager.translate("settings.preferences.lightTheme", "Light theme")
                                 model: Settings.theme.themeNames
                                 currentIndex: Math.max(0, Settings.theme.themeNames.indexOf(Settings.theme.lightThemeName))
-                                onActivated: Settings.theme.applyLightTheme(Settings.theme.themeNames[currentIndex])
+                                onActivated: {
+                                    Settings.beginTransaction("applyLightTheme")
+                                    Settings.theme.applyLightTheme(Settings.theme.themeNames[currentIndex])
+                                    Settings.commitTransaction()
+                                }
                             }
                         }
                     }
@@ -361,7 +361,12 @@ KeyboardAwareContainer {
                                         anchors.top: parent.top
                                         anchors.bottom: parent.bottom
                                         anchors.right: deleteBtn.visible ? deleteBtn.left : parent.right
-                                        onClicked: Settings.theme.applyPresetTheme(modelData.name)
+                                        onClicked: {
+                                            // One round of binding updates for the whole theme switch
+                                            Settings.beginTransaction("applyPresetTheme")
+                                            Settings.theme.applyPresetTheme(modelData.name)
+                                            Settings.commitTransaction()
+                                        }
                                     }
 
                                     Row {
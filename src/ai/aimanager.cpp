@@ -9,6 +9,7 @@
 #include "../profile/profile.h"
 #include "../network/visualizeruploader.h"
 #include "../history/shothistorystorage.h"
+#include "../history/shotrecordcache.h"
 
 #include <QNetworkAccessManager>
 #include <QStandardPaths>
@@ -369,7 +370,7 @@ void AIManager::setShotHistoryStorage(ShotHistoryStorage* storage)
 // to reduce lambda nesting. NOT safe to call from the main thread (would conflict
 // with the primary DB connection).
 static QList<QPair<qint64, QVariantMap>> loadQualifiedShots(
-    const QString& dbPath,
+    const QString& dbPath, ShotRecordCache* cache,
     const QString& beanBrand, const QString& beanType,
     const QString& profileName, int excludeShotId)
 {
@@ -446,8 +447,8 @@ static QList<QPair<qint64, QVariantMap>> loadQualifiedShots(
 
             QVariantMap fullShot;
             try {
-                ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, c.id);
-                fullShot = ShotHistoryStorage::convertShotRecord(record);
+                const auto record = ShotHistoryStorage::loadShotRecordCached(db, c.id, cache);
+                fullShot = ShotHistoryStorage::convertShotRecord(*record);
             } catch (const std::exception& e) {
                 qWarning() << "  Shot id=" << c.id << "-> SKIPPED (exception:" << e.what() << ")";
                 continue;
@@ -480,6 +481,7 @@ void AIManager::requestRecentShotContext(const QString& beanBrand, const QString
     }
 
     const QString dbPath = m_shotHistory->databasePath();
+    auto cache = m_shotHistory->recordCache();
     QPointer<AIManager> self(this);
     ++m_contextSerial;
     int serial = m_contextSerial;
@@ -488,8 +490,8 @@ void AIManager::requestRecentShotContext(const QString& beanBrand, const QString
     // event loop. The background thread captures `self` by value but MUST NOT dereference
     // it. All dereferences occur inside the QueuedConnection callback, which runs on the
     // main thread where QPointer's tracking is valid.
-    QThread* thread = QThread::create([self, dbPath, beanBrand, beanType, profileName, excludeShotId, serial]() {
-        auto qualifiedShots = loadQualifiedShots(dbPath, beanBrand, beanType, profileName, excludeShotId);
+    QThread* thread = QThread::create([self, dbPath, cache, beanBrand, beanType, profileName, excludeShotId, serial]() {
+        auto qualifiedShots = loadQualifiedShots(dbPath, cache.get(), beanBrand, beanType, profileName, excludeShotId);
 
         // Query grinder context on background thread using the shared helper (also used by MCP dialing_get_context)
         GrinderContext grinderCtx;
@@ -17,31 +17,37 @@ QVector<QPointF> fromPressureFlow(const QVector<QPointF>& pressure,
     return out;
 }
 
-QVector<QPointF> derivative(const QVector<QPointF>& conductance)
+namespace {
+
+// Step 1 of derivative(): centered difference scaled ×10 (matches
+// Visualizer.coffee), forward/backward difference at the two edges.
+double rawSlope(const QVector<QPointF>& conductance, qsizetype i)
 {
-    QVector<QPointF> out;
     const qsizetype n = conductance.size();
-    if (n < 3) return out;
-
-    // Step 1: centered difference, scaled ×10 (matches Visualizer.coffee).
-    QVector<double> raw(n, 0.0);
-    for (qsizetype i = 1; i < n - 1; ++i) {
+    if (i > 0 && i < n - 1) {
         const double dt = conductance[i + 1].x() - conductance[i - 1].x();
         if (dt > 0.001) {
             const double dc = conductance[i + 1].y() - conductance[i - 1].y();
-            raw[i] = (dc / dt) * 10.0;
+            return (dc / dt) * 10.0;
         }
+        return 0.0;
     }
-    // Edge values: forward/backward difference.
-    {
-        double dt = conductance[1].x() - conductance[0].x();
+    if (i == 0) {
+        const double dt = conductance[1].x() - conductance[0].x();
         if (dt > 0.001)
-            raw[0] = ((conductance[1].y() - conductance[0].y()) / dt) * 10.0;
-        dt = conductance[n - 1].x() - conductance[n - 2].x();
-        if (dt > 0.001)
-            raw[n - 1] = ((conductance[n - 1].y() - conductance[n - 2].y()) / dt) * 10.0;
+            return ((conductance[1].y() - conductance[0].y()) / dt) * 10.0;
+        return 0.0;
     }
+    const double dt = conductance[n - 1].x() - conductance[n - 2].x();
+    if (dt > 0.001)
+        return ((conductance[n - 1].y() - conductance[n - 2].y()) / dt) * 10.0;
+    return 0.0;
+}
+
+} // namespace
 
+double derivativeAt(const QVector<QPointF>& conductance, qsizetype i)
+{
     // Step 2: 9-point Gaussian kernel (Visualizer.coffee).
     static constexpr double GAUSSIAN[] = {
         0.048297, 0.08393, 0.124548, 0.157829, 0.170793,
@@ -49,25 +55,35 @@ QVector<QPointF> derivative(const QVector<QPointF>& conductance)
     };
     static constexpr qsizetype KERNEL_HALF = 4;
 
-    out.reserve(n);
-    for (qsizetype i = 0; i < n; ++i) {
-        double smoothed = 0.0;
-        double weightSum = 0.0;
-        for (qsizetype k = -KERNEL_HALF; k <= KERNEL_HALF; ++k) {
-            const qsizetype idx = i + k;
-            if (idx >= 0 && idx < n) {
-                const double w = GAUSSIAN[k + KERNEL_HALF];
-                smoothed += raw[idx] * w;
-                weightSum += w;
-            }
+    const qsizetype n = conductance.size();
+    double smoothed = 0.0;
+    double weightSum = 0.0;
+    for (qsizetype k = -KERNEL_HALF; k <= KERNEL_HALF; ++k) {
+        const qsizetype idx = i + k;
+        if (idx >= 0 && idx < n) {
+            const double w = GAUSSIAN[k + KERNEL_HALF];
+            smoothed += rawSlope(conductance, idx) * w;
+            weightSum += w;
         }
-        if (weightSum > 0.0) smoothed /= weightSum;
-        // Clamp to [-5, 19] per Visualizer convention.
-        if (smoothed < -5.0) smoothed = -5.0;
-        else if (smoothed > 19.0) smoothed = 19.0;
-        out.append(QPointF(conductance[i].x(), smoothed));
     }
+    if (weightSum > 0.0) smoothed /= weightSum;
+    // Clamp to [-5, 19] per Visualizer convention.
+    if (smoothed < -5.0) smoothed = -5.0;
+    else if (smoothed > 19.0) smoothed = 19.0;
+    return smoothed;
+}
+
+QVector<QPointF> derivative(const QVector<QPointF>& conductance)
+{
+    QVector<QPointF> out;
+    const qsizetype n = conductance.size();
+    if (n < 3) return out;
 
+    // One code path with the streaming caller (LiveShotAnalysis), so the
+    // live and post-shot curves agree to the last bit.
+    out.reserve(n);
+    for (qsizetype i = 0; i < n; ++i)
+        out.append(QPointF(conductance[i].x(), derivativeAt(conductance, i)));
     return out;
 }
 
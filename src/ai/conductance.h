@@ -38,4 +38,13 @@ QVector<QPointF> fromPressureFlow(const QVector<QPointF>& pressure,
 // transient channeling events invisible in pressure/flow/resistance alone.
 QVector<QPointF> derivative(const QVector<QPointF>& conductance);
 
+// Value of derivative(conductance)[i] computed for a single sample. Callers
+// must have at least 3 samples. The value only depends on samples up to
+// i + DERIVATIVE_LOOKAHEAD, so once conductance.size() > i +
+// DERIVATIVE_LOOKAHEAD it no longer changes as samples are appended — the
+// streaming detectors rely on this to finalise dC/dt a fixed lag behind
+// the live sample.
+double derivativeAt(const QVector<QPointF>& conductance, qsizetype i);
+inline constexpr qsizetype DERIVATIVE_LOOKAHEAD = 5;
+
 } // namespace Conductance
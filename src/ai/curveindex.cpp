@@ -0,0 +1,124 @@
+#include "curveindex.h"
+
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// floor(log2(n)) for n >= 1
+int floorLog2(qsizetype n)
+{
+    return 63 - qCountLeadingZeroBits(static_cast<quint64>(n));
+}
+}
+
+CurveIndex::CurveIndex(const QVector<QPointF>& points)
+    : m_points(points)
+{
+    const qsizetype n = m_points.size();
+    if (n == 0) return;
+
+    m_sum.resize(n + 1);
+    m_sumSq.resize(n + 1);
+    m_sum[0] = m_sumSq[0] = 0.0;
+    for (qsizetype i = 0; i < n; ++i) {
+        const double y = m_points[i].y();
+        m_sum[i + 1] = m_sum[i] + y;
+        m_sumSq[i + 1] = m_sumSq[i] + y * y;
+    }
+
+    const int levels = floorLog2(n) + 1;
+    m_min.resize(levels);
+    m_max.resize(levels);
+    m_min[0].resize(n);
+    m_max[0].resize(n);
+    for (qsizetype i = 0; i < n; ++i)
+        m_min[0][i] = m_max[0][i] = m_points[i].y();
+    for (int k = 1; k < levels; ++k) {
+        const qsizetype half = qsizetype(1) << (k - 1);
+        const qsizetype count = n - (qsizetype(1) << k) + 1;
+        m_min[k].resize(count);
+        m_max[k].resize(count);
+        for (qsizetype i = 0; i < count; ++i) {
+            m_min[k][i] = std::min(m_min[k - 1][i], m_min[k - 1][i + half]);
+            m_max[k][i] = std::max(m_max[k - 1][i], m_max[k - 1][i + half]);
+        }
+    }
+}
+
+CurveIndex::Stats CurveIndex::stats(double t0, double t1) const
+{
+    Stats result;
+    const qsizetype first = firstAtOrAfter(m_points, t0);
+    const qsizetype last = lastAtOrBefore(m_points, t1);
+    if (first > last) return result;
+
+    const qsizetype count = last - first + 1;
+    const double sum = m_sum[last + 1] - m_sum[first];
+    const double sumSq = m_sumSq[last + 1] - m_sumSq[first];
+    result.count = count;
+    result.mean = sum / count;
+    // Cancellation can leave a tiny negative variance on flat windows
+    result.stddev = std::sqrt(std::max(0.0, sumSq / count - result.mean * result.mean));
+    result.min = rangeMin(first, last);
+    result.max = rangeMax(first, last);
+    return result;
+}
+
+double CurveIndex::min(double t0, double t1) const
+{
+    const qsizetype first = firstAtOrAfter(m_points, t0);
+    const qsizetype last = lastAtOrBefore(m_points, t1);
+    return first <= last ? rangeMin(first, last) : 0.0;
+}
+
+double CurveIndex::max(double t0, double t1) const
+{
+    const qsizetype first = firstAtOrAfter(m_points, t0);
+    const qsizetype last = lastAtOrBefore(m_points, t1);
+    return first <= last ? rangeMax(first, last) : 0.0;
+}
+
+double CurveIndex::rangeMin(qsizetype first, qsizetype last) const
+{
+    const int k = floorLog2(last - first + 1);
+    return std::min(m_min[k][first], m_min[k][last - (qsizetype(1) << k) + 1]);
+}
+
+double CurveIndex::rangeMax(qsizetype first, qsizetype last) const
+{
+    const int k = floorLog2(last - first + 1);
+    return std::max(m_max[k][first], m_max[k][last - (qsizetype(1) << k) + 1]);
+}
+
+qsizetype CurveIndex::firstAtOrAfter(const QVector<QPointF>& points, double t)
+{
+    const auto it = std::lower_bound(points.cbegin(), points.cend(), t,
+                                     [](const QPointF& p, double value) { return p.x() < value; });
+    return it - points.cbegin();
+}
+
+qsizetype CurveIndex::lastAtOrBefore(const QVector<QPointF>& points, double t)
+{
+    const auto it = std::upper_bound(points.cbegin(), points.cend(), t,
+                                     [](double value, const QPointF& p) { return value < p.x(); });
+    return (it - points.cbegin()) - 1;
+}
+
+qsizetype CurveIndex::nearest(const QVector<QPointF>& points, double t)
+{
+    if (points.isEmpty()) return -1;
+    const qsizetype after = firstAtOrAfter(points, t);
+    if (after == 0) return 0;
+    if (after < points.size() && points[after].x() - t < t - points[after - 1].x())
+        return after;
+    // The earlier neighbour wins ties; step back to the first of its timestamp
+    return firstAtOrAfter(points, points[after - 1].x());
+}
+
+double CurveIndex::valueAtOrAfter(const QVector<QPointF>& points, double t)
+{
+    if (points.isEmpty()) return 0.0;
+    const qsizetype i = firstAtOrAfter(points, t);
+    return i < points.size() ? points[i].y() : points.last().y();
+}
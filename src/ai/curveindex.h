@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+
+// Read-only index over a time-ordered curve (x = seconds, non-decreasing, as
+// every shot series is). Time lookups are binary searches; window statistics
+// come from prefix sums of y and y² plus a min/max sparse table, so each
+// query is O(1) after an O(n log n) build.
+//
+// Build one when the same curve is queried over many windows (per-phase
+// summaries). A single lookup doesn't need the tables — use the static
+// search helpers on the raw series instead.
+//
+// Windows are closed intervals [t0, t1], matching the linear scans this
+// replaced. A window with no samples reports count 0 and zero statistics.
+class CurveIndex {
+public:
+    struct Stats {
+        qsizetype count = 0;
+        double mean = 0.0;
+        double stddev = 0.0;  // Population standard deviation
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    CurveIndex() = default;
+    explicit CurveIndex(const QVector<QPointF>& points);
+
+    const QVector<QPointF>& points() const { return m_points; }
+    bool isEmpty() const { return m_points.isEmpty(); }
+
+    Stats stats(double t0, double t1) const;
+    double mean(double t0, double t1) const { return stats(t0, t1).mean; }
+    double min(double t0, double t1) const;
+    double max(double t0, double t1) const;
+
+    // Index of the first point with x >= t (points.size() when none).
+    static qsizetype firstAtOrAfter(const QVector<QPointF>& points, double t);
+    // Index of the last point with x <= t (-1 when none).
+    static qsizetype lastAtOrBefore(const QVector<QPointF>& points, double t);
+    // Index of the point closest in time to t, -1 when empty. Ties and
+    // duplicate timestamps resolve to the earliest point.
+    static qsizetype nearest(const QVector<QPointF>& points, double t);
+    // y of the first point at or after t; the last y past the end, 0 when empty.
+    static double valueAtOrAfter(const QVector<QPointF>& points, double t);
+
+private:
+    // Inclusive sample range, first <= last
+    double rangeMin(qsizetype first, qsizetype last) const;
+    double rangeMax(qsizetype first, qsizetype last) const;
+
+    QVector<QPointF> m_points;
+    QVector<double> m_sum;             // m_sum[i] = sum of y over [0, i)
+    QVector<double> m_sumSq;           // Same for y²
+    QVector<QVector<double>> m_min;    // m_min[k][i] = min of y over [i, i + 2^k)
+    QVector<QVector<double>> m_max;
+};
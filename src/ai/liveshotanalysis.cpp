@@ -0,0 +1,628 @@
+#include "liveshotanalysis.h"
+#include "conductance.h"
+#include "curveindex.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr double kOpenEnd = std::numeric_limits<double>::infinity();
+}
+
+LiveShotAnalysis::LiveShotAnalysis(QObject* parent)
+    : QObject(parent)
+{
+}
+
+QString LiveShotAnalysis::severityName(ShotAnalysis::ChannelingSeverity severity)
+{
+    switch (severity) {
+    case ShotAnalysis::ChannelingSeverity::Sustained: return QStringLiteral("sustained");
+    case ShotAnalysis::ChannelingSeverity::Transient: return QStringLiteral("transient");
+    case ShotAnalysis::ChannelingSeverity::None: break;
+    }
+    return QStringLiteral("none");
+}
+
+void LiveShotAnalysis::begin(const QString& beverageType, const QStringList& analysisFlags)
+{
+    m_beverageType = beverageType;
+    m_analysisFlags = analysisFlags;
+    m_nonEspresso = ShotAnalysis::isNonEspressoBeverage(beverageType);
+
+    m_pressure.clear();
+    m_flow.clear();
+    m_conductance.clear();
+    m_pressureGoal.clear();
+    m_flowGoal.clear();
+    m_phases.clear();
+    m_dcdt.clear();
+    m_qualified.clear();
+    m_assembly.clear();
+    m_peakPressure.clear();
+    m_turboFlowSum.clear();
+    m_turboFlowCount.clear();
+    m_qualCursor = 0;
+    m_provisional.clear();
+    m_pourStart = 0.0;
+    m_pourPhaseStart = -1.0;
+    m_flowModeRanges.clear();
+    m_pressureModeRanges.clear();
+    rebuildPourState();
+
+    const bool channelingWasSet = m_liveChanneling != ShotAnalysis::ChannelingSeverity::None;
+    const bool grindWasSet = !m_liveGrindDirection.isEmpty();
+    const bool pourWasSet = m_livePourNotPressurizing;
+    m_liveChanneling = ShotAnalysis::ChannelingSeverity::None;
+    m_liveSpikeTime = 0.0;
+    m_liveGrindDirection.clear();
+    m_liveGrindDelta = 0.0;
+    m_livePourNotPressurizing = false;
+    m_reportedGrindIssues.clear();
+    m_pourNotPressurizingReported = false;
+    if (channelingWasSet) emit channelingChanged();
+    if (grindWasSet) emit grindChanged();
+    if (pourWasSet) emit pourNotPressurizingChanged();
+
+    if (!m_active) {
+        m_active = true;
+        emit activeChanged();
+    }
+}
+
+void LiveShotAnalysis::addPhaseMarker(const HistoryPhaseMarker& marker)
+{
+    if (!m_active) return;
+
+    m_phases.append(marker);
+
+    // Pour start moves with each "infus"/"start"/"pour" marker. Markers
+    // arrive at (or just before) the newest sample, so everything that has
+    // to be re-tallied from the new start is at most a sample or two.
+    const double pourStart = ShotAnalysis::findPourWindow(m_phases, 0.0).pourStart;
+    if (pourStart != m_pourStart) {
+        m_pourStart = pourStart;
+        rebuildPourState();
+    }
+
+    // The live pour-not-pressurizing clock starts at the first frame after
+    // preinfusion. findPourWindow falls back to the preinfusion marker when
+    // no frame is labelled "pour", which would count a long, low-pressure
+    // preinfusion against the puck.
+    const QString label = marker.label.toLower();
+    if (label.contains(QStringLiteral("infus")) || label == QStringLiteral("start"))
+        m_pourPhaseStart = -1.0;
+    else if (label != QStringLiteral("end") && m_pourPhaseStart < 0)
+        m_pourPhaseStart = marker.time;
+
+    m_flowModeRanges = ShotAnalysis::grindFlowModeRanges(m_phases, m_pourStart, kOpenEnd);
+    m_pressureModeRanges = ShotAnalysis::grindPressureModeRanges(m_phases, kOpenEnd);
+    advance();
+}
+
+void LiveShotAnalysis::addSample(double time, double pressure, double flow,
+                                 double pressureGoal, double flowGoal)
+{
+    if (!m_active) return;
+
+    const qsizetype i = m_pressure.size();
+    m_pressure.append(QPointF(time, pressure));
+    m_flow.append(QPointF(time, flow));
+    m_conductance.append(QPointF(time, Conductance::sample(pressure, flow)));
+    if (pressureGoal > 0) m_pressureGoal.append(QPointF(time, pressureGoal));
+    if (flowGoal > 0) m_flowGoal.append(QPointF(time, flowGoal));
+    m_qualified.append(qint8(-1));
+    m_assembly.append(AssemblyState{});
+
+    // Running pour-window prefixes (peak pressure; turbo-check flow average)
+    if (i < m_pourStartIndex) {
+        m_peakPressure.append(0.0);
+        m_turboFlowSum.append(0.0);
+        m_turboFlowCount.append(0);
+    } else {
+        const double prevPeak = i > m_pourStartIndex ? m_peakPressure[i - 1] : 0.0;
+        m_peakPressure.append(pressure > prevPeak ? pressure : prevPeak);
+        double sum = i > m_pourStartIndex ? m_turboFlowSum[i - 1] : 0.0;
+        qsizetype count = i > m_pourStartIndex ? m_turboFlowCount[i - 1] : 0;
+        if (flow > 0.05) { sum += flow; ++count; }
+        m_turboFlowSum.append(sum);
+        m_turboFlowCount.append(count);
+    }
+
+    advance();
+}
+
+void LiveShotAnalysis::rebuildPourState()
+{
+    const qsizetype n = m_pressure.size();
+    m_pourStartIndex = firstAtOrAfter(m_pressure, m_pourStart);
+
+    for (qsizetype i = 0; i < n; ++i) {
+        if (i < m_pourStartIndex) {
+            m_peakPressure[i] = 0.0;
+            m_turboFlowSum[i] = 0.0;
+            m_turboFlowCount[i] = 0;
+            continue;
+        }
+        const double p = m_pressure[i].y();
+        const double f = m_flow[i].y();
+        const double prevPeak = i > m_pourStartIndex ? m_peakPressure[i - 1] : 0.0;
+        m_peakPressure[i] = p > prevPeak ? p : prevPeak;
+        m_turboFlowSum[i] = (i > m_pourStartIndex ? m_turboFlowSum[i - 1] : 0.0) + (f > 0.05 ? f : 0.0);
+        m_turboFlowCount[i] = (i > m_pourStartIndex ? m_turboFlowCount[i - 1] : 0) + (f > 0.05 ? 1 : 0);
+    }
+
+    m_assemblyBegin = firstAtOrAfter(m_pressure, m_pourStart + ShotAnalysis::CHANNELING_DC_POUR_SKIP_SEC);
+    m_assemblyCursor = m_assemblyBegin;
+    m_windows.clear();
+    m_current = {-1.0, -1.0};
+    m_channeling.clear();
+    m_flowGoalTally.clear();
+    m_chokeAllTally.clear();
+    m_chokePressureModeTally.clear();
+    m_provisionalFlowGoalFrom = -1;
+    m_provisionalChokeFrom = -1;
+}
+
+void LiveShotAnalysis::advance()
+{
+    finaliseDerivative();
+    qualify();
+    assembleThrough(m_qualCursor - 1);
+    decideChanneling();
+    tallyGrind();
+    tallyProvisionalGrind();
+    updateLive();
+}
+
+// --- dC/dt ---
+
+void LiveShotAnalysis::finaliseDerivative()
+{
+    const qsizetype n = m_conductance.size();
+    if (n < 3) return;
+    const qsizetype limit = n - Conductance::DERIVATIVE_LOOKAHEAD;
+    while (m_dcdt.size() < limit)
+        m_dcdt.append(Conductance::derivativeAt(m_conductance, m_dcdt.size()));
+}
+
+// --- Channeling windows ---
+
+bool LiveShotAnalysis::flowModeAt(double t) const
+{
+    // Same walk as ShotAnalysis's phaseAtTime (list order, stop at the first
+    // marker past t) — the End marker can land out of time order.
+    const HistoryPhaseMarker* active = &m_phases.first();
+    for (const auto& phase : m_phases) {
+        if (phase.time <= t) active = &phase;
+        else break;
+    }
+    return active->isFlowMode;
+}
+
+LiveShotAnalysis::Readiness LiveShotAnalysis::qualificationReadiness(qsizetype i) const
+{
+    // channelingWindowQualifies() reads pressure and the active goal out to
+    // t + WINDOW_HALF_SEC. Once both series reach that far the answer is
+    // final: later samples only append beyond it.
+    if (m_phases.isEmpty()) return Readiness::Pending;
+    const double t = m_pressure[i].x();
+    const double horizon = t + ShotAnalysis::WINDOW_HALF_SEC;
+    if (m_pressure.last().x() < horizon) return Readiness::Pending;
+    const QVector<QPointF>& goal = flowModeAt(t) ? m_flowGoal : m_pressureGoal;
+    // Goal points only arrive past the newest sample, so a goal that hasn't
+    // started by t - WINDOW_HALF_SEC never covers the look-back.
+    if (goal.isEmpty() || t - ShotAnalysis::WINDOW_HALF_SEC < goal.first().x()
+        || goal.last().x() >= horizon)
+        return Readiness::Final;
+    // The goal stopped short of the horizon (the pump switched mode). It
+    // reads as "no goal" unless the same mode comes back later.
+    return Readiness::Provisional;
+}
+
+bool LiveShotAnalysis::evaluateQualification(qsizetype i) const
+{
+    return !m_phases.isEmpty()
+        && ShotAnalysis::channelingWindowQualifies(m_pressure, m_flow, m_pressureGoal,
+                                                   m_flowGoal, m_phases, m_pressure[i].x());
+}
+
+void LiveShotAnalysis::qualify()
+{
+    resolveProvisional();
+    while (m_qualCursor < m_pressure.size()) {
+        const Readiness readiness = qualificationReadiness(m_qualCursor);
+        if (readiness == Readiness::Pending) break;
+        m_qualified[m_qualCursor] = evaluateQualification(m_qualCursor) ? 1 : 0;
+        if (readiness == Readiness::Provisional)
+            m_provisional.append(m_qualCursor);
+        ++m_qualCursor;
+    }
+}
+
+void LiveShotAnalysis::resolveProvisional()
+{
+    // Provisional samples sit within WINDOW_HALF_SEC of a mode switch, a
+    // handful per switch. If their goal resumes and one turns out to
+    // qualify, assembly rewinds to it.
+    qsizetype flipFrom = -1;
+    for (qsizetype k = 0; k < m_provisional.size();) {
+        const qsizetype i = m_provisional[k];
+        if (qualificationReadiness(i) != Readiness::Final) {
+            ++k;
+            continue;
+        }
+        if (evaluateQualification(i)) {
+            m_qualified[i] = 1;
+            if (flipFrom < 0 || i < flipFrom) flipFrom = i;
+        }
+        m_provisional.removeAt(k);
+    }
+    if (flipFrom >= 0 && flipFrom < m_assemblyCursor)
+        rewindAssembly(flipFrom);
+}
+
+void LiveShotAnalysis::rewindAssembly(qsizetype from)
+{
+    if (from <= m_assemblyBegin) {
+        m_windows.clear();
+        m_current = {-1.0, -1.0};
+        m_assemblyCursor = m_assemblyBegin;
+        m_channeling.clear();
+        return;
+    }
+    const AssemblyState& state = m_assembly[from - 1];
+    m_windows.resize(state.windowCount);
+    if (!m_windows.isEmpty()) m_windows.last().end = state.lastWindowEnd;
+    m_current = state.current;
+    m_assemblyCursor = from;
+
+    // Decisions taken before `from` was assembled never read it.
+    const double t = m_pressure[from].x();
+    const auto firstStale = std::lower_bound(
+        m_channeling.cbegin(), m_channeling.cend(), t,
+        [](const ChannelingTally& tally, double value) { return tally.decidedAt < value; });
+    m_channeling.resize(firstStale - m_channeling.cbegin());
+}
+
+void LiveShotAnalysis::flushWindow(QVector<ShotAnalysis::DetectionWindow>& windows,
+                                   ShotAnalysis::DetectionWindow& current)
+{
+    // Mirrors the flushCurrent lambda in ShotAnalysis::buildChannelingWindows.
+    if (current.start >= 0 && current.end > current.start) {
+        if (!windows.isEmpty()
+            && current.start - windows.last().end <= ShotAnalysis::WINDOW_GAP_MERGE_SEC) {
+            windows.last().end = current.end;
+        } else {
+            windows.append(current);
+        }
+    }
+    current = {-1.0, -1.0};
+}
+
+void LiveShotAnalysis::assembleThrough(qsizetype last)
+{
+    for (; m_assemblyCursor <= last; ++m_assemblyCursor) {
+        const qsizetype i = m_assemblyCursor;
+        const double t = m_pressure[i].x();
+        if (m_qualified[i]) {
+            if (m_current.start < 0) m_current.start = t;
+            m_current.end = t;
+        } else {
+            flushWindow(m_windows, m_current);
+        }
+        m_assembly[i] = {m_windows.size(),
+                         m_windows.isEmpty() ? 0.0 : m_windows.last().end,
+                         m_current};
+    }
+}
+
+bool LiveShotAnalysis::windowsCover(const QVector<ShotAnalysis::DetectionWindow>& windows,
+                                    const ShotAnalysis::DetectionWindow& current, double t)
+{
+    // Membership as if `current` were flushed now (merged into the last
+    // window or appended), without mutating either.
+    bool merged = false;
+    if (current.start >= 0 && current.end > current.start) {
+        if (!windows.isEmpty()
+            && current.start - windows.last().end <= ShotAnalysis::WINDOW_GAP_MERGE_SEC) {
+            merged = true;
+        } else if (t >= current.start && t <= current.end) {
+            return true;
+        }
+    }
+    for (qsizetype w = windows.size() - 1; w >= 0; --w) {
+        const double end = (merged && w == windows.size() - 1) ? current.end : windows[w].end;
+        if (t >= windows[w].start && t <= end) return true;
+        if (end < t) break;
+    }
+    return false;
+}
+
+void LiveShotAnalysis::decideChanneling()
+{
+    if (m_assemblyCursor <= m_assemblyBegin) return;
+
+    // A dC/dt sample at t is settled once assembly has moved more than
+    // WINDOW_GAP_MERGE_SEC past it: any fragment that could still merge back
+    // over t must start within that gap. The one exception is an open
+    // single-time fragment inside the gap — whether it survives depends on
+    // the next sample.
+    const double decidedAt = m_pressure[m_assemblyCursor - 1].x();
+    const bool openSingle = m_current.start >= 0 && !(m_current.end > m_current.start);
+
+    qsizetype i = m_assemblyBegin + m_channeling.size();
+    while (i < m_dcdt.size() && i < m_assemblyCursor) {
+        const double t = m_pressure[i].x();
+        if (decidedAt <= t + ShotAnalysis::WINDOW_GAP_MERGE_SEC) break;
+        if (openSingle && m_current.start <= t + ShotAnalysis::WINDOW_GAP_MERGE_SEC) break;
+
+        ChannelingTally tally = m_channeling.isEmpty() ? ChannelingTally{} : m_channeling.last();
+        tally.decidedAt = decidedAt;
+        if (windowsCover(m_windows, m_current, t)) {
+            const double v = std::abs(m_dcdt[i]);
+            if (v > tally.maxSpike) {
+                tally.maxSpike = v;
+                tally.maxSpikeTime = t;
+            }
+            if (v > ShotAnalysis::CHANNELING_DC_ELEVATED) ++tally.elevated;
+        }
+        m_channeling.append(tally);
+        ++i;
+    }
+}
+
+// --- Grind (flow vs goal + choked puck) ---
+
+bool LiveShotAnalysis::isPhaseClosedAt(double t) const
+{
+    // Range masks are final for every phase but the newest one.
+    return !m_phases.isEmpty() && t < m_phases.last().time;
+}
+
+bool LiveShotAnalysis::inRanges(const QVector<ShotAnalysis::TimeRange>& ranges, double t)
+{
+    for (const auto& r : ranges) {
+        if (r.end > r.start && t >= r.start && t <= r.end) return true;
+    }
+    return false;
+}
+
+void LiveShotAnalysis::stepFlowGoal(FlowGoalTally& acc, qsizetype i, bool inMask) const
+{
+    // Mirrors the flow-vs-goal loop in ShotAnalysis::analyzeFlowVsGoal.
+    if (!inMask) return;
+    const double x = m_flow[i].x();
+    const double goal = valueAtOrAfter(m_flowGoal, x);
+    if (goal < ShotAnalysis::FLOW_GOAL_MIN_AVG) return;
+    acc.actualSum += m_flow[i].y();
+    acc.goalSum += goal;
+    ++acc.count;
+}
+
+void LiveShotAnalysis::stepChoke(ChokeTally& acc, qsizetype i, bool inMask) const
+{
+    // Mirrors the choked-puck loop in ShotAnalysis::analyzeFlowVsGoal.
+    const double x = m_flow[i].x();
+    if (!inMask) {
+        acc.prevValid = false;
+        return;
+    }
+    const double press = valueAtOrAfter(m_pressure, x);
+    if (press < ShotAnalysis::CHOKED_PRESSURE_MIN_BAR) {
+        acc.prevValid = false;
+        return;
+    }
+    if (acc.prevValid) {
+        const double dt = x - acc.prevX;
+        if (dt > 0 && dt < 1.0)
+            acc.pressurizedDuration += dt;
+    }
+    acc.flowSum += m_flow[i].y();
+    ++acc.flowSamples;
+    acc.prevX = x;
+    acc.prevValid = true;
+}
+
+void LiveShotAnalysis::tallyGrind()
+{
+    const qsizetype n = m_flow.size();
+
+    // Flow-vs-goal: needs the sample's phase closed and, when it is inside
+    // a flow-mode range, a goal sample at or after it.
+    for (qsizetype i = m_pourStartIndex + m_flowGoalTally.size(); i < n; ++i) {
+        const double x = m_flow[i].x();
+        if (!isPhaseClosedAt(x)) break;
+        const bool inMask = inRanges(m_flowModeRanges, x);
+        if (inMask && (m_flowGoal.isEmpty() || m_flowGoal.last().x() < x)) break;
+        FlowGoalTally acc = m_flowGoalTally.isEmpty() ? FlowGoalTally{} : m_flowGoalTally.last();
+        stepFlowGoal(acc, i, inMask);
+        m_flowGoalTally.append(acc);
+    }
+
+    // Choked puck, whole pour (used when the shot has no pressure-mode phase)
+    for (qsizetype i = m_pourStartIndex + m_chokeAllTally.size(); i < n; ++i) {
+        ChokeTally acc = m_chokeAllTally.isEmpty() ? ChokeTally{} : m_chokeAllTally.last();
+        stepChoke(acc, i, true);
+        m_chokeAllTally.append(acc);
+    }
+
+    // Choked puck restricted to pressure-mode phases
+    for (qsizetype i = m_pourStartIndex + m_chokePressureModeTally.size(); i < n; ++i) {
+        const double x = m_flow[i].x();
+        if (!isPhaseClosedAt(x)) break;
+        ChokeTally acc = m_chokePressureModeTally.isEmpty() ? ChokeTally{} : m_chokePressureModeTally.last();
+        stepChoke(acc, i, inRanges(m_pressureModeRanges, x));
+        m_chokePressureModeTally.append(acc);
+    }
+}
+
+void LiveShotAnalysis::tallyProvisionalGrind()
+{
+    // Continue each committed prefix over the samples it is still waiting
+    // on, using the open phase's range as it stands (open end = +inf, no
+    // limiter-tail trim yet). Restarts only when the committed prefix
+    // moves, so each sample is re-stepped about once per marker.
+    const qsizetype n = m_flow.size();
+
+    const qsizetype flowGoalFrom = m_pourStartIndex + m_flowGoalTally.size();
+    if (m_provisionalFlowGoalFrom != flowGoalFrom) {
+        m_provisionalFlowGoalFrom = flowGoalFrom;
+        m_provisionalFlowGoalCursor = flowGoalFrom;
+        m_provisionalFlowGoal = m_flowGoalTally.isEmpty() ? FlowGoalTally{} : m_flowGoalTally.last();
+    }
+    for (; m_provisionalFlowGoalCursor < n; ++m_provisionalFlowGoalCursor) {
+        const double x = m_flow[m_provisionalFlowGoalCursor].x();
+        const bool inMask = inRanges(m_flowModeRanges, x);
+        if (inMask && (m_flowGoal.isEmpty() || m_flowGoal.last().x() < x)) break;
+        stepFlowGoal(m_provisionalFlowGoal, m_provisionalFlowGoalCursor, inMask);
+    }
+
+    const qsizetype chokeFrom = m_pourStartIndex + m_chokePressureModeTally.size();
+    if (m_provisionalChokeFrom != chokeFrom) {
+        m_provisionalChokeFrom = chokeFrom;
+        m_provisionalChokeCursor = chokeFrom;
+        m_provisionalChoke = m_chokePressureModeTally.isEmpty() ? ChokeTally{} : m_chokePressureModeTally.last();
+    }
+    for (; m_provisionalChokeCursor < n; ++m_provisionalChokeCursor) {
+        stepChoke(m_provisionalChoke, m_provisionalChokeCursor,
+                  inRanges(m_pressureModeRanges, m_flow[m_provisionalChokeCursor].x()));
+    }
+}
+
+bool LiveShotAnalysis::hasPressureModeRange() const
+{
+    for (const auto& r : m_pressureModeRanges) {
+        if (r.end > r.start) return true;
+    }
+    return false;
+}
+
+// --- Live outputs ---
+
+void LiveShotAnalysis::updateLive()
+{
+    // Channeling — committed tallies only ever grow, so the severity only
+    // escalates. Suppressed for the same reasons analyzeShot skips the
+    // check; the turbo test uses the pour's average flow so far.
+    const qsizetype last = m_pressure.size() - 1;
+    const bool turbo = last >= m_pourStartIndex && m_turboFlowCount.value(last) > 0
+        && (m_turboFlowSum[last] / m_turboFlowCount[last]) > ShotAnalysis::CHANNELING_MAX_AVG_FLOW;
+    const bool channelingSuppressed = m_nonEspresso || turbo || m_livePourNotPressurizing
+        || m_analysisFlags.contains(QStringLiteral("channeling_expected"));
+    if (!channelingSuppressed && !m_channeling.isEmpty()) {
+        const ChannelingTally& tally = m_channeling.last();
+        const auto severity = ShotAnalysis::classifyChanneling(tally.elevated, tally.maxSpike);
+        if (severity != m_liveChanneling || tally.maxSpikeTime != m_liveSpikeTime) {
+            const bool escalated = severity > m_liveChanneling;
+            m_liveChanneling = severity;
+            m_liveSpikeTime = severity == ShotAnalysis::ChannelingSeverity::None ? 0.0 : tally.maxSpikeTime;
+            emit channelingChanged();
+            if (escalated) {
+                qDebug() << "LiveShotAnalysis: channeling" << severityName(severity)
+                         << "at" << m_liveSpikeTime << "s";
+                emit channelingDetected(severityName(severity), m_liveSpikeTime);
+            }
+        }
+    }
+
+    // Grind — flow-vs-goal average and the choked-puck flow arm over the
+    // committed samples plus the open-phase continuation. The yield arms need the final weight and stay
+    // with the post-shot verdict.
+    if (!m_nonEspresso && !m_analysisFlags.contains(QStringLiteral("grind_check_skip"))) {
+        ShotAnalysis::GrindCheck grind;
+        const FlowGoalTally& fg = m_provisionalFlowGoal;
+        ShotAnalysis::applyFlowVsGoalAverages(grind, fg.actualSum, fg.goalSum, fg.count);
+        const ChokeTally c = hasPressureModeRange()
+            ? m_provisionalChoke
+            : (m_chokeAllTally.isEmpty() ? ChokeTally{} : m_chokeAllTally.last());
+        ShotAnalysis::applyChokedPuckArms(grind, c.flowSamples, c.pressurizedDuration,
+                                          c.flowSum, 0.0, 0.0);
+
+        QString direction;
+        if (grind.hasData) {
+            if (grind.chokedPuck)
+                direction = QStringLiteral("chokedPuck");
+            else if (grind.delta < -ShotAnalysis::FLOW_DEVIATION_THRESHOLD)
+                direction = QStringLiteral("tooFine");
+            else if (grind.delta > ShotAnalysis::FLOW_DEVIATION_THRESHOLD)
+                direction = QStringLiteral("tooCoarse");
+            else
+                direction = QStringLiteral("onTarget");
+        }
+        if (direction != m_liveGrindDirection || grind.delta != m_liveGrindDelta) {
+            // The open-phase continuation can hover around a threshold;
+            // announce each direction once per shot.
+            const bool newIssue = !m_reportedGrindIssues.contains(direction)
+                && (direction == QStringLiteral("chokedPuck")
+                    || direction == QStringLiteral("tooFine")
+                    || direction == QStringLiteral("tooCoarse"));
+            if (newIssue)
+                m_reportedGrindIssues.append(direction);
+            m_liveGrindDirection = direction;
+            m_liveGrindDelta = grind.delta;
+            emit grindChanged();
+            if (newIssue) {
+                qDebug() << "LiveShotAnalysis: grind" << direction << "delta" << grind.delta;
+                emit grindIssueDetected(direction, grind.delta);
+            }
+        }
+    }
+
+    // Pour not pressurizing — only once the pour frame has run
+    // LIVE_POUR_TRUNCATED_GRACE_SEC without the pour window reaching the
+    // floor. Clears again if pressure builds later.
+    bool notPressurizing = false;
+    if (!m_nonEspresso && m_pourStart > 0 && m_pourPhaseStart >= 0 && last >= m_pourStartIndex) {
+        const double pourFrom = qMax(m_pourStart, m_pourPhaseStart);
+        notPressurizing = m_pressure[last].x() - pourFrom >= LIVE_POUR_TRUNCATED_GRACE_SEC
+            && m_peakPressure[last] < ShotAnalysis::PRESSURE_FLOOR_BAR;
+    }
+    if (notPressurizing != m_livePourNotPressurizing) {
+        m_livePourNotPressurizing = notPressurizing;
+        emit pourNotPressurizingChanged();
+        if (notPressurizing && !m_pourNotPressurizingReported) {
+            m_pourNotPressurizingReported = true;
+            qDebug() << "LiveShotAnalysis: pour not pressurizing, peak" << m_peakPressure[last] << "bar";
+            emit pourNotPressurizingDetected(m_peakPressure[last]);
+        }
+    }
+}
+
+// --- End of shot ---
+
+void LiveShotAnalysis::end()
+{
+    if (!m_active) return;
+    m_active = false;
+    emit activeChanged();
+}
+
+// --- Series helpers (time-ordered series) ---
+
+qsizetype LiveShotAnalysis::firstAtOrAfter(const QVector<QPointF>& series, double t)
+{
+    return CurveIndex::firstAtOrAfter(series, t);
+}
+
+double LiveShotAnalysis::valueAtOrAfter(const QVector<QPointF>& series, double t)
+{
+    return CurveIndex::valueAtOrAfter(series, t);
+}
+
+QJsonObject LiveShotAnalysis::toJson() const
+{
+    QJsonObject result;
+    result["active"] = m_active;
+    result["channelingSeverity"] = channelingSeverity();
+    result["channelingSpikeTimeSec"] = m_liveSpikeTime;
+    result["grindDirection"] = m_liveGrindDirection;
+    result["grindFlowDeltaMlPerSec"] = m_liveGrindDelta;
+    result["pourNotPressurizing"] = m_livePourNotPressurizing;
+    result["pourStartSec"] = m_pourStart;
+    if (!m_peakPressure.isEmpty())
+        result["peakPressureBar"] = m_peakPressure.last();
+    return result;
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "shotanalysis.h"
+#include "history/shothistory_types.h"
+
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Streaming counterparts of the puck-integrity detectors in ShotAnalysis —
+// detectChannelingFromDerivative (with buildChannelingWindows),
+// analyzeFlowVsGoal and detectPourTruncated — fed one sample at a time while
+// the shot runs, so the UI, MQTT and MCP can report "channeling now" instead
+// of waiting for the post-shot summary.
+//
+// Each detector keeps running state and commits a sample only once nothing
+// that arrives later can change how the batch detector would treat it:
+//   * dC/dt is finalised Conductance::DERIVATIVE_LOOKAHEAD samples behind
+//     the head (same Conductance::derivativeAt the batch curve uses).
+//   * Channeling-window qualification needs WINDOW_HALF_SEC of look-ahead
+//     on pressure and on the active goal; a dC/dt sample's window membership
+//     is decided once assembly has moved WINDOW_GAP_MERGE_SEC past it.
+//     Samples just before a pump-mode switch are taken as "no goal" until
+//     that goal resumes, and assembly rewinds if one of them then qualifies.
+//   * The grind masks (flow-mode / pressure-mode ranges) need the phase the
+//     sample sits in to have closed, i.e. the next marker to have arrived.
+//     The live grind signal continues the committed sums provisionally over
+//     the open phase; that continuation is re-run from the committed prefix
+//     whenever a marker commits more samples.
+// Per-sample cost is amortised O(log n) (binary-searched series lookups);
+// committed channeling decisions are only revisited by the mode-switch
+// rewind above.
+//
+// The detectors share ShotAnalysis's building blocks and accumulate in the
+// same order as the batch ones. The saved verdicts still come from
+// analyzeShot() in the post-shot pipeline; this class only drives the live
+// signals below.
+//
+// Assumes what MainController guarantees: samples arrive in time order and a
+// frame marker is added no later than the first sample at its time. The End
+// marker (stop-at-weight / user stop) may lag by a few samples; all it
+// could affect lies past the end of the pour.
+class LiveShotAnalysis : public QObject {
+    Q_OBJECT
+
+    Q_PROPERTY(bool active READ isActive NOTIFY activeChanged)
+    Q_PROPERTY(QString channelingSeverity READ channelingSeverity NOTIFY channelingChanged)
+    Q_PROPERTY(double channelingSpikeTime READ channelingSpikeTime NOTIFY channelingChanged)
+    Q_PROPERTY(QString grindDirection READ grindDirection NOTIFY grindChanged)
+    Q_PROPERTY(double grindFlowDelta READ grindFlowDelta NOTIFY grindChanged)
+    Q_PROPERTY(bool pourNotPressurizing READ pourNotPressurizing NOTIFY pourNotPressurizingChanged)
+
+public:
+    // How long the pour may run below PRESSURE_FLOOR_BAR before the live
+    // warning fires. The batch verdict needs the whole pour; live we only
+    // speak once the pour phase has clearly started and stayed flat.
+    static constexpr double LIVE_POUR_TRUNCATED_GRACE_SEC = 5.0;
+
+    explicit LiveShotAnalysis(QObject* parent = nullptr);
+
+    // Start a new shot. analysisFlags as returned by
+    // ShotSummarizer::getAnalysisFlags for the active profile.
+    void begin(const QString& beverageType, const QStringList& analysisFlags);
+
+    void addPhaseMarker(const HistoryPhaseMarker& marker);
+
+    // Same arguments ShotDataModel::addSample() records; goals <= 0 are
+    // treated as "no goal" exactly as the model's goal segments do.
+    void addSample(double time, double pressure, double flow,
+                   double pressureGoal, double flowGoal);
+
+    // End the shot. Pending decisions are dropped: the saved badges come
+    // from analyzeShot() in the post-shot pipeline.
+    void end();
+
+    bool isActive() const { return m_active; }
+    QString channelingSeverity() const { return severityName(m_liveChanneling); }
+    double channelingSpikeTime() const { return m_liveSpikeTime; }
+    QString grindDirection() const { return m_liveGrindDirection; }
+    double grindFlowDelta() const { return m_liveGrindDelta; }
+    bool pourNotPressurizing() const { return m_livePourNotPressurizing; }
+
+    // Live state for MCP / the web debug page.
+    QJsonObject toJson() const;
+
+    static QString severityName(ShotAnalysis::ChannelingSeverity severity);
+
+signals:
+    void activeChanged();
+    void channelingChanged();
+    void grindChanged();
+    void pourNotPressurizingChanged();
+
+    // Edge-triggered: channeling fires when the live severity escalates,
+    // the other two at most once per shot (per direction for grind).
+    void channelingDetected(const QString& severity, double spikeTimeSec);
+    void grindIssueDetected(const QString& direction, double flowDeltaMlPerSec);
+    void pourNotPressurizingDetected(double peakPressureBar);
+
+private:
+    struct AssemblyState {
+        qsizetype windowCount = 0;
+        double lastWindowEnd = 0.0;
+        ShotAnalysis::DetectionWindow current{-1.0, -1.0};
+    };
+    // Cumulative channeling tallies, one per decided dC/dt sample.
+    struct ChannelingTally {
+        double decidedAt = 0.0;   // newest assembled grid time the decision read
+        int elevated = 0;
+        double maxSpike = 0.0;
+        double maxSpikeTime = 0.0;
+    };
+    // Cumulative flow-vs-goal sums, one per decided flow sample.
+    struct FlowGoalTally {
+        double actualSum = 0.0;
+        double goalSum = 0.0;
+        qsizetype count = 0;
+    };
+    // Cumulative choked-puck state, one per decided flow sample.
+    struct ChokeTally {
+        double pressurizedDuration = 0.0;
+        double flowSum = 0.0;
+        qsizetype flowSamples = 0;
+        double prevX = 0.0;
+        bool prevValid = false;
+    };
+
+    void rebuildPourState();
+    void advance();
+    void finaliseDerivative();
+    enum class Readiness { Pending, Provisional, Final };
+    Readiness qualificationReadiness(qsizetype i) const;
+    bool evaluateQualification(qsizetype i) const;
+    void qualify();
+    void resolveProvisional();
+    void rewindAssembly(qsizetype from);
+    void assembleThrough(qsizetype last);
+    void decideChanneling();
+    void tallyGrind();
+    void tallyProvisionalGrind();
+    void updateLive();
+
+    void stepFlowGoal(FlowGoalTally& acc, qsizetype i, bool inMask) const;
+    void stepChoke(ChokeTally& acc, qsizetype i, bool inMask) const;
+    bool isPhaseClosedAt(double t) const;
+    bool flowModeAt(double t) const;
+    bool hasPressureModeRange() const;
+
+    static qsizetype firstAtOrAfter(const QVector<QPointF>& series, double t);
+    static double valueAtOrAfter(const QVector<QPointF>& series, double t);
+    static bool inRanges(const QVector<ShotAnalysis::TimeRange>& ranges, double t);
+    static void flushWindow(QVector<ShotAnalysis::DetectionWindow>& windows,
+                            ShotAnalysis::DetectionWindow& current);
+    static bool windowsCover(const QVector<ShotAnalysis::DetectionWindow>& windows,
+                             const ShotAnalysis::DetectionWindow& current, double t);
+
+    // Shot configuration
+    bool m_active = false;
+    QString m_beverageType;
+    QStringList m_analysisFlags;
+    bool m_nonEspresso = false;
+
+    // Inputs (append-only during a shot). All sample series share one time axis.
+    QVector<QPointF> m_pressure;
+    QVector<QPointF> m_flow;
+    QVector<QPointF> m_conductance;
+    QVector<QPointF> m_pressureGoal;
+    QVector<QPointF> m_flowGoal;
+    QList<HistoryPhaseMarker> m_phases;
+
+    // Pour window as far as the markers so far define it
+    double m_pourStart = 0.0;
+    qsizetype m_pourStartIndex = 0;
+    double m_pourPhaseStart = -1.0;  // first frame after preinfusion (live warning only)
+    QVector<ShotAnalysis::TimeRange> m_flowModeRanges;      // open phase ends at +inf
+    QVector<ShotAnalysis::TimeRange> m_pressureModeRanges;  // open phase ends at +inf
+
+    // Per-sample prefixes from m_pourStartIndex (0 before it)
+    QVector<double> m_peakPressure;
+    QVector<double> m_turboFlowSum;
+    QVector<qsizetype> m_turboFlowCount;
+
+    // dC/dt, finalised values only
+    QVector<double> m_dcdt;
+
+    // Channeling windows: per-sample qualification (-1 = not yet decidable),
+    // incremental assembly from the first sample at/after the analysis start.
+    QVector<qint8> m_qualified;
+    qsizetype m_qualCursor = 0;
+    QVector<qsizetype> m_provisional;   // qualified "no" pending a goal that may resume
+    qsizetype m_assemblyBegin = 0;
+    qsizetype m_assemblyCursor = 0;
+    QVector<ShotAnalysis::DetectionWindow> m_windows;
+    ShotAnalysis::DetectionWindow m_current{-1.0, -1.0};
+    QVector<AssemblyState> m_assembly;  // state after assembling sample i
+
+    QVector<ChannelingTally> m_channeling;  // [k] ↔ sample m_assemblyBegin + k
+    QVector<FlowGoalTally> m_flowGoalTally; // [k] ↔ sample m_pourStartIndex + k
+    QVector<ChokeTally> m_chokeAllTally;
+    QVector<ChokeTally> m_chokePressureModeTally;
+
+    // Committed sums continued over the open phase (live signal only).
+    // *From is the first uncommitted sample the continuation started at.
+    qsizetype m_provisionalFlowGoalFrom = -1;
+    qsizetype m_provisionalFlowGoalCursor = 0;
+    FlowGoalTally m_provisionalFlowGoal;
+    qsizetype m_provisionalChokeFrom = -1;
+    qsizetype m_provisionalChokeCursor = 0;
+    ChokeTally m_provisionalChoke;
+
+    // Live outputs
+    ShotAnalysis::ChannelingSeverity m_liveChanneling = ShotAnalysis::ChannelingSeverity::None;
+    double m_liveSpikeTime = 0.0;
+    QString m_liveGrindDirection;
+    double m_liveGrindDelta = 0.0;
+    bool m_livePourNotPressurizing = false;
+    QStringList m_reportedGrindIssues;
+    bool m_pourNotPressurizingReported = false;
+};
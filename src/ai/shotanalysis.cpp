@@ -1,4 +1,5 @@
 #include "shotanalysis.h"
+#include "curveindex.h"
 #include "history/shothistorystorage.h"  // HistoryPhaseMarker
 
 #include <QVariantMap>
@@ -29,19 +30,21 @@ double lookupOrNaN(const QVector<QPointF>& data, double t)
 {
     if (data.isEmpty()) return std::nan("");
     if (t < data.first().x() || t > data.last().x()) return std::nan("");
-    // Linear interpolation between the nearest bracketing samples.
-    for (qsizetype i = 1; i < data.size(); ++i) {
-        if (data[i].x() >= t) {
-            const double x0 = data[i - 1].x();
-            const double x1 = data[i].x();
-            const double y0 = data[i - 1].y();
-            const double y1 = data[i].y();
-            if (x1 <= x0) return y1;
-            const double alpha = (t - x0) / (x1 - x0);
-            return y0 + alpha * (y1 - y0);
-        }
-    }
-    return data.last().y();
+    // Linear interpolation between the nearest bracketing samples. Binary
+    // search for the first sample at or after t (series are time-ordered);
+    // the window builder probes three times per grid sample, so a linear
+    // scan here made it quadratic in shot length.
+    const auto it = std::lower_bound(data.cbegin() + 1, data.cend(), t,
+                                     [](const QPointF& p, double value) { return p.x() < value; });
+    if (it == data.cend()) return data.last().y();
+    const qsizetype i = it - data.cbegin();
+    const double x0 = data[i - 1].x();
+    const double x1 = data[i].x();
+    const double y0 = data[i - 1].y();
+    const double y1 = data[i].y();
+    if (x1 <= x0) return y1;
+    const double alpha = (t - x0) / (x1 - x0);
+    return y0 + alpha * (y1 - y0);
 }
 
 } // namespace
@@ -106,7 +109,12 @@ ShotAnalysis::ChannelingSeverity ShotAnalysis::detectChannelingFromDerivative(
 
     if (outMaxSpikeTime) *outMaxSpikeTime = maxSpikeTime;
 
-    if (sustainedCount > CHANNELING_DC_SUSTAINED_COUNT)
+    return classifyChanneling(sustainedCount, maxSpike);
+}
+
+ShotAnalysis::ChannelingSeverity ShotAnalysis::classifyChanneling(int elevatedCount, double maxSpike)
+{
+    if (elevatedCount > CHANNELING_DC_SUSTAINED_COUNT)
         return ChannelingSeverity::Sustained;
     if (maxSpike > CHANNELING_DC_TRANSIENT_PEAK)
         return ChannelingSeverity::Transient;
@@ -167,88 +175,11 @@ QVector<ShotAnalysis::DetectionWindow> ShotAnalysis::buildChannelingWindows(
         if (t < analysisStart) continue;
         if (t > analysisEnd) break;
 
-        bool isFlowMode = false;
-        if (!phaseAtTime(phases, t, &isFlowMode)) {
-            flushCurrent();
-            continue;
-        }
-
-        const QVector<QPointF>& goalSeries = isFlowMode ? flowGoal : pressureGoal;
-        const QVector<QPointF>& actualSeries = isFlowMode ? flow : pressure;
-
-        const double goalNow = lookupOrNaN(goalSeries, t);
-        const double goalPast = lookupOrNaN(goalSeries, t - WINDOW_HALF_SEC);
-        const double goalFut = lookupOrNaN(goalSeries, t + WINDOW_HALF_SEC);
-        const double actual = lookupOrNaN(actualSeries, t);
-
-        // No goal data at this moment (outside series bounds or sentinel) → skip.
-        if (std::isnan(goalNow) || std::isnan(goalPast) || std::isnan(goalFut)
-            || std::isnan(actual)) {
-            flushCurrent();
-            continue;
-        }
-        if (goalNow < WINDOW_MIN_GOAL) {
-            // Goal is zero/sentinel here — no active control → skip.
-            flushCurrent();
-            continue;
-        }
-
-        // Stationarity: both past and future goal values within WINDOW_STATIONARY_REL of goalNow.
-        const double relPast = std::abs(goalPast - goalNow) / goalNow;
-        const double relFut = std::abs(goalFut - goalNow) / goalNow;
-        if (relPast > WINDOW_STATIONARY_REL || relFut > WINDOW_STATIONARY_REL) {
+        if (!channelingWindowQualifies(pressure, flow, pressureGoal, flowGoal, phases, t)) {
             flushCurrent();
             continue;
         }
 
-        // Convergence: actual within WINDOW_CONVERGED_REL of goalNow.
-        const double convergenceErr = std::abs(actual - goalNow) / goalNow;
-        if (convergenceErr > WINDOW_CONVERGED_REL) {
-            flushCurrent();
-            continue;
-        }
-
-        // Exclude samples where pressure is RISING fast, regardless of phase
-        // mode. Two intentional ramp dynamics produce the same conductance-
-        // drop signature that the dC/dt detector would otherwise read as
-        // sustained channeling:
-        //
-        //   * Flow-mode lever rise: flow goal is steady (e.g. 7.5 ml/s
-        //     preinfusion) while the puck builds pressure under a
-        //     pressure-ceiling exit condition. Cremina, Damian LRv3,
-        //     80's Espresso preinfusion all hit this.
-        //
-        //   * Pressure-mode rise-and-hold: pressure goal is locked at the
-        //     target (e.g. 7.8 bar) but actual pressure is still ramping
-        //     toward it. The convergence check (|actual - goal| / goal ≤
-        //     0.15) admits samples while actual is within 15 % of goal,
-        //     even when actual is still rising fast — and during that
-        //     final leg, dC/dt clamps at the negative floor as conductance
-        //     drops with pressure. Shot 889 (a clean 35.6 g extraction on
-        //     80's Espresso) tripped this and falsely fired channeling.
-        //
-        // Direction matters: real puck failures collapse flow under
-        // approximately stable pressure, so pressure stays in-window. Bloom
-        // transitions and pressure-mode → flow-mode handoffs see pressure
-        // FALL rapidly — those are legitimate channeling signals (or
-        // expected transients) and must not be masked, so we only fence on
-        // rises here. The dC/dt detector counts both signs of conductance
-        // change as channeling (flow-surge gushers and post-channel flow
-        // collapse), and neither failure mode coincides with pressure
-        // climbing past the WINDOW_STATIONARY_REL threshold under a
-        // converged-and-held goal — so excluding rising-pressure samples
-        // doesn't mask either signature in pressure mode.
-        {
-            const double pressureNow = lookupOrNaN(pressure, t);
-            const double pressureFut = lookupOrNaN(pressure, t + WINDOW_HALF_SEC);
-            if (!std::isnan(pressureNow) && !std::isnan(pressureFut)
-                && pressureNow > 0.5
-                && pressureFut > pressureNow * (1.0 + WINDOW_STATIONARY_REL)) {
-                flushCurrent();
-                continue;
-            }
-        }
-
         // Sample qualifies. Extend or start the current window.
         if (current.start < 0) {
             current.start = t;
@@ -260,20 +191,101 @@ QVector<ShotAnalysis::DetectionWindow> ShotAnalysis::buildChannelingWindows(
     return windows;
 }
 
+bool ShotAnalysis::channelingWindowQualifies(const QVector<QPointF>& pressure,
+                                             const QVector<QPointF>& flow,
+                                             const QVector<QPointF>& pressureGoal,
+                                             const QVector<QPointF>& flowGoal,
+                                             const QList<HistoryPhaseMarker>& phases,
+                                             double t)
+{
+    bool isFlowMode = false;
+    if (!phaseAtTime(phases, t, &isFlowMode)) {
+        return false;
+    }
+
+    const QVector<QPointF>& goalSeries = isFlowMode ? flowGoal : pressureGoal;
+    const QVector<QPointF>& actualSeries = isFlowMode ? flow : pressure;
+
+    const double goalNow = lookupOrNaN(goalSeries, t);
+    const double goalPast = lookupOrNaN(goalSeries, t - WINDOW_HALF_SEC);
+    const double goalFut = lookupOrNaN(goalSeries, t + WINDOW_HALF_SEC);
+    const double actual = lookupOrNaN(actualSeries, t);
+
+    // No goal data at this moment (outside series bounds or sentinel) → skip.
+    if (std::isnan(goalNow) || std::isnan(goalPast) || std::isnan(goalFut)
+        || std::isnan(actual)) {
+        return false;
+    }
+    if (goalNow < WINDOW_MIN_GOAL) {
+        // Goal is zero/sentinel here — no active control → skip.
+        return false;
+    }
+
+    // Stationarity: both past and future goal values within WINDOW_STATIONARY_REL of goalNow.
+    const double relPast = std::abs(goalPast - goalNow) / goalNow;
+    const double relFut = std::abs(goalFut - goalNow) / goalNow;
+    if (relPast > WINDOW_STATIONARY_REL || relFut > WINDOW_STATIONARY_REL) {
+        return false;
+    }
+
+    // Convergence: actual within WINDOW_CONVERGED_REL of goalNow.
+    const double convergenceErr = std::abs(actual - goalNow) / goalNow;
+    if (convergenceErr > WINDOW_CONVERGED_REL) {
+        return false;
+    }
+
+    // Exclude samples where pressure is RISING fast, regardless of phase
+    // mode. Two intentional ramp dynamics produce the same conductance-
+    // drop signature that the dC/dt detector would otherwise read as
+    // sustained channeling:
+    //
+    //   * Flow-mode lever rise: flow goal is steady (e.g. 7.5 ml/s
+    //     preinfusion) while the puck builds pressure under a
+    //     pressure-ceiling exit condition. Cremina, Damian LRv3,
+    //     80's Espresso preinfusion all hit this.
+    //
+    //   * Pressure-mode rise-and-hold: pressure goal is locked at the
+    //     target (e.g. 7.8 bar) but actual pressure is still ramping
+    //     toward it. The convergence check (|actual - goal| / goal ≤
+    //     0.15) admits samples while actual is within 15 % of goal,
+    //     even when actual is still rising fast — and during that
+    //     final leg, dC/dt clamps at the negative floor as conductance
+    //     drops with pressure. Shot 889 (a clean 35.6 g extraction on
+    //     80's Espresso) tripped this and falsely fired channeling.
+    //
+    // Direction matters: real puck failures collapse flow under
+    // approximately stable pressure, so pressure stays in-window. Bloom
+    // transitions and pressure-mode → flow-mode handoffs see pressure
+    // FALL rapidly — those are legitimate channeling signals (or
+    // expected transients) and must not be masked, so we only fence on
+    // rises here. The dC/dt detector counts both signs of conductance
+    // change as channeling (flow-surge gushers and post-channel flow
+    // collapse), and neither failure mode coincides with pressure
+    // climbing past the WINDOW_STATIONARY_REL threshold under a
+    // converged-and-held goal — so excluding rising-pressure samples
+    // doesn't mask either signature in pressure mode.
+    {
+        const double pressureNow = lookupOrNaN(pressure, t);
+        const double pressureFut = lookupOrNaN(pressure, t + WINDOW_HALF_SEC);
+        if (!std::isnan(pressureNow) && !std::isnan(pressureFut)
+            && pressureNow > 0.5
+            && pressureFut > pressureNow * (1.0 + WINDOW_STATIONARY_REL)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool ShotAnalysis::shouldSkipChannelingCheck(const QString& beverageType,
                                                const QVector<QPointF>& flowData,
                                                double pourStart, double pourEnd)
 {
-    QString bev = beverageType.toLower();
     // Non-espresso modes: filter/pourover brew through a paper filter, tea
     // steeps, steam is a manual health check, cleaning/calibration flow hot
     // water through an empty portafilter. None of these have a puck whose
     // integrity dC/dt can meaningfully score.
-    if (bev == QStringLiteral("filter")
-        || bev == QStringLiteral("pourover")
-        || bev == QStringLiteral("tea")
-        || bev == QStringLiteral("steam")
-        || bev == QStringLiteral("cleaning"))
+    if (isNonEspressoBeverage(beverageType))
         return true;
 
     // Check for turbo: avg flow during extraction > threshold
@@ -358,11 +370,7 @@ bool ShotAnalysis::reachedExtractionPhase(const QList<HistoryPhaseMarker>& phase
 
 double ShotAnalysis::findValueAtTime(const QVector<QPointF>& data, double time)
 {
-    if (data.isEmpty()) return 0.0;
-    for (const auto& pt : data) {
-        if (pt.x() >= time) return pt.y();
-    }
-    return data.last().y();
+    return CurveIndex::valueAtOrAfter(data, time);
 }
 
 ShotAnalysis::GrindCheck ShotAnalysis::analyzeFlowVsGoal(
@@ -378,13 +386,8 @@ ShotAnalysis::GrindCheck ShotAnalysis::analyzeFlowVsGoal(
 {
     GrindCheck result;
 
-    const QString bev = beverageType.toLower();
-    const bool bevSkip = (bev == QStringLiteral("filter")
-                          || bev == QStringLiteral("pourover")
-                          || bev == QStringLiteral("tea")
-                          || bev == QStringLiteral("steam")
-                          || bev == QStringLiteral("cleaning"));
-    if (analysisFlags.contains(QStringLiteral("grind_check_skip")) || bevSkip) {
+    if (analysisFlags.contains(QStringLiteral("grind_check_skip"))
+        || isNonEspressoBeverage(beverageType)) {
         result.skipped = true;
         return result;
     }
@@ -405,58 +408,11 @@ ShotAnalysis::GrindCheck ShotAnalysis::analyzeFlowVsGoal(
     if (pourStart >= pourEnd || flow.isEmpty())
         return result;
 
-    // Build inclusive flow-mode time ranges from phase markers. A sample at
-    // time t qualifies only when it falls inside a flow-mode phase; this
-    // gates out pressure-controlled phases whose "flow goal" is really a
-    // safety limiter (80's Espresso rise+decline, Cremina lever, Londinium
-    // pour, etc.) — comparing actual flow against that ceiling is the
-    // canonical false-positive source.
-    //
-    // Two boundary trims (see GRIND_*_SKIP_SEC in shotanalysis.h) apply
-    // within each flow-mode range so we don't average pump-ramp lag or the
-    // post-limiter-engaged tail. Without them the lever preinfusion shape
-    // (pump-ramp at start + pressure ceiling activates at end) reads as a
-    // sustained "too fine" delta even on clean shots.
-    struct Range { double start; double end; };
-    QVector<Range> flowModeRanges;
-    if (!phases.isEmpty()) {
-        // Pump-ramp trim applies to the first flow-mode phase that
-        // coincides with pourStart — that's the one where the pump goes
-        // from idle to commanded flow. A flow-mode phase that starts
-        // before pourStart (e.g. a fill phase) has its samples filtered
-        // out by the pour-window gate below anyway; consuming the
-        // "first seen" flag on it would silently skip the trim where it
-        // actually belongs. The 0.1 s margin absorbs BLE timestamp jitter.
-        //
-        // Both trims are gated on the resulting range staying at least
-        // kMinPostTrimRangeSec long. On extreme puck-failure shots —
-        // where the firmware bails out within a couple of seconds because
-        // the puck offers no resistance — the first flow-mode phase can
-        // be a fraction of a second. Trimming 0.5 s off the front of that
-        // phase would leave nothing to analyze and the detector would
-        // silently report no-data instead of catching the obvious gusher.
-        constexpr double kMinPostTrimRangeSec = 1.0;
-        bool firstFlowModeAtPourStartSeen = false;
-        for (qsizetype i = 0; i < phases.size(); ++i) {
-            if (!phases[i].isFlowMode) continue;
-            double start = phases[i].time;
-            double end = (i + 1 < phases.size()) ? phases[i + 1].time : pourEnd;
-            if (!firstFlowModeAtPourStartSeen
-                && phases[i].time + 0.1 >= pourStart) {
-                if ((end - start) - GRIND_PUMP_RAMP_SKIP_SEC >= kMinPostTrimRangeSec) {
-                    start += GRIND_PUMP_RAMP_SKIP_SEC;
-                }
-                firstFlowModeAtPourStartSeen = true;
-            }
-            if (i + 1 < phases.size()
-                && phases[i + 1].transitionReason.compare(
-                       QStringLiteral("pressure"), Qt::CaseInsensitive) == 0) {
-                if ((end - start) - GRIND_LIMITER_TAIL_SKIP_SEC >= kMinPostTrimRangeSec) {
-                    end -= GRIND_LIMITER_TAIL_SKIP_SEC;
-                }
-            }
-            if (end > start) flowModeRanges.append({start, end});
-        }
+    // Flow-mode time ranges (trimmed) from phase markers — see
+    // grindFlowModeRanges() for the pump-ramp and limiter-tail trims.
+    QVector<TimeRange> flowModeRanges;
+    for (const TimeRange& r : grindFlowModeRanges(phases, pourStart, pourEnd)) {
+        if (r.end > r.start) flowModeRanges.append(r);
     }
     // Flow-vs-goal averaging path. Skipped when no flow-mode windows
     // qualify or when the profile carries no flow goal.
@@ -480,11 +436,7 @@ ShotAnalysis::GrindCheck ShotAnalysis::analyzeFlowVsGoal(
             ++count;
         }
 
-        result.sampleCount = count;
-        if (count >= 5) {
-            result.hasData = true;
-            result.delta = (actualSum / count) - (goalSum / count);
-        }
+        applyFlowVsGoalAverages(result, actualSum, goalSum, count);
     }
 
     // Choked-puck check, restricted to pressure-mode portions of the pour.
@@ -499,12 +451,9 @@ ShotAnalysis::GrindCheck ShotAnalysis::analyzeFlowVsGoal(
     if (pressure.isEmpty())
         return result;
 
-    QVector<Range> pressureModeRanges;
-    for (qsizetype i = 0; i < phases.size(); ++i) {
-        if (phases[i].isFlowMode) continue;
-        const double start = phases[i].time;
-        const double end = (i + 1 < phases.size()) ? phases[i + 1].time : pourEnd;
-        if (end > start) pressureModeRanges.append({start, end});
+    QVector<TimeRange> pressureModeRanges;
+    for (const TimeRange& r : grindPressureModeRanges(phases, pourEnd)) {
+        if (r.end > r.start) pressureModeRanges.append(r);
     }
     auto inPressureMode = [&pressureModeRanges](double t) {
         if (pressureModeRanges.isEmpty()) return true;
@@ -541,61 +490,8 @@ ShotAnalysis::GrindCheck ShotAnalysis::analyzeFlowVsGoal(
         prevValid = true;
     }
 
-    // Two arms with split gates:
-    //  - Flow arm needs sustained pressurized flow (≥ 15s ≥ 4 bar) to
-    //    compute a meaningful mean-flow average.
-    //  - Yield arm only needs ≥ 5 pressurized samples (puck saw
-    //    meaningful pressure briefly); its diagnosis is yield-based
-    //    and does not read mean pressurized flow.
-    // The shared gate previously hid shot 745-class misses (Adaptive v2,
-    // 35s pour, 64% yield, ~8.8 s pressurized) — silenced by the 15s gate
-    // even though the yield arm could have spoken. See openspec change
-    // tighten-grind-yield-shortfall-arm and #963.
-    if (flowSamples >= 5) {
-        const bool flowArmGatesPassed = (pressurizedDuration >= CHOKED_DURATION_MIN_SEC);
-
-        bool flowChoked = false;
-        if (flowArmGatesPassed) {
-            const double meanFlow = flowSum / flowSamples;
-            flowChoked = meanFlow < CHOKED_FLOW_MAX_MLPS;
-        }
-
-        // Yield-ratio arm: same diagnosis (grind too fine), milder severity.
-        // Catches shots like 745 (Adaptive v2, 64% of target with brief
-        // pressurized window). finalWeightG works on either real or virtual
-        // scale (FlowScale integrates flow with dose-aware puck-absorption
-        // compensation), so this fires headless too.
-        const bool yieldShortfall = targetWeightG > 0.0
-            && finalWeightG > 0.0
-            && (finalWeightG / targetWeightG) < CHOKED_YIELD_RATIO_MAX;
-
-        // hasData when any arm could speak: the flow arm's gates passed
-        // (regardless of whether choke fired) OR the yield arm fired.
-        // Verified-clean still requires the strong flow-arm gates.
-        if (flowArmGatesPassed || yieldShortfall) {
-            result.hasData = true;
-        }
-
-        if (flowChoked || yieldShortfall) {
-            result.chokedPuck = true;
-            result.sampleCount = flowSamples;
-            // Leave delta carrying its flow-vs-goal meaning; consumers
-            // short-circuit on chokedPuck before reading delta.
-        } else if (flowArmGatesPassed
-                   && !result.yieldOvershoot
-                   && std::abs(result.delta) <= FLOW_DEVIATION_THRESHOLD) {
-            // Flow-arm gates passed, no choke fired, no overshoot, and
-            // Arm 1 (if it ran) found delta within tolerance. The puck
-            // behaved through a sustained pressurized pour — strong verify.
-            result.verifiedClean = true;
-            // Leave sampleCount as Arm 1 set it. Arm 1 assigns sampleCount
-            // before its own count >= 5 gate, so the value here is whatever
-            // Arm 1 saw — could be the qualifying-samples count (≥ 5) when
-            // Arm 1 produced data, a partial count (1-4) when Arm 1 ran
-            // but didn't pass its gate, or 0 when Arm 1's block was
-            // bypassed entirely (empty flowModeRanges or no flowGoal).
-        }
-    }
+    applyChokedPuckArms(result, flowSamples, pressurizedDuration, flowSum,
+                        targetWeightG, finalWeightG);
 
     return result;
 }
@@ -624,12 +520,7 @@ bool ShotAnalysis::detectPourTruncated(const QVector<QPointF>& pressure,
     // Non-espresso modes legitimately run below PRESSURE_FLOOR_BAR (tea
     // steeps cold, pourover runs at a few bar max, cleaning just flushes).
     // Skip entirely — same rule the channeling/grind detectors use.
-    const QString bev = beverageType.toLower();
-    if (bev == QStringLiteral("filter")
-        || bev == QStringLiteral("pourover")
-        || bev == QStringLiteral("tea")
-        || bev == QStringLiteral("steam")
-        || bev == QStringLiteral("cleaning"))
+    if (isNonEspressoBeverage(beverageType))
         return false;
 
     if (pressure.size() < 10 || pourEnd <= pourStart) return false;
@@ -738,14 +629,10 @@ ShotAnalysis::AnalysisResult ShotAnalysis::analyzeShot(
     }
 
     // --- Find phase boundaries ---
-    double preinfEnd = 0, pourStart = 0, pourEnd = duration;
-    for (const auto& phase : phases) {
-        QString label = phase.label.toLower();
-        if (label.contains("infus") || label == "start") preinfEnd = phase.time;
-        if (label.contains("pour")) pourStart = phase.time;
-        if (label == "end") pourEnd = phase.time;
-    }
-    if (pourStart == 0 && preinfEnd > 0) pourStart = preinfEnd;
+    const PourWindow pourWindow = findPourWindow(phases, duration);
+    const double preinfEnd = pourWindow.preinfusionEnd;
+    const double pourStart = pourWindow.pourStart;
+    const double pourEnd = pourWindow.pourEnd;
     d.pourStartSec = pourStart;
     d.pourEndSec = pourEnd;
 
@@ -1180,3 +1067,169 @@ QVariantList ShotAnalysis::generateSummary(const QVector<QPointF>& pressure,
                        expectedFrameCount)
         .lines;
 }
+
+ShotAnalysis::PourWindow ShotAnalysis::findPourWindow(const QList<HistoryPhaseMarker>& phases,
+                                                      double duration)
+{
+    PourWindow w;
+    w.pourEnd = duration;
+    for (const auto& phase : phases) {
+        QString label = phase.label.toLower();
+        if (label.contains("infus") || label == "start") w.preinfusionEnd = phase.time;
+        if (label.contains("pour")) w.pourStart = phase.time;
+        if (label == "end") w.pourEnd = phase.time;
+    }
+    if (w.pourStart == 0 && w.preinfusionEnd > 0) w.pourStart = w.preinfusionEnd;
+    return w;
+}
+
+bool ShotAnalysis::isNonEspressoBeverage(const QString& beverageType)
+{
+    const QString bev = beverageType.toLower();
+    return bev == QStringLiteral("filter")
+        || bev == QStringLiteral("pourover")
+        || bev == QStringLiteral("tea")
+        || bev == QStringLiteral("steam")
+        || bev == QStringLiteral("cleaning");
+}
+
+QVector<ShotAnalysis::TimeRange> ShotAnalysis::grindFlowModeRanges(
+    const QList<HistoryPhaseMarker>& phases, double pourStart, double pourEnd)
+{
+    // Inclusive flow-mode time ranges from phase markers. A sample at
+    // time t qualifies only when it falls inside a flow-mode phase; this
+    // gates out pressure-controlled phases whose "flow goal" is really a
+    // safety limiter (80's Espresso rise+decline, Cremina lever, Londinium
+    // pour, etc.) — comparing actual flow against that ceiling is the
+    // canonical false-positive source.
+    //
+    // Two boundary trims (see GRIND_*_SKIP_SEC in shotanalysis.h) apply
+    // within each flow-mode range so we don't average pump-ramp lag or the
+    // post-limiter-engaged tail. Without them the lever preinfusion shape
+    // (pump-ramp at start + pressure ceiling activates at end) reads as a
+    // sustained "too fine" delta even on clean shots.
+    QVector<TimeRange> ranges(phases.size());
+    {
+        // Pump-ramp trim applies to the first flow-mode phase that
+        // coincides with pourStart — that's the one where the pump goes
+        // from idle to commanded flow. A flow-mode phase that starts
+        // before pourStart (e.g. a fill phase) has its samples filtered
+        // out by the pour-window gate below anyway; consuming the
+        // "first seen" flag on it would silently skip the trim where it
+        // actually belongs. The 0.1 s margin absorbs BLE timestamp jitter.
+        //
+        // Both trims are gated on the resulting range staying at least
+        // kMinPostTrimRangeSec long. On extreme puck-failure shots —
+        // where the firmware bails out within a couple of seconds because
+        // the puck offers no resistance — the first flow-mode phase can
+        // be a fraction of a second. Trimming 0.5 s off the front of that
+        // phase would leave nothing to analyze and the detector would
+        // silently report no-data instead of catching the obvious gusher.
+        constexpr double kMinPostTrimRangeSec = 1.0;
+        bool firstFlowModeAtPourStartSeen = false;
+        for (qsizetype i = 0; i < phases.size(); ++i) {
+            if (!phases[i].isFlowMode) continue;
+            double start = phases[i].time;
+            double end = (i + 1 < phases.size()) ? phases[i + 1].time : pourEnd;
+            if (!firstFlowModeAtPourStartSeen
+                && phases[i].time + 0.1 >= pourStart) {
+                if ((end - start) - GRIND_PUMP_RAMP_SKIP_SEC >= kMinPostTrimRangeSec) {
+                    start += GRIND_PUMP_RAMP_SKIP_SEC;
+                }
+                firstFlowModeAtPourStartSeen = true;
+            }
+            if (i + 1 < phases.size()
+                && phases[i + 1].transitionReason.compare(
+                       QStringLiteral("pressure"), Qt::CaseInsensitive) == 0) {
+                if ((end - start) - GRIND_LIMITER_TAIL_SKIP_SEC >= kMinPostTrimRangeSec) {
+                    end -= GRIND_LIMITER_TAIL_SKIP_SEC;
+                }
+            }
+            ranges[i] = {start, end};
+        }
+    }
+    return ranges;
+}
+
+QVector<ShotAnalysis::TimeRange> ShotAnalysis::grindPressureModeRanges(
+    const QList<HistoryPhaseMarker>& phases, double pourEnd)
+{
+    QVector<TimeRange> ranges(phases.size());
+    for (qsizetype i = 0; i < phases.size(); ++i) {
+        if (phases[i].isFlowMode) continue;
+        ranges[i].start = phases[i].time;
+        ranges[i].end = (i + 1 < phases.size()) ? phases[i + 1].time : pourEnd;
+    }
+    return ranges;
+}
+
+void ShotAnalysis::applyFlowVsGoalAverages(GrindCheck& result, double actualSum, double goalSum,
+                                           qsizetype count)
+{
+    result.sampleCount = count;
+    if (count >= 5) {
+        result.hasData = true;
+        result.delta = (actualSum / count) - (goalSum / count);
+    }
+}
+
+void ShotAnalysis::applyChokedPuckArms(GrindCheck& result, qsizetype flowSamples,
+                                       double pressurizedDuration, double flowSum,
+                                       double targetWeightG, double finalWeightG)
+{
+    // Two arms with split gates:
+    //  - Flow arm needs sustained pressurized flow (≥ 15s ≥ 4 bar) to
+    //    compute a meaningful mean-flow average.
+    //  - Yield arm only needs ≥ 5 pressurized samples (puck saw
+    //    meaningful pressure briefly); its diagnosis is yield-based
+    //    and does not read mean pressurized flow.
+    // The shared gate previously hid shot 745-class misses (Adaptive v2,
+    // 35s pour, 64% yield, ~8.8 s pressurized) — silenced by the 15s gate
+    // even though the yield arm could have spoken. See openspec change
+    // tighten-grind-yield-shortfall-arm and #963.
+    if (flowSamples >= 5) {
+        const bool flowArmGatesPassed = (pressurizedDuration >= CHOKED_DURATION_MIN_SEC);
+
+        bool flowChoked = false;
+        if (flowArmGatesPassed) {
+            const double meanFlow = flowSum / flowSamples;
+            flowChoked = meanFlow < CHOKED_FLOW_MAX_MLPS;
+        }
+
+        // Yield-ratio arm: same diagnosis (grind too fine), milder severity.
+        // Catches shots like 745 (Adaptive v2, 64% of target with brief
+        // pressurized window). finalWeightG works on either real or virtual
+        // scale (FlowScale integrates flow with dose-aware puck-absorption
+        // compensation), so this fires headless too.
+        const bool yieldShortfall = targetWeightG > 0.0
+            && finalWeightG > 0.0
+            && (finalWeightG / targetWeightG) < CHOKED_YIELD_RATIO_MAX;
+
+        // hasData when any arm could speak: the flow arm's gates passed
+        // (regardless of whether choke fired) OR the yield arm fired.
+        // Verified-clean still requires the strong flow-arm gates.
+        if (flowArmGatesPassed || yieldShortfall) {
+            result.hasData = true;
+        }
+
+        if (flowChoked || yieldShortfall) {
+            result.chokedPuck = true;
+            result.sampleCount = flowSamples;
+            // Leave delta carrying its flow-vs-goal meaning; consumers
+            // short-circuit on chokedPuck before reading delta.
+        } else if (flowArmGatesPassed
+                   && !result.yieldOvershoot
+                   && std::abs(result.delta) <= FLOW_DEVIATION_THRESHOLD) {
+            // Flow-arm gates passed, no choke fired, no overshoot, and
+            // Arm 1 (if it ran) found delta within tolerance. The puck
+            // behaved through a sustained pressurized pour — strong verify.
+            result.verifiedClean = true;
+            // Leave sampleCount as Arm 1 set it. Arm 1 assigns sampleCount
+            // before its own count >= 5 gate, so the value here is whatever
+            // Arm 1 saw — could be the qualifying-samples count (≥ 5) when
+            // Arm 1 produced data, a partial count (1-4) when Arm 1 ran
+            // but didn't pass its gate, or 0 when Arm 1's block was
+            // bypassed entirely (empty flowModeRanges or no flowGoal).
+        }
+    }
+}
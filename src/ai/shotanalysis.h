@@ -151,7 +151,7 @@ public:
 
     // --- Helpers ---
 
-    // Find Y value at a given time using linear search (data assumed sorted by X).
+    // Y value of the first point at or after the given time, binary search (data sorted by X).
     static double findValueAtTime(const QVector<QPointF>& data, double time);
 
     // --- User-facing shot summary ---
@@ -526,4 +526,63 @@ public:
                                          double targetWeightG = 0.0,
                                          double finalWeightG = 0.0,
                                          int expectedFrameCount = -1);
+
+    // --- Detector building blocks ---
+    // The predicates and arithmetic the batch detectors above are built
+    // from. Exposed so LiveShotAnalysis can evaluate the same rules one
+    // sample at a time during extraction: its end-of-shot verdicts must
+    // match the batch detectors exactly, so both sides call these rather
+    // than keeping a second copy of the thresholds and formulas.
+
+    // Phase boundaries analyzeShot gates every detector on. pourStart is
+    // the last "pour" marker (falling back to the last "infus"/"start"
+    // marker), pourEnd the last "end" marker or `duration` when absent.
+    struct PourWindow {
+        double preinfusionEnd = 0.0;
+        double pourStart = 0.0;
+        double pourEnd = 0.0;
+    };
+    static PourWindow findPourWindow(const QList<HistoryPhaseMarker>& phases, double duration);
+
+    // Filter/pourover/tea/steam/cleaning — beverage types with no puck for
+    // the channeling, grind and pour-truncated detectors to score.
+    static bool isNonEspressoBeverage(const QString& beverageType);
+
+    // Per-sample inclusion test behind buildChannelingWindows(): active goal
+    // stationary across ±WINDOW_HALF_SEC, actual converged onto it, and
+    // pressure not rising fast over the next WINDOW_HALF_SEC. Reads the
+    // series at t - WINDOW_HALF_SEC .. t + WINDOW_HALF_SEC only; phases
+    // must be non-empty. Series must be sorted by time.
+    static bool channelingWindowQualifies(const QVector<QPointF>& pressure,
+                                          const QVector<QPointF>& flow,
+                                          const QVector<QPointF>& pressureGoal,
+                                          const QVector<QPointF>& flowGoal,
+                                          const QList<HistoryPhaseMarker>& phases,
+                                          double t);
+
+    // Severity from the tallies detectChannelingFromDerivative() accumulates.
+    static ChannelingSeverity classifyChanneling(int elevatedCount, double maxSpike);
+
+    // Inclusive time range. The range builders below return one entry per
+    // phase marker (index-aligned with `phases`); entries with end <= start
+    // are empty and match nothing. A phase's entry only depends on pourEnd
+    // when it is the last phase.
+    struct TimeRange {
+        double start = 0.0;
+        double end = 0.0;
+    };
+    // Flow-mode phases with the pump-ramp and limiter-tail trims applied
+    // (see GRIND_*_SKIP_SEC) — the flow-vs-goal averaging mask.
+    static QVector<TimeRange> grindFlowModeRanges(const QList<HistoryPhaseMarker>& phases,
+                                                  double pourStart, double pourEnd);
+    // Pressure-mode phases, untrimmed — the choked-puck mask.
+    static QVector<TimeRange> grindPressureModeRanges(const QList<HistoryPhaseMarker>& phases,
+                                                      double pourEnd);
+
+    // The analyzeFlowVsGoal() arms, applied to already-accumulated sums.
+    static void applyFlowVsGoalAverages(GrindCheck& result, double actualSum, double goalSum,
+                                        qsizetype count);
+    static void applyChokedPuckArms(GrindCheck& result, qsizetype flowSamples,
+                                    double pressurizedDuration, double flowSum,
+                                    double targetWeightG, double finalWeightG);
 };
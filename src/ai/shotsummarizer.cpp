@@ -1,5 +1,6 @@
 #include "shotsummarizer.h"
 #include "shotanalysis.h"
+#include "curveindex.h"
 #include "../history/shothistory_types.h"  // HistoryPhaseMarker — passed to ShotAnalysis::analyzeShot
 #include "../models/shotdatamodel.h"
 #include "../profile/profile.h"
@@ -102,6 +103,11 @@ QList<PhaseSummary> ShotSummarizer::buildPhaseSummariesForRange(
     const QList<HistoryPhaseMarker>& markers,
     double totalDuration)
 {
+    // Indexed once so each phase's window statistics are O(1)
+    const CurveIndex pressureIndex(pressure);
+    const CurveIndex flowIndex(flow);
+    const CurveIndex temperatureIndex(temperature);
+
     QList<PhaseSummary> phases;
     phases.reserve(markers.size());
     for (qsizetype i = 0; i < markers.size(); i++) {
@@ -123,21 +129,23 @@ QList<PhaseSummary> ShotSummarizer::buildPhaseSummariesForRange(
         phase.duration = endTime - startTime;
         phase.isFlowMode = marker.isFlowMode;
 
-        phase.avgPressure = calculateAverage(pressure, startTime, endTime);
-        phase.maxPressure = calculateMax(pressure, startTime, endTime);
-        phase.minPressure = calculateMin(pressure, startTime, endTime);
+        const CurveIndex::Stats pressureStats = pressureIndex.stats(startTime, endTime);
+        phase.avgPressure = pressureStats.mean;
+        phase.maxPressure = pressureStats.max;
+        phase.minPressure = pressureStats.min;
         phase.pressureAtStart = findValueAtTime(pressure, startTime);
         phase.pressureAtMiddle = findValueAtTime(pressure, (startTime + endTime) / 2);
         phase.pressureAtEnd = findValueAtTime(pressure, endTime);
 
-        phase.avgFlow = calculateAverage(flow, startTime, endTime);
-        phase.maxFlow = calculateMax(flow, startTime, endTime);
-        phase.minFlow = calculateMin(flow, startTime, endTime);
+        const CurveIndex::Stats flowStats = flowIndex.stats(startTime, endTime);
+        phase.avgFlow = flowStats.mean;
+        phase.maxFlow = flowStats.max;
+        phase.minFlow = flowStats.min;
         phase.flowAtStart = findValueAtTime(flow, startTime);
         phase.flowAtMiddle = findValueAtTime(flow, (startTime + endTime) / 2);
         phase.flowAtEnd = findValueAtTime(flow, endTime);
 
-        phase.avgTemperature = calculateAverage(temperature, startTime, endTime);
+        phase.avgTemperature = temperatureIndex.mean(startTime, endTime);
 
         if (!weight.isEmpty()) {
             const double startWeight = findValueAtTime(weight, startTime);
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QDateTime>
+#include <QElapsedTimer>
+
+/**
+ * Monotonic clock for notification arrival stamps.
+ *
+ * Transports stamp each notification the moment they receive it, before it
+ * waits in any event queue, and the stamp travels with the data (ShotSample,
+ * ScaleDevice::weightChanged, WeightProcessor::processWeight). Readings are
+ * QElapsedTimer's reference clock in milliseconds: they only mean something
+ * relative to each other, but they compare across threads and never jump
+ * with wall-clock changes.
+ */
+namespace ArrivalClock {
+
+inline qint64 nowMs()
+{
+    QElapsedTimer timer;
+    timer.start();
+    return timer.msecsSinceReference();
+}
+
+// Wall-clock time (ms since epoch) at which a stamp was taken, for code that
+// stores or displays absolute times
+inline qint64 toEpochMs(qint64 arrivalMs)
+{
+    return QDateTime::currentMSecsSinceEpoch() - (nowMs() - arrivalMs);
+}
+
+} // namespace ArrivalClock
@@ -0,0 +1,269 @@
+#include "blecapture.h"
+#include "de1transport.h"
+#include "transport/scalebletransport.h"
+
+#include <QDebug>
+#include <QIODevice>
+#include <QUuid>
+#include <algorithm>
+
+namespace {
+
+constexpr quint8 TAG_UUID = 0x01;
+constexpr quint8 TAG_EVENT = 0x02;
+constexpr int UUID_BYTES = 16;
+constexpr int MAX_UUIDS = 256;
+
+void appendVarUInt(QByteArray& out, quint64 value)
+{
+    do {
+        quint8 byte = value & 0x7F;
+        value >>= 7;
+        if (value) byte |= 0x80;
+        out.append(static_cast<char>(byte));
+    } while (value);
+}
+
+// Cursor over the whole file; every read fails cleanly at the end of data
+class Cursor {
+public:
+    explicit Cursor(const QByteArray& data) : m_data(data) {}
+
+    bool atEnd() const { return m_pos >= m_data.size(); }
+
+    bool readU8(quint8* value)
+    {
+        if (m_pos >= m_data.size()) return false;
+        *value = static_cast<quint8>(m_data[m_pos++]);
+        return true;
+    }
+
+    bool readVarUInt(quint64* value)
+    {
+        quint64 result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            quint8 byte;
+            if (!readU8(&byte)) return false;
+            result |= quint64(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readBytes(qsizetype length, QByteArray* out)
+    {
+        if (length < 0 || m_data.size() - m_pos < length) return false;
+        *out = m_data.mid(m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+private:
+    const QByteArray& m_data;
+    qsizetype m_pos = 0;
+};
+
+} // namespace
+
+// -- Reading --
+
+bool BleCapture::read(QIODevice* device, QList<BleCaptureRecord>* records, QString* error)
+{
+    records->clear();
+    const QByteArray data = device->readAll();
+    if (data.size() < 5 || !data.startsWith(QByteArray(MAGIC, sizeof(MAGIC)))) {
+        if (error) *error = QStringLiteral("not a BLE capture file");
+        return false;
+    }
+    if (static_cast<quint8>(data[4]) != VERSION) {
+        if (error) *error = QStringLiteral("unsupported capture version %1").arg(static_cast<quint8>(data[4]));
+        return false;
+    }
+
+    const QByteArray body = data.mid(5);
+    Cursor cursor(body);
+    QList<QBluetoothUuid> uuids(MAX_UUIDS);
+    qint64 timestampUs = 0;
+
+    while (!cursor.atEnd()) {
+        quint8 tag;
+        if (!cursor.readU8(&tag)) break;
+
+        if (tag == TAG_UUID) {
+            quint8 index;
+            QByteArray raw;
+            if (!cursor.readU8(&index) || !cursor.readBytes(UUID_BYTES, &raw)) break;
+            uuids[index] = QBluetoothUuid(QUuid::fromRfc4122(raw));
+        } else if (tag == TAG_EVENT) {
+            quint64 deltaUs, length;
+            quint8 source, kind, index;
+            BleCaptureRecord record;
+            if (!cursor.readVarUInt(&deltaUs) || !cursor.readU8(&source) || !cursor.readU8(&kind)
+                || !cursor.readU8(&index) || !cursor.readVarUInt(&length)
+                || !cursor.readBytes(static_cast<qsizetype>(length), &record.payload)) {
+                break;
+            }
+            timestampUs += static_cast<qint64>(deltaUs);
+            record.timestampUs = timestampUs;
+            record.source = static_cast<BleCaptureRecord::Source>(source);
+            record.kind = static_cast<BleCaptureRecord::Kind>(kind);
+            record.uuid = uuids[index];
+            records->append(record);
+        } else {
+            if (error) *error = QStringLiteral("unknown record tag 0x%1").arg(int(tag), 2, 16, QChar('0'));
+            break;
+        }
+    }
+    return true;
+}
+
+bool BleCapture::readFile(const QString& path, QList<BleCaptureRecord>* records, QString* error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return read(&file, records, error);
+}
+
+// -- Writing --
+
+BleCaptureWriter::BleCaptureWriter(QIODevice* device)
+    : m_device(device)
+{
+    QByteArray header(BleCapture::MAGIC, sizeof(BleCapture::MAGIC));
+    header.append(static_cast<char>(BleCapture::VERSION));
+    m_device->write(header);
+}
+
+bool BleCaptureWriter::append(const BleCaptureRecord& record)
+{
+    m_buffer.clear();
+
+    qsizetype index = m_uuids.indexOf(record.uuid);
+    if (index < 0) {
+        if (m_uuids.size() >= MAX_UUIDS) return false;
+        index = m_uuids.size();
+        m_uuids.append(record.uuid);
+        m_buffer.append(static_cast<char>(TAG_UUID));
+        m_buffer.append(static_cast<char>(index));
+        m_buffer.append(QUuid(record.uuid).toRfc4122());
+    }
+
+    const qint64 deltaUs = std::max<qint64>(0, record.timestampUs - m_lastTimestampUs);
+    m_lastTimestampUs = std::max(m_lastTimestampUs, record.timestampUs);
+
+    m_buffer.append(static_cast<char>(TAG_EVENT));
+    appendVarUInt(m_buffer, static_cast<quint64>(deltaUs));
+    m_buffer.append(static_cast<char>(record.source));
+    m_buffer.append(static_cast<char>(record.kind));
+    m_buffer.append(static_cast<char>(index));
+    appendVarUInt(m_buffer, static_cast<quint64>(record.payload.size()));
+    m_buffer.append(record.payload);
+
+    if (m_device->write(m_buffer) != m_buffer.size()) return false;
+    ++m_records;
+    return true;
+}
+
+// -- Tap --
+
+BleCaptureTap* BleCaptureTap::s_instance = nullptr;
+
+BleCaptureTap::BleCaptureTap(QObject* parent)
+    : QObject(parent)
+{
+    // Bound what a crash can lose without a syscall per notification
+    m_flushTimer.setInterval(1000);
+    connect(&m_flushTimer, &QTimer::timeout, this, [this]() { m_file.flush(); });
+}
+
+BleCaptureTap::~BleCaptureTap()
+{
+    stop();
+}
+
+bool BleCaptureTap::start(const QString& path)
+{
+    stop();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning().noquote() << "[BLE capture] Cannot open" << path << "-" << m_file.errorString();
+        return false;
+    }
+    m_writer = std::make_unique<BleCaptureWriter>(&m_file);
+    m_clock.start();
+    m_flushTimer.start();
+    s_instance = this;
+    qDebug().noquote() << "[BLE capture] Recording to" << path;
+    return true;
+}
+
+void BleCaptureTap::stop()
+{
+    if (s_instance == this) s_instance = nullptr;
+    if (!m_writer) return;
+    m_flushTimer.stop();
+    qDebug().noquote() << "[BLE capture] Stopped after" << m_writer->recordCount() << "events";
+    m_writer.reset();
+    m_file.close();
+}
+
+void BleCaptureTap::attach(DE1Transport* transport)
+{
+    if (!transport) return;
+    connect(transport, &DE1Transport::dataReceived,
+            this, &BleCaptureTap::onDe1Data, Qt::UniqueConnection);
+    connect(transport, &DE1Transport::writeComplete,
+            this, &BleCaptureTap::onDe1WriteComplete, Qt::UniqueConnection);
+}
+
+void BleCaptureTap::attach(ScaleBleTransport* transport)
+{
+    if (!transport) return;
+    connect(transport, &ScaleBleTransport::characteristicChanged,
+            this, &BleCaptureTap::onScaleChanged, Qt::UniqueConnection);
+    connect(transport, &ScaleBleTransport::characteristicRead,
+            this, &BleCaptureTap::onScaleRead, Qt::UniqueConnection);
+}
+
+void BleCaptureTap::onDe1Data(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs)
+{
+    record(BleCaptureRecord::Source::DE1, BleCaptureRecord::Kind::Notification, uuid, data, arrivalMs);
+}
+
+void BleCaptureTap::onDe1WriteComplete(const QBluetoothUuid& uuid, const QByteArray& data)
+{
+    record(BleCaptureRecord::Source::DE1, BleCaptureRecord::Kind::Write, uuid, data);
+}
+
+void BleCaptureTap::onScaleChanged(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs)
+{
+    record(BleCaptureRecord::Source::Scale, BleCaptureRecord::Kind::Notification, uuid, data, arrivalMs);
+}
+
+void BleCaptureTap::onScaleRead(const QBluetoothUuid& uuid, const QByteArray& data)
+{
+    record(BleCaptureRecord::Source::Scale, BleCaptureRecord::Kind::Read, uuid, data);
+}
+
+void BleCaptureTap::record(BleCaptureRecord::Source source, BleCaptureRecord::Kind kind,
+                           const QBluetoothUuid& uuid, const QByteArray& payload, qint64 arrivalMs)
+{
+    if (!m_writer) return;
+    BleCaptureRecord record;
+    // Notifications keep the time they reached the transport, not the time the
+    // tap's queued slot ran; both clocks are QElapsedTimer's reference clock
+    record.timestampUs = arrivalMs > 0
+        ? std::max<qint64>(0, (arrivalMs - m_clock.msecsSinceReference()) * 1000)
+        : m_clock.nsecsElapsed() / 1000;
+    record.source = source;
+    record.kind = kind;
+    record.uuid = uuid;
+    record.payload = payload;
+    m_writer->append(record);
+}
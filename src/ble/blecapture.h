@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QObject>
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QTimer>
+#include <memory>
+
+class DE1Transport;
+class ScaleBleTransport;
+class QIODevice;
+
+/**
+ * Raw BLE capture: every characteristic notification (and DE1 write ACK)
+ * seen by the DE1 and scale transports, with a monotonic timestamp, so field
+ * issues can be replayed through the real pipeline (see ReplayTransport).
+ *
+ * File format ("varuint" = unsigned LEB128):
+ *
+ *   header   "DCAP" | u8 version (1)
+ *   record   u8 tag, then per tag:
+ *     0x01   UUID definition: u8 index | 16 bytes RFC 4122 UUID
+ *     0x02   event: varuint µs since previous event (first: since capture
+ *            start) | u8 source (0 DE1, 1 scale) | u8 kind (0 notification,
+ *            1 read response, 2 write) | u8 UUID index | varuint length |
+ *            payload
+ *
+ * UUIDs are defined once, the first time they're used, so a typical event is
+ * 5-6 bytes of framing plus its payload. A file cut short by a crash reads
+ * back up to the last complete event.
+ */
+struct BleCaptureRecord {
+    enum class Source : quint8 { DE1 = 0, Scale = 1 };
+    enum class Kind : quint8 { Notification = 0, Read = 1, Write = 2 };
+
+    qint64 timestampUs = 0;  // Monotonic, from the start of the capture
+    Source source = Source::DE1;
+    Kind kind = Kind::Notification;
+    QBluetoothUuid uuid;
+    QByteArray payload;
+};
+
+namespace BleCapture {
+constexpr char MAGIC[4] = {'D', 'C', 'A', 'P'};
+constexpr quint8 VERSION = 1;
+
+// Reads every complete event. Returns false (with *error set) only when the
+// header is missing or wrong; a truncated tail just ends the list.
+bool read(QIODevice* device, QList<BleCaptureRecord>* records, QString* error = nullptr);
+bool readFile(const QString& path, QList<BleCaptureRecord>* records, QString* error = nullptr);
+}
+
+// Appends records to an open device. A timestamp earlier than the previous
+// record's is written as the previous one, so the file stays in time order.
+class BleCaptureWriter {
+public:
+    explicit BleCaptureWriter(QIODevice* device);  // Writes the file header
+
+    bool append(const BleCaptureRecord& record);
+    qint64 recordCount() const { return m_records; }
+
+private:
+    QIODevice* m_device;
+    QList<QBluetoothUuid> m_uuids;  // Index = position; at most 256
+    qint64 m_lastTimestampUs = 0;
+    qint64 m_records = 0;
+    QByteArray m_buffer;
+};
+
+/**
+ * Records the traffic of attached transports to a capture file.
+ *
+ * main.cpp starts one when DECENZA_BLE_CAPTURE names a file; while it is
+ * recording, instance() returns it and DE1Device::setTransport() and
+ * ScaleFactory attach every transport they create.
+ */
+class BleCaptureTap : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BleCaptureTap(QObject* parent = nullptr);
+    ~BleCaptureTap() override;
+
+    // The recording tap, or nullptr
+    static BleCaptureTap* instance() { return s_instance; }
+
+    bool start(const QString& path);
+    void stop();
+    bool isRecording() const { return m_writer != nullptr; }
+
+    void attach(DE1Transport* transport);
+    void attach(ScaleBleTransport* transport);
+
+private slots:
+    void onDe1Data(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs);
+    void onDe1WriteComplete(const QBluetoothUuid& uuid, const QByteArray& data);
+    void onScaleChanged(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs);
+    void onScaleRead(const QBluetoothUuid& uuid, const QByteArray& data);
+
+private:
+    // arrivalMs: the transport's ArrivalClock stamp; 0 = unstamped, use now
+    void record(BleCaptureRecord::Source source, BleCaptureRecord::Kind kind,
+                const QBluetoothUuid& uuid, const QByteArray& payload, qint64 arrivalMs = 0);
+
+    QFile m_file;
+    std::unique_ptr<BleCaptureWriter> m_writer;
+    QElapsedTimer m_clock;
+    QTimer m_flushTimer;
+
+    static BleCaptureTap* s_instance;
+};
@@ -1,4 +1,5 @@
 #include "bletransport.h"
+#include "arrivalclock.h"
 #include "blecapability.h"
 #ifndef DECENZA_TESTING
 #include "blemanager.h"
@@ -89,37 +90,22 @@ static void stopBleConnectionService() {
 
 BleTransport::BleTransport(QObject* parent)
     : DE1Transport(parent)
+    , m_scheduler([this](const QBluetoothUuid& uuid, const QByteArray& data) { return writeCharacteristic(uuid, data); },
+                  [this](const QBluetoothUuid& uuid) { return readCharacteristic(uuid); })
 {
-    m_commandTimer.setInterval(50);  // Process queue every 50ms
-    m_commandTimer.setSingleShot(true);
-    connect(&m_commandTimer, &QTimer::timeout, this, &BleTransport::processCommandQueue);
-
-    // Write timeout timer - detect hung BLE writes (like de1app)
-    m_writeTimeoutTimer.setSingleShot(true);
-    m_writeTimeoutTimer.setInterval(WRITE_TIMEOUT_MS);
-    connect(&m_writeTimeoutTimer, &QTimer::timeout, this, [this]() {
-        if (m_writePending) {
-            m_writePending = false;
-            if (m_lastCommand && m_writeRetryCount < MAX_WRITE_RETRIES) {
-                m_writeRetryCount++;
-                log(QString("Write timeout, retrying %1/%2 (uuid=%3)")
-                    .arg(m_writeRetryCount).arg(MAX_WRITE_RETRIES).arg(m_lastWriteUuid));
-                QTimer::singleShot(WRITE_RETRY_DELAY_MS, this, [this]() {
-                    if (m_lastCommand) {
-                        m_lastCommand();
-                    }
-                });
-            } else {
-                warn(QString("Write FAILED after %1 retries (uuid=%2, %3 bytes)")
-                    .arg(MAX_WRITE_RETRIES).arg(m_lastWriteUuid).arg(m_lastWriteData.size()));
-                emit errorOccurred(QString("BLE write failed after %1 retries").arg(MAX_WRITE_RETRIES));
-                m_lastCommand = nullptr;
-                m_writeRetryCount = 0;
-                processCommandQueue();  // Move on to next command
-                if (!m_writePending && m_commandQueue.isEmpty())
-                    emit queueDrained();
-            }
-        }
+    connect(&m_scheduler, &BleWriteScheduler::writeAcknowledged, this, &BleTransport::writeComplete);
+    connect(&m_scheduler, &BleWriteScheduler::drained, this, &BleTransport::queueDrained);
+    connect(&m_scheduler, &BleWriteScheduler::writeRetrying, this,
+            [this](const QBluetoothUuid& uuid, int attempt, const QString& reason) {
+        log(QString("Write %1, retrying %2/%3 (uuid=%4, window=1)")
+            .arg(reason).arg(attempt).arg(BleWriteScheduler::MAX_WRITE_RETRIES)
+            .arg(uuid.toString().mid(1, 8)));
+    });
+    connect(&m_scheduler, &BleWriteScheduler::writeAbandoned, this,
+            [this](const QBluetoothUuid& uuid, const QByteArray& data) {
+        warn(QString("Write FAILED after %1 retries (uuid=%2, %3 bytes)")
+            .arg(BleWriteScheduler::MAX_WRITE_RETRIES).arg(uuid.toString().mid(1, 8)).arg(data.size()));
+        emit errorOccurred(QString("BLE write failed after %1 retries").arg(BleWriteScheduler::MAX_WRITE_RETRIES));
     });
 
     // Retry timer for failed service discovery
@@ -159,40 +145,32 @@ BleTransport::~BleTransport() {
 // -- DE1Transport interface implementation --
 
 void BleTransport::write(const QBluetoothUuid& uuid, const QByteArray& data) {
-    queueCommand([this, uuid, data]() {
-        writeCharacteristic(uuid, data);
-    });
+    m_scheduler.enqueueWrite(uuid, data);
 }
 
 void BleTransport::writeUrgent(const QBluetoothUuid& uuid, const QByteArray& data) {
-    // Bypass the 50ms command queue for immediate write. Does NOT clear the queue —
-    // callers that need to clear (SAW, sleep) do so explicitly before calling this.
-    // This allows ensureChargerOn (app suspend) to write urgently without dropping
-    // any pending extraction frames.
-    //
-    // If a write is already in-flight, prepend to the queue instead of calling
-    // writeCharacteristic directly — writeCharacteristic is not re-entrant and would
-    // corrupt m_writePending/m_lastWriteUuid/m_writeTimeoutTimer state.
-    if (m_writePending) {
-        m_commandQueue.prepend([this, uuid, data]() {
-            writeCharacteristic(uuid, data);
-        });
-    } else {
-        writeCharacteristic(uuid, data);
-    }
+    // Goes straight to the stack unless the in-flight window is completely
+    // full, in which case it jumps to the head of the queue. Does NOT clear
+    // the queue — callers that need to clear (SAW, sleep) do so explicitly
+    // before calling this. This allows ensureChargerOn (app suspend) to write
+    // urgently without dropping any pending extraction frames.
+    m_scheduler.writeUrgent(uuid, data);
+}
+
+void BleTransport::writeInLane(const QBluetoothUuid& uuid, const QByteArray& data,
+                               WriteLane lane, const QByteArray& coalesceKey) {
+    m_scheduler.enqueueWrite(uuid, data,
+                             lane == WriteLane::Background ? BleWriteScheduler::Background
+                                                           : BleWriteScheduler::Interactive,
+                             coalesceKey);
 }
 
 void BleTransport::read(const QBluetoothUuid& uuid) {
-    // Queue the read so it runs after any pending writes complete. Without
-    // queueing, a read issued right after a write executes immediately and
-    // returns the pre-write value, defeating any read-after-write verification.
-    queueCommand([this, uuid]() {
-        if (!m_service || !m_characteristics.contains(uuid)) {
-            log(QString("read(%1) skipped - %2").arg(uuid.toString().mid(1, 8), !m_service ? "no service" : "unknown characteristic"));
-            return;
-        }
-        m_service->readCharacteristic(m_characteristics[uuid]);
-    });
+    // Queue the read so it runs after any pending writes are acknowledged.
+    // Without queueing, a read issued right after a write executes immediately
+    // and returns the pre-write value, defeating any read-after-write
+    // verification. The scheduler holds reads until nothing is in flight.
+    m_scheduler.enqueueRead(uuid);
 }
 
 void BleTransport::subscribe(const QBluetoothUuid& uuid) {
@@ -232,13 +210,7 @@ void BleTransport::subscribeAll() {
 }
 
 void BleTransport::disconnect() {
-    m_commandQueue.clear();
-    m_writePending = false;
-    m_writeTimeoutTimer.stop();
-    m_lastCommand = nullptr;
-    m_writeRetryCount = 0;
-    m_lastWriteUuid.clear();
-    m_lastWriteData.clear();
+    m_scheduler.clear();
 
     // Stop any pending retries
     m_retryTimer.stop();
@@ -274,19 +246,10 @@ void BleTransport::disconnect() {
 }
 
 qsizetype BleTransport::clearQueue() {
-    // processCommandQueue dequeues a command before dispatching it, so the
-    // currently-in-flight write is no longer in m_commandQueue but is still
-    // live (m_writePending=true). Count it too — otherwise an aborted MMR
-    // write would leave m_lastMMRValues claiming the DE1 has the value.
-    qsizetype cleared = m_commandQueue.size() + (m_writePending ? 1 : 0);
-    m_commandQueue.clear();
-    m_writePending = false;
-    m_writeTimeoutTimer.stop();
-    m_lastCommand = nullptr;
-    m_writeRetryCount = 0;
-    m_lastWriteUuid.clear();
-    m_lastWriteData.clear();
-    return cleared;
+    // Writes already handed to the stack but not yet acknowledged count too —
+    // otherwise an aborted MMR write would leave m_lastMMRValues claiming the
+    // DE1 has the value.
+    return m_scheduler.clear();
 }
 
 bool BleTransport::isConnected() const {
@@ -355,10 +318,7 @@ void BleTransport::onControllerDisconnected() {
 
     // Clear pending BLE operations to prevent writes against a dead connection,
     // which causes DeadObjectException crashes on Android (issue #189)
-    m_commandQueue.clear();
-    m_writePending = false;
-    m_writeTimeoutTimer.stop();
-    m_commandTimer.stop();
+    m_scheduler.clear();
     m_characteristicsReady = false;
 
     if (!m_disconnectedEmittedForAttempt) {
@@ -466,29 +426,10 @@ void BleTransport::onServiceDiscovered(const QBluetoothUuid& uuid) {
                 // Log but don't fail on descriptor errors - common on Windows
                 if (error != QLowEnergyService::DescriptorReadError &&
                     error != QLowEnergyService::DescriptorWriteError) {
-                    // Handle write errors with retry (like de1app)
-                    if (error == QLowEnergyService::CharacteristicWriteError && m_writePending) {
-                        m_writePending = false;
-                        m_writeTimeoutTimer.stop();
-                        if (m_lastCommand && m_writeRetryCount < MAX_WRITE_RETRIES) {
-                            m_writeRetryCount++;
-                            log(QString("CharacteristicWriteError, retrying %1/%2 (uuid=%3)")
-                                .arg(m_writeRetryCount).arg(MAX_WRITE_RETRIES).arg(m_lastWriteUuid));
-                            QTimer::singleShot(WRITE_RETRY_DELAY_MS, this, [this]() {
-                                if (m_lastCommand) {
-                                    m_lastCommand();
-                                }
-                            });
-                        } else {
-                            warn(QString("CharacteristicWriteError FAILED after %1 retries (uuid=%2)")
-                                .arg(MAX_WRITE_RETRIES).arg(m_lastWriteUuid));
-                            emit errorOccurred(QString("BLE write failed after %1 retries").arg(MAX_WRITE_RETRIES));
-                            m_lastCommand = nullptr;
-                            m_writeRetryCount = 0;
-                            processCommandQueue();
-                            if (!m_writePending && m_commandQueue.isEmpty())
-                                emit queueDrained();
-                        }
+                    // Handle write errors with back-off and retry (like de1app)
+                    if (error == QLowEnergyService::CharacteristicWriteError
+                        && m_scheduler.inFlightCount() > 0) {
+                        m_scheduler.writeFailed();
                     } else {
                         emit errorOccurred(QString("Service error: %1").arg(error));
                     }
@@ -550,22 +491,12 @@ void BleTransport::onServiceStateChanged(QLowEnergyService::ServiceState state)
 }
 
 void BleTransport::onCharacteristicChanged(const QLowEnergyCharacteristic& c, const QByteArray& value) {
-    emit dataReceived(c.uuid(), value);
+    emit dataReceived(c.uuid(), value, ArrivalClock::nowMs());
 }
 
 void BleTransport::onCharacteristicWritten(const QLowEnergyCharacteristic& c, const QByteArray& value) {
-    m_writePending = false;
-    m_writeTimeoutTimer.stop();
-    m_writeRetryCount = 0;
-    m_lastCommand = nullptr;
-    m_lastWriteUuid.clear();
-    m_lastWriteData.clear();
-
-    emit writeComplete(c.uuid(), value);
-    processCommandQueue();
-
-    if (!m_writePending && m_commandQueue.isEmpty())
-        emit queueDrained();
+    // Emits writeComplete() (and queueDrained() once idle) via the scheduler
+    m_scheduler.acknowledge(c.uuid(), value);
 }
 
 // -- Private helpers --
@@ -653,38 +584,20 @@ void BleTransport::setupService() {
     }
 }
 
-void BleTransport::writeCharacteristic(const QBluetoothUuid& uuid, const QByteArray& data) {
+bool BleTransport::writeCharacteristic(const QBluetoothUuid& uuid, const QByteArray& data) {
     if (!m_service || !m_characteristics.contains(uuid)) {
         log(QString("writeCharacteristic(%1) skipped - %2").arg(uuid.toString().mid(1, 8), !m_service ? "no service" : "unknown characteristic"));
-        return;
+        return false;
     }
-    m_writePending = true;
-    QString uuidShort = uuid.toString().mid(1, 8);
-    m_lastWriteUuid = uuidShort;
-    m_lastWriteData = data;
-    m_writeTimeoutTimer.start();
     m_service->writeCharacteristic(m_characteristics[uuid], data);
+    return true;
 }
 
-void BleTransport::queueCommand(std::function<void()> command) {
-    m_commandQueue.enqueue(command);
-    if (!m_writePending && !m_commandTimer.isActive()) {
-        m_commandTimer.start();
-    }
-}
-
-void BleTransport::processCommandQueue() {
-    if (m_writePending || m_commandQueue.isEmpty()) return;
-
-    auto command = m_commandQueue.dequeue();
-    m_lastCommand = command;  // Store for potential retry
-    command();
-
-    // Reads don't set m_writePending and don't re-enter via
-    // onCharacteristicWritten, so the queue would otherwise stall after a
-    // dispatched read until some other queueCommand() call. Re-arm the timer
-    // here so subsequent queued items continue draining.
-    if (!m_writePending && !m_commandQueue.isEmpty() && !m_commandTimer.isActive()) {
-        m_commandTimer.start();
+bool BleTransport::readCharacteristic(const QBluetoothUuid& uuid) {
+    if (!m_service || !m_characteristics.contains(uuid)) {
+        log(QString("read(%1) skipped - %2").arg(uuid.toString().mid(1, 8), !m_service ? "no service" : "unknown characteristic"));
+        return false;
     }
+    m_service->readCharacteristic(m_characteristics[uuid]);
+    return true;
 }
@@ -1,20 +1,22 @@
 #pragma once
 
 #include "de1transport.h"
+#include "blewritescheduler.h"
 
 #include <QBluetoothDeviceInfo>
 #include <QLowEnergyController>
 #include <QLowEnergyService>
 #include <QTimer>
-#include <QQueue>
-#include <functional>
 
 /**
  * BLE transport for DE1 communication.
  *
  * Implements DE1Transport using QLowEnergyController (Bluetooth Low Energy).
- * Manages the BLE command queue with 50ms inter-write spacing, write retry
- * logic, service discovery, and characteristic subscriptions.
+ * Writes and reads go through a BleWriteScheduler, which sends the next
+ * write as soon as the stack acknowledges the previous ones (small adaptive
+ * in-flight window, back-off and retry on errors or timeouts, priority
+ * lanes, coalescing of superseded writes). Also handles service discovery
+ * and characteristic subscriptions.
  *
  * Lifecycle:
  *   1. Construct BleTransport
@@ -35,6 +37,8 @@ public:
     // -- DE1Transport interface --
     void write(const QBluetoothUuid& uuid, const QByteArray& data) override;
     void writeUrgent(const QBluetoothUuid& uuid, const QByteArray& data) override;
+    void writeInLane(const QBluetoothUuid& uuid, const QByteArray& data,
+                     WriteLane lane, const QByteArray& coalesceKey = QByteArray()) override;
     void read(const QBluetoothUuid& uuid) override;
     void subscribe(const QBluetoothUuid& uuid) override;
     void subscribeAll() override;
@@ -42,6 +46,7 @@ public:
     qsizetype clearQueue() override;
     bool isConnected() const override;
     QString transportName() const override { return QStringLiteral("BLE"); }
+    QJsonObject queueStats() const override { return m_scheduler.statsJson(); }
 
     // -- BLE-specific API (not part of DE1Transport) --
 
@@ -62,15 +67,14 @@ private slots:
     void onServiceStateChanged(QLowEnergyService::ServiceState state);
     void onCharacteristicChanged(const QLowEnergyCharacteristic& c, const QByteArray& value);
     void onCharacteristicWritten(const QLowEnergyCharacteristic& c, const QByteArray& value);
-    void processCommandQueue();
 
 private:
     void log(const QString& message);
     void warn(const QString& message);
     bool setupController(const QBluetoothDeviceInfo& device);
     void setupService();
-    void writeCharacteristic(const QBluetoothUuid& uuid, const QByteArray& data);
-    void queueCommand(std::function<void()> command);
+    bool writeCharacteristic(const QBluetoothUuid& uuid, const QByteArray& data);
+    bool readCharacteristic(const QBluetoothUuid& uuid);
 
     QLowEnergyController* m_controller = nullptr;
     QLowEnergyService* m_service = nullptr;
@@ -87,20 +91,8 @@ private:
     // corresponds to a subsequent m_controller->connectToDevice() call.
     bool m_disconnectedEmittedForAttempt = false;
 
-    // Command queue (50ms spacing between BLE writes)
-    QQueue<std::function<void()>> m_commandQueue;
-    QTimer m_commandTimer;
-    bool m_writePending = false;
-
-    // Write retry logic (like de1app)
-    std::function<void()> m_lastCommand;
-    int m_writeRetryCount = 0;
-    static constexpr int MAX_WRITE_RETRIES = 10;
-    QTimer m_writeTimeoutTimer;
-    static constexpr int WRITE_TIMEOUT_MS = 5000;
-    static constexpr int WRITE_RETRY_DELAY_MS = 500;
-    QString m_lastWriteUuid;
-    QByteArray m_lastWriteData;
+    // Write/read queue, driven by characteristicWritten acknowledgements
+    BleWriteScheduler m_scheduler;
 
     // Service discovery retry logic
     QBluetoothDeviceInfo m_pendingDevice;
@@ -0,0 +1,324 @@
+#include "blewritescheduler.h"
+
+#include <algorithm>
+
+BleWriteScheduler::BleWriteScheduler(WriteFn writeFn, ReadFn readFn, QObject* parent)
+    : QObject(parent)
+    , m_writeFn(std::move(writeFn))
+    , m_readFn(std::move(readFn))
+{
+    m_clock.start();
+
+    m_pumpTimer.setSingleShot(true);
+    m_pumpTimer.setInterval(0);
+    connect(&m_pumpTimer, &QTimer::timeout, this, &BleWriteScheduler::pump);
+
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, [this]() {
+        ++m_stats.timeouts;
+        retryOldest(QStringLiteral("timeout"));
+    });
+
+    m_backoffTimer.setSingleShot(true);
+    connect(&m_backoffTimer, &QTimer::timeout, this, &BleWriteScheduler::pump);
+}
+
+void BleWriteScheduler::enqueueWrite(const QBluetoothUuid& uuid, const QByteArray& data,
+                                     Lane lane, const QByteArray& coalesceKey) {
+    Command command;
+    command.lane = lane;
+    command.uuid = uuid;
+    command.data = data;
+    command.coalesceKey = coalesceKey;
+    enqueue(std::move(command));
+}
+
+void BleWriteScheduler::enqueueRead(const QBluetoothUuid& uuid, Lane lane) {
+    Command command;
+    command.isRead = true;
+    command.lane = lane;
+    command.uuid = uuid;
+    enqueue(std::move(command));
+}
+
+void BleWriteScheduler::writeUrgent(const QBluetoothUuid& uuid, const QByteArray& data) {
+    Command command;
+    command.lane = Urgent;
+    command.uuid = uuid;
+    command.data = data;
+    command.enqueuedMs = m_clock.elapsed();
+
+    if (m_inFlight.size() >= MAX_IN_FLIGHT) {
+        m_lanes[Urgent].append(command);
+        notePeakQueue();
+        return;
+    }
+    if (dispatch(command)) {
+        m_inFlight.append(command);
+        armTimeout();
+    } else {
+        ++m_stats.dropped;
+    }
+}
+
+void BleWriteScheduler::acknowledge(const QBluetoothUuid& uuid, const QByteArray& data) {
+    // Prefer an exact match; fall back to the oldest write on the same
+    // characteristic for stacks that don't echo the written value back.
+    auto it = std::find_if(m_inFlight.begin(), m_inFlight.end(), [&](const Command& c) {
+        return c.uuid == uuid && c.data == data;
+    });
+    if (it == m_inFlight.end()) {
+        it = std::find_if(m_inFlight.begin(), m_inFlight.end(), [&](const Command& c) {
+            return c.uuid == uuid;
+        });
+    }
+    if (it == m_inFlight.end()) {
+        ++m_stats.lateAcks;
+        return;
+    }
+
+    const qint64 latency = m_clock.elapsed() - it->sentMs;
+    m_inFlight.erase(it);
+
+    ++m_stats.writes;
+    m_stats.lastLatencyMs = latency;
+    m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, latency);
+    m_stats.meanLatencyMs += (latency - m_stats.meanLatencyMs) / static_cast<double>(m_stats.writes);
+
+    // Additive increase: one more slot per full window of clean acks
+    if (++m_cleanAcks >= m_window && m_window < MAX_IN_FLIGHT) {
+        ++m_window;
+        m_cleanAcks = 0;
+    }
+
+    emit writeAcknowledged(uuid, data);
+
+    pump();
+    if (isIdle())
+        emit drained();
+}
+
+void BleWriteScheduler::writeFailed() {
+    if (m_inFlight.isEmpty()) return;
+    ++m_stats.errors;
+    retryOldest(QStringLiteral("error"));
+}
+
+qsizetype BleWriteScheduler::clear() {
+    const qsizetype dropped = queuedCount() + m_inFlight.size();
+    for (QList<Command>& queue : m_lanes)
+        queue.clear();
+    m_inFlight.clear();
+    m_stats.dropped += static_cast<quint64>(dropped);
+    m_pumpTimer.stop();
+    m_timeoutTimer.stop();
+    m_backoffTimer.stop();
+    m_window = 1;
+    m_cleanAcks = 0;
+    return dropped;
+}
+
+qsizetype BleWriteScheduler::queuedCount() const {
+    qsizetype count = 0;
+    for (const QList<Command>& queue : m_lanes)
+        count += queue.size();
+    return count;
+}
+
+BleWriteScheduler::Stats BleWriteScheduler::stats() const {
+    Stats result = m_stats;
+    result.queued = queuedCount();
+    for (int lane = 0; lane < LaneCount; ++lane)
+        result.queuedByLane[lane] = m_lanes[lane].size();
+    result.inFlight = m_inFlight.size();
+    result.window = m_window;
+    return result;
+}
+
+QJsonObject BleWriteScheduler::statsJson() const {
+    const Stats s = stats();
+    QJsonObject result;
+    result["queued"] = static_cast<qint64>(s.queued);
+    QJsonObject byLane;
+    byLane["urgent"] = static_cast<qint64>(s.queuedByLane[Urgent]);
+    byLane["interactive"] = static_cast<qint64>(s.queuedByLane[Interactive]);
+    byLane["background"] = static_cast<qint64>(s.queuedByLane[Background]);
+    result["queuedByLane"] = byLane;
+    result["peakQueued"] = static_cast<qint64>(s.peakQueued);
+    result["inFlight"] = static_cast<qint64>(s.inFlight);
+    result["window"] = s.window;
+    result["writes"] = static_cast<qint64>(s.writes);
+    result["retries"] = static_cast<qint64>(s.retries);
+    result["timeouts"] = static_cast<qint64>(s.timeouts);
+    result["errors"] = static_cast<qint64>(s.errors);
+    result["failures"] = static_cast<qint64>(s.failures);
+    result["lateAcks"] = static_cast<qint64>(s.lateAcks);
+    result["coalesced"] = static_cast<qint64>(s.coalesced);
+    result["dropped"] = static_cast<qint64>(s.dropped);
+    result["lastLatencyMs"] = s.lastLatencyMs;
+    result["meanLatencyMs"] = s.meanLatencyMs;
+    result["maxLatencyMs"] = s.maxLatencyMs;
+    result["meanQueueWaitMs"] = s.meanQueueWaitMs;
+    result["maxQueueWaitMs"] = s.maxQueueWaitMs;
+    return result;
+}
+
+// -- Private --
+
+void BleWriteScheduler::enqueue(Command command) {
+    promote(command.uuid, command.lane);
+    if (coalesce(command)) {
+        ++m_stats.coalesced;
+        return;
+    }
+    command.enqueuedMs = m_clock.elapsed();
+    m_lanes[command.lane].append(std::move(command));
+    notePeakQueue();
+    schedulePump();
+}
+
+void BleWriteScheduler::promote(const QBluetoothUuid& uuid, Lane lane) {
+    for (int lower = lane + 1; lower < LaneCount; ++lower) {
+        QList<Command>& queue = m_lanes[lower];
+        for (qsizetype i = 0; i < queue.size();) {
+            if (queue[i].uuid == uuid) {
+                Command promoted = queue.takeAt(i);
+                promoted.lane = lane;
+                m_lanes[lane].append(std::move(promoted));
+            } else {
+                ++i;
+            }
+        }
+    }
+}
+
+bool BleWriteScheduler::coalesce(const Command& command) {
+    QList<Command>& queue = m_lanes[command.lane];
+
+    if (command.isRead) {
+        // A read right behind another read of the same characteristic would
+        // return the same value
+        for (qsizetype i = queue.size() - 1; i >= 0; --i) {
+            if (queue[i].uuid == command.uuid) return queue[i].isRead;
+        }
+        return false;
+    }
+    if (command.coalesceKey.isEmpty()) return false;
+
+    for (qsizetype i = queue.size() - 1; i >= 0; --i) {
+        Command& queued = queue[i];
+        if (queued.uuid != command.uuid || queued.isRead) continue;
+        if (queued.coalesceKey.isEmpty()) return false;  // Unknown effect; keep order
+        if (queued.coalesceKey == command.coalesceKey) {
+            queued.data = command.data;
+            return true;
+        }
+    }
+    return false;
+}
+
+void BleWriteScheduler::schedulePump() {
+    if (!m_pumpTimer.isActive())
+        m_pumpTimer.start();
+}
+
+void BleWriteScheduler::pump() {
+    if (m_backoffTimer.isActive()) return;
+
+    for (;;) {
+        // Strict priority: the highest non-empty lane always goes next
+        auto lane = std::find_if(m_lanes.begin(), m_lanes.end(),
+                                 [](const QList<Command>& queue) { return !queue.isEmpty(); });
+        if (lane == m_lanes.end()) break;
+        QList<Command>& queue = *lane;
+
+        if (queue.first().isRead) {
+            // Barrier: a read must observe every write queued before it
+            if (!m_inFlight.isEmpty()) break;
+            Command command = queue.takeFirst();
+            if (!dispatch(command))
+                ++m_stats.dropped;
+            continue;
+        }
+        if (m_inFlight.size() >= m_window) break;
+        Command command = queue.takeFirst();
+        if (dispatch(command))
+            m_inFlight.append(command);
+        else
+            ++m_stats.dropped;
+    }
+    armTimeout();
+}
+
+bool BleWriteScheduler::dispatch(Command& command) {
+    if (command.isRead)
+        return m_readFn(command.uuid);
+
+    const qint64 now = m_clock.elapsed();
+    if (command.sentMs == 0) {
+        // First dispatch; retries and re-sends don't count as queue wait
+        const qint64 wait = now - command.enqueuedMs;
+        ++m_dispatchedWrites;
+        m_stats.maxQueueWaitMs = std::max(m_stats.maxQueueWaitMs, wait);
+        m_stats.meanQueueWaitMs += (wait - m_stats.meanQueueWaitMs) / static_cast<double>(m_dispatchedWrites);
+    }
+    // Never 0 once sent, even in the clock's first millisecond
+    command.sentMs = std::max<qint64>(now, 1);
+    return m_writeFn(command.uuid, command.data);
+}
+
+void BleWriteScheduler::retryOldest(const QString& reason) {
+    if (m_inFlight.isEmpty()) return;
+
+    Command failed = m_inFlight.takeFirst();
+    m_window = 1;
+    m_cleanAcks = 0;
+
+    if (failed.attempts >= MAX_WRITE_RETRIES) {
+        ++m_stats.failures;
+        emit writeAbandoned(failed.uuid, failed.data);
+        pump();
+        if (isIdle())
+            emit drained();
+        return;
+    }
+
+    ++failed.attempts;
+    ++m_stats.retries;
+
+    // Every later in-flight write may already have landed, on this
+    // characteristic or another (a FRAME_WRITE retry with REQUESTED_STATE
+    // behind it). Pull them all back so they are re-sent after the retry in
+    // dispatch order, as the one-at-a-time queue would have sent them.
+    // They go back to the head of the highest lane among them.
+    QList<Command> resend{failed};
+    Lane lane = failed.lane;
+    for (Command& command : m_inFlight) {
+        lane = std::min(lane, command.lane);
+        resend.append(std::move(command));
+    }
+    m_inFlight.clear();
+    for (Command& command : resend)
+        command.lane = lane;
+    m_lanes[lane] = resend + m_lanes[lane];
+    notePeakQueue();
+
+    emit writeRetrying(failed.uuid, failed.attempts, reason);
+
+    const int delay = std::min(WRITE_RETRY_DELAY_MS << (failed.attempts - 1), MAX_RETRY_DELAY_MS);
+    m_backoffTimer.start(delay);
+    armTimeout();
+}
+
+void BleWriteScheduler::armTimeout() {
+    if (m_inFlight.isEmpty()) {
+        m_timeoutTimer.stop();
+        return;
+    }
+    const qint64 age = m_clock.elapsed() - m_inFlight.first().sentMs;
+    m_timeoutTimer.start(static_cast<int>(std::max<qint64>(0, WRITE_TIMEOUT_MS - age)));
+}
+
+void BleWriteScheduler::notePeakQueue() {
+    m_stats.peakQueued = std::max(m_stats.peakQueued, queuedCount());
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <QObject>
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QList>
+#include <QTimer>
+#include <array>
+#include <functional>
+
+/**
+ * Acknowledgement-driven scheduler for DE1 GATT writes.
+ *
+ * BleTransport hands every write and read to this class instead of spacing
+ * them on a timer. The next write goes out as soon as the stack has room for
+ * it: up to window() writes are in flight at once, where the window starts at
+ * 1 and grows by one per full window of clean acknowledgements (capped at
+ * MAX_IN_FLIGHT). A write error or timeout collapses it back to 1 and holds
+ * the queue for a back-off delay that doubles with each retry of the same
+ * write.
+ *
+ * Lanes: commands queue in one of three lanes, sent in strict priority order
+ * (Urgent, then Interactive, then Background); within a lane they leave
+ * FIFO, and QLowEnergyService runs GATT operations in submission order. A
+ * command never overtakes an earlier one for the same characteristic: queuing
+ * into a lane pulls any queued commands for that characteristic up from
+ * lower lanes first. When a write has to be retried, every later in-flight
+ * write is pulled back and re-sent after it in dispatch order, so commands
+ * still reach the machine in the order they were queued and the last value
+ * a characteristic receives is always the last one queued.
+ * Reads are barriers: they go out only once every earlier write has been
+ * acknowledged, which keeps read-after-write verification meaningful.
+ *
+ * Coalescing: a write with a coalescing key (e.g. an MMR register address)
+ * replaces the data of a not-yet-sent write with the same characteristic and
+ * key in its lane instead of queuing behind it. Only last-value-wins state
+ * should be keyed: the replaced write keeps its place, so reads queued behind
+ * it observe the newer value. An unkeyed write to the characteristic in
+ * between stops the search. A read queued right behind another read of the
+ * same characteristic is dropped the same way.
+ *
+ * Each dispatched write produces at most one writeAcknowledged(). Acks that
+ * no longer match an in-flight write (the write was cleared, or was pulled
+ * back for a retry and is still queued) are dropped and counted as late.
+ *
+ * The scheduler never touches Qt Bluetooth itself — the owner supplies the
+ * write/read functions — so it can be driven directly in tests.
+ */
+class BleWriteScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    // Perform the GATT operation. Return false if it could not be issued
+    // (no service, unknown characteristic); the command is then dropped.
+    using WriteFn = std::function<bool(const QBluetoothUuid& uuid, const QByteArray& data)>;
+    using ReadFn = std::function<bool(const QBluetoothUuid& uuid)>;
+
+    static constexpr int MAX_IN_FLIGHT = 4;
+    static constexpr int MAX_WRITE_RETRIES = 10;
+    static constexpr int WRITE_TIMEOUT_MS = 5000;
+    static constexpr int WRITE_RETRY_DELAY_MS = 500;   // First back-off; doubles per retry
+    static constexpr int MAX_RETRY_DELAY_MS = 4000;
+
+    enum Lane { Urgent, Interactive, Background, LaneCount };
+
+    struct Stats {
+        qsizetype queued = 0;
+        std::array<qsizetype, LaneCount> queuedByLane{};
+        qsizetype peakQueued = 0;
+        qsizetype inFlight = 0;
+        int window = 1;
+        quint64 writes = 0;          // Acknowledged writes
+        quint64 retries = 0;
+        quint64 timeouts = 0;
+        quint64 errors = 0;
+        quint64 failures = 0;        // Writes abandoned after MAX_WRITE_RETRIES
+        quint64 lateAcks = 0;
+        quint64 coalesced = 0;       // Commands folded into an earlier queued one
+        quint64 dropped = 0;         // Cleared, or the owner couldn't issue them
+        qint64 lastLatencyMs = 0;    // Dispatch -> ack, most recent write
+        double meanLatencyMs = 0;
+        qint64 maxLatencyMs = 0;
+        double meanQueueWaitMs = 0;  // Enqueue -> dispatch
+        qint64 maxQueueWaitMs = 0;
+    };
+
+    BleWriteScheduler(WriteFn writeFn, ReadFn readFn, QObject* parent = nullptr);
+
+    void enqueueWrite(const QBluetoothUuid& uuid, const QByteArray& data,
+                      Lane lane = Interactive, const QByteArray& coalesceKey = QByteArray());
+    void enqueueRead(const QBluetoothUuid& uuid, Lane lane = Interactive);
+
+    // Dispatches immediately when fewer than MAX_IN_FLIGHT writes are
+    // outstanding, ignoring the adaptive window and any back-off; otherwise
+    // the write joins the Urgent lane, ahead of everything else queued.
+    // Never clears the queue.
+    void writeUrgent(const QBluetoothUuid& uuid, const QByteArray& data);
+
+    // characteristicWritten from the stack
+    void acknowledge(const QBluetoothUuid& uuid, const QByteArray& data);
+    // CharacteristicWriteError from the stack. Qt doesn't say which write
+    // failed; the stack runs them in order, so it is the oldest in flight.
+    void writeFailed();
+
+    // Drops queued and in-flight commands, returns how many were dropped.
+    // Acks for the dropped in-flight writes are ignored when they arrive.
+    qsizetype clear();
+
+    bool isIdle() const { return queuedCount() == 0 && m_inFlight.isEmpty(); }
+    qsizetype queuedCount() const;
+    qsizetype queuedCount(Lane lane) const { return m_lanes[lane].size(); }
+    qsizetype inFlightCount() const { return m_inFlight.size(); }
+    int window() const { return m_window; }
+
+    Stats stats() const;
+    QJsonObject statsJson() const;
+
+signals:
+    void writeAcknowledged(const QBluetoothUuid& uuid, const QByteArray& data);
+    // attempt is 1-based; reason is "timeout" or "error"
+    void writeRetrying(const QBluetoothUuid& uuid, int attempt, const QString& reason);
+    void writeAbandoned(const QBluetoothUuid& uuid, const QByteArray& data);
+    // Queue empty and nothing in flight, after an ack or an abandoned write
+    void drained();
+
+private:
+    struct Command {
+        bool isRead = false;
+        Lane lane = Interactive;
+        QBluetoothUuid uuid;
+        QByteArray data;
+        QByteArray coalesceKey;
+        int attempts = 0;
+        qint64 enqueuedMs = 0;
+        qint64 sentMs = 0;
+    };
+
+    void enqueue(Command command);
+    // Moves queued commands for uuid from lanes below lane to its tail
+    void promote(const QBluetoothUuid& uuid, Lane lane);
+    bool coalesce(const Command& command);
+    void schedulePump();
+    void pump();
+    bool dispatch(Command& command);
+    void retryOldest(const QString& reason);
+    void armTimeout();
+    void notePeakQueue();
+
+    WriteFn m_writeFn;
+    ReadFn m_readFn;
+
+    std::array<QList<Command>, LaneCount> m_lanes;
+    QList<Command> m_inFlight;  // Dispatch order
+
+    int m_window = 1;
+    int m_cleanAcks = 0;        // Acks since the window last changed
+
+    QElapsedTimer m_clock;
+    QTimer m_pumpTimer;         // Zero-delay: batches enqueues from one event-loop turn
+    QTimer m_timeoutTimer;      // Armed for the oldest in-flight write
+    QTimer m_backoffTimer;      // Holds the queue after an error or timeout
+
+    Stats m_stats;
+    quint64 m_dispatchedWrites = 0;
+};
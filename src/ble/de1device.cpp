@@ -1,6 +1,8 @@
 #include "de1device.h"
 #include "de1transport.h"
+#include "arrivalclock.h"
 #include "bletransport.h"
+#include "blecapture.h"
 #include "protocol/binarycodec.h"
 #include "protocol/firmwarepackets.h"
 #include "profile/profile.h"
@@ -14,16 +16,16 @@
 #include <cmath>
 #include <QDebug>
 #include <QStringList>
-#include <chrono>
 #include <memory>
 
 namespace {
-qint64 monotonicMsNow()
-{
-    using namespace std::chrono;
-    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-}
-}
+// Coalescing keys for DE1Transport::writeInLane. MMR requests are keyed by
+// length byte + address, so a queued write to a register is replaced by a
+// newer one and an identical queued read request isn't sent twice.
+QByteArray mmrCoalesceKey(const QByteArray& payload) { return payload.left(4); }
+const QByteArray kShotSettingsKey = QByteArrayLiteral("shotSettings");
+const QByteArray kWaterLevelsKey = QByteArrayLiteral("waterLevels");
+} // namespace
 
 DE1Device::DE1Device(QObject* parent)
     : QObject(parent)
@@ -52,6 +54,7 @@ void DE1Device::setTransport(DE1Transport* transport) {
 
     bool wasConnected = isConnected();
     m_transport = transport;
+    invalidateLoadedProfile();
 
     if (m_transport) {
         connect(m_transport, &DE1Transport::connected,
@@ -66,6 +69,9 @@ void DE1Device::setTransport(DE1Transport* transport) {
                 this, &DE1Device::errorOccurred);
         connect(m_transport, &DE1Transport::logMessage,
                 this, &DE1Device::logMessage);
+
+        if (auto* tap = BleCaptureTap::instance())
+            tap->attach(m_transport);
     }
 
     if (wasConnected != isConnected()) {
@@ -93,9 +99,7 @@ void DE1Device::onTransportConnected() {
 }
 
 void DE1Device::onTransportDisconnected() {
-    m_sawStopWritePending = false;
-    m_lastSawTriggerMs = 0;
-    m_lastSawWriteMs = 0;
+    m_sawTrace = SawLatencyTrace();
 
     // Clear ShotSettings tracking so a reconnect doesn't compare the DE1's
     // post-reconnect indication against a stale commanded value from the
@@ -112,6 +116,8 @@ void DE1Device::onTransportDisconnected() {
     // power-cycled or had its firmware state reset between sessions).
     m_lastMMRValues.clear();
     m_pendingMMRVerifies.clear();
+    // Same for the loaded profile: the next upload goes out in full.
+    invalidateLoadedProfile();
     m_deviceSteamTargetC = -1.0;
     m_deviceSteamDurationSec = -1;
     m_deviceHotWaterTempC = -1.0;
@@ -142,11 +148,11 @@ void DE1Device::onTransportDisconnected() {
     emit guiEnabledChanged();
 }
 
-void DE1Device::onTransportDataReceived(const QBluetoothUuid& uuid, const QByteArray& data) {
+void DE1Device::onTransportDataReceived(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs) {
     if (uuid == DE1::Characteristic::STATE_INFO) {
-        parseStateInfo(data);
+        parseStateInfo(data, arrivalMs > 0 ? arrivalMs : ArrivalClock::nowMs());
     } else if (uuid == DE1::Characteristic::SHOT_SAMPLE) {
-        parseShotSample(data);
+        parseShotSample(data, arrivalMs > 0 ? arrivalMs : ArrivalClock::nowMs());
     } else if (uuid == DE1::Characteristic::SHOT_SETTINGS) {
         parseShotSettings(data);
     } else if (uuid == DE1::Characteristic::WATER_LEVELS) {
@@ -169,23 +175,32 @@ void DE1Device::onTransportDataReceived(const QBluetoothUuid& uuid, const QByteA
 
 void DE1Device::onTransportWriteComplete(const QBluetoothUuid& uuid, const QByteArray& data) {
     // SAW stop latency instrumentation (worker trigger -> urgent write -> BLE ack)
-    if (m_sawStopWritePending
+    if (m_sawTrace.writeMs > 0 && m_sawTrace.ackMs == 0
         && uuid == DE1::Characteristic::REQUESTED_STATE
         && data.size() == 1
         && static_cast<uint8_t>(data[0]) == static_cast<uint8_t>(DE1::State::Idle)) {
-        qint64 ackMs = monotonicMsNow();
-        qint64 dispatchMs = m_lastSawWriteMs - m_lastSawTriggerMs;
-        qint64 bleAckMs = ackMs - m_lastSawWriteMs;
-        qint64 totalMs = ackMs - m_lastSawTriggerMs;
+        m_sawTrace.ackMs = ArrivalClock::nowMs();
+        qint64 dispatchMs = m_sawTrace.writeMs - m_sawTrace.triggerMs;
+        qint64 bleAckMs = m_sawTrace.ackMs - m_sawTrace.writeMs;
+        qint64 totalMs = m_sawTrace.ackMs - m_sawTrace.triggerMs;
         qDebug() << "[SAW-Latency] dispatch=" << dispatchMs
                  << "ms, bleAck=" << bleAckMs
                  << "ms, total=" << totalMs << "ms";
-        m_sawStopWritePending = false;
-        m_lastSawTriggerMs = 0;
-        m_lastSawWriteMs = 0;
+        finishSawTrace();
     }
 }
 
+void DE1Device::finishSawTrace() {
+    // The state notification can beat the write acknowledgement
+    if (!m_sawTrace.complete()) return;
+    const SawLatencyTrace trace = m_sawTrace;
+    m_sawTrace = SawLatencyTrace();
+    qDebug() << "[SAW-Latency] machine=" << (trace.stateMs - trace.writeMs)
+             << "ms, scale->machine="
+             << (trace.arrivalMs > 0 ? trace.stateMs - trace.arrivalMs : -1) << "ms";
+    emit sawStopTraced(trace);
+}
+
 // -- Connection state --
 
 bool DE1Device::isConnected() const {
@@ -337,9 +352,7 @@ void DE1Device::disconnect() {
         finishProfileUpload(false, QStringLiteral("BLE disconnect during upload"));
     }
     m_sleepPendingAfterUpload = false;
-    m_sawStopWritePending = false;
-    m_lastSawTriggerMs = 0;
-    m_lastSawWriteMs = 0;
+    m_sawTrace = SawLatencyTrace();
 
     if (m_transport) {
         // Disconnect signals FIRST to prevent re-entrant emissions
@@ -364,7 +377,7 @@ void DE1Device::disconnect() {
 
 // -- Parse methods --
 
-void DE1Device::parseStateInfo(const QByteArray& data) {
+void DE1Device::parseStateInfo(const QByteArray& data, qint64 arrivalMs) {
     if (data.size() < 2) return;
 
     DE1::State newState = static_cast<DE1::State>(static_cast<uint8_t>(data[0]));
@@ -376,6 +389,34 @@ void DE1Device::parseStateInfo(const QByteArray& data) {
     m_state = newState;
     m_subState = newSubState;
 
+    // First reaction to a traced SAW stop. A notification that arrived before
+    // the write went out (and only got here after it) isn't one.
+    const qint64 stateMs = arrivalMs > 0 ? arrivalMs : ArrivalClock::nowMs();
+    if (m_sawTrace.writeMs > 0 && m_sawTrace.stateMs == 0 && stateMs >= m_sawTrace.writeMs
+        && (stateChanged || subStateChanged)) {
+        m_sawTrace.stateMs = stateMs;
+        finishSawTrace();
+    }
+
+    // States where the firmware restarts or runs its own programs; don't
+    // trust that the profile we loaded survived them.
+    if (stateChanged) {
+        switch (newState) {
+        case DE1::State::Init:
+        case DE1::State::InBootLoader:
+        case DE1::State::FatalError:
+        case DE1::State::SelfTest:
+        case DE1::State::ShortCal:
+        case DE1::State::LongCal:
+        case DE1::State::Descale:
+        case DE1::State::Clean:
+            invalidateLoadedProfile();
+            break;
+        default:
+            break;
+        }
+    }
+
     if (stateChanged) {
         emit this->stateChanged();
     }
@@ -384,14 +425,16 @@ void DE1Device::parseStateInfo(const QByteArray& data) {
     }
 }
 
-void DE1Device::parseShotSample(const QByteArray& data) {
+void DE1Device::parseShotSample(const QByteArray& data, qint64 arrivalMs) {
     // DE1 has two BLE specs with different packet formats:
     // Old spec (< 1.0): 17 bytes, pressure/flow are 1 byte each (U8P4)
     // New spec (>= 1.0): 19 bytes, pressure/flow are 2 bytes each (U16P12), temp is 3 bytes
 
     const uint8_t* d = reinterpret_cast<const uint8_t*>(data.constData());
     ShotSample sample;
-    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+    // Stamped when the transport received it, not after the event-loop wait
+    sample.arrivalMs = arrivalMs;
+    sample.timestamp = ArrivalClock::toEpochMs(arrivalMs);
 
     // Detect BLE spec based on packet size
     bool newSpec = (data.size() >= 19);
@@ -564,7 +607,8 @@ void DE1Device::requestGHCStatus() {
     mmrRead[3] = 0x1C;   // Address low byte (GHC info)
 
     if (!m_transport) return;
-    m_transport->write(DE1::Characteristic::READ_FROM_MMR, mmrRead);
+    m_transport->writeInLane(DE1::Characteristic::READ_FROM_MMR, mmrRead,
+                             DE1Transport::WriteLane::Background, mmrCoalesceKey(mmrRead));
 }
 
 void DE1Device::parseMMRResponse(const QByteArray& data) {
@@ -792,17 +836,17 @@ void DE1Device::stopOperation() {
 }
 
 void DE1Device::stopOperationUrgent() {
-    stopOperationUrgent(0);
+    stopOperationUrgent(SawLatencyTrace());
 }
 
 void DE1Device::customEvent(QEvent* event) {
     if (event->type() == SawStopEvent::eventType()) {
         auto* e = static_cast<SawStopEvent*>(event);
-        stopOperationUrgent(e->sawTriggerMs());
+        stopOperationUrgent(e->trace());
     }
 }
 
-void DE1Device::stopOperationUrgent(qint64 sawTriggerMs) {
+void DE1Device::stopOperationUrgent(const SawLatencyTrace& sawTrace) {
 #ifdef QT_DEBUG
     if (m_simulationMode && m_simulator) {
         m_simulator->stop();
@@ -811,15 +855,10 @@ void DE1Device::stopOperationUrgent(qint64 sawTriggerMs) {
 #endif
     if (!m_transport) return;
     if (dropDeviceWriteIfFirmwareFlash("stopOperationUrgent")) return;
-    clearCommandQueue();
-    if (sawTriggerMs > 0) {
-        m_lastSawTriggerMs = sawTriggerMs;
-        m_lastSawWriteMs = monotonicMsNow();
-        m_sawStopWritePending = true;
-    } else {
-        m_sawStopWritePending = false;
-        m_lastSawTriggerMs = 0;
-        m_lastSawWriteMs = 0;
+    clearCommandQueue();  // Also drops any earlier trace
+    if (sawTrace.triggerMs > 0) {
+        m_sawTrace = sawTrace;
+        m_sawTrace.writeMs = ArrivalClock::nowMs();
     }
     QByteArray data(1, static_cast<char>(DE1::State::Idle));
     m_transport->writeUrgent(DE1::Characteristic::REQUESTED_STATE, data);
@@ -882,9 +921,7 @@ void DE1Device::clearCommandQueue() {
         finishProfileUpload(false, QStringLiteral("command queue cleared during upload"));
     }
     m_sleepPendingAfterUpload = false;
-    m_sawStopWritePending = false;
-    m_lastSawTriggerMs = 0;
-    m_lastSawWriteMs = 0;
+    m_sawTrace = SawLatencyTrace();
     // Dropping the transport queue discards pending MMR writes whose values
     // are already recorded in m_lastMMRValues, so the cache would silently
     // elide the next retry. Only invalidate the cache if something was
@@ -901,6 +938,14 @@ void DE1Device::clearCommandQueue() {
 }
 
 void DE1Device::uploadProfile(const Profile& profile) {
+    sendProfile(profile, /*startEspresso=*/false);
+}
+
+void DE1Device::uploadProfileAndStartEspresso(const Profile& profile) {
+    sendProfile(profile, /*startEspresso=*/true);
+}
+
+void DE1Device::sendProfile(const Profile& profile, bool startEspresso) {
 #ifdef QT_DEBUG
     if (m_simulationMode && m_simulator) {
         m_simulator->setProfile(profile);
@@ -908,39 +953,59 @@ void DE1Device::uploadProfile(const Profile& profile) {
 #endif
 
     if (!m_transport) return;
-    if (dropDeviceWriteIfFirmwareFlash("uploadProfile")) return;
-
-    // Attach the ACK listener BEFORE queuing writes so we observe every
-    // writeComplete for this upload.
-    QList<QByteArray> frames = profile.toFrameBytes();
-    startProfileUploadTracking(profile.title(), frames, /*expectEspressoStart=*/false);
+    if (dropDeviceWriteIfFirmwareFlash(startEspresso ? "uploadProfileAndStartEspresso" : "uploadProfile")) return;
 
-    m_transport->write(DE1::Characteristic::HEADER_WRITE, profile.toHeaderBytes());
-    for (const QByteArray& frame : frames) {
-        m_transport->write(DE1::Characteristic::FRAME_WRITE, frame);
+    // An upload still in flight will change what the DE1 holds, so the
+    // loaded image can't be diffed against; superseding it also drops the
+    // image, and this upload goes out in full.
+    if (m_profileUploadInProgress) {
+        finishProfileUpload(false, QStringLiteral("superseded by a new upload"));
     }
-}
 
-void DE1Device::uploadProfileAndStartEspresso(const Profile& profile) {
-#ifdef QT_DEBUG
-    if (m_simulationMode && m_simulator) {
-        m_simulator->setProfile(profile);
+    const QByteArray header = profile.toHeaderBytes();
+    const QList<QByteArray> frames = profile.toFrameBytes();
+    const QByteArray espressoStart(1, static_cast<char>(DE1::State::Espresso));
+
+    if (m_hasLoadedProfile && header == m_loadedProfileHeader && frames == m_loadedProfileFrames) {
+        qDebug().noquote() << QStringLiteral("DE1Device: profile %1 already loaded on the DE1, skipping upload")
+                                 .arg(profile.title());
+        if (startEspresso)
+            m_transport->write(DE1::Characteristic::REQUESTED_STATE, espressoStart);
+        emit profileUploaded(true);
+        return;
     }
-#endif
 
-    if (!m_transport) return;
-    if (dropDeviceWriteIfFirmwareFlash("uploadProfileAndStartEspresso")) return;
+    // Only frames that differ from the loaded image at the same position go
+    // out, after the header. Without a loaded image that is every frame.
+    QList<QByteArray> changedFrames;
+    for (qsizetype i = 0; i < frames.size(); ++i) {
+        if (!m_hasLoadedProfile || i >= m_loadedProfileFrames.size() || frames[i] != m_loadedProfileFrames[i])
+            changedFrames.append(frames[i]);
+    }
+    if (m_hasLoadedProfile) {
+        qDebug().noquote() << QStringLiteral("DE1Device: profile %1 differs from the loaded one in %2 of %3 frame(s)")
+                                 .arg(profile.title()).arg(changedFrames.size()).arg(frames.size());
+    }
 
-    QList<QByteArray> frames = profile.toFrameBytes();
-    startProfileUploadTracking(profile.title(), frames, /*expectEspressoStart=*/true);
+    // Attach the ACK listener BEFORE queuing writes so we observe every
+    // writeComplete for this upload.
+    startProfileUploadTracking(profile.title(), changedFrames, startEspresso);
+    m_uploadHeaderBytes = header;
+    m_uploadFrames = frames;
 
-    m_transport->write(DE1::Characteristic::HEADER_WRITE, profile.toHeaderBytes());
-    for (const QByteArray& frame : frames) {
+    m_transport->write(DE1::Characteristic::HEADER_WRITE, header);
+    for (const QByteArray& frame : changedFrames) {
         m_transport->write(DE1::Characteristic::FRAME_WRITE, frame);
     }
     // Queue espresso start AFTER all profile frames
-    m_transport->write(DE1::Characteristic::REQUESTED_STATE,
-                       QByteArray(1, static_cast<char>(DE1::State::Espresso)));
+    if (startEspresso)
+        m_transport->write(DE1::Characteristic::REQUESTED_STATE, espressoStart);
+}
+
+void DE1Device::invalidateLoadedProfile() {
+    m_hasLoadedProfile = false;
+    m_loadedProfileHeader.clear();
+    m_loadedProfileFrames.clear();
 }
 
 // -- Profile upload frame-ACK verification --
@@ -1074,6 +1139,19 @@ void DE1Device::finishProfileUpload(bool success, const QString& reason)
     }
     m_profileUploadInProgress = false;
 
+    // A verified upload is exactly what the DE1 now holds. After a failed
+    // one we can't tell which frames landed, so the next upload goes out
+    // in full.
+    if (success) {
+        m_hasLoadedProfile = true;
+        m_loadedProfileHeader = m_uploadHeaderBytes;
+        m_loadedProfileFrames = m_uploadFrames;
+    } else {
+        invalidateLoadedProfile();
+    }
+    m_uploadHeaderBytes.clear();
+    m_uploadFrames.clear();
+
     // Use .noquote() so QString reasons/titles land as plain text (no
     // surrounding quotes), making the messages scannable in the debug log
     // and stable for test-harness filters to match against.
@@ -1111,12 +1189,14 @@ void DE1Device::finishProfileUpload(bool success, const QString& reason)
 void DE1Device::writeHeader(const QByteArray& headerData) {
     if (!m_transport) return;
     if (dropDeviceWriteIfFirmwareFlash("writeHeader")) return;
+    invalidateLoadedProfile();
     m_transport->write(DE1::Characteristic::HEADER_WRITE, headerData);
 }
 
 void DE1Device::writeFrame(const QByteArray& frameData) {
     if (!m_transport) return;
     if (dropDeviceWriteIfFirmwareFlash("writeFrame")) return;
+    invalidateLoadedProfile();
     m_transport->write(DE1::Characteristic::FRAME_WRITE, frameData);
 }
 
@@ -1141,6 +1221,8 @@ QByteArray DE1Device::buildMMRPayload(uint32_t address, uint32_t value) {
 void DE1Device::setFirmwareFlashInProgress(bool inProgress) {
     if (m_firmwareFlashInProgress == inProgress) return;
     m_firmwareFlashInProgress = inProgress;
+    // New firmware boots with whatever profile it defaults to
+    invalidateLoadedProfile();
     qDebug() << "[firmware] DE1Device MMR-write guard"
              << (inProgress ? "ENGAGED" : "cleared");
 }
@@ -1167,6 +1249,11 @@ bool DE1Device::dropIfFirmwareFlashInProgress(uint32_t address, uint32_t value,
 
 void DE1Device::writeMMR(uint32_t address, uint32_t value,
                          const QString& reason, bool force) {
+    queueMMRWrite(address, value, reason, force, /*background=*/false);
+}
+
+void DE1Device::queueMMRWrite(uint32_t address, uint32_t value,
+                              const QString& reason, bool force, bool background) {
     if (!m_transport) return;
 
     // Firmware flash active: MMR writes travel on the same BLE
@@ -1211,7 +1298,11 @@ void DE1Device::writeMMR(uint32_t address, uint32_t value,
         .arg(reasonSuffix);
 
     m_lastMMRValues.insert(address, value);
-    m_transport->write(DE1::Characteristic::WRITE_TO_MMR, buildMMRPayload(address, value));
+    const QByteArray payload = buildMMRPayload(address, value);
+    m_transport->writeInLane(DE1::Characteristic::WRITE_TO_MMR, payload,
+                             background ? DE1Transport::WriteLane::Background
+                                        : DE1Transport::WriteLane::Interactive,
+                             mmrCoalesceKey(payload));
 }
 
 void DE1Device::writeMMRUrgent(uint32_t address, uint32_t value, const QString& reason) {
@@ -1290,8 +1381,9 @@ void DE1Device::writeMMRVerified(uint32_t address, uint32_t value,
     // same value actually reaches the wire (otherwise the cache would elide).
     writeMMR(address, value, reason, /*force=*/true);
 
-    // Schedule the read-back. 50ms gives the BLE queue's 50ms inter-write
-    // spacing time to dispatch the write and the DE1 a tick to process it.
+    // Schedule the read-back. 50ms gives the write time to be acknowledged
+    // (the BLE queue holds reads until earlier writes are) and the DE1 a
+    // tick to process it.
     QTimer::singleShot(50, this, [this, address]() {
         scheduleMMRVerifyRead(address);
     });
@@ -1311,7 +1403,8 @@ void DE1Device::scheduleMMRVerifyRead(uint32_t address) {
     req[1] = (address >> 16) & 0xFF;
     req[2] = (address >> 8) & 0xFF;
     req[3] = address & 0xFF;
-    m_transport->write(DE1::Characteristic::READ_FROM_MMR, req);
+    m_transport->writeInLane(DE1::Characteristic::READ_FROM_MMR, req,
+                             DE1Transport::WriteLane::Interactive, mmrCoalesceKey(req));
 }
 
 void DE1Device::retryMMRVerify(uint32_t address, const QString& cause) {
@@ -1361,8 +1454,10 @@ void DE1Device::setUsbChargerOn(bool on, bool force) {
     // force=true must bypass writeMMR's per-register dedup — the DE1's 10-min
     // auto-enable timeout requires us to keep reasserting the commanded value
     // even when unchanged, otherwise the DE1 will silently override us.
-    writeMMR(DE1::MMR::USB_CHARGER, on ? 1 : 0,
-             QStringLiteral("setUsbChargerOn"), force);
+    // Background lane: the periodic reassert shouldn't hold up user-driven
+    // writes, and a newer toggle replaces one still queued.
+    queueMMRWrite(DE1::MMR::USB_CHARGER, on ? 1 : 0,
+                  QStringLiteral("setUsbChargerOn"), force, /*background=*/true);
 
     if (stateChanged) {
         emit usbChargerOnChanged();
@@ -1392,7 +1487,8 @@ void DE1Device::setWaterRefillLevel(int refillPointMm) {
     data.append(BinaryCodec::encodeShortBE(BinaryCodec::encodeU16P8(0)));
     data.append(BinaryCodec::encodeShortBE(BinaryCodec::encodeU16P8(static_cast<double>(refillPointMm))));
 
-    m_transport->write(DE1::Characteristic::WATER_LEVELS, data);
+    m_transport->writeInLane(DE1::Characteristic::WATER_LEVELS, data,
+                             DE1Transport::WriteLane::Interactive, kWaterLevelsKey);
 }
 
 void DE1Device::setFlowCalibrationMultiplier(double multiplier) {
@@ -1412,7 +1508,8 @@ void DE1Device::requestRefillKitStatus() {
     mmrRead[2] = 0x38;
     mmrRead[3] = 0x5C;
 
-    m_transport->write(DE1::Characteristic::READ_FROM_MMR, mmrRead);
+    m_transport->writeInLane(DE1::Characteristic::READ_FROM_MMR, mmrRead,
+                             DE1Transport::WriteLane::Background, mmrCoalesceKey(mmrRead));
 }
 
 void DE1Device::sendInitialSettings() {
@@ -1466,7 +1563,8 @@ void DE1Device::sendInitialSettings() {
     mmrRead[2] = 0x38;
     mmrRead[3] = 0x1C;
 
-    m_transport->write(DE1::Characteristic::READ_FROM_MMR, mmrRead);
+    m_transport->writeInLane(DE1::Characteristic::READ_FROM_MMR, mmrRead,
+                             DE1Transport::WriteLane::Background, mmrCoalesceKey(mmrRead));
 
     // Read machine identity MMRs (CPU board model, machine model, firmware build)
     // These populate the third line of the firmware version string
@@ -1477,7 +1575,8 @@ void DE1Device::sendInitialSettings() {
         req[1] = static_cast<char>((addr >> 16) & 0xFF);
         req[2] = static_cast<char>((addr >> 8) & 0xFF);
         req[3] = static_cast<char>(addr & 0xFF);
-        m_transport->write(DE1::Characteristic::READ_FROM_MMR, req);
+        m_transport->writeInLane(DE1::Characteristic::READ_FROM_MMR, req,
+                                 DE1Transport::WriteLane::Background, mmrCoalesceKey(req));
     }
 
     // Read refill kit status
@@ -1585,7 +1684,8 @@ void DE1Device::setShotSettings(double steamTemp, int steamDuration,
         .arg(groupTemp, 0, 'f', 2)
         .arg(reasonSuffix);
 
-    m_transport->write(DE1::Characteristic::SHOT_SETTINGS, data);
+    m_transport->writeInLane(DE1::Characteristic::SHOT_SETTINGS, data,
+                             DE1Transport::WriteLane::Interactive, kShotSettingsKey);
 
     // Verify the write by reading back. The DE1 firmware does NOT push
     // notifications on the SHOT_SETTINGS characteristic when written (de1app
@@ -1650,5 +1750,8 @@ void DE1Device::resendLastShotSettings() {
         .arg(m_commandedHotWaterVolMl)
         .arg(m_commandedGroupTargetC, 0, 'f', 2);
     m_lastShotSettingsWriteMs = QDateTime::currentMSecsSinceEpoch();
-    m_transport->write(DE1::Characteristic::SHOT_SETTINGS, m_lastShotSettingsPayload);
+    // Background: a drift heal isn't waiting on the user, and it folds into
+    // any setShotSettings() write still queued
+    m_transport->writeInLane(DE1::Characteristic::SHOT_SETTINGS, m_lastShotSettingsPayload,
+                             DE1Transport::WriteLane::Background, kShotSettingsKey);
 }
@@ -14,6 +14,7 @@
 #include <QTimer>
 
 #include "protocol/de1characteristics.h"
+#include "sawlatencytrace.h"
 
 // High-priority custom event posted by WeightProcessor to bypass the normal
 // QueuedConnection queue on slow devices. Delivered via Qt::HighEventPriority
@@ -24,11 +25,12 @@ public:
         static int type = QEvent::registerEventType();
         return static_cast<QEvent::Type>(type);
     }
-    explicit SawStopEvent(qint64 sawTriggerMs)
-        : QEvent(eventType()), m_sawTriggerMs(sawTriggerMs) {}
-    qint64 sawTriggerMs() const { return m_sawTriggerMs; }
+    explicit SawStopEvent(const SawLatencyTrace& trace)
+        : QEvent(eventType()), m_trace(trace) {}
+    qint64 sawTriggerMs() const { return m_trace.triggerMs; }
+    const SawLatencyTrace& trace() const { return m_trace; }
 private:
-    qint64 m_sawTriggerMs;
+    SawLatencyTrace m_trace;
 };
 
 class Profile;
@@ -41,7 +43,8 @@ class DE1Simulator;
 #endif
 
 struct ShotSample {
-    qint64 timestamp = 0;
+    qint64 timestamp = 0;  // Wall clock (ms since epoch) when the notification arrived
+    qint64 arrivalMs = 0;  // ArrivalClock stamp from the transport; 0 for simulated samples
     double timer = 0.0;
     double groupPressure = 0.0;
     double groupFlow = 0.0;
@@ -188,13 +191,15 @@ public slots:
     void startClean();
     void stopOperation();         // Soft stop (for steam: stops flow, no purge)
     void stopOperationUrgent();   // Bypasses command queue for faster stop (SOW)
-    void stopOperationUrgent(qint64 sawTriggerMs);  // Includes SAW trigger timestamp for latency tracing
+    void stopOperationUrgent(const SawLatencyTrace& sawTrace);  // SAW stop, traced through to the DE1 reacting
     void requestIdle();           // Hard stop (requests Idle state, triggers steam purge)
     void skipToNextFrame();   // Skip to next profile frame during extraction (0x0E)
     void goToSleep();
     void wakeUp();
 
-    // Profile upload
+    // Profile upload. Only the header and the frames that differ from the
+    // last verified upload are sent; an identical profile is not sent at all
+    // (profileUploaded(true) fires immediately).
     void uploadProfile(const Profile& profile);
     void uploadProfileAndStartEspresso(const Profile& profile);  // Upload then start in correct order
     void clearCommandQueue();  // Clear all pending BLE commands (use when extraction starts)
@@ -256,8 +261,8 @@ public slots:
     void setUsbChargerOn(bool on, bool force = false);
 
     // Like setUsbChargerOn but bypasses the BLE command queue for immediate send.
-    // Used by ensureChargerOn() on app suspend where the 50ms queue delay could
-    // race with iOS suspension.
+    // Used by ensureChargerOn() on app suspend where waiting behind queued
+    // writes could race with iOS suspension.
     void setUsbChargerOnUrgent(bool on);
 
     // Water refill level (write StartFillLevel to machine via WaterLevels characteristic)
@@ -336,6 +341,9 @@ signals:
     void shotSettingsReported(double deviceSteamTargetC, int deviceSteamDurationSec,
                               double deviceHotWaterTempC, int deviceHotWaterVolMl,
                               double deviceGroupTargetC);
+    // A SAW stop made it all the way through: the stop write was acknowledged
+    // and the DE1 reported leaving the shot. Feeds SawLatencyTracker.
+    void sawStopTraced(const SawLatencyTrace& trace);
     void logMessage(const QString& message);
 
 protected:
@@ -345,6 +353,11 @@ private:
     // Build the 20-byte MMR payload without sending it (shared by writeMMR/writeMMRUrgent)
     static QByteArray buildMMRPayload(uint32_t address, uint32_t value);
 
+    // writeMMR body; background sends it in the transport's Background lane.
+    // Queued writes to the same register coalesce either way.
+    void queueMMRWrite(uint32_t address, uint32_t value, const QString& reason,
+                       bool force, bool background);
+
     // Firmware-flash guard shared by writeMMR / writeMMRUrgent /
     // writeMMRVerified. Returns true (and logs a qWarning) when the caller
     // should bail because a flash is in progress; false means "proceed".
@@ -363,12 +376,13 @@ private:
     // Transport signal handlers
     void onTransportConnected();
     void onTransportDisconnected();
-    void onTransportDataReceived(const QBluetoothUuid& uuid, const QByteArray& data);
+    void onTransportDataReceived(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs);
     void onTransportWriteComplete(const QBluetoothUuid& uuid, const QByteArray& data);
 
     // Parse methods (dispatch from onTransportDataReceived)
-    void parseStateInfo(const QByteArray& data);
-    void parseShotSample(const QByteArray& data);
+    void parseStateInfo(const QByteArray& data, qint64 arrivalMs = 0);
+    void finishSawTrace();
+    void parseShotSample(const QByteArray& data, qint64 arrivalMs);
     void parseShotSettings(const QByteArray& data);
     void parseWaterLevel(const QByteArray& data);
     void parseVersion(const QByteArray& data);
@@ -392,6 +406,8 @@ private:
     void onProfileUploadWriteComplete(const QBluetoothUuid& uuid,
                                       const QByteArray& data);
     void finishProfileUpload(bool success, const QString& reason = QString());
+    void sendProfile(const Profile& profile, bool startEspresso);
+    void invalidateLoadedProfile();
 
     // Owned when created internally via connectToDevice(); set externally via setTransport() for USB
     DE1Transport* m_transport = nullptr;
@@ -478,15 +494,27 @@ private:
     bool m_uploadEspressoStartAcked = false;
     bool m_uploadExpectEspressoStart = false;
     QMetaObject::Connection m_uploadConnection;
+
+    // Byte-exact header and frames of the last upload the DE1 verifiably
+    // acknowledged, so a repeat upload can be skipped and an edit can send
+    // only the frames that changed. m_upload* hold the full image of the
+    // upload in flight, which becomes the loaded one when it verifies.
+    // Dropped on any failed upload, transport change or disconnect, direct
+    // header/frame writes, firmware flash, and machine states where the
+    // firmware restarts or runs its own programs.
+    bool m_hasLoadedProfile = false;
+    QByteArray m_loadedProfileHeader;
+    QList<QByteArray> m_loadedProfileFrames;
+    QByteArray m_uploadHeaderBytes;
+    QList<QByteArray> m_uploadFrames;
     QTimer m_uploadTimeoutTimer;
     bool m_usbChargerOn = true;  // Default on (safe default like de1app)
     bool m_isHeadless = false;   // True if app can start operations (GHC not installed or inactive)
     int m_refillKitDetected = -1;  // -1=unknown, 0=not detected, 1=detected
 
-    // SAW stop latency instrumentation (monotonic ms timestamps)
-    bool m_sawStopWritePending = false;
-    qint64 m_lastSawTriggerMs = 0;
-    qint64 m_lastSawWriteMs = 0;
+    // SAW stop latency instrumentation: the stop in flight, until the write is
+    // acknowledged and the DE1 reports a state change (writeMs == 0: none)
+    SawLatencyTrace m_sawTrace;
 
 #ifdef DECENZA_TESTING
     friend class tst_SAV;
@@ -3,6 +3,7 @@
 #include <QObject>
 #include <QBluetoothUuid>
 #include <QByteArray>
+#include <QJsonObject>
 #include <QString>
 
 /**
@@ -35,7 +36,7 @@ public:
      * Write data bypassing any command queue.
      * Used for time-critical operations like stop-at-weight (SAW) and
      * ensureChargerOn (app suspend). Default implementation delegates to
-     * write(). BLE overrides this to bypass its 50ms command queue for
+     * write(). BLE overrides this to bypass its command queue for
      * lower latency. Does not clear the queue — callers that need to
      * clear pending commands do so explicitly before calling this.
      */
@@ -43,6 +44,24 @@ public:
         write(uuid, data);
     }
 
+    // Queue lane for writeInLane(); write() uses Interactive
+    enum class WriteLane { Interactive, Background };
+
+    /**
+     * Write through a queue lane, optionally coalescing. Queuing transports
+     * send Interactive writes before Background ones, and replace a queued,
+     * not-yet-sent write with the same characteristic and coalesceKey
+     * instead of sending both — only use a key for last-value-wins state
+     * (an MMR register, SHOT_SETTINGS). Writes to one characteristic still
+     * reach it in call order. Default implementation delegates to write().
+     */
+    virtual void writeInLane(const QBluetoothUuid& uuid, const QByteArray& data,
+                             WriteLane lane, const QByteArray& coalesceKey = QByteArray()) {
+        Q_UNUSED(lane);
+        Q_UNUSED(coalesceKey);
+        write(uuid, data);
+    }
+
     /**
      * Read data from a characteristic.
      * Result arrives via dataReceived() signal.
@@ -78,6 +97,13 @@ public:
      */
     virtual qsizetype clearQueue() { return 0; }
 
+    /**
+     * Command queue diagnostics (queue depth, in-flight writes, write
+     * latency, retries) for the debug endpoints. Transports without a
+     * queue return an empty object.
+     */
+    virtual QJsonObject queueStats() const { return QJsonObject(); }
+
     /**
      * Check if the transport is currently connected.
      */
@@ -104,8 +130,10 @@ signals:
      * Emitted when data is received from a characteristic (notification or read response).
      * @param uuid The characteristic that produced the data.
      * @param data The raw binary payload.
+     * @param arrivalMs ArrivalClock stamp taken when the transport received
+     *        the data; 0 if the emitter didn't stamp it.
      */
-    void dataReceived(const QBluetoothUuid& uuid, const QByteArray& data);
+    void dataReceived(const QBluetoothUuid& uuid, const QByteArray& data, qint64 arrivalMs = 0);
 
     /**
      * Emitted when a write operation completes successfully.
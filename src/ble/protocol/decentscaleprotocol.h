@@ -1,19 +1,47 @@
 #pragma once
 
 #include <QByteArray>
+#include <array>
 #include <cstdint>
 
 // Decent Scale 7-byte binary packet protocol, shared by BLE and USB paths.
 // Packet format: [0x03, type, data0, data1, data2, data3, XOR]
 namespace DecentScaleProtocol {
 
-// XOR checksum: XOR of all bytes except the last (byte 6 in a 7-byte packet).
-inline uint8_t calculateXor(const QByteArray& data) {
+constexpr uint8_t kHeader = 0x03;
+constexpr int kPacketLength = 7;
+constexpr uint8_t kLedResponse = 0x0A;
+
+// XOR of the first size - 1 bytes (the checksum of a size-byte packet)
+inline uint8_t calculateXor(const uint8_t* data, int size) {
     uint8_t result = 0;
-    for (qsizetype i = 0; i < data.size() - 1; i++) {
-        result ^= static_cast<uint8_t>(data[i]);
+    for (int i = 0; i < size - 1; i++) {
+        result ^= data[i];
     }
     return result;
 }
 
+// XOR checksum: XOR of all bytes except the last (byte 6 in a 7-byte packet).
+inline uint8_t calculateXor(const QByteArray& data) {
+    return calculateXor(reinterpret_cast<const uint8_t*>(data.constData()), static_cast<int>(data.size()));
+}
+
+// FramedStreamParser format: 0x03, then six bytes. The LED response (0x0A)
+// uses all seven for data and has no checksum.
+struct Frame {
+    static constexpr std::array<uint8_t, 1> sync{{kHeader}};
+    static constexpr int headerLength = 1;
+    static constexpr int maxFrameLength = kPacketLength;
+    static int frameLength(const uint8_t*) { return kPacketLength; }
+    static bool checksumValid(const uint8_t* frame, int length) {
+        return frame[1] == kLedResponse || calculateXor(frame, length) == frame[length - 1];
+    }
+};
+
+// Same framing, checksum not checked: original (v1) Decent Scales don't
+// compute it correctly
+struct UncheckedFrame : Frame {
+    static bool checksumValid(const uint8_t*, int) { return true; }
+};
+
 } // namespace DecentScaleProtocol
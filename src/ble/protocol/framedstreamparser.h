@@ -0,0 +1,145 @@
+#pragma once
+
+#include <QByteArray>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+/**
+ * A frame handed out by FramedStreamParser. Points either into the
+ * notification being fed (frame arrived whole) or into the parser's buffer
+ * (frame was split across notifications); valid only during the callback.
+ */
+struct FrameView {
+    const uint8_t* data = nullptr;
+    int size = 0;
+
+    uint8_t operator[](int i) const { return data[i]; }
+};
+
+/**
+ * Reassembles framed messages from a BLE notification stream, for scale
+ * protocols that split a message across notifications or pack several into
+ * one.
+ *
+ * Format describes the frame at compile time:
+ *
+ *   struct MyFrame {
+ *       static constexpr std::array<uint8_t, 2> sync{{0xEF, 0xDD}};  // Every frame starts with these
+ *       static constexpr int headerLength = 4;       // Bytes frameLength() reads (>= sync size)
+ *       static constexpr int maxFrameLength = 260;   // Anything longer is corruption
+ *       static int frameLength(const uint8_t* header);              // Whole frame, from its header
+ *       static bool checksumValid(const uint8_t* frame, int length);
+ *   };
+ *
+ * feed() calls onFrame(const FrameView&) for each complete frame with a
+ * valid checksum, in order. Bytes that can't start a frame are skipped up to
+ * the next sync sequence; a sync with an impossible length or a bad checksum
+ * is skipped by one byte so a frame starting inside it is still found. Nothing
+ * is allocated: frames are parsed in place in the notification, and only an
+ * incomplete tail is copied into the fixed Capacity-byte buffer.
+ */
+template <typename Format, int Capacity = 2 * Format::maxFrameLength>
+class FramedStreamParser {
+    static_assert(Format::headerLength >= static_cast<int>(Format::sync.size()),
+                  "header must include the sync bytes");
+    static_assert(Capacity >= Format::maxFrameLength, "buffer can't hold a whole frame");
+
+public:
+    template <typename OnFrame>
+    void feed(const uint8_t* data, int size, OnFrame&& onFrame)
+    {
+        if (m_size == 0) {
+            const int consumed = parse(data, size, onFrame);
+            stash(data + consumed, size - consumed);
+            return;
+        }
+
+        // A frame is pending: append and parse from the buffer, a bufferful
+        // at a time if the notification is larger than the free space
+        while (size > 0) {
+            const int chunk = std::min(size, Capacity - m_size);
+            std::memcpy(m_buffer.data() + m_size, data, static_cast<size_t>(chunk));
+            m_size += chunk;
+            data += chunk;
+            size -= chunk;
+
+            const int consumed = parse(m_buffer.data(), m_size, onFrame);
+            m_size -= consumed;
+            std::memmove(m_buffer.data(), m_buffer.data() + consumed, static_cast<size_t>(m_size));
+        }
+    }
+
+    template <typename OnFrame>
+    void feed(const QByteArray& data, OnFrame&& onFrame)
+    {
+        feed(reinterpret_cast<const uint8_t*>(data.constData()), static_cast<int>(data.size()),
+             std::forward<OnFrame>(onFrame));
+    }
+
+    void reset() { m_size = 0; }
+
+    // Bytes of an incomplete frame waiting for the next notification
+    int buffered() const { return m_size; }
+    // Bytes discarded while looking for a frame, since construction
+    qint64 skippedBytes() const { return m_skipped; }
+
+private:
+    // Delivers every complete frame in [data, data + size); returns how many
+    // bytes were used up. The rest is the start of a frame still arriving.
+    template <typename OnFrame>
+    int parse(const uint8_t* data, int size, OnFrame& onFrame)
+    {
+        int pos = 0;
+        while (pos < size) {
+            const int start = findSync(data + pos, size - pos);
+            m_skipped += start;
+            pos += start;
+
+            if (size - pos < Format::headerLength) break;
+
+            const int length = Format::frameLength(data + pos);
+            if (length < Format::headerLength || length > Format::maxFrameLength) {
+                ++pos;
+                ++m_skipped;
+                continue;
+            }
+            if (size - pos < length) break;
+
+            if (!Format::checksumValid(data + pos, length)) {
+                ++pos;
+                ++m_skipped;
+                continue;
+            }
+            onFrame(FrameView{data + pos, length});
+            pos += length;
+        }
+        return pos;
+    }
+
+    // Offset of the first sync sequence, or of a partial one ending the data;
+    // size if there is neither
+    static int findSync(const uint8_t* data, int size)
+    {
+        constexpr int syncSize = static_cast<int>(Format::sync.size());
+        for (int i = 0; i < size; ++i) {
+            const int n = std::min(syncSize, size - i);
+            if (std::memcmp(data + i, Format::sync.data(), static_cast<size_t>(n)) == 0)
+                return i;
+        }
+        return size;
+    }
+
+    void stash(const uint8_t* data, int size)
+    {
+        // parse() only leaves less than one frame behind
+        std::memcpy(m_buffer.data(), data, static_cast<size_t>(size));
+        m_size = size;
+    }
+
+    std::array<uint8_t, Capacity> m_buffer;
+    int m_size = 0;
+    qint64 m_skipped = 0;
+};
@@ -0,0 +1,165 @@
+#include "replaytransport.h"
+#include "arrivalclock.h"
+
+#include <QLowEnergyCharacteristic>
+#include <algorithm>
+
+// -- ReplayDE1Transport --
+
+void ReplayDE1Transport::write(const QBluetoothUuid& uuid, const QByteArray& data) {
+    m_writes.append({uuid, data});
+    QMetaObject::invokeMethod(this, [this, uuid, data]() {
+        if (m_connected) emit writeComplete(uuid, data);
+    }, Qt::QueuedConnection);
+}
+
+void ReplayDE1Transport::disconnect() {
+    if (!m_connected) return;
+    m_connected = false;
+    emit disconnected();
+}
+
+void ReplayDE1Transport::open() {
+    if (m_connected) return;
+    m_connected = true;
+    emit connected();
+}
+
+void ReplayDE1Transport::inject(const QBluetoothUuid& uuid, const QByteArray& data) {
+    if (m_connected) emit dataReceived(uuid, data, ArrivalClock::nowMs());
+}
+
+// -- ReplayScaleTransport --
+
+void ReplayScaleTransport::connectToDevice(const QString&, const QString&) {
+    QMetaObject::invokeMethod(this, [this]() {
+        m_connected = true;
+        emit connected();
+    }, Qt::QueuedConnection);
+}
+
+void ReplayScaleTransport::disconnectFromDevice() {
+    if (!m_connected) return;
+    m_connected = false;
+    emit disconnected();
+}
+
+void ReplayScaleTransport::discoverServices() {
+    QMetaObject::invokeMethod(this, [this]() {
+        for (const QBluetoothUuid& service : std::as_const(m_services))
+            emit serviceDiscovered(service);
+        emit servicesDiscoveryFinished();
+    }, Qt::QueuedConnection);
+}
+
+void ReplayScaleTransport::discoverCharacteristics(const QBluetoothUuid& serviceUuid) {
+    QMetaObject::invokeMethod(this, [this, serviceUuid]() {
+        const int properties = int(QLowEnergyCharacteristic::Read) | int(QLowEnergyCharacteristic::Write)
+                             | int(QLowEnergyCharacteristic::Notify);
+        for (const QBluetoothUuid& characteristic : std::as_const(m_characteristics))
+            emit characteristicDiscovered(serviceUuid, characteristic, properties);
+        emit characteristicsDiscoveryFinished(serviceUuid);
+    }, Qt::QueuedConnection);
+}
+
+void ReplayScaleTransport::enableNotifications(const QBluetoothUuid&, const QBluetoothUuid& characteristicUuid) {
+    QMetaObject::invokeMethod(this, [this, characteristicUuid]() {
+        emit notificationsEnabled(characteristicUuid);
+    }, Qt::QueuedConnection);
+}
+
+void ReplayScaleTransport::writeCharacteristic(const QBluetoothUuid&, const QBluetoothUuid& characteristicUuid,
+                                               const QByteArray& data, WriteType writeType) {
+    m_writes.append({characteristicUuid, data});
+    if (writeType == WriteType::WithoutResponse) return;
+    QMetaObject::invokeMethod(this, [this, characteristicUuid]() {
+        if (m_connected) emit characteristicWritten(characteristicUuid);
+    }, Qt::QueuedConnection);
+}
+
+void ReplayScaleTransport::inject(BleCaptureRecord::Kind kind, const QBluetoothUuid& uuid, const QByteArray& data) {
+    if (!m_connected) return;
+    if (kind == BleCaptureRecord::Kind::Read)
+        emit characteristicRead(uuid, data);
+    else
+        emit characteristicChanged(uuid, data, ArrivalClock::nowMs());
+}
+
+// -- ReplayTransport --
+
+ReplayTransport::ReplayTransport(const QList<BleCaptureRecord>& records, QObject* parent)
+    : QObject(parent)
+    , m_records(records)
+    , m_de1(new ReplayDE1Transport(this))
+    , m_scale(new ReplayScaleTransport(this))
+{
+    for (const BleCaptureRecord& record : std::as_const(m_records)) {
+        if (record.source == BleCaptureRecord::Source::Scale)
+            m_scale->addCharacteristic(record.uuid);
+    }
+
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ReplayTransport::onTimer);
+}
+
+ReplayTransport* ReplayTransport::fromFile(const QString& path, QString* error, QObject* parent) {
+    QList<BleCaptureRecord> records;
+    if (!BleCapture::readFile(path, &records, error))
+        return nullptr;
+    return new ReplayTransport(records, parent);
+}
+
+void ReplayTransport::start() {
+    m_de1->open();
+    m_baseUs = atEnd() ? 0 : m_records[m_position].timestampUs;
+    m_clock.start();
+    scheduleNext();
+}
+
+void ReplayTransport::stop() {
+    m_timer.stop();
+}
+
+bool ReplayTransport::step() {
+    if (atEnd()) return false;
+    deliver(m_records[m_position++]);
+    if (atEnd()) {
+        m_timer.stop();
+        emit finished();
+    }
+    return true;
+}
+
+// -- Private --
+
+void ReplayTransport::deliver(const BleCaptureRecord& record) {
+    if (record.kind == BleCaptureRecord::Kind::Write) return;
+
+    if (record.source == BleCaptureRecord::Source::DE1)
+        m_de1->inject(record.uuid, record.payload);
+    else if (m_scale)
+        m_scale->inject(record.kind, record.uuid, record.payload);
+}
+
+void ReplayTransport::onTimer() {
+    if (m_speed == Speed::AsFastAsPossible) {
+        step();
+    } else {
+        // Everything that has come due, in case the timer fired late
+        const qint64 nowUs = m_baseUs + m_clock.nsecsElapsed() / 1000;
+        while (!atEnd() && m_records[m_position].timestampUs <= nowUs)
+            step();
+    }
+    scheduleNext();
+}
+
+void ReplayTransport::scheduleNext() {
+    if (atEnd()) return;
+    if (m_speed == Speed::AsFastAsPossible) {
+        m_timer.start(0);
+        return;
+    }
+    const qint64 dueUs = m_records[m_position].timestampUs - m_baseUs;
+    const qint64 waitMs = (dueUs - m_clock.nsecsElapsed() / 1000) / 1000;
+    m_timer.start(static_cast<int>(std::max<qint64>(0, waitMs)));
+}
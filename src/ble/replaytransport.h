@@ -0,0 +1,145 @@
+#pragma once
+
+#include "blecapture.h"
+#include "de1transport.h"
+#include "transport/scalebletransport.h"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QTimer>
+
+/**
+ * DE1 side of a capture replay. Looks connected once playback starts;
+ * writes from the app are kept (for comparison with the capture) and
+ * acknowledged on the next event-loop turn, as the BLE stack would.
+ */
+class ReplayDE1Transport : public DE1Transport {
+    Q_OBJECT
+
+public:
+    explicit ReplayDE1Transport(QObject* parent = nullptr) : DE1Transport(parent) {}
+
+    void write(const QBluetoothUuid& uuid, const QByteArray& data) override;
+    void read(const QBluetoothUuid&) override {}
+    void subscribe(const QBluetoothUuid&) override {}
+    void subscribeAll() override {}
+    void disconnect() override;
+    bool isConnected() const override { return m_connected; }
+    QString transportName() const override { return QStringLiteral("Replay"); }
+
+    const QList<QPair<QBluetoothUuid, QByteArray>>& writes() const { return m_writes; }
+
+    // Driven by ReplayTransport
+    void open();
+    void inject(const QBluetoothUuid& uuid, const QByteArray& data);
+
+private:
+    bool m_connected = false;
+    QList<QPair<QBluetoothUuid, QByteArray>> m_writes;
+};
+
+/**
+ * Scale side of a capture replay, handed to a ScaleDevice in place of the
+ * platform transport (the scale takes ownership). Connection and discovery
+ * succeed immediately: every service added with addService() is reported,
+ * and each reports every characteristic the capture touched. Captures don't
+ * record service UUIDs, so the caller adds the scale's own service.
+ */
+class ReplayScaleTransport : public ScaleBleTransport {
+    Q_OBJECT
+
+public:
+    explicit ReplayScaleTransport(QObject* parent = nullptr) : ScaleBleTransport(parent) {}
+
+    void addService(const QBluetoothUuid& serviceUuid) { m_services.append(serviceUuid); }
+    void addCharacteristic(const QBluetoothUuid& uuid) {
+        if (!m_characteristics.contains(uuid)) m_characteristics.append(uuid);
+    }
+
+    void connectToDevice(const QString& address, const QString& name) override;
+    void disconnectFromDevice() override;
+    void discoverServices() override;
+    void discoverCharacteristics(const QBluetoothUuid& serviceUuid) override;
+    void enableNotifications(const QBluetoothUuid& serviceUuid,
+                             const QBluetoothUuid& characteristicUuid) override;
+    void writeCharacteristic(const QBluetoothUuid& serviceUuid,
+                             const QBluetoothUuid& characteristicUuid,
+                             const QByteArray& data,
+                             WriteType writeType = WriteType::WithResponse) override;
+    void readCharacteristic(const QBluetoothUuid&, const QBluetoothUuid&) override {}
+    bool isConnected() const override { return m_connected; }
+
+    const QList<QPair<QBluetoothUuid, QByteArray>>& writes() const { return m_writes; }
+
+    // Driven by ReplayTransport
+    void inject(BleCaptureRecord::Kind kind, const QBluetoothUuid& uuid, const QByteArray& data);
+
+private:
+    bool m_connected = false;
+    QList<QBluetoothUuid> m_services;
+    QList<QBluetoothUuid> m_characteristics;  // First-seen order
+    QList<QPair<QBluetoothUuid, QByteArray>> m_writes;
+};
+
+/**
+ * Plays a BLE capture (see BleCaptureTap) back through the real DE1Device
+ * and ScaleDevice code, so a field report can be reproduced on a desk.
+ *
+ * Hand de1() to DE1Device::setTransport() and scale() to the scale class
+ * the capture came from, then start(). RealTime keeps the recorded spacing
+ * between events; AsFastAsPossible delivers one event per event-loop turn,
+ * which keeps the order deterministic (queued work triggered by one event
+ * runs before the next) while finishing a shot in milliseconds. step()
+ * delivers the next event synchronously for tests that drive playback by
+ * hand. Recorded writes are not replayed — the app under test produces its
+ * own, available from each transport's writes().
+ */
+class ReplayTransport : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Speed { RealTime, AsFastAsPossible };
+
+    explicit ReplayTransport(const QList<BleCaptureRecord>& records, QObject* parent = nullptr);
+
+    // Loads a capture file; nullptr (with *error set) if it can't be read
+    static ReplayTransport* fromFile(const QString& path, QString* error = nullptr,
+                                     QObject* parent = nullptr);
+
+    void setSpeed(Speed speed) { m_speed = speed; }
+    Speed speed() const { return m_speed; }
+
+    ReplayDE1Transport* de1() { return m_de1; }
+    ReplayScaleTransport* scale() { return m_scale; }
+
+    // Connects the DE1 transport and begins timed playback
+    void start();
+    void stop();
+    // Delivers the next event now; false once the capture is exhausted
+    bool step();
+
+    qsizetype position() const { return m_position; }
+    qsizetype count() const { return m_records.size(); }
+    bool atEnd() const { return m_position >= m_records.size(); }
+
+signals:
+    void finished();
+
+private:
+    void deliver(const BleCaptureRecord& record);
+    void onTimer();
+    void scheduleNext();
+
+    QList<BleCaptureRecord> m_records;
+    qsizetype m_position = 0;
+    Speed m_speed = Speed::RealTime;
+
+    ReplayDE1Transport* m_de1;
+    QPointer<ReplayScaleTransport> m_scale;  // Owned by the scale once handed over
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_baseUs = 0;  // Capture time that maps to m_clock's start
+};
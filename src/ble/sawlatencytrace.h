@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * ArrivalClock stamps (ms) along one stop-at-weight stop, from the scale
+ * reading that tripped it to the DE1 reacting. WeightProcessor fills in the
+ * first three, DE1Device the rest; 0 means the step wasn't seen (e.g. a
+ * reading with no arrival stamp).
+ */
+struct SawLatencyTrace {
+    qint64 arrivalMs = 0;   // Scale notification reached the transport
+    qint64 processMs = 0;   // WeightProcessor::processWeight picked it up
+    qint64 triggerMs = 0;   // WeightProcessor::stopNow emitted
+    qint64 writeMs = 0;     // Urgent Idle write handed to the transport
+    qint64 ackMs = 0;       // Transport reported the write complete
+    qint64 stateMs = 0;     // DE1 state notification showing it stopped
+
+    bool complete() const { return writeMs > 0 && ackMs > 0 && stateMs > 0; }
+};
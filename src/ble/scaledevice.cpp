@@ -1,4 +1,5 @@
 #include "scaledevice.h"
+#include "arrivalclock.h"
 #include <QDebug>
 
 ScaleDevice::ScaleDevice(QObject* parent)
@@ -82,10 +83,10 @@ void ScaleDevice::setConnected(bool connected) {
     }
 }
 
-void ScaleDevice::setWeight(double weight) {
+void ScaleDevice::setWeight(double weight, qint64 arrivalMs) {
     if (m_weight != weight) {
         m_weight = weight;
-        emit weightChanged(weight);
+        emit weightChanged(weight, arrivalMs > 0 ? arrivalMs : ArrivalClock::nowMs());
     }
 }
 
@@ -59,7 +59,9 @@ public slots:
 
 signals:
     void connectedChanged();
-    void weightChanged(double weight);
+    // arrivalMs: ArrivalClock stamp of the notification that carried the
+    // reading (0 for the simulation reset)
+    void weightChanged(double weight, qint64 arrivalMs = 0);
     void flowRateChanged(double rate);
     void batteryLevelChanged(int level);
     void buttonPressed(int button);
@@ -70,7 +72,8 @@ signals:
 
 protected:
     void setConnected(bool connected);
-    void setWeight(double weight);
+    // arrivalMs: when the transport received the reading; 0 stamps it now
+    void setWeight(double weight, qint64 arrivalMs = 0);
     void setFlowRate(double rate);
     void setBatteryLevel(int level);
 
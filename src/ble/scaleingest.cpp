@@ -0,0 +1,56 @@
+#include "scaleingest.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+
+ScaleIngest* ScaleIngest::s_instance = nullptr;
+
+ScaleIngest::ScaleIngest()
+{
+    m_thread.setObjectName(QStringLiteral("ScaleIngest"));
+    m_thread.start(QThread::HighPriority);
+    s_instance = this;
+}
+
+ScaleIngest::~ScaleIngest()
+{
+    stop();
+    if (s_instance == this) s_instance = nullptr;
+}
+
+ScaleBleTransport* ScaleIngest::wrap(ScaleBleTransport* transport,
+                                     IngestScaleBleTransport::WeightDecoder decoder)
+{
+    if (!transport) return nullptr;
+    m_transports.append(transport);
+    return new IngestScaleBleTransport(transport, &m_thread, decoder, m_sink);
+}
+
+void ScaleIngest::stop()
+{
+    if (!m_thread.isRunning()) return;
+    // Queued behind whatever is already posted to the thread
+    auto* stopper = new QObject;
+    stopper->moveToThread(&m_thread);
+    QMetaObject::invokeMethod(stopper, [this, stopper]() {
+        // Release GATT connections while the transports can still act on it
+        for (const QPointer<ScaleBleTransport>& transport : std::as_const(m_transports)) {
+            if (transport && transport->isConnected())
+                transport->disconnectFromDevice();
+        }
+        stopper->deleteLater();
+        m_thread.quit();
+    }, Qt::QueuedConnection);
+
+    // Not a plain wait(): a disconnect may block on the main thread
+    QElapsedTimer waited;
+    waited.start();
+    while (!m_thread.wait(10)) {
+        if (waited.elapsed() >= 1000) {
+            qWarning() << "[ScaleIngest] Thread did not stop within 1 s";
+            return;
+        }
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+}
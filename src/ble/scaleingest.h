@@ -0,0 +1,55 @@
+#pragma once
+
+#include "transport/ingestscalebletransport.h"
+#include <QList>
+#include <QPointer>
+#include <QThread>
+
+/**
+ * The thread scale notifications are received and decoded on.
+ *
+ * main.cpp creates one at startup and moves WeightProcessor onto
+ * ingestThread(). While it exists, instance() returns it and ScaleFactory
+ * wraps every scale transport it creates in an IngestScaleBleTransport with
+ * the scale's weight decoder and the sink set here, so readings reach
+ * WeightProcessor by a direct call on this thread instead of through the GUI
+ * thread's event queue. Scales without a decoder still get their transport
+ * moved here; their weight goes through ScaleDevice::weightChanged as before.
+ * CoreBluetooth transports (iOS/macOS) are never wrapped: they must stay on
+ * the main dispatch queue.
+ */
+class ScaleIngest {
+public:
+    ScaleIngest();
+    ~ScaleIngest();
+
+    ScaleIngest(const ScaleIngest&) = delete;
+    ScaleIngest& operator=(const ScaleIngest&) = delete;
+
+    // The running ingest, or nullptr
+    static ScaleIngest* instance() { return s_instance; }
+
+    QThread* ingestThread() { return &m_thread; }
+
+    // Receives every decoded reading on the ingest thread. Set before any
+    // scale is created; transports take a copy when they are wrapped.
+    void setWeightSink(IngestScaleBleTransport::WeightSink sink) { m_sink = std::move(sink); }
+
+    // Moves transport onto the ingest thread behind a proxy that lives on
+    // the caller's thread; decoder may be nullptr
+    ScaleBleTransport* wrap(ScaleBleTransport* transport,
+                            IngestScaleBleTransport::WeightDecoder decoder);
+
+    // Runs the work already queued for the thread, disconnects any transport
+    // still connected, then stops it. Keeps processing the calling thread's
+    // events while it waits, so a disconnect that needs the main thread
+    // (a blocking call into it) can't deadlock against the wait.
+    void stop();
+
+private:
+    QThread m_thread;
+    IngestScaleBleTransport::WeightSink m_sink;
+    QList<QPointer<ScaleBleTransport>> m_transports;  // Only dereferenced on m_thread
+
+    static ScaleIngest* s_instance;
+};
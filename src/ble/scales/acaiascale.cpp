@@ -75,7 +75,7 @@ void AcaiaScale::connectToDevice(const QBluetoothDeviceInfo& device) {
     m_weightReceived = false;
     m_isConnecting = true;
     m_identRetryCount = 0;
-    m_buffer.clear();
+    m_parser.reset();
 
     m_name = device.name();
     m_transport->connectToDevice(device);
@@ -227,12 +227,12 @@ void AcaiaScale::onInitTimer() {
     ACAIA_LOG(QString("Init attempt %1/%2").arg(m_identRetryCount).arg(MAX_IDENT_RETRIES));
 }
 
-void AcaiaScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value) {
+void AcaiaScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value, qint64 arrivalMs) {
     // Check if it's from our status characteristic
     if (m_isPyxis && characteristicUuid == Scale::Acaia::STATUS) {
-        parseResponse(value);
+        parseResponse(value, arrivalMs);
     } else if (!m_isPyxis && characteristicUuid == Scale::AcaiaIPS::CHARACTERISTIC) {
-        parseResponse(value);
+        parseResponse(value, arrivalMs);
     }
 }
 
@@ -297,76 +297,44 @@ void AcaiaScale::sendCommand(const QByteArray& command) {
     }
 }
 
-void AcaiaScale::parseResponse(const QByteArray& data) {
-    // Append to buffer
-    m_buffer.append(data);
-
-    // Need at least 6 bytes for a valid message
-    if (m_buffer.size() < 6) return;
-
-    const uint8_t* buf = reinterpret_cast<const uint8_t*>(m_buffer.constData());
-
-    // Find message start (0xEF 0xDD)
-    int msgStart = -1;
-    for (int i = 0; i < m_buffer.size() - 1; i++) {
-        if (buf[i] == 0xEF && buf[i + 1] == 0xDD) {
-            msgStart = i;
-            break;
-        }
-    }
-
-    if (msgStart < 0) {
-        m_buffer.clear();
-        return;
-    }
-
-    // Skip bytes before message start
-    if (msgStart > 0) {
-        m_buffer = m_buffer.mid(msgStart);
-        buf = reinterpret_cast<const uint8_t*>(m_buffer.constData());
-    }
-
-    // Check if we have enough data for metadata
-    if (m_buffer.size() < ACAIA_METADATA_LEN + 1) return;
+void AcaiaScale::parseResponse(const QByteArray& data, qint64 arrivalMs) {
+    // Messages can be split across notifications or share one
+    m_parser.feed(data, [this, arrivalMs](const FrameView& msg) {
+        handleMessage(msg, arrivalMs);
+    });
+}
 
-    uint8_t msgType = buf[2];
-    uint8_t length = buf[3];
-    uint8_t eventType = buf[4];
+void AcaiaScale::handleMessage(const FrameView& msg, qint64 arrivalMs) {
+    uint8_t msgType = msg[2];
+    uint8_t eventType = msg[4];
 
     // Mark that we're receiving notifications (not just info messages)
     if (msgType != 7) {
         m_receivingNotifications = true;
     }
 
-    // Check if we have the complete message
-    int msgEnd = ACAIA_METADATA_LEN + length;
-    if (m_buffer.size() < msgEnd) return;
-
     // Weight messages (msgType 0x0C, eventType 5 or 11)
     if (msgType == 0x0C && (eventType == 5 || eventType == 11)) {
         int payloadOffset = (eventType == 5) ? ACAIA_METADATA_LEN : ACAIA_METADATA_LEN + 3;
-        decodeWeight(m_buffer, payloadOffset);
+        decodeWeight(msg, payloadOffset, arrivalMs);
     }
 
     // Settings response (msgType 0x08): contains battery level
-    // Unlike 0x0C event messages, 0x08 has no eventType byte — payload starts at buf[4]:
-    //   buf[4]=payload[0] (unknown), buf[5]=payload[1] (battery), buf[6]=payload[2] (units), ...
+    // Unlike 0x0C event messages, 0x08 has no eventType byte — payload starts at msg[4]:
+    //   msg[4]=payload[0] (unknown), msg[5]=payload[1] (battery), msg[6]=payload[2] (units), ...
     // Battery masked with 0x7F gives 0-100%
-    if (msgType == 0x08 && m_buffer.size() >= 6) {
-        int batteryLevel = buf[5] & 0x7F;
+    if (msgType == 0x08) {
+        int batteryLevel = msg[5] & 0x7F;
         if (batteryLevel >= 0 && batteryLevel <= 100) {
             setBatteryLevel(batteryLevel);
         }
     }
-
-    // Clear buffer after processing
-    m_buffer.clear();
 }
 
-void AcaiaScale::decodeWeight(const QByteArray& data, int payloadOffset) {
-    if (data.size() < payloadOffset + 6) return;
+void AcaiaScale::decodeWeight(const FrameView& msg, int payloadOffset, qint64 arrivalMs) {
+    if (msg.size < payloadOffset + 6) return;
 
-    const uint8_t* payload = reinterpret_cast<const uint8_t*>(data.constData()) + payloadOffset;
+    const uint8_t* payload = msg.data + payloadOffset;
 
     // Weight is 3 bytes, little-endian
     int32_t value = ((payload[2] & 0xFF) << 16) |
@@ -391,7 +359,7 @@ void AcaiaScale::decodeWeight(const QByteArray& data, int payloadOffset) {
         setConnected(true);
     }
 
-    setWeight(weight);
+    setWeight(weight, arrivalMs);
 }
 
 void AcaiaScale::sendKeepAlive() {
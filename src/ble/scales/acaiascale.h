@@ -2,9 +2,20 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedstreamparser.h"
 #include <QTimer>
 #include <QByteArray>
 
+// Acaia message framing: EF DD, type, length, then length + 1 bytes. The
+// trailing checksum isn't verified, matching de1app.
+struct AcaiaFrame {
+    static constexpr std::array<uint8_t, 2> sync{{0xEF, 0xDD}};
+    static constexpr int headerLength = 4;
+    static constexpr int maxFrameLength = 5 + 255;
+    static int frameLength(const uint8_t* header) { return std::max(6, 5 + header[3]); }
+    static bool checksumValid(const uint8_t*, int) { return true; }
+};
+
 class AcaiaScale : public ScaleDevice {
     Q_OBJECT
 
@@ -30,7 +41,8 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
     void sendHeartbeat();
     void sendIdent();
     void sendConfig();
@@ -38,8 +50,12 @@ private slots:
     void onInitTimer();  // Handles ident/config retry sequence
 
 private:
-    void parseResponse(const QByteArray& data);
-    void decodeWeight(const QByteArray& payload, int payloadOffset);
+#ifdef DECENZA_TESTING
+    friend class tst_ScaleProtocol;
+#endif
+    void parseResponse(const QByteArray& data, qint64 arrivalMs);
+    void handleMessage(const FrameView& msg, qint64 arrivalMs);
+    void decodeWeight(const FrameView& msg, int payloadOffset, qint64 arrivalMs);
     QByteArray encodePacket(uint8_t msgType, const QByteArray& payload);
     void sendCommand(const QByteArray& command);
     void sendTareCommand();  // Internal: sends a single tare command
@@ -62,7 +78,7 @@ private:
     int m_identRetryCount = 0;
 
     // Message parsing state
-    QByteArray m_buffer;
+    FramedStreamParser<AcaiaFrame> m_parser;
 
     // Constants
     static constexpr int ACAIA_METADATA_LEN = 5;
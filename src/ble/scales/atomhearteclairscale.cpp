@@ -125,7 +125,7 @@ bool AtomheartEclairScale::validateXor(const QByteArray& data) {
 }
 
 void AtomheartEclairScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                                    const QByteArray& value) {
+                                                    const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::AtomheartEclair::STATUS) {
         // Atomheart Eclair format: 'W' (0x57) header, 4-byte weight in milligrams, 4-byte timer, XOR byte
         if (value.size() >= 9) {
@@ -144,7 +144,7 @@ void AtomheartEclairScale::onCharacteristicChanged(const QBluetoothUuid& charact
             int32_t weightMg = d[1] | (d[2] << 8) | (d[3] << 16) | (d[4] << 24);
             double weight = weightMg / 1000.0;  // Convert to grams
 
-            setWeight(weight);
+            setWeight(weight, arrivalMs);
         }
     }
 }
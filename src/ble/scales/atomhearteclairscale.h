@@ -29,7 +29,8 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
 
 private:
     void sendCommand(const QByteArray& cmd);
@@ -67,6 +67,7 @@ void BookooScale::onTransportConnected() {
 
 void BookooScale::onTransportDisconnected() {
     BOOKOO_LOG("Transport disconnected");
+    m_parser.reset();
     setConnected(false);
 }
 
@@ -131,9 +132,9 @@ void BookooScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& servi
 }
 
 void BookooScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                          const QByteArray& value) {
+                                          const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::Bookoo::STATUS) {
-        parseWeightData(value);
+        parseWeightData(value, arrivalMs);
     }
 }
 
@@ -141,35 +142,45 @@ void BookooScale::onNotificationsEnabled(const QBluetoothUuid& characteristicUui
     BOOKOO_LOG(QString("Notifications enabled for %1").arg(characteristicUuid.toString()));
 }
 
-void BookooScale::parseWeightData(const QByteArray& data) {
+bool BookooScale::decodeWeight(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                               double* weight) {
+    if (characteristicUuid != Scale::Bookoo::STATUS || value.size() < BookooFrame::maxFrameLength) return false;
+
+    const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
+    if (d[0] != BookooFrame::sync[0] || d[1] != BookooFrame::sync[1]) return false;
+
+    *weight = frameWeight(d);
+    return true;
+}
+
+double BookooScale::frameWeight(const uint8_t* d) {
     // Bookoo 20-byte weight notification (from BooKooCode/OpenSource protocol docs):
     // [0]=0x03, [1]=0x0B, [2-4]=timer ms, [5]=unit, [6]=sign, [7-9]=weight*100,
     // [10]=flow sign, [11-12]=flow*100, [13]=battery%, [14-15]=standby min,
     // [16]=buzzer, [17]=flow smooth, [18-19]=XOR
-    // de1app only parses bytes 0-9 (weight). We also extract battery from byte 13.
-    if (data.size() >= 10) {
-        const uint8_t* d = reinterpret_cast<const uint8_t*>(data.constData());
-
-        char sign = static_cast<char>(d[6]);
+    // de1app only parses bytes 0-9 (weight).
+    char sign = static_cast<char>(d[6]);
 
-        // Weight is 3 bytes big-endian in hundredths of gram
-        uint32_t weightRaw = (d[7] << 16) | (d[8] << 8) | d[9];
-        double weight = weightRaw / 100.0;
+    // Weight is 3 bytes big-endian in hundredths of gram
+    uint32_t weightRaw = (d[7] << 16) | (d[8] << 8) | d[9];
+    double weight = weightRaw / 100.0;
 
-        if (sign == '-') {
-            weight = -weight;
-        }
+    if (sign == '-') {
+        weight = -weight;
+    }
+    return weight;
+}
 
-        setWeight(weight);
+void BookooScale::parseWeightData(const QByteArray& data, qint64 arrivalMs) {
+    m_parser.feed(data, [this, arrivalMs](const FrameView& frame) {
+        setWeight(frameWeight(frame.data), arrivalMs);
 
-        // Battery at byte 13 (0-100%)
-        if (data.size() >= 14) {
-            uint8_t battery = d[13];
-            if (battery <= 100) {
-                setBatteryLevel(battery);
-            }
+        // We also extract battery from byte 13 (0-100%)
+        uint8_t battery = frame[13];
+        if (battery <= 100) {
+            setBatteryLevel(battery);
         }
-    }
+    });
 }
 
 void BookooScale::sendCommand(const QByteArray& cmd) {
@@ -2,8 +2,19 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedstreamparser.h"
 #include <QLowEnergyCharacteristic>
 
+// Bookoo weight notification framing: 03 0B, then 18 bytes. The trailing
+// XOR isn't verified, matching de1app.
+struct BookooFrame {
+    static constexpr std::array<uint8_t, 2> sync{{0x03, 0x0B}};
+    static constexpr int headerLength = 2;
+    static constexpr int maxFrameLength = 20;
+    static int frameLength(const uint8_t*) { return maxFrameLength; }
+    static bool checksumValid(const uint8_t*, int) { return true; }
+};
+
 class BookooScale : public ScaleDevice {
     Q_OBJECT
 
@@ -15,6 +26,11 @@ public:
     QString name() const override { return m_name; }
     QString type() const override { return "bookoo"; }
 
+    // IngestScaleBleTransport::WeightDecoder: a weight frame that fills the
+    // notification. parseWeightData() also reassembles split ones.
+    static bool decodeWeight(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                             double* weight);
+
 public slots:
     void tare() override;
     void startTimer() override;
@@ -29,7 +45,8 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
     void onNotificationsEnabled(const QBluetoothUuid& characteristicUuid);
 
 private:
@@ -37,10 +54,12 @@ private:
     friend class tst_ScaleProtocol;
 #endif
     void sendCommand(const QByteArray& cmd);
-    void parseWeightData(const QByteArray& data);
+    void parseWeightData(const QByteArray& data, qint64 arrivalMs);
+    static double frameWeight(const uint8_t* frame);
 
     ScaleBleTransport* m_transport = nullptr;
     QString m_name = "Bookoo";
     bool m_serviceFound = false;
     bool m_characteristicsReady = false;
+    FramedStreamParser<BookooFrame> m_parser;
 };
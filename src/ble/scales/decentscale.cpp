@@ -69,6 +69,8 @@ void DecentScale::onTransportDisconnected() {
     }
     m_consecutiveChecksumFailures = 0;
     m_checksumDisabled = false;
+    m_parser.reset();
+    m_uncheckedParser.reset();
     setConnected(false);
 }
 
@@ -159,50 +161,76 @@ void DecentScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& servi
 }
 
 void DecentScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                          const QByteArray& value) {
+                                          const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::Decent::READ) {
         tickleWatchdog();
-        parseWeightData(value);
+        parseWeightData(value, arrivalMs);
     }
 }
 
-void DecentScale::parseWeightData(const QByteArray& data) {
-    if (data.size() < 7) return;
+bool DecentScale::decodeWeight(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                               double* weight) {
+    if (characteristicUuid != Scale::Decent::READ || value.size() < 7) return false;
 
-    const uint8_t* d = reinterpret_cast<const uint8_t*>(data.constData());
+    const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
+    if (d[1] != 0xCE && d[1] != 0xCA) return false;
+    if (DecentScaleProtocol::calculateXor(value) != d[6]) return false;
 
-    uint8_t command = d[1];
+    int16_t weightRaw = (static_cast<int16_t>(d[2]) << 8) | d[3];
+    *weight = weightRaw / 10.0;
+    return true;
+}
+
+void DecentScale::parseWeightData(const QByteArray& data, qint64 arrivalMs) {
+    const auto onPacket = [this, arrivalMs](const FrameView& packet) { handlePacket(packet, arrivalMs); };
+    if (m_checksumDisabled) {
+        m_uncheckedParser.feed(data, onPacket);
+        return;
+    }
 
     // Validate XOR checksum on all packet types except LED response (0x0A),
     // which uses all 7 bytes for data and has no room for a checksum.
     // See: https://github.com/Kulitorum/Decenza/issues/560
-    // Original Decent Scale (v1) does not compute checksums correctly — auto-disable
-    // after consecutive failures. See: https://github.com/Kulitorum/Decenza/issues/630
-    if (command != 0x0A && !m_checksumDisabled) {
-        uint8_t expected = DecentScaleProtocol::calculateXor(data);
-        if (expected != d[6]) {
-            m_consecutiveChecksumFailures++;
-            if (m_consecutiveChecksumFailures >= kChecksumFailureThreshold) {
-                m_checksumDisabled = true;
-                DECENT_WARN("Checksum validation disabled — scale may be original Decent Scale (non-HDS)");
-            } else {
-                DECENT_WARN(QString("Invalid checksum on type 0x%1, dropping packet (%2/%3)")
-                            .arg(command, 2, 16, QChar('0'))
-                            .arg(m_consecutiveChecksumFailures)
-                            .arg(kChecksumFailureThreshold));
-                return;
-            }
-        } else {
-            m_consecutiveChecksumFailures = 0;
-        }
+    int packets = 0;
+    const qint64 skippedBefore = m_parser.skippedBytes();
+    m_parser.feed(data, [&packets, &onPacket](const FrameView& packet) {
+        ++packets;
+        onPacket(packet);
+    });
+    if (packets > 0) {
+        m_consecutiveChecksumFailures = 0;
+        return;
+    }
+    if (m_parser.skippedBytes() == skippedBefore) return;  // Packet still arriving
+
+    // The parser rejected a packet. Original Decent Scale (v1) does not compute
+    // checksums correctly — auto-disable after consecutive failures and accept
+    // the packet that crossed the threshold.
+    // See: https://github.com/Kulitorum/Decenza/issues/630
+    m_consecutiveChecksumFailures++;
+    if (m_consecutiveChecksumFailures >= kChecksumFailureThreshold) {
+        m_checksumDisabled = true;
+        DECENT_WARN("Checksum validation disabled — scale may be original Decent Scale (non-HDS)");
+        m_parser.reset();
+        m_uncheckedParser.feed(data, onPacket);
+    } else {
+        const uint8_t command = data.size() > 1 ? static_cast<uint8_t>(data[1]) : 0;
+        DECENT_WARN(QString("Invalid checksum on type 0x%1, dropping packet (%2/%3)")
+                    .arg(command, 2, 16, QChar('0'))
+                    .arg(m_consecutiveChecksumFailures)
+                    .arg(kChecksumFailureThreshold));
     }
+}
+
+void DecentScale::handlePacket(const FrameView& d, qint64 arrivalMs) {
+    uint8_t command = d[1];
 
     if (command == 0xCE || command == 0xCA) {
         // Weight data
         int16_t weightRaw = (static_cast<int16_t>(d[2]) << 8) | d[3];
         double weight = weightRaw / 10.0;  // Weight in grams
-        setWeight(weight);
-    } else if (command == 0x0A && d[0] == 0x03) {
+        setWeight(weight, arrivalMs);
+    } else if (command == DecentScaleProtocol::kLedResponse) {
         // LED response packet (openscale/HDS format):
         // [0]=0x03 header, [1]=0x0A type, [2-3]=weight, [4]=battery, [5-6]=firmware version
         // Battery: 0-100 = percentage, 0xFF = charging
@@ -2,6 +2,8 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/decentscaleprotocol.h"
+#include "../protocol/framedstreamparser.h"
 #include <QTimer>
 
 class DecentScale : public ScaleDevice {
@@ -15,6 +17,13 @@ public:
     QString name() const override { return m_name; }
     QString type() const override { return "decent"; }
 
+    // IngestScaleBleTransport::WeightDecoder: a checksummed weight packet
+    // that fills the notification. Packets this rejects still reach
+    // parseWeightData(), which reassembles split ones and may accept bad
+    // checksums once they are disabled for an original Decent Scale.
+    static bool decodeWeight(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                             double* weight);
+
 public slots:
     void tare() override;
     void sendKeepAlive() override;
@@ -33,13 +42,15 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
 
 private:
 #ifdef DECENZA_TESTING
     friend class tst_ScaleProtocol;
 #endif
-    void parseWeightData(const QByteArray& data);
+    void parseWeightData(const QByteArray& data, qint64 arrivalMs);
+    void handlePacket(const FrameView& packet, qint64 arrivalMs);
     void sendCommand(const QByteArray& command);
     void sendHeartbeat();
     void enableWeightNotifications(const QString& reason);
@@ -64,6 +75,8 @@ private:
     int m_watchdogRetries = 0;
     int m_consecutiveChecksumFailures = 0;
     bool m_checksumDisabled = false;
+    FramedStreamParser<DecentScaleProtocol::Frame> m_parser;
+    FramedStreamParser<DecentScaleProtocol::UncheckedFrame> m_uncheckedParser;  // Once checksums are disabled
     QTimer* m_heartbeatTimer = nullptr;
     QTimer* m_watchdogTimer = nullptr;
 };
@@ -116,18 +116,20 @@ void DifluidScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serv
 }
 
 void DifluidScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                           const QByteArray& value) {
+                                           const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::DiFluid::CHARACTERISTIC) {
         // Difluid format: header bytes, then hex-encoded weight
         if (value.size() >= 19) {
-            // Weight is in bytes 5-8 as hex-encoded integer
-            QString hexStr = value.mid(5, 8).toHex();
-            bool ok;
-            uint32_t weightRaw = hexStr.toUInt(&ok, 16);
+            // Weight is bytes 5-12 as a big-endian integer
+            const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
+            uint64_t weightRaw = 0;
+            for (int i = 5; i < 13; i++) {
+                weightRaw = (weightRaw << 8) | d[i];
+            }
 
-            if (ok && weightRaw < 20000) {
+            if (weightRaw < 20000) {
                 double weight = weightRaw / 10.0;
-                setWeight(weight);
+                setWeight(weight, arrivalMs);
             }
         }
     }
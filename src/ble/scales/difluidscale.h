@@ -29,9 +29,13 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
 
 private:
+#ifdef DECENZA_TESTING
+    friend class tst_ScaleProtocol;
+#endif
     void sendCommand(const QByteArray& cmd);
     void enableNotifications();
     void setToGrams();
@@ -115,7 +115,7 @@ void EurekaPrecisaScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid
 }
 
 void EurekaPrecisaScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                                  const QByteArray& value) {
+                                                  const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::Generic::STATUS) {
         // Eureka Precisa format (from de1app binary scan "cucucu cu su cu su"):
         //   Bytes 0-2: header (0xAA, 0x09, 0x41)
@@ -140,7 +140,7 @@ void EurekaPrecisaScale::onCharacteristicChanged(const QBluetoothUuid& character
                 weight = -weight;
             }
 
-            setWeight(weight);
+            setWeight(weight, arrivalMs);
         }
     }
 }
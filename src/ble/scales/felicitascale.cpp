@@ -2,6 +2,9 @@
 #include "../protocol/de1characteristics.h"
 #include "scalelogging.h"
 #include <QTimer>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 #define FELICITA_LOG(msg)  SCALE_LOG("FelicitaScale", msg)
 #define FELICITA_WARN(msg) SCALE_WARN("FelicitaScale", msg)
@@ -111,13 +114,13 @@ void FelicitaScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& ser
 }
 
 void FelicitaScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                            const QByteArray& value) {
+                                            const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::Felicita::CHARACTERISTIC) {
-        parseResponse(value);
+        parseResponse(value, arrivalMs);
     }
 }
 
-void FelicitaScale::parseResponse(const QByteArray& data) {
+void FelicitaScale::parseResponse(const QByteArray& data, qint64 arrivalMs) {
     // Felicita format: header1 header2 sign weight[6] ... battery
     if (data.size() < 9) return;
 
@@ -129,18 +132,23 @@ void FelicitaScale::parseResponse(const QByteArray& data) {
     // Sign is at byte 2 ('+' or '-')
     char sign = static_cast<char>(d[2]);
 
-    // Weight is 6 ASCII digits starting at byte 3
-    QByteArray weightStr = data.mid(3, 6);
-    bool ok;
-    int weightInt = weightStr.toInt(&ok);
-    if (!ok) return;
+    // Weight is 6 ASCII digits starting at byte 3. Parsed on the stack with
+    // the same leniency as QByteArray::toInt (surrounding spaces, a sign).
+    char weightStr[7];
+    std::memcpy(weightStr, d + 3, 6);
+    weightStr[6] = '\0';
+    char* end = nullptr;
+    long weightInt = std::strtol(weightStr, &end, 10);
+    if (end == weightStr) return;
+    while (end < weightStr + 6 && std::isspace(static_cast<unsigned char>(*end))) ++end;
+    if (end != weightStr + 6) return;
 
     double weight = weightInt / 100.0;  // Weight in grams with 2 decimal places
     if (sign == '-') {
         weight = -weight;
     }
 
-    setWeight(weight);
+    setWeight(weight, arrivalMs);
 
     // Battery level is at byte 15 if available
     if (data.size() >= 16) {
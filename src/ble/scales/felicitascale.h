@@ -28,10 +28,14 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
 
 private:
-    void parseResponse(const QByteArray& data);
+#ifdef DECENZA_TESTING
+    friend class tst_ScaleProtocol;
+#endif
+    void parseResponse(const QByteArray& data, qint64 arrivalMs);
     void sendCommand(uint8_t cmd);
 
     ScaleBleTransport* m_transport = nullptr;
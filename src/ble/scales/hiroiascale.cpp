@@ -111,18 +111,16 @@ void HiroiaScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& servi
 }
 
 void HiroiaScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                          const QByteArray& value) {
+                                          const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::HiroiaJimmy::STATUS) {
         // Hiroia format: 4 bytes header, then 4 bytes weight (unsigned, tenths of gram)
         if (value.size() >= 7) {
-            // Append a zero byte to make it 8 bytes for easy parsing
-            QByteArray padded = value;
-            padded.append(static_cast<char>(0));
+            const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
 
-            const uint8_t* d = reinterpret_cast<const uint8_t*>(padded.constData());
-
-            // Weight is in bytes 4-7 as unsigned 32-bit little-endian
-            uint32_t weightRaw = d[4] | (d[5] << 8) | (d[6] << 16) | (d[7] << 24);
+            // Weight is in bytes 4-7 as unsigned 32-bit little-endian; a
+            // 7-byte packet leaves the top byte off (zero)
+            uint32_t top = value.size() >= 8 ? d[7] : 0;
+            uint32_t weightRaw = d[4] | (d[5] << 8) | (d[6] << 16) | (top << 24);
 
             // Handle negative values (if >= 8388608, it's negative)
             double weight;
@@ -133,7 +131,7 @@ void HiroiaScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUu
             }
 
             weight /= 10.0;  // Convert to grams
-            setWeight(weight);
+            setWeight(weight, arrivalMs);
         }
     }
 }
@@ -12,6 +12,8 @@
 #include "atomhearteclairscale.h"
 #include "variaakuscale.h"
 #include "timemorescale.h"
+#include "../blecapture.h"
+#include "../scaleingest.h"
 
 // Transport implementations
 #include "../transport/qtscalebletransport.h"
@@ -20,13 +22,27 @@
 #endif
 
 namespace {
-    ScaleBleTransport* createTransportForPlatform() {
+    ScaleBleTransport* createTransportForPlatform(
+            IngestScaleBleTransport::WeightDecoder decoder = nullptr) {
 #if defined(Q_OS_IOS) || defined(Q_OS_MACOS)
-        // Use native CoreBluetooth on iOS/macOS - Qt BLE has issues with CCCD discovery
-        return new CoreBluetoothScaleBleTransport();
+        // Use native CoreBluetooth on iOS/macOS - Qt BLE has issues with CCCD discovery.
+        // Not moved to the ingest thread: its CBCentralManager and the state its
+        // delegate callbacks touch belong to the main dispatch queue, which is
+        // the Qt main thread. Weight reaches WeightProcessor via weightChanged.
+        Q_UNUSED(decoder);
+        ScaleBleTransport* transport = new CoreBluetoothScaleBleTransport();
+        if (auto* tap = BleCaptureTap::instance())
+            tap->attach(transport);
+        return transport;
 #else
         // Qt 6.10+ BLE works reliably on Android and Desktop
-        return new QtScaleBleTransport();
+        ScaleBleTransport* transport = new QtScaleBleTransport();
+        if (auto* tap = BleCaptureTap::instance())
+            tap->attach(transport);
+        // Receive and decode on the ingest thread when the app runs one
+        if (auto* ingest = ScaleIngest::instance())
+            return ingest->wrap(transport, decoder);
+        return transport;
 #endif
     }
 }
@@ -58,7 +74,7 @@ std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInf
 
     switch (type) {
         case ScaleType::DecentScale:
-            return std::make_unique<DecentScale>(createTransportForPlatform(), parent);
+            return std::make_unique<DecentScale>(createTransportForPlatform(&DecentScale::decodeWeight), parent);
         case ScaleType::Acaia:
         case ScaleType::AcaiaPyxis:
             // Unified AcaiaScale auto-detects IPS vs Pyxis protocol
@@ -70,7 +86,7 @@ std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInf
         case ScaleType::HiroiaJimmy:
             return std::make_unique<HiroiaScale>(createTransportForPlatform(), parent);
         case ScaleType::Bookoo:
-            return std::make_unique<BookooScale>(createTransportForPlatform(), parent);
+            return std::make_unique<BookooScale>(createTransportForPlatform(&BookooScale::decodeWeight), parent);
         case ScaleType::SmartChef:
             return std::make_unique<SmartChefScale>(createTransportForPlatform(), parent);
         case ScaleType::Difluid:
@@ -130,7 +146,7 @@ std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInf
 
     switch (type) {
         case ScaleType::DecentScale:
-            return std::make_unique<DecentScale>(createTransportForPlatform(), parent);
+            return std::make_unique<DecentScale>(createTransportForPlatform(&DecentScale::decodeWeight), parent);
         case ScaleType::Acaia:
         case ScaleType::AcaiaPyxis:
             // Unified AcaiaScale auto-detects IPS vs Pyxis protocol
@@ -142,7 +158,7 @@ std::unique_ptr<ScaleDevice> ScaleFactory::createScale(const QBluetoothDeviceInf
         case ScaleType::HiroiaJimmy:
             return std::make_unique<HiroiaScale>(createTransportForPlatform(), parent);
         case ScaleType::Bookoo:
-            return std::make_unique<BookooScale>(createTransportForPlatform(), parent);
+            return std::make_unique<BookooScale>(createTransportForPlatform(&BookooScale::decodeWeight), parent);
         case ScaleType::SmartChef:
             return std::make_unique<SmartChefScale>(createTransportForPlatform(), parent);
         case ScaleType::Difluid:
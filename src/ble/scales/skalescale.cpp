@@ -132,14 +132,14 @@ void SkaleScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& servic
 }
 
 void SkaleScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                         const QByteArray& value) {
+                                         const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::Skale::WEIGHT) {
         // Skale weight format: byte 0 = type, bytes 1-2 = unsigned short weight (10ths of gram)
         if (value.size() >= 3) {
             const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
             int16_t weightRaw = static_cast<int16_t>((d[2] << 8) | d[1]);
             double weight = weightRaw / 10.0;
-            setWeight(weight);
+            setWeight(weight, arrivalMs);
         }
     } else if (characteristicUuid == Scale::Skale::BUTTON) {
         // Button press notification
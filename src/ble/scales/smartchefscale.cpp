@@ -111,7 +111,7 @@ void SmartChefScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& se
 }
 
 void SmartChefScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                             const QByteArray& value) {
+                                             const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid == Scale::Generic::STATUS) {
         // SmartChef format: weight in bytes 5-6 as unsigned short (tenths of gram)
         // Sign determined by byte 3
@@ -126,7 +126,7 @@ void SmartChefScale::onCharacteristicChanged(const QBluetoothUuid& characteristi
                 weight = -weight;
             }
 
-            setWeight(weight);
+            setWeight(weight, arrivalMs);
         }
     }
 }
@@ -140,10 +140,14 @@ void TimemoreScale::onCharacteristicsDiscoveryFinished(const QBluetoothUuid& ser
 }
 
 void TimemoreScale::onCharacteristicChanged(const QBluetoothUuid& characteristicUuid,
-                                            const QByteArray& value) {
+                                            const QByteArray& value, qint64 arrivalMs) {
     if (characteristicUuid != Scale::Generic::STATUS) return;
 
-    // Timemore packet: header A5 5A, type at [2], weight at [8-9]
+    // Timemore packet: header A5 5A, type at [2], weight at [8-9]. One packet
+    // per notification; not run through FramedStreamParser because the packet
+    // length isn't known: the snooped commands above follow no single length
+    // rule (timer start and stop share bytes 0-5 but are 9 and 10 bytes long),
+    // and a guessed frame size would splice packets together.
     if (value.size() < 10) return;
 
     const uint8_t* d = reinterpret_cast<const uint8_t*>(value.constData());
@@ -156,7 +160,7 @@ void TimemoreScale::onCharacteristicChanged(const QBluetoothUuid& characteristic
         // Big-endian signed weight in tenths of gram
         int16_t weightRaw = static_cast<int16_t>((d[8] << 8) | d[9]);
         double weight = weightRaw / 10.0;
-        setWeight(weight);
+        setWeight(weight, arrivalMs);
     }
 }
 
@@ -2,8 +2,19 @@
 
 #include "../scaledevice.h"
 #include "../transport/scalebletransport.h"
+#include "../protocol/framedstreamparser.h"
 #include <QTimer>
 
+// Varia Aku message framing: FA, command, length, then length payload bytes
+// and an XOR byte. The XOR isn't verified, as before the parser.
+struct VariaAkuFrame {
+    static constexpr std::array<uint8_t, 1> sync{{0xFA}};
+    static constexpr int headerLength = 3;
+    static constexpr int maxFrameLength = 4 + 255;
+    static int frameLength(const uint8_t* header) { return 4 + header[2]; }
+    static bool checksumValid(const uint8_t*, int) { return true; }
+};
+
 class VariaAkuScale : public ScaleDevice {
     Q_OBJECT
 
@@ -26,11 +37,16 @@ private slots:
     void onServiceDiscovered(const QBluetoothUuid& uuid);
     void onServicesDiscoveryFinished();
     void onCharacteristicsDiscoveryFinished(const QBluetoothUuid& serviceUuid);
-    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value);
+    void onCharacteristicChanged(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                                 qint64 arrivalMs = 0);
     void onWatchdogTimeout();
     void onTickleTimeout();
 
 private:
+#ifdef DECENZA_TESTING
+    friend class tst_ScaleProtocol;
+#endif
+    void handleMessage(const FrameView& msg, qint64 arrivalMs);
     void sendCommand(const QByteArray& cmd);
     void enableNotifications();
     void startWatchdog();
@@ -41,6 +57,7 @@ private:
     QString m_name = "Varia Aku";
     bool m_serviceFound = false;
     bool m_characteristicsReady = false;
+    FramedStreamParser<VariaAkuFrame> m_parser;
 
     // Watchdog to re-enable notifications if they stop arriving
     QTimer* m_watchdogTimer = nullptr;
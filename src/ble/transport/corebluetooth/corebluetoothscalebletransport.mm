@@ -1,4 +1,5 @@
 #include "corebluetoothscalebletransport.h"
+#include "../../arrivalclock.h"
 
 #include <QDebug>
 #include <QTimer>
@@ -419,12 +420,14 @@ didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic
         bytes = QByteArray((const char*)data.bytes, (int)data.length);
 
     QString uuidStr = nsToQs(characteristic.UUID.UUIDString);
+    // Stamp on the CoreBluetooth queue, before the hop to the main thread
+    const qint64 arrivalMs = ArrivalClock::nowMs();
 
-    QMetaObject::invokeMethod(d->q, [d, uuidStr, bytes]{
+    QMetaObject::invokeMethod(d->q, [d, uuidStr, bytes, arrivalMs]{
         if (!d->isValid) return;  // Transport being destroyed
         QBluetoothUuid cu = uuidFromString(uuidStr);
         // Don't log every notification - too verbose at high rates (10/sec for Bookoo)
-        emit d->q->characteristicChanged(cu, bytes);
+        emit d->q->characteristicChanged(cu, bytes, arrivalMs);
     }, Qt::QueuedConnection);
 }
 
@@ -0,0 +1,132 @@
+#include "ingestscalebletransport.h"
+
+#include <QThread>
+
+IngestScaleBleTransport::IngestScaleBleTransport(ScaleBleTransport* transport, QThread* ingestThread,
+                                                 WeightDecoder decoder, WeightSink sink, QObject* parent)
+    : ScaleBleTransport(parent)
+    , m_transport(transport)
+    , m_decoder(decoder)
+    , m_latestWeightMs(std::make_shared<std::atomic<qint64>>(0))
+{
+    m_transport->setParent(nullptr);
+    m_transport->moveToThread(ingestThread);
+
+    // Fast path first, so the stamp is published before the queued copy below
+    // is posted. Runs on the ingest thread; m_transport is the context, so
+    // this can't outlive the state it captures.
+    if (m_decoder) {
+        connect(m_transport, &ScaleBleTransport::characteristicChanged, m_transport,
+                [decoder = m_decoder, sink = std::move(sink), latest = m_latestWeightMs,
+                 lastWeight = 0.0, hasWeight = false]
+                (const QBluetoothUuid& uuid, const QByteArray& value, qint64 arrivalMs) mutable {
+            double weight;
+            if (!decoder(uuid, value, &weight)) return;
+            latest->store(arrivalMs);
+            // Same rule as ScaleDevice::setWeight(): only changes are readings
+            if (hasWeight && weight == lastWeight) return;
+            lastWeight = weight;
+            hasWeight = true;
+            if (sink) sink(weight, arrivalMs);
+        }, Qt::DirectConnection);
+    }
+
+    // Everything else crosses to this object's thread (auto-queued)
+    connect(m_transport, &ScaleBleTransport::characteristicChanged,
+            this, &IngestScaleBleTransport::onNotification);
+    connect(m_transport, &ScaleBleTransport::connected, this, [this]() {
+        m_connected = true;
+        emit connected();
+    });
+    connect(m_transport, &ScaleBleTransport::disconnected, this, [this]() {
+        m_connected = false;
+        emit disconnected();
+    });
+    connect(m_transport, &ScaleBleTransport::serviceDiscovered,
+            this, &ScaleBleTransport::serviceDiscovered);
+    connect(m_transport, &ScaleBleTransport::servicesDiscoveryFinished,
+            this, &ScaleBleTransport::servicesDiscoveryFinished);
+    connect(m_transport, &ScaleBleTransport::characteristicDiscovered,
+            this, &ScaleBleTransport::characteristicDiscovered);
+    connect(m_transport, &ScaleBleTransport::characteristicsDiscoveryFinished,
+            this, &ScaleBleTransport::characteristicsDiscoveryFinished);
+    connect(m_transport, &ScaleBleTransport::characteristicRead,
+            this, &ScaleBleTransport::characteristicRead);
+    connect(m_transport, &ScaleBleTransport::characteristicWritten,
+            this, &ScaleBleTransport::characteristicWritten);
+    connect(m_transport, &ScaleBleTransport::notificationsEnabled,
+            this, &ScaleBleTransport::notificationsEnabled);
+    connect(m_transport, &ScaleBleTransport::error,
+            this, &ScaleBleTransport::error);
+    connect(m_transport, &ScaleBleTransport::logMessage,
+            this, &ScaleBleTransport::logMessage);
+}
+
+IngestScaleBleTransport::~IngestScaleBleTransport() {
+    // Runs after any disconnectFromDevice() the scale queued on its way out
+    m_transport->deleteLater();
+}
+
+void IngestScaleBleTransport::connectToDevice(const QString& address, const QString& name) {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport, address, name]() {
+        t->connectToDevice(address, name);
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::connectToDevice(const QBluetoothDeviceInfo& device) {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport, device]() {
+        t->connectToDevice(device);
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::disconnectFromDevice() {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport]() {
+        t->disconnectFromDevice();
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::discoverServices() {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport]() {
+        t->discoverServices();
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::discoverCharacteristics(const QBluetoothUuid& serviceUuid) {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport, serviceUuid]() {
+        t->discoverCharacteristics(serviceUuid);
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::enableNotifications(const QBluetoothUuid& serviceUuid,
+                                                  const QBluetoothUuid& characteristicUuid) {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport, serviceUuid, characteristicUuid]() {
+        t->enableNotifications(serviceUuid, characteristicUuid);
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::writeCharacteristic(const QBluetoothUuid& serviceUuid,
+                                                  const QBluetoothUuid& characteristicUuid,
+                                                  const QByteArray& data, WriteType writeType) {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport, serviceUuid, characteristicUuid, data, writeType]() {
+        t->writeCharacteristic(serviceUuid, characteristicUuid, data, writeType);
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::readCharacteristic(const QBluetoothUuid& serviceUuid,
+                                                 const QBluetoothUuid& characteristicUuid) {
+    QMetaObject::invokeMethod(m_transport, [t = m_transport, serviceUuid, characteristicUuid]() {
+        t->readCharacteristic(serviceUuid, characteristicUuid);
+    }, Qt::QueuedConnection);
+}
+
+void IngestScaleBleTransport::onNotification(const QBluetoothUuid& characteristicUuid,
+                                             const QByteArray& value, qint64 arrivalMs) {
+    // A display update the ingest thread has already overtaken: the scale
+    // would only redraw a value that is about to be replaced
+    double weight;
+    if (m_decoder && arrivalMs < m_latestWeightMs->load()
+        && m_decoder(characteristicUuid, value, &weight)) {
+        return;
+    }
+    emit characteristicChanged(characteristicUuid, value, arrivalMs);
+}
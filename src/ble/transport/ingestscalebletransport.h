@@ -0,0 +1,67 @@
+#pragma once
+
+#include "scalebletransport.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class QThread;
+
+/**
+ * Runs a platform scale transport on the scale ingest thread (see ScaleIngest).
+ *
+ * The wrapped transport is moved to the ingest thread, so the BLE stack
+ * delivers its notifications there. Calls made on this object are queued to
+ * it, and its signals are re-emitted here on the scale's own thread, so scale
+ * classes use this like any other transport.
+ *
+ * Notifications the scale's WeightDecoder recognises as weight readings are
+ * decoded on the ingest thread and passed to the weight sink there, without
+ * waiting on the GUI thread. The scale still receives them for its display,
+ * but a weight reading that a newer one has overtaken by the time the GUI
+ * thread gets to it is dropped. Everything else is forwarded in order.
+ */
+class IngestScaleBleTransport : public ScaleBleTransport {
+    Q_OBJECT
+
+public:
+    // Recognises a complete weight reading without touching any scale state
+    // (it runs on the ingest thread); true with *weight set if it is one
+    using WeightDecoder = bool (*)(const QBluetoothUuid& characteristicUuid,
+                                   const QByteArray& value, double* weight);
+    // Called on the ingest thread with each new decoded reading
+    using WeightSink = std::function<void(double weight, qint64 arrivalMs)>;
+
+    // Takes ownership of transport and moves it to ingestThread
+    IngestScaleBleTransport(ScaleBleTransport* transport, QThread* ingestThread,
+                            WeightDecoder decoder, WeightSink sink, QObject* parent = nullptr);
+    ~IngestScaleBleTransport() override;
+
+    void connectToDevice(const QString& address, const QString& name) override;
+    void connectToDevice(const QBluetoothDeviceInfo& device) override;
+    void disconnectFromDevice() override;
+    void discoverServices() override;
+    void discoverCharacteristics(const QBluetoothUuid& serviceUuid) override;
+    void enableNotifications(const QBluetoothUuid& serviceUuid,
+                             const QBluetoothUuid& characteristicUuid) override;
+    void writeCharacteristic(const QBluetoothUuid& serviceUuid,
+                             const QBluetoothUuid& characteristicUuid,
+                             const QByteArray& data,
+                             WriteType writeType = WriteType::WithResponse) override;
+    void readCharacteristic(const QBluetoothUuid& serviceUuid,
+                            const QBluetoothUuid& characteristicUuid) override;
+    bool isConnected() const override { return m_connected; }
+
+    // The wrapped transport (lives on the ingest thread)
+    ScaleBleTransport* transport() const { return m_transport; }
+
+private:
+    void onNotification(const QBluetoothUuid& characteristicUuid, const QByteArray& value,
+                        qint64 arrivalMs);
+
+    ScaleBleTransport* m_transport;
+    WeightDecoder m_decoder;
+    // Stamp of the newest weight reading seen on the ingest thread
+    std::shared_ptr<std::atomic<qint64>> m_latestWeightMs;
+    bool m_connected = false;
+};
@@ -1,4 +1,5 @@
 #include "qtscalebletransport.h"
+#include "../arrivalclock.h"
 #include "../blecapability.h"
 #include "../blemanager.h"
 #include <QDebug>
@@ -386,7 +387,7 @@ void QtScaleBleTransport::onServiceStateChanged(QLowEnergyService::ServiceState
 void QtScaleBleTransport::onCharacteristicChanged(const QLowEnergyCharacteristic& c,
                                                    const QByteArray& value) {
     // Don't log every notification - too spammy (weight updates come constantly)
-    emit characteristicChanged(c.uuid(), value);
+    emit characteristicChanged(c.uuid(), value, ArrivalClock::nowMs());
 }
 
 void QtScaleBleTransport::onCharacteristicRead(const QLowEnergyCharacteristic& c,
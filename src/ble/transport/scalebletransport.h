@@ -135,10 +135,12 @@ signals:
 
     /**
      * Emitted when a characteristic value changes (notifications).
-     * This is the primary way scales receive weight data.
+     * This is the primary way scales receive weight data. arrivalMs is the
+     * ArrivalClock stamp taken when the notification reached the transport
+     * (0 if the emitter didn't stamp it).
      */
     void characteristicChanged(const QBluetoothUuid& characteristicUuid,
-                               const QByteArray& value);
+                               const QByteArray& value, qint64 arrivalMs = 0);
 
     /**
      * Emitted when a characteristic read completes.
@@ -21,6 +21,9 @@
 #include "../history/shothistorystorage.h"
 #include "../history/shotimporter.h"
 #include "../history/shotdebuglogger.h"
+#include "../history/postshotpipeline.h"
+#include "../ai/liveshotanalysis.h"
+#include "../ai/shotsummarizer.h"
 #include "../network/shotserver.h"
 #include "../network/locationprovider.h"
 #include "../core/crashhandler.h"
@@ -174,6 +177,34 @@ MainController::MainController(QNetworkAccessManager* networkManager,
     m_shotHistory->initialize();
     connect(m_shotHistory, &QObject::destroyed, this, [this]() { m_savingShot = false; });
 
+    // Post-shot processing pipeline (snapshot → worker stages → save). Its analysis
+    // results are republished as MainController properties for the post-shot UI.
+    m_postShotPipeline = new PostShotPipeline(m_shotHistory, this);
+    connect(m_postShotPipeline, &PostShotPipeline::busyChanged, this, &MainController::postShotProcessingChanged);
+    connect(m_postShotPipeline, &PostShotPipeline::analysisReady, this,
+            [this](const QVariantList& summaryLines, const QString& verdictCategory, const QVariantMap& badges) {
+        m_lastShotSummary = summaryLines;
+        m_lastShotVerdict = verdictCategory;
+        m_lastShotBadges = badges;
+        emit lastShotAnalysisChanged();
+    });
+
+    // Streaming puck-integrity detectors, fed alongside the shot model so
+    // channeling / grind / pour-not-pressurizing warnings surface mid-shot.
+    // The End marker comes from ShotDataModel::markStopAt (SAW or user stop).
+    m_liveShotAnalysis = new LiveShotAnalysis(this);
+    if (m_shotDataModel) {
+        connect(m_shotDataModel, &ShotDataModel::stopTimeChanged, this, [this]() {
+            if (!m_liveShotAnalysis->isActive() || m_shotDataModel->stopTime() < 0)
+                return;
+            HistoryPhaseMarker marker;
+            marker.time = m_shotDataModel->stopTime();
+            marker.label = QStringLiteral("End");
+            marker.frameNumber = -1;
+            m_liveShotAnalysis->addPhaseMarker(marker);
+        });
+    }
+
     // Create shot importer for importing .shot files from DE1 app
     m_shotImporter = new ShotImporter(m_shotHistory, this);
 
@@ -1647,6 +1678,12 @@ void MainController::onEspressoCycleStarted() {
     if (m_shotDataModel) {
         m_shotDataModel->clear();
     }
+    {
+        const Profile& profile = m_profileManager->currentProfile();
+        m_liveShotAnalysis->begin(profile.beverageType(),
+                                  ShotSummarizer::getAnalysisFlags(
+                                      ShotSummarizer::computeProfileKbId(profile.title(), profile.editorType())));
+    }
 
     // Reset FlowScale and set dose for puck absorption compensation
     if (m_flowScale) {
@@ -1710,6 +1747,7 @@ void MainController::onShotEnded() {
 
     // Only process espresso shots that actually extracted
     if (!m_extractionStarted || !m_settings || !m_shotDataModel) {
+        m_liveShotAnalysis->end();
         // Stop debug logging even if we don't save
         if (m_shotDebugLogger) {
             m_shotDebugLogger->stopCapture();
@@ -1752,36 +1790,12 @@ void MainController::onShotEnded() {
     if (finalWeight <= 0 && m_profileManager->currentProfile().targetWeight() > 0)
         finalWeight = m_profileManager->currentProfile().targetWeight();
 
-    // Trim trailing zero-pressure samples from SAW settling period before saving.
-    // During settling the DE1 reports 0 pressure/flow while the scale settles — these
-    // cause a vertical drop to 0 at the end of the graph. Weight data is preserved.
-    // NOTE: Must run before smoothWeightFlowRate() — smoothWeightFlowRate() snapshots
-    // m_weightFlowRatePoints as the raw export copy before smoothing. Running trim first
-    // ensures neither the smoothed nor raw copy includes trailing zeros.
-    m_shotDataModel->trimSettlingData();
-
-    // Smooth weight flow rate before saving (centered moving average, window=5, ≈ 2.2s at 5Hz).
-    // The raw LSLR data from recording has staircase artifacts from 0.1g scale quantization;
-    // this post-processing matches de1app's smoothing level for storage and visualizer export.
-    m_shotDataModel->smoothWeightFlowRate();
-
-    // Auto flow calibration: compute per-profile multiplier from this shot's data.
-    // Must run before stopCapture() so its debug output is included in the shot log.
-    computeAutoFlowCalibration();
-
     // Capture shot-end epoch now so uploads (including deferred pending uploads) use consistent time.
-    // Held in a local until after the discard branch so a dropped shot doesn't corrupt
-    // m_pendingShotEpoch / m_pendingDebugLog that may still belong to a prior unflushed shot
-    // (uploadPendingShot is gated on m_hasPendingShot, which the discard path doesn't touch).
+    // Held in a local until the onSeriesReady hook, which commits it together with the
+    // rest of the pending-shot state, so a dropped shot doesn't corrupt m_pendingShotEpoch /
+    // m_pendingDebugLog that may still belong to a prior unflushed shot.
     const qint64 pendingShotEpoch = QDateTime::currentSecsSinceEpoch();
 
-    // Stop debug logging and get the captured log
-    QString debugLog;
-    if (m_shotDebugLogger) {
-        m_shotDebugLogger->stopCapture();
-        debugLog = m_shotDebugLogger->getCapturedLog();
-    }
-
     // Build metadata for history
     ShotMetadata metadata;
     metadata.beanBrand = m_settings->dye()->dyeBeanBrand();
@@ -1806,38 +1820,110 @@ void MainController::onShotEnded() {
         shotYieldOverride = finalWeight;
     }
 
+    // The saved badges come from analyzeShot() in the pipeline's Analysis stage
+    m_liveShotAnalysis->end();
+
     // Capture once so both the async callback and synchronous code use the same value
     bool showPostShot = m_settings->visualizer()->visualizerShowAfterShot();
 
     // Aborted-shot classifier: drop shots that did not start (extraction < 10s AND yield < 5g).
     // Always on — validated against an 882-shot corpus, 5/882 (0.57%) discarded, all genuine
     // "did not start" cases. See openspec/specs/shot-save-filter/spec.md.
-    {
-        const bool aborted = decenza::isAbortedShot(duration, finalWeight);
-        qInfo().noquote() << QStringLiteral("[discard-classifier] extractionDurationSec=%1 finalWeightG=%2 verdict=%3 action=%4")
-            .arg(QString::number(duration, 'f', 3),
-                 QString::number(finalWeight, 'f', 1),
-                 aborted ? QStringLiteral("aborted") : QStringLiteral("kept"),
-                 aborted ? QStringLiteral("discarded") : QStringLiteral("saved"));
-
-        if (aborted) {
-            emit shotDiscarded(duration, finalWeight);
-            // Skip save, skip auto-upload, skip post-shot review navigation.
-            // Reset extraction flag so subsequent operations don't re-trigger shot logic.
-            m_extractionStarted = false;
+    const bool aborted = decenza::isAbortedShot(duration, finalWeight);
+    qInfo().noquote() << QStringLiteral("[discard-classifier] extractionDurationSec=%1 finalWeightG=%2 verdict=%3 action=%4")
+        .arg(QString::number(duration, 'f', 3),
+             QString::number(finalWeight, 'f', 1),
+             aborted ? QStringLiteral("aborted") : QStringLiteral("kept"),
+             aborted ? QStringLiteral("discarded") : QStringLiteral("saved"));
+
+    // Post-shot processing runs on a worker against a snapshot of the shot (settling
+    // trim → weight-flow smoothing → dC/dt → phase summaries → analyzeShot → compress
+    // → DB insert). The snapshot is implicitly shared, so nothing here walks the
+    // sample data on the GUI thread. See PostShotPipeline.
+    PostShotPipeline::Job job;
+    job.snapshot = m_shotDataModel->snapshot();
+    job.save = PostShotPipeline::makeSaveData(
+        m_profileManager->currentProfilePtr(),
+        duration, finalWeight, doseWeight, metadata, QString(),
+        shotTemperatureOverride, shotYieldOverride);
+
+    const bool historyReady = m_shotHistory && m_shotHistory->isReady();
+    job.persist = !aborted && historyReady && !m_savingShot;
+
+    // Runs on the main thread once the trimmed / smoothed series come back from the
+    // worker. Everything that must see the processed curves lives here: the live
+    // model, auto flow calibration, and the visualizer auto-upload.
+    job.onSeriesReady = [this, aborted, showPostShot, pendingShotEpoch, duration, finalWeight, doseWeight, metadata]
+                        (const ShotSnapshot& processed, ShotSaveData& save) {
+        if (!m_shotDataModel || !m_shotDataModel->applyProcessedSnapshot(processed)) {
+            // A new shot cleared the model while this one was processing — the
+            // debug logger and the live model now belong to the new shot.
+            qWarning() << "[metadata] Post-shot series arrived after a new shot started; skipping flow cal and upload";
+            return;
+        }
+
+        // Auto flow calibration: compute per-profile multiplier from this shot's data.
+        // Must run before stopCapture() so its debug output is included in the shot log.
+        computeAutoFlowCalibration();
+
+        // Stop debug logging and get the captured log
+        QString debugLog;
+        if (m_shotDebugLogger) {
+            m_shotDebugLogger->stopCapture();
+            debugLog = m_shotDebugLogger->getCapturedLog();
+        }
+
+        if (aborted)
             return;
+
+        // Past the discard gate — commit the pending-shot snapshot used by uploadPendingShot()
+        // and the visualizer auto-upload below. All of it is set here, together, so an
+        // upload never pairs this shot's curves with the previous shot's log or epoch.
+        m_pendingShotEpoch = pendingShotEpoch;
+        m_pendingDebugLog = debugLog;
+        save.debugLog = debugLog;
+        if (showPostShot) {
+            // Store pending shot data for later upload (user can re-upload with updated metadata)
+            m_hasPendingShot = true;
+            m_pendingShotDuration = duration;
+            m_pendingShotFinalWeight = finalWeight;
+            m_pendingShotDoseWeight = doseWeight;
         }
+
+        // Auto-upload if enabled
+        if (m_settings && m_settings->visualizer()->visualizerAutoUpload() && m_visualizer) {
+            qDebug() << "  -> Auto-uploading to visualizer";
+            m_visualizer->uploadShot(m_shotDataModel, m_profileManager->currentProfilePtr(), duration, finalWeight, doseWeight, metadata, debugLog, m_pendingShotEpoch);
+        }
+    };
+
+    // The pending shot for uploadPendingShot() is committed by the onSeriesReady
+    // hook. Until it runs the model already holds this shot, so an earlier
+    // pending shot can no longer be uploaded either.
+    m_hasPendingShot = false;
+
+    if (aborted) {
+        emit shotDiscarded(duration, finalWeight);
+        // Still run the series stages (flow cal + debug-log stop) but skip save,
+        // auto-upload and post-shot review navigation.
+        // Reset extraction flag so subsequent operations don't re-trigger shot logic.
+        m_postShotPipeline->submit(std::move(job));
+        m_extractionStarted = false;
+        return;
     }
 
-    // Past the discard gate — commit the pending-shot snapshot used by uploadPendingShot()
-    // and the synchronous visualizer auto-upload below.
-    m_pendingShotEpoch = pendingShotEpoch;
-    m_pendingDebugLog = debugLog;
+    // Reset the published analysis; the pipeline refills it when the Analysis stage lands
+    if (!m_lastShotSummary.isEmpty() || !m_lastShotBadges.isEmpty() || !m_lastShotVerdict.isEmpty()) {
+        m_lastShotSummary.clear();
+        m_lastShotBadges.clear();
+        m_lastShotVerdict.clear();
+        emit lastShotAnalysisChanged();
+    }
 
-    // Always save shot to local history (async — DB work runs on background thread)
+    // Always save shot to local history (async — all processing and DB work runs on the pipeline worker)
     qDebug() << "[metadata] Saving shot - shotHistory:" << (m_shotHistory ? "exists" : "null")
-             << "isReady:" << (m_shotHistory ? m_shotHistory->isReady() : false);
-    if (m_shotHistory && m_shotHistory->isReady()) {
+             << "isReady:" << historyReady;
+    if (historyReady) {
         if (m_savingShot) {
             qWarning() << "[metadata] Shot save already in progress, skipping";
         } else {
@@ -1893,12 +1979,6 @@ void MainController::onShotEnded() {
                     }
                 }
             }, static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::SingleShotConnection));
-
-            m_shotHistory->saveShot(
-                m_shotDataModel, m_profileManager->currentProfilePtr(),
-                duration, finalWeight, doseWeight,
-                metadata, debugLog,
-                shotTemperatureOverride, shotYieldOverride);
         }
     } else {
         qWarning() << "[metadata] Could not save shot - history not ready!";
@@ -1909,6 +1989,8 @@ void MainController::onShotEnded() {
         }
     }
 
+    m_postShotPipeline->submit(std::move(job));
+
     // Report shot to decenza.coffee shot map
     if (m_shotReporter && m_shotReporter->isEnabled()) {
         m_shotReporter->reportShot(m_profileManager->currentProfile().title(), "Decent DE1");
@@ -1925,22 +2007,13 @@ void MainController::onShotEnded() {
              << "Final P:" << QString::number(finalPressure, 'f', 2) << "bar"
              << "Final F:" << QString::number(finalFlow, 'f', 2) << "ml/s";
 
-    // Auto-upload if enabled (do this first, before showing metadata page)
-    if (m_settings->visualizer()->visualizerAutoUpload() && m_visualizer) {
-        qDebug() << "  -> Auto-uploading to visualizer";
-        m_visualizer->uploadShot(m_shotDataModel, m_profileManager->currentProfilePtr(), duration, finalWeight, doseWeight, metadata, debugLog, m_pendingShotEpoch);
-    }
+    // Visualizer auto-upload happens in the pipeline's onSeriesReady hook above,
+    // once the trimmed/smoothed curves and the debug log are available.
 
-    // Store pending shot data for later upload (user can re-upload with updated metadata)
     // Note: shotEndedShowMetadata is emitted from the shotSaved callback above,
     // after m_lastSavedShotId is set, so PostShotReviewPage gets a valid shot ID.
-    if (showPostShot) {
-        m_hasPendingShot = true;
-        m_pendingShotDuration = duration;
-        m_pendingShotFinalWeight = finalWeight;
-        m_pendingShotDoseWeight = doseWeight;
+    if (showPostShot)
         qDebug() << "  -> Will show metadata page after shot is saved";
-    }
 
     // Reset extraction flag so that subsequent Steam/HotWater/Flush operations
     // don't incorrectly trigger shot metadata page or upload
@@ -2090,6 +2163,8 @@ void MainController::generateFakeShotData() {
     m_pendingShotDuration = totalDuration;
     m_pendingShotFinalWeight = 40.0;
     m_pendingShotDoseWeight = 18.0;
+    m_pendingShotEpoch = QDateTime::currentSecsSinceEpoch();
+    m_pendingDebugLog.clear();
 
     qDebug() << "DEV: Generated" << numSamples << "fake samples";
 
@@ -2144,11 +2219,21 @@ void MainController::generateFakeShotData() {
                 }
             }, static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::SingleShotConnection));
 
-            m_shotHistory->saveShot(
-                m_shotDataModel, m_profileManager->currentProfilePtr(),
+            // Synthetic curves have no settling tail and are already smooth —
+            // skip those stages so the saved shot matches what the graph shows.
+            PostShotPipeline::Job job;
+            job.snapshot = m_shotDataModel->snapshot();
+            job.save = PostShotPipeline::makeSaveData(
+                m_profileManager->currentProfilePtr(),
                 totalDuration, m_pendingShotFinalWeight, m_pendingShotDoseWeight,
                 metadata, "[Simulated shot]",
                 temperatureOverride, yieldOverride);
+            job.processSeries = false;
+            job.onSeriesReady = [this](const ShotSnapshot& processed, ShotSaveData&) {
+                if (m_shotDataModel)
+                    m_shotDataModel->applyProcessedSnapshot(processed);
+            };
+            m_postShotPipeline->submit(std::move(job));
         }
     }
 }
@@ -2325,6 +2410,12 @@ void MainController::onShotSampleReceived(const ShotSample& sample) {
         m_extractionStarted = true;
         m_frameStartTime = time;
         m_shotDataModel->markExtractionStart(time);
+
+        HistoryPhaseMarker marker;
+        marker.time = time;
+        marker.label = QStringLiteral("Start");
+        marker.frameNumber = 0;
+        m_liveShotAnalysis->addPhaseMarker(marker);
     }
 
     // Update filtered goals for QML (zeroed for non-active mode)
@@ -2392,6 +2483,15 @@ void MainController::onShotSampleReceived(const ShotSample& sample) {
         }
 
         m_shotDataModel->addPhaseMarker(time, frameName, frameIndex, isFlowMode, transitionReason);
+        {
+            HistoryPhaseMarker marker;
+            marker.time = time;
+            marker.label = frameName;
+            marker.frameNumber = frameIndex;
+            marker.isFlowMode = isFlowMode;
+            marker.transitionReason = transitionReason;
+            m_liveShotAnalysis->addPhaseMarker(marker);
+        }
         m_frameStartTime = time;  // Record start time of new frame
         m_lastFrameNumber = sample.frameNumber;
         m_currentFrameName = frameName;  // Store for accessibility QML binding
@@ -2414,6 +2514,8 @@ void MainController::onShotSampleReceived(const ShotSample& sample) {
                                sample.mixTemp,
                                pressureGoal, flowGoal, sample.setTempGoal,
                                sample.frameNumber, isFlowMode);
+    m_liveShotAnalysis->addSample(time, sample.groupPressure, sample.groupFlow,
+                                  pressureGoal, flowGoal);
 
     // Log tracking delta every 10 shot samples for debug (at the DE1's ~5Hz sample rate,
     // this is roughly every 2 seconds). Only log when a goal is active.
@@ -14,6 +14,8 @@
 #include "../machine/steamhealthtracker.h"
 #include "../history/shothistorystorage.h"
 #include "../history/shotimporter.h"
+#include "../history/postshotpipeline.h"
+#include "../ai/liveshotanalysis.h"
 #include "../profile/profileconverter.h"
 #include "../profile/profileimporter.h"
 #include "../models/shotcomparisonmodel.h"
@@ -47,6 +49,7 @@ class MainController : public QObject {
     Q_PROPERTY(VisualizerImporter* visualizerImporter READ visualizerImporter CONSTANT)
     Q_PROPERTY(AIManager* aiManager READ aiManager CONSTANT)
     Q_PROPERTY(ShotDataModel* shotDataModel READ shotDataModel CONSTANT)
+    Q_PROPERTY(LiveShotAnalysis* liveShotAnalysis READ liveShotAnalysis CONSTANT)
     Q_PROPERTY(SteamDataModel* steamDataModel READ steamDataModel CONSTANT)
     Q_PROPERTY(SteamHealthTracker* steamHealthTracker READ steamHealthTracker CONSTANT)
     Q_PROPERTY(QString currentFrameName READ currentFrameName NOTIFY frameChanged)
@@ -66,6 +69,12 @@ class MainController : public QObject {
     Q_PROPERTY(DatabaseBackupManager* backupManager READ backupManager CONSTANT)
     Q_PROPERTY(qint64 lastSavedShotId READ lastSavedShotId NOTIFY lastSavedShotIdChanged)
     Q_PROPERTY(bool sawSettling READ isSawSettling NOTIFY sawSettlingChanged)
+    // Published by the post-shot pipeline as its Analysis stage finishes —
+    // available before the save completes (lastSavedShotId follows).
+    Q_PROPERTY(QVariantList lastShotSummary READ lastShotSummary NOTIFY lastShotAnalysisChanged)
+    Q_PROPERTY(QString lastShotVerdict READ lastShotVerdict NOTIFY lastShotAnalysisChanged)
+    Q_PROPERTY(QVariantMap lastShotBadges READ lastShotBadges NOTIFY lastShotAnalysisChanged)
+    Q_PROPERTY(bool postShotProcessing READ isPostShotProcessing NOTIFY postShotProcessingChanged)
 
 public:
     explicit MainController(QNetworkAccessManager* networkManager,
@@ -98,6 +107,7 @@ public:
     void setTimingController(ShotTimingController* controller) { m_timingController = controller; }
     void setBackupManager(DatabaseBackupManager* backupManager) { m_backupManager = backupManager; }
     ShotDataModel* shotDataModel() const { return m_shotDataModel; }
+    LiveShotAnalysis* liveShotAnalysis() const { return m_liveShotAnalysis; }
     SteamDataModel* steamDataModel() const { return m_steamDataModel; }
     SteamHealthTracker* steamHealthTracker() const { return m_steamHealthTracker; }
     void setSteamDataModel(SteamDataModel* model) { m_steamDataModel = model; }
@@ -118,6 +128,10 @@ public:
     DatabaseBackupManager* backupManager() const { return m_backupManager; }
     LocationProvider* locationProvider() const { return m_locationProvider; }
     qint64 lastSavedShotId() const { return m_lastSavedShotId; }
+    QVariantList lastShotSummary() const { return m_lastShotSummary; }
+    QString lastShotVerdict() const { return m_lastShotVerdict; }
+    QVariantMap lastShotBadges() const { return m_lastShotBadges; }
+    bool isPostShotProcessing() const { return m_postShotPipeline && m_postShotPipeline->isBusy(); }
 
     // For simulator integration
     void handleShotSample(const ShotSample& sample) { onShotSampleReceived(sample); }
@@ -192,6 +206,8 @@ signals:
     // DYE: emitted when shot ends and should show metadata page
     void shotEndedShowMetadata();
     void lastSavedShotIdChanged();
+    void lastShotAnalysisChanged();
+    void postShotProcessingChanged();
 
     // Shot aborted because saved scale is not connected
     void shotAbortedNoScale();
@@ -301,9 +317,14 @@ private:
     QString m_pendingDebugLog;
     qint64 m_lastSavedShotId = 0;  // ID of most recently saved shot (for post-shot review)
     bool m_savingShot = false;     // Guard against overlapping async saves
+    QVariantList m_lastShotSummary;  // analyzeShot prose lines for the last shot
+    QString m_lastShotVerdict;       // DetectorResults::verdictCategory
+    QVariantMap m_lastShotBadges;    // Five quality-badge booleans
 
     // Shot history and comparison
     ShotHistoryStorage* m_shotHistory = nullptr;
+    PostShotPipeline* m_postShotPipeline = nullptr;
+    LiveShotAnalysis* m_liveShotAnalysis = nullptr;  // In-shot channeling / grind / pour warnings
     ShotImporter* m_shotImporter = nullptr;
     ProfileConverter* m_profileConverter = nullptr;
     ProfileImporter* m_profileImporter = nullptr;
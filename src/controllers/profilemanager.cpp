@@ -20,9 +20,11 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QTimer>
+#include <QThread>
+#include <QHash>
 #include <algorithm>
 #include <cmath>
-#include <tuple>
+#include <memory>
 
 #ifndef Q_OS_WIN
 #include <dlfcn.h>   // For dladdr() to resolve caller symbols
@@ -98,6 +100,7 @@ ProfileManager::ProfileManager(Settings* settings, DE1Device* device,
     , m_device(device)
     , m_machineState(machineState)
     , m_profileStorage(profileStorage)
+    , m_catalogIndex(ProfileCatalogIndex::load(catalogIndexPath()))
 {
     // Retry pending profile upload when machine reaches Idle, Ready, Sleep, or
     // Heating — phases where it's safe to write a new profile to the DE1.
@@ -238,7 +241,7 @@ ProfileManager::ProfileManager(Settings* settings, DE1Device* device,
         connect(m_profileStorage, &ProfileStorage::configuredChanged, this, [this]() {
             if (m_profileStorage->isConfigured()) {
                 qDebug() << "[ProfileManager] Storage configured, refreshing profiles";
-                refreshProfiles();
+                refreshProfilesInBackground();
             }
         });
     }
@@ -287,7 +290,6 @@ ProfileManager::ProfileManager(Settings* settings, DE1Device* device,
     } else {
         loadDefaultProfile();
     }
-    m_profileJsonCache.clear();  // Free cached JSON after startup profile load
     m_startupLoadDone = true;
 
     // Keep MachineState in sync when yield override changes in Settings
@@ -974,11 +976,7 @@ void ProfileManager::loadProfile(const QString& profileName) {
 
     // 1. Check ProfileStorage first (SAF folder on Android)
     if (m_profileStorage && m_profileStorage->isConfigured()) {
-        // Use cached JSON from refreshProfiles() if available (avoids double-read at startup)
-        QString jsonContent = m_profileJsonCache.take(resolvedName);
-        if (jsonContent.isEmpty()) {
-            jsonContent = m_profileStorage->readProfile(resolvedName);
-        }
+        QString jsonContent = m_profileStorage->readProfile(resolvedName);
         if (!jsonContent.isEmpty()) {
             m_currentProfile = Profile::loadFromJsonString(jsonContent);
             found = true;
@@ -1172,178 +1170,164 @@ bool ProfileManager::persistCurrentProfile() {
 }
 
 void ProfileManager::refreshProfiles() {
-    m_availableProfiles.clear();
-    m_profileTitles.clear();
-    m_allProfiles.clear();
-    m_profileJsonCache.clear();
-
-    // Helper to extract profile metadata from a JSON object
-    // Returns: title, beverageType, hasKnowledgeBase, editorType, readOnly
-    auto extractProfileMeta = [](const QJsonObject& obj) -> std::tuple<QString, QString, bool, QString, bool> {
-        QString title = obj["title"].toString();
-
-        // Derive editor type from title + profileType (matching Profile::editorType())
-        QString editorType;
-        QString t = title.startsWith(QLatin1Char('*')) ? title.mid(1) : title;
-        if (t.startsWith(QStringLiteral("D-Flow"), Qt::CaseInsensitive))
-            editorType = QStringLiteral("dflow");
-        else if (t.startsWith(QStringLiteral("A-Flow"), Qt::CaseInsensitive))
-            editorType = QStringLiteral("aflow");
-        else {
-            QString profileType = obj["legacy_profile_type"].toString();
-            if (profileType.isEmpty()) profileType = obj["profile_type"].toString();
-            if (profileType == QLatin1String("settings_2a"))
-                editorType = QStringLiteral("pressure");
-            else if (profileType == QLatin1String("settings_2b"))
-                editorType = QStringLiteral("flow");
-            else
-                editorType = QStringLiteral("advanced");
-        }
-
-        bool hasKb = !ShotSummarizer::computeProfileKbId(title, editorType).isEmpty();
-        bool readOnly = (obj["read_only"].toInt(0) == 1);
-        return {title, obj["beverage_type"].toString(), hasKb, editorType, readOnly};
-    };
-
-    // Helper to load profile metadata from file path
-    auto loadProfileMeta = [&extractProfileMeta](const QString& path) -> std::tuple<QString, QString, bool, QString, bool> {
-        QFile file(path);
-        if (file.open(QIODevice::ReadOnly)) {
-            QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-            return extractProfileMeta(doc.object());
-        }
-        return {QString(), QString(), false, QStringLiteral("advanced"), false};
-    };
+    ++m_catalogGeneration;  // Supersedes any background refresh still running
+    QList<CatalogFile> files = catalogFiles();
+    scanCatalog(files, m_catalogIndex);
+    applyCatalog(files);
+    saveCatalogIndex();
+}
 
-    // Helper to load profile metadata from JSON string
-    auto loadProfileMetaFromJson = [&extractProfileMeta](const QString& jsonContent) -> std::tuple<QString, QString, bool, QString, bool> {
-        QJsonDocument doc = QJsonDocument::fromJson(jsonContent.toUtf8());
-        return extractProfileMeta(doc.object());
+void ProfileManager::refreshProfilesInBackground() {
+    struct Scan {
+        QList<CatalogFile> files;
+        ProfileCatalogIndex index;
     };
+    const quint64 generation = ++m_catalogGeneration;
+    // The worker scans a copy of the index (shared until it changes an entry)
+    // and never touches this object; the result is applied back here once
+    // the thread has finished, and Qt drops that connection if we are gone.
+    auto scan = std::make_shared<Scan>(Scan{catalogFiles(), m_catalogIndex});
+
+    QThread* thread = QThread::create([scan]() {
+        scanCatalog(scan->files, scan->index);
+    });
+    connect(thread, &QThread::finished, this, [this, scan, generation]() {
+        // A refresh started after this one has already applied newer state
+        if (generation != m_catalogGeneration) return;
+        m_catalogIndex = std::move(scan->index);
+        applyCatalog(scan->files);
+        saveCatalogIndex();
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
 
-    QStringList filters;
-    filters << "*.json";
-
-    // 1. Load built-in profiles (always available)
-    QDir builtInDir(":/profiles");
-    QStringList files = builtInDir.entryList(filters, QDir::Files);
-    for (const QString& file : files) {
-        QString name = file.left(file.length() - 5);  // Remove .json
-        auto [title, beverageType, hasKnowledgeBase, editorType, readOnly] = loadProfileMeta(":/profiles/" + file);
-
-        ProfileInfo info;
-        info.filename = name;
-        info.title = title.isEmpty() ? name : title;
-        info.beverageType = beverageType;
-        info.editorType = editorType;
-        info.source = ProfileSource::BuiltIn;
-
-        info.hasKnowledgeBase = hasKnowledgeBase;
-        info.readOnly = true;  // Built-in profiles are always read-only
-        m_allProfiles.append(info);
+QList<ProfileManager::CatalogFile> ProfileManager::catalogFiles() const {
+    QList<CatalogFile> files;
+    const QStringList filters{QStringLiteral("*.json")};
 
-        m_availableProfiles.append(name);
-        m_profileTitles[name] = info.title;
-    }
+    // 1. Built-in profiles (always available)
+    for (const QString& file : QDir(":/profiles").entryList(filters, QDir::Files))
+        files.append({file.chopped(5), ":/profiles/" + file, ProfileSource::BuiltIn});
 
-    // 2. Load profiles from ProfileStorage (SAF folder or fallback)
-    // ProfileStorage takes loading priority over built-in (loadProfile checks it first),
-    // so if a copy exists here it should override the built-in entry in the list too.
+    // 2. ProfileStorage (SAF folder or fallback)
     if (m_profileStorage) {
-        QStringList storageProfiles = m_profileStorage->listProfiles();
-        for (const QString& name : storageProfiles) {
-            QString jsonContent = m_profileStorage->readProfile(name);
-            if (jsonContent.isEmpty()) {
-                continue;
-            }
-
-            // Cache for loadProfile() to avoid re-reading from storage
-            m_profileJsonCache[name] = jsonContent;
-
-            auto [title, beverageType, hasKnowledgeBase, editorType, readOnly] = loadProfileMetaFromJson(jsonContent);
-
-            ProfileInfo info;
-            info.filename = name;
-            info.title = title.isEmpty() ? name : title;
-            info.beverageType = beverageType;
-            info.editorType = editorType;
-            info.source = ProfileSource::UserCreated;
-    
-            info.hasKnowledgeBase = hasKnowledgeBase;
-            info.readOnly = readOnly;
-
-            if (m_availableProfiles.contains(name)) {
-                // Override built-in entry so list matches what loadProfile() actually loads
-                for (qsizetype i = 0; i < m_allProfiles.size(); ++i) {
-                    if (m_allProfiles[i].filename == name) {
-                        m_allProfiles[i] = info;
-                        break;
-                    }
-                }
-            } else {
-                m_allProfiles.append(info);
-                m_availableProfiles.append(name);
-            }
-            m_profileTitles[name] = info.title;
+        for (const QString& name : m_profileStorage->listProfiles()) {
+            const QString path = m_profileStorage->profilePath(name);
+            if (!path.isEmpty())
+                files.append({name, path, ProfileSource::UserCreated, true});
         }
     }
 
-    // 3. Load downloaded profiles (legacy local folder)
-    QDir downloadedDir(downloadedProfilesPath());
-    files = downloadedDir.entryList(filters, QDir::Files);
-    for (const QString& file : files) {
-        QString name = file.left(file.length() - 5);
-        if (m_availableProfiles.contains(name)) {
-            continue;  // Skip if already loaded from ProfileStorage
-        }
+    // 3. Downloaded profiles (legacy local folder)
+    const QDir downloadedDir(downloadedProfilesPath());
+    for (const QString& file : downloadedDir.entryList(filters, QDir::Files))
+        files.append({file.chopped(5), downloadedDir.filePath(file), ProfileSource::Downloaded});
 
-        auto [title, beverageType, hasKnowledgeBase, editorType, readOnly] = loadProfileMeta(downloadedDir.filePath(file));
-
-        ProfileInfo info;
-        info.filename = name;
-        info.title = title.isEmpty() ? name : title;
-        info.beverageType = beverageType;
-        info.editorType = editorType;
-        info.source = ProfileSource::Downloaded;
+    // 4. User-created profiles (legacy local folder)
+    const QDir userDir(userProfilesPath());
+    for (const QString& file : userDir.entryList(filters, QDir::Files))
+        files.append({file.chopped(5), userDir.filePath(file), ProfileSource::UserCreated});
 
-        info.hasKnowledgeBase = hasKnowledgeBase;
-        info.readOnly = readOnly;
-        m_allProfiles.append(info);
+    return files;
+}
 
-        m_availableProfiles.append(name);
-        m_profileTitles[name] = info.title;
+void ProfileManager::scanCatalog(QList<CatalogFile>& files, ProfileCatalogIndex& index) {
+    // Touches only the files and the index, so it can run on any thread
+    QSet<QString> listed;
+    for (CatalogFile& file : files) {
+        // applyCatalog() skips legacy-folder copies of a listed name; don't read them
+        if (!file.fromStorage && listed.contains(file.name))
+            continue;
+        file.meta = index.lookup(file.path);
+        if (!file.fromStorage || file.meta)
+            listed.insert(file.name);
     }
+    index.pruneUnvisited();
 
-    // 4. Load user-created profiles (legacy local folder)
-    QDir userDir(userProfilesPath());
-    files = userDir.entryList(filters, QDir::Files);
-    for (const QString& file : files) {
-        QString name = file.left(file.length() - 5);
-        if (m_availableProfiles.contains(name)) {
-            continue;  // Skip if already loaded from ProfileStorage
+    const ProfileCatalogIndex::Stats stats = index.takeStats();
+    qDebug() << "ProfileManager: catalog scan of" << files.size() << "files -"
+             << stats.statHits << "unchanged," << stats.hashHits << "touched but identical,"
+             << stats.parsed << "parsed," << stats.unreadable << "unreadable";
+}
+
+void ProfileManager::applyCatalog(const QList<CatalogFile>& files) {
+    QList<ProfileInfo> profiles;
+    QStringList available;
+    QMap<QString, QString> titles;
+    QHash<QString, qsizetype> positions;
+
+    for (const CatalogFile& file : files) {
+        const auto known = positions.constFind(file.name);
+        if (file.fromStorage) {
+            if (!file.meta)
+                continue;
+        } else if (known != positions.cend()) {
+            continue;  // Legacy folders never override an earlier entry
         }
 
-        auto [title, beverageType, hasKnowledgeBase, editorType, readOnly] = loadProfileMeta(userDir.filePath(file));
+        const ProfileCatalogIndex::Meta meta = file.meta.value_or(ProfileCatalogIndex::Meta());
+
+        // Derive editor type from title + profileType (matching Profile::editorType())
+        QString editorType;
+        const QString t = meta.title.startsWith(QLatin1Char('*')) ? meta.title.mid(1) : meta.title;
+        if (t.startsWith(QStringLiteral("D-Flow"), Qt::CaseInsensitive))
+            editorType = QStringLiteral("dflow");
+        else if (t.startsWith(QStringLiteral("A-Flow"), Qt::CaseInsensitive))
+            editorType = QStringLiteral("aflow");
+        else if (meta.profileType == QLatin1String("settings_2a"))
+            editorType = QStringLiteral("pressure");
+        else if (meta.profileType == QLatin1String("settings_2b"))
+            editorType = QStringLiteral("flow");
+        else
+            editorType = QStringLiteral("advanced");
 
         ProfileInfo info;
-        info.filename = name;
-        info.title = title.isEmpty() ? name : title;
-        info.beverageType = beverageType;
+        info.filename = file.name;
+        info.title = meta.title.isEmpty() ? file.name : meta.title;
+        info.beverageType = meta.beverageType;
         info.editorType = editorType;
-        info.source = ProfileSource::UserCreated;
-
-        info.hasKnowledgeBase = hasKnowledgeBase;
-        info.readOnly = readOnly;
-        m_allProfiles.append(info);
+        info.source = file.source;
+        info.hasKnowledgeBase = !ShotSummarizer::computeProfileKbId(meta.title, editorType).isEmpty();
+        info.readOnly = file.source == ProfileSource::BuiltIn || meta.readOnly;  // Built-ins are always read-only
+
+        if (known != positions.cend()) {
+            // ProfileStorage takes loading priority over built-in (loadProfile checks it
+            // first), so its copy replaces the built-in entry in the list too
+            profiles[known.value()] = info;
+        } else {
+            positions.insert(file.name, profiles.size());
+            profiles.append(info);
+            available.append(file.name);
+        }
+        titles[file.name] = info.title;
+    }
 
-        m_availableProfiles.append(name);
-        m_profileTitles[name] = info.title;
+    // Diff against the previous catalog, by filename
+    QStringList added, removed, updated;
+    QHash<QString, const ProfileInfo*> previous;
+    for (const ProfileInfo& info : std::as_const(m_allProfiles))
+        previous.insert(info.filename, &info);
+    for (const ProfileInfo& info : std::as_const(profiles)) {
+        const ProfileInfo* before = previous.take(info.filename);
+        if (!before)
+            added.append(info.filename);
+        else if (*before != info)
+            updated.append(info.filename);
     }
+    for (const ProfileInfo& info : std::as_const(m_allProfiles)) {
+        if (previous.contains(info.filename))
+            removed.append(info.filename);
+    }
+
+    m_allProfiles = std::move(profiles);
+    m_availableProfiles = std::move(available);
+    m_profileTitles = std::move(titles);
 
     // Validate favorites and currentProfile against the known profile set.
     // Removes favorites that reference profiles not found in any directory, and resets
     // a stale currentProfile to the first remaining valid favorite (or "default").
-    // Runs every time refreshProfiles() is called so stale references are cleaned up at startup.
+    // Runs on every refresh so stale references are cleaned up at startup.
     if (m_settings) {
         QSet<QString> known(m_availableProfiles.begin(), m_availableProfiles.end());
 
@@ -1370,10 +1354,33 @@ void ProfileManager::refreshProfiles() {
         }
     }
 
+    if (added.isEmpty() && removed.isEmpty() && updated.isEmpty())
+        return;
+    emit profileCatalogChanged(added, removed, updated);
     emit profilesChanged();
     emit allBuiltInProfileListChanged();
 }
 
+void ProfileManager::saveCatalogIndex() {
+    if (!m_catalogIndex.isDirty())
+        return;
+    m_catalogIndex.markClean();
+
+    // Written off the main thread from a copy. Out-of-order saves are harmless:
+    // every entry is self-consistent, and an older one is just re-validated.
+    QThread* thread = QThread::create([index = m_catalogIndex, path = catalogIndexPath()]() {
+        index.save(path);
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
+
+QString ProfileManager::catalogIndexPath() const {
+    QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(path);
+    return path + "/profile_catalog.json";
+}
+
 
 // === Profile upload ===
 
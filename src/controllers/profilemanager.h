@@ -4,7 +4,9 @@
 #include <QTimer>
 #include <QVariantList>
 #include <QMap>
+#include <optional>
 #include "../profile/profile.h"
+#include "../profile/profilecatalogindex.h"
 
 class Settings;
 class DE1Device;
@@ -27,6 +29,14 @@ struct ProfileInfo {
     ProfileSource source;
     bool hasKnowledgeBase = false;
     bool readOnly = false;  // From profile JSON read_only field or forced for BuiltIn source
+
+    bool operator==(const ProfileInfo& other) const {
+        return filename == other.filename && title == other.title
+            && beverageType == other.beverageType && editorType == other.editorType
+            && source == other.source && hasKnowledgeBase == other.hasKnowledgeBase
+            && readOnly == other.readOnly;
+    }
+    bool operator!=(const ProfileInfo& other) const { return !(*this == other); }
 };
 
 /**
@@ -164,6 +174,10 @@ public slots:
     Q_INVOKABLE bool loadProfileFromJson(const QString& jsonContent);
     bool persistCurrentProfile();  // Save to downloaded folder if not already installed (no re-upload)
     void refreshProfiles();
+    // Same result as refreshProfiles(), but files are stat'ed, read and parsed
+    // on a worker thread and the catalog is swapped in when it finishes. For
+    // refreshes nothing waits on (storage permission granted, data import).
+    Q_INVOKABLE void refreshProfilesInBackground();
     Q_INVOKABLE void uploadCurrentProfile();
     Q_INVOKABLE void uploadProfile(const QVariantMap& profileData);
     Q_INVOKABLE bool saveProfile(const QString& filename);
@@ -183,6 +197,13 @@ signals:
     void profilesChanged();
     void allBuiltInProfileListChanged();
 
+    // What a refresh changed in allProfiles(), by filename. Emitted just before
+    // profilesChanged(), and neither is emitted when nothing changed.
+    // profilesChanged() stays argument-less: it is the NOTIFY of the list
+    // properties and SettingsApp signals are forwarded into it.
+    void profileCatalogChanged(const QStringList& added, const QStringList& removed,
+                               const QStringList& updated);
+
     // Emitted when uploadCurrentProfile() is blocked during active phase.
     // Connect to ShotDebugLogger for diagnostics.
     void profileUploadBlocked(const QString& phaseString, const QString& stackTrace);
@@ -214,6 +235,20 @@ private:
     QString downloadedProfilesPath() const;
     double getGroupTemperature() const;
 
+    // A profile file the catalog considers, in priority order
+    struct CatalogFile {
+        QString name;
+        QString path;
+        ProfileSource source;
+        bool fromStorage = false;  // ProfileStorage: overrides built-ins, skipped if unreadable
+        std::optional<ProfileCatalogIndex::Meta> meta;  // Filled in by scanCatalog()
+    };
+    QList<CatalogFile> catalogFiles() const;
+    static void scanCatalog(QList<CatalogFile>& files, ProfileCatalogIndex& index);
+    void applyCatalog(const QList<CatalogFile>& files);
+    void saveCatalogIndex();
+    QString catalogIndexPath() const;
+
     Settings* m_settings = nullptr;
     DE1Device* m_device = nullptr;
     MachineState* m_machineState = nullptr;
@@ -222,8 +257,9 @@ private:
     Profile m_currentProfile;
     QStringList m_availableProfiles;
     QMap<QString, QString> m_profileTitles;      // filename -> display title
-    QMap<QString, QString> m_profileJsonCache;   // populated by refreshProfiles, consumed by loadProfile
     QList<ProfileInfo> m_allProfiles;
+    ProfileCatalogIndex m_catalogIndex;          // Per-file metadata cache, saved to catalogIndexPath()
+    quint64 m_catalogGeneration = 0;             // Bumped by every refresh; stale background scans are dropped
     QString m_baseProfileName;
     QString m_previousProfileName;
     bool m_profileModified = false;
@@ -157,6 +157,8 @@ void ShotTimingController::onShotSample(const ShotSample& sample, double pressur
         return;
     }
 
+    const qint64 sampleMs = sample.timestamp > 0 ? sample.timestamp : QDateTime::currentMSecsSinceEpoch();
+
     // Track frame number change and detect extraction start (skip during settling)
     if (!isSettling && frameNumber != m_currentFrameNumber) {
         if (m_currentProfile && frameNumber >= 0 && frameNumber < m_currentProfile->steps().size()) {
@@ -170,13 +172,14 @@ void ShotTimingController::onShotSample(const ShotSample& sample, double pressur
         // frames (0-1) if the group is already hot, jumping straight to frame 2+.
         if (!m_extractionStarted) {
             m_extractionStarted = true;
-            m_displayTimeBase = QDateTime::currentMSecsSinceEpoch();
+            m_displayTimeBase = sampleMs;
             qDebug() << "EXTRACTION STARTED at frame" << frameNumber;
         }
     }
 
-    // Calculate time from wall clock (simple and reliable)
-    double time = (QDateTime::currentMSecsSinceEpoch() - m_displayTimeBase) / 1000.0;
+    // Calculate time from the sample's arrival wall clock, so time spent
+    // waiting in the event loop doesn't shift it on the graph
+    double time = (sampleMs - m_displayTimeBase) / 1000.0;
     m_currentTime = time;
 
     // shotTimeChanged deferred to ShotDataModel's 33ms flush timer (avoid blocking BLE handler)
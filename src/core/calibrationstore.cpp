@@ -0,0 +1,515 @@
+#include "calibrationstore.h"
+#include "settingsstore.h"
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <QDebug>
+
+namespace {
+
+// Column list shared by the three SAW entry tables, in selectSawEntries() order
+const QString kSawColumns = QStringLiteral("profile, scale, drip, flow, overshoot, lag, ts, batch_size");
+
+QVariant optionalDouble(const QJsonObject& entry, const char* key)
+{
+    return entry.contains(QLatin1String(key)) ? QVariant(entry.value(QLatin1String(key)).toDouble())
+                                              : QVariant(QMetaType(QMetaType::Double));
+}
+
+QVariant optionalInt(const QJsonObject& entry, const char* key)
+{
+    return entry.contains(QLatin1String(key)) ? QVariant(entry.value(QLatin1String(key)).toInteger())
+                                              : QVariant(QMetaType(QMetaType::LongLong));
+}
+
+QJsonObject parseJsonObject(const SettingsStore& settings, const QString& key)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(settings.value(key).toByteArray(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "CalibrationStore: corrupt" << key << "JSON, not imported:" << parseError.errorString();
+        return QJsonObject();
+    }
+    return doc.object();
+}
+
+// Legacy per-pair maps are keyed "profile::scale"; entries also carry both
+QPair<QString, QString> splitPairKey(const QString& key, const QJsonObject& entry)
+{
+    const qsizetype sep = key.indexOf(QStringLiteral("::"));
+    const QString profile = entry.contains("profile") ? entry.value("profile").toString()
+                                                      : (sep >= 0 ? key.left(sep) : key);
+    const QString scale = entry.contains("scale") ? entry.value("scale").toString()
+                                                  : (sep >= 0 ? key.mid(sep + 2) : QString());
+    return {profile, scale};
+}
+
+} // namespace
+
+CalibrationStore::CalibrationStore(const QString& dbPath, QObject* parent)
+    : QObject(parent)
+    , m_connectionName(QStringLiteral("calibration_%1").arg(reinterpret_cast<quintptr>(this), 0, 16))
+{
+    QString path = dbPath;
+    if (path.isEmpty()) {
+        const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(dataDir);
+        path = dataDir + "/calibration.db";
+    }
+
+    m_persistent = open(path);
+    if (!m_persistent) {
+        qWarning() << "CalibrationStore: falling back to an in-memory database;"
+                   << "SAW learning and flow calibration won't persist this session";
+        open(QStringLiteral(":memory:"));
+    }
+}
+
+CalibrationStore::~CalibrationStore()
+{
+    if (m_db.isOpen()) {
+        m_db.close();
+    }
+    m_db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+bool CalibrationStore::open(const QString& path)
+{
+    if (m_db.isValid()) {
+        m_db.close();
+        m_db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+
+    m_db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    m_db.setDatabaseName(path);
+    if (!m_db.open()) {
+        qWarning() << "CalibrationStore: Failed to open" << path << ":" << m_db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery pragma(m_db);
+    pragma.exec("PRAGMA journal_mode=WAL");
+    pragma.exec("PRAGMA busy_timeout = 5000");
+
+    if (!createTables()) {
+        qWarning() << "CalibrationStore: Failed to create tables in" << path;
+        m_db.close();
+        return false;
+    }
+    return true;
+}
+
+bool CalibrationStore::createTables()
+{
+    // The three SAW tables share one row shape; nullable columns mirror the
+    // optional keys of the old JSON entries
+    const QStringList sawTables = {"saw_pool", "saw_pair_history", "saw_pair_batch"};
+    for (const QString& table : sawTables) {
+        const bool ok = exec(QStringLiteral(R"(
+            CREATE TABLE IF NOT EXISTS %1 (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                profile TEXT NOT NULL DEFAULT '',
+                scale TEXT NOT NULL DEFAULT '',
+                drip REAL,
+                flow REAL,
+                overshoot REAL,
+                lag REAL,
+                ts INTEGER,
+                batch_size INTEGER
+            )
+        )").arg(table));
+        if (!ok) return false;
+    }
+
+    const bool ok = exec(R"(
+            CREATE TABLE IF NOT EXISTS flow_calibration (
+                profile TEXT PRIMARY KEY,
+                multiplier REAL NOT NULL,
+                updated_at INTEGER DEFAULT (strftime('%s', 'now'))
+            )
+        )")
+        && exec(R"(
+            CREATE TABLE IF NOT EXISTS flow_cal_pending (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                profile TEXT NOT NULL,
+                ideal REAL NOT NULL
+            )
+        )");
+    if (!ok) return false;
+
+    // Recency reads are "newest N for this key": (key columns, id) indexes
+    // serve them, and the bounded trims, without a scan or sort
+    exec("CREATE INDEX IF NOT EXISTS idx_saw_pool_scale ON saw_pool(scale, id)");
+    exec("CREATE INDEX IF NOT EXISTS idx_saw_pair_history_pair ON saw_pair_history(profile, scale, id)");
+    exec("CREATE INDEX IF NOT EXISTS idx_saw_pair_history_scale ON saw_pair_history(scale)");
+    exec("CREATE INDEX IF NOT EXISTS idx_saw_pair_batch_pair ON saw_pair_batch(profile, scale, id)");
+    exec("CREATE INDEX IF NOT EXISTS idx_flow_cal_pending_profile ON flow_cal_pending(profile, id)");
+
+    exec("CREATE TABLE IF NOT EXISTS schema_version (version INTEGER PRIMARY KEY)");
+    exec("INSERT INTO schema_version (version) SELECT 1 WHERE NOT EXISTS (SELECT 1 FROM schema_version)");
+    return true;
+}
+
+bool CalibrationStore::exec(const QString& sql, const QVariantList& binds) const
+{
+    QSqlQuery query(m_db);
+    if (!query.prepare(sql)) {
+        qWarning() << "CalibrationStore: prepare failed:" << query.lastError().text() << "-" << sql.simplified();
+        return false;
+    }
+    for (const QVariant& v : binds) query.addBindValue(v);
+    if (!query.exec()) {
+        qWarning() << "CalibrationStore: query failed:" << query.lastError().text() << "-" << sql.simplified();
+        return false;
+    }
+    return true;
+}
+
+// ---- legacy import ----
+
+void CalibrationStore::importLegacySettings(SettingsStore& settings)
+{
+    const QStringList keys = {"saw/learningHistory", "saw/perProfileHistory", "saw/perProfileBatch",
+                              "calibration/perProfileFlow", "calibration/flowCalBatch"};
+    bool any = false;
+    for (const QString& key : keys) any = any || settings.contains(key);
+    if (!any) return;
+
+    if (!m_persistent) {
+        qWarning() << "CalibrationStore: not importing legacy calibration data into a transient store";
+        return;
+    }
+
+    if (!m_db.transaction()) {
+        qWarning() << "CalibrationStore: legacy import could not start a transaction:" << m_db.lastError().text();
+        return;
+    }
+
+    int imported = 0;
+
+    // Global pool: a JSON array, oldest first
+    if (settings.contains("saw/learningHistory")) {
+        const QJsonDocument doc = QJsonDocument::fromJson(settings.value("saw/learningHistory").toByteArray());
+        if (!doc.isArray()) {
+            qWarning() << "CalibrationStore: corrupt saw/learningHistory JSON, not imported";
+        }
+        for (const auto& v : doc.array()) {
+            const QJsonObject entry = v.toObject();
+            imported += insertSawEntry("saw_pool", entry.value("profile").toString(),
+                                       entry.value("scale").toString(), entry);
+        }
+    }
+
+    // Per-pair history and pending batches: {"profile::scale": [entries]}
+    const QList<QPair<QString, QString>> pairMaps = {
+        {"saw/perProfileHistory", "saw_pair_history"},
+        {"saw/perProfileBatch", "saw_pair_batch"},
+    };
+    for (const auto& [key, table] : pairMaps) {
+        if (!settings.contains(key)) continue;
+        const QJsonObject map = parseJsonObject(settings, key);
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            for (const auto& v : it.value().toArray()) {
+                const QJsonObject entry = v.toObject();
+                const auto [profile, scale] = splitPairKey(it.key(), entry);
+                imported += insertSawEntry(table, profile, scale, entry);
+            }
+        }
+    }
+
+    if (settings.contains("calibration/perProfileFlow")) {
+        const QJsonObject map = parseJsonObject(settings, "calibration/perProfileFlow");
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            imported += exec("INSERT OR REPLACE INTO flow_calibration (profile, multiplier) VALUES (?, ?)",
+                             {it.key(), it.value().toDouble()});
+        }
+    }
+
+    if (settings.contains("calibration/flowCalBatch")) {
+        const QJsonObject map = parseJsonObject(settings, "calibration/flowCalBatch");
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            for (const auto& v : it.value().toArray()) {
+                imported += exec("INSERT INTO flow_cal_pending (profile, ideal) VALUES (?, ?)",
+                                 {it.key(), v.toDouble()});
+            }
+        }
+    }
+
+    if (!m_db.commit()) {
+        qWarning() << "CalibrationStore: legacy import failed to commit, keeping QSettings data:"
+                   << m_db.lastError().text();
+        m_db.rollback();
+        return;
+    }
+
+    for (const QString& key : keys) settings.remove(key);
+    qDebug() << "CalibrationStore: imported" << imported << "rows of SAW learning / flow calibration from QSettings";
+}
+
+// ---- SAW entries ----
+
+bool CalibrationStore::insertSawEntry(const QString& table, const QString& profile, const QString& scale,
+                                      const QJsonObject& entry)
+{
+    return exec(QStringLiteral("INSERT INTO %1 (%2) VALUES (?, ?, ?, ?, ?, ?, ?, ?)").arg(table, kSawColumns),
+                {profile, scale,
+                 optionalDouble(entry, "drip"), optionalDouble(entry, "flow"),
+                 optionalDouble(entry, "overshoot"), optionalDouble(entry, "lag"),
+                 optionalInt(entry, "ts"), optionalInt(entry, "batchSize")});
+}
+
+QJsonArray CalibrationStore::selectSawEntries(const QString& sql, const QVariantList& binds) const
+{
+    QJsonArray result;
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    for (const QVariant& v : binds) query.addBindValue(v);
+    if (!query.exec()) {
+        qWarning() << "CalibrationStore: query failed:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        QJsonObject entry;
+        auto put = [&](int column, const char* key) {
+            if (!query.isNull(column)) entry[QLatin1String(key)] = query.value(column).toDouble();
+        };
+        put(2, "drip");
+        put(3, "flow");
+        put(4, "overshoot");
+        put(5, "lag");
+        entry["scale"] = query.value(1).toString();
+        const QString profile = query.value(0).toString();
+        if (!profile.isEmpty()) entry["profile"] = profile;
+        if (!query.isNull(6)) entry["ts"] = query.value(6).toLongLong();
+        if (!query.isNull(7)) entry["batchSize"] = query.value(7).toInt();
+        result.append(entry);
+    }
+    return result;
+}
+
+void CalibrationStore::trimSawPool(int keep)
+{
+    exec("DELETE FROM saw_pool WHERE id <= (SELECT id FROM saw_pool ORDER BY id DESC LIMIT 1 OFFSET ?)",
+         {keep});
+}
+
+void CalibrationStore::trimSawPair(const QString& profile, const QString& scale, int keep)
+{
+    exec(R"(DELETE FROM saw_pair_history WHERE profile = ? AND scale = ? AND id <=
+                (SELECT id FROM saw_pair_history WHERE profile = ? AND scale = ?
+                 ORDER BY id DESC LIMIT 1 OFFSET ?))",
+         {profile, scale, profile, scale, keep});
+}
+
+QJsonArray CalibrationStore::sawPool() const
+{
+    return selectSawEntries(QStringLiteral("SELECT %1 FROM saw_pool ORDER BY id").arg(kSawColumns), {});
+}
+
+void CalibrationStore::appendSawPoolEntry(const QJsonObject& entry, int keep, const QString& resetScale)
+{
+    m_db.transaction();
+    if (!resetScale.isEmpty()) {
+        exec("DELETE FROM saw_pool WHERE scale = ?", {resetScale});
+    }
+    insertSawEntry("saw_pool", entry.value("profile").toString(), entry.value("scale").toString(), entry);
+    trimSawPool(keep);
+    m_db.commit();
+}
+
+QJsonArray CalibrationStore::sawPairHistory(const QString& profile, const QString& scale) const
+{
+    return selectSawEntries(
+        QStringLiteral("SELECT %1 FROM saw_pair_history WHERE profile = ? AND scale = ? ORDER BY id").arg(kSawColumns),
+        {profile, scale});
+}
+
+int CalibrationStore::sawPairHistoryCount(const QString& profile, const QString& scale) const
+{
+    QSqlQuery query(m_db);
+    query.prepare("SELECT COUNT(*) FROM saw_pair_history WHERE profile = ? AND scale = ?");
+    query.addBindValue(profile);
+    query.addBindValue(scale);
+    return (query.exec() && query.next()) ? query.value(0).toInt() : 0;
+}
+
+QList<QPair<double, double>> CalibrationStore::recentSawPairEntries(const QString& profile, const QString& scale,
+                                                                   int limit) const
+{
+    QList<QPair<double, double>> result;
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare(R"(SELECT drip, flow FROM saw_pair_history
+                     WHERE profile = ? AND scale = ? AND drip IS NOT NULL
+                     ORDER BY id DESC LIMIT ?)");
+    query.addBindValue(profile);
+    query.addBindValue(scale);
+    query.addBindValue(limit);
+    if (!query.exec()) {
+        qWarning() << "CalibrationStore: query failed:" << query.lastError().text();
+        return result;
+    }
+    while (query.next()) {
+        result.append({query.value(0).toDouble(), query.value(1).toDouble()});
+    }
+    return result;
+}
+
+QJsonObject CalibrationStore::allSawPairHistory() const
+{
+    QJsonObject map;
+    const QJsonArray rows = selectSawEntries(
+        QStringLiteral("SELECT %1 FROM saw_pair_history ORDER BY id").arg(kSawColumns), {});
+    for (const auto& v : rows) {
+        const QJsonObject entry = v.toObject();
+        const QString key = entry.value("profile").toString() + QStringLiteral("::") + entry.value("scale").toString();
+        QJsonArray history = map.value(key).toArray();
+        history.append(entry);
+        map[key] = history;
+    }
+    return map;
+}
+
+QList<QJsonObject> CalibrationStore::latestSawPairMedians(const QString& scale) const
+{
+    const QJsonArray rows = selectSawEntries(
+        QStringLiteral(R"(SELECT %1 FROM saw_pair_history h WHERE scale = ? AND id =
+                              (SELECT MAX(id) FROM saw_pair_history
+                               WHERE profile = h.profile AND scale = h.scale))").arg(kSawColumns),
+        {scale});
+    QList<QJsonObject> result;
+    result.reserve(rows.size());
+    for (const auto& v : rows) result.append(v.toObject());
+    return result;
+}
+
+void CalibrationStore::clearSawPair(const QString& profile, const QString& scale)
+{
+    m_db.transaction();
+    exec("DELETE FROM saw_pair_history WHERE profile = ? AND scale = ?", {profile, scale});
+    exec("DELETE FROM saw_pair_batch WHERE profile = ? AND scale = ?", {profile, scale});
+    m_db.commit();
+}
+
+QJsonArray CalibrationStore::sawPendingBatch(const QString& profile, const QString& scale) const
+{
+    return selectSawEntries(
+        QStringLiteral("SELECT %1 FROM saw_pair_batch WHERE profile = ? AND scale = ? ORDER BY id").arg(kSawColumns),
+        {profile, scale});
+}
+
+void CalibrationStore::appendSawPendingEntry(const QString& profile, const QString& scale, const QJsonObject& entry)
+{
+    insertSawEntry("saw_pair_batch", profile, scale, entry);
+}
+
+void CalibrationStore::clearSawPendingBatch(const QString& profile, const QString& scale)
+{
+    exec("DELETE FROM saw_pair_batch WHERE profile = ? AND scale = ?", {profile, scale});
+}
+
+void CalibrationStore::commitSawBatch(const QString& profile, const QString& scale, const QJsonObject& median,
+                                      bool resetPairHistory, int keepPair, int keepPool)
+{
+    m_db.transaction();
+    if (resetPairHistory) {
+        exec("DELETE FROM saw_pair_history WHERE profile = ? AND scale = ?", {profile, scale});
+    }
+    insertSawEntry("saw_pair_history", profile, scale, median);
+    trimSawPair(profile, scale, keepPair);
+    insertSawEntry("saw_pool", profile, scale, median);
+    trimSawPool(keepPool);
+    exec("DELETE FROM saw_pair_batch WHERE profile = ? AND scale = ?", {profile, scale});
+    if (!m_db.commit()) {
+        qWarning() << "CalibrationStore: SAW batch commit failed for" << profile << scale
+                   << ":" << m_db.lastError().text();
+        m_db.rollback();
+    }
+}
+
+void CalibrationStore::clearSaw()
+{
+    m_db.transaction();
+    exec("DELETE FROM saw_pool");
+    exec("DELETE FROM saw_pair_history");
+    exec("DELETE FROM saw_pair_batch");
+    m_db.commit();
+}
+
+// ---- flow calibration ----
+
+QJsonObject CalibrationStore::flowCalibrations() const
+{
+    QJsonObject map;
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT profile, multiplier FROM flow_calibration")) {
+        qWarning() << "CalibrationStore: query failed:" << query.lastError().text();
+        return map;
+    }
+    while (query.next()) {
+        map[query.value(0).toString()] = query.value(1).toDouble();
+    }
+    return map;
+}
+
+void CalibrationStore::setFlowCalibration(const QString& profile, double multiplier)
+{
+    exec("INSERT OR REPLACE INTO flow_calibration (profile, multiplier) VALUES (?, ?)",
+         {profile, multiplier});
+}
+
+void CalibrationStore::removeFlowCalibration(const QString& profile)
+{
+    exec("DELETE FROM flow_calibration WHERE profile = ?", {profile});
+}
+
+void CalibrationStore::clearFlowCalibrations()
+{
+    exec("DELETE FROM flow_calibration");
+}
+
+QVector<double> CalibrationStore::flowCalPendingIdeals(const QString& profile) const
+{
+    QVector<double> result;
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT ideal FROM flow_cal_pending WHERE profile = ? ORDER BY id");
+    query.addBindValue(profile);
+    if (!query.exec()) {
+        qWarning() << "CalibrationStore: query failed:" << query.lastError().text();
+        return result;
+    }
+    while (query.next()) {
+        result.append(query.value(0).toDouble());
+    }
+    return result;
+}
+
+void CalibrationStore::appendFlowCalPendingIdeal(const QString& profile, double ideal)
+{
+    exec("INSERT INTO flow_cal_pending (profile, ideal) VALUES (?, ?)", {profile, ideal});
+}
+
+void CalibrationStore::clearFlowCalPendingIdeals(const QString& profile)
+{
+    exec("DELETE FROM flow_cal_pending WHERE profile = ?", {profile});
+}
+
+void CalibrationStore::clearAll()
+{
+    m_db.transaction();
+    exec("DELETE FROM saw_pool");
+    exec("DELETE FROM saw_pair_history");
+    exec("DELETE FROM saw_pair_batch");
+    exec("DELETE FROM flow_calibration");
+    exec("DELETE FROM flow_cal_pending");
+    m_db.commit();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QVector>
+#include <QJsonArray>
+#include <QJsonObject>
+
+class SettingsStore;
+
+// SQLite store for the learned calibration data Settings used to keep as JSON
+// blobs in QSettings: the SAW learning pool, per-(profile, scale) SAW batch
+// medians and pending batches, and per-profile flow calibration with its
+// pending auto-cal ideals.
+//
+// Every learning update is a single-row insert (plus a bounded trim) instead
+// of re-serializing the whole map into the INI file, and the read paths are
+// indexed recency queries on (profile, scale). Entries go in and come out as
+// the same QJsonObjects the QSettings format used ({drip, flow, overshoot,
+// scale, profile, ts, batchSize, or legacy lag}); keys whose column is NULL
+// are left out, so `contains("drip")` still tells old-format entries apart.
+//
+// Owned by Settings and used on its (main) thread only. If the database can't
+// be opened the store falls back to an in-memory one for the session and the
+// legacy QSettings keys are left in place.
+class CalibrationStore : public QObject {
+public:
+    // dbPath empty = <AppDataLocation>/calibration.db
+    explicit CalibrationStore(const QString& dbPath = QString(), QObject* parent = nullptr);
+    ~CalibrationStore() override;
+
+    bool isPersistent() const { return m_persistent; }
+
+    // One-time import of the old QSettings JSON keys (saw/learningHistory,
+    // saw/perProfileHistory, saw/perProfileBatch, calibration/perProfileFlow,
+    // calibration/flowCalBatch). Keys are removed only after the import commits.
+    void importLegacySettings(SettingsStore& settings);
+
+    // ---- SAW global pool (all scales, oldest first) ----
+    QJsonArray sawPool() const;
+    // Appends and trims the pool to the newest `keep` entries. A non-empty
+    // resetScale first drops that scale's entries (auto-reset), atomically.
+    void appendSawPoolEntry(const QJsonObject& entry, int keep, const QString& resetScale = QString());
+
+    // ---- SAW per-(profile, scale) committed batch medians ----
+    // Oldest first, like the old per-pair JSON arrays
+    QJsonArray sawPairHistory(const QString& profile, const QString& scale) const;
+    int sawPairHistoryCount(const QString& profile, const QString& scale) const;
+    // Newest first, at most `limit`, entries with a drip only
+    QList<QPair<double, double>> recentSawPairEntries(const QString& profile, const QString& scale, int limit) const;
+    // "profile::scale" -> history array, for tools and bootstrap recompute
+    QJsonObject allSawPairHistory() const;
+    // Newest median of every pair whose newest median is for `scale`
+    QList<QJsonObject> latestSawPairMedians(const QString& scale) const;
+    void clearSawPair(const QString& profile, const QString& scale);
+
+    // ---- SAW per-pair pending batch ----
+    QJsonArray sawPendingBatch(const QString& profile, const QString& scale) const;
+    void appendSawPendingEntry(const QString& profile, const QString& scale, const QJsonObject& entry);
+    void clearSawPendingBatch(const QString& profile, const QString& scale);
+
+    // Commits a batch median in one transaction: optionally wipes the pair's
+    // history (auto-reset), appends the median to it (trimmed to keepPair),
+    // mirrors it into the global pool (trimmed to keepPool) and clears the
+    // pending batch.
+    void commitSawBatch(const QString& profile, const QString& scale, const QJsonObject& median,
+                        bool resetPairHistory, int keepPair, int keepPool);
+
+    void clearSaw();
+
+    // ---- Flow calibration ----
+    QJsonObject flowCalibrations() const;  // profile -> multiplier
+    void setFlowCalibration(const QString& profile, double multiplier);
+    void removeFlowCalibration(const QString& profile);
+    void clearFlowCalibrations();
+
+    QVector<double> flowCalPendingIdeals(const QString& profile) const;
+    void appendFlowCalPendingIdeal(const QString& profile, double ideal);
+    void clearFlowCalPendingIdeals(const QString& profile);
+
+    // Wipes every table (factory reset)
+    void clearAll();
+
+private:
+    bool open(const QString& path);
+    bool createTables();
+    bool exec(const QString& sql, const QVariantList& binds = {}) const;
+    bool insertSawEntry(const QString& table, const QString& profile, const QString& scale,
+                        const QJsonObject& entry);
+    void trimSawPool(int keep);
+    void trimSawPair(const QString& profile, const QString& scale, int keep);
+    QJsonArray selectSawEntries(const QString& sql, const QVariantList& binds) const;
+
+    QString m_connectionName;
+    QSqlDatabase m_db;
+    bool m_persistent = false;
+};
@@ -2,6 +2,7 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QDebug>
 #include <QSettings>
 
@@ -249,6 +250,21 @@ QString ProfileStorage::readProfile(const QString& filename) const {
     return QString();
 }
 
+QString ProfileStorage::profilePath(const QString& filename) const {
+    if (isConfigured()) {
+        QString extPath = externalProfilesPath();
+        if (!extPath.isEmpty()) {
+            QString path = extPath + "/" + filename + ".json";
+            if (QFileInfo::exists(path)) {
+                return path;
+            }
+        }
+    }
+
+    QString path = fallbackPath() + "/" + filename + ".json";
+    return QFileInfo::exists(path) ? path : QString();
+}
+
 bool ProfileStorage::writeProfile(const QString& filename, const QString& content) {
     // Write to external storage if configured
     if (isConfigured()) {
@@ -37,6 +37,9 @@ public:
     // Read profile JSON content
     QString readProfile(const QString& filename) const;
 
+    // Path of the file readProfile() would read, or empty if there is none
+    QString profilePath(const QString& filename) const;
+
     // Write profile JSON content
     bool writeProfile(const QString& filename, const QString& content);
 
@@ -11,6 +11,7 @@
 #include "settings_network.h"
 #include "settings_app.h"
 #include "grinderaliases.h"
+#include "calibrationstore.h"
 #include "../machine/sawprediction.h"
 #include <algorithm>
 #include <QStandardPaths>
@@ -22,6 +23,8 @@
 #include <QtMath>
 #include <QColor>
 #include <QUuid>
+#include <QSet>
+#include <utility>
 #include <QLocale>
 #include <QGuiApplication>
 #include <QStyleHints>
@@ -40,7 +43,8 @@
 
 Settings::Settings(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
+    , m_calibration(new CalibrationStore(QString(), this))
     , m_mqtt(new SettingsMqtt(this))
     , m_autoWake(new SettingsAutoWake(this))
     , m_hardware(new SettingsHardware(this))
@@ -56,18 +60,19 @@ Settings::Settings(QObject* parent)
     qDebug() << "Settings: system time format =" << QLocale::system().timeFormat(QLocale::ShortFormat)
              << "-> use12HourTime =" << m_app->use12HourTime();
 
-    // Force a fresh read from persistent storage before checking for missing keys.
-    // On macOS, NSUserDefaults can return stale (empty) data if another instance of
-    // the app just wrote to the same plist — sync() forces re-read from disk and
-    // prevents the defaults-initialization code from overwriting existing settings.
-    m_settings.sync();
-    qDebug() << "Settings: sync() done, contains profile/favorites:" << m_settings.contains("profile/favorites");
+    // SettingsStore syncs before its initial load, so on macOS the check below
+    // doesn't see stale (empty) NSUserDefaults data and overwrite existing settings.
+    qDebug() << "Settings: store loaded, contains profile/favorites:" << m_settings.contains("profile/favorites");
 
     // Snapshot whether this looks like a fresh install before any default-init
     // blocks below write keys. Used by one-shot migrations that need to behave
     // differently for new users vs upgrades.
     const bool freshInstall = m_settings.allKeys().isEmpty();
 
+    // One-time move of SAW learning and per-profile flow calibration out of
+    // QSettings JSON blobs into the calibration store
+    m_calibration->importLegacySettings(m_settings);
+
     // Initialize default favorite profiles if none exist
     if (!m_settings.contains("profile/favorites")) {
         QJsonArray defaultFavorites;
@@ -180,7 +185,8 @@ Settings::Settings(QObject* parent)
     // in turn poisoned new profiles via inheritance. Reset everything so the improved
     // algorithm (with per-sample and window-level ratio checks) can re-converge cleanly.
     if (!m_settings.contains("calibration/v2RatioGuardReset")) {
-        savePerProfileFlowCalMap(QJsonObject());
+        m_calibration->clearFlowCalibrations();
+        m_perProfileFlowCalCacheValid = false;
         setFlowCalibrationMultiplier(1.0);
         m_settings.setValue("calibration/v2RatioGuardReset", true);
         qDebug() << "Settings: Reset all flow calibrations to 1.0 (v2 ratio guard migration)";
@@ -194,7 +200,8 @@ Settings::Settings(QObject* parent)
     // uses the profile's target flow directly for flow profiles, breaking the loop.
     // Users who ran v2 may have factors drifted to ~0.6-0.8 instead of ~0.9-1.0.
     if (!m_settings.contains("calibration/v3FlowProfileReset")) {
-        savePerProfileFlowCalMap(QJsonObject());
+        m_calibration->clearFlowCalibrations();
+        m_perProfileFlowCalCacheValid = false;
         setFlowCalibrationMultiplier(1.0);
         m_settings.setValue("calibration/v3FlowProfileReset", true);
         qDebug() << "Settings: Reset all flow calibrations to 1.0 (v3 flow profile feedback loop fix)";
@@ -260,9 +267,29 @@ Settings::Settings(QObject* parent)
     // Settings::setDefaultShotRating(); it now lives here so any caller
     // of SettingsVisualizer::setDefaultShotRating gets the same behaviour.
     // Bean-modified tracking lives entirely inside SettingsDye now.
-    connect(m_visualizer, &SettingsVisualizer::defaultShotRatingChanged, this, [this]() {
+    addCrossDomainReaction([this]() { return QVariant(m_visualizer->defaultShotRating()); }, [this]() {
         m_dye->setDyeEspressoEnjoyment(m_visualizer->defaultShotRating());
     });
+    connect(&m_settings, &SettingsStore::changed, this, &Settings::runCrossDomainReactions);
+}
+
+void Settings::addCrossDomainReaction(std::function<QVariant()> read, std::function<void()> react)
+{
+    const QVariant current = read();
+    m_crossDomainReactions.append({std::move(read), std::move(react), current});
+}
+
+void Settings::runCrossDomainReactions()
+{
+    // By index: a reaction writes, which re-enters here; lastValue is updated
+    // first, so the nested pass only runs reactions to that write
+    for (qsizetype i = 0; i < m_crossDomainReactions.size(); ++i) {
+        const QVariant current = m_crossDomainReactions[i].read();
+        if (current == m_crossDomainReactions[i].lastValue)
+            continue;
+        m_crossDomainReactions[i].lastValue = current;
+        m_crossDomainReactions[i].react();
+    }
 }
 
 // Domain sub-object QML accessors. Each sub-object IS-A QObject; the upcast
@@ -340,20 +367,25 @@ void Settings::setScaleName(const QString& name) {
 }
 
 // Multi-scale management
+// Same layout QSettings::beginWriteArray uses ("knownScales/scales/size",
+// 1-based "knownScales/scales/<n>/<field>"), so existing lists still read.
+static QString knownScaleKeyPrefix(int index) {
+    return QStringLiteral("knownScales/scales/%1/").arg(index + 1);
+}
+
 QVariantList Settings::knownScales() const {
     QVariantList result;
     QString primary = primaryScaleAddress();
-    qsizetype count = m_settings.beginReadArray("knownScales/scales");
-    for (qsizetype i = 0; i < count; ++i) {
-        m_settings.setArrayIndex(static_cast<int>(i));
+    const int count = m_settings.value("knownScales/scales/size", 0).toInt();
+    for (int i = 0; i < count; ++i) {
+        const QString prefix = knownScaleKeyPrefix(i);
         QVariantMap scale;
-        scale["address"] = m_settings.value("address").toString();
-        scale["type"] = m_settings.value("type").toString();
-        scale["name"] = m_settings.value("name").toString();
+        scale["address"] = m_settings.value(prefix + "address").toString();
+        scale["type"] = m_settings.value(prefix + "type").toString();
+        scale["name"] = m_settings.value(prefix + "name").toString();
         scale["isPrimary"] = (scale["address"].toString().compare(primary, Qt::CaseInsensitive) == 0);
         result.append(scale);
     }
-    m_settings.endArray();
     return result;
 }
 
@@ -435,28 +467,23 @@ QString Settings::primaryScaleAddress() const {
 }
 
 bool Settings::isKnownScale(const QString& address) const {
-    qsizetype count = m_settings.beginReadArray("knownScales/scales");
-    for (qsizetype i = 0; i < count; ++i) {
-        m_settings.setArrayIndex(static_cast<int>(i));
-        if (m_settings.value("address").toString().compare(address, Qt::CaseInsensitive) == 0) {
-            m_settings.endArray();
+    const int count = m_settings.value("knownScales/scales/size", 0).toInt();
+    for (int i = 0; i < count; ++i) {
+        if (m_settings.value(knownScaleKeyPrefix(i) + "address").toString().compare(address, Qt::CaseInsensitive) == 0)
             return true;
-        }
     }
-    m_settings.endArray();
     return false;
 }
 
 void Settings::writeKnownScales(const QVariantList& scales) {
-    m_settings.beginWriteArray("knownScales/scales", static_cast<int>(scales.size()));
+    m_settings.setValue("knownScales/scales/size", static_cast<int>(scales.size()));
     for (qsizetype i = 0; i < scales.size(); ++i) {
-        m_settings.setArrayIndex(static_cast<int>(i));
+        const QString prefix = knownScaleKeyPrefix(static_cast<int>(i));
         QVariantMap s = scales[i].toMap();
-        m_settings.setValue("address", s["address"]);
-        m_settings.setValue("type", s["type"]);
-        m_settings.setValue("name", s["name"]);
+        m_settings.setValue(prefix + "address", s["address"]);
+        m_settings.setValue(prefix + "type", s["type"]);
+        m_settings.setValue(prefix + "name", s["name"]);
     }
-    m_settings.endArray();
     emit knownScalesChanged();
 }
 
@@ -571,9 +598,10 @@ bool Settings::setProfileFlowCalibration(const QString& profileFilename, double
                    << multiplier << "for" << profileFilename << "(outside [0.5, 2.7])";
         return false;
     }
-    QJsonObject map = allProfileFlowCalibrations();
-    map[profileFilename] = multiplier;
-    savePerProfileFlowCalMap(map);
+    m_calibration->setFlowCalibration(profileFilename, multiplier);
+    allProfileFlowCalibrations();  // Make sure the cache is loaded before patching it
+    m_perProfileFlowCalCache[profileFilename] = multiplier;
+    notifyPerProfileFlowCalChanged();
     return true;
 }
 
@@ -582,9 +610,10 @@ void Settings::clearProfileFlowCalibration(const QString& profileFilename) {
         qWarning() << "Settings: clearProfileFlowCalibration called with empty profile filename";
         return;
     }
-    QJsonObject map = allProfileFlowCalibrations();
-    map.remove(profileFilename);
-    savePerProfileFlowCalMap(map);
+    m_calibration->removeFlowCalibration(profileFilename);
+    allProfileFlowCalibrations();
+    m_perProfileFlowCalCache.remove(profileFilename);
+    notifyPerProfileFlowCalChanged();
     // Clear any pending batch ideals — they were computed at the old C value
     clearFlowCalPendingIdeals(profileFilename);
 }
@@ -609,70 +638,30 @@ QJsonObject Settings::allProfileFlowCalibrations() const {
     if (m_perProfileFlowCalCacheValid)
         return m_perProfileFlowCalCache;
 
-    QJsonParseError parseError;
-    QJsonObject map = QJsonDocument::fromJson(
-        m_settings.value("calibration/perProfileFlow", "{}").toByteArray(),
-        &parseError).object();
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Settings: corrupt perProfileFlow JSON:" << parseError.errorString()
-                   << "- raw data:" << m_settings.value("calibration/perProfileFlow").toByteArray().left(200)
-                   << "- per-profile flow calibrations lost";
-        // Clear the corrupt data so it doesn't persist and cause repeated warnings
-        const_cast<QSettings&>(m_settings).setValue("calibration/perProfileFlow", "{}");
-        map = QJsonObject();
-    }
-    // Cache the result (even if empty from corruption) to prevent repeated re-parsing.
-    // INVARIANT: All modifications to "calibration/perProfileFlow" in QSettings
-    // MUST go through savePerProfileFlowCalMap() to maintain cache consistency.
-    m_perProfileFlowCalCache = map;
+    // INVARIANT: all per-profile flow calibration writes go through
+    // m_calibration AND patch this cache (set/clearProfileFlowCalibration).
+    m_perProfileFlowCalCache = m_calibration->flowCalibrations();
     m_perProfileFlowCalCacheValid = true;
     return m_perProfileFlowCalCache;
 }
 
-void Settings::savePerProfileFlowCalMap(const QJsonObject& map) {
-    m_settings.setValue("calibration/perProfileFlow", QJsonDocument(map).toJson(QJsonDocument::Compact));
-    m_perProfileFlowCalCache = map;
-    m_perProfileFlowCalCacheValid = true;
+void Settings::notifyPerProfileFlowCalChanged() {
     m_perProfileFlowCalVersion++;
     emit perProfileFlowCalibrationChanged();
 }
 
 // Auto flow calibration batch accumulator
 
-static QJsonObject parseFlowCalBatch(const QSettings& settings) {
-    QJsonParseError parseError;
-    QJsonObject map = QJsonDocument::fromJson(
-        settings.value("calibration/flowCalBatch", "{}").toByteArray(),
-        &parseError).object();
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Settings: corrupt flowCalBatch JSON:" << parseError.errorString();
-        const_cast<QSettings&>(settings).setValue("calibration/flowCalBatch", "{}");
-        return QJsonObject();
-    }
-    return map;
-}
-
 QVector<double> Settings::flowCalPendingIdeals(const QString& profileFilename) const {
-    QJsonObject map = parseFlowCalBatch(m_settings);
-    QVector<double> result;
-    QJsonArray arr = map.value(profileFilename).toArray();
-    for (const auto& v : arr)
-        result.append(v.toDouble());
-    return result;
+    return m_calibration->flowCalPendingIdeals(profileFilename);
 }
 
 void Settings::appendFlowCalPendingIdeal(const QString& profileFilename, double ideal) {
-    QJsonObject map = parseFlowCalBatch(m_settings);
-    QJsonArray arr = map.value(profileFilename).toArray();
-    arr.append(ideal);
-    map[profileFilename] = arr;
-    m_settings.setValue("calibration/flowCalBatch", QJsonDocument(map).toJson(QJsonDocument::Compact));
+    m_calibration->appendFlowCalPendingIdeal(profileFilename, ideal);
 }
 
 void Settings::clearFlowCalPendingIdeals(const QString& profileFilename) {
-    QJsonObject map = parseFlowCalBatch(m_settings);
-    map.remove(profileFilename);
-    m_settings.setValue("calibration/flowCalBatch", QJsonDocument(map).toJson(QJsonDocument::Compact));
+    m_calibration->clearFlowCalPendingIdeals(profileFilename);
 }
 
 // SAW (Stop-at-Weight) learning
@@ -722,13 +711,7 @@ double Settings::sawLearnedLag() const {
 
 void Settings::ensureSawCacheLoaded() const {
     if (!m_sawHistoryCacheDirty) return;
-    QByteArray data = m_settings.value("saw/learningHistory").toByteArray();
-    if (data.isEmpty()) {
-        m_sawHistoryCache = QJsonArray();
-    } else {
-        QJsonDocument doc = QJsonDocument::fromJson(data);
-        m_sawHistoryCache = doc.array();
-    }
+    m_sawHistoryCache = m_calibration->sawPool();
     m_sawHistoryCacheDirty = false;
     m_sawConvergedCache = -1;  // Invalidate convergence cache too
 }
@@ -944,17 +927,8 @@ void Settings::addSawLearningPoint(double drip, double flowRate, const QString&
 
     // Legacy path (profile unknown): append directly to the global pool. Preserves
     // existing behaviour for callers that have not been updated to pass a profile.
-    QByteArray data = m_settings.value("saw/learningHistory").toByteArray();
-    QJsonArray arr;
-    if (!data.isEmpty()) {
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
-        if (doc.isArray()) {
-            arr = doc.array();
-        } else {
-            qWarning() << "[SAW] Learning history corrupted, starting fresh:" << parseError.errorString();
-        }
-    }
+    ensureSawCacheLoaded();
+    const QJsonArray& arr = m_sawHistoryCache;
 
     // Auto-reset: if this shot stopped 6g+ early (current) AND the most recent
     // prior entry for this scale type also stopped 6g+ early, the learning is
@@ -962,8 +936,9 @@ void Settings::addSawLearningPoint(double drip, double flowRate, const QString&
     // so the new entry becomes the sole baseline. Entries from other scale types
     // are skipped when searching backwards — "consecutive" means consecutive for
     // this scale type only.
-    // NOTE: execution always falls through to the append+save below — do NOT add
-    // an early return here, or the reset will wipe history without saving anything.
+    // NOTE: execution always falls through to the append below — do NOT add an
+    // early return here, or the reset will wipe history without saving anything.
+    bool resetScale = false;
     if (isAutoResetCandidate) {
         bool prevAlsoEarly = false;
         for (qsizetype i = arr.size() - 1; i >= 0; --i) {
@@ -978,12 +953,7 @@ void Settings::addSawLearningPoint(double drip, double flowRate, const QString&
                        << "- resetting learning (both shots overshoot <-6g)";
             // Remove all entries for this scale type, preserving other scales.
             // The new entry will be appended below and becomes the fresh baseline.
-            QJsonArray filtered;
-            for (int i = 0; i < arr.size(); ++i) {
-                if (arr[i].toObject()["scale"].toString() != scaleType)
-                    filtered.append(arr[i]);
-            }
-            arr = filtered;
+            resetScale = true;
         }
     }
 
@@ -994,28 +964,19 @@ void Settings::addSawLearningPoint(double drip, double flowRate, const QString&
     entry["scale"] = scaleType;
     entry["overshoot"] = overshoot; // grams over/under target (for convergence detection)
     entry["ts"] = QDateTime::currentSecsSinceEpoch();
-    arr.append(entry);
-
-    // Trim to max 50 entries (converged mode uses up to 20, keep extra history)
-    while (arr.size() > 50) {
-        arr.removeFirst();
-    }
 
-    m_settings.setValue("saw/learningHistory", QJsonDocument(arr).toJson());
+    // Keep max 50 entries (converged mode uses up to 20, keep extra history)
+    m_calibration->appendSawPoolEntry(entry, 50, resetScale ? scaleType : QString());
     m_sawHistoryCacheDirty = true;
     m_sawConvergedCache = -1;
     emit sawLearnedLagChanged();
 }
 
 void Settings::resetSawLearning() {
-    m_settings.remove("saw/learningHistory");
-    m_settings.remove("saw/perProfileHistory");
-    m_settings.remove("saw/perProfileBatch");
+    m_calibration->clearSaw();
     m_settings.remove("saw/globalBootstrapLag");
     m_sawHistoryCacheDirty = true;
     m_sawConvergedCache = -1;
-    m_perProfileSawHistoryCacheValid = false;
-    m_perProfileSawBatchCacheValid = false;
     qDebug() << "[SAW] reset all SAW learning";
     emit sawLearnedLagChanged();
 
@@ -1030,20 +991,10 @@ void Settings::resetSawLearningForProfile(const QString& profileFilename, const
         return;
     }
     const QString key = sawPairKey(profileFilename, scaleType);
-    QJsonObject historyMap = loadPerProfileSawHistoryMap();
-    QJsonObject batchMap = loadPerProfileSawBatchMap();
-    bool changed = false;
-    if (historyMap.contains(key)) {
-        historyMap.remove(key);
-        savePerProfileSawHistoryMap(historyMap);
-        changed = true;
-    }
-    if (batchMap.contains(key)) {
-        batchMap.remove(key);
-        savePerProfileSawBatchMap(batchMap);
-        changed = true;
-    }
+    const bool changed = m_calibration->sawPairHistoryCount(profileFilename, scaleType) > 0
+                         || !m_calibration->sawPendingBatch(profileFilename, scaleType).isEmpty();
     if (changed) {
+        m_calibration->clearSawPair(profileFilename, scaleType);
         qDebug() << "[SAW] reset perProfileHistory for" << key;
         emit sawLearnedLagChanged();
     }
@@ -1055,63 +1006,16 @@ QString Settings::sawPairKey(const QString& profileFilename, const QString& scal
     return profileFilename + QStringLiteral("::") + scaleType;
 }
 
-QJsonObject Settings::loadPerProfileSawHistoryMap() const {
-    if (m_perProfileSawHistoryCacheValid) return m_perProfileSawHistoryCache;
-    QJsonParseError parseError;
-    QJsonObject map = QJsonDocument::fromJson(
-        m_settings.value("saw/perProfileHistory", "{}").toByteArray(),
-        &parseError).object();
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "[SAW] corrupt perProfileHistory JSON:" << parseError.errorString()
-                   << "- per-profile SAW history lost";
-        const_cast<QSettings&>(m_settings).setValue("saw/perProfileHistory", "{}");
-        map = QJsonObject();
-    }
-    m_perProfileSawHistoryCache = map;
-    m_perProfileSawHistoryCacheValid = true;
-    return m_perProfileSawHistoryCache;
-}
-
-void Settings::savePerProfileSawHistoryMap(const QJsonObject& map) {
-    m_settings.setValue("saw/perProfileHistory",
-                        QJsonDocument(map).toJson(QJsonDocument::Compact));
-    m_perProfileSawHistoryCache = map;
-    m_perProfileSawHistoryCacheValid = true;
-}
-
-QJsonObject Settings::loadPerProfileSawBatchMap() const {
-    if (m_perProfileSawBatchCacheValid) return m_perProfileSawBatchCache;
-    QJsonParseError parseError;
-    QJsonObject map = QJsonDocument::fromJson(
-        m_settings.value("saw/perProfileBatch", "{}").toByteArray(),
-        &parseError).object();
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "[SAW] corrupt perProfileBatch JSON:" << parseError.errorString();
-        const_cast<QSettings&>(m_settings).setValue("saw/perProfileBatch", "{}");
-        map = QJsonObject();
-    }
-    m_perProfileSawBatchCache = map;
-    m_perProfileSawBatchCacheValid = true;
-    return m_perProfileSawBatchCache;
-}
-
-void Settings::savePerProfileSawBatchMap(const QJsonObject& map) {
-    m_settings.setValue("saw/perProfileBatch",
-                        QJsonDocument(map).toJson(QJsonDocument::Compact));
-    m_perProfileSawBatchCache = map;
-    m_perProfileSawBatchCacheValid = true;
-}
-
 QJsonArray Settings::perProfileSawHistory(const QString& profileFilename, const QString& scaleType) const {
-    return loadPerProfileSawHistoryMap().value(sawPairKey(profileFilename, scaleType)).toArray();
+    return m_calibration->sawPairHistory(profileFilename, scaleType);
 }
 
 QJsonObject Settings::allPerProfileSawHistory() const {
-    return loadPerProfileSawHistoryMap();
+    return m_calibration->allSawPairHistory();
 }
 
 QJsonArray Settings::sawPendingBatch(const QString& profileFilename, const QString& scaleType) const {
-    return loadPerProfileSawBatchMap().value(sawPairKey(profileFilename, scaleType)).toArray();
+    return m_calibration->sawPendingBatch(profileFilename, scaleType);
 }
 
 double Settings::globalSawBootstrapLag(const QString& scaleType) const {
@@ -1127,9 +1031,9 @@ void Settings::setGlobalSawBootstrapLag(const QString& scaleType, double lag) {
 // ---- per-(profile, scale) read path ----
 
 QString Settings::sawModelSource(const QString& profileFilename, const QString& scaleType) const {
-    if (!profileFilename.isEmpty()) {
-        QJsonArray pairHistory = perProfileSawHistory(profileFilename, scaleType);
-        if (pairHistory.size() >= kSawMinMediansForGraduation) return QStringLiteral("perProfile");
+    if (!profileFilename.isEmpty()
+        && m_calibration->sawPairHistoryCount(profileFilename, scaleType) >= kSawMinMediansForGraduation) {
+        return QStringLiteral("perProfile");
     }
     if (globalSawBootstrapLag(scaleType) > 0.0) return QStringLiteral("globalBootstrap");
     ensureSawCacheLoaded();
@@ -1142,16 +1046,13 @@ QString Settings::sawModelSource(const QString& profileFilename, const QString&
 QList<QPair<double, double>> Settings::sawLearningEntriesFor(const QString& profileFilename,
                                                              const QString& scaleType,
                                                              int maxEntries) const {
-    QList<QPair<double, double>> result;
     if (!profileFilename.isEmpty()) {
-        QJsonArray pairHistory = perProfileSawHistory(profileFilename, scaleType);
-        if (pairHistory.size() >= kSawMinMediansForGraduation) {
-            for (qsizetype i = pairHistory.size() - 1; i >= 0 && result.size() < maxEntries; --i) {
-                QJsonObject obj = pairHistory[i].toObject();
-                if (obj.contains("drip")) {
-                    result.append({obj["drip"].toDouble(), obj["flow"].toDouble()});
-                }
-            }
+        // Bounded indexed read, newest first: enough medians to both check
+        // graduation and fill maxEntries
+        const int limit = qMax(maxEntries, static_cast<int>(kSawMinMediansForGraduation));
+        QList<QPair<double, double>> result = m_calibration->recentSawPairEntries(profileFilename, scaleType, limit);
+        if (result.size() >= kSawMinMediansForGraduation) {
+            result.resize(qMin<qsizetype>(result.size(), qMax(maxEntries, 0)));
             if (!result.isEmpty()) return result;
         }
     }
@@ -1235,8 +1136,7 @@ void Settings::addSawPerPairEntry(double drip, double flowRate, const QString& s
     const QString key = sawPairKey(profileFilename, scaleType);
 
     // 1. Append entry to pending batch
-    QJsonObject batchMap = loadPerProfileSawBatchMap();
-    QJsonArray batch = batchMap.value(key).toArray();
+    QJsonArray batch = m_calibration->sawPendingBatch(profileFilename, scaleType);
     QJsonObject entry;
     entry["drip"] = drip;
     entry["flow"] = flowRate;
@@ -1247,8 +1147,7 @@ void Settings::addSawPerPairEntry(double drip, double flowRate, const QString& s
     batch.append(entry);
 
     if (batch.size() < kBatchSize) {
-        batchMap[key] = batch;
-        savePerProfileSawBatchMap(batchMap);
+        m_calibration->appendSawPendingEntry(profileFilename, scaleType, entry);
         const double lag = (flowRate > 0.5) ? drip / flowRate : 0.0;
         qDebug() << "[SAW] accumulated drip=" << drip << "flow=" << flowRate
                  << "for" << key
@@ -1304,8 +1203,7 @@ void Settings::addSawPerPairEntry(double drip, double flowRate, const QString& s
     if (!rejectReason.isEmpty()) {
         qWarning() << "[SAW] batch rejected —" << qPrintable(rejectReason)
                    << "median_lag=" << medianLag << "for" << key << "— dropping batch";
-        batchMap.remove(key);
-        savePerProfileSawBatchMap(batchMap);
+        m_calibration->clearSawPendingBatch(profileFilename, scaleType);
         return;
     }
 
@@ -1315,14 +1213,14 @@ void Settings::addSawPerPairEntry(double drip, double flowRate, const QString& s
     //    auto-reset trigger is effectively 10 consecutive bad shots — intentional
     //    debouncing for the batched update model. (Distinct from the graduation
     //    threshold defined at the top of this section.)
-    QJsonObject historyMap = loadPerProfileSawHistoryMap();
-    QJsonArray pairHistory = historyMap.value(key).toArray();
+    const QJsonArray pairHistory = m_calibration->sawPairHistory(profileFilename, scaleType);
+    bool resetPairHistory = false;
     if (medianOver < -6.0 && !pairHistory.isEmpty()) {
         QJsonObject lastMedian = pairHistory.last().toObject();
         if (lastMedian["overshoot"].toDouble() < -6.0) {
             qWarning() << "[SAW] 2nd consecutive overshoot<-6g for" << key
                        << "— clearing committed history";
-            pairHistory = QJsonArray();
+            resetPairHistory = true;
         }
     }
 
@@ -1335,34 +1233,21 @@ void Settings::addSawPerPairEntry(double drip, double flowRate, const QString& s
     medianEntry["profile"] = profileFilename;
     medianEntry["ts"] = QDateTime::currentSecsSinceEpoch();
     medianEntry["batchSize"] = batch.size();
-    pairHistory.append(medianEntry);
-    while (pairHistory.size() > kMaxPairHistory) pairHistory.removeFirst();
-    historyMap[key] = pairHistory;
-    savePerProfileSawHistoryMap(historyMap);
 
     // 6. Mirror the median into the global pool so isSawConverged + the legacy
     //    bootstrap path keep working. Trim to 50 (existing cap).
-    QByteArray data = m_settings.value("saw/learningHistory").toByteArray();
-    QJsonArray pool;
-    if (!data.isEmpty()) {
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
-        if (doc.isArray()) pool = doc.array();
-    }
-    pool.append(medianEntry);
-    while (pool.size() > 50) pool.removeFirst();
-    m_settings.setValue("saw/learningHistory", QJsonDocument(pool).toJson());
+    // 7. Clear pending batch.
+    //    Steps 5-7 are one store transaction.
+    m_calibration->commitSawBatch(profileFilename, scaleType, medianEntry,
+                                  resetPairHistory, kMaxPairHistory, 50);
     m_sawHistoryCacheDirty = true;
     m_sawConvergedCache = -1;
 
-    // 7. Clear pending batch.
-    batchMap.remove(key);
-    savePerProfileSawBatchMap(batchMap);
-
+    const qsizetype nMedians = qMin<qsizetype>((resetPairHistory ? 0 : pairHistory.size()) + 1, kMaxPairHistory);
     qDebug() << "[SAW] committed median lag=" << medianLag
              << "(drip=" << medianDrip << "flow=" << medianFlow << ")"
              << "for" << key
-             << "— n_medians=" << pairHistory.size();
+             << "— n_medians=" << nMedians;
 
     // 8. Recompute global bootstrap lag for this scale type so other (profile, scale)
     //    pairs with no per-pair history can use it as their first-shot default.
@@ -1379,15 +1264,10 @@ void Settings::recomputeGlobalSawBootstrap(const QString& scaleType) {
     // crossed the per-profile graduation threshold (kSawMinMediansForGraduation
     // medians) for the read path are a stricter bar handled in sawLearnedLagFor /
     // sawModelSource.
-    QJsonObject map = loadPerProfileSawHistoryMap();
     QVector<double> lags;
-    for (auto it = map.begin(); it != map.end(); ++it) {
-        QJsonArray pairHistory = it.value().toArray();
-        if (pairHistory.isEmpty()) continue;
-        // Median entries record their scale; only include this scale's pairs.
-        if (pairHistory.last().toObject().value("scale").toString() != scaleType) continue;
-        // Use the last committed median lag as that pair's representative.
-        QJsonObject last = pairHistory.last().toObject();
+    // Use the last committed median lag of each of this scale's pairs as that
+    // pair's representative.
+    for (const QJsonObject& last : m_calibration->latestSawPairMedians(scaleType)) {
         double drip = last.value("drip").toDouble();
         double flow = last.value("flow").toDouble();
         if (flow > 0.5) lags.append(drip / flow);
@@ -1424,6 +1304,11 @@ QVariant Settings::value(const QString& key, const QVariant& defaultValue) const
 
 void Settings::setValue(const QString& key, const QVariant& value) {
     m_settings.setValue(key, value);
+    if (m_transactionDepth > 0) {
+        if (!m_transactionKeys.contains(key))
+            m_transactionKeys.append(key);
+        return;
+    }
     emit valueChanged(key);
 }
 
@@ -1437,6 +1322,87 @@ bool Settings::boolValue(const QString& key, bool defaultValue) const {
     return v.toBool();
 }
 
+QList<QObject*> Settings::notifyingObjects() const
+{
+    return {const_cast<Settings*>(this), m_mqtt, m_autoWake, m_hardware, m_ai, m_theme,
+            m_visualizer, m_mcp, m_brew, m_dye, m_network, m_app};
+}
+
+void Settings::beginTransaction(const QString& label)
+{
+    if (m_transactionDepth++ > 0)
+        return;
+
+    m_transactionLabel = label;
+    m_transactionTimer.start();
+    m_transactionStartWrites = m_settings.changeCount();
+    m_settings.holdSnapshots();
+
+    // Snapshot every notifying property so commit can tell which ones moved
+    for (QObject* object : notifyingObjects()) {
+        const QMetaObject* mo = object->metaObject();
+        for (int i = mo->propertyOffset(); i < mo->propertyCount(); ++i) {
+            const QMetaProperty property = mo->property(i);
+            if (property.isReadable() && property.hasNotifySignal())
+                m_transactionSnapshot.append({object, property, property.read(object)});
+        }
+        m_transactionWasBlocked.append(object->blockSignals(true));
+    }
+}
+
+void Settings::commitTransaction()
+{
+    if (m_transactionDepth == 0) {
+        qWarning() << "Settings: commitTransaction() without beginTransaction()";
+        return;
+    }
+    if (--m_transactionDepth > 0)
+        return;
+
+    // Publish before any slot runs, so work a slot hands to another thread sees the result
+    m_settings.releaseSnapshots();
+
+    const QList<QObject*> objects = notifyingObjects();
+    for (qsizetype i = 0; i < objects.size(); ++i)
+        objects[i]->blockSignals(m_transactionWasBlocked.value(i));
+
+    // Properties can share a NOTIFY signal (e.g. the theme colors); emit each once
+    QList<QPair<QObject*, QMetaMethod>> changed;
+    QSet<QPair<QObject*, int>> seen;
+    bool aiChanged = false;
+    for (const PropertySnapshot& snapshot : std::as_const(m_transactionSnapshot)) {
+        if (snapshot.property.read(snapshot.object) == snapshot.value)
+            continue;
+        const QMetaMethod signal = snapshot.property.notifySignal();
+        if (seen.contains({snapshot.object, signal.methodIndex()}))
+            continue;
+        seen.insert({snapshot.object, signal.methodIndex()});
+        changed.append({snapshot.object, signal});
+        aiChanged = aiChanged || snapshot.object == m_ai;
+    }
+    const QStringList keys = std::exchange(m_transactionKeys, QStringList());
+    m_transactionSnapshot.clear();
+    m_transactionWasBlocked.clear();
+
+    TransactionStats stats;
+    stats.label = m_transactionLabel;
+    stats.writes = m_settings.changeCount() - m_transactionStartWrites;
+    stats.notifications = static_cast<int>(changed.size() + keys.size()) + (aiChanged ? 1 : 0);
+
+    // Bookkeeping is reset first, so a slot may open a transaction of its own
+    for (const auto& [object, signal] : changed)
+        signal.invoke(object, Qt::DirectConnection);
+    if (aiChanged)
+        emit m_ai->configurationChanged();  // Not a NOTIFY; SettingsAI emits it with every property
+    for (const QString& key : keys)
+        emit valueChanged(key);
+
+    stats.elapsedMs = m_transactionTimer.elapsed();
+    m_lastTransactionStats = stats;
+    qDebug() << "Settings: transaction" << stats.label << "-" << stats.writes << "writes,"
+             << stats.notifications << "change signals in" << stats.elapsedMs << "ms";
+}
+
 void Settings::factoryReset()
 {
     qWarning() << "Settings::factoryReset() - WIPING ALL DATA";
@@ -1448,6 +1414,12 @@ void Settings::factoryReset()
     // Invalidate in-memory caches so getters re-read from (now-empty) QSettings
     m_dye->invalidateCache();
 
+    // 1b. Clear learned calibration (SAW learning, per-profile flow calibration)
+    m_calibration->clearAll();
+    m_sawHistoryCacheDirty = true;
+    m_sawConvergedCache = -1;
+    m_perProfileFlowCalCacheValid = false;
+
     // 2. Clear secondary QSettings store (used by AI, location, profilestorage)
     QSettings defaultSettings;
     defaultSettings.clear();
@@ -3,10 +3,18 @@
 #include <QObject>
 #include <QSettings>
 #include <QString>
+#include <QStringList>
 #include <QVariantList>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QMetaProperty>
+
+#include "settingsstore.h"
+
+#include <functional>
+
 // Domain sub-objects are forward-declared. The QML-facing Q_PROPERTYs return
 // QObject* (a known type that QML can introspect) so this header doesn't need
 // to include the eleven sub-object headers — preserving the recompile-blast
@@ -25,6 +33,7 @@ class SettingsBrew;
 class SettingsDye;
 class SettingsNetwork;
 class SettingsApp;
+class CalibrationStore;
 
 class Settings : public QObject {
     Q_OBJECT
@@ -156,9 +165,13 @@ public:
     bool usbSerialEnabled() const;
     void setUsbSerialEnabled(bool enabled);
 
-    // Force sync to disk
+    // Write debounced changes to disk now (blocks until written)
     void sync() { m_settings.sync(); }
 
+    // Immutable copy of all settings for code running off the main thread,
+    // which must not call the getters here or on the domain objects
+    std::shared_ptr<const SettingsSnapshot> snapshot() const { return m_settings.snapshot(); }
+
     // Flow calibration
     double flowCalibrationMultiplier() const;
     void setFlowCalibrationMultiplier(double multiplier);
@@ -218,6 +231,37 @@ public:
 
     Q_INVOKABLE void factoryReset();
 
+    // Change-notification batching for bulk updates (theme switch, backup
+    // restore, SettingsSerializer::importFromJson). Between begin and commit,
+    // Settings and its domain objects emit nothing; commit emits each NOTIFY
+    // signal once, and only for properties whose value actually changed, then
+    // the deferred valueChanged(key)s. Settings' own cross-domain reactions
+    // are not deferred: they follow each write in order, as outside a
+    // transaction. snapshot() moves from the state before begin to the state
+    // at commit in one step. Nests; the outermost commit emits.
+    Q_INVOKABLE void beginTransaction(const QString& label = QString());
+    Q_INVOKABLE void commitTransaction();
+    bool inTransaction() const { return m_transactionDepth > 0; }
+
+    struct TransactionStats {
+        QString label;
+        quint64 writes = 0;     // Settings writes that changed a value
+        int notifications = 0;  // Change signals emitted at commit
+        qint64 elapsedMs = 0;
+    };
+    TransactionStats lastTransactionStats() const { return m_lastTransactionStats; }
+
+    // Begins on construction, commits on destruction
+    class Transaction {
+    public:
+        explicit Transaction(Settings* settings, const QString& label = QString())
+            : m_settings(settings) { if (m_settings) m_settings->beginTransaction(label); }
+        ~Transaction() { if (m_settings) m_settings->commitTransaction(); }
+        Q_DISABLE_COPY(Transaction)
+    private:
+        Settings* m_settings;
+    };
+
     // Generic settings access (for extensibility)
     Q_INVOKABLE QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
     Q_INVOKABLE void setValue(const QString& key, const QVariant& value);
@@ -256,9 +300,9 @@ private:
     void ensureSawCacheLoaded() const;
     void writeKnownScales(const QVariantList& scales);
 
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 
-    // SAW learning history cache (avoids re-parsing JSON from QSettings on every weight sample)
+    // SAW learning pool cache (avoids querying the store on every weight sample)
     mutable QJsonArray m_sawHistoryCache;
     mutable bool m_sawHistoryCacheDirty = true;
     mutable int m_sawConvergedCache = -1;  // -1 = unknown, 0 = no, 1 = yes
@@ -266,24 +310,47 @@ private:
     int m_perProfileFlowCalVersion = 0;  // Bumped on per-profile calibration changes to trigger QML rebind
     mutable QJsonObject m_perProfileFlowCalCache;  // Cached per-profile flow calibration map
     mutable bool m_perProfileFlowCalCacheValid = false;
-    void savePerProfileFlowCalMap(const QJsonObject& map);
-
-    // Per-(profile, scale) SAW history cache. INVARIANT: all writes route through
-    // savePerProfileSawHistoryMap() / savePerProfileSawBatchMap() to keep the cache
-    // and QSettings in sync (mirrors the perProfileFlowCal cache pattern).
-    mutable QJsonObject m_perProfileSawHistoryCache;
-    mutable bool m_perProfileSawHistoryCacheValid = false;
-    mutable QJsonObject m_perProfileSawBatchCache;
-    mutable bool m_perProfileSawBatchCacheValid = false;
-    QJsonObject loadPerProfileSawHistoryMap() const;
-    void savePerProfileSawHistoryMap(const QJsonObject& map);
-    QJsonObject loadPerProfileSawBatchMap() const;
-    void savePerProfileSawBatchMap(const QJsonObject& map);
+    void notifyPerProfileFlowCalChanged();
+
+    // SAW learning (global pool, per-(profile, scale) medians and pending batches)
+    // and per-profile flow calibration live in SQLite, not QSettings. The pool
+    // and flow-cal caches above are filled from it and updated on every write.
+    CalibrationStore* m_calibration = nullptr;
     static QString sawPairKey(const QString& profileFilename, const QString& scaleType);
     void addSawPerPairEntry(double drip, double flowRate, const QString& scaleType,
                             double overshoot, const QString& profileFilename);
     void recomputeGlobalSawBootstrap(const QString& scaleType);
 
+    // Cross-domain reactions (wired in Settings::Settings). Driven by
+    // SettingsStore::changed rather than the source's NOTIFY signal, so a
+    // reaction runs right after the write that triggers it, also inside a
+    // transaction where NOTIFYs wait for commit. A restore that sets the
+    // default rating and then the bean's enjoyment keeps the enjoyment.
+    struct CrossDomainReaction {
+        std::function<QVariant()> read;
+        std::function<void()> react;
+        QVariant lastValue;
+    };
+    QList<CrossDomainReaction> m_crossDomainReactions;
+    void addCrossDomainReaction(std::function<QVariant()> read, std::function<void()> react);
+    void runCrossDomainReactions();
+
+    // Notification batching (beginTransaction / commitTransaction)
+    struct PropertySnapshot {
+        QObject* object;
+        QMetaProperty property;
+        QVariant value;
+    };
+    QList<QObject*> notifyingObjects() const;
+    int m_transactionDepth = 0;
+    QString m_transactionLabel;
+    QList<PropertySnapshot> m_transactionSnapshot;
+    QList<bool> m_transactionWasBlocked;  // blockSignals() state to restore, per notifyingObjects()
+    QStringList m_transactionKeys;        // Deferred valueChanged(key), first-write order
+    quint64 m_transactionStartWrites = 0;
+    QElapsedTimer m_transactionTimer;
+    TransactionStats m_lastTransactionStats;
+
     // Domain sub-objects (composition façade)
     SettingsMqtt* m_mqtt = nullptr;
     SettingsAutoWake* m_autoWake = nullptr;
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 
+#include "settingsstore.h"
+
 // AI Dialing Assistant settings: provider selection, API keys, endpoints.
 class SettingsAI : public QObject {
     Q_OBJECT
@@ -59,5 +60,5 @@ signals:
     void configurationChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 };
@@ -14,7 +14,7 @@
 
 SettingsApp::SettingsApp(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
     , m_use12HourTime(QLocale::system().timeFormat(QLocale::ShortFormat).contains("AP", Qt::CaseInsensitive))
 {
 }
@@ -513,7 +513,7 @@ QString SettingsApp::deviceId() const {
     QString id = m_settings.value("device/uuid").toString();
     if (id.isEmpty()) {
         id = QUuid::createUuid().toString(QUuid::WithoutBraces);
-        const_cast<QSettings&>(m_settings).setValue("device/uuid", id);
+        m_settings.setValue("device/uuid", id);
     }
     return id;
 }
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 #include <QStringList>
 #include <QVariantList>
 #include <QVariantMap>
 
+#include "settingsstore.h"
+
 // App-level settings: auto-update channel, backup schedule, developer/platform
 // flags, water level/refill, profile management bookkeeping (favorites, hidden,
 // selected built-ins, current profile), device identity, Pocket pairing.
@@ -162,7 +163,7 @@ signals:
     void screenCaptureEnabledChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
     bool m_use12HourTime = false;
 
     // Runtime-only flag — not persisted, resets to false on app restart
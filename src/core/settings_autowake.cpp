@@ -7,7 +7,7 @@
 
 SettingsAutoWake::SettingsAutoWake(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
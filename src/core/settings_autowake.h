@@ -1,9 +1,10 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QVariantList>
 
+#include "settingsstore.h"
+
 class SettingsAutoWake : public QObject {
     Q_OBJECT
 
@@ -37,5 +38,5 @@ signals:
     void autoWakeStayAwakeMinutesChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 };
@@ -7,7 +7,7 @@
 
 SettingsBrew::SettingsBrew(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
     // Seed default steam pitcher presets if none exist
     if (!m_settings.contains("steam/pitcherPresets")) {
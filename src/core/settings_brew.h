@@ -1,11 +1,12 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 #include <QVariantList>
 #include <QVariantMap>
 
+#include "settingsstore.h"
+
 // Brew-domain settings: espresso, steam, hot water, flush, presets, and
 // session-only brew/temperature overrides. Split from Settings to keep
 // settings.h's transitive-include footprint small.
@@ -200,7 +201,7 @@ signals:
     void ignoreVolumeWithScaleChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 
     // Session-only steam-disable flag (used during descaling)
     bool m_steamDisabled = false;
@@ -8,7 +8,7 @@
 
 SettingsDye::SettingsDye(SettingsVisualizer* visualizer, QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
     , m_visualizer(visualizer)
 {
     // The visualizer pointer is required — dyeEspressoEnjoyment() falls back
@@ -1,13 +1,14 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 #include <QStringList>
 #include <QVariantList>
 #include <QVariantMap>
 #include <QJsonArray>
 
+#include "settingsstore.h"
+
 class SettingsVisualizer;
 
 // DYE (Describe Your Espresso) metadata + bean preset CRUD. Split from Settings
@@ -160,7 +161,7 @@ private:
     void recomputeBeansModified();
     void ensureDyeCacheLoaded() const;
 
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
     SettingsVisualizer* m_visualizer = nullptr;  // Non-owning; for default-rating fallback.
 
     bool m_beansModified = false;
@@ -4,7 +4,7 @@
 
 SettingsHardware::SettingsHardware(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
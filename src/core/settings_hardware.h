@@ -1,7 +1,8 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
+
+#include "settingsstore.h"
 
 // Hardware calibration settings sent to the DE1 firmware:
 // heater tweaks, hot-water flow rate, steam two-tap stop.
@@ -45,5 +46,5 @@ signals:
     void steamTwoTapStopChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 };
@@ -4,7 +4,7 @@
 
 SettingsMcp::SettingsMcp(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
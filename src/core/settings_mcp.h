@@ -1,9 +1,10 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 
+#include "settingsstore.h"
+
 // MCP server settings: enable, access level, confirmation level, API key.
 class SettingsMcp : public QObject {
     Q_OBJECT
@@ -35,5 +36,5 @@ signals:
     void mcpApiKeyChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 };
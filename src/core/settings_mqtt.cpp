@@ -2,7 +2,7 @@
 
 SettingsMqtt::SettingsMqtt(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 
+#include "settingsstore.h"
+
 class SettingsMqtt : public QObject {
     Q_OBJECT
 
@@ -64,5 +65,5 @@ signals:
     void mqttClientIdChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 };
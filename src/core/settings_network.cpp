@@ -12,7 +12,7 @@
 
 SettingsNetwork::SettingsNetwork(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 #include <QStringList>
 #include <QVariant>
@@ -9,6 +8,8 @@
 #include <QVariantMap>
 #include <QJsonObject>
 
+#include "settingsstore.h"
+
 // Network/web/layout settings: shot server, web security, auto-favorites,
 // saved searches, shot history sort, layout configuration, Discuss-Shot URLs.
 // Split from Settings to keep settings.h's transitive-include footprint small.
@@ -140,7 +141,7 @@ private:
     QString generateItemId(const QString& type) const;
     void invalidateLayoutCache();
 
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
     mutable QJsonObject m_layoutCache;
     mutable QString m_layoutJsonCache;
     mutable bool m_layoutCacheValid = false;
@@ -22,7 +22,7 @@
 
 SettingsTheme::SettingsTheme(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
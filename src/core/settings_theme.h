@@ -1,7 +1,6 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 #include <QStringList>
 #include <QTimer>
@@ -9,8 +8,10 @@
 #include <QVariantMap>
 #include <QJsonObject>
 
+#include "settingsstore.h"
+
 // Theme, color palette, font, shader, and flash settings.
-// Owns its own QSettings instance — same backing store as Settings.
+// Reads and writes the shared SettingsStore — same backing store as Settings.
 class SettingsTheme : public QObject {
     Q_OBJECT
 
@@ -139,7 +140,7 @@ signals:
 private:
     void updateResolvedMode();
 
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
     bool m_isDarkMode = true;
     QString m_editingPalette = "dark";
 
@@ -2,7 +2,7 @@
 
 SettingsVisualizer::SettingsVisualizer(QObject* parent)
     : QObject(parent)
-    , m_settings("DecentEspresso", "DE1Qt")
+    , m_settings(SettingsStore::instance())
 {
 }
 
@@ -93,6 +93,6 @@ void SettingsVisualizer::setDefaultShotRating(int rating) {
         emit defaultShotRatingChanged();
         // Cross-domain side effect (sync dye/espressoEnjoyment so the new default
         // applies to the current shot) is wired in Settings::Settings() via
-        // connect(m_visualizer, &SettingsVisualizer::defaultShotRatingChanged, ...).
+        // addCrossDomainReaction(), and has already run by the time we get here.
     }
 }
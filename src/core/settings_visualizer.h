@@ -1,9 +1,10 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
 #include <QString>
 
+#include "settingsstore.h"
+
 // Visualizer (visualizer.coffee) upload settings + default shot rating.
 class SettingsVisualizer : public QObject {
     Q_OBJECT
@@ -55,5 +56,5 @@ signals:
     void defaultShotRatingChanged();
 
 private:
-    mutable QSettings m_settings;
+    SettingsStore& m_settings;
 };
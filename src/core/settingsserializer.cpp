@@ -378,6 +378,9 @@ QJsonObject SettingsSerializer::exportToJson(Settings* settings, bool includeSen
 bool SettingsSerializer::importFromJson(Settings* settings, const QJsonObject& json,
                                         const QStringList& excludeKeys)
 {
+    // One round of change notifications for the whole import, not one per key
+    Settings::Transaction transaction(settings, QStringLiteral("importFromJson"));
+
     // Machine settings
     if (json.contains("machine") && !excludeKeys.contains("machine")) {
         QJsonObject machine = json["machine"].toObject();
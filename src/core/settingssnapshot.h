@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <algorithm>
+#include <utility>
+
+// Immutable copy of every setting at one point in time, published by
+// SettingsStore at most once per event-loop turn (see SettingsStore::snapshot()).
+//
+// Unlike Settings and its domain objects, a snapshot may be read from any
+// thread: it never changes after construction. The QHash it wraps shares its
+// data with the store's map copy-on-write; the store's next write copies it.
+//
+// Keys and defaults are the ones the domain getters use, e.g.
+//   snapshot->get<double>("dye/beanWeight", 18.0)
+// Values loaded from an INI file are strings until written again; get<T>()
+// converts them the way the getters' toDouble()/toBool() calls do.
+class SettingsSnapshot {
+public:
+    SettingsSnapshot(QHash<QString, QVariant> values, quint64 revision)
+        : m_values(std::move(values))
+        , m_revision(revision)
+    {}
+
+    QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const
+    {
+        const auto it = m_values.constFind(key);
+        return it != m_values.cend() ? it.value() : defaultValue;
+    }
+
+    template <typename T>
+    T get(const QString& key, const T& defaultValue = T()) const
+    {
+        const auto it = m_values.constFind(key);
+        return it != m_values.cend() ? it.value().template value<T>() : defaultValue;
+    }
+
+    bool contains(const QString& key) const { return m_values.contains(key); }
+
+    QStringList allKeys() const
+    {
+        QStringList keys = m_values.keys();
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    // Bumped by each publish; a reader holding an older revision is behind
+    quint64 revision() const { return m_revision; }
+
+private:
+    const QHash<QString, QVariant> m_values;
+    const quint64 m_revision;
+};
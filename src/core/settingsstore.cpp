@@ -0,0 +1,228 @@
+#include "settingsstore.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QThread>
+
+#include <algorithm>
+
+SettingsStore& SettingsStore::instance()
+{
+    static SettingsStore store(QStringLiteral("DecentEspresso"), QStringLiteral("DE1Qt"));
+    // Also flush while the application object still exists on exits that
+    // never emit aboutToQuit (tests, an app that returns from main early)
+    static const bool postRoutineAdded = (qAddPostRoutine([] { store.sync(); }), true);
+    Q_UNUSED(postRoutineAdded);
+    return store;
+}
+
+SettingsStore::SettingsStore(const QString& organization, const QString& application, QObject* parent)
+    : QObject(parent)
+    , m_organization(organization)
+    , m_application(application)
+{
+    load();
+}
+
+SettingsStore::SettingsStore(const QString& fileName, QSettings::Format format, QObject* parent)
+    : QObject(parent)
+    , m_fileName(fileName)
+    , m_format(format)
+{
+    load();
+}
+
+SettingsStore::~SettingsStore()
+{
+    sync();
+}
+
+std::unique_ptr<QSettings> SettingsStore::openBacking() const
+{
+    if (m_fileName.isEmpty())
+        return std::make_unique<QSettings>(m_organization, m_application);
+    return std::make_unique<QSettings>(m_fileName, m_format);
+}
+
+void SettingsStore::load()
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &SettingsStore::flush);
+    m_writer.setMaxThreadCount(1);
+    m_publishTimer.setSingleShot(true);
+    m_publishTimer.setInterval(0);
+    connect(&m_publishTimer, &QTimer::timeout, this, &SettingsStore::publishSnapshot);
+
+    if (auto* app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, &SettingsStore::sync);
+
+    // sync() before reading: on macOS, NSUserDefaults can return stale (empty)
+    // data if another instance of the app just wrote the same plist.
+    auto settings = openBacking();
+    settings->sync();
+    const QStringList keys = settings->allKeys();
+    m_values.reserve(keys.size());
+    for (const QString& key : keys)
+        m_values.insert(key, settings->value(key));
+    publishSnapshot();
+}
+
+QVariant SettingsStore::value(const QString& key, const QVariant& defaultValue) const
+{
+    const auto it = m_values.constFind(key);
+    return it != m_values.cend() ? it.value() : defaultValue;
+}
+
+void SettingsStore::setValue(const QString& key, const QVariant& value)
+{
+    const auto it = m_values.constFind(key);
+    if (it != m_values.cend() && it.value() == value)
+        return;
+    m_values.insert(key, value);
+    m_pendingSets.insert(key, value);
+    ++m_changeCount;
+    schedulePublish();
+    scheduleFlush();
+    emit changed();
+}
+
+bool SettingsStore::contains(const QString& key) const
+{
+    return m_values.contains(key);
+}
+
+void SettingsStore::remove(const QString& key)
+{
+    if (key.isEmpty()) {
+        clear();
+        return;
+    }
+
+    const QString prefix = key + QLatin1Char('/');
+    const auto matches = [&](const QString& k) { return k == key || k.startsWith(prefix); };
+
+    bool removed = false;
+    for (auto it = m_values.begin(); it != m_values.end();) {
+        if (matches(it.key())) {
+            it = m_values.erase(it);
+            removed = true;
+        } else {
+            ++it;
+        }
+    }
+    if (!removed)
+        return;
+
+    for (auto it = m_pendingSets.begin(); it != m_pendingSets.end();) {
+        if (matches(it.key()))
+            it = m_pendingSets.erase(it);
+        else
+            ++it;
+    }
+    m_pendingRemovals.insert(key);
+    ++m_changeCount;
+    schedulePublish();
+    scheduleFlush();
+    emit changed();
+}
+
+void SettingsStore::clear()
+{
+    m_values.clear();
+    m_pendingSets.clear();
+    m_pendingRemovals.clear();
+    m_clearPending = true;
+    ++m_changeCount;
+    schedulePublish();
+    scheduleFlush();
+    emit changed();
+}
+
+QStringList SettingsStore::allKeys() const
+{
+    QStringList keys = m_values.keys();
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+bool SettingsStore::hasPendingWrites() const
+{
+    return m_clearPending || !m_pendingRemovals.isEmpty() || !m_pendingSets.isEmpty();
+}
+
+std::shared_ptr<const SettingsSnapshot> SettingsStore::snapshot()
+{
+    // Other threads must not touch the change counters; they get the last publish
+    if (QThread::currentThread() == thread())
+        publishSnapshot();
+    return std::atomic_load(&m_snapshot);
+}
+
+void SettingsStore::schedulePublish()
+{
+    if (m_snapshotHolds == 0 && !m_publishTimer.isActive())
+        m_publishTimer.start();
+}
+
+void SettingsStore::publishSnapshot()
+{
+    if (m_snapshotHolds > 0 || (m_snapshot && m_publishedChangeCount == m_changeCount))
+        return;
+    m_publishTimer.stop();
+    m_publishedChangeCount = m_changeCount;
+    // Shares m_values' data, so the store's next write copies its map; the
+    // zero-delay timer keeps that to once per event-loop turn
+    std::atomic_store(&m_snapshot, std::shared_ptr<const SettingsSnapshot>(
+        std::make_shared<SettingsSnapshot>(m_values, ++m_snapshotRevision)));
+}
+
+void SettingsStore::releaseSnapshots()
+{
+    if (m_snapshotHolds == 0 || --m_snapshotHolds > 0)
+        return;
+    publishSnapshot();
+}
+
+void SettingsStore::scheduleFlush()
+{
+    // Not restarted by later writes: the first unsaved change bounds the delay
+    if (!m_flushTimer.isActive())
+        m_flushTimer.start();
+}
+
+void SettingsStore::flush()
+{
+    m_flushTimer.stop();
+    if (!hasPendingWrites())
+        return;
+
+    const bool clearFirst = m_clearPending;
+    const QStringList removals = m_pendingRemovals.values();
+    const QHash<QString, QVariant> sets = m_pendingSets;
+    m_clearPending = false;
+    m_pendingRemovals.clear();
+    m_pendingSets.clear();
+
+    m_writer.start([this, clearFirst, removals, sets]() {
+        auto settings = openBacking();
+        if (clearFirst)
+            settings->clear();
+        for (const QString& key : removals)
+            settings->remove(key);
+        for (auto it = sets.cbegin(); it != sets.cend(); ++it)
+            settings->setValue(it.key(), it.value());
+        settings->sync();
+        if (settings->status() != QSettings::NoError) {
+            qWarning() << "SettingsStore: Failed to write" << (removals.size() + sets.size())
+                       << "changed keys to" << settings->fileName() << "status:" << settings->status();
+        }
+        m_batchesWritten.fetch_add(1);
+    });
+}
+
+void SettingsStore::sync()
+{
+    flush();
+    m_writer.waitForDone();
+}
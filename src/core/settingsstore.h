@@ -0,0 +1,128 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QSettings>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
+
+#include "settingssnapshot.h"
+
+#include <atomic>
+#include <memory>
+
+// In-memory, write-back copy of the app's QSettings file, shared by Settings
+// and all of its domain sub-objects (SettingsBrew, SettingsTheme, ...).
+//
+// Reads are hash lookups. Writes update the map, mark the key dirty and arm a
+// short timer; when it fires, every key changed since the last flush goes to
+// disk in one QSettings batch (one sync()) on a background thread. A slider
+// drag, an MCP settings_set burst or a backup restore therefore costs one INI
+// rewrite instead of hundreds. Setting a key to the value it already has is
+// not a change.
+//
+// The timer is armed by the first unsaved change and not restarted by later
+// ones, so a continuous drag still reaches disk every kFlushDelayMs. sync()
+// writes anything pending and waits for it; it runs on app quit, on suspend
+// and from the destructor, so an orderly exit never loses a write.
+//
+// Only keys changed through the store are written, so other QSettings users of
+// the same file (SteamHealthTracker) keep their own keys.
+// Their writes are not seen by the store after load; Settings doesn't read them.
+//
+// API mirrors the subset of QSettings the settings classes use, so they keep
+// their `m_settings.value(...)` / `setValue(...)` call sites. Main thread only,
+// like the QSettings members it replaces, except for snapshot(): changes are
+// published as an immutable SettingsSnapshot that any thread can pick up
+// without locking the store or a round trip through the main thread.
+//
+// A snapshot shares the store's map copy-on-write, so the first write after a
+// publish copies the whole map. Publishing is therefore deferred to a
+// zero-delay timer: a burst of writes in one event-loop turn (a slider drag
+// step, an import) costs one copy, not one per key. snapshot() called on the
+// store's own thread publishes pending changes first, so main-thread callers
+// always get the settings as of the call.
+class SettingsStore : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kFlushDelayMs = 300;
+
+    // The process-wide store for QSettings("DecentEspresso", "DE1Qt")
+    static SettingsStore& instance();
+
+    SettingsStore(const QString& organization, const QString& application, QObject* parent = nullptr);
+    SettingsStore(const QString& fileName, QSettings::Format format, QObject* parent = nullptr);
+    ~SettingsStore() override;
+
+    QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
+    void setValue(const QString& key, const QVariant& value);
+    bool contains(const QString& key) const;
+    // Like QSettings::remove: also removes "key/..." children; "" clears all
+    void remove(const QString& key);
+    void clear();
+    QStringList allKeys() const;
+
+    // Writes pending changes now and blocks until they are on disk
+    void sync();
+
+    bool hasPendingWrites() const;
+    int batchesWritten() const { return m_batchesWritten.load(); }
+    // Writes that changed something (set to a new value, remove, clear)
+    quint64 changeCount() const { return m_changeCount; }
+    void setFlushDelay(int ms) { m_flushTimer.setInterval(ms); }
+
+    // The settings as an immutable snapshot. Safe from any thread; other
+    // threads see the last published one, at most one event-loop turn behind.
+    std::shared_ptr<const SettingsSnapshot> snapshot();
+
+    // Between hold and release, changes are not published; release publishes
+    // them at once, as one snapshot. Settings transactions use this so readers on
+    // other threads never see half a theme or half a restored backup. Nests.
+    void holdSnapshots() { ++m_snapshotHolds; }
+    void releaseSnapshots();
+
+signals:
+    // After every write that changed something, never blocked or deferred.
+    // Settings runs its cross-domain reactions from it, so they follow each
+    // write in order even inside a transaction.
+    void changed();
+
+private:
+    void load();
+    void scheduleFlush();
+    void flush();
+    void schedulePublish();
+    void publishSnapshot();
+    std::unique_ptr<QSettings> openBacking() const;
+
+    const QString m_organization;
+    const QString m_application;
+    const QString m_fileName;
+    const QSettings::Format m_format = QSettings::NativeFormat;
+
+    QHash<QString, QVariant> m_values;
+
+    // Changes since the last flush. Applied as clear, then removals, then
+    // sets, which is the order that reproduces any sequence of calls.
+    bool m_clearPending = false;
+    QSet<QString> m_pendingRemovals;
+    QHash<QString, QVariant> m_pendingSets;
+
+    quint64 m_changeCount = 0;
+
+    // Replaced with std::atomic_store; other threads read it with atomic_load
+    std::shared_ptr<const SettingsSnapshot> m_snapshot;
+    quint64 m_snapshotRevision = 0;
+    quint64 m_publishedChangeCount = 0;  // changeCount() at the last publish
+    int m_snapshotHolds = 0;
+
+    QTimer m_publishTimer;  // Zero delay: one publish per event-loop turn
+    QTimer m_flushTimer;
+    QThreadPool m_writer;  // One thread, so batches land in order
+    std::atomic<int> m_batchesWritten{0};
+};
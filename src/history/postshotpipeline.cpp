@@ -0,0 +1,265 @@
+#include "postshotpipeline.h"
+#include "shothistorystorage.h"
+#include "shothistorystorage_internal.h"
+#include "history/shotbadgeprojection.h"
+#include "ai/shotanalysis.h"
+#include "ai/shotsummarizer.h"
+#include "profile/profile.h"
+#include "network/visualizeruploader.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QThread>
+#include <QUuid>
+
+using decenza::storage::detail::AnalysisInputs;
+using decenza::storage::detail::prepareAnalysisInputs;
+
+PostShotPipeline::PostShotPipeline(ShotHistoryStorage* storage, QObject* parent)
+    : QObject(parent)
+    , m_storage(storage)
+{
+}
+
+PostShotPipeline::~PostShotPipeline()
+{
+    *m_destroyed = true;
+}
+
+ShotSaveData PostShotPipeline::makeSaveData(const Profile* profile,
+                                            double duration,
+                                            double finalWeight,
+                                            double doseWeight,
+                                            const ShotMetadata& metadata,
+                                            const QString& debugLog,
+                                            double temperatureOverride,
+                                            double yieldOverride)
+{
+    ShotSaveData data;
+    data.uuid = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    data.timestamp = QDateTime::currentSecsSinceEpoch();
+    data.profileName = profile ? profile->title() : QStringLiteral("Unknown");
+    data.profileJson = profile ? QString::fromUtf8(profile->toJson().toJson(QJsonDocument::Compact)) : QString();
+    data.beverageType = profile ? profile->beverageType() : QStringLiteral("espresso");
+    data.duration = duration;
+    data.finalWeight = finalWeight;
+    data.doseWeight = doseWeight;
+    data.temperatureOverride = temperatureOverride;
+    data.yieldOverride = yieldOverride;
+    data.beanBrand = metadata.beanBrand;
+    data.beanType = metadata.beanType;
+    data.roastDate = metadata.roastDate;
+    data.roastLevel = metadata.roastLevel;
+    data.grinderBrand = metadata.grinderBrand;
+    data.grinderModel = metadata.grinderModel;
+    data.grinderBurrs = metadata.grinderBurrs;
+    data.grinderSetting = metadata.grinderSetting;
+    data.drinkTds = metadata.drinkTds;
+    data.drinkEy = metadata.drinkEy;
+    data.espressoEnjoyment = metadata.espressoEnjoyment;
+    data.espressoNotes = metadata.espressoNotes;
+    data.barista = metadata.barista;
+    data.profileNotes = profile ? profile->profileNotes() : QString();
+    data.debugLog = debugLog;
+
+    if (profile) {
+        data.profileKbId = ShotSummarizer::computeProfileKbId(profile->title(), profile->editorType());
+    }
+    return data;
+}
+
+void PostShotPipeline::runStage(Stage stage, Job& job, StageOutput& out, const QString& dbPath)
+{
+    ShotSnapshot& shot = job.snapshot;
+    ShotSaveData& data = job.save;
+
+    switch (stage) {
+    case Stage::TrimSettling:
+        // Must run before smoothing — smoothWeightFlowRate() snapshots the raw
+        // weight-flow series, and neither copy should include settling zeros.
+        if (job.processSeries)
+            shot.trimSettlingData();
+        break;
+
+    case Stage::SmoothWeightFlow:
+        // Centered moving average (window=5, ≈ 2.2s at 5Hz). The raw LSLR data has
+        // staircase artifacts from 0.1g scale quantization; this matches de1app's
+        // smoothing level for storage and visualizer export.
+        if (job.processSeries)
+            shot.smoothWeightFlowRate();
+        break;
+
+    case Stage::ConductanceDerivative:
+        shot.computeConductanceDerivative();
+        break;
+
+    case Stage::PhaseSummaries: {
+        ShotRecord tmpRecord;
+        tmpRecord.pressure = shot.pressure;
+        tmpRecord.flow = shot.flow;
+        tmpRecord.temperature = shot.temperature;
+        tmpRecord.weight = shot.cumulativeWeight;
+        tmpRecord.phases = shot.phases;
+        ShotHistoryStorage::computePhaseSummaries(tmpRecord);
+        data.phaseSummariesJson = tmpRecord.phaseSummariesJson;
+        data.phaseMarkers = shot.phases;
+        break;
+    }
+
+    case Stage::Analysis: {
+        // All five quality badges come from a single ShotAnalysis::analyzeShot
+        // pass projected through decenza::deriveBadgesFromAnalysis, so the
+        // save-time, load-time and dialog/AI/MCP cascades share one pipeline.
+        // See docs/SHOT_REVIEW.md §4 for the mapping table.
+        const AnalysisInputs inputs = prepareAnalysisInputs(data.profileKbId, data.profileJson);
+        out.analysis = ShotAnalysis::analyzeShot(
+            shot.pressure, shot.flow,
+            shot.cumulativeWeight,
+            shot.temperature, shot.temperatureGoal,
+            shot.conductanceDerivative,
+            shot.phases, data.beverageType, data.duration,
+            shot.pressureGoal(), shot.flowGoal(),
+            inputs.analysisFlags, inputs.firstFrameSeconds,
+            data.yieldOverride, data.finalWeight,
+            inputs.frameCount);
+        decenza::applyBadgesToTarget(data, out.analysis.detectors);
+        break;
+    }
+
+    case Stage::Compress:
+        data.compressedSamples = ShotHistoryStorage::compressSampleData(shot, data.phaseSummariesJson);
+        data.sampleCount = static_cast<int>(shot.pressure.size());
+        break;
+
+    case Stage::Save:
+        out.shotId = ShotHistoryStorage::saveShotStatic(dbPath, data);
+        break;
+
+    case Stage::Idle:
+    case Stage::PublishSeries:
+        break;
+    }
+}
+
+QVariantMap PostShotPipeline::badgesToVariantMap(const ShotSaveData& save)
+{
+    QVariantMap badges;
+    badges["channelingDetected"] = save.channelingDetected;
+    badges["temperatureUnstable"] = save.temperatureUnstable;
+    badges["grindIssueDetected"] = save.grindIssueDetected;
+    badges["skipFirstFrameDetected"] = save.skipFirstFrameDetected;
+    badges["pourTruncatedDetected"] = save.pourTruncatedDetected;
+    return badges;
+}
+
+void PostShotPipeline::submit(Job job)
+{
+    m_queue.enqueue(std::move(job));
+    startNext();
+}
+
+void PostShotPipeline::startNext()
+{
+    if (m_busy || m_queue.isEmpty())
+        return;
+
+    m_busy = true;
+    emit busyChanged();
+    runOnWorker(m_queue.dequeue(),
+                {Stage::TrimSettling, Stage::SmoothWeightFlow, Stage::ConductanceDerivative});
+}
+
+void PostShotPipeline::runOnWorker(Job job, QList<Stage> stages)
+{
+    const QString dbPath = m_storage ? m_storage->databasePath() : QString();
+    auto destroyed = m_destroyed;
+
+    QThread* thread = QThread::create([this, destroyed, dbPath, stages, job = std::move(job)]() mutable {
+        StageOutput out;
+        for (Stage stage : stages) {
+            runStage(stage, job, out, dbPath);
+
+            if (*destroyed) return;
+            QVariantMap badges;
+            if (stage == Stage::Analysis)
+                badges = badgesToVariantMap(job.save);
+            QMetaObject::invokeMethod(this, [this, destroyed, stage, badges,
+                                             lines = stage == Stage::Analysis ? out.analysis.lines : QVariantList(),
+                                             verdict = out.analysis.detectors.verdictCategory]() {
+                if (*destroyed) return;
+                setStage(stage);
+                if (stage == Stage::Analysis)
+                    emit analysisReady(lines, verdict, badges);
+            }, Qt::QueuedConnection);
+        }
+
+        if (*destroyed) return;
+        const Stage lastStage = stages.isEmpty() ? Stage::Idle : stages.last();
+        QMetaObject::invokeMethod(this, [this, destroyed, job, out, lastStage]() {
+            if (*destroyed) {
+                qDebug() << "PostShotPipeline: worker result dropped (object destroyed)";
+                return;
+            }
+            onWorkerLegDone(job, out, lastStage);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
+
+void PostShotPipeline::onWorkerLegDone(Job job, StageOutput out, Stage lastStage)
+{
+    if (lastStage == Stage::ConductanceDerivative) {
+        publishSeries(std::move(job));
+        return;
+    }
+
+    // Save leg finished
+    if (m_storage) {
+        m_storage->completeShotSave(out.shotId, job.save.profileName, job.save.duration,
+                                    job.save.sampleCount, job.save.compressedSamples.size());
+    }
+    finishJob(out.shotId);
+}
+
+void PostShotPipeline::publishSeries(Job job)
+{
+    setStage(Stage::PublishSeries);
+    if (job.onSeriesReady)
+        job.onSeriesReady(job.snapshot, job.save);
+
+    if (!job.persist) {
+        finishJob(0);
+        return;
+    }
+
+    if (!m_storage || !m_storage->acceptingSaves()) {
+        qWarning() << "PostShotPipeline: Cannot save shot - history not ready or backup in progress";
+        if (m_storage)
+            m_storage->completeShotSave(-1, job.save.profileName, job.save.duration, 0, 0);
+        finishJob(-1);
+        return;
+    }
+
+    runOnWorker(std::move(job),
+                {Stage::PhaseSummaries, Stage::Analysis, Stage::Compress, Stage::Save});
+}
+
+void PostShotPipeline::finishJob(qint64 shotId)
+{
+    setStage(Stage::Idle);
+    m_busy = false;
+    emit busyChanged();
+    emit jobFinished(shotId);
+    startNext();
+}
+
+void PostShotPipeline::setStage(Stage stage)
+{
+    if (m_stage == stage)
+        return;
+    m_stage = stage;
+    emit stageChanged(stage);
+}
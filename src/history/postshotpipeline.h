@@ -0,0 +1,113 @@
+#pragma once
+
+#include "shotsnapshot.h"
+#include "shothistory_types.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QVariantList>
+#include <QVariantMap>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class ShotHistoryStorage;
+class Profile;
+struct ShotMetadata;
+
+// Post-shot processing expressed as an ordered list of stages over an
+// immutable ShotSnapshot. MainController captures the snapshot when the shot
+// ends (implicitly-shared copies, no sample walking on the GUI thread) and
+// submits it here; settling trim, smoothing, dC/dt, phase summaries, the
+// analyzeShot pass, blob compression and the DB insert all run on a worker.
+//
+// One stage runs on the main thread: PublishSeries hands the processed curves
+// back through Job::onSeriesReady so the live graph, auto flow calibration and
+// the visualizer upload see exactly the data that gets saved, and so the
+// caller can attach late inputs (the debug log) before the save stages run.
+//
+// Results are published as each stage finishes: stageChanged() for progress,
+// analysisReady() for the summary lines and badges, and — through
+// ShotHistoryStorage::completeShotSave() — shotSaved() with the new ID.
+// Jobs run one at a time in submission order.
+class PostShotPipeline : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Stage {
+        Idle,
+        TrimSettling,
+        SmoothWeightFlow,
+        ConductanceDerivative,
+        PublishSeries,          // main thread
+        PhaseSummaries,
+        Analysis,
+        Compress,
+        Save,
+    };
+    Q_ENUM(Stage)
+
+    struct Job {
+        ShotSnapshot snapshot;
+        ShotSaveData save;            // Metadata; sample-derived fields are filled by the stages
+        bool processSeries = true;    // false: skip settling trim + smoothing (simulated shots)
+        bool persist = true;          // false: stop after PublishSeries (discarded shot, or a save already in flight)
+
+        // Runs on the main thread once the series stages are done. May fill
+        // late fields on `save` (e.g. debugLog) before the save stages start.
+        std::function<void(const ShotSnapshot& processed, ShotSaveData& save)> onSeriesReady;
+    };
+
+    explicit PostShotPipeline(ShotHistoryStorage* storage, QObject* parent = nullptr);
+    ~PostShotPipeline() override;
+
+    void submit(Job job);
+    bool isBusy() const { return m_busy; }
+    Stage currentStage() const { return m_stage; }
+
+    // Build the metadata half of a ShotSaveData on the main thread (reads the
+    // Profile, which is not thread-safe). Sample-derived fields stay empty.
+    static ShotSaveData makeSaveData(const Profile* profile,
+                                     double duration,
+                                     double finalWeight,
+                                     double doseWeight,
+                                     const ShotMetadata& metadata,
+                                     const QString& debugLog,
+                                     double temperatureOverride,
+                                     double yieldOverride);
+
+    // Stage bodies. Pure functions of the job — exposed so tests can drive a
+    // single stage without threads. `dbPath` is only read by Stage::Save.
+    struct StageOutput {
+        ShotAnalysis::AnalysisResult analysis;
+        qint64 shotId = -1;
+    };
+    static void runStage(Stage stage, Job& job, StageOutput& out, const QString& dbPath = QString());
+
+    static QVariantMap badgesToVariantMap(const ShotSaveData& save);
+
+signals:
+    void stageChanged(PostShotPipeline::Stage stage);
+    void busyChanged();
+    void analysisReady(const QVariantList& summaryLines, const QString& verdictCategory,
+                       const QVariantMap& badges);
+    void jobFinished(qint64 shotId);  // -1 on failure, 0 when the job did not persist
+
+private:
+    void startNext();
+    void runOnWorker(Job job, QList<Stage> stages);
+    void onWorkerLegDone(Job job, StageOutput out, Stage lastStage);
+    void publishSeries(Job job);
+    void finishJob(qint64 shotId);
+    void setStage(Stage stage);
+
+    QPointer<ShotHistoryStorage> m_storage;
+    QQueue<Job> m_queue;
+    bool m_busy = false;
+    Stage m_stage = Stage::Idle;
+
+    // Same destroyed-flag pattern as ShotHistoryStorage: written on the main
+    // thread in the destructor, read by worker lambdas before posting back.
+    std::shared_ptr<std::atomic<bool>> m_destroyed = std::make_shared<std::atomic<bool>>(false);
+};
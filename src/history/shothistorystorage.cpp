@@ -1,11 +1,13 @@
 #include "shothistorystorage.h"
 #include "shothistorystorage_internal.h"
 #include "ai/conductance.h"
+#include "ai/curveindex.h"
 #include "ai/shotanalysis.h"
 #include "ai/shotsummarizer.h"
 #include "history/shotbadgeprojection.h"
+#include "history/shotrecordcache.h"
 #include "core/grinderaliases.h"
-#include "models/shotdatamodel.h"
+#include "history/shotsnapshot.h"
 #include "profile/profile.h"
 #include "network/visualizeruploader.h"
 
@@ -39,7 +41,26 @@ const QString ShotHistoryStorage::DB_CONNECTION_NAME = "ShotHistoryConnection";
 
 ShotHistoryStorage::ShotHistoryStorage(QObject* parent)
     : QObject(parent)
+    , m_recordCache(std::make_shared<ShotRecordCache>())
 {
+    // Every write path (including ShotServer and MCP edits) reports through
+    // these signals, so they are the one place the decoded-shot cache is kept honest.
+    auto cache = m_recordCache;
+    connect(this, &ShotHistoryStorage::shotMetadataUpdated, this, [cache](qint64 shotId, bool) {
+        cache->invalidate(shotId);
+    });
+    connect(this, &ShotHistoryStorage::visualizerInfoUpdated, this, [cache](qint64 shotId, bool) {
+        cache->invalidate(shotId);
+    });
+    connect(this, &ShotHistoryStorage::shotDeleted, this, [cache](qint64 shotId) {
+        cache->invalidate(shotId);
+    });
+    connect(this, &ShotHistoryStorage::grinderFieldsUpdated, this, [cache]() {
+        cache->invalidateAll();
+    });
+    connect(this, &ShotHistoryStorage::importDatabaseFinished, this, [cache]() {
+        cache->invalidateAll();
+    });
 }
 
 ShotHistoryStorage::~ShotHistoryStorage()
@@ -50,6 +71,7 @@ ShotHistoryStorage::~ShotHistoryStorage()
 
 void ShotHistoryStorage::close()
 {
+    m_recordCache->invalidateAll();
     if (m_db.isOpen()) {
         m_db.close();
     }
@@ -755,32 +777,32 @@ QJsonObject ShotHistoryStorage::pointsToJsonObject(const QVector<QPointF>& point
     return obj;
 }
 
-QByteArray ShotHistoryStorage::compressSampleData(ShotDataModel* shotData, const QString& phaseSummariesJson)
+QByteArray ShotHistoryStorage::compressSampleData(const ShotSnapshot& shot, const QString& phaseSummariesJson)
 {
     QJsonObject root;
 
-    root["pressure"] = pointsToJsonObject(shotData->pressureData());
-    root["flow"] = pointsToJsonObject(shotData->flowData());
-    root["temperature"] = pointsToJsonObject(shotData->temperatureData());
-    root["pressureGoal"] = pointsToJsonObject(shotData->pressureGoalData());
-    root["flowGoal"] = pointsToJsonObject(shotData->flowGoalData());
-    root["temperatureGoal"] = pointsToJsonObject(shotData->temperatureGoalData());
+    root["pressure"] = pointsToJsonObject(shot.pressure);
+    root["flow"] = pointsToJsonObject(shot.flow);
+    root["temperature"] = pointsToJsonObject(shot.temperature);
+    root["pressureGoal"] = pointsToJsonObject(shot.pressureGoal());
+    root["flowGoal"] = pointsToJsonObject(shot.flowGoal());
+    root["temperatureGoal"] = pointsToJsonObject(shot.temperatureGoal);
 
-    root["temperatureMix"] = pointsToJsonObject(shotData->temperatureMixData());
-    root["resistance"] = pointsToJsonObject(shotData->resistanceData());
-    root["conductance"] = pointsToJsonObject(shotData->conductanceData());
-    root["darcyResistance"] = pointsToJsonObject(shotData->darcyResistanceData());
-    root["conductanceDerivative"] = pointsToJsonObject(shotData->conductanceDerivativeData());
-    root["waterDispensed"] = pointsToJsonObject(shotData->waterDispensedData());
+    root["temperatureMix"] = pointsToJsonObject(shot.temperatureMix);
+    root["resistance"] = pointsToJsonObject(shot.resistance);
+    root["conductance"] = pointsToJsonObject(shot.conductance);
+    root["darcyResistance"] = pointsToJsonObject(shot.darcyResistance);
+    root["conductanceDerivative"] = pointsToJsonObject(shot.conductanceDerivative);
+    root["waterDispensed"] = pointsToJsonObject(shot.waterDispensed);
 
     // Weight data - store cumulative weight for history
-    root["weight"] = pointsToJsonObject(shotData->cumulativeWeightData());
+    root["weight"] = pointsToJsonObject(shot.cumulativeWeight);
     // Also store flow rate from scale for future graph display
-    root["weightFlow"] = pointsToJsonObject(shotData->weightData());
+    root["weightFlow"] = pointsToJsonObject(shot.weight);
     // Weight-based flow rate (g/s) for visualizer export
-    root["weightFlowRate"] = pointsToJsonObject(shotData->weightFlowRateData());
+    root["weightFlowRate"] = pointsToJsonObject(shot.weightFlowRate);
 
-    // Phase summaries for UI display (pre-computed by saveShot() via computePhaseSummaries)
+    // Phase summaries for UI display (pre-computed by the PostShotPipeline PhaseSummaries stage)
     if (!phaseSummariesJson.isEmpty()) {
         root["phaseSummaries"] = QJsonDocument::fromJson(phaseSummariesJson.toUtf8()).array();
     }
@@ -841,164 +863,28 @@ void ShotHistoryStorage::decompressSampleData(const QByteArray& blob, ShotRecord
     }
 }
 
-qint64 ShotHistoryStorage::saveShot(ShotDataModel* shotData,
-                                     const Profile* profile,
-                                     double duration,
-                                     double finalWeight,
-                                     double doseWeight,
-                                     const ShotMetadata& metadata,
-                                     const QString& debugLog,
-                                     double temperatureOverride,
-                                     double yieldOverride)
+bool ShotHistoryStorage::acceptingSaves() const
 {
-    if (!m_ready || m_backupInProgress || !shotData) {
-        qWarning() << "ShotHistoryStorage: Cannot save shot - not ready, backup in progress, or no data";
-        emit shotSaved(-1);
-        return -1;
-    }
-
-    // Extract all data from QObject pointers on the main thread into a plain value struct
-    ShotSaveData data;
-    data.uuid = QUuid::createUuid().toString(QUuid::WithoutBraces);
-    data.timestamp = QDateTime::currentSecsSinceEpoch();
-    data.profileName = profile ? profile->title() : QStringLiteral("Unknown");
-    data.profileJson = profile ? QString::fromUtf8(profile->toJson().toJson(QJsonDocument::Compact)) : QString();
-    data.beverageType = profile ? profile->beverageType() : QStringLiteral("espresso");
-    data.duration = duration;
-    data.finalWeight = finalWeight;
-    data.doseWeight = doseWeight;
-    data.temperatureOverride = temperatureOverride;
-    data.yieldOverride = yieldOverride;
-    data.beanBrand = metadata.beanBrand;
-    data.beanType = metadata.beanType;
-    data.roastDate = metadata.roastDate;
-    data.roastLevel = metadata.roastLevel;
-    data.grinderBrand = metadata.grinderBrand;
-    data.grinderModel = metadata.grinderModel;
-    data.grinderBurrs = metadata.grinderBurrs;
-    data.grinderSetting = metadata.grinderSetting;
-    data.drinkTds = metadata.drinkTds;
-    data.drinkEy = metadata.drinkEy;
-    data.espressoEnjoyment = metadata.espressoEnjoyment;
-    data.espressoNotes = metadata.espressoNotes;
-    data.barista = metadata.barista;
-    data.profileNotes = profile ? profile->profileNotes() : QString();
-    data.debugLog = debugLog;
-
-    if (profile) {
-        data.profileKbId = ShotSummarizer::computeProfileKbId(profile->title(), profile->editorType());
-    }
-
-    // Compute conductance derivative (post-shot Gaussian smoothing) before compression
-    shotData->computeConductanceDerivative();
-
-    // Compute quality flags and phase summaries. Uses ShotSummarizer::getAnalysisFlags()
-    // for KB flag lookups and ShotAnalysis helpers for detection. Runs on the main
-    // thread before data is handed to the background save thread.
-    // Build a temporary ShotRecord from the live data to reuse the static helpers.
-    {
-        ShotRecord tmpRecord;
-        tmpRecord.pressure = shotData->pressureData();
-        tmpRecord.flow = shotData->flowData();
-        tmpRecord.temperature = shotData->temperatureData();
-        tmpRecord.weight = shotData->cumulativeWeightData();
-
-        // Extract phase markers into the record
-        QVariantList tmpMarkers = shotData->phaseMarkersVariant();
-        for (const QVariant& mv : tmpMarkers) {
-            QVariantMap m = mv.toMap();
-            HistoryPhaseMarker pm;
-            pm.time = m["time"].toDouble();
-            pm.label = m["label"].toString();
-            pm.frameNumber = m["frameNumber"].toInt();
-            pm.isFlowMode = m["isFlowMode"].toBool();
-            pm.transitionReason = m["transitionReason"].toString();
-            tmpRecord.phases.append(pm);
-        }
-
-        // Compute phase summaries
-        computePhaseSummaries(tmpRecord);
-        data.phaseSummariesJson = tmpRecord.phaseSummariesJson;
-
-        // Compute all five quality badges via a single ShotAnalysis::analyzeShot
-        // pass and project the booleans from DetectorResults using the
-        // documented mapping. This unifies the save-time, load-time, and
-        // dialog/AI/MCP cascades on one pipeline — the cascade lives in exactly
-        // one place (analyzeShot's body). See docs/SHOT_REVIEW.md §4 for the
-        // full mapping table and decenza::deriveBadgesFromAnalysis (in
-        // history/shotbadgeprojection.h) for the projection rules.
-        const AnalysisInputs inputs = prepareAnalysisInputs(data.profileKbId, data.profileJson);
-        const auto analysis = ShotAnalysis::analyzeShot(
-            tmpRecord.pressure, shotData->flowData(),
-            shotData->cumulativeWeightData(),
-            shotData->temperatureData(), shotData->temperatureGoalData(),
-            shotData->conductanceDerivativeData(),
-            tmpRecord.phases, data.beverageType, duration,
-            shotData->pressureGoalData(), shotData->flowGoalData(),
-            inputs.analysisFlags, inputs.firstFrameSeconds,
-            data.yieldOverride, data.finalWeight,
-            inputs.frameCount);
-        decenza::applyBadgesToTarget(data, analysis.detectors);
-    }
-
-    // Compress sample data on main thread (reads QObject data vectors)
-    data.compressedSamples = compressSampleData(shotData, data.phaseSummariesJson);
-    data.sampleCount = static_cast<int>(shotData->pressureData().size());
+    return m_ready && !m_backupInProgress;
+}
 
-    // Extract phase markers on main thread
-    QVariantList markers = shotData->phaseMarkersVariant();
-    for (const QVariant& markerVar : markers) {
-        QVariantMap marker = markerVar.toMap();
-        HistoryPhaseMarker pm;
-        pm.time = marker["time"].toDouble();
-        pm.label = marker["label"].toString();
-        pm.frameNumber = marker["frameNumber"].toInt();
-        pm.isFlowMode = marker["isFlowMode"].toBool();
-        pm.transitionReason = marker["transitionReason"].toString();
-        data.phaseMarkers.append(pm);
+void ShotHistoryStorage::completeShotSave(qint64 shotId, const QString& profileName,
+                                          double duration, int sampleCount, qsizetype compressedSize)
+{
+    if (shotId > 0) {
+        m_lastSavedShotId = shotId;
+        refreshTotalShots();  // already calls invalidateDistinctCache() internally
+
+        qDebug() << "ShotHistoryStorage: Saved shot" << shotId
+                 << "- Profile:" << profileName
+                 << "- Duration:" << duration << "s"
+                 << "- Samples:" << sampleCount
+                 << "- Compressed size:" << compressedSize << "bytes";
+    } else {
+        emit errorOccurred("Failed to save shot to database");
     }
 
-    // Run DB work on background thread
-    const QString dbPath = m_dbPath;
-    auto destroyed = m_destroyed;
-    QThread* thread = QThread::create([this, dbPath, data = std::move(data), destroyed]() {
-        qint64 shotId = saveShotStatic(dbPath, data);
-
-        // Capture only the fields needed for logging (avoid copying the large compressedSamples blob)
-        QString profileName = data.profileName;
-        double duration = data.duration;
-        int sampleCount = data.sampleCount;
-        qsizetype compressedSize = data.compressedSamples.size();
-
-        if (*destroyed) return;
-        QMetaObject::invokeMethod(this, [this, shotId, destroyed,
-                                         profileName, duration, sampleCount, compressedSize]() {
-            if (*destroyed) {
-                qDebug() << "ShotHistoryStorage: saveShot callback dropped (object destroyed)";
-                return;
-            }
-
-            if (shotId > 0) {
-                m_lastSavedShotId = shotId;
-                refreshTotalShots();  // already calls invalidateDistinctCache() internally
-
-                qDebug() << "ShotHistoryStorage: Saved shot" << shotId
-                         << "- Profile:" << profileName
-                         << "- Duration:" << duration << "s"
-                         << "- Samples:" << sampleCount
-                         << "- Compressed size:" << compressedSize << "bytes";
-            } else {
-                emit errorOccurred("Failed to save shot to database");
-            }
-
-            emit shotSaved(shotId);
-        }, Qt::QueuedConnection);
-    });
-
-    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
-    thread->start();
-
-    return 0;  // Async — actual shotId delivered via shotSaved signal
+    emit shotSaved(shotId);
 }
 
 qint64 ShotHistoryStorage::saveShotStatic(const QString& dbPath, const ShotSaveData& data)
@@ -1201,15 +1087,28 @@ void ShotHistoryStorage::requestShot(qint64 shotId)
         return;
     }
 
+    // Cache hit: still answer asynchronously, as callers expect
+    if (auto cached = m_recordCache->find(shotId)) {
+        auto destroyed = m_destroyed;
+        QMetaObject::invokeMethod(this, [this, shotId, cached, destroyed]() {
+            if (*destroyed) return;
+            emit shotReady(shotId, convertShotRecord(*cached));
+        }, Qt::QueuedConnection);
+        return;
+    }
+
     const QString dbPath = m_dbPath;
+    auto cache = m_recordCache;
+    const quint64 revision = cache->revision(shotId);
 
     auto destroyed = m_destroyed;
-    QThread* thread = QThread::create([this, dbPath, shotId, destroyed]() {
+    QThread* thread = QThread::create([this, dbPath, shotId, destroyed, cache, revision]() {
         ShotRecord record;
         bool badgesPersisted = false;
         withTempDb(dbPath, "shs_shot", [&](QSqlDatabase& db) {
             record = loadShotRecordStatic(db, shotId, &badgesPersisted);
         });
+        cache->insert(revision, std::make_shared<const ShotRecord>(record));
 
         // Convert to QVariantMap on main thread (touches QML-visible data).
         // shotReady carries the recomputed badges already; shotBadgesUpdated
@@ -1308,28 +1207,10 @@ void ShotHistoryStorage::computeDerivedCurves(ShotRecord& record)
 
 void ShotHistoryStorage::computePhaseSummaries(ShotRecord& record)
 {
-    // Helper: average Y values in a time range
-    auto avgInRange = [](const QVector<QPointF>& data, double t0, double t1) {
-        double sum = 0;
-        int count = 0;
-        for (const auto& p : data) {
-            if (p.x() >= t0 && p.x() <= t1) {
-                sum += p.y();
-                ++count;
-            }
-        }
-        return count > 0 ? sum / count : 0.0;
-    };
-
-    // Helper: find Y value at or near a time
-    auto valueAtTime = [](const QVector<QPointF>& data, double t) {
-        if (data.isEmpty()) return 0.0;
-        for (qsizetype i = 0; i < data.size(); ++i) {
-            if (data[i].x() >= t)
-                return data[i].y();
-        }
-        return data.last().y();
-    };
+    // Every phase averages the same three curves: index them once
+    const CurveIndex pressure(record.pressure);
+    const CurveIndex flow(record.flow);
+    const CurveIndex temperature(record.temperature);
 
     // Build phase boundaries from markers
     struct PhaseBound { QString name; double start; double end; bool isFlowMode; };
@@ -1362,12 +1243,12 @@ void ShotHistoryStorage::computePhaseSummaries(ShotRecord& record)
         QJsonObject phaseObj;
         phaseObj["name"] = b.name;
         phaseObj["duration"] = qRound((b.end - b.start) * 10.0) / 10.0;
-        phaseObj["avgPressure"] = qRound(avgInRange(record.pressure, b.start, b.end) * 10.0) / 10.0;
-        phaseObj["avgFlow"] = qRound(avgInRange(record.flow, b.start, b.end) * 10.0) / 10.0;
-        phaseObj["avgTemperature"] = qRound(avgInRange(record.temperature, b.start, b.end) * 10.0) / 10.0;
+        phaseObj["avgPressure"] = qRound(pressure.mean(b.start, b.end) * 10.0) / 10.0;
+        phaseObj["avgFlow"] = qRound(flow.mean(b.start, b.end) * 10.0) / 10.0;
+        phaseObj["avgTemperature"] = qRound(temperature.mean(b.start, b.end) * 10.0) / 10.0;
 
-        double w0 = valueAtTime(record.weight, b.start);
-        double w1 = valueAtTime(record.weight, b.end);
+        double w0 = CurveIndex::valueAtOrAfter(record.weight, b.start);
+        double w1 = CurveIndex::valueAtOrAfter(record.weight, b.end);
         phaseObj["weightGained"] = qRound((w1 - w0) * 10.0) / 10.0;
         phaseObj["isFlowMode"] = b.isFlowMode;
         phasesArray.append(phaseObj);
@@ -1377,6 +1258,20 @@ void ShotHistoryStorage::computePhaseSummaries(ShotRecord& record)
         QJsonDocument(phasesArray).toJson(QJsonDocument::Compact));
 }
 
+std::shared_ptr<const ShotRecord> ShotHistoryStorage::loadShotRecordCached(QSqlDatabase& db, qint64 shotId,
+                                                                            ShotRecordCache* cache)
+{
+    if (!cache)
+        return std::make_shared<const ShotRecord>(loadShotRecordStatic(db, shotId));
+    if (auto cached = cache->find(shotId))
+        return cached;
+
+    const quint64 revision = cache->revision(shotId);
+    auto record = std::make_shared<const ShotRecord>(loadShotRecordStatic(db, shotId));
+    cache->insert(revision, record);
+    return record;
+}
+
 ShotRecord ShotHistoryStorage::loadShotRecordStatic(QSqlDatabase& db, qint64 shotId,
                                                      bool* outBadgesPersisted)
 {
@@ -1588,6 +1483,8 @@ bool ShotHistoryStorage::deleteShot(qint64 shotId)
         return false;
     }
 
+    m_recordCache->invalidate(shotId);
+
     // Note: no updateTotalShots()/invalidateDistinctCache()/shotDeleted() here.
     // This method is only called from importShotRecord() during overwrite, which
     // handles refresh via ShotImporter::refreshTotalShots() after the full batch.
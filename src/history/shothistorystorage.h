@@ -15,7 +15,9 @@ class QThread;
 
 class ShotDataModel;
 class Profile;
+class ShotRecordCache;
 struct ShotMetadata;
+struct ShotSnapshot;
 
 class ShotHistoryStorage : public QObject {
     Q_OBJECT
@@ -34,18 +36,18 @@ public:
     int totalShots() const { return m_totalShots; }
     bool loadingFiltered() const { return m_loadingFiltered; }
 
-    // Save a completed shot (async). Extracts data on main thread, runs DB work on background thread.
-    // Returns 0 if async save started, -1 if preconditions not met (shotSaved(-1) also emitted).
-    // Actual shot ID delivered via shotSaved() signal.
-    qint64 saveShot(ShotDataModel* shotData,
-                    const Profile* profile,
-                    double duration,
-                    double finalWeight,
-                    double doseWeight,
-                    const ShotMetadata& metadata,
-                    const QString& debugLog,
-                    double temperatureOverride,
-                    double yieldOverride);
+    // Shot saving is driven by PostShotPipeline: its worker builds a complete
+    // ShotSaveData from a ShotSnapshot and calls saveShotStatic(); the main-thread
+    // tail of the job reports back through completeShotSave(), which updates the
+    // totals and emits shotSaved(). acceptingSaves() is the precondition the
+    // pipeline checks before its Save stage (ready and no backup in progress).
+    bool acceptingSaves() const;
+    void completeShotSave(qint64 shotId, const QString& profileName,
+                          double duration, int sampleCount, qsizetype compressedSize);
+
+    // Serialize + qCompress the sample series of a finished shot into the
+    // shot_samples blob format. Pure function of its inputs — safe off the main thread.
+    static QByteArray compressSampleData(const ShotSnapshot& shot, const QString& phaseSummariesJson = QString());
 
     // Async: runs update on background thread, emits visualizerInfoUpdated()
     Q_INVOKABLE void requestUpdateVisualizerInfo(qint64 shotId,
@@ -55,9 +57,15 @@ public:
     // Async: runs SQL on a background thread and emits shotsFilteredReady()
     Q_INVOKABLE void requestShotsFiltered(const QVariantMap& filter, int offset = 0, int limit = 50);
 
-    // Async: runs on background thread, emits shotReady()
+    // Async: runs on background thread, emits shotReady(). Served from
+    // recordCache() when the shot was decoded recently.
     Q_INVOKABLE void requestShot(qint64 shotId);
 
+    // Process-wide decoded-shot LRU (one per database), shared by every shot
+    // reader. Shots are invalidated here whenever they are written, so readers
+    // never see stale records. Hit/miss stats appear in the memory diagnostics.
+    std::shared_ptr<ShotRecordCache> recordCache() const { return m_recordCache; }
+
     // Async: runs on background thread, emits recentShotsByKbIdReady()
     // Returns summary data (not full time-series) for dial-in history queries.
     Q_INVOKABLE void requestRecentShotsByKbId(const QString& kbId, int limit = 10);
@@ -75,6 +83,13 @@ public:
     static ShotRecord loadShotRecordStatic(QSqlDatabase& db, qint64 shotId,
                                             bool* outBadgesPersisted = nullptr);
 
+    // loadShotRecordStatic through the decoded-shot cache (recordCache()): a hit
+    // skips the read, decompress and analysis; a miss loads on db and caches the
+    // result. A null cache just loads. Never returns nullptr — a missing shot has
+    // summary.id == 0. Thread-safe; callers must not modify the record.
+    static std::shared_ptr<const ShotRecord> loadShotRecordCached(QSqlDatabase& db, qint64 shotId,
+                                                                   ShotRecordCache* cache);
+
     // Compute conductance, Darcy resistance, and conductance derivative
     // from raw pressure/flow data for legacy shots that lack these fields.
     static void computeDerivedCurves(ShotRecord& record);
@@ -222,7 +237,6 @@ signals:
 private:
     bool createTables();
     bool runMigrations();
-    QByteArray compressSampleData(ShotDataModel* shotData, const QString& phaseSummariesJson = QString());
     static void decompressSampleData(const QByteArray& blob, ShotRecord* record);
     void updateTotalShots();
     QString buildFilterQuery(const ShotFilter& filter, QVariantList& bindValues);
@@ -279,5 +293,8 @@ private:
     // read on background threads (before QMetaObject::invokeMethod).
     std::shared_ptr<std::atomic<bool>> m_destroyed = std::make_shared<std::atomic<bool>>(false);
 
+    // shared_ptr so loader threads can still insert after this object is gone
+    std::shared_ptr<ShotRecordCache> m_recordCache;
+
     static const QString DB_CONNECTION_NAME;
 };
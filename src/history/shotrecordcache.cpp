@@ -0,0 +1,118 @@
+#include "shotrecordcache.h"
+
+#include <QMutexLocker>
+
+ShotRecordCache::ShotRecordCache(qsizetype budgetBytes)
+    : m_cache(budgetBytes)
+{
+}
+
+std::shared_ptr<const ShotRecord> ShotRecordCache::find(qint64 shotId)
+{
+    QMutexLocker locker(&m_mutex);
+    const Entry* entry = m_cache.object(shotId);
+    if (!entry || entry->revision != revisionLocked(shotId)) {
+        ++m_stats.misses;
+        return nullptr;
+    }
+    ++m_stats.hits;
+    return entry->record;
+}
+
+bool ShotRecordCache::contains(qint64 shotId) const
+{
+    // Invalidation removes the entry, so presence means current. QCache::contains
+    // also leaves the LRU order alone, unlike object().
+    QMutexLocker locker(&m_mutex);
+    return m_cache.contains(shotId);
+}
+
+quint64 ShotRecordCache::revision(qint64 shotId) const
+{
+    QMutexLocker locker(&m_mutex);
+    return revisionLocked(shotId);
+}
+
+quint64 ShotRecordCache::revisionLocked(qint64 shotId) const
+{
+    return m_revisions.value(shotId, m_baseRevision);
+}
+
+void ShotRecordCache::insert(quint64 revision, std::shared_ptr<const ShotRecord> record)
+{
+    if (!record || record->summary.id == 0) return;
+    const qsizetype cost = estimateCost(*record);
+    const qint64 shotId = record->summary.id;
+
+    QMutexLocker locker(&m_mutex);
+    if (revision != revisionLocked(shotId)) {
+        ++m_stats.staleDrops;
+        return;
+    }
+    ++m_stats.inserts;
+    // QCache takes ownership (and drops it at once if it exceeds the budget)
+    m_cache.insert(shotId, new Entry{revision, std::move(record)}, cost);
+}
+
+void ShotRecordCache::invalidate(qint64 shotId)
+{
+    QMutexLocker locker(&m_mutex);
+    m_revisions.insert(shotId, ++m_nextRevision);
+    m_cache.remove(shotId);
+}
+
+void ShotRecordCache::invalidateAll()
+{
+    QMutexLocker locker(&m_mutex);
+    m_baseRevision = ++m_nextRevision;
+    m_revisions.clear();
+    m_cache.clear();
+}
+
+ShotRecordCache::Stats ShotRecordCache::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    Stats result = m_stats;
+    result.entries = m_cache.size();
+    result.costBytes = m_cache.totalCost();
+    result.budgetBytes = m_cache.maxCost();
+    return result;
+}
+
+QJsonObject ShotRecordCache::statsJson() const
+{
+    const Stats s = stats();
+    const quint64 lookups = s.hits + s.misses;
+    QJsonObject result;
+    result["hits"] = static_cast<qint64>(s.hits);
+    result["misses"] = static_cast<qint64>(s.misses);
+    result["hitRate"] = lookups > 0 ? static_cast<double>(s.hits) / lookups : 0.0;
+    result["inserts"] = static_cast<qint64>(s.inserts);
+    result["staleDrops"] = static_cast<qint64>(s.staleDrops);
+    result["entries"] = static_cast<qint64>(s.entries);
+    result["sizeMB"] = s.costBytes / (1024.0 * 1024.0);
+    result["budgetMB"] = s.budgetBytes / (1024.0 * 1024.0);
+    return result;
+}
+
+qsizetype ShotRecordCache::estimateCost(const ShotRecord& record)
+{
+    qsizetype points = 0;
+    for (const QVector<QPointF>* series : {&record.pressure, &record.flow, &record.temperature,
+                                           &record.pressureGoal, &record.flowGoal, &record.temperatureGoal,
+                                           &record.temperatureMix, &record.resistance, &record.conductance,
+                                           &record.darcyResistance, &record.conductanceDerivative,
+                                           &record.waterDispensed, &record.weight, &record.weightFlowRate}) {
+        points += series->size();
+    }
+
+    // The large strings; the rest of the metadata is noise next to these
+    const qsizetype chars = record.debugLog.size() + record.profileJson.size()
+        + record.phaseSummariesJson.size() + record.espressoNotes.size()
+        + record.beanNotes.size() + record.profileNotes.size();
+
+    return static_cast<qsizetype>(sizeof(ShotRecord))
+        + points * static_cast<qsizetype>(sizeof(QPointF))
+        + chars * static_cast<qsizetype>(sizeof(QChar))
+        + record.phases.size() * static_cast<qsizetype>(sizeof(HistoryPhaseMarker));
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "shothistory_types.h"
+
+#include <QCache>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <memory>
+
+// Memory-bounded LRU of decoded shots: ShotRecord exactly as
+// ShotHistoryStorage::loadShotRecordStatic returns it (blob inflated, derived
+// curves, badges and cachedAnalysis filled in). ShotHistoryStorage owns the one
+// instance per database and every reader goes through it — the QML detail page
+// (requestShot), ShotComparisonModel, the web pages, MCP shot tools and
+// AIManager's history context — so a shot decoded by one is free for the others.
+// Most readers go through ShotHistoryStorage::loadShotRecordCached.
+//
+// Records are immutable once cached and handed out as shared pointers: a
+// caller's record stays valid even if it is evicted meanwhile. All methods
+// are thread-safe.
+//
+// Entries are keyed by (shot id, revision). ShotHistoryStorage invalidates a
+// shot whenever it is written (metadata, visualizer info, delete), which bumps
+// its revision; invalidateAll() bumps every shot's (grinder rename, import).
+// Loaders take revision() before reading the DB and insert() discards the
+// record if the shot was invalidated meanwhile, so a slow read can never
+// reinstate data older than a write.
+class ShotRecordCache {
+public:
+    static constexpr qsizetype DEFAULT_BUDGET_BYTES = 24 * 1024 * 1024;
+
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 inserts = 0;
+        quint64 staleDrops = 0;     // Inserts discarded because the shot changed during the load
+        qsizetype entries = 0;
+        qsizetype costBytes = 0;
+        qsizetype budgetBytes = 0;
+    };
+
+    explicit ShotRecordCache(qsizetype budgetBytes = DEFAULT_BUDGET_BYTES);
+
+    // Marks the shot most recently used and counts a hit or miss. nullptr on a miss.
+    std::shared_ptr<const ShotRecord> find(qint64 shotId);
+    // Presence check for prefetching; not counted in the stats.
+    bool contains(qint64 shotId) const;
+
+    quint64 revision(qint64 shotId) const;
+    // Records with summary.id == 0 (load failed) are ignored.
+    void insert(quint64 revision, std::shared_ptr<const ShotRecord> record);
+
+    void invalidate(qint64 shotId);
+    void invalidateAll();
+
+    Stats stats() const;
+    QJsonObject statsJson() const;
+
+    // Approximate heap footprint of a decoded record
+    static qsizetype estimateCost(const ShotRecord& record);
+
+private:
+    struct Entry {
+        quint64 revision = 0;
+        std::shared_ptr<const ShotRecord> record;
+    };
+
+    quint64 revisionLocked(qint64 shotId) const;
+
+    mutable QMutex m_mutex;
+    QCache<qint64, Entry> m_cache;
+    QHash<qint64, quint64> m_revisions;  // Shots invalidated since the last invalidateAll()
+    quint64 m_baseRevision = 0;          // Revision of every other shot
+    quint64 m_nextRevision = 0;
+    Stats m_stats;
+};
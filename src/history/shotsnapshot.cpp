@@ -0,0 +1,95 @@
+#include "shotsnapshot.h"
+#include "ai/conductance.h"
+
+#include <QDebug>
+
+bool ShotSnapshot::trimSettlingData() {
+    // Find the last sample with non-zero pressure — samples after this are from the
+    // SAW settling period where the DE1 reports 0 pressure/flow while the scale settles.
+    // De1app stops recording at the end of pouring substate; we trim at save time to
+    // preserve live drip visualization during settling but produce clean history graphs.
+    qsizetype trimIndex = pressure.size();
+    while (trimIndex > 0 && pressure[trimIndex - 1].y() <= 0.0) {
+        --trimIndex;
+    }
+
+    if (trimIndex >= pressure.size()) {
+        return false;  // Nothing to trim
+    }
+
+    if (trimIndex == 0) {
+        qWarning() << "[ShotSnapshot] trimSettlingData: all" << pressure.size()
+                   << "samples have zero pressure — skipping trim to preserve data";
+        return false;
+    }
+
+    qsizetype removed = pressure.size() - trimIndex;
+    qDebug() << "[ShotSnapshot] Trimming" << removed << "trailing zero-pressure settling samples"
+             << "(keeping" << trimIndex << "of" << pressure.size() << ")";
+
+    // Trim sensor data series to the same length
+    pressure.resize(trimIndex);
+    flow.resize(qMin(flow.size(), trimIndex));
+    temperature.resize(qMin(temperature.size(), trimIndex));
+    temperatureMix.resize(qMin(temperatureMix.size(), trimIndex));
+    resistance.resize(qMin(resistance.size(), trimIndex));
+    conductance.resize(qMin(conductance.size(), trimIndex));
+    darcyResistance.resize(qMin(darcyResistance.size(), trimIndex));
+    waterDispensed.resize(qMin(waterDispensed.size(), trimIndex));
+
+    // Trim time-based series using cutoff from last retained pressure sample.
+    // Goals and weight flow rate have different sample counts than DE1 sensor data.
+    // (trimIndex is guaranteed > 0 by the early returns above)
+    const double cutoffTime = pressure.last().x();
+    for (auto& segment : pressureGoalSegments) {
+        while (!segment.isEmpty() && segment.last().x() > cutoffTime)
+            segment.removeLast();
+    }
+    for (auto& segment : flowGoalSegments) {
+        while (!segment.isEmpty() && segment.last().x() > cutoffTime)
+            segment.removeLast();
+    }
+    while (!temperatureGoal.isEmpty() && temperatureGoal.last().x() > cutoffTime)
+        temperatureGoal.removeLast();
+    while (!weightFlowRate.isEmpty() && weightFlowRate.last().x() > cutoffTime)
+        weightFlowRate.removeLast();
+    while (!weightFlowRateRaw.isEmpty() && weightFlowRateRaw.last().x() > cutoffTime)
+        weightFlowRateRaw.removeLast();
+
+    // Do NOT trim cumulative weight data (weight, cumulativeWeight) —
+    // weight continues to change during settling and the settled final weight is accurate.
+    return true;
+}
+
+void ShotSnapshot::smoothWeightFlowRate(int window) {
+    // Save raw copy before smoothing (for by_weight_raw export)
+    weightFlowRateRaw = weightFlowRate;
+
+    const qsizetype n = weightFlowRate.size();
+    if (n < 3) return;
+
+    // Centered moving average: each point averages with `window` neighbors on each side.
+    // With window=5 and ~5Hz data, this spans ~2.2s on top of the 1s LSLR recording window
+    // and the real-time EMA smoothing. X values (timestamps) are preserved.
+    QVector<QPointF> smoothed;
+    smoothed.reserve(n);
+    for (qsizetype i = 0; i < n; i++) {
+        qsizetype lo = qMax(qsizetype(0), i - window);
+        qsizetype hi = qMin(n - 1, i + window);
+        double sum = 0;
+        for (qsizetype j = lo; j <= hi; j++) {
+            sum += weightFlowRate[j].y();
+        }
+        smoothed.append(QPointF(weightFlowRate[i].x(), sum / (hi - lo + 1)));
+    }
+    weightFlowRate = smoothed;
+}
+
+void ShotSnapshot::computeConductanceDerivative() {
+    // Delegate to Conductance::derivative so the live model, the post-shot
+    // pipeline and tools/shot_eval (batch offline data) share one formula —
+    // keeps live-graph curves identical to offline-evaluation curves.
+    conductanceDerivative = Conductance::derivative(conductance);
+    qDebug() << "ShotSnapshot: Computed conductance derivative ("
+             << conductanceDerivative.size() << " points)";
+}
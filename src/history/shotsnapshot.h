@@ -0,0 +1,69 @@
+#pragma once
+
+#include "history/shothistory_types.h"
+
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+// Immutable-by-convention copy of everything ShotDataModel recorded for one
+// shot, taken on the main thread when the shot ends. Every series is an
+// implicitly-shared QVector, so capturing a snapshot is O(number of series),
+// not O(samples) — the sample data is only copied if one side writes to it.
+//
+// The post-shot stages (settling trim, weight-flow smoothing, dC/dt) mutate
+// the snapshot owned by the PostShotPipeline job, never the live model; the
+// processed result is handed back via ShotDataModel::applyProcessedSnapshot().
+// Pure value type with no QObject pointers, so it is safe to move across
+// threads.
+struct ShotSnapshot {
+    // ShotDataModel::generation() at capture time. applyProcessedSnapshot()
+    // refuses a snapshot whose generation no longer matches (the model was
+    // cleared for a new shot while the pipeline was running).
+    quint64 generation = 0;
+
+    QVector<QPointF> pressure;
+    QVector<QPointF> flow;
+    QVector<QPointF> temperature;
+    QVector<QPointF> temperatureMix;
+    QVector<QPointF> resistance;
+    QVector<QPointF> conductance;
+    QVector<QPointF> darcyResistance;
+    QVector<QPointF> conductanceDerivative;
+    QVector<QPointF> waterDispensed;
+    QVector<QVector<QPointF>> pressureGoalSegments;
+    QVector<QVector<QPointF>> flowGoalSegments;
+    QVector<QPointF> temperatureGoal;
+    QVector<QPointF> weight;             // Graph copy (ShotDataModel::weightData)
+    QVector<QPointF> cumulativeWeight;   // Export copy (ShotDataModel::cumulativeWeightData)
+    QVector<QPointF> weightFlowRate;
+    QVector<QPointF> weightFlowRateRaw;
+
+    QList<HistoryPhaseMarker> phases;
+
+    // Goal segments flattened for export / analysis (same as
+    // ShotDataModel::pressureGoalData / flowGoalData).
+    QVector<QPointF> pressureGoal() const { return combineSegments(pressureGoalSegments); }
+    QVector<QPointF> flowGoal() const { return combineSegments(flowGoalSegments); }
+
+    // Remove trailing zero-pressure samples recorded during SAW settling.
+    // Cumulative weight is intentionally left untouched (the settled weight is
+    // the accurate one). Returns true if anything was trimmed.
+    bool trimSettlingData();
+
+    // Centered moving average over weightFlowRate; snapshots the unsmoothed
+    // series into weightFlowRateRaw first. Must run after trimSettlingData()
+    // so neither copy includes settling zeros.
+    void smoothWeightFlowRate(int window = 5);
+
+    // dC/dt with Gaussian smoothing via Conductance::derivative.
+    void computeConductanceDerivative();
+
+private:
+    static QVector<QPointF> combineSegments(const QVector<QVector<QPointF>>& segments) {
+        QVector<QPointF> combined;
+        for (const auto& segment : segments)
+            combined.append(segment);
+        return combined;
+    }
+};
@@ -0,0 +1,181 @@
+#include "sawlatencytracker.h"
+#include "../ble/arrivalclock.h"
+#include "../core/settingsstore.h"
+#include <QJsonArray>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <algorithm>
+#include <cmath>
+
+SawLatencyTracker* SawLatencyTracker::s_instance = nullptr;
+
+namespace {
+const QString kSettingsKey = QStringLiteral("saw/latencyHistograms");
+
+QJsonObject histogramToJson(const SawLatencyTracker::Histogram& h)
+{
+    QJsonArray buckets;
+    for (quint32 n : h.buckets) buckets.append(static_cast<qint64>(n));
+    QJsonObject obj;
+    obj["count"] = static_cast<qint64>(h.count);
+    obj["sumMs"] = h.sumMs;
+    obj["maxMs"] = h.maxMs;
+    obj["buckets"] = buckets;
+    return obj;
+}
+
+SawLatencyTracker::Histogram histogramFromJson(const QJsonObject& obj)
+{
+    SawLatencyTracker::Histogram h;
+    h.count = static_cast<quint32>(obj["count"].toInteger());
+    h.sumMs = obj["sumMs"].toInteger();
+    h.maxMs = obj["maxMs"].toInteger();
+    const QJsonArray buckets = obj["buckets"].toArray();
+    for (int i = 0; i < SawLatencyTracker::BUCKET_COUNT && i < buckets.size(); ++i)
+        h.buckets[i] = static_cast<quint32>(buckets[i].toInteger());
+    return h;
+}
+} // namespace
+
+void SawLatencyTracker::Histogram::add(qint64 ms)
+{
+    ms = std::max<qint64>(ms, 0);  // Clock granularity can put the ack before the write
+    const auto it = std::lower_bound(BUCKET_UPPER_MS.begin(), BUCKET_UPPER_MS.end(), ms);
+    ++buckets[static_cast<size_t>(it - BUCKET_UPPER_MS.begin())];
+    ++count;
+    sumMs += ms;
+    maxMs = std::max(maxMs, ms);
+}
+
+qint64 SawLatencyTracker::Histogram::percentileMs(double p) const
+{
+    if (count == 0) return 0;
+    const quint64 rank = static_cast<quint64>(std::ceil(p / 100.0 * count));
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT - 1; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min<qint64>(BUCKET_UPPER_MS[i], maxMs);
+    }
+    return maxMs;
+}
+
+SawLatencyTracker::SawLatencyTracker(QObject* parent)
+    : QObject(parent)
+    , m_settings(SettingsStore::instance())
+{
+    load();
+    s_instance = this;
+}
+
+SawLatencyTracker::~SawLatencyTracker()
+{
+    if (s_instance == this) s_instance = nullptr;
+}
+
+QString SawLatencyTracker::stageName(Stage stage)
+{
+    switch (stage) {
+    case Queue: return QStringLiteral("queue");
+    case Decide: return QStringLiteral("decide");
+    case Dispatch: return QStringLiteral("dispatch");
+    case BleAck: return QStringLiteral("bleAck");
+    case Machine: return QStringLiteral("machine");
+    case Total: return QStringLiteral("total");
+    case StageCount: break;
+    }
+    return QString();
+}
+
+void SawLatencyTracker::record(const QString& scaleType, const SawLatencyTrace& trace)
+{
+    const QString key = scaleType.isEmpty() ? QStringLiteral("unknown") : scaleType;
+    ScaleStats& stats = m_scales[key];
+
+    auto addStage = [&stats](Stage stage, qint64 fromMs, qint64 toMs) {
+        if (fromMs > 0 && toMs > 0) stats.stages[stage].add(toMs - fromMs);
+    };
+    addStage(Queue, trace.arrivalMs, trace.processMs);
+    addStage(Decide, trace.processMs, trace.triggerMs);
+    addStage(Dispatch, trace.triggerMs, trace.writeMs);
+    addStage(BleAck, trace.writeMs, trace.ackMs);
+    addStage(Machine, trace.writeMs, trace.stateMs);
+    addStage(Total, trace.arrivalMs, trace.stateMs);
+
+    ++stats.stops;
+    stats.lastStopEpochMs = trace.stateMs > 0 ? ArrivalClock::toEpochMs(trace.stateMs)
+                                              : QDateTime::currentMSecsSinceEpoch();
+    save();
+}
+
+const SawLatencyTracker::Histogram* SawLatencyTracker::histogram(const QString& scaleType, Stage stage) const
+{
+    auto it = m_scales.constFind(scaleType);
+    if (it == m_scales.constEnd() || stage < 0 || stage >= StageCount) return nullptr;
+    return &it->stages[stage];
+}
+
+QJsonObject SawLatencyTracker::toJson() const
+{
+    QJsonArray bounds;
+    for (int ms : BUCKET_UPPER_MS) bounds.append(ms);
+
+    QJsonObject result;
+    result["bucketUpperMs"] = bounds;
+    result["scales"] = scalesJson(true);
+    return result;
+}
+
+QJsonObject SawLatencyTracker::scalesJson(bool withSummary) const
+{
+    QJsonObject scales;
+    for (auto it = m_scales.constBegin(); it != m_scales.constEnd(); ++it) {
+        QJsonObject stages;
+        for (int s = 0; s < StageCount; ++s) {
+            const Histogram& h = it->stages[s];
+            QJsonObject obj = histogramToJson(h);
+            if (withSummary) {
+                obj["meanMs"] = h.count > 0 ? static_cast<double>(h.sumMs) / h.count : 0.0;
+                obj["p50Ms"] = h.percentileMs(50);
+                obj["p95Ms"] = h.percentileMs(95);
+            }
+            stages[stageName(static_cast<Stage>(s))] = obj;
+        }
+        QJsonObject scale;
+        scale["stops"] = static_cast<qint64>(it->stops);
+        scale["lastStopEpochMs"] = it->lastStopEpochMs;
+        scale["stages"] = stages;
+        scales[it.key()] = scale;
+    }
+    return scales;
+}
+
+void SawLatencyTracker::clear()
+{
+    m_scales.clear();
+    m_settings.remove(kSettingsKey);
+}
+
+void SawLatencyTracker::load()
+{
+    const QByteArray data = m_settings.value(kSettingsKey).toByteArray();
+    if (data.isEmpty()) return;
+
+    const QJsonObject scales = QJsonDocument::fromJson(data).object();
+    for (auto it = scales.constBegin(); it != scales.constEnd(); ++it) {
+        const QJsonObject obj = it.value().toObject();
+        const QJsonObject stages = obj["stages"].toObject();
+        ScaleStats stats;
+        for (int s = 0; s < StageCount; ++s)
+            stats.stages[s] = histogramFromJson(stages[stageName(static_cast<Stage>(s))].toObject());
+        stats.stops = static_cast<quint32>(obj["stops"].toInteger());
+        stats.lastStopEpochMs = obj["lastStopEpochMs"].toInteger();
+        m_scales.insert(it.key(), stats);
+    }
+}
+
+void SawLatencyTracker::save()
+{
+    // One in-memory write per SAW stop, after the DE1 has already stopped;
+    // the store batches it into its next flush
+    m_settings.setValue(kSettingsKey, QJsonDocument(scalesJson(false)).toJson(QJsonDocument::Compact));
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../ble/sawlatencytrace.h"
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <array>
+
+// Per-scale-type histograms of stop-at-weight latency, kept across sessions.
+//
+// Every SAW stop DE1Device traces end to end (see SawLatencyTrace) is split
+// into stages and added to the histograms of the scale type in use:
+//
+//   queue     scale notification arrival -> WeightProcessor::processWeight
+//   decide    processWeight -> stopNow
+//   dispatch  stopNow -> urgent Idle write queued on the transport
+//   bleAck    write queued -> write acknowledged
+//   machine   write queued -> DE1 state change observed
+//   total     scale notification arrival -> DE1 state change observed
+//
+// Shown on the web debug page (/api/saw-latency) and the
+// decenza://debug/saw-latency MCP resource. Persisted through SettingsStore,
+// so a stop updates the in-memory copy and the write to disk is debounced
+// with the other settings. Main thread only.
+class SettingsStore;
+
+class SawLatencyTracker : public QObject {
+    Q_OBJECT
+
+public:
+    enum Stage { Queue, Decide, Dispatch, BleAck, Machine, Total, StageCount };
+
+    // Bucket i counts durations <= BUCKET_UPPER_MS[i] (and above the previous
+    // bound); the last bucket counts everything slower
+    static constexpr int BUCKET_COUNT = 10;
+    static constexpr std::array<int, BUCKET_COUNT - 1> BUCKET_UPPER_MS{{5, 10, 20, 50, 100, 200, 500, 1000, 2000}};
+
+    struct Histogram {
+        std::array<quint32, BUCKET_COUNT> buckets{};
+        quint32 count = 0;
+        qint64 sumMs = 0;
+        qint64 maxMs = 0;
+
+        void add(qint64 ms);
+        // Upper bound of the bucket holding the p-th percentile (maxMs for
+        // the overflow bucket); 0 when empty
+        qint64 percentileMs(double p) const;
+    };
+
+    explicit SawLatencyTracker(QObject* parent = nullptr);
+    ~SawLatencyTracker() override;
+
+    // The live tracker, or nullptr
+    static SawLatencyTracker* instance() { return s_instance; }
+
+    static QString stageName(Stage stage);
+
+    // Adds a completed trace; stages whose ends weren't both seen are skipped
+    void record(const QString& scaleType, const SawLatencyTrace& trace);
+
+    const Histogram* histogram(const QString& scaleType, Stage stage) const;
+    QJsonObject toJson() const;
+
+    Q_INVOKABLE void clear();
+
+private:
+    struct ScaleStats {
+        std::array<Histogram, StageCount> stages;
+        quint32 stops = 0;
+        qint64 lastStopEpochMs = 0;
+    };
+
+    void load();
+    void save();
+    // Per scale type; withSummary adds mean and percentiles for display
+    QJsonObject scalesJson(bool withSummary) const;
+
+    SettingsStore& m_settings;
+    QHash<QString, ScaleStats> m_scales;
+
+    static SawLatencyTracker* s_instance;
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <QtGlobal>
+#include <array>
+
+// Least-squares flow rate over trailing time windows of scale readings, in
+// constant time per reading.
+//
+// WeightProcessor keeps the last second of readings in a WeightRing and fits
+// a line (weight against time) to a long and a short window of it on every
+// reading; the slope is the flow rate in g/s. Instead of re-summing the
+// window each time, a WindowFit keeps running means and co-moments
+// (Welford-style) and only adds the readings that entered the window and
+// removes the ones that left it. Removal accumulates rounding error, so every
+// REBASE_INTERVAL updates the fit is recomputed from its window.
+//
+// Single-threaded (WeightProcessor's ingest thread); nothing allocates.
+
+struct WeightSample {
+    qint64 timestamp = 0;  // ms
+    double weight = 0;
+};
+
+// Fixed-capacity ring of readings, oldest first. Every reading gets a sequence
+// number; a dropped reading stays readable by sequence until CAPACITY newer
+// ones have overwritten it, which is what lets a WindowFit remove it later.
+class WeightRing {
+public:
+    // A second of readings at 100+ Hz; a faster scale would shorten the
+    // window to the newest CAPACITY readings rather than overflow
+    static constexpr int CAPACITY = 128;
+
+    // Appends a reading, then drops readings more than maxAgeMs older than it
+    void append(qint64 timestamp, double weight, qint64 maxAgeMs)
+    {
+        if (size() == CAPACITY) ++m_begin;
+        m_samples[m_end % CAPACITY] = {timestamp, weight};
+        ++m_end;
+        while (timestamp - at(0).timestamp > maxAgeMs) ++m_begin;
+    }
+
+    void clear() { m_begin = m_end; }  // Sequence numbers keep counting
+
+    int size() const { return static_cast<int>(m_end - m_begin); }
+    bool isEmpty() const { return m_begin == m_end; }
+    const WeightSample& at(int i) const { return m_samples[(m_begin + static_cast<quint64>(i)) % CAPACITY]; }
+    const WeightSample& last() const { return at(size() - 1); }
+
+    // Live readings are [beginSeq, endSeq); storage still holds the
+    // CAPACITY readings before endSeq
+    quint64 beginSeq() const { return m_begin; }
+    quint64 endSeq() const { return m_end; }
+    const WeightSample& bySeq(quint64 seq) const
+    {
+        Q_ASSERT(seq < m_end && seq + CAPACITY >= m_end);
+        return m_samples[seq % CAPACITY];
+    }
+
+private:
+    std::array<WeightSample, CAPACITY> m_samples{};
+    quint64 m_begin = 0;
+    quint64 m_end = 0;
+};
+
+// Least-squares line over the readings within windowMs of the newest one.
+// update() after every append (or clear) of the ring it's used with; the
+// window length may change between calls (WeightProcessor's short window
+// adapts to the scale's rate).
+class WindowFit {
+public:
+    static constexpr int REBASE_INTERVAL = 64;
+
+    void update(const WeightRing& ring, int windowMs)
+    {
+        // Missed too many appends to remove what left, or the ring was
+        // cleared past the window: start over
+        if (m_first + WeightRing::CAPACITY < ring.endSeq() || m_end < ring.beginSeq()) {
+            reset(ring.beginSeq());
+        }
+
+        if (ring.isEmpty()) {
+            reset(ring.endSeq());
+            return;
+        }
+        while (m_end < ring.endSeq()) add(ring.bySeq(m_end++));
+
+        const qint64 cutoff = ring.last().timestamp - windowMs;
+        while (m_first < m_end && (m_first < ring.beginSeq() || ring.bySeq(m_first).timestamp < cutoff)) {
+            remove(ring.bySeq(m_first++));
+        }
+        // A longer window than last time takes back readings the ring still has
+        while (m_first > ring.beginSeq() && ring.bySeq(m_first - 1).timestamp >= cutoff) {
+            add(ring.bySeq(--m_first));
+        }
+
+        if (++m_updates >= REBASE_INTERVAL) {
+            m_updates = 0;
+            const quint64 first = m_first;
+            reset(first);
+            while (m_end < ring.endSeq()) add(ring.bySeq(m_end++));
+        }
+
+        m_spanMs = m_n > 0 ? ring.last().timestamp - ring.bySeq(m_first).timestamp : 0;
+    }
+
+    int count() const { return m_n; }
+    qint64 spanMs() const { return m_spanMs; }  // First to last reading in the window
+
+    // g/s; 0 with fewer than two readings or no spread in time
+    double slope() const
+    {
+        return (m_n >= 2 && m_n * m_ctt > 1e-12) ? m_ctw / m_ctt : 0.0;
+    }
+
+private:
+    void reset(quint64 seq)
+    {
+        m_first = m_end = seq;
+        m_n = 0;
+        m_meanT = m_meanW = m_ctt = m_ctw = 0;
+        m_spanMs = 0;
+    }
+
+    void add(const WeightSample& s)
+    {
+        if (m_n == 0) m_originMs = s.timestamp;  // Keeps t small
+        const double t = (s.timestamp - m_originMs) / 1000.0;
+        ++m_n;
+        const double dt = t - m_meanT;
+        m_meanT += dt / m_n;
+        m_meanW += (s.weight - m_meanW) / m_n;
+        m_ctt += dt * (t - m_meanT);
+        m_ctw += dt * (s.weight - m_meanW);
+    }
+
+    // Inverse of add(): C(n-1) = C(n) - (x - mean(n-1)) * (y - mean(n))
+    void remove(const WeightSample& s)
+    {
+        if (m_n <= 1) {
+            m_n = 0;
+            m_meanT = m_meanW = m_ctt = m_ctw = 0;
+            return;
+        }
+        const double t = (s.timestamp - m_originMs) / 1000.0;
+        const double meanT = (m_n * m_meanT - t) / (m_n - 1);
+        const double meanW = (m_n * m_meanW - s.weight) / (m_n - 1);
+        m_ctt -= (t - meanT) * (t - m_meanT);
+        m_ctw -= (t - meanT) * (s.weight - m_meanW);
+        m_meanT = meanT;
+        m_meanW = meanW;
+        --m_n;
+    }
+
+    quint64 m_first = 0;   // Window is ring sequences [m_first, m_end)
+    quint64 m_end = 0;
+    int m_n = 0;
+    qint64 m_originMs = 0;
+    double m_meanT = 0;    // s since m_originMs
+    double m_meanW = 0;
+    double m_ctt = 0;      // Sum of (t - meanT)^2
+    double m_ctw = 0;      // Sum of (t - meanT)(w - meanW)
+    qint64 m_spanMs = 0;
+    int m_updates = 0;
+};
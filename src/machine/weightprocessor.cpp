@@ -1,25 +1,35 @@
 #include "weightprocessor.h"
 #include "sawprediction.h"
+#include "../ble/arrivalclock.h"
 #include <QtMath>
 #include <QDebug>
-#include <chrono>
-
-namespace {
-qint64 monotonicMsNow()
-{
-    using namespace std::chrono;
-    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-}
-}
 
 WeightProcessor::WeightProcessor(QObject* parent)
     : QObject(parent)
 {
 }
 
-void WeightProcessor::processWeight(double weight)
+void WeightProcessor::processWeight(double weight, qint64 arrivalMs)
 {
-    qint64 wallClock = m_wallClock();
+    // SAW latency trace: when this reading reached us (real clock even in tests)
+    const qint64 processMs = ArrivalClock::nowMs();
+
+    // Time the reading by when the transport received it. Direct callers
+    // (and tests) without a stamp fall back to the clock at processing time.
+    const qint64 wallClock = arrivalMs > 0 ? arrivalMs : m_wallClock();
+
+    // Scales with an ingest decoder deliver each reading twice: straight from the
+    // transport on this thread, then again via ScaleDevice::weightChanged once the
+    // main thread gets to it. Take it from whichever arrives first, and never let
+    // a reading older than one already processed rewind the buffer.
+    if (arrivalMs > 0) {
+        if (arrivalMs < m_lastArrivalMs
+            || (arrivalMs == m_lastArrivalMs && weight == m_lastArrivalWeight)) {
+            return;
+        }
+        m_lastArrivalMs = arrivalMs;
+        m_lastArrivalWeight = weight;
+    }
 
     // Spike filter (issue #610): reject single-packet BLE corruption.
     // A Felicita scale was observed sending 1649g instead of ~10g, causing a
@@ -51,9 +61,11 @@ void WeightProcessor::processWeight(double weight)
 
     // De-jitter: BLE events arrive on the main thread via QueuedConnection, and when
     // the main thread is busy (QML rendering), multiple events queue up and are
-    // delivered in a burst. The worker thread processes them all within ~1ms, so
-    // wall-clock timestamps cluster together. This makes LSLR see dt≈0 and return 0,
-    // blinding SAW for the entire pour.
+    // delivered in a burst. Arrival stamps taken by the transport are immune to the
+    // main-thread → worker hop, and scales read on the ingest thread (see ScaleIngest)
+    // never make it; the rest still reach us through the main event loop, so on a
+    // busy device their stamps can cluster together.
+    // This makes LSLR see dt≈0 and return 0, blinding SAW for the entire pour.
     //
     // Fix: detect batching (gap < 20ms) and assign synthetic timestamps spaced by
     // the calibrated scale interval. Non-batched events calibrate the interval via
@@ -113,13 +125,11 @@ void WeightProcessor::processWeight(double weight)
     m_lastSampleTs = sampleTs;
 
     // Record sample for LSLR (1-second rolling window)
-    m_weightSamples.append({sampleTs, weight});
-    while (!m_weightSamples.isEmpty() && (sampleTs - m_weightSamples.first().timestamp) > 1000) {
-        m_weightSamples.removeFirst();
-    }
+    m_weightSamples.append(sampleTs, weight, 1000);
 
     // Compute flow rates (always, even outside extraction — for QML display and settling)
-    double flowRate = computeLSLR(1000);
+    m_longFit.update(m_weightSamples, 1000);
+    double flowRate = WeightProcessor::flowRate(m_longFit, 1000);
 
     // Adaptive short window: ensure at least 3 samples are covered regardless of
     // the scale's reporting rate. At 5Hz (Decent Scale) the span of 2 intervals is
@@ -130,10 +140,11 @@ void WeightProcessor::processWeight(double weight)
     int shortWindowMs = 500;
     if (m_weightSamples.size() >= 3) {
         qint64 spanOf3 = m_weightSamples.last().timestamp
-                         - m_weightSamples[m_weightSamples.size() - 3].timestamp;
+                         - m_weightSamples.at(m_weightSamples.size() - 3).timestamp;
         shortWindowMs = qBound(500, static_cast<int>(spanOf3) + 50, 1000);
     }
-    double flowRateShort = computeLSLR(shortWindowMs);
+    m_shortFit.update(m_weightSamples, shortWindowMs);
+    double flowRateShort = WeightProcessor::flowRate(m_shortFit, shortWindowMs);
 
     emit flowRatesReady(weight, flowRate, flowRateShort);
 
@@ -207,13 +218,7 @@ void WeightProcessor::processWeight(double weight)
         // Throttle this log to every 5s, include LSLR diagnostic info
         if (wallClock - m_lastLowFlowLogMs >= 5000) {
             // Compute dt for the short window to diagnose why LSLR returns 0
-            double shortDt = 0;
-            if (m_weightSamples.size() >= 2) {
-                qint64 cutoff = m_weightSamples.last().timestamp - shortWindowMs;
-                qsizetype si = m_weightSamples.size() - 1;
-                while (si > 0 && m_weightSamples[si - 1].timestamp >= cutoff) --si;
-                shortDt = (m_weightSamples.last().timestamp - m_weightSamples[si].timestamp) / 1000.0;
-            }
+            double shortDt = m_shortFit.spanMs() / 1000.0;
             qDebug() << "[SAW-Worker] Flow too low for SAW check: flowShort=" << flowRateShort
                      << "weight=" << weight << "target=" << m_targetWeight
                      << "samples=" << m_weightSamples.size()
@@ -242,14 +247,14 @@ void WeightProcessor::processWeight(double weight)
 
         if (weight >= stopThreshold) {
             m_stopTriggered = true;
-            qint64 triggerMs = monotonicMsNow();
+            qint64 triggerMs = ArrivalClock::nowMs();
             qDebug() << "[SAW-Worker] Stop triggered: weight=" << weight
                      << "threshold=" << stopThreshold
                      << "flow=" << flowRateShort << "(short)"
                      << "expectedDrip=" << expectedDrip
                      << "target=" << m_targetWeight;
             emit sawTriggered(weight, flowRateShort, m_targetWeight);
-            emit stopNow(triggerMs);
+            emit stopNow(triggerMs, arrivalMs, processMs);
         }
     }
 
@@ -342,7 +347,7 @@ void WeightProcessor::stopExtraction()
     // Log measured scale reporting rate and de-jitter state — captured in shot debug log.
     // Helps diagnose SAW issues on slow-reporting scales (Bookoo ~2Hz, etc.).
     if (m_weightSamples.size() >= 3) {
-        qint64 span = m_weightSamples.last().timestamp - m_weightSamples.first().timestamp;
+        qint64 span = m_weightSamples.last().timestamp - m_weightSamples.at(0).timestamp;
         if (span > 0) {
             double avgIntervalMs = span / static_cast<double>(m_weightSamples.size() - 1);
             qDebug() << "[Weight-Worker] Scale interval: avg" << static_cast<int>(avgIntervalMs) << "ms"
@@ -375,41 +380,16 @@ void WeightProcessor::resetForRetare()
     qDebug() << "[SAW-Worker] Reset for auto-retare";
 }
 
-double WeightProcessor::computeLSLR(int windowMs) const
+double WeightProcessor::flowRate(const WindowFit& fit, int windowMs)
 {
-    if (m_weightSamples.size() < 2) return 0.0;
-
-    qint64 now = m_weightSamples.last().timestamp;
-    qint64 cutoff = now - windowMs;
-
-    // Find start of window
-    qsizetype startIdx = m_weightSamples.size() - 1;
-    while (startIdx > 0 && m_weightSamples[startIdx - 1].timestamp >= cutoff) {
-        --startIdx;
-    }
-
-    qsizetype n = m_weightSamples.size() - startIdx;
-    if (n < 2) return 0.0;
-
-    double dt = (m_weightSamples.last().timestamp - m_weightSamples[startIdx].timestamp) / 1000.0;
-    if (dt < (windowMs * 0.65 / 1000.0)) return 0.0;  // Wait until window is ~65% full
-
     // Least-squares linear regression: fits w = slope*t + intercept
     // slope = flow rate in g/s. Uses all samples in the window, averaging
-    // out noise from scale quantization and BLE timing jitter.
-    qint64 t0 = m_weightSamples[startIdx].timestamp;
-    double sumT = 0, sumW = 0, sumTW = 0, sumTT = 0;
-    for (qsizetype i = startIdx; i < m_weightSamples.size(); ++i) {
-        double t = (m_weightSamples[i].timestamp - t0) / 1000.0;
-        sumT += t;
-        sumW += m_weightSamples[i].weight;
-        sumTW += t * m_weightSamples[i].weight;
-        sumTT += t * t;
-    }
-    double denom = n * sumTT - sumT * sumT;
-    double slope = (denom > 1e-12) ? (n * sumTW - sumT * sumW) / denom : 0.0;
+    // out noise from scale quantization and BLE timing jitter. The fit is
+    // kept up to date incrementally as samples enter and leave the window.
+    if (fit.count() < 2) return 0.0;
+    if (fit.spanMs() < windowMs * 0.65) return 0.0;  // Wait until window is ~65% full
 
-    return qMax(0.0, slope);
+    return qMax(0.0, fit.slope());
 }
 
 double WeightProcessor::getExpectedDrip(double currentFlowRate) const
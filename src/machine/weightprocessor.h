@@ -6,20 +6,25 @@
 #include <QVector>
 #include <QSet>
 #include <QDateTime>
+#include "../ble/arrivalclock.h"
+#include "slidingregression.h"
 #include <functional>
 
-// Runs on a dedicated worker thread. Receives weight samples from the scale,
-// computes LSLR flow rates, and makes SAW/per-frame-exit decisions
+// Runs on the scale ingest thread (see ScaleIngest). Receives weight samples from
+// the scale, computes LSLR flow rates, and makes SAW/per-frame-exit decisions
 // independently of main thread congestion.
 //
 // Input (via QueuedConnection from main thread):
-//   - processWeight(): called at ~5Hz with each scale reading
+//   - processWeight(): called at ~5Hz with each scale reading and the
+//     ArrivalClock stamp the transport put on it. Scales with an ingest decoder
+//     also call it directly on the ingest thread; the later copy is dropped
 //   - configure(): called once at shot start with targets and learning data
 //   - setTargetWeight(): may update SAW target mid-shot (e.g. user +10g bump)
 //   - setCurrentFrame(): called at ~5Hz from DE1 shot samples
 //
 // Output (via QueuedConnection back to main thread):
-//   - stopNow(triggerMs): triggers DE1Device::stopOperationUrgent(triggerMs)
+//   - stopNow(triggerMs, arrivalMs, processMs): triggers DE1Device::stopOperationUrgent()
+//     with the start of a SawLatencyTrace
 //   - sawTriggered(weightAtStop, flowRateAtStop, targetWeight): carries context for SAW learning
 //   - skipFrame(): triggers DE1Device::skipToNextFrame()
 //   - flowRatesReady(): feeds ShotTimingController for graph/settling
@@ -32,7 +37,7 @@ public:
 
 public slots:
     // Called from main thread (all via QueuedConnection — thread-safe)
-    void processWeight(double weight);
+    void processWeight(double weight, qint64 arrivalMs = 0);
     void configure(double targetWeight, int preinfuseFrameCount,
                    QVector<double> frameExitWeights,
                    QVector<double> learningDrips, QVector<double> learningFlows,
@@ -58,8 +63,9 @@ public:
 #endif
 
 signals:
-    // Emitted when SAW triggers. Includes monotonic timestamp (ms) for latency tracing.
-    void stopNow(qint64 triggerMs);
+    // Emitted when SAW triggers. ArrivalClock stamps (ms) for latency tracing: now,
+    // and when the reading that tripped it arrived (0 if unstamped) and was picked up.
+    void stopNow(qint64 triggerMs, qint64 arrivalMs, qint64 processMs);
     // Carries SAW context for learning (weight/flow at stop time)
     void sawTriggered(double weightAtStop, double flowRateAtStop, double targetWeight);
     void skipFrame(int frameNumber);
@@ -67,15 +73,14 @@ signals:
     void untaredCupDetected();
 
 private:
-    double computeLSLR(int windowMs) const;
+    static double flowRate(const WindowFit& fit, int windowMs);
     double getExpectedDrip(double currentFlowRate) const;
 
-    // Weight sample buffer (1-second rolling window for LSLR)
-    struct WeightSample {
-        qint64 timestamp;
-        double weight;
-    };
-    QList<WeightSample> m_weightSamples;
+    // Weight sample buffer (1-second rolling window for LSLR) and the running
+    // least-squares fits over its long (1s) and adaptive short windows
+    WeightRing m_weightSamples;
+    WindowFit m_longFit;
+    WindowFit m_shortFit;
 
     // Spike filter: rejects single-packet BLE corruption (issue #610).
     // Scoped to active extractions via m_active — see processWeight().
@@ -95,6 +100,10 @@ private:
     bool m_oscillationDetected = false;  // true while waiting for scale to re-settle after oscillation
     int m_settleCount = 0;               // consecutive near-zero readings since oscillation detected
 
+    // Duplicate delivery: last stamped reading taken (see processWeight)
+    qint64 m_lastArrivalMs = 0;
+    double m_lastArrivalWeight = 0;
+
     // De-jitter: compensates for main thread event batching (see processWeight comments)
     qint64 m_lastWallClockMs = 0;       // Wall-clock time of last processWeight() call
     qint64 m_lastSampleTs = 0;          // Last synthetic timestamp assigned to a sample
@@ -121,6 +130,8 @@ private:
     // Per-frame exit tracking (avoid duplicate skip commands)
     QSet<int> m_frameWeightSkipSent;
 
-    // Wall-clock source (injectable for testing — avoids 77s of QTest::qWait)
-    std::function<qint64()> m_wallClock = [] { return QDateTime::currentMSecsSinceEpoch(); };
+    // Clock for unstamped readings and extraction timing — must share a reference
+    // with the transports' arrival stamps (injectable for testing — avoids 77s of
+    // QTest::qWait)
+    std::function<qint64()> m_wallClock = [] { return ArrivalClock::nowMs(); };
 };
@@ -58,8 +58,10 @@
 #include "network/crashreporter.h"
 #include "core/profilestorage.h"
 #include "ble/blemanager.h"
+#include "ble/blecapture.h"
 #include "ble/de1device.h"
 #include "ble/de1transport.h"
+#include "ble/scaleingest.h"
 #ifndef Q_OS_IOS
 #include "usb/usbmanager.h"
 #include "usb/usbscalemanager.h"
@@ -80,16 +82,20 @@
 #include "models/shotdatamodel.h"
 #include "models/steamdatamodel.h"
 #include "machine/steamhealthtracker.h"
+#include "machine/sawlatencytracker.h"
 #include "controllers/maincontroller.h"
 #include "controllers/shottimingcontroller.h"
 #include "ai/aimanager.h"
 #include "ai/aiconversation.h"
+#include "ai/liveshotanalysis.h"
 #include "screensaver/screensavervideomanager.h"
 #if defined(Q_OS_IOS) || defined(Q_OS_MACOS)
 #include "screensaver/iosbrightness.h"
 #endif
 #include "screensaver/strangeattractorrenderer.h"
 #include "rendering/fastlinerenderer.h"
+#include "rendering/fastmultilinerenderer.h"
+#include "rendering/fastsegmentseries.h"
 #ifdef ENABLE_QUICK3D
 #include "screensaver/pipegeometry.h"
 #endif
@@ -472,6 +478,17 @@ int main(int argc, char *argv[])
     bleManager.setDisabled(settings.app()->simulationMode());
 #endif
 
+    // Raw BLE capture for reproducing field issues (ReplayTransport plays it back).
+    // Must be recording before the first transport is created.
+    BleCaptureTap bleCaptureTap;
+    const QString bleCapturePath = qEnvironmentVariable("DECENZA_BLE_CAPTURE");
+    if (!bleCapturePath.isEmpty())
+        bleCaptureTap.start(bleCapturePath);
+
+    // Scale transports and their weight decoders run on this thread (see
+    // ScaleIngest); like the capture tap, it must exist before any scale is created.
+    ScaleIngest scaleIngest;
+
     DE1Device de1Device;
     de1Device.setSettings(settings.hardware());  // Heater calibration sent to firmware
     qDebug() << "Simulation mode:" << (settings.app()->simulationMode() ? "ON" : "off");
@@ -481,6 +498,7 @@ int main(int argc, char *argv[])
     ShotDataModel shotDataModel;
     SteamDataModel steamDataModel;
     SteamHealthTracker steamHealthTracker;
+    SawLatencyTracker sawLatencyTracker;
     MachineState machineState(&de1Device);
     machineState.setSettings(&settings);
     machineState.setScale(&flowScale);  // Start with FlowScale, switch to physical scale if found
@@ -553,16 +571,19 @@ int main(int argc, char *argv[])
 
     checkpoint("ShotTimingController wiring");
 
-    // Weight processor on dedicated worker thread — isolates LSLR + SOW decisions
-    // from main thread stalls (GC pauses, remaining synchronous I/O).
+    // Weight processor on the scale ingest thread — isolates LSLR + SOW decisions
+    // from main thread stalls (GC pauses, remaining synchronous I/O). Scales with
+    // a weight decoder feed it directly from their transport on that thread.
     WeightProcessor weightProcessor;
-    QThread weightThread;
-    weightThread.setObjectName(QStringLiteral("WeightProcessor"));
-    weightProcessor.moveToThread(&weightThread);
-    weightThread.start();
+    weightProcessor.moveToThread(scaleIngest.ingestThread());
+    scaleIngest.setWeightSink([&weightProcessor](double weight, qint64 arrivalMs) {
+        weightProcessor.processWeight(weight, arrivalMs);
+    });
 
     // Scale → WeightProcessor (main → worker, auto QueuedConnection)
-    // Initially connected to FlowScale; reconnected when physical scale is found
+    // Initially connected to FlowScale; reconnected when physical scale is found.
+    // For decoded scales this delivers each reading a second time, later;
+    // processWeight() drops the repeat by its arrival stamp.
     QObject::connect(&flowScale, &ScaleDevice::weightChanged,
                      &weightProcessor, &WeightProcessor::processWeight);
 
@@ -572,12 +593,23 @@ int main(int argc, char *argv[])
     // jump ahead of any normal-priority events already queued on the main thread (e.g. D-Flow
     // setpoint writes), preventing the 4+ second delivery delay seen on slow devices.
     QObject::connect(&weightProcessor, &WeightProcessor::stopNow,
-                     &weightProcessor, [&de1Device](qint64 sawTriggerMs) {
+                     &weightProcessor, [&de1Device](qint64 sawTriggerMs, qint64 arrivalMs, qint64 processMs) {
+                         SawLatencyTrace trace;
+                         trace.arrivalMs = arrivalMs;
+                         trace.processMs = processMs;
+                         trace.triggerMs = sawTriggerMs;
                          QCoreApplication::postEvent(&de1Device,
-                             new SawStopEvent(sawTriggerMs),
+                             new SawStopEvent(trace),
                              Qt::HighEventPriority);
                      }, Qt::DirectConnection);
 
+    // DE1Device → SawLatencyTracker: per-scale latency histograms for each traced
+    // SAW stop (debug page, MCP). Same scale type key as SAW learning.
+    QObject::connect(&de1Device, &DE1Device::sawStopTraced,
+                     &sawLatencyTracker, [&sawLatencyTracker, &settings](const SawLatencyTrace& trace) {
+                         sawLatencyTracker.record(settings.scaleType(), trace);
+                     });
+
     // WeightProcessor → MachineState: forward SAW trigger for QML "Target reached" display
     QObject::connect(&weightProcessor, &WeightProcessor::stopNow,
                      &machineState, [&machineState](qint64) {
@@ -1652,6 +1684,8 @@ int main(int argc, char *argv[])
         "MachineState is created in C++");
     qmlRegisterUncreatableType<AIConversation>("Decenza", 1, 0, "AIConversationType",
         "AIConversation is created in C++");
+    qmlRegisterUncreatableType<LiveShotAnalysis>("Decenza", 1, 0, "LiveShotAnalysisType",
+        "LiveShotAnalysis is created in C++");
     // Exposes SteamHealthTracker::BaselineState enum values to QML
     // (e.g. SteamHealthTrackerType.EstablishingAfterReset). The tracker
     // instance itself is available as the "SteamHealthTracker" context
@@ -1691,8 +1725,14 @@ int main(int argc, char *argv[])
     // Register strange attractor renderer (QQuickPaintedItem, no Quick3D dependency)
     qmlRegisterType<StrangeAttractorRenderer>("Decenza", 1, 0, "StrangeAttractorRenderer");
 
-    // Register fast line renderer for shot graph (QSGGeometryNode, pre-allocated VBO)
+    // Register fast line renderers: single series (steam graph) and the batched
+    // multi-series renderer the shot graph draws every live channel, goal and
+    // phase marker with
     qmlRegisterType<FastLineRenderer>("Decenza", 1, 0, "FastLineRenderer");
+    qmlRegisterType<FastMultiLineRenderer>("Decenza", 1, 0, "FastMultiLineRenderer");
+    qmlRegisterAnonymousType<FastSeries>("Decenza", 1);
+    qmlRegisterType<FastLineSeries>("Decenza", 1, 0, "FastLineSeries");
+    qmlRegisterType<FastSegmentSeries>("Decenza", 1, 0, "FastSegmentSeries");
 
 #ifdef ENABLE_QUICK3D
     // Register pipe geometry types for 3D pipes screensaver
@@ -2089,6 +2129,10 @@ int main(int argc, char *argv[])
             // before iOS can tear down CoreBluetooth. The bluetooth-central background mode
             // also helps by keeping CoreBluetooth alive longer during backgrounding.
             batteryManager.ensureChargerOn();
+
+            // Write debounced settings changes now — a backgrounded app can be
+            // killed without ever reaching aboutToQuit.
+            settings.sync();
         }
         else if (state == Qt::ApplicationActive && wasSuspended) {
             qDebug() << "App resumed from suspended state";
@@ -2099,8 +2143,9 @@ int main(int argc, char *argv[])
             QAccessible::setActive(true);
 #endif
 
-            // Sync settings from disk to ensure we have latest values
-            // (prevents theme colors from falling back to defaults on wake)
+            // Settings are served from SettingsStore's in-memory copy, so theme
+            // colors can't fall back to defaults on wake; this just writes out
+            // anything changed while suspended.
             settings.sync();
 
             // Try to reconnect/wake DE1 — reset the reconnect counter so we get
@@ -2208,7 +2253,7 @@ int main(int argc, char *argv[])
     });
 
     // Cleanup on exit
-    QObject::connect(&app, &QCoreApplication::aboutToQuit, [&accessibilityManager, &batteryManager, &de1Device, &de1ReconnectTimer, &physicalScale, &engine, &weightThread, &relayClient]() {
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [&accessibilityManager, &batteryManager, &de1Device, &de1ReconnectTimer, &physicalScale, &engine, &weightProcessor, &scaleIngest, &relayClient]() {
         qDebug() << "Application exiting - shutting down devices";
 
         // Stop relay client and screen capture FIRST — the capture timer grabs
@@ -2227,10 +2272,12 @@ int main(int argc, char *argv[])
             engine.rootObjects().constFirst()->setProperty("shuttingDown", true);
         }
 
-        // Stop weight processor thread first (before BLE shutdown).
+        // Stop weight processing first (before BLE shutdown).
         // Any pending SOW commands are no longer needed since we're exiting.
-        weightThread.quit();
-        weightThread.wait(1000);
+        // The ingest thread itself keeps running until the scale has disconnected.
+        QMetaObject::invokeMethod(&weightProcessor, [&weightProcessor]() {
+            weightProcessor.stopExtraction();
+        });
 
         bool needBleWait = false;
 
@@ -2308,6 +2355,8 @@ int main(int argc, char *argv[])
         if (physicalScale) {
             physicalScale->disconnectFromScale();
         }
+        // Scale transports live on the ingest thread: disconnect them there, then stop it
+        scaleIngest.stop();
 
         // Note: No need to null context properties here. All C++ objects are
         // stack-allocated before the QML engine, so reverse destruction order
@@ -2,9 +2,12 @@
 #include "mcpresourceregistry.h"
 #include "mcptoolregistry.h"
 #include "../ble/de1device.h"
+#include "../ble/de1transport.h"
 #include "../machine/machinestate.h"
+#include "../machine/sawlatencytracker.h"
 #include "../controllers/profilemanager.h"
 #include "../history/shothistorystorage.h"
+#include "../history/shotrecordcache.h"
 #include "../core/memorymonitor.h"
 #include "../core/settings.h"
 #include "../core/settings_dye.h"
@@ -274,11 +277,29 @@ void registerMcpResources(McpResourceRegistry* registry, DE1Device* device,
     registry->registerResource(
         "decenza://debug/memory",
         "Memory Stats",
-        "Current RSS, peak RSS, QObject count, and recent memory samples",
+        "Current RSS, peak RSS, QObject count, recent memory samples, decoded-shot cache hit/miss stats, "
+        "and DE1 BLE write queue depth/latency",
         "application/json",
-        [memoryMonitor]() -> QJsonObject {
+        [memoryMonitor, shotHistory, device]() -> QJsonObject {
             if (!memoryMonitor) return QJsonObject();
-            return memoryMonitor->toJson();
+            QJsonObject result = memoryMonitor->toJson();
+            if (shotHistory)
+                result["shotRecordCache"] = shotHistory->recordCache()->statsJson();
+            if (device && device->transport())
+                result["de1WriteQueue"] = device->transport()->queueStats();
+            return result;
+        });
+
+    // decenza://debug/saw-latency
+    registry->registerResource(
+        "decenza://debug/saw-latency",
+        "Stop-at-Weight Latency",
+        "Per-scale-type histograms of SAW stop latency, kept across sessions: scale notification -> "
+        "WeightProcessor -> stop signal -> urgent BLE write -> write ack -> DE1 state change",
+        "application/json",
+        []() -> QJsonObject {
+            auto* tracker = SawLatencyTracker::instance();
+            return tracker ? tracker->toJson() : QJsonObject();
         });
 }
 
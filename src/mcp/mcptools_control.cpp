@@ -367,7 +367,10 @@ void registerControlTools(McpToolRegistry* registry, DE1Device* device, MachineS
                 result["error"] = "Theme name is required";
                 return result;
             }
-            settings->theme()->applyPresetTheme(name);
+            {
+                Settings::Transaction transaction(settings, QStringLiteral("applyPresetTheme"));
+                settings->theme()->applyPresetTheme(name);
+            }
             result["success"] = true;
             result["message"] = "Applied theme: " + name;
             return result;
@@ -1,12 +1,12 @@
 #include "mcpserver.h"
 #include "mcptoolregistry.h"
 #include "../history/shothistorystorage.h"
+#include "../history/shotrecordcache.h"
 #include "../controllers/maincontroller.h"
 #include "../controllers/profilemanager.h"
 #include "../ai/aimanager.h"
 #include "../ai/shotsummarizer.h"
 #include "../core/settings.h"
-#include "../core/settings_dye.h"
 #include "../profile/profile.h"
 
 #include <QDateTime>
@@ -22,14 +22,46 @@
 
 #include "../core/dbutils.h"
 
-// Data collected on the background thread (pure SQL results, no QObject access)
+// Data collected on the background thread (SQL results and settings snapshot reads, no QObject access)
 struct DialingDbResult {
     QVariantMap shotData;
     QString profileKbId;
     QJsonArray dialInHistory;
     QJsonObject grinderContext;
+    QJsonObject currentBean;
 };
 
+// Current DYE bean/grinder metadata. Reads a settings snapshot (keys and
+// defaults as in SettingsDye), so it runs on the query thread.
+static QJsonObject currentBeanFromSnapshot(const SettingsSnapshot& s)
+{
+    QJsonObject bean;
+    bean["brand"] = s.get<QString>("dye/beanBrand");
+    bean["type"] = s.get<QString>("dye/beanType");
+    bean["roastDate"] = s.get<QString>("dye/roastDate");
+    bean["roastLevel"] = s.get<QString>("dye/roastLevel");
+    bean["grinderBrand"] = s.get<QString>("dye/grinderBrand");
+    bean["grinderModel"] = s.get<QString>("dye/grinderModel");
+    bean["grinderBurrs"] = s.get<QString>("dye/grinderBurrs");
+    bean["grinderSetting"] = s.get<QString>("dye/grinderSetting");
+    bean["doseWeightG"] = s.get<double>("dye/beanWeight", 18.0);
+    const QString roastDateStr = s.get<QString>("dye/roastDate");
+    if (!roastDateStr.isEmpty()) {
+        QDate roastDate = QDate::fromString(roastDateStr, "yyyy-MM-dd");
+        if (!roastDate.isValid()) roastDate = QDate::fromString(roastDateStr, Qt::ISODate);
+        if (!roastDate.isValid()) roastDate = QDate::fromString(roastDateStr, "MM/dd/yyyy");
+        if (!roastDate.isValid()) roastDate = QDate::fromString(roastDateStr, "dd/MM/yyyy");
+
+        if (roastDate.isValid()) {
+            qint64 days = roastDate.daysTo(QDate::currentDate());
+            bean["daysSinceRoast"] = days;
+            bean["daysSinceRoastNote"] = "Days since roast date, NOT freshness. "
+                "Many users freeze beans and thaw weekly — ask about storage before assuming degradation.";
+        }
+    }
+    return bean;
+}
+
 void registerDialingTools(McpToolRegistry* registry, MainController* mainController,
                           ProfileManager* profileManager,
                           ShotHistoryStorage* shotHistory, Settings* settings)
@@ -66,9 +98,12 @@ void registerDialingTools(McpToolRegistry* registry, MainController* mainControl
                 shotId = shotHistory->lastSavedShotId();
 
             const QString dbPath = shotHistory->databasePath();
+            auto cache = shotHistory->recordCache();
+            // Settings as of the request; read on the thread below
+            auto settingsSnapshot = settings ? settings->snapshot() : nullptr;
 
             QThread* thread = QThread::create(
-                [dbPath, shotId, historyLimit, mainController, profileManager, settings, respond]() {
+                [dbPath, cache, shotId, historyLimit, mainController, profileManager, settingsSnapshot, respond]() {
                 // --- All SQL runs on this background thread ---
                 DialingDbResult dbResult;
 
@@ -91,9 +126,9 @@ void registerDialingTools(McpToolRegistry* registry, MainController* mainControl
                 }
 
                 withTempDb(dbPath, "mcp_dialing", [&](QSqlDatabase& db) {
-                    ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, resolvedShotId);
-                    dbResult.shotData = ShotHistoryStorage::convertShotRecord(record);
-                    dbResult.profileKbId = record.profileKbId;
+                    const auto record = ShotHistoryStorage::loadShotRecordCached(db, resolvedShotId, cache.get());
+                    dbResult.shotData = ShotHistoryStorage::convertShotRecord(*record);
+                    dbResult.profileKbId = record->profileKbId;
 
                     // --- Dial-in history (same profile family) ---
                     if (!dbResult.profileKbId.isEmpty()) {
@@ -167,10 +202,13 @@ void registerDialingTools(McpToolRegistry* registry, MainController* mainControl
                     }
                 });
 
+                if (settingsSnapshot)
+                    dbResult.currentBean = currentBeanFromSnapshot(*settingsSnapshot);
+
                 // --- Deliver results to main thread for final assembly ---
-                // Main-thread work: settings access, AI analysis, profile info
+                // Main-thread work: AI analysis, profile info
                 QMetaObject::invokeMethod(qApp,
-                    [respond, dbResult, resolvedShotId, mainController, profileManager, settings]() {
+                    [respond, dbResult, resolvedShotId, mainController, profileManager]() {
 
                     if (dbResult.shotData.isEmpty()) {
                         respond(QJsonObject{{"error", "Shot not found: " + QString::number(resolvedShotId)}});
@@ -225,34 +263,9 @@ void registerDialingTools(McpToolRegistry* registry, MainController* mainControl
                     if (!profileKnowledge.isEmpty())
                         result["profileKnowledge"] = profileKnowledge;
 
-                    // --- Bean/grinder metadata (current DYE settings) ---
-                    if (settings) {
-                        QJsonObject bean;
-                        bean["brand"] = settings->dye()->dyeBeanBrand();
-                        bean["type"] = settings->dye()->dyeBeanType();
-                        bean["roastDate"] = settings->dye()->dyeRoastDate();
-                        bean["roastLevel"] = settings->dye()->dyeRoastLevel();
-                        bean["grinderBrand"] = settings->dye()->dyeGrinderBrand();
-                        bean["grinderModel"] = settings->dye()->dyeGrinderModel();
-                        bean["grinderBurrs"] = settings->dye()->dyeGrinderBurrs();
-                        bean["grinderSetting"] = settings->dye()->dyeGrinderSetting();
-                        bean["doseWeightG"] = settings->dye()->dyeBeanWeight();
-                        QString roastDateStr = settings->dye()->dyeRoastDate();
-                        if (!roastDateStr.isEmpty()) {
-                            QDate roastDate = QDate::fromString(roastDateStr, "yyyy-MM-dd");
-                            if (!roastDate.isValid()) roastDate = QDate::fromString(roastDateStr, Qt::ISODate);
-                            if (!roastDate.isValid()) roastDate = QDate::fromString(roastDateStr, "MM/dd/yyyy");
-                            if (!roastDate.isValid()) roastDate = QDate::fromString(roastDateStr, "dd/MM/yyyy");
-
-                            if (roastDate.isValid()) {
-                                qint64 days = roastDate.daysTo(QDate::currentDate());
-                                bean["daysSinceRoast"] = days;
-                                bean["daysSinceRoastNote"] = "Days since roast date, NOT freshness. "
-                                    "Many users freeze beans and thaw weekly — ask about storage before assuming degradation.";
-                            }
-                        }
-                        result["currentBean"] = bean;
-                    }
+                    // --- Bean/grinder metadata (current DYE settings, read on the query thread) ---
+                    if (!dbResult.currentBean.isEmpty())
+                        result["currentBean"] = dbResult.currentBean;
 
                     // --- Current profile info ---
                     if (profileManager) {
@@ -205,7 +205,8 @@ void registerMachineTools(McpToolRegistry* registry, DE1Device* device,
     // machine_get_telemetry
     registry->registerTool(
         "machine_get_telemetry",
-        "Get live telemetry: pressure, flow, temperature, weight, goal values. During a shot, also returns time-series data so far.",
+        "Get live telemetry: pressure, flow, temperature, weight, goal values. During a shot, also returns time-series data so far "
+        "and liveAnalysis (channeling severity, grind direction, pour-not-pressurizing as detected mid-shot).",
         QJsonObject{{"type", "object"}, {"properties", QJsonObject{}}},
         [device, machineState, mainController](const QJsonObject&) -> QJsonObject {
             QJsonObject result;
@@ -250,6 +251,9 @@ void registerMachineTools(McpToolRegistry* registry, DE1Device* device,
                     result["temperatureData"] = pointsToArray(model->temperatureData());
                     result["weightData"] = pointsToArray(model->weightData());
                 }
+                // Streaming channeling / grind / pour-not-pressurizing verdicts so far
+                if (auto* live = mainController->liveShotAnalysis(); live && live->isActive())
+                    result["liveAnalysis"] = live->toJson();
             }
             return result;
         },
@@ -1,6 +1,7 @@
 #include "mcpserver.h"
 #include "mcptoolregistry.h"
 #include "../history/shothistorystorage.h"
+#include "../history/shotrecordcache.h"
 #include "../core/dbutils.h"
 
 #include <QDateTime>
@@ -219,13 +220,14 @@ void registerShotTools(McpToolRegistry* registry, ShotHistoryStorage* shotHistor
             }
 
             const QString dbPath = shotHistory->databasePath();
+            auto cache = shotHistory->recordCache();
 
-            QThread* thread = QThread::create([dbPath, shotId, respond]() {
+            QThread* thread = QThread::create([dbPath, cache, shotId, respond]() {
                 QJsonObject result;
 
                 if (!withTempDb(dbPath, "mcp_shot_detail", [&](QSqlDatabase& db) {
-                    ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, shotId);
-                    QVariantMap shotMap = ShotHistoryStorage::convertShotRecord(record);
+                    QVariantMap shotMap = ShotHistoryStorage::convertShotRecord(
+                        *ShotHistoryStorage::loadShotRecordCached(db, shotId, cache.get()));
                     if (!shotMap.isEmpty()) {
                         result = QJsonObject::fromVariantMap(shotMap);
                     } else {
@@ -281,16 +283,17 @@ void registerShotTools(McpToolRegistry* registry, ShotHistoryStorage* shotHistor
             }
 
             const QString dbPath = shotHistory->databasePath();
+            auto cache = shotHistory->recordCache();
 
-            QThread* thread = QThread::create([dbPath, idArray, respond]() {
+            QThread* thread = QThread::create([dbPath, cache, idArray, respond]() {
                 QJsonObject result;
                 QJsonArray shots;
 
                 if (!withTempDb(dbPath, "mcp_compare", [&](QSqlDatabase& db) {
                     for (const auto& idVal : idArray) {
                         qint64 shotId = idVal.toInteger();
-                        ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, shotId);
-                        QVariantMap shotMap = ShotHistoryStorage::convertShotRecord(record);
+                        QVariantMap shotMap = ShotHistoryStorage::convertShotRecord(
+                            *ShotHistoryStorage::loadShotRecordCached(db, shotId, cache.get()));
                         if (!shotMap.isEmpty())
                             shots.append(QJsonObject::fromVariantMap(shotMap));
                     }
@@ -1,11 +1,14 @@
 #include "shotcomparisonmodel.h"
 #include "../history/shothistorystorage.h"
+#include "../history/shotrecordcache.h"
+#include "../ai/curveindex.h"
 
 #include <QDateTime>
 #include <QLocale>
 #include <QSqlDatabase>
 #include "../core/dbutils.h"
 #include <QThread>
+#include <QHash>
 #include <algorithm>
 #include <QtCharts/QXYSeries>
 
@@ -182,6 +185,28 @@ void ShotComparisonModel::scheduleLoad()
     for (int i = m_windowStart; i < windowEnd; ++i)
         windowIds.append(m_shotIds[i]);
 
+    // Take what the decoded-shot cache already has; only the misses go to the DB
+    auto cache = m_storage->recordCache();
+    QList<std::shared_ptr<const ShotRecord>> cached;
+    QList<qint64> missingIds;
+    QList<quint64> missingRevisions;  // Taken before the read, see ShotRecordCache
+    for (qint64 id : windowIds) {
+        cached.append(cache->find(id));
+        if (!cached.last()) {
+            missingIds.append(id);
+            missingRevisions.append(cache->revision(id));
+        }
+    }
+
+    if (missingIds.isEmpty()) {
+        QList<ComparisonShot> shots;
+        for (const auto& record : cached)
+            shots.append(toComparisonShot(*record));
+        applyWindow(std::move(shots));
+        prefetchNeighbours();
+        return;
+    }
+
     const QString dbPath = m_storage->databasePath();
 
     if (!m_loading) {
@@ -189,70 +214,33 @@ void ShotComparisonModel::scheduleLoad()
         emit loadingChanged();
     }
 
-    // Open a dedicated SQLite connection on the worker thread, load the shots,
-    // and deliver results back to the main thread via a queued invocation.
+    // Open a dedicated SQLite connection on the worker thread, load the missing
+    // shots, and deliver results back to the main thread via a queued invocation.
     // Qt guarantees the functor is not called if `this` is already destroyed.
-    QThread* thread = QThread::create([this, dbPath, windowIds, serial]() {
-        QList<ComparisonShot> shots;
+    QThread* thread = QThread::create([this, dbPath, windowIds, cached, missingIds, missingRevisions, cache, serial]() {
+        QHash<qint64, std::shared_ptr<const ShotRecord>> loaded;
         withTempDb(dbPath, "scm_load", [&](QSqlDatabase& db) {
-            for (qint64 id : windowIds) {
-                ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, id);
-                if (record.summary.id == 0) continue;
-
-                ComparisonShot shot;
-                shot.id = record.summary.id;
-                shot.profileName = record.summary.profileName;
-                shot.beanBrand = record.summary.beanBrand;
-                shot.beanType = record.summary.beanType;
-                shot.roastDate = record.roastDate;
-                shot.roastLevel = record.roastLevel;
-                shot.grinderBrand = record.grinderBrand;
-                shot.grinderModel = record.grinderModel;
-                shot.grinderBurrs = record.grinderBurrs;
-                shot.grinderSetting = record.grinderSetting;
-                shot.duration = record.summary.duration;
-                shot.doseWeight = record.summary.doseWeight;
-                shot.finalWeight = record.summary.finalWeight;
-                shot.drinkTds = record.drinkTds;
-                shot.drinkEy = record.drinkEy;
-                shot.enjoyment = record.summary.enjoyment;
-                shot.timestamp = record.summary.timestamp;
-                shot.notes = record.espressoNotes;
-                shot.barista = record.barista;
-                shot.temperatureOverride = record.temperatureOverride;
-                shot.yieldOverride = record.yieldOverride;
-                shot.pressure = record.pressure;
-                shot.flow = record.flow;
-                shot.temperature = record.temperature;
-                shot.weight = record.weight;
-                shot.weightFlowRate = record.weightFlowRate;
-                shot.resistance = record.resistance;
-                shot.conductance = record.conductance;
-                shot.conductanceDerivative = record.conductanceDerivative;
-                shot.darcyResistance = record.darcyResistance;
-                shot.temperatureMix = record.temperatureMix;
-
-                for (const auto& phase : record.phases) {
-                    ComparisonShot::PhaseMarker marker;
-                    marker.time = phase.time;
-                    marker.label = phase.label;
-                    marker.transitionReason = phase.transitionReason;
-                    shot.phases.append(marker);
-                }
-
-                shots.append(shot);
+            for (qsizetype i = 0; i < missingIds.size(); ++i) {
+                auto record = std::make_shared<const ShotRecord>(
+                    ShotHistoryStorage::loadShotRecordStatic(db, missingIds[i]));
+                cache->insert(missingRevisions[i], record);
+                loaded.insert(missingIds[i], std::move(record));
             }
         });
 
+        QList<ComparisonShot> shots;
+        for (qsizetype i = 0; i < windowIds.size(); ++i) {
+            const auto record = cached[i] ? cached[i] : loaded.value(windowIds[i]);
+            if (!record || record->summary.id == 0) continue;
+            shots.append(toComparisonShot(*record));
+        }
+
         // Post results back to the main thread.
         // Qt discards this call automatically if `this` has been destroyed.
         QMetaObject::invokeMethod(this, [this, shots = std::move(shots), serial]() mutable {
             if (serial != m_loadSerial) return;  // superseded by a newer load
-            m_displayShots = std::move(shots);
-            calculateMaxValues();
-            m_loading = false;
-            emit loadingChanged();
-            emit shotsChanged();
+            applyWindow(std::move(shots));
+            prefetchNeighbours();
         }, Qt::QueuedConnection);
     });
 
@@ -261,6 +249,99 @@ void ShotComparisonModel::scheduleLoad()
     thread->start();
 }
 
+void ShotComparisonModel::applyWindow(QList<ComparisonShot> shots)
+{
+    m_displayShots = std::move(shots);
+    calculateMaxValues();
+    if (m_loading) {
+        m_loading = false;
+        emit loadingChanged();
+    }
+    emit shotsChanged();
+}
+
+void ShotComparisonModel::prefetchNeighbours()
+{
+    if (!m_storage || (m_prefetchThread && m_prefetchThread->isRunning())) return;
+
+    auto cache = m_storage->recordCache();
+    const int shotCount = static_cast<int>(m_shotIds.size());
+    const int windowEnd = std::min(m_windowStart + DISPLAY_WINDOW_SIZE, shotCount);
+
+    // Nearest first, so a quick single shift is the likeliest to be covered
+    QList<qint64> ids;
+    for (int step = 1; step <= DISPLAY_WINDOW_SIZE; ++step) {
+        const int right = windowEnd - 1 + step;
+        const int left = m_windowStart - step;
+        if (right < shotCount && !cache->contains(m_shotIds[right]))
+            ids.append(m_shotIds[right]);
+        if (left >= 0 && !cache->contains(m_shotIds[left]))
+            ids.append(m_shotIds[left]);
+    }
+    if (ids.isEmpty()) return;
+
+    const QString dbPath = m_storage->databasePath();
+    QThread* thread = QThread::create([dbPath, ids, cache]() {
+        withTempDb(dbPath, "scm_prefetch", [&](QSqlDatabase& db) {
+            for (qint64 id : ids) {
+                if (cache->contains(id)) continue;  // Loaded meanwhile (e.g. by the detail page)
+                const quint64 revision = cache->revision(id);
+                cache->insert(revision, std::make_shared<const ShotRecord>(
+                    ShotHistoryStorage::loadShotRecordStatic(db, id)));
+            }
+        });
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    m_prefetchThread = thread;
+    thread->start();
+}
+
+ShotComparisonModel::ComparisonShot ShotComparisonModel::toComparisonShot(const ShotRecord& record)
+{
+    ComparisonShot shot;
+    shot.id = record.summary.id;
+    shot.profileName = record.summary.profileName;
+    shot.beanBrand = record.summary.beanBrand;
+    shot.beanType = record.summary.beanType;
+    shot.roastDate = record.roastDate;
+    shot.roastLevel = record.roastLevel;
+    shot.grinderBrand = record.grinderBrand;
+    shot.grinderModel = record.grinderModel;
+    shot.grinderBurrs = record.grinderBurrs;
+    shot.grinderSetting = record.grinderSetting;
+    shot.duration = record.summary.duration;
+    shot.doseWeight = record.summary.doseWeight;
+    shot.finalWeight = record.summary.finalWeight;
+    shot.drinkTds = record.drinkTds;
+    shot.drinkEy = record.drinkEy;
+    shot.enjoyment = record.summary.enjoyment;
+    shot.timestamp = record.summary.timestamp;
+    shot.notes = record.espressoNotes;
+    shot.barista = record.barista;
+    shot.temperatureOverride = record.temperatureOverride;
+    shot.yieldOverride = record.yieldOverride;
+    shot.pressure = record.pressure;
+    shot.flow = record.flow;
+    shot.temperature = record.temperature;
+    shot.weight = record.weight;
+    shot.weightFlowRate = record.weightFlowRate;
+    shot.resistance = record.resistance;
+    shot.conductance = record.conductance;
+    shot.conductanceDerivative = record.conductanceDerivative;
+    shot.darcyResistance = record.darcyResistance;
+    shot.temperatureMix = record.temperatureMix;
+
+    for (const auto& phase : record.phases) {
+        ComparisonShot::PhaseMarker marker;
+        marker.time = phase.time;
+        marker.label = phase.label;
+        marker.transitionReason = phase.transitionReason;
+        shot.phases.append(marker);
+    }
+    return shot;
+}
+
 void ShotComparisonModel::calculateMaxValues()
 {
     m_maxTime = 0.0;
@@ -469,19 +550,8 @@ QVariantMap ShotComparisonModel::getValuesAtTime(int index, double time) const
 
     // Returns the Y value of the nearest point within 1 second, or -1.0 if none.
     auto findNearest = [](const QVector<QPointF>& points, double t) -> double {
-        if (points.isEmpty()) return -1.0;
-        double closest = points[0].y();
-        double minDist = std::abs(points[0].x() - t);
-        for (const auto& pt : points) {
-            double dist = std::abs(pt.x() - t);
-            if (dist < minDist) {
-                minDist = dist;
-                closest = pt.y();
-            } else if (dist > minDist) {
-                break;  // data sorted by x
-            }
-        }
-        return minDist < 1.0 ? closest : -1.0;
+        const qsizetype i = CurveIndex::nearest(points, t);
+        return (i >= 0 && std::abs(points[i].x() - t) < 1.0) ? points[i].y() : -1.0;
     };
 
     double pressure    = findNearest(shot.pressure, time);
@@ -496,18 +566,13 @@ QVariantMap ShotComparisonModel::getValuesAtTime(int index, double time) const
 
     // dC/dt uses a sentinel distinct from flow/pressure (it legitimately ranges
     // negative). findNearest returns -1.0 for "missing", but a real dC/dt value
-    // could be -1.0, so we use a custom lookup for this series.
+    // could be -1.0, so we check the lookup distance for this series directly.
     bool hasDcdt = false;
     double dcdt = 0.0;
-    if (!shot.conductanceDerivative.isEmpty()) {
-        double best = shot.conductanceDerivative[0].y();
-        double minDist = std::abs(shot.conductanceDerivative[0].x() - time);
-        for (const auto& pt : shot.conductanceDerivative) {
-            double dist = std::abs(pt.x() - time);
-            if (dist < minDist) { minDist = dist; best = pt.y(); }
-            else if (dist > minDist) break;
-        }
-        if (minDist < 1.0) { dcdt = best; hasDcdt = true; }
+    const qsizetype dcdtIndex = CurveIndex::nearest(shot.conductanceDerivative, time);
+    if (dcdtIndex >= 0 && std::abs(shot.conductanceDerivative[dcdtIndex].x() - time) < 1.0) {
+        dcdt = shot.conductanceDerivative[dcdtIndex].y();
+        hasDcdt = true;
     }
 
     result["hasPressure"]    = pressure    >= 0.0;
@@ -6,6 +6,7 @@
 #include <QVariantList>
 #include <QColor>
 #include <QThread>
+#include <QPointer>
 
 class ShotHistoryStorage;
 struct ShotRecord;
@@ -97,9 +98,14 @@ signals:
     void errorOccurred(const QString& message);
 
 private:
-    // Start a background QThread that opens its own SQLite connection, loads the
-    // current window, and delivers results back to the main thread via finished().
+    // Load the current window. Shots already in the storage's decoded-shot cache
+    // are used directly; the rest are loaded on a background QThread with its own
+    // SQLite connection and delivered back to the main thread. When every shot
+    // is cached the window is applied synchronously.
     void scheduleLoad();
+    // Warm the cache with the shots one window either side of the current one,
+    // so shiftWindowLeft/Right usually hit it. At most one prefetch runs at a time.
+    void prefetchNeighbours();
     void calculateMaxValues();
     QVariantList pointsToVariant(const QVector<QPointF>& points) const;
 
@@ -145,6 +151,9 @@ private:
         QList<PhaseMarker> phases;
     };
 
+    static ComparisonShot toComparisonShot(const ShotRecord& record);
+    void applyWindow(QList<ComparisonShot> shots);
+
     ShotHistoryStorage* m_storage = nullptr;
     QList<qint64> m_shotIds;
     QList<ComparisonShot> m_displayShots;
@@ -152,6 +161,7 @@ private:
     bool m_loading = false;
     QThread* m_loadThread = nullptr;  // Tracked so superseded loads can be abandoned
     int m_loadSerial = 0;             // Incremented on each scheduleLoad(); stale results ignored
+    QPointer<QThread> m_prefetchThread;
 
     double m_maxTime = 60.0;
     double m_maxPressure = 12.0;
@@ -1,8 +1,35 @@
 #include "shotdatamodel.h"
 #include "ai/conductance.h"
-#include "rendering/fastlinerenderer.h"
+#include "history/shotsnapshot.h"
+#include "rendering/fastmultilinerenderer.h"
+#include "rendering/fastsegmentseries.h"
 #include <QDebug>
 
+namespace {
+// Appends goal points recorded since the last flush, breaking the line
+// wherever a new pump-mode segment began.
+void flushGoalSegments(FastSegmentSeries* series, const QVector<QVector<QPointF>>& segments,
+                       qsizetype& segment, qsizetype& point) {
+    while (segment < segments.size()) {
+        const QVector<QPointF>& points = segments[segment];
+        for (; point < points.size(); ++point)
+            series->appendPoint(points[point].x(), points[point].y());
+        if (segment + 1 >= segments.size())
+            break;
+        series->breakSegment();
+        ++segment;
+        point = 0;
+    }
+}
+
+// Vertical phase marker line on the pressure axis (0-12 bar)
+void appendMarkerLine(FastSegmentSeries* series, double time) {
+    series->breakSegment();
+    series->appendPoint(time, 0);
+    series->appendPoint(time, 12);
+}
+}
+
 ShotDataModel::ShotDataModel(QObject* parent)
     : QObject(parent)
 {
@@ -39,57 +66,55 @@ ShotDataModel::~ShotDataModel() {
     }
 }
 
-void ShotDataModel::registerSeries(const QVariantList& pressureGoalSegments, const QVariantList& flowGoalSegments,
-                                    QLineSeries* temperatureGoal,
-                                    QLineSeries* extractionMarker,
-                                    QLineSeries* stopMarker,
-                                    const QVariantList& frameMarkers) {
+void ShotDataModel::registerSeries(FastSegmentSeries* pressureGoal, FastSegmentSeries* flowGoal,
+                                    FastSegmentSeries* temperatureGoal,
+                                    FastSegmentSeries* extractionMarker,
+                                    FastSegmentSeries* stopMarker,
+                                    FastSegmentSeries* frameMarkers) {
+    m_pressureGoalSeries = pressureGoal;
+    m_flowGoalSeries = flowGoal;
     m_temperatureGoalSeries = temperatureGoal;
     m_extractionMarkerSeries = extractionMarker;
     m_stopMarkerSeries = stopMarker;
+    m_frameMarkerSeries = frameMarkers;
 
-    // Register pressure goal segment series
-    m_pressureGoalSeriesList.clear();
-    for (const QVariant& v : pressureGoalSegments) {
-        if (auto* series = qobject_cast<QLineSeries*>(v.value<QObject*>())) {
-            m_pressureGoalSeriesList.append(series);
-        }
-    }
-
-    // Register flow goal segment series
-    m_flowGoalSeriesList.clear();
-    for (const QVariant& v : flowGoalSegments) {
-        if (auto* series = qobject_cast<QLineSeries*>(v.value<QObject*>())) {
-            m_flowGoalSeriesList.append(series);
-        }
+    // Replay everything the model already holds (e.g., returning to espresso
+    // page after shot): goals from the start, and every marker, not just the
+    // ones still pending.
+    for (FastSegmentSeries* series : {pressureGoal, flowGoal, temperatureGoal,
+                                      extractionMarker, stopMarker, frameMarkers}) {
+        if (series) series->clear();
     }
+    m_lastFlushedPressureGoalSegment = 0;
+    m_lastFlushedPressureGoal = 0;
+    m_lastFlushedFlowGoalSegment = 0;
+    m_lastFlushedFlowGoal = 0;
+    m_lastFlushedTemperatureGoal = 0;
 
-    m_frameMarkerSeries.clear();
-    for (const QVariant& v : frameMarkers) {
-        if (auto* series = qobject_cast<QLineSeries*>(v.value<QObject*>())) {
-            m_frameMarkerSeries.append(series);
-        }
+    m_pendingMarkers.clear();
+    for (const PhaseMarker& marker : m_phaseMarkers) {
+        if (marker.label == "End" && marker.frameNumber < 0)
+            continue;  // markStopAt()'s marker, drawn from m_stopTime
+        m_pendingMarkers.append({marker.time, marker.label});
     }
+    m_pendingStopTime = m_stopTime;
 
     qDebug() << "ShotDataModel: Registered goal/marker series";
 
-    // If we have existing goal/marker data, flush it
-    if (!m_pressureGoalSegments[0].isEmpty() || !m_pendingMarkers.isEmpty()) {
-        m_dirty = true;
-        onFlushTimerTick();
-    }
+    m_dirty = true;
+    onFlushTimerTick();
 
     // Start the flush timer
     m_flushTimer->start();
 }
 
-void ShotDataModel::registerFastSeries(FastLineRenderer* pressure, FastLineRenderer* flow,
-                                        FastLineRenderer* temperature,
-                                        FastLineRenderer* weight, FastLineRenderer* weightFlow,
-                                        FastLineRenderer* resistance,
-                                        FastLineRenderer* conductance,
-                                        FastLineRenderer* darcyResistance,
-                                        FastLineRenderer* temperatureMix) {
+void ShotDataModel::registerFastSeries(FastLineSeries* pressure, FastLineSeries* flow,
+                                        FastLineSeries* temperature,
+                                        FastLineSeries* weight, FastLineSeries* weightFlow,
+                                        FastLineSeries* resistance,
+                                        FastLineSeries* conductance,
+                                        FastLineSeries* darcyResistance,
+                                        FastLineSeries* temperatureMix) {
     m_fastPressure = pressure;
     m_fastFlow = flow;
     m_fastTemperature = temperature;
@@ -113,7 +138,7 @@ void ShotDataModel::registerFastSeries(FastLineRenderer* pressure, FastLineRende
 
     // Bulk-load any existing data (e.g., returning to espresso page after shot)
     if (!m_pressurePoints.isEmpty() || !m_flowPoints.isEmpty() || !m_weightPoints.isEmpty()) {
-        qDebug() << "ShotDataModel: Populating fast renderers with existing data ("
+        qDebug() << "ShotDataModel: Populating fast series with existing data ("
                  << m_pressurePoints.size() << " pressure,"
                  << m_flowPoints.size() << " flow,"
                  << m_weightPoints.size() << " weight,"
@@ -140,13 +165,16 @@ void ShotDataModel::registerFastSeries(FastLineRenderer* pressure, FastLineRende
         m_lastFlushedTemperatureMix = m_temperatureMixPoints.size();
     }
 
-    qDebug() << "ShotDataModel: Registered fast renderers (QSGGeometryNode, pre-allocated VBO)";
+    qDebug() << "ShotDataModel: Registered fast series (batched FastMultiLineRenderer)";
 }
 
 void ShotDataModel::clear() {
     // Stop timer during clear
     m_flushTimer->stop();
 
+    // Invalidates any snapshot still being processed for the previous shot
+    ++m_generation;
+
     // Clear data vectors (keep capacity)
     m_pressurePoints.clear();
     m_flowPoints.clear();
@@ -172,7 +200,7 @@ void ShotDataModel::clear() {
     m_flowGoalSegments.append(QVector<QPointF>());
     m_flowGoalSegments[0].reserve(INITIAL_CAPACITY);
 
-    // Clear fast renderers
+    // Clear fast series
     if (m_fastPressure) m_fastPressure->clear();
     if (m_fastFlow) m_fastFlow->clear();
     if (m_fastTemperature) m_fastTemperature->clear();
@@ -192,27 +220,22 @@ void ShotDataModel::clear() {
     m_lastFlushedDarcyResistance = 0;
     m_lastFlushedTemperatureMix = 0;
 
-    // Clear goal/marker chart series
+    // Clear goal/marker series
+    if (m_pressureGoalSeries) m_pressureGoalSeries->clear();
+    if (m_flowGoalSeries) m_flowGoalSeries->clear();
     if (m_temperatureGoalSeries) m_temperatureGoalSeries->clear();
     if (m_extractionMarkerSeries) m_extractionMarkerSeries->clear();
     if (m_stopMarkerSeries) m_stopMarkerSeries->clear();
+    if (m_frameMarkerSeries) m_frameMarkerSeries->clear();
+    m_lastFlushedPressureGoalSegment = 0;
+    m_lastFlushedPressureGoal = 0;
+    m_lastFlushedFlowGoalSegment = 0;
+    m_lastFlushedFlowGoal = 0;
+    m_lastFlushedTemperatureGoal = 0;
     m_pendingStopTime = -1;
     m_stopTime = -1;
     m_weightAtStop = 0.0;
 
-    // Clear all goal segment series
-    for (const auto& series : m_pressureGoalSeriesList) {
-        if (series) series->clear();
-    }
-    for (const auto& series : m_flowGoalSeriesList) {
-        if (series) series->clear();
-    }
-
-    for (const auto& series : m_frameMarkerSeries) {
-        if (series) series->clear();
-    }
-
-    m_frameMarkerIndex = 0;
     m_phaseMarkers.clear();
     m_maxTime = 5.0;
     m_rawTime = 0.0;
@@ -419,93 +442,82 @@ void ShotDataModel::markStopAt(double time) {
 }
 
 void ShotDataModel::smoothWeightFlowRate(int window) {
-    // Save raw copy before smoothing (for by_weight_raw export)
-    m_weightFlowRateRawPoints = m_weightFlowRatePoints;
-
-    qsizetype n = m_weightFlowRatePoints.size();
-    if (n < 3) return;
-
-    // Centered moving average: each point averages with `window` neighbors on each side.
-    // With window=5 and ~5Hz data, this spans ~2.2s on top of the 1s LSLR recording window
-    // and the real-time EMA smoothing. X values (timestamps) are preserved.
-    QVector<QPointF> smoothed;
-    smoothed.reserve(n);
-    for (qsizetype i = 0; i < n; i++) {
-        qsizetype lo = qMax(qsizetype(0), i - window);
-        qsizetype hi = qMin(n - 1, i + window);
-        double sum = 0;
-        for (qsizetype j = lo; j <= hi; j++) {
-            sum += m_weightFlowRatePoints[j].y();
-        }
-        smoothed.append(QPointF(m_weightFlowRatePoints[i].x(), sum / (hi - lo + 1)));
-    }
-    m_weightFlowRatePoints = smoothed;
+    ShotSnapshot processed = snapshot();
+    processed.smoothWeightFlowRate(window);
+    applyProcessedSnapshot(processed);
 }
 
 void ShotDataModel::computeConductanceDerivative() {
-    // Delegate to Conductance::derivative so ShotDataModel (per-sample live
-    // data) and tools/shot_eval (batch offline data) share one formula —
-    // keeps live-graph curves identical to offline-evaluation curves.
-    m_conductanceDerivativePoints = Conductance::derivative(m_conductancePoints);
-    qDebug() << "ShotDataModel: Computed conductance derivative ("
-             << m_conductanceDerivativePoints.size() << " points)";
+    ShotSnapshot processed = snapshot();
+    processed.computeConductanceDerivative();
+    applyProcessedSnapshot(processed);
 }
 
 void ShotDataModel::trimSettlingData() {
-    // Find the last sample with non-zero pressure — samples after this are from the
-    // SAW settling period where the DE1 reports 0 pressure/flow while the scale settles.
-    // De1app stops recording at the end of pouring substate; we trim at save time to
-    // preserve live drip visualization during settling but produce clean history graphs.
-    qsizetype trimIndex = m_pressurePoints.size();
-    while (trimIndex > 0 && m_pressurePoints[trimIndex - 1].y() <= 0.0) {
-        --trimIndex;
-    }
-
-    if (trimIndex >= m_pressurePoints.size()) {
-        return;  // Nothing to trim
-    }
+    ShotSnapshot processed = snapshot();
+    if (processed.trimSettlingData())
+        applyProcessedSnapshot(processed);
+}
 
-    if (trimIndex == 0) {
-        qWarning() << "[ShotDataModel] trimSettlingData: all" << m_pressurePoints.size()
-                   << "samples have zero pressure — skipping trim to preserve data";
-        return;
-    }
+ShotSnapshot ShotDataModel::snapshot() const {
+    // Implicitly-shared copies: no sample data is walked here, so this is safe
+    // to call on the GUI thread at shot end regardless of shot length.
+    ShotSnapshot s;
+    s.generation = m_generation;
+    s.pressure = m_pressurePoints;
+    s.flow = m_flowPoints;
+    s.temperature = m_temperaturePoints;
+    s.temperatureMix = m_temperatureMixPoints;
+    s.resistance = m_resistancePoints;
+    s.conductance = m_conductancePoints;
+    s.darcyResistance = m_darcyResistancePoints;
+    s.conductanceDerivative = m_conductanceDerivativePoints;
+    s.waterDispensed = m_waterDispensedPoints;
+    s.pressureGoalSegments = m_pressureGoalSegments;
+    s.flowGoalSegments = m_flowGoalSegments;
+    s.temperatureGoal = m_temperatureGoalPoints;
+    s.weight = m_weightPoints;
+    s.cumulativeWeight = m_cumulativeWeightPoints;
+    s.weightFlowRate = m_weightFlowRatePoints;
+    s.weightFlowRateRaw = m_weightFlowRateRawPoints;
+
+    s.phases.reserve(m_phaseMarkers.size());
+    for (const PhaseMarker& marker : m_phaseMarkers) {
+        HistoryPhaseMarker pm;
+        pm.time = marker.time;
+        pm.label = marker.label;
+        pm.frameNumber = marker.frameNumber;
+        pm.isFlowMode = marker.isFlowMode;
+        pm.transitionReason = marker.transitionReason;
+        s.phases.append(pm);
+    }
+    return s;
+}
 
-    qsizetype removed = m_pressurePoints.size() - trimIndex;
-    qDebug() << "[ShotDataModel] Trimming" << removed << "trailing zero-pressure settling samples"
-             << "(keeping" << trimIndex << "of" << m_pressurePoints.size() << ")";
-
-    // Trim sensor data series to the same length
-    m_pressurePoints.resize(trimIndex);
-    m_flowPoints.resize(qMin(m_flowPoints.size(), trimIndex));
-    m_temperaturePoints.resize(qMin(m_temperaturePoints.size(), trimIndex));
-    m_temperatureMixPoints.resize(qMin(m_temperatureMixPoints.size(), trimIndex));
-    m_resistancePoints.resize(qMin(m_resistancePoints.size(), trimIndex));
-    m_conductancePoints.resize(qMin(m_conductancePoints.size(), trimIndex));
-    m_darcyResistancePoints.resize(qMin(m_darcyResistancePoints.size(), trimIndex));
-    m_waterDispensedPoints.resize(qMin(m_waterDispensedPoints.size(), trimIndex));
-
-    // Trim time-based series using cutoff from last retained pressure sample.
-    // Goals and weight flow rate have different sample counts than DE1 sensor data.
-    // (trimIndex is guaranteed > 0 by the early returns above)
-    double cutoffTime = m_pressurePoints.last().x();
-    for (auto& segment : m_pressureGoalSegments) {
-        while (!segment.isEmpty() && segment.last().x() > cutoffTime)
-            segment.removeLast();
-    }
-    for (auto& segment : m_flowGoalSegments) {
-        while (!segment.isEmpty() && segment.last().x() > cutoffTime)
-            segment.removeLast();
-    }
-    while (!m_temperatureGoalPoints.isEmpty() && m_temperatureGoalPoints.last().x() > cutoffTime)
-        m_temperatureGoalPoints.removeLast();
-    while (!m_weightFlowRatePoints.isEmpty() && m_weightFlowRatePoints.last().x() > cutoffTime)
-        m_weightFlowRatePoints.removeLast();
-    while (!m_weightFlowRateRawPoints.isEmpty() && m_weightFlowRateRawPoints.last().x() > cutoffTime)
-        m_weightFlowRateRawPoints.removeLast();
-
-    // Do NOT trim cumulative weight data (m_weightPoints, m_cumulativeWeightPoints) —
-    // weight continues to change during settling and the settled final weight is accurate.
+bool ShotDataModel::applyProcessedSnapshot(const ShotSnapshot& processed) {
+    if (processed.generation != m_generation) {
+        qWarning() << "[ShotDataModel] Dropping processed snapshot from a previous shot"
+                   << "(generation" << processed.generation << "current" << m_generation << ")";
+        return false;
+    }
+
+    // Only the series the post-shot stages rewrite. Weight/cumulative weight and
+    // phase markers are never modified by processing, so they stay as recorded.
+    m_pressurePoints = processed.pressure;
+    m_flowPoints = processed.flow;
+    m_temperaturePoints = processed.temperature;
+    m_temperatureMixPoints = processed.temperatureMix;
+    m_resistancePoints = processed.resistance;
+    m_conductancePoints = processed.conductance;
+    m_darcyResistancePoints = processed.darcyResistance;
+    m_conductanceDerivativePoints = processed.conductanceDerivative;
+    m_waterDispensedPoints = processed.waterDispensed;
+    m_pressureGoalSegments = processed.pressureGoalSegments;
+    m_flowGoalSegments = processed.flowGoalSegments;
+    m_temperatureGoalPoints = processed.temperatureGoal;
+    m_weightFlowRatePoints = processed.weightFlowRate;
+    m_weightFlowRateRawPoints = processed.weightFlowRateRaw;
+    return true;
 }
 
 void ShotDataModel::addPhaseMarker(double time, const QString& label, int frameNumber, bool isFlowMode, const QString& transitionReason) {
@@ -526,7 +538,7 @@ void ShotDataModel::addPhaseMarker(double time, const QString& label, int frameN
 void ShotDataModel::onFlushTimerTick() {
     if (!m_dirty) return;
 
-    // Incrementally append new points to fast renderers (pre-allocated VBO, no rebuild)
+    // Incrementally append new points to the fast series (only the new tail is regenerated)
     if (m_fastPressure) {
         for (qsizetype i = m_lastFlushedPressure; i < m_pressurePoints.size(); ++i)
             m_fastPressure->appendPoint(m_pressurePoints[i].x(), m_pressurePoints[i].y());
@@ -573,46 +585,34 @@ void ShotDataModel::onFlushTimerTick() {
         m_lastFlushedTemperatureMix = m_temperatureMixPoints.size();
     }
 
-    // Update goal curve LineSeries (infrequent updates, replace() is fine)
-    for (qsizetype i = 0; i < m_pressureGoalSegments.size() && i < m_pressureGoalSeriesList.size(); ++i) {
-        if (m_pressureGoalSeriesList[i] && !m_pressureGoalSegments[i].isEmpty()) {
-            m_pressureGoalSeriesList[i]->replace(m_pressureGoalSegments[i]);
-        }
+    // Goal curves: append-only like the live series; a pump-mode switch breaks the line
+    if (m_pressureGoalSeries) {
+        flushGoalSegments(m_pressureGoalSeries, m_pressureGoalSegments,
+                          m_lastFlushedPressureGoalSegment, m_lastFlushedPressureGoal);
     }
-    for (qsizetype i = 0; i < m_flowGoalSegments.size() && i < m_flowGoalSeriesList.size(); ++i) {
-        if (m_flowGoalSeriesList[i] && !m_flowGoalSegments[i].isEmpty()) {
-            m_flowGoalSeriesList[i]->replace(m_flowGoalSegments[i]);
-        }
+    if (m_flowGoalSeries) {
+        flushGoalSegments(m_flowGoalSeries, m_flowGoalSegments,
+                          m_lastFlushedFlowGoalSegment, m_lastFlushedFlowGoal);
     }
-    if (m_temperatureGoalSeries && !m_temperatureGoalPoints.isEmpty()) {
-        m_temperatureGoalSeries->replace(m_temperatureGoalPoints);
+    if (m_temperatureGoalSeries) {
+        for (qsizetype i = m_lastFlushedTemperatureGoal; i < m_temperatureGoalPoints.size(); ++i)
+            m_temperatureGoalSeries->appendPoint(m_temperatureGoalPoints[i].x(), m_temperatureGoalPoints[i].y());
+        m_lastFlushedTemperatureGoal = m_temperatureGoalPoints.size();
     }
 
     // Process pending vertical markers
     for (const auto& marker : m_pendingMarkers) {
-        if (marker.second == "Start") {
-            if (m_extractionMarkerSeries) {
-                m_extractionMarkerSeries->append(marker.first, 0);
-                m_extractionMarkerSeries->append(marker.first, 12);
-            }
-        } else {
-            if (m_frameMarkerIndex < m_frameMarkerSeries.size()) {
-                const auto& series = m_frameMarkerSeries[m_frameMarkerIndex];
-                if (series) {
-                    series->append(marker.first, 0);
-                    series->append(marker.first, 12);
-                }
-                m_frameMarkerIndex++;
-            }
-        }
+        FastSegmentSeries* series = marker.second == "Start" ? m_extractionMarkerSeries.data()
+                                                             : m_frameMarkerSeries.data();
+        if (series)
+            appendMarkerLine(series, marker.first);
     }
     m_pendingMarkers.clear();
 
     // Draw stop marker if pending
     if (m_pendingStopTime >= 0 && m_stopMarkerSeries) {
         m_stopMarkerSeries->clear();  // Clear any existing line
-        m_stopMarkerSeries->append(m_pendingStopTime, 0);
-        m_stopMarkerSeries->append(m_pendingStopTime, 12);
+        appendMarkerLine(m_stopMarkerSeries, m_pendingStopTime);
         m_pendingStopTime = -1;  // Mark as drawn
     }
 
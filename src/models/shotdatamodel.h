@@ -6,9 +6,10 @@
 #include <QPointF>
 #include <QPointer>
 #include <QVariantList>
-#include <QtCharts/QLineSeries>
 
-class FastLineRenderer;
+class FastLineSeries;
+class FastSegmentSeries;
+struct ShotSnapshot;
 
 struct PhaseMarker {
     double time;
@@ -39,21 +40,23 @@ public:
     double finalWeight() const;
     QVariantList phaseMarkersVariant() const;
 
-    // Register goal/marker chart series (LineSeries - infrequent updates)
-    Q_INVOKABLE void registerSeries(const QVariantList& pressureGoalSegments, const QVariantList& flowGoalSegments,
-                                     QLineSeries* temperatureGoal,
-                                     QLineSeries* extractionMarker,
-                                     QLineSeries* stopMarker,
-                                     const QVariantList& frameMarkers);
-
-    // Register fast renderers for live data series (QSGGeometryNode - pre-allocated VBO)
-    Q_INVOKABLE void registerFastSeries(FastLineRenderer* pressure, FastLineRenderer* flow,
-                                         FastLineRenderer* temperature,
-                                         FastLineRenderer* weight, FastLineRenderer* weightFlow,
-                                         FastLineRenderer* resistance = nullptr,
-                                         FastLineRenderer* conductance = nullptr,
-                                         FastLineRenderer* darcyResistance = nullptr,
-                                         FastLineRenderer* temperatureMix = nullptr);
+    // Register goal curves and phase markers (segmented series of the same
+    // FastMultiLineRenderer). Goals break into a new segment on every pump-mode
+    // switch; each marker is its own segment, so there is no per-shot limit.
+    Q_INVOKABLE void registerSeries(FastSegmentSeries* pressureGoal, FastSegmentSeries* flowGoal,
+                                     FastSegmentSeries* temperatureGoal,
+                                     FastSegmentSeries* extractionMarker,
+                                     FastSegmentSeries* stopMarker,
+                                     FastSegmentSeries* frameMarkers);
+
+    // Register live data series of the shot graph's FastMultiLineRenderer
+    Q_INVOKABLE void registerFastSeries(FastLineSeries* pressure, FastLineSeries* flow,
+                                         FastLineSeries* temperature,
+                                         FastLineSeries* weight, FastLineSeries* weightFlow,
+                                         FastLineSeries* resistance = nullptr,
+                                         FastLineSeries* conductance = nullptr,
+                                         FastLineSeries* darcyResistance = nullptr,
+                                         FastLineSeries* temperatureMix = nullptr);
 
     // Data export for visualizer upload
     const QVector<QPointF>& pressureData() const { return m_pressurePoints; }
@@ -76,6 +79,14 @@ public:
     // Phase markers for state_change export
     const QList<PhaseMarker>& phaseMarkersList() const { return m_phaseMarkers; }
 
+    // Post-shot pipeline hand-off. snapshot() is O(series), not O(samples)
+    // (implicitly-shared copies). applyProcessedSnapshot() writes the trimmed /
+    // smoothed / dC/dt series back; returns false (and leaves the model alone)
+    // if clear() ran since the snapshot was taken.
+    ShotSnapshot snapshot() const;
+    bool applyProcessedSnapshot(const ShotSnapshot& processed);
+    quint64 generation() const { return m_generation; }
+
 public slots:
     void clear();
     void clearWeightData();  // Clear only weight samples (call when tare completes)
@@ -126,16 +137,16 @@ private:
     QVector<QPointF> m_weightFlowRatePoints;  // Flow rate from scale (g/s) - for visualizer export
     QVector<QPointF> m_weightFlowRateRawPoints;  // Raw (pre-smoothing) copy for by_weight_raw export
 
-    // Fast renderers for live data series (QSGGeometryNode, pre-allocated VBO)
-    QPointer<FastLineRenderer> m_fastPressure;
-    QPointer<FastLineRenderer> m_fastFlow;
-    QPointer<FastLineRenderer> m_fastTemperature;
-    QPointer<FastLineRenderer> m_fastWeight;
-    QPointer<FastLineRenderer> m_fastWeightFlow;
-    QPointer<FastLineRenderer> m_fastResistance;
-    QPointer<FastLineRenderer> m_fastConductance;
-    QPointer<FastLineRenderer> m_fastDarcyResistance;
-    QPointer<FastLineRenderer> m_fastTemperatureMix;
+    // Live data series (one FastMultiLineRenderer draws them all)
+    QPointer<FastLineSeries> m_fastPressure;
+    QPointer<FastLineSeries> m_fastFlow;
+    QPointer<FastLineSeries> m_fastTemperature;
+    QPointer<FastLineSeries> m_fastWeight;
+    QPointer<FastLineSeries> m_fastWeightFlow;
+    QPointer<FastLineSeries> m_fastResistance;
+    QPointer<FastLineSeries> m_fastConductance;
+    QPointer<FastLineSeries> m_fastDarcyResistance;
+    QPointer<FastLineSeries> m_fastTemperatureMix;
 
     // Last-flushed index per fast series (for incremental appends)
     qsizetype m_lastFlushedPressure = 0;
@@ -148,22 +159,30 @@ private:
     qsizetype m_lastFlushedDarcyResistance = 0;
     qsizetype m_lastFlushedTemperatureMix = 0;
 
-    // Chart series for goals/markers (QPointer auto-nulls when QML destroys them)
-    QList<QPointer<QLineSeries>> m_pressureGoalSeriesList;  // One per segment
-    QList<QPointer<QLineSeries>> m_flowGoalSeriesList;      // One per segment
-    QPointer<QLineSeries> m_temperatureGoalSeries;
-    QPointer<QLineSeries> m_extractionMarkerSeries;
-    QPointer<QLineSeries> m_stopMarkerSeries;
-    QList<QPointer<QLineSeries>> m_frameMarkerSeries;
+    // Goal/marker series (QPointer auto-nulls when QML destroys them)
+    QPointer<FastSegmentSeries> m_pressureGoalSeries;   // One segment per pump-mode run
+    QPointer<FastSegmentSeries> m_flowGoalSeries;       // One segment per pump-mode run
+    QPointer<FastSegmentSeries> m_temperatureGoalSeries;
+    QPointer<FastSegmentSeries> m_extractionMarkerSeries;
+    QPointer<FastSegmentSeries> m_stopMarkerSeries;
+    QPointer<FastSegmentSeries> m_frameMarkerSeries;    // One segment per frame marker
+
+    // Last-flushed position in the goal data (segment, point within it)
+    qsizetype m_lastFlushedPressureGoalSegment = 0;
+    qsizetype m_lastFlushedPressureGoal = 0;
+    qsizetype m_lastFlushedFlowGoalSegment = 0;
+    qsizetype m_lastFlushedFlowGoal = 0;
+    qsizetype m_lastFlushedTemperatureGoal = 0;
 
     // Batched update timer (30fps)
     QTimer* m_flushTimer = nullptr;
     bool m_dirty = false;
 
+    quint64 m_generation = 0;  // Bumped by clear(); tags snapshots with the shot they came from
+
     double m_maxTime = 5.0;
     double m_rawTime = 0.0;
     bool m_rawTimeDirty = false;  // Deferred: emit rawTimeChanged in onFlushTimerTick()
-    int m_frameMarkerIndex = 0;
     bool m_lastPumpModeIsFlow = false;  // Track for starting new goal segments
     bool m_hasPumpModeData = false;     // True after first sample with pump mode
     int m_currentPressureGoalSegment = 0;  // Current segment index
@@ -24,7 +24,7 @@ public:
     double rawTime() const { return m_rawTime; }
     int sampleCount() const { return static_cast<int>(m_pressurePoints.size()); }
 
-    // Register fast renderers for live data series (QSGGeometryNode, pre-allocated VBO)
+    // Register fast renderers for live data series (QSGGeometryNode, chunked VBO)
     Q_INVOKABLE void registerFastSeries(FastLineRenderer* pressure, FastLineRenderer* flow,
                                          FastLineRenderer* temperature);
 
@@ -66,7 +66,7 @@ private:
     QVector<QPointF> m_temperaturePoints;
     QVector<QPointF> m_flowGoalPoints;
 
-    // Fast renderers for live data series (QSGGeometryNode, pre-allocated VBO)
+    // Fast renderers for live data series (QSGGeometryNode, chunked VBO)
     QPointer<FastLineRenderer> m_fastPressure;
     QPointer<FastLineRenderer> m_fastFlow;
     QPointer<FastLineRenderer> m_fastTemperature;
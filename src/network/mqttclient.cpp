@@ -641,6 +641,32 @@ void MqttClient::setCurrentProfileFilename(const QString& filename)
 void MqttClient::setMainController(MainController* controller)
 {
     m_mainController = controller;
+
+    // Live puck-integrity warnings (see LiveShotAnalysis). Edge-triggered
+    // while the shot runs; all three topics reset to their clear value when
+    // a new shot starts.
+    LiveShotAnalysis* live = controller ? controller->liveShotAnalysis() : nullptr;
+    if (!live) return;
+
+    connect(live, &LiveShotAnalysis::activeChanged, this, [this, live]() {
+        if (!live->isActive()) return;
+        publish(topicPath("shot/channeling"), "none", true);
+        publish(topicPath("shot/grind"), "none", true);
+        publish(topicPath("shot/pour_not_pressurizing"), "false", true);
+    });
+    connect(live, &LiveShotAnalysis::channelingDetected, this,
+            [this](const QString& severity, double spikeTimeSec) {
+        publish(topicPath("shot/channeling"), severity, true);
+        qDebug() << "MqttClient: Published live channeling" << severity << "at" << spikeTimeSec << "s";
+    });
+    connect(live, &LiveShotAnalysis::grindIssueDetected, this,
+            [this](const QString& direction, double) {
+        publish(topicPath("shot/grind"), direction, true);
+    });
+    connect(live, &LiveShotAnalysis::pourNotPressurizingChanged, this, [this, live]() {
+        publish(topicPath("shot/pour_not_pressurizing"),
+                live->pourNotPressurizing() ? "true" : "false", true);
+    });
 }
 
 void MqttClient::onReconnectTimerTick()
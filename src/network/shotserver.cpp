@@ -5,8 +5,11 @@
 #include "webtemplates.h"
 #include "webtemplates/auth_page.h"
 #include "../history/shothistorystorage.h"
+#include "../history/shotrecordcache.h"
 #include "../ble/de1device.h"
+#include "../ble/de1transport.h"
 #include "../machine/machinestate.h"
+#include "../machine/sawlatencytracker.h"
 #include "../screensaver/screensavervideomanager.h"
 #include "../core/settings.h"
 #include "../core/settings_network.h"
@@ -1634,13 +1637,14 @@ btn.textContent='Copied!';setTimeout(function(){btn.textContent='Copy'},2000);
         }
         QPointer<QTcpSocket> socketGuard(socket);
         QString dbPath = m_storage->databasePath();
+        auto cache = m_storage->recordCache();
         auto destroyed = m_destroyed;
-        QThread* thread = QThread::create([this, socketGuard, dbPath, ids, destroyed]() {
+        QThread* thread = QThread::create([this, socketGuard, dbPath, cache, ids, destroyed]() {
             QList<ShotRecord> shots;
             bool dbOpened = withTempDb(dbPath, "shs_web_cmp", [&](QSqlDatabase& db) {
                 for (qint64 id : ids) {
-                    ShotRecord r = ShotHistoryStorage::loadShotRecordStatic(db, id);
-                    if (r.summary.id > 0) shots.append(std::move(r));
+                    const auto r = ShotHistoryStorage::loadShotRecordCached(db, id, cache.get());
+                    if (r->summary.id > 0) shots.append(*r);
                 }
             });
 
@@ -1670,11 +1674,12 @@ btn.textContent='Copied!';setTimeout(function(){btn.textContent='Copy'},2000);
         }
         QPointer<QTcpSocket> socketGuard(socket);
         QString dbPath = m_storage->databasePath();
+        auto cache = m_storage->recordCache();
         auto destroyed = m_destroyed;
-        QThread* thread = QThread::create([this, socketGuard, dbPath, shotId, destroyed]() {
+        QThread* thread = QThread::create([this, socketGuard, dbPath, cache, shotId, destroyed]() {
             ShotRecord record;
             bool dbOpened = withTempDb(dbPath, "shs_web_prof", [&](QSqlDatabase& db) {
-                record = ShotHistoryStorage::loadShotRecordStatic(db, shotId);
+                record = *ShotHistoryStorage::loadShotRecordCached(db, shotId, cache.get());
             });
 
             if (*destroyed) return;
@@ -1706,12 +1711,13 @@ btn.textContent='Copied!';setTimeout(function(){btn.textContent='Copy'},2000);
         }
         QPointer<QTcpSocket> socketGuard(socket);
         QString dbPath = m_storage->databasePath();
+        auto cache = m_storage->recordCache();
         auto destroyed = m_destroyed;
-        QThread* thread = QThread::create([this, socketGuard, dbPath, shotId, destroyed]() {
+        QThread* thread = QThread::create([this, socketGuard, dbPath, cache, shotId, destroyed]() {
             QVariantMap shot;
             bool dbOpened = withTempDb(dbPath, "shs_web_det", [&](QSqlDatabase& db) {
-                ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, shotId);
-                shot = ShotHistoryStorage::convertShotRecord(record);
+                shot = ShotHistoryStorage::convertShotRecord(
+                    *ShotHistoryStorage::loadShotRecordCached(db, shotId, cache.get()));
             });
 
             if (*destroyed) return;
@@ -1816,12 +1822,13 @@ btn.textContent='Copied!';setTimeout(function(){btn.textContent='Copy'},2000);
         }
         QPointer<QTcpSocket> socketGuard(socket);
         QString dbPath = m_storage->databasePath();
+        auto cache = m_storage->recordCache();
         auto destroyed = m_destroyed;
-        QThread* thread = QThread::create([this, socketGuard, dbPath, shotId, destroyed]() {
+        QThread* thread = QThread::create([this, socketGuard, dbPath, cache, shotId, destroyed]() {
             QVariantMap shot;
             bool dbOpened = withTempDb(dbPath, "shs_web_get", [&](QSqlDatabase& db) {
-                ShotRecord record = ShotHistoryStorage::loadShotRecordStatic(db, shotId);
-                shot = ShotHistoryStorage::convertShotRecord(record);
+                shot = ShotHistoryStorage::convertShotRecord(
+                    *ShotHistoryStorage::loadShotRecordCached(db, shotId, cache.get()));
             });
 
             if (*destroyed) return;
@@ -1943,12 +1950,24 @@ btn.textContent='Copied!';setTimeout(function(){btn.textContent='Copy'},2000);
     }
     else if (path == "/api/memory") {
         if (m_memoryMonitor) {
-            QJsonDocument doc(m_memoryMonitor->toJson());
+            QJsonObject memory = m_memoryMonitor->toJson();
+            if (m_storage)
+                memory["shotRecordCache"] = m_storage->recordCache()->statsJson();
+            if (m_device && m_device->transport())
+                memory["de1WriteQueue"] = m_device->transport()->queueStats();
+            QJsonDocument doc(memory);
             sendJson(socket, doc.toJson(QJsonDocument::Compact));
         } else {
             sendResponse(socket, 503, "application/json", R"({"error":"Memory monitor not available"})");
         }
     }
+    else if (path == "/api/saw-latency") {
+        if (auto* tracker = SawLatencyTracker::instance()) {
+            sendJson(socket, QJsonDocument(tracker->toJson()).toJson(QJsonDocument::Compact));
+        } else {
+            sendResponse(socket, 503, "application/json", R"({"error":"SAW latency tracker not available"})");
+        }
+    }
     else if (path == "/debug") {
         sendHtml(socket, generateDebugPage());
     }
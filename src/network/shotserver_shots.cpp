@@ -3293,10 +3293,80 @@ QString ShotServer::generateDebugPage() const
                 </div>
             </div>
         </div>
+        <div class="memory-section" id="sawLatencySection">
+            <div class="memory-header" onclick="toggleSawLatency()">
+                <h2>Stop-at-Weight Latency</h2>
+                <span class="memory-toggle" id="sawLatencyToggle">Collapse</span>
+            </div>
+            <div class="memory-body" id="sawLatencyBody">
+                <div class="class-table-wrap">
+                    <table class="class-table">
+                        <thead><tr><th>Scale</th><th>Stage</th><th style="text-align:right">Stops</th><th style="text-align:right">p50</th><th style="text-align:right">p95</th><th style="text-align:right">Max</th><th>Histogram (ms: count)</th></tr></thead>
+                        <tbody id="sawLatencyTableBody"><tr><td colspan="7">No traced stops yet</td></tr></tbody>
+                    </table>
+                </div>
+            </div>
+        </div>
     </main>
     <script>
 )HTML"
 // Split string literal to stay within MSVC's 16380-char per-segment limit (C2026)
+R"HTML(        /* --- SAW latency section --- */
+        var sawLatencyCollapsed = false;
+
+        function toggleSawLatency() {
+            sawLatencyCollapsed = !sawLatencyCollapsed;
+            document.getElementById("sawLatencyBody").classList.toggle("collapsed", sawLatencyCollapsed);
+            document.getElementById("sawLatencyToggle").textContent = sawLatencyCollapsed ? "Expand" : "Collapse";
+        }
+
+        function updateSawLatency(data) {
+            if (!data || !data.scales || !data.bucketUpperMs) return;
+            var bounds = data.bucketUpperMs;
+            var stageLabels = { queue: "Notify \u2192 process", decide: "Process \u2192 stop", dispatch: "Stop \u2192 write",
+                                bleAck: "Write \u2192 ack", machine: "Write \u2192 DE1 state", total: "Notify \u2192 DE1 state" };
+            var rows = "";
+            Object.keys(data.scales).sort().forEach(function(scale) {
+                var stages = data.scales[scale].stages;
+                Object.keys(stageLabels).forEach(function(stage) {
+                    var h = stages[stage];
+                    if (!h || h.count === 0) return;
+                    var parts = [];
+                    for (var i = 0; i < h.buckets.length; i++) {
+                        if (h.buckets[i] === 0) continue;
+                        var label = i < bounds.length ? "\u2264" + bounds[i] : ">" + bounds[bounds.length - 1];
+                        parts.push(label + ": " + h.buckets[i]);
+                    }
+                    rows += "<tr><td>" + escapeHtml(scale) + "</td><td>" + stageLabels[stage] + "</td>"
+                          + "<td style='text-align:right'>" + h.count + "</td>"
+                          + "<td style='text-align:right'>" + h.p50Ms + " ms</td>"
+                          + "<td style='text-align:right'>" + h.p95Ms + " ms</td>"
+                          + "<td style='text-align:right'>" + h.maxMs + " ms</td>"
+                          + "<td>" + parts.join(", ") + "</td></tr>";
+                });
+            });
+            if (rows)
+                document.getElementById("sawLatencyTableBody").innerHTML = rows;
+        }
+
+        function fetchSawLatency() {
+            fetch("/api/saw-latency")
+                .then(function(r) {
+                    if (!r.ok) throw new Error("Server error " + r.status);
+                    return r.json();
+                })
+                .then(updateSawLatency)
+                .catch(function(err) { console.warn("[SAW latency] fetch failed:", err); });
+        }
+
+        fetchSawLatency();
+        var sawLatencyTimer = setInterval(fetchSawLatency, 30000);
+        document.addEventListener("visibilitychange", function() {
+            if (document.hidden) { clearInterval(sawLatencyTimer); }
+            else { fetchSawLatency(); sawLatencyTimer = setInterval(fetchSawLatency, 30000); }
+        });
+
+)HTML"
 R"HTML(        /* --- Memory section --- */
         var memoryCollapsed = false;
         var memoryChart = null;
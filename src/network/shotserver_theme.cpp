@@ -218,7 +218,10 @@ void ShotServer::handleThemeApi(QTcpSocket* socket, const QString& method,
             sendResponse(socket, 400, "text/plain", "Missing name");
             return;
         }
-        m_settings->theme()->applyPresetTheme(name);
+        {
+            Settings::Transaction transaction(m_settings, QStringLiteral("applyPresetTheme"));
+            m_settings->theme()->applyPresetTheme(name);
+        }
         QJsonDocument doc(buildThemeJson());
         sendJson(socket, doc.toJson(QJsonDocument::Compact));
         return;
@@ -231,11 +234,14 @@ void ShotServer::handleThemeApi(QTcpSocket* socket, const QString& method,
         double saturation = obj["saturation"].toDouble();
         double lightness = obj["lightness"].toDouble();
         QVariantMap palette = m_settings->theme()->generatePalette(hue, saturation, lightness);
-        // Write each color to the editing palette (not the active palette)
-        for (auto it = palette.constBegin(); it != palette.constEnd(); ++it) {
-            m_settings->theme()->setEditingPaletteColor(it.key(), it.value().toString());
+        {
+            Settings::Transaction transaction(m_settings, QStringLiteral("themePalette"));
+            // Write each color to the editing palette (not the active palette)
+            for (auto it = palette.constBegin(); it != palette.constEnd(); ++it) {
+                m_settings->theme()->setEditingPaletteColor(it.key(), it.value().toString());
+            }
+            m_settings->theme()->setActiveThemeName("Custom");
         }
-        m_settings->theme()->setActiveThemeName("Custom");
         QJsonDocument doc(buildThemeJson());
         sendJson(socket, doc.toJson(QJsonDocument::Compact));
         return;
@@ -257,8 +263,11 @@ void ShotServer::handleThemeApi(QTcpSocket* socket, const QString& method,
 
     // POST /api/theme/reset - reset to defaults
     if (path == "/api/theme/reset" && method == "POST") {
-        m_settings->theme()->resetThemeToDefault();
-        m_settings->theme()->resetFontSizesToDefault();
+        {
+            Settings::Transaction transaction(m_settings, QStringLiteral("resetTheme"));
+            m_settings->theme()->resetThemeToDefault();
+            m_settings->theme()->resetFontSizesToDefault();
+        }
         QJsonDocument doc(buildThemeJson());
         sendJson(socket, doc.toJson(QJsonDocument::Compact));
         return;
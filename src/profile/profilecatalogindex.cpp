@@ -0,0 +1,155 @@
+#include "profilecatalogindex.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <utility>
+
+ProfileCatalogIndex ProfileCatalogIndex::load(const QString& fileName)
+{
+    ProfileCatalogIndex index;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return index;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kFormatVersion) {
+        qDebug() << "ProfileCatalogIndex: ignoring" << fileName << "(format"
+                 << root.value("version").toInt() << "), every profile will be re-read";
+        return index;
+    }
+
+    const QJsonArray entries = root.value("entries").toArray();
+    index.m_entries.reserve(entries.size());
+    for (const QJsonValue& value : entries) {
+        const QJsonObject e = value.toObject();
+        Entry entry;
+        entry.mtimeMs = e.value("mtime").toInteger(-1);
+        entry.size = e.value("size").toInteger(-1);
+        entry.indexedMs = e.value("indexed").toInteger();
+        entry.hash = QByteArray::fromHex(e.value("hash").toString().toLatin1());
+        entry.meta.title = e.value("title").toString();
+        entry.meta.beverageType = e.value("beverageType").toString();
+        entry.meta.profileType = e.value("profileType").toString();
+        entry.meta.readOnly = e.value("readOnly").toBool();
+        index.m_entries.insert(e.value("path").toString(), entry);
+    }
+    return index;
+}
+
+bool ProfileCatalogIndex::save(const QString& fileName) const
+{
+    QJsonArray entries;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        const Entry& entry = it.value();
+        QJsonObject e;
+        e["path"] = it.key();
+        e["mtime"] = entry.mtimeMs;
+        e["size"] = entry.size;
+        e["indexed"] = entry.indexedMs;
+        e["hash"] = QString::fromLatin1(entry.hash.toHex());
+        e["title"] = entry.meta.title;
+        e["beverageType"] = entry.meta.beverageType;
+        e["profileType"] = entry.meta.profileType;
+        e["readOnly"] = entry.meta.readOnly;
+        entries.append(e);
+    }
+    QJsonObject root;
+    root["version"] = kFormatVersion;
+    root["entries"] = entries;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ProfileCatalogIndex: cannot write" << fileName << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "ProfileCatalogIndex: failed to save" << fileName << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+std::optional<ProfileCatalogIndex::Meta> ProfileCatalogIndex::lookup(const QString& path)
+{
+    m_visited.insert(path);
+
+    const QFileInfo info(path);
+    const QDateTime modified = info.lastModified();
+    const qint64 mtimeMs = modified.isValid() ? modified.toMSecsSinceEpoch() : -1;
+    const qint64 size = info.size();
+
+    auto it = m_entries.find(path);
+    if (it != m_entries.end() && mtimeMs >= 0
+        && it->mtimeMs == mtimeMs && it->size == size
+        && it->mtimeMs + kRacyWindowMs < it->indexedMs) {
+        ++m_stats.statHits;
+        return it->meta;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        ++m_stats.unreadable;
+        return std::nullopt;
+    }
+    const QByteArray content = file.readAll();
+    if (content.isEmpty()) {
+        ++m_stats.unreadable;
+        return std::nullopt;
+    }
+    QByteArray hash = QCryptographicHash::hash(content, QCryptographicHash::Md5);
+
+    if (it == m_entries.end())
+        it = m_entries.insert(path, Entry());
+    if (it->hash == hash) {
+        ++m_stats.hashHits;
+    } else {
+        ++m_stats.parsed;
+        it->meta = parse(content);
+        it->hash = std::move(hash);
+    }
+    it->mtimeMs = mtimeMs;
+    it->size = size;
+    it->indexedMs = QDateTime::currentMSecsSinceEpoch();
+    m_dirty = true;
+    return it->meta;
+}
+
+void ProfileCatalogIndex::pruneUnvisited()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_visited.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+            m_dirty = true;
+        }
+    }
+    m_visited.clear();
+}
+
+ProfileCatalogIndex::Meta ProfileCatalogIndex::parse(const QByteArray& json)
+{
+    const QJsonObject obj = QJsonDocument::fromJson(json).object();
+    Meta meta;
+    meta.title = obj["title"].toString();
+    meta.beverageType = obj["beverage_type"].toString();
+    meta.profileType = obj["legacy_profile_type"].toString();
+    if (meta.profileType.isEmpty())
+        meta.profileType = obj["profile_type"].toString();
+    meta.readOnly = (obj["read_only"].toInt(0) == 1);
+    return meta;
+}
+
+ProfileCatalogIndex::Stats ProfileCatalogIndex::takeStats()
+{
+    return std::exchange(m_stats, Stats());
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <optional>
+
+/**
+ * ProfileCatalogIndex - on-disk cache of the per-file metadata the profile
+ * catalog shows (title, beverage type, profile type, read-only flag), so
+ * ProfileManager::refreshProfiles() only opens and parses profile JSON that
+ * actually changed.
+ *
+ * Entries are keyed by path and validated by mtime + size; a file whose stat
+ * still matches costs one stat() and no read. A file whose stat changed is
+ * read and hashed, and only parsed if the content hash changed too (a resave
+ * of identical JSON, or a copy that only touched the mtime, is not a parse).
+ *
+ * Stat is not trusted for a file that was modified within kRacyWindowMs of
+ * being indexed: two writes inside one mtime tick (FAT-style 2 s granularity
+ * on external storage) could leave the same mtime and size with different
+ * content, so such entries are re-hashed until the file has settled.
+ *
+ * Only raw fields read from the file are stored. Anything derived from them
+ * by app code (editor type, knowledge-base match) is recomputed by the
+ * caller, so an app update never serves stale derived values.
+ *
+ * A plain value type with no thread affinity: a background refresh scans a
+ * copy and hands it back. Not safe for concurrent use of one instance.
+ */
+class ProfileCatalogIndex {
+public:
+    static constexpr int kFormatVersion = 1;
+    static constexpr qint64 kRacyWindowMs = 2000;
+
+    struct Meta {
+        QString title;
+        QString beverageType;
+        QString profileType;   // legacy_profile_type, else profile_type
+        bool readOnly = false; // read_only == 1
+
+        bool operator==(const Meta& other) const {
+            return title == other.title && beverageType == other.beverageType
+                && profileType == other.profileType && readOnly == other.readOnly;
+        }
+        bool operator!=(const Meta& other) const { return !(*this == other); }
+    };
+
+    // How lookups since the last takeStats() were answered
+    struct Stats {
+        int statHits = 0;  // mtime + size matched, nothing read
+        int hashHits = 0;  // read and hashed, content unchanged
+        int parsed = 0;    // new or changed file, parsed
+        int unreadable = 0;
+    };
+
+    ProfileCatalogIndex() = default;
+
+    // Index saved by save(). A missing, corrupt or other-version file gives an
+    // empty index, which just means every profile is parsed once.
+    static ProfileCatalogIndex load(const QString& fileName);
+    // Atomic replace (QSaveFile); can run on a copy on another thread
+    bool save(const QString& fileName) const;
+
+    // Metadata for the profile file at path, parsing it only when needed.
+    // nullopt if the file can't be read or is empty.
+    std::optional<Meta> lookup(const QString& path);
+
+    // Drops entries for paths not looked up since the previous prune (deleted
+    // or renamed profiles), so the index doesn't grow without bound
+    void pruneUnvisited();
+
+    static Meta parse(const QByteArray& json);
+
+    // Changed since load() or markClean(), i.e. worth saving
+    bool isDirty() const { return m_dirty; }
+    void markClean() { m_dirty = false; }
+    qsizetype size() const { return m_entries.size(); }
+    Stats takeStats();
+
+private:
+    struct Entry {
+        qint64 mtimeMs = -1;
+        qint64 size = -1;
+        qint64 indexedMs = 0;  // Wall clock when mtime/size were recorded
+        QByteArray hash;
+        Meta meta;
+    };
+
+    QHash<QString, Entry> m_entries;
+    QSet<QString> m_visited;
+    bool m_dirty = false;
+    Stats m_stats;
+};
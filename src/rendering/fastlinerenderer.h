@@ -1,12 +1,16 @@
 #pragma once
 
+#include "linestrip.h"
+
 #include <QQuickItem>
 #include <QColor>
 #include <QPointF>
 #include <QVector>
-#include <QSGGeometryNode>
-#include <QSGFlatColorMaterial>
 
+// Single live series as its own item (steam graph). The strip itself —
+// chunked, append-only, min/max-decimated geometry — lives in LineStrip.
+// The espresso graph draws all of its channels through one
+// FastMultiLineRenderer instead.
 class FastLineRenderer : public QQuickItem {
     Q_OBJECT
 
@@ -18,14 +22,12 @@ class FastLineRenderer : public QQuickItem {
     Q_PROPERTY(double maxY READ maxY WRITE setMaxY NOTIFY maxYChanged)
 
 public:
-    static constexpr int MAX_POINTS = 700;  // 2 min at 5Hz + margin
-
     explicit FastLineRenderer(QQuickItem* parent = nullptr);
 
-    QColor color() const { return m_color; }
+    QColor color() const { return m_strip.color(); }
     void setColor(const QColor& color);
 
-    float lineWidth() const { return m_lineWidth; }
+    float lineWidth() const { return m_strip.lineWidth(); }
     void setLineWidth(float width);
 
     double minX() const { return m_minX; }
@@ -37,7 +39,8 @@ public:
     double maxY() const { return m_maxY; }
     void setMaxY(double v);
 
-    // Called by ShotDataModel - fast, just appends to internal vector
+    // Called by the data model - fast, just appends to internal vector.
+    // Points must arrive in increasing x (time) order.
     Q_INVOKABLE void appendPoint(double x, double y);
     Q_INVOKABLE void clear();
     // Bulk load for viewing completed shots on page re-entry
@@ -54,14 +57,9 @@ signals:
 protected:
     QSGNode* updatePaintNode(QSGNode* node, UpdatePaintNodeData*) override;
     void itemChange(ItemChange change, const ItemChangeData& data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
 
 private:
-    QVector<QPointF> m_points;  // Data-space coordinates
-    int m_pointCount = 0;
-    QColor m_color = Qt::white;
-    float m_lineWidth = 2.0f;
+    LineStrip m_strip;
     double m_minX = 0, m_maxX = 1, m_minY = 0, m_maxY = 1;
-    bool m_geometryDirty = true;
-    bool m_materialDirty = true;
-
 };
@@ -0,0 +1,198 @@
+#include "fastmultilinerenderer.h"
+
+namespace {
+// Per-series subtree root: the series' axis transform, and a way to drop a
+// hidden series from rendering without tearing down its geometry.
+class SeriesNode : public QSGTransformNode {
+public:
+    bool isSubtreeBlocked() const override { return m_blocked; }
+    void setBlocked(bool blocked) {
+        if (m_blocked == blocked) return;
+        m_blocked = blocked;
+        markDirty(QSGNode::DirtySubtreeBlocked);
+    }
+
+private:
+    bool m_blocked = false;
+};
+}
+
+// --- FastSeries ---
+
+FastSeries::FastSeries(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void FastSeries::setColor(const QColor& color) {
+    if (m_color == color) return;
+    m_color = color;
+    strokeChanged();
+    emit updateRequested();
+    emit colorChanged();
+}
+
+void FastSeries::setLineWidth(float width) {
+    if (qFuzzyCompare(m_lineWidth, width)) return;
+    m_lineWidth = width;
+    strokeChanged();
+    emit updateRequested();
+    emit lineWidthChanged();
+}
+
+void FastSeries::setMinY(double v) {
+    if (qFuzzyCompare(m_minY, v)) return;
+    m_minY = v;
+    emit updateRequested();
+    emit minYChanged();
+}
+
+void FastSeries::setMaxY(double v) {
+    if (qFuzzyCompare(m_maxY, v)) return;
+    m_maxY = v;
+    emit updateRequested();
+    emit maxYChanged();
+}
+
+void FastSeries::setVisible(bool visible) {
+    if (m_visible == visible) return;
+    m_visible = visible;
+    emit updateRequested();
+    emit visibleChanged();
+}
+
+// --- FastLineSeries ---
+
+FastLineSeries::FastLineSeries(QObject* parent)
+    : FastSeries(parent)
+{
+    strokeChanged();
+}
+
+void FastLineSeries::strokeChanged() {
+    m_strip.setColor(color());
+    m_strip.setLineWidth(lineWidth());
+}
+
+void FastLineSeries::appendPoint(double x, double y) {
+    m_strip.append(x, y);
+    emit updateRequested();  // Only the new tail is generated at sync
+}
+
+void FastLineSeries::clear() {
+    m_strip.clear();
+    emit updateRequested();
+}
+
+void FastLineSeries::setPoints(const QVector<QPointF>& points) {
+    m_strip.setPoints(points);
+    emit updateRequested();
+}
+
+// --- FastMultiLineRenderer ---
+
+FastMultiLineRenderer::FastMultiLineRenderer(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void FastMultiLineRenderer::setMinX(double v) {
+    if (qFuzzyCompare(m_minX, v)) return;
+    m_minX = v;
+    update();
+    emit minXChanged();
+}
+
+void FastMultiLineRenderer::setMaxX(double v) {
+    if (qFuzzyCompare(m_maxX, v)) return;
+    m_maxX = v;
+    update();
+    emit maxXChanged();
+}
+
+QQmlListProperty<FastSeries> FastMultiLineRenderer::series() {
+    return QQmlListProperty<FastSeries>(this, nullptr,
+                                            &FastMultiLineRenderer::appendSeries,
+                                            &FastMultiLineRenderer::seriesCount,
+                                            &FastMultiLineRenderer::seriesAt,
+                                            &FastMultiLineRenderer::clearSeries);
+}
+
+void FastMultiLineRenderer::appendSeries(QQmlListProperty<FastSeries>* list, FastSeries* series) {
+    auto* self = static_cast<FastMultiLineRenderer*>(list->object);
+    if (!series) return;
+    series->setParent(self);
+    self->m_series.append(series);
+    connect(series, &FastSeries::updateRequested, self, &QQuickItem::update);
+    self->update();
+}
+
+qsizetype FastMultiLineRenderer::seriesCount(QQmlListProperty<FastSeries>* list) {
+    return static_cast<FastMultiLineRenderer*>(list->object)->m_series.size();
+}
+
+FastSeries* FastMultiLineRenderer::seriesAt(QQmlListProperty<FastSeries>* list, qsizetype index) {
+    return static_cast<FastMultiLineRenderer*>(list->object)->m_series.at(index);
+}
+
+void FastMultiLineRenderer::clearSeries(QQmlListProperty<FastSeries>* list) {
+    auto* self = static_cast<FastMultiLineRenderer*>(list->object);
+    for (FastSeries* series : std::as_const(self->m_series))
+        disconnect(series, &FastSeries::updateRequested, self, &QQuickItem::update);
+    self->m_series.clear();
+    self->update();
+}
+
+void FastMultiLineRenderer::itemChange(ItemChange change, const ItemChangeData& data) {
+    if (change == ItemVisibleHasChanged && data.boolValue) {
+        // When the item becomes visible again (e.g., StackView pop), force a repaint.
+        // The scene graph may have destroyed our QSGNode while we were hidden,
+        // and without an explicit update() call, updatePaintNode() won't be triggered.
+        for (FastSeries* series : std::as_const(m_series))
+            series->invalidate();
+        update();
+    }
+    QQuickItem::itemChange(change, data);
+}
+
+void FastMultiLineRenderer::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) {
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size())
+        update();
+}
+
+QSGNode* FastMultiLineRenderer::updatePaintNode(QSGNode* node, UpdatePaintNodeData*) {
+    // Guard against zero-dimension rendering (e.g., during Loader creation before
+    // ChartView has laid out plotArea). Creating QSGGeometry with zero dimensions
+    // can crash the Metal scene graph on iOS.
+    if (width() <= 0 || height() <= 0) {
+        delete node;
+        return nullptr;
+    }
+
+    // One SeriesNode per series, in declaration order
+    if (node && node->childCount() != m_series.size()) {
+        delete node;
+        node = nullptr;
+    }
+    if (!node) {
+        node = new QSGNode();
+        for (FastSeries* series : std::as_const(m_series)) {
+            node->appendChildNode(new SeriesNode());
+            series->invalidate();
+        }
+    }
+
+    for (qsizetype i = 0; i < m_series.size(); ++i) {
+        FastSeries* series = m_series[i];
+        auto* snode = static_cast<SeriesNode*>(node->childAtIndex(static_cast<int>(i)));
+        snode->setBlocked(!series->isVisible());
+        if (!series->isVisible())
+            continue;
+        series->sync(snode, LineStrip::Viewport::fromAxes(m_minX, m_maxX,
+                                                          series->minY(), series->maxY(),
+                                                          width(), height()));
+    }
+    return node;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "linestrip.h"
+
+#include <QQuickItem>
+#include <QQmlListProperty>
+#include <QColor>
+#include <QPointF>
+#include <QVector>
+
+class FastMultiLineRenderer;
+
+// What a FastMultiLineRenderer needs from a series: style, y-axis and
+// visibility here, geometry in the subclass. The x-axis and plot rectangle
+// belong to the renderer.
+class FastSeries : public QObject {
+    Q_OBJECT
+
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(double minY READ minY WRITE setMinY NOTIFY minYChanged)
+    Q_PROPERTY(double maxY READ maxY WRITE setMaxY NOTIFY maxYChanged)
+    Q_PROPERTY(bool visible READ isVisible WRITE setVisible NOTIFY visibleChanged)
+
+public:
+    QColor color() const { return m_color; }
+    void setColor(const QColor& color);
+
+    float lineWidth() const { return m_lineWidth; }
+    void setLineWidth(float width);
+
+    double minY() const { return m_minY; }
+    void setMinY(double v);
+    double maxY() const { return m_maxY; }
+    void setMaxY(double v);
+
+    bool isVisible() const { return m_visible; }
+    void setVisible(bool visible);
+
+signals:
+    void colorChanged();
+    void lineWidthChanged();
+    void minYChanged();
+    void maxYChanged();
+    void visibleChanged();
+    void updateRequested();
+
+protected:
+    explicit FastSeries(QObject* parent = nullptr);
+
+    // Colour or line width changed; the geometry has to be regenerated.
+    virtual void strokeChanged() = 0;
+    // Render side, called from updatePaintNode with the GUI thread blocked.
+    virtual void invalidate() = 0;
+    virtual void sync(QSGTransformNode* tnode, const LineStrip::Viewport& viewport) = 0;
+
+private:
+    friend class FastMultiLineRenderer;
+
+    QColor m_color = Qt::white;
+    float m_lineWidth = 2.0f;
+    double m_minY = 0, m_maxY = 1;
+    bool m_visible = true;
+};
+
+// A continuous live channel (pressure, flow, weight, ...) drawn as a LineStrip.
+class FastLineSeries : public FastSeries {
+    Q_OBJECT
+
+public:
+    explicit FastLineSeries(QObject* parent = nullptr);
+
+    // Called by ShotDataModel - fast, just appends to internal vector.
+    // Points must arrive in increasing x (time) order.
+    Q_INVOKABLE void appendPoint(double x, double y);
+    Q_INVOKABLE void clear();
+    // Bulk load for viewing completed shots on page re-entry
+    void setPoints(const QVector<QPointF>& points);
+
+protected:
+    void strokeChanged() override;
+    void invalidate() override { m_strip.invalidate(); }
+    void sync(QSGTransformNode* tnode, const LineStrip::Viewport& viewport) override {
+        m_strip.sync(tnode, viewport);
+    }
+
+private:
+    LineStrip m_strip;
+};
+
+// Every live espresso channel in one item: one node subtree, every chunk of
+// every series drawn with the same vertex-colour material so the scene graph
+// renderer merges the whole live chart into a single batch, instead of one
+// item, node, material and draw call per channel. Goal curves and phase
+// markers (FastSegmentSeries) live in the same tree.
+//
+//   FastMultiLineRenderer {
+//       minX: timeAxis.min; maxX: timeAxis.max
+//       FastSegmentSeries { id: pressureGoal; style: Qt.DashLine; ... }
+//       FastLineSeries { id: pressureSeries; color: ...; minY: ...; maxY: ... }
+//       ...
+//   }
+//
+// Series are drawn in declaration order. Hidden series are skipped at sync
+// time and blocked in the scene graph; they catch up when shown again.
+class FastMultiLineRenderer : public QQuickItem {
+    Q_OBJECT
+
+    Q_PROPERTY(double minX READ minX WRITE setMinX NOTIFY minXChanged)
+    Q_PROPERTY(double maxX READ maxX WRITE setMaxX NOTIFY maxXChanged)
+    Q_PROPERTY(QQmlListProperty<FastSeries> series READ series)
+    Q_CLASSINFO("DefaultProperty", "series")
+
+public:
+    explicit FastMultiLineRenderer(QQuickItem* parent = nullptr);
+
+    double minX() const { return m_minX; }
+    void setMinX(double v);
+    double maxX() const { return m_maxX; }
+    void setMaxX(double v);
+
+    QQmlListProperty<FastSeries> series();
+
+signals:
+    void minXChanged();
+    void maxXChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* node, UpdatePaintNodeData*) override;
+    void itemChange(ItemChange change, const ItemChangeData& data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+    static void appendSeries(QQmlListProperty<FastSeries>* list, FastSeries* series);
+    static qsizetype seriesCount(QQmlListProperty<FastSeries>* list);
+    static FastSeries* seriesAt(QQmlListProperty<FastSeries>* list, qsizetype index);
+    static void clearSeries(QQmlListProperty<FastSeries>* list);
+
+    QList<FastSeries*> m_series;
+    double m_minX = 0, m_maxX = 1;
+};
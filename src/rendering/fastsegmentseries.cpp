@@ -0,0 +1,237 @@
+#include "fastsegmentseries.h"
+#include <QSGVertexColorMaterial>
+#include <cmath>
+
+// Each quad takes six vertices: the previous quad's last vertex and its own
+// first vertex (zero-area joins), then its four corners. One terminator after
+// the last quad repeats its last vertex; the constant tail behind it collapses
+// into zero-area triangles, as in LineStrip, so appends never rewrite it.
+static constexpr int QUAD_VERTICES = 6;
+static constexpr int CHUNK_VERTICES = FastSegmentSeries::CHUNK_QUADS * QUAD_VERTICES + 1;
+
+namespace {
+// Qt's built-in pen dash patterns, in units of the line width
+QVector<float> dashPattern(Qt::PenStyle style, float unit) {
+    QVector<float> pattern;
+    switch (style) {
+    case Qt::DashLine:       pattern = {4, 2}; break;
+    case Qt::DotLine:        pattern = {1, 2}; break;
+    case Qt::DashDotLine:    pattern = {4, 2, 1, 2}; break;
+    case Qt::DashDotDotLine: pattern = {4, 2, 1, 2, 1, 2}; break;
+    default: break;  // Solid (custom patterns are not supported)
+    }
+    for (float& length : pattern)
+        length *= unit;
+    return pattern;
+}
+
+QSGGeometryNode* appendChunk(QSGTransformNode* tnode) {
+    auto* gnode = new QSGGeometryNode();
+
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), CHUNK_VERTICES);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    geometry->setVertexDataPattern(QSGGeometry::StreamPattern);
+    auto* v = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < CHUNK_VERTICES; ++i) {
+        v[i].set(0.0f, 0.0f, 0, 0, 0, 0);
+    }
+
+    gnode->setGeometry(geometry);
+    gnode->setFlag(QSGNode::OwnsGeometry);
+
+    // Same material state as LineStrip chunks, so goals and markers merge
+    // into the live lines' batch.
+    gnode->setMaterial(new QSGVertexColorMaterial());
+    gnode->setFlag(QSGNode::OwnsMaterial);
+
+    tnode->appendChildNode(gnode);
+    return gnode;
+}
+
+void markChunksDirty(QSGTransformNode* tnode, int fromChunk) {
+    for (int k = fromChunk; k < tnode->childCount(); ++k) {
+        auto* gnode = static_cast<QSGGeometryNode*>(tnode->childAtIndex(k));
+        gnode->geometry()->markVertexDataDirty();
+        gnode->markDirty(QSGNode::DirtyGeometry);
+    }
+}
+}
+
+FastSegmentSeries::FastSegmentSeries(QObject* parent)
+    : FastSeries(parent)
+{
+}
+
+void FastSegmentSeries::setStyle(Qt::PenStyle style) {
+    if (m_style == style) return;
+    m_style = style;
+    m_geometryDirty = true;
+    emit updateRequested();
+    emit styleChanged();
+}
+
+void FastSegmentSeries::appendPoint(double x, double y) {
+    if (m_breakPending && !m_points.isEmpty())
+        m_segmentStarts.append(m_points.size());
+    m_breakPending = false;
+    m_points.append(QPointF(x, y));
+    emit updateRequested();  // Only the new tail is stroked at sync
+}
+
+void FastSegmentSeries::breakSegment() {
+    m_breakPending = true;
+}
+
+void FastSegmentSeries::clear() {
+    m_points.clear();
+    m_segmentStarts.clear();
+    m_breakPending = false;
+    m_geometryDirty = true;
+    emit updateRequested();
+}
+
+void FastSegmentSeries::setSegments(const QVector<QVector<QPointF>>& segments) {
+    m_points.clear();
+    m_segmentStarts.clear();
+    for (const auto& segment : segments) {
+        if (segment.isEmpty()) continue;
+        if (!m_points.isEmpty())
+            m_segmentStarts.append(m_points.size());
+        m_points.append(segment);
+    }
+    m_breakPending = false;
+    m_geometryDirty = true;
+    emit updateRequested();
+}
+
+FastSegmentSeries::Pixel FastSegmentSeries::toBakedPixel(qsizetype i) const {
+    return {static_cast<float>((m_points[i].x() - m_bake.minX) * (m_bake.width / m_bake.rangeX)),
+            m_bake.height - static_cast<float>((m_points[i].y() - m_bake.minY) * (m_bake.height / m_bake.rangeY))};
+}
+
+void FastSegmentSeries::startSegment() {
+    m_hasLast = false;
+    m_dashIndex = 0;
+    m_dashRemaining = m_pattern.isEmpty() ? 0.0f : m_pattern[0];
+}
+
+void FastSegmentSeries::consumePoint(qsizetype i, QSGTransformNode* tnode) {
+    if (m_nextStart < m_segmentStarts.size() && m_segmentStarts[m_nextStart] == i) {
+        ++m_nextStart;
+        startSegment();
+    }
+    const Pixel p = toBakedPixel(i);
+    if (m_hasLast)
+        strokePiece(m_last, p, tnode);
+    m_last = p;
+    m_hasLast = true;
+}
+
+void FastSegmentSeries::strokePiece(Pixel a, Pixel b, QSGTransformNode* tnode) {
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float len = std::sqrt(dx * dx + dy * dy);
+    if (len < 1e-6f) return;
+    if (m_pattern.isEmpty()) {
+        appendQuad(a, b, tnode);
+        return;
+    }
+
+    // Walk the dash pattern along the piece; the phase carries into the next one.
+    const float ux = dx / len;
+    const float uy = dy / len;
+    float left = len;
+    while (left > 0.0f) {
+        const float step = qMin(m_dashRemaining, left);
+        if ((m_dashIndex & 1) == 0) {
+            const float t = len - left;
+            appendQuad({a.x + ux * t, a.y + uy * t},
+                       {a.x + ux * (t + step), a.y + uy * (t + step)}, tnode);
+        }
+        left -= step;
+        m_dashRemaining -= step;
+        if (m_dashRemaining <= 0.0f) {
+            m_dashIndex = (m_dashIndex + 1) % static_cast<int>(m_pattern.size());
+            m_dashRemaining = m_pattern[m_dashIndex];
+        }
+    }
+}
+
+void FastSegmentSeries::appendQuad(Pixel a, Pixel b, QSGTransformNode* tnode) {
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float len = std::sqrt(dx * dx + dy * dy);
+    if (len < 1e-6f) return;
+    const float halfWidth = lineWidth() * 0.5f;
+    const float nx = -dy / len * halfWidth;
+    const float ny = dx / len * halfWidth;
+
+    const int chunk = m_quads / CHUNK_QUADS;
+    const int slot = m_quads % CHUNK_QUADS;
+    while (tnode->childCount() <= chunk)
+        appendChunk(tnode);
+    auto* gnode = static_cast<QSGGeometryNode*>(tnode->childAtIndex(chunk));
+    auto* v = gnode->geometry()->vertexDataAsColoredPoint2D() + slot * QUAD_VERTICES;
+
+    const uchar r = static_cast<uchar>(qRed(m_vertexColor));
+    const uchar g = static_cast<uchar>(qGreen(m_vertexColor));
+    const uchar bl = static_cast<uchar>(qBlue(m_vertexColor));
+    const uchar al = static_cast<uchar>(qAlpha(m_vertexColor));
+    v[2].set(a.x + nx, a.y + ny, r, g, bl, al);
+    v[3].set(a.x - nx, a.y - ny, r, g, bl, al);
+    v[4].set(b.x + nx, b.y + ny, r, g, bl, al);
+    v[5].set(b.x - nx, b.y - ny, r, g, bl, al);
+    v[0] = slot == 0 ? v[2] : m_lastVertex;
+    v[1] = v[2];
+    v[6] = v[5];  // Terminator (overwritten by the next quad's join)
+
+    m_lastVertex = v[5];
+    ++m_quads;
+}
+
+void FastSegmentSeries::rebuild(QSGTransformNode* tnode) {
+    // Fresh chunks: their tails must be constant for the terminator trick.
+    while (QSGNode* child = tnode->firstChild()) {
+        tnode->removeChildNode(child);
+        delete child;
+    }
+    tnode->setMatrix(QMatrix4x4());
+
+    m_pattern = dashPattern(m_style, qMax(lineWidth(), 1.0f));
+    m_vertexColor = qPremultiply(color().rgba());  // QSGVertexColorMaterial expects premultiplied alpha
+    m_quads = 0;
+    m_consumed = 0;
+    m_nextStart = 0;
+    startSegment();
+
+    if (!m_bake.valid())
+        return;
+    for (; m_consumed < m_points.size(); ++m_consumed)
+        consumePoint(m_consumed, tnode);
+    markChunksDirty(tnode, 0);
+}
+
+void FastSegmentSeries::sync(QSGTransformNode* tnode, const LineStrip::Viewport& viewport) {
+    if (!m_geometryDirty && !(viewport == m_synced)) {
+        QMatrix4x4 matrix;
+        if (LineStrip::bakedTransform(m_bake, viewport, &matrix))
+            tnode->setMatrix(matrix);
+        else
+            m_geometryDirty = true;
+    }
+    m_synced = viewport;
+
+    if (m_geometryDirty) {
+        m_bake = viewport;
+        rebuild(tnode);
+        m_geometryDirty = false;
+        return;
+    }
+    if (!m_bake.valid() || m_consumed >= m_points.size())
+        return;
+
+    const int fromChunk = m_quads / CHUNK_QUADS;
+    for (; m_consumed < m_points.size(); ++m_consumed)
+        consumePoint(m_consumed, tnode);
+    markChunksDirty(tnode, fromChunk);
+}
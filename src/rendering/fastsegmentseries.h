@@ -0,0 +1,81 @@
+#pragma once
+
+#include "fastmultilinerenderer.h"
+
+#include <QVector>
+#include <QPointF>
+
+// A FastMultiLineRenderer series made of separate, optionally dashed polyline
+// segments: profile goals (which break on every pump-mode switch) and phase
+// marker lines. One series holds any number of segments, so a shot with many
+// mode switches or frames needs no extra items.
+//
+// Like LineStrip, geometry is generated in baked pixel space and axis changes
+// go through the transform node; appending points only strokes the new tail,
+// with the dash phase carried over. Dashes are quads in fixed-size triangle
+// strip chunks (degenerate joins between them) so they batch with the live
+// lines. Dash lengths are in units of the line width, as for QPen.
+class FastSegmentSeries : public FastSeries {
+    Q_OBJECT
+
+    Q_PROPERTY(Qt::PenStyle style READ style WRITE setStyle NOTIFY styleChanged)
+
+public:
+    static constexpr int CHUNK_QUADS = 128;  // Dash quads per geometry node
+
+    explicit FastSegmentSeries(QObject* parent = nullptr);
+
+    Qt::PenStyle style() const { return m_style; }
+    void setStyle(Qt::PenStyle style);
+
+    // Points within a segment must arrive in non-decreasing x (time) order;
+    // vertical runs (phase markers) are fine.
+    Q_INVOKABLE void appendPoint(double x, double y);
+    // The next point starts a new segment, leaving a gap.
+    Q_INVOKABLE void breakSegment();
+    Q_INVOKABLE void clear();
+    // Bulk load; empty segments are skipped.
+    void setSegments(const QVector<QVector<QPointF>>& segments);
+
+signals:
+    void styleChanged();
+
+protected:
+    void strokeChanged() override { m_geometryDirty = true; }
+    void invalidate() override { m_geometryDirty = true; }
+    void sync(QSGTransformNode* tnode, const LineStrip::Viewport& viewport) override;
+
+private:
+    struct Pixel { float x, y; };
+
+    Pixel toBakedPixel(qsizetype i) const;
+    void consumePoint(qsizetype i, QSGTransformNode* tnode);
+    void strokePiece(Pixel a, Pixel b, QSGTransformNode* tnode);
+    void appendQuad(Pixel a, Pixel b, QSGTransformNode* tnode);
+    void startSegment();
+    void rebuild(QSGTransformNode* tnode);
+
+    Qt::PenStyle m_style = Qt::SolidLine;
+    QVector<QPointF> m_points;          // Data-space coordinates
+    QVector<qsizetype> m_segmentStarts; // Indices into m_points that begin a segment (after the first)
+    bool m_breakPending = false;
+    bool m_geometryDirty = true;
+
+    // Render-side state
+    LineStrip::Viewport m_bake;
+    LineStrip::Viewport m_synced;
+    QVector<float> m_pattern;           // Dash/gap lengths in pixels, empty = solid
+    QRgb m_vertexColor = 0;             // Premultiplied
+    qsizetype m_consumed = 0;           // m_points stroked so far
+    qsizetype m_nextStart = 0;          // Next entry of m_segmentStarts to reach
+    bool m_hasLast = false;             // m_last is the open end of the current segment
+    Pixel m_last{0, 0};
+    int m_dashIndex = 0;                // Current pattern entry (even = dash, odd = gap)
+    float m_dashRemaining = 0;          // Pixels left in it
+    int m_quads = 0;                    // Quads written
+    QSGGeometry::ColoredPoint2D m_lastVertex{};  // Last vertex of the previous quad
+
+#ifdef DECENZA_TESTING
+    friend class tst_LineStrip;
+#endif
+};
@@ -0,0 +1,307 @@
+#include "linestrip.h"
+#include <QSGVertexColorMaterial>
+#include <cmath>
+
+// Chunk k draws render points [k * CHUNK_POINTS, (k + 1) * CHUNK_POINTS]: the
+// boundary point is in both chunks so the strips join without a gap. Each point
+// is 2 vertices (left/right of the line center), plus one terminator that
+// repeats the last vertex. Everything past the terminator stays at its initial
+// constant, so the strip collapses into zero-area triangles without having to
+// rewrite the unused tail on every append.
+static constexpr int CHUNK_VERTICES = (LineStrip::CHUNK_POINTS + 1) * 2 + 1;
+
+namespace {
+struct Rgba { uchar r, g, b, a; };
+
+// QSGVertexColorMaterial expects premultiplied alpha
+Rgba premultiplied(const QColor& color) {
+    const QColor c = color.toRgb();
+    const int a = c.alpha();
+    return {static_cast<uchar>(c.red() * a / 255), static_cast<uchar>(c.green() * a / 255),
+            static_cast<uchar>(c.blue() * a / 255), static_cast<uchar>(a)};
+}
+}
+
+void LineStrip::clear() {
+    m_points.clear();
+    m_geometryDirty = true;
+}
+
+void LineStrip::setPoints(const QVector<QPointF>& points) {
+    m_points = points;
+    m_geometryDirty = true;
+}
+
+void LineStrip::setColor(const QColor& color) {
+    if (m_color == color) return;
+    m_color = color;
+    m_geometryDirty = true;  // Colour lives in the vertices
+}
+
+void LineStrip::setLineWidth(float width) {
+    if (qFuzzyCompare(m_lineWidth, width)) return;
+    m_lineWidth = width;
+    m_geometryDirty = true;
+}
+
+LineStrip::RenderPoint LineStrip::toBakedPixel(int i) const {
+    return {static_cast<float>((m_points[i].x() - m_bake.minX) * (m_bake.width / m_bake.rangeX)),
+            m_bake.height - static_cast<float>((m_points[i].y() - m_bake.minY) * (m_bake.height / m_bake.rangeY))};
+}
+
+void LineStrip::consumePoint(int i) {
+    const RenderPoint p = toBakedPixel(i);
+    if (!m_decimate) {
+        m_render.append(p);
+        return;
+    }
+
+    // Min/max per pixel column, emitted in time order. A column's entries
+    // only ever go from one to two, so earlier columns are never touched.
+    const qint64 column = static_cast<qint64>(std::floor(p.x));
+    if (m_columnMinIndex < 0 || column != m_column) {
+        m_column = column;
+        m_columnStart = static_cast<int>(m_render.size());
+        m_columnMinIndex = m_columnMaxIndex = i;
+        m_columnMin = m_columnMax = p;
+        m_render.append(p);
+        return;
+    }
+
+    if (p.y < m_columnMin.y) {
+        m_columnMinIndex = i;
+        m_columnMin = p;
+    } else if (p.y > m_columnMax.y) {
+        m_columnMaxIndex = i;
+        m_columnMax = p;
+    } else {
+        return;
+    }
+
+    m_render.resize(m_columnStart);
+    if (m_columnMinIndex == m_columnMaxIndex) {
+        m_render.append(m_columnMin);
+    } else if (m_columnMinIndex < m_columnMaxIndex) {
+        m_render.append(m_columnMin);
+        m_render.append(m_columnMax);
+    } else {
+        m_render.append(m_columnMax);
+        m_render.append(m_columnMin);
+    }
+    m_dirtyRender = qMin(m_dirtyRender, m_columnStart);
+}
+
+void LineStrip::vertexPair(int r, float halfWidth, QSGGeometry::ColoredPoint2D* out) const {
+    // Emit two vertices offset perpendicular to the line direction by halfWidth.
+    const int count = static_cast<int>(m_render.size());
+    const float x = m_render[r].x;
+    const float y = m_render[r].y;
+    float nx, ny;
+    if (r == 0) {
+        // First point: use direction to next point
+        float dx = m_render[1].x - x;
+        float dy = m_render[1].y - y;
+        float len = std::sqrt(dx * dx + dy * dy);
+        if (len < 1e-6f) len = 1.0f;
+        nx = -dy / len;
+        ny = dx / len;
+    } else if (r == count - 1) {
+        // Last point: use direction from previous point
+        float dx = x - m_render[r - 1].x;
+        float dy = y - m_render[r - 1].y;
+        float len = std::sqrt(dx * dx + dy * dy);
+        if (len < 1e-6f) len = 1.0f;
+        nx = -dy / len;
+        ny = dx / len;
+    } else {
+        // Middle points: average the normals of adjacent segments (miter join)
+        float dx1 = x - m_render[r - 1].x;
+        float dy1 = y - m_render[r - 1].y;
+        float len1 = std::sqrt(dx1 * dx1 + dy1 * dy1);
+        if (len1 < 1e-6f) len1 = 1.0f;
+        float nx1 = -dy1 / len1;
+        float ny1 = dx1 / len1;
+
+        float dx2 = m_render[r + 1].x - x;
+        float dy2 = m_render[r + 1].y - y;
+        float len2 = std::sqrt(dx2 * dx2 + dy2 * dy2);
+        if (len2 < 1e-6f) len2 = 1.0f;
+        float nx2 = -dy2 / len2;
+        float ny2 = dx2 / len2;
+
+        nx = (nx1 + nx2) * 0.5f;
+        ny = (ny1 + ny2) * 0.5f;
+        float nlen = std::sqrt(nx * nx + ny * ny);
+        if (nlen < 1e-6f) { nx = nx1; ny = ny1; }
+        else {
+            // Scale miter normal so the perpendicular offset equals halfWidth.
+            // dot(avgNormal, segNormal) gives the cosine of the half-angle;
+            // dividing by it corrects the miter length. Clamp to avoid spikes.
+            float dot = nx * nx1 + ny * ny1;
+            float miterLen = (dot > 0.25f) ? (nlen / dot) : 2.0f;
+            if (miterLen > 2.0f) miterLen = 2.0f;
+            nx = nx / nlen * miterLen;
+            ny = ny / nlen * miterLen;
+        }
+    }
+
+    const Rgba c = premultiplied(m_color);
+    out[0].set(x + nx * halfWidth, y + ny * halfWidth, c.r, c.g, c.b, c.a);
+    out[1].set(x - nx * halfWidth, y - ny * halfWidth, c.r, c.g, c.b, c.a);
+}
+
+QSGGeometryNode* LineStrip::appendChunk(QSGTransformNode* tnode) const {
+    auto* gnode = new QSGGeometryNode();
+
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), CHUNK_VERTICES);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    geometry->setVertexDataPattern(QSGGeometry::StreamPattern);
+    auto* v = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < CHUNK_VERTICES; ++i) {
+        v[i].set(0.0f, 0.0f, 0, 0, 0, 0);
+    }
+
+    gnode->setGeometry(geometry);
+    gnode->setFlag(QSGNode::OwnsGeometry);
+
+    // Identical material state on every chunk of every series: the renderer
+    // merges them into one batch.
+    gnode->setMaterial(new QSGVertexColorMaterial());
+    gnode->setFlag(QSGNode::OwnsMaterial);
+
+    tnode->appendChildNode(gnode);
+    return gnode;
+}
+
+void LineStrip::writeVertices(QSGTransformNode* tnode, int fromRender) {
+    // Regenerates render points [fromRender, end) and the terminator of every
+    // chunk they touch. Needs at least two render points.
+    const int count = static_cast<int>(m_render.size());
+    const float halfWidth = m_lineWidth * 0.5f;
+
+    const int lastChunk = (count - 2) / CHUNK_POINTS;
+    while (tnode->childCount() <= lastChunk)
+        appendChunk(tnode);
+
+    const int firstChunk = qMax(0, (fromRender - 1) / CHUNK_POINTS);
+    for (int k = firstChunk; k <= lastChunk; ++k) {
+        auto* gnode = static_cast<QSGGeometryNode*>(tnode->childAtIndex(k));
+        auto* v = gnode->geometry()->vertexDataAsColoredPoint2D();
+        const int base = k * CHUNK_POINTS;
+        const int end = qMin(count, base + CHUNK_POINTS + 1);
+        for (int r = qMax(base, fromRender); r < end; ++r)
+            vertexPair(r, halfWidth, v + 2 * (r - base));
+
+        const int vi = (end - base) * 2;
+        v[vi] = v[vi - 1];
+        gnode->geometry()->markVertexDataDirty();
+        gnode->markDirty(QSGNode::DirtyGeometry);
+    }
+    m_builtRender = count;
+    m_dirtyRender = count;
+}
+
+void LineStrip::rebuild(QSGTransformNode* tnode) {
+    // Fresh chunks: their tails must be constant for the terminator trick,
+    // and the new series may be shorter than the old one.
+    while (QSGNode* child = tnode->firstChild()) {
+        tnode->removeChildNode(child);
+        delete child;
+    }
+    tnode->setMatrix(QMatrix4x4());
+
+    m_render.clear();
+    m_consumed = 0;
+    m_columnMinIndex = m_columnMaxIndex = -1;
+    m_builtRender = 0;
+    m_dirtyRender = 0;
+    m_decimate = m_bake.valid()
+        && m_points.size() > LOD_POINTS_PER_PIXEL * m_bake.width;
+
+    if (!m_bake.valid() || m_points.isEmpty())
+        return;
+
+    for (; m_consumed < m_points.size(); ++m_consumed)
+        consumePoint(m_consumed);
+
+    if (m_render.size() > 1) {
+        writeVertices(tnode, 0);
+        return;
+    }
+
+    // Single point: draw a small dot
+    auto* gnode = appendChunk(tnode);
+    auto* v = gnode->geometry()->vertexDataAsColoredPoint2D();
+    const float halfWidth = m_lineWidth * 0.5f;
+    const float px = m_render[0].x;
+    const float py = m_render[0].y;
+    const Rgba c = premultiplied(m_color);
+    v[0].set(px - halfWidth, py - halfWidth, c.r, c.g, c.b, c.a);
+    v[1].set(px + halfWidth, py - halfWidth, c.r, c.g, c.b, c.a);
+    for (int i = 2; i < CHUNK_VERTICES; ++i) {
+        v[i].set(px, py, c.r, c.g, c.b, c.a);
+    }
+    m_builtRender = 1;
+    m_dirtyRender = 1;
+}
+
+bool LineStrip::bakedTransform(const Viewport& bake, const Viewport& now, QMatrix4x4* matrix) {
+    // Map baked pixel space onto the current axes/size:
+    //   x' = ax * x + bx,  y' = ay * y + by
+    if (!bake.valid() || !now.valid())
+        return false;
+
+    const double ax = (bake.rangeX / bake.width) * (now.width / now.rangeX);
+    const double ay = (bake.rangeY / bake.height) * (now.height / now.rangeY);
+    const auto withinTolerance = [](double scale) {
+        return scale <= REBAKE_TOLERANCE && scale >= 1.0 / REBAKE_TOLERANCE;
+    };
+    if (!withinTolerance(ax) || !withinTolerance(ay))
+        return false;
+
+    const double bx = (bake.minX - now.minX) * (now.width / now.rangeX);
+    const double by = now.height - (bake.minY - now.minY) * (now.height / now.rangeY)
+                      - bake.height * ay;
+
+    matrix->setToIdentity();
+    matrix->translate(static_cast<float>(bx), static_cast<float>(by));
+    matrix->scale(static_cast<float>(ax), static_cast<float>(ay));
+    return true;
+}
+
+bool LineStrip::updateTransform(QSGTransformNode* tnode, const Viewport& now) {
+    // Returns false when the vertices need regenerating instead.
+    QMatrix4x4 matrix;
+    if (!bakedTransform(m_bake, now, &matrix))
+        return false;
+    tnode->setMatrix(matrix);
+    return true;
+}
+
+void LineStrip::sync(QSGTransformNode* tnode, const Viewport& viewport) {
+    if (!m_geometryDirty && !(viewport == m_synced)) {
+        if (!updateTransform(tnode, viewport))
+            m_geometryDirty = true;
+    }
+    m_synced = viewport;
+
+    // The incremental path needs a strip to extend, and switches to the
+    // decimated representation only through a rebuild.
+    const int pointCount = static_cast<int>(m_points.size());
+    if (!m_geometryDirty && pointCount != m_consumed
+        && (pointCount < m_consumed || m_builtRender < 2
+            || (!m_decimate && pointCount > LOD_POINTS_PER_PIXEL * m_bake.width)))
+        m_geometryDirty = true;
+
+    if (m_geometryDirty) {
+        m_bake = viewport;
+        rebuild(tnode);
+        m_geometryDirty = false;
+    } else if (pointCount > m_consumed) {
+        m_dirtyRender = static_cast<int>(m_render.size());
+        for (; m_consumed < pointCount; ++m_consumed)
+            consumePoint(m_consumed);
+        // The previous last point loses its end cap and becomes a miter join.
+        writeVertices(tnode, qMax(0, m_dirtyRender - 1));
+    }
+}
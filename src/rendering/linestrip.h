@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QColor>
+#include <QPointF>
+#include <QVector>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+
+// One thick polyline series, drawn as triangle strips in fixed-size geometry
+// chunks under a QSGTransformNode the owning item provides. Shared by
+// FastLineRenderer (one series per item) and FastMultiLineRenderer (every
+// live shot channel in one item).
+//
+// Vertices are extruded in pixel space for the axis ranges and size they
+// were "baked" at. Appending points only generates the new tail (plus the
+// previous last point, whose end cap becomes a miter join). Axis or size
+// changes are applied through the transform node's matrix instead of
+// regenerating vertices; the strip is only re-baked once that stretch would
+// visibly distort the line width (REBAKE_TOLERANCE), or when the data is
+// replaced. A live shot therefore costs O(new points) per frame, with a
+// logarithmic number of full rebuilds as the time axis grows.
+//
+// The series has no length cap: geometry grows a CHUNK_POINTS chunk at a
+// time. Once a series has more than LOD_POINTS_PER_PIXEL points per pixel
+// column it is drawn min/max-decimated — each column contributes its lowest
+// and highest sample in time order — which bounds the vertex count by the
+// item width however long the shot runs.
+//
+// The colour is written into every vertex (QSGVertexColorMaterial), so all
+// strips share one material state and the scene graph renderer can merge
+// every chunk of every series into a single batch.
+//
+// The data-side calls (append/clear/setPoints/setColor/setLineWidth) run on
+// the GUI thread; sync() runs in updatePaintNode with the GUI thread blocked.
+class LineStrip {
+public:
+    static constexpr int CHUNK_POINTS = 256;             // Points per geometry node
+    static constexpr double LOD_POINTS_PER_PIXEL = 2.0;  // Decimate above this density
+    // Largest axis stretch (either direction) applied by matrix before the
+    // strip is regenerated at the current scale.
+    static constexpr double REBAKE_TOLERANCE = 1.1;
+
+    // Axis ranges + item size, in the item's coordinate system
+    struct Viewport {
+        double minX = 0, minY = 0, rangeX = 0, rangeY = 0;
+        float width = 0, height = 0;
+        static Viewport fromAxes(double minX, double maxX, double minY, double maxY,
+                                 qreal width, qreal height) {
+            return {minX, minY, maxX - minX, maxY - minY,
+                    static_cast<float>(width), static_cast<float>(height)};
+        }
+        bool valid() const { return rangeX > 0 && rangeY > 0 && width > 0 && height > 0; }
+        bool operator==(const Viewport& o) const {
+            return minX == o.minX && minY == o.minY && rangeX == o.rangeX && rangeY == o.rangeY
+                && width == o.width && height == o.height;
+        }
+    };
+
+    // Matrix that maps geometry generated in `bake`'s pixel space onto `now`.
+    // False when the stretch exceeds REBAKE_TOLERANCE (or either viewport is
+    // empty) and the geometry should be regenerated instead.
+    static bool bakedTransform(const Viewport& bake, const Viewport& now, QMatrix4x4* matrix);
+
+    // Points must arrive in increasing x (time) order.
+    void append(double x, double y) { m_points.append(QPointF(x, y)); }
+    void clear();
+    void setPoints(const QVector<QPointF>& points);
+    qsizetype size() const { return m_points.size(); }
+
+    QColor color() const { return m_color; }
+    void setColor(const QColor& color);
+    float lineWidth() const { return m_lineWidth; }
+    void setLineWidth(float width);
+
+    // Forces a full rebuild on the next sync (e.g. the node tree was recreated).
+    void invalidate() { m_geometryDirty = true; }
+
+    // Brings `tnode` (and its chunk children) up to date.
+    void sync(QSGTransformNode* tnode, const Viewport& viewport);
+
+private:
+    struct RenderPoint { float x, y; };  // Baked pixel space
+
+    RenderPoint toBakedPixel(int i) const;
+    void consumePoint(int i);
+    void vertexPair(int r, float halfWidth, QSGGeometry::ColoredPoint2D* out) const;
+    QSGGeometryNode* appendChunk(QSGTransformNode* tnode) const;
+    void writeVertices(QSGTransformNode* tnode, int fromRender);
+    void rebuild(QSGTransformNode* tnode);
+    bool updateTransform(QSGTransformNode* tnode, const Viewport& viewport);
+
+    QVector<QPointF> m_points;  // Data-space coordinates
+    QColor m_color = Qt::white;
+    float m_lineWidth = 2.0f;
+    bool m_geometryDirty = true;    // Full rebuild: data replaced, style changed, node recreated
+
+    // Render-side state
+    Viewport m_bake;                // Viewport the vertices were generated for
+    Viewport m_synced;              // Viewport the transform was last set for
+    bool m_decimate = false;
+    QVector<RenderPoint> m_render;  // Points the strips are built from
+    int m_consumed = 0;             // m_points folded into m_render
+    int m_builtRender = 0;          // m_render entries with valid vertices
+    int m_dirtyRender = 0;          // First m_render entry changed since the last build
+
+    // Pixel column being filled in decimated mode
+    qint64 m_column = 0;
+    int m_columnStart = 0;          // Its first entry in m_render
+    int m_columnMinIndex = -1, m_columnMaxIndex = -1;  // Into m_points
+    RenderPoint m_columnMin{0, 0}, m_columnMax{0, 0};
+
+#ifdef DECENZA_TESTING
+    friend class tst_LineStrip;
+#endif
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <QByteArray>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Splits the DE1's serial notification stream into lines and decodes them
+ * where they lie: "[M]0a1b2c...\r\n" becomes letter 'M' plus the payload
+ * bytes.
+ *
+ * feed() calls, for each complete line that isn't blank, in order:
+ *
+ *   onLine(char letter, const QByteArray& payload)   // "[X]hex", X unchecked
+ *   onMalformed(const char* line, int length)        // anything else
+ *
+ * Lines are parsed in place in the bytes being fed; only an incomplete tail
+ * is copied into a fixed buffer. Hex goes through a lookup table into one
+ * payload buffer reused for every line (non-hex characters are skipped and
+ * an odd leading digit stands alone, as with QByteArray::fromHex), so once
+ * the payload has grown to the longest line nothing is allocated per line.
+ * A callback that keeps a copy of payload is fine — the next line detaches
+ * it — but it costs an allocation.
+ */
+class SerialLineDecoder {
+public:
+    // An incomplete line longer than this is garbage (the longest DE1 line is
+    // a few dozen bytes); it's dropped up to its newline
+    static constexpr int MAX_LINE_LENGTH = 4096;
+
+    SerialLineDecoder() { m_payload.reserve(64); }
+
+    // Returns the number of bytes dropped as an over-long line
+    template <typename OnLine, typename OnMalformed>
+    qsizetype feed(const char* data, qsizetype size, OnLine&& onLine, OnMalformed&& onMalformed)
+    {
+        const char* const end = data + size;
+        qsizetype dropped = 0;
+
+        if (m_partialSize > 0 || m_discarding) {
+            const char* newline = findNewline(data, end);
+            const qsizetype chunk = (newline ? newline : end) - data;
+            if (m_discarding || m_partialSize + chunk > MAX_LINE_LENGTH) {
+                dropped = m_partialSize + chunk;
+                m_partialSize = 0;
+                m_discarding = (newline == nullptr);
+            } else {
+                std::memcpy(m_partial.data() + m_partialSize, data, static_cast<size_t>(chunk));
+                m_partialSize += static_cast<int>(chunk);
+                if (newline) {
+                    decodeLine(m_partial.data(), m_partialSize, onLine, onMalformed);
+                    m_partialSize = 0;
+                }
+            }
+            if (!newline) return dropped;
+            data = newline + 1;
+        }
+
+        while (const char* newline = findNewline(data, end)) {
+            decodeLine(data, static_cast<int>(newline - data), onLine, onMalformed);
+            data = newline + 1;
+        }
+
+        const qsizetype tail = end - data;
+        if (tail > MAX_LINE_LENGTH) {
+            dropped += tail;
+            m_discarding = true;
+        } else {
+            std::memcpy(m_partial.data(), data, static_cast<size_t>(tail));
+            m_partialSize = static_cast<int>(tail);
+        }
+        return dropped;
+    }
+
+    template <typename OnLine, typename OnMalformed>
+    qsizetype feed(const QByteArray& data, OnLine&& onLine, OnMalformed&& onMalformed)
+    {
+        return feed(data.constData(), data.size(), onLine, onMalformed);
+    }
+
+    void clear()
+    {
+        m_partialSize = 0;
+        m_discarding = false;
+    }
+
+    int pendingBytes() const { return m_partialSize; }
+
+private:
+    static const char* findNewline(const char* data, const char* end)
+    {
+        return static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+    }
+
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+    }
+
+    // Nibble value of an ASCII hex digit, -1 for anything else
+    static int8_t hexValue(char c)
+    {
+        static constexpr std::array<int8_t, 256> table = [] {
+            std::array<int8_t, 256> t{};
+            for (auto& v : t) v = -1;
+            for (int i = 0; i < 10; ++i) t['0' + i] = static_cast<int8_t>(i);
+            for (int i = 0; i < 6; ++i) {
+                t['a' + i] = static_cast<int8_t>(10 + i);
+                t['A' + i] = static_cast<int8_t>(10 + i);
+            }
+            return t;
+        }();
+        return table[static_cast<uint8_t>(c)];
+    }
+
+    template <typename OnLine, typename OnMalformed>
+    void decodeLine(const char* line, int length, OnLine& onLine, OnMalformed& onMalformed)
+    {
+        while (length > 0 && isSpace(line[0])) { ++line; --length; }
+        while (length > 0 && isSpace(line[length - 1])) --length;
+        if (length == 0) return;
+
+        if (length < 3 || line[0] != '[' || line[2] != ']') {
+            onMalformed(line, length);
+            return;
+        }
+
+        const char* hex = line + 3;
+        const int hexLength = length - 3;
+        int digits = 0;
+        for (int i = 0; i < hexLength; ++i)
+            digits += hexValue(hex[i]) >= 0;
+
+        m_payload.resize((digits + 1) / 2);
+        char* out = m_payload.data();
+        bool high = (digits % 2 == 0);
+        uint8_t byte = 0;
+        for (int i = 0; i < hexLength; ++i) {
+            const int8_t v = hexValue(hex[i]);
+            if (v < 0) continue;
+            if (high) {
+                byte = static_cast<uint8_t>(v << 4);
+            } else {
+                *out++ = static_cast<char>(byte | v);
+                byte = 0;
+            }
+            high = !high;
+        }
+
+        onLine(line[1], static_cast<const QByteArray&>(m_payload));
+    }
+
+    std::array<char, MAX_LINE_LENGTH> m_partial;
+    int m_partialSize = 0;
+    bool m_discarding = false;   // Inside an over-long line, until its newline
+    QByteArray m_payload;
+};
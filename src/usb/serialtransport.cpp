@@ -1,4 +1,5 @@
 #include "usb/serialtransport.h"
+#include "ble/arrivalclock.h"
 #include "ble/protocol/de1characteristics.h"
 
 #ifdef Q_OS_ANDROID
@@ -6,6 +7,7 @@
 #endif
 
 #include <QDebug>
+#include <array>
 
 // ===========================================================================
 // Constructor / Destructor
@@ -139,7 +141,7 @@ void SerialTransport::disconnect()
     bool wasConnected = m_connected;
     m_connected = false;
     m_subscribed.clear();
-    m_buffer.clear();
+    m_decoder.clear();
 
     if (wasConnected) {
         emit logMessage(QStringLiteral("[USB] Disconnected: %1").arg(m_portName));
@@ -186,7 +188,7 @@ void SerialTransport::open()
     }
 
     m_connected = true;
-    m_buffer.clear();
+    m_decoder.clear();
     m_subscribed.clear();
 
     // Start polling for incoming data (20ms = 50Hz — responsive for ~5Hz shot data)
@@ -209,7 +211,7 @@ void SerialTransport::open()
     m_port->setRequestToSend(false);
 
     m_connected = true;
-    m_buffer.clear();
+    m_decoder.clear();
     m_subscribed.clear();
 
     emit logMessage(QStringLiteral("[USB] Port opened: %1 (115200 8N1)").arg(m_portName));
@@ -248,19 +250,23 @@ void SerialTransport::onAndroidReadTimer()
         return;
     }
 
-    QByteArray data = AndroidUsbHelper::readAvailable();
+    const QByteArray data = AndroidUsbHelper::readAvailable();
     if (data.isEmpty()) return;
 
-    m_buffer.append(data);
-    processBuffer();
+    processData(data.constData(), data.size(), ArrivalClock::nowMs());
 }
 
 #else // Desktop
 
 void SerialTransport::onReadyRead()
 {
-    m_buffer.append(m_port->readAll());
-    processBuffer();
+    // Read through a stack buffer rather than readAll(), which allocates a
+    // QByteArray per readyRead
+    const qint64 arrivalMs = ArrivalClock::nowMs();
+    char chunk[512];
+    qint64 n;
+    while ((n = m_port->read(chunk, sizeof(chunk))) > 0)
+        processData(chunk, n, arrivalMs);
 }
 
 void SerialTransport::onErrorOccurred(QSerialPort::SerialPortError error)
@@ -303,64 +309,39 @@ void SerialTransport::writeRaw(const QByteArray& data)
 #endif
 }
 
-void SerialTransport::processBuffer()
+void SerialTransport::processData(const char* data, qsizetype size, qint64 arrivalMs)
 {
-    // Process complete lines (terminated by \n)
-    while (true) {
-        qsizetype idx = m_buffer.indexOf('\n');
-        if (idx == -1) {
-            break;
-        }
-
-        QString line = QString::fromLatin1(m_buffer.left(idx)).trimmed();
-        m_buffer.remove(0, idx + 1);
-
-        if (!line.isEmpty()) {
-            processLine(line);
-        }
-    }
-
-    // Safety: prevent unbounded buffer growth from garbage data
-    if (m_buffer.size() > 4096) {
-        qWarning() << "[USB] Buffer overflow, discarding" << m_buffer.size() << "bytes";
-        m_buffer.clear();
+    const qsizetype dropped = m_decoder.feed(data, size,
+        [this, arrivalMs](char letter, const QByteArray& payload) {
+            const QBluetoothUuid uuid = letterToUuid(letter);
+            if (uuid.isNull()) {
+                emit logMessage(QStringLiteral("[USB] RX unknown letter: %1").arg(QChar(letter)));
+                return;
+            }
+            // Shot samples stream at ~5 Hz for the whole shot; logging each one
+            // would cost more than decoding it
+            if (letter != 'M') {
+                emit logMessage(QStringLiteral("[USB] RX [%1] %2 bytes").arg(QChar(letter)).arg(payload.size()));
+            }
+            emit dataReceived(uuid, payload, arrivalMs);
+        },
+        [this](const char* line, int length) {
+            emit logMessage(QStringLiteral("[USB] RX unknown: %1")
+                                .arg(QString::fromLatin1(line, length)));
+        });
+
+    // Safety: garbage without newlines mustn't grow a line without bound
+    if (dropped > 0) {
+        qWarning() << "[USB] Buffer overflow, discarding" << dropped << "bytes";
     }
 }
 
-void SerialTransport::processLine(const QString& line)
-{
-    // Response format: [LETTER]hexdata
-    // Minimum valid line: [X] (3 chars, possibly with empty hex data)
-    if (line.length() < 3 || line[0] != QLatin1Char('[') || line[2] != QLatin1Char(']')) {
-        emit logMessage(QStringLiteral("[USB] RX unknown: %1").arg(line));
-        return;
-    }
-
-    char letter = line[1].toLatin1();
-    QBluetoothUuid uuid = letterToUuid(letter);
-    if (uuid.isNull()) {
-        emit logMessage(QStringLiteral("[USB] RX unknown letter: %1").arg(QChar(letter)));
-        return;
-    }
-
-    QString hexData = line.mid(3);  // Everything after [X]
-    QByteArray data = hexStringToBytes(hexData);
-
-    emit logMessage(QStringLiteral("[USB] RX [%1] %2 bytes").arg(QChar(letter)).arg(data.size()));
-    emit dataReceived(uuid, data);
-}
-
 char SerialTransport::uuidToLetter(const QBluetoothUuid& uuid)
 {
-    // DE1 UUIDs are 0000XXXX-0000-1000-8000-00805F9B34FB
-    // Extract the 16-bit short UUID (XXXX) from the string representation.
-    QString uuidStr = uuid.toString();
-
-    // Handle both "{0000xxxx-...}" and "0000xxxx-..." formats
-    int hexStart = uuidStr.startsWith(QLatin1Char('{')) ? 5 : 4;
-
-    bool ok;
-    uint16_t shortUuid = uuidStr.mid(hexStart, 4).toUInt(&ok, 16);
+    // DE1 UUIDs are 0000XXXX-0000-1000-8000-00805F9B34FB, i.e. 16-bit UUIDs
+    // on the Bluetooth base
+    bool ok = false;
+    const quint16 shortUuid = uuid.toUInt16(&ok);
     if (!ok || shortUuid < 0xA001 || shortUuid > 0xA012) {
         return '\0';
     }
@@ -370,19 +351,18 @@ char SerialTransport::uuidToLetter(const QBluetoothUuid& uuid)
 
 QBluetoothUuid SerialTransport::letterToUuid(char letter)
 {
+    // Built once: this runs for every received line
+    static const std::array<QBluetoothUuid, 18> uuids = [] {
+        std::array<QBluetoothUuid, 18> table;
+        for (quint16 i = 0; i < table.size(); ++i)
+            table[i] = QBluetoothUuid(static_cast<quint16>(0xA001 + i));
+        return table;
+    }();
+
     if (letter < 'A' || letter > 'R') {
         return QBluetoothUuid();
     }
-
-    uint16_t shortUuid = 0xA001 + static_cast<uint16_t>(letter - 'A');
-    return QBluetoothUuid(
-        QStringLiteral("0000%1-0000-1000-8000-00805F9B34FB")
-            .arg(shortUuid, 4, 16, QLatin1Char('0')));
-}
-
-QByteArray SerialTransport::hexStringToBytes(const QString& hex)
-{
-    return QByteArray::fromHex(hex.toLatin1());
+    return uuids[static_cast<size_t>(letter - 'A')];
 }
 
 QString SerialTransport::bytesToHexString(const QByteArray& data)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ble/de1transport.h"
+#include "usb/seriallinedecoder.h"
 
 #include <QSet>
 #include <QTimer>
@@ -74,20 +75,20 @@ private slots:
 #endif
 
 private:
-    void processLine(const QString& line);
-    void processBuffer();  ///< Extract and process complete lines from m_buffer
+    /// Decode and dispatch the complete lines in newly read bytes; arrivalMs
+    /// is when they were read
+    void processData(const char* data, qsizetype size, qint64 arrivalMs);
 
     /** Write raw bytes to the serial connection (platform-specific). */
     void writeRaw(const QByteArray& data);
 
     static char uuidToLetter(const QBluetoothUuid& uuid);
     static QBluetoothUuid letterToUuid(char letter);
-    static QByteArray hexStringToBytes(const QString& hex);
     static QString bytesToHexString(const QByteArray& data);
 
     QString m_portName;
     QString m_serialNumber;
-    QByteArray m_buffer;
+    SerialLineDecoder m_decoder;
     bool m_connected = false;
     QSet<char> m_subscribed;
 
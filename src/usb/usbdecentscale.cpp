@@ -106,7 +106,7 @@ void UsbDecentScale::open(const QString& portName)
         return;
     }
 
-    m_buffer.clear();
+    m_parser.reset();
     m_readTimer.start(20);  // 50Hz polling
 #else
     if (portName.isEmpty()) {
@@ -123,7 +123,7 @@ void UsbDecentScale::open(const QString& portName)
 
     m_port->setDataTerminalReady(false);
     m_port->setRequestToSend(false);
-    m_buffer.clear();
+    m_parser.reset();
 #endif
 
     setConnected(true);
@@ -152,7 +152,7 @@ void UsbDecentScale::close()
     }
 #endif
 
-    m_buffer.clear();
+    m_parser.reset();
 
     if (isConnected()) {
         setConnected(false);
@@ -178,16 +178,14 @@ void UsbDecentScale::onReadTimer()
     QByteArray data = AndroidUsbScaleHelper::readAvailable();
     if (data.isEmpty()) return;
 
-    m_buffer.append(data);
-    processBuffer();
+    processData(data);
 }
 
 #else // Desktop
 
 void UsbDecentScale::onReadyRead()
 {
-    m_buffer.append(m_port->readAll());
-    processBuffer();
+    processData(m_port->readAll());
 }
 
 void UsbDecentScale::onErrorOccurred(QSerialPort::SerialPortError error)
@@ -219,59 +217,18 @@ void UsbDecentScale::onHeartbeatTimer()
 // Private helpers — protocol handling
 // ===========================================================================
 
-void UsbDecentScale::processBuffer()
+void UsbDecentScale::processData(const QByteArray& data)
 {
-    // The scale sends 7-byte binary packets starting with 0x03.
-    // Scan for valid packets, skipping any garbage bytes.
-    while (m_buffer.size() >= 7) {
-        // Find the next 0x03 marker byte
-        qsizetype startIdx = m_buffer.indexOf(static_cast<char>(0x03));
-        if (startIdx == -1) {
-            // No marker found — discard entire buffer
-            m_buffer.clear();
-            return;
-        }
-
-        // Discard bytes before the marker
-        if (startIdx > 0) {
-            m_buffer.remove(0, startIdx);
-        }
-
-        // Need at least 7 bytes for a complete packet
-        if (m_buffer.size() < 7) {
-            return;
-        }
-
-        QByteArray packet = m_buffer.left(7);
-
-        // Validate XOR checksum — skip for LED response (0x0A) which uses
-        // all 7 bytes for data (byte 6 is firmware version, not checksum)
-        uint8_t command = static_cast<uint8_t>(packet[1]);
-        if (command != 0x0A) {
-            uint8_t expected = DecentScaleProtocol::calculateXor(packet);
-            uint8_t actual = static_cast<uint8_t>(packet[6]);
-            if (expected != actual) {
-                // Bad checksum — skip this byte and try again
-                m_buffer.remove(0, 1);
-                continue;
-            }
-        }
-
-        // Valid packet — consume and process
-        m_buffer.remove(0, 7);
+    // The scale sends 7-byte binary packets starting with 0x03. The parser
+    // skips garbage bytes, and a bad XOR checksum (except on the LED response,
+    // 0x0A, where byte 6 is firmware version) skips the 0x03 and rescans.
+    m_parser.feed(data, [this](const FrameView& packet) {
         processPacket(packet);
-    }
-
-    // Safety: prevent unbounded buffer growth
-    if (m_buffer.size() > 1024) {
-        qWarning() << "[USB Scale] Buffer overflow, discarding" << m_buffer.size() << "bytes";
-        m_buffer.clear();
-    }
+    });
 }
 
-void UsbDecentScale::processPacket(const QByteArray& packet)
+void UsbDecentScale::processPacket(const FrameView& d)
 {
-    const uint8_t* d = reinterpret_cast<const uint8_t*>(packet.constData());
     uint8_t command = d[1];
 
     if (command == 0xCE || command == 0xCA) {
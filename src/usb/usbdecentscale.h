@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ble/scaledevice.h"
+#include "ble/protocol/decentscaleprotocol.h"
+#include "ble/protocol/framedstreamparser.h"
 
 #include <QTimer>
 
@@ -67,12 +69,12 @@ private slots:
     void onHeartbeatTimer();
 
 private:
-    void processBuffer();
-    void processPacket(const QByteArray& packet);
+    void processData(const QByteArray& data);
+    void processPacket(const FrameView& packet);
     void sendCommand(const QByteArray& commandData);
     void writeRaw(const QByteArray& data);
 
-    QByteArray m_buffer;
+    FramedStreamParser<DecentScaleProtocol::Frame> m_parser;
     QTimer m_heartbeatTimer;
 
 #ifdef Q_OS_ANDROID
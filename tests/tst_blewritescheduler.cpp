@@ -0,0 +1,330 @@
+#include <QtTest>
+
+#include "ble/blewritescheduler.h"
+
+// Tests for BleWriteScheduler, the ack-driven BLE write queue: in-flight window,
+// error replay, read ordering, priority lanes and keyed coalescing.
+
+namespace {
+
+const QBluetoothUuid kCharA(QStringLiteral("0000a00d-0000-1000-8000-00805f9b34fb"));
+const QBluetoothUuid kCharB(QStringLiteral("0000a00f-0000-1000-8000-00805f9b34fb"));
+const QBluetoothUuid kCharC(QStringLiteral("0000a011-0000-1000-8000-00805f9b34fb"));
+
+struct Wire {
+    // What the scheduler handed to the stack, in order. Reads have empty data.
+    QList<QPair<QBluetoothUuid, QByteArray>> writes;
+    QList<QBluetoothUuid> reads;
+};
+
+QByteArray bytes(char c) { return QByteArray(4, c); }
+
+} // namespace
+
+class tst_BleWriteScheduler : public QObject {
+    Q_OBJECT
+
+private:
+    static std::unique_ptr<BleWriteScheduler> makeScheduler(Wire& wire)
+    {
+        return std::make_unique<BleWriteScheduler>(
+            [&wire](const QBluetoothUuid& uuid, const QByteArray& data) {
+                wire.writes.append({uuid, data});
+                return true;
+            },
+            [&wire](const QBluetoothUuid& uuid) {
+                wire.reads.append(uuid);
+                return true;
+            });
+    }
+
+private slots:
+    void nextWrite_goesOutOnAck()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        scheduler->enqueueWrite(kCharA, bytes('1'));
+        scheduler->enqueueWrite(kCharA, bytes('2'));
+        scheduler->enqueueWrite(kCharB, bytes('3'));
+
+        QTRY_COMPARE(wire.writes.size(), 1);
+        QCOMPARE(scheduler->inFlightCount(), qsizetype(1));
+        QCOMPARE(scheduler->queuedCount(), qsizetype(2));
+
+        // The ack dispatches synchronously; no timer spacing
+        scheduler->acknowledge(kCharA, bytes('1'));
+        QCOMPARE(wire.writes.size(), 2);
+        QCOMPARE(wire.writes[1].second, bytes('2'));
+    }
+
+    void window_growsWithCleanAcks()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        QSignalSpy acked(scheduler.get(), &BleWriteScheduler::writeAcknowledged);
+        QSignalSpy drained(scheduler.get(), &BleWriteScheduler::drained);
+        for (char c = 'a'; c < 'a' + 20; ++c)
+            scheduler->enqueueWrite(kCharA, bytes(c));
+
+        QTRY_COMPARE(wire.writes.size(), 1);
+        qsizetype acks = 0;
+        while (acks < wire.writes.size()) {
+            QVERIFY(scheduler->inFlightCount() <= BleWriteScheduler::MAX_IN_FLIGHT);
+            scheduler->acknowledge(kCharA, wire.writes[acks].second);
+            ++acks;
+        }
+
+        QCOMPARE(acks, qsizetype(20));
+        QCOMPARE(acked.size(), 20);
+        QCOMPARE(drained.size(), 1);
+        QCOMPARE(scheduler->window(), BleWriteScheduler::MAX_IN_FLIGHT);
+        QVERIFY(scheduler->isIdle());
+
+        const BleWriteScheduler::Stats stats = scheduler->stats();
+        QCOMPARE(stats.writes, quint64(20));
+        QCOMPARE(stats.peakQueued, qsizetype(20));
+        QCOMPARE(stats.retries, quint64(0));
+    }
+
+    void error_backsOffAndResendsSameCharacteristicInOrder()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        QSignalSpy acked(scheduler.get(), &BleWriteScheduler::writeAcknowledged);
+        QSignalSpy retrying(scheduler.get(), &BleWriteScheduler::writeRetrying);
+
+        // Open the window to 2 with one clean ack
+        scheduler->enqueueWrite(kCharB, bytes('0'));
+        QTRY_COMPARE(wire.writes.size(), 1);
+        scheduler->acknowledge(kCharB, bytes('0'));
+        QCOMPARE(scheduler->window(), 2);
+
+        scheduler->enqueueWrite(kCharA, bytes('1'));
+        scheduler->enqueueWrite(kCharA, bytes('2'));
+        scheduler->enqueueWrite(kCharB, bytes('3'));
+        QTRY_COMPARE(wire.writes.size(), 3);
+
+        // '1' fails; '2' (same characteristic) lands anyway
+        scheduler->writeFailed();
+        QCOMPARE(retrying.size(), 1);
+        QCOMPARE(scheduler->window(), 1);
+        scheduler->acknowledge(kCharA, bytes('2'));  // Stale: '2' was pulled back
+        QCOMPARE(acked.size(), 1);
+        QCOMPARE(scheduler->stats().lateAcks, quint64(1));
+
+        // After the back-off '1' goes out alone; its ack reopens the window
+        // for '2' (again) and then '3'
+        QTRY_COMPARE(wire.writes.size(), 4);
+        QCOMPARE(wire.writes[3].second, bytes('1'));
+        scheduler->acknowledge(kCharA, bytes('1'));
+        QCOMPARE(wire.writes.size(), 6);
+        QCOMPARE(wire.writes[4].second, bytes('2'));
+        QCOMPARE(wire.writes[5].second, bytes('3'));
+        scheduler->acknowledge(kCharA, bytes('2'));
+        scheduler->acknowledge(kCharB, bytes('3'));
+
+        // One writeAcknowledged per queued write, no duplicates
+        QCOMPARE(acked.size(), 4);
+        QVERIFY(scheduler->isIdle());
+        QCOMPARE(scheduler->stats().errors, quint64(1));
+        QCOMPARE(scheduler->stats().retries, quint64(1));
+    }
+
+    void error_pullsBackLaterWritesToOtherCharacteristics()
+    {
+        // uploadProfileAndStartEspresso: FRAME_WRITE n, n+1, then REQUESTED_STATE
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        QSignalSpy acked(scheduler.get(), &BleWriteScheduler::writeAcknowledged);
+
+        // Open the window to 3 with three clean acks
+        scheduler->enqueueWrite(kCharB, bytes('0'));
+        QTRY_COMPARE(wire.writes.size(), 1);
+        scheduler->acknowledge(kCharB, bytes('0'));
+        scheduler->enqueueWrite(kCharB, bytes('x'));
+        scheduler->enqueueWrite(kCharB, bytes('y'));
+        QTRY_COMPARE(wire.writes.size(), 3);
+        scheduler->acknowledge(kCharB, bytes('x'));
+        scheduler->acknowledge(kCharB, bytes('y'));
+        QCOMPARE(scheduler->window(), 3);
+
+        scheduler->enqueueWrite(kCharA, bytes('1'));
+        scheduler->enqueueWrite(kCharA, bytes('2'));
+        scheduler->enqueueWrite(kCharC, bytes('S'));
+        QTRY_COMPARE(wire.writes.size(), 6);
+        QCOMPARE(scheduler->inFlightCount(), qsizetype(3));
+
+        // '1' fails; 'S' on another characteristic lands anyway
+        scheduler->writeFailed();
+        QCOMPARE(scheduler->inFlightCount(), qsizetype(0));
+        QCOMPARE(scheduler->queuedCount(), qsizetype(3));
+        scheduler->acknowledge(kCharC, bytes('S'));  // Stale: 'S' was pulled back
+        QCOMPARE(scheduler->stats().lateAcks, quint64(1));
+
+        // '1' goes out alone, then '2' and 'S' in their original order
+        QTRY_COMPARE(wire.writes.size(), 7);
+        QCOMPARE(wire.writes[6].first, kCharA);
+        QCOMPARE(wire.writes[6].second, bytes('1'));
+        scheduler->acknowledge(kCharA, bytes('1'));
+        QCOMPARE(wire.writes.size(), 9);
+        QCOMPARE(wire.writes[7].second, bytes('2'));
+        QCOMPARE(wire.writes[8].first, kCharC);
+        QCOMPARE(wire.writes[8].second, bytes('S'));
+        scheduler->acknowledge(kCharA, bytes('2'));
+        scheduler->acknowledge(kCharC, bytes('S'));
+
+        QCOMPARE(acked.size(), 6);
+        QVERIFY(scheduler->isIdle());
+        QCOMPARE(scheduler->stats().retries, quint64(1));
+    }
+
+    void read_waitsForEarlierWrites()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        scheduler->enqueueWrite(kCharA, bytes('1'));
+        scheduler->enqueueRead(kCharA);
+        scheduler->enqueueWrite(kCharB, bytes('2'));
+
+        QTRY_COMPARE(wire.writes.size(), 1);
+        QVERIFY(wire.reads.isEmpty());
+
+        scheduler->acknowledge(kCharA, bytes('1'));
+        QCOMPARE(wire.reads.size(), 1);
+        QCOMPARE(wire.writes.size(), 2);
+    }
+
+    void urgent_skipsQueueUntilWindowIsFull()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        scheduler->enqueueWrite(kCharA, bytes('1'));
+        scheduler->enqueueWrite(kCharA, bytes('2'));
+        QTRY_COMPARE(wire.writes.size(), 1);
+
+        // Window is 1 and full, but the hard cap isn't
+        scheduler->writeUrgent(kCharB, bytes('!'));
+        QCOMPARE(wire.writes.size(), 2);
+        QCOMPARE(wire.writes[1].second, bytes('!'));
+
+        for (qsizetype i = scheduler->inFlightCount(); i < BleWriteScheduler::MAX_IN_FLIGHT; ++i)
+            scheduler->writeUrgent(kCharB, bytes('u'));
+        const qsizetype sent = wire.writes.size();
+        scheduler->writeUrgent(kCharB, bytes('x'));
+        QCOMPARE(wire.writes.size(), sent);
+        QCOMPARE(scheduler->queuedCount(), qsizetype(2));  // 'x' ahead of '2'
+
+        scheduler->acknowledge(kCharA, bytes('1'));
+        scheduler->acknowledge(kCharB, bytes('!'));
+        scheduler->acknowledge(kCharB, bytes('u'));
+        scheduler->acknowledge(kCharB, bytes('u'));
+        QCOMPARE(wire.writes.size(), sent + 2);
+        QCOMPARE(wire.writes[sent].second, bytes('x'));
+        QCOMPARE(wire.writes[sent + 1].second, bytes('2'));
+    }
+
+    void clear_countsInFlightAndIgnoresTheirAcks()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        QSignalSpy acked(scheduler.get(), &BleWriteScheduler::writeAcknowledged);
+        scheduler->enqueueWrite(kCharA, bytes('1'));
+        scheduler->enqueueWrite(kCharA, bytes('2'));
+        scheduler->enqueueRead(kCharA);
+        QTRY_COMPARE(wire.writes.size(), 1);
+
+        QCOMPARE(scheduler->clear(), qsizetype(3));
+        QVERIFY(scheduler->isIdle());
+        scheduler->acknowledge(kCharA, bytes('1'));
+        QCOMPARE(acked.size(), 0);
+        QCOMPARE(scheduler->stats().lateAcks, quint64(1));
+        QCOMPARE(scheduler->clear(), qsizetype(0));
+    }
+
+    void lanes_strictPriorityKeepsCharacteristicOrder()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        scheduler->enqueueWrite(kCharA, bytes('b'), BleWriteScheduler::Background);
+        scheduler->enqueueWrite(kCharB, bytes('1'), BleWriteScheduler::Background);
+        scheduler->enqueueWrite(kCharC, bytes('i'));
+        QCOMPARE(scheduler->queuedCount(BleWriteScheduler::Background), qsizetype(2));
+
+        // An interactive write to A pulls the queued background A up with it
+        scheduler->enqueueWrite(kCharA, bytes('2'));
+        QCOMPARE(scheduler->queuedCount(BleWriteScheduler::Interactive), qsizetype(3));
+        QCOMPARE(scheduler->queuedCount(BleWriteScheduler::Background), qsizetype(1));
+
+        QTRY_COMPARE(wire.writes.size(), 1);
+        while (scheduler->inFlightCount() > 0)
+            scheduler->acknowledge(wire.writes[wire.writes.size() - scheduler->inFlightCount()].first,
+                                   wire.writes[wire.writes.size() - scheduler->inFlightCount()].second);
+
+        QCOMPARE(wire.writes.size(), 4);
+        QCOMPARE(wire.writes[0].second, bytes('i'));
+        QCOMPARE(wire.writes[1].second, bytes('b'));
+        QCOMPARE(wire.writes[2].second, bytes('2'));
+        QCOMPARE(wire.writes[3].second, bytes('1'));
+    }
+
+    void coalesce_replacesQueuedWriteWithSameKey()
+    {
+        Wire wire;
+        auto scheduler = makeScheduler(wire);
+        const QByteArray reg1("r1"), reg2("r2");
+        scheduler->enqueueWrite(kCharA, bytes('1'), BleWriteScheduler::Interactive, reg1);
+        scheduler->enqueueWrite(kCharA, bytes('2'), BleWriteScheduler::Interactive, reg2);
+        scheduler->enqueueRead(kCharA);
+        scheduler->enqueueWrite(kCharA, bytes('3'), BleWriteScheduler::Interactive, reg1);
+        scheduler->enqueueRead(kCharA);
+        QCOMPARE(scheduler->queuedCount(), qsizetype(3));
+
+        // Once it's on the wire, a write can't be replaced
+        QTRY_COMPARE(wire.writes.size(), 1);
+        QCOMPARE(wire.writes[0].second, bytes('3'));
+        scheduler->enqueueWrite(kCharA, bytes('4'), BleWriteScheduler::Interactive, reg1);
+        // ...and an unkeyed write in between stops the search
+        scheduler->enqueueWrite(kCharA, bytes('x'));
+        scheduler->enqueueWrite(kCharA, bytes('5'), BleWriteScheduler::Interactive, reg1);
+        QCOMPARE(scheduler->queuedCount(), qsizetype(5));
+        QCOMPARE(scheduler->stats().coalesced, quint64(2));  // '3' and the second read
+
+        scheduler->acknowledge(kCharA, bytes('3'));
+        scheduler->acknowledge(kCharA, bytes('2'));
+        QCOMPARE(wire.reads.size(), 1);
+        QCOMPARE(wire.writes.size(), 4);
+        QCOMPARE(wire.writes[2].second, bytes('4'));
+        QCOMPARE(wire.writes[3].second, bytes('x'));
+        scheduler->acknowledge(kCharA, bytes('4'));
+        QCOMPARE(wire.writes.size(), 5);
+        QCOMPARE(wire.writes[4].second, bytes('5'));
+
+        QCOMPARE(scheduler->clear(), qsizetype(2));
+        QCOMPARE(scheduler->stats().dropped, quint64(2));
+    }
+
+    void skippedCommand_doesNotStall()
+    {
+        // A write the owner can't issue (no service yet) is dropped, and the
+        // rest of the queue keeps moving
+        QList<QByteArray> sent;
+        BleWriteScheduler scheduler(
+            [&sent](const QBluetoothUuid&, const QByteArray& data) {
+                if (data == bytes('1')) return false;
+                sent.append(data);
+                return true;
+            },
+            [](const QBluetoothUuid&) { return false; });
+        scheduler.enqueueWrite(kCharA, bytes('1'));
+        scheduler.enqueueRead(kCharA);
+        scheduler.enqueueWrite(kCharA, bytes('2'));
+
+        QTRY_COMPARE(sent.size(), 1);
+        QCOMPARE(sent.first(), bytes('2'));
+        QCOMPARE(scheduler.inFlightCount(), qsizetype(1));
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_BleWriteScheduler)
+
+#include "tst_blewritescheduler.moc"
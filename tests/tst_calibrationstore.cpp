@@ -0,0 +1,229 @@
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <algorithm>
+
+#include "core/calibrationstore.h"
+#include "core/settingsstore.h"
+
+// Tests for CalibrationStore, the SQLite store for SAW learning and flow
+// calibration, including the one-time QSettings import.
+
+namespace {
+
+QJsonObject sawEntry(double drip, double flow, double overshoot, const QString& scale = "Decent Scale")
+{
+    QJsonObject e;
+    e["drip"] = drip;
+    e["flow"] = flow;
+    e["overshoot"] = overshoot;
+    e["scale"] = scale;
+    e["ts"] = 1700000000;
+    return e;
+}
+
+} // namespace
+
+class tst_CalibrationStore : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    QString dbPath() const { return m_dir.filePath("calibration.db"); }
+
+private slots:
+    void init()
+    {
+        QFile::remove(dbPath());
+        QFile::remove(dbPath() + "-wal");
+        QFile::remove(dbPath() + "-shm");
+    }
+
+    void poolRoundTripsAndTrims()
+    {
+        CalibrationStore store(dbPath());
+        QVERIFY(store.isPersistent());
+
+        QJsonObject legacy;
+        legacy["lag"] = 1.2;
+        legacy["scale"] = "Bookoo";
+        store.appendSawPoolEntry(legacy, 50);
+        for (int i = 0; i < 60; ++i)
+            store.appendSawPoolEntry(sawEntry(i, 2.0, 0.5), 50);
+
+        const QJsonArray pool = store.sawPool();
+        QCOMPARE(pool.size(), 50);
+        QCOMPARE(pool.first().toObject()["drip"].toDouble(), 10.0);  // Oldest kept
+        QCOMPARE(pool.last().toObject()["drip"].toDouble(), 59.0);
+        QCOMPARE(pool.last().toObject().value("ts").toInteger(), qint64(1700000000));
+        QVERIFY(!pool.last().toObject().contains("profile"));
+
+        // Auto-reset drops only that scale
+        CalibrationStore store2(m_dir.filePath("other.db"));
+        store2.appendSawPoolEntry(legacy, 50);
+        store2.appendSawPoolEntry(sawEntry(1.0, 2.0, -7.0), 50);
+        store2.appendSawPoolEntry(sawEntry(2.0, 2.0, -7.0), 50, "Decent Scale");
+        const QJsonArray pool2 = store2.sawPool();
+        QCOMPARE(pool2.size(), 2);
+        QCOMPARE(pool2[0].toObject()["lag"].toDouble(), 1.2);
+        QVERIFY(!pool2[0].toObject().contains("drip"));
+        QVERIFY(!pool2[0].toObject().contains("overshoot"));
+        QCOMPARE(pool2[1].toObject()["drip"].toDouble(), 2.0);
+    }
+
+    void batchCommit()
+    {
+        CalibrationStore store(dbPath());
+        for (int i = 0; i < 4; ++i)
+            store.appendSawPendingEntry("p", "Decent Scale", sawEntry(1.0, 2.0, 0.0));
+        QCOMPARE(store.sawPendingBatch("p", "Decent Scale").size(), 4);
+        QCOMPARE(store.sawPendingBatch("q", "Decent Scale").size(), 0);
+
+        for (int i = 0; i < 12; ++i) {
+            QJsonObject median = sawEntry(i, 2.0, 0.0);
+            median["profile"] = "p";
+            median["batchSize"] = 5;
+            store.commitSawBatch("p", "Decent Scale", median, false, 10, 50);
+        }
+        QCOMPARE(store.sawPendingBatch("p", "Decent Scale").size(), 0);
+        QCOMPARE(store.sawPairHistoryCount("p", "Decent Scale"), 10);
+        QCOMPARE(store.sawPool().size(), 12);
+
+        const QJsonArray history = store.sawPairHistory("p", "Decent Scale");
+        QCOMPARE(history.first().toObject()["drip"].toDouble(), 2.0);
+        QCOMPARE(history.last().toObject()["batchSize"].toInt(), 5);
+        QCOMPARE(history.last().toObject()["profile"].toString(), QString("p"));
+
+        // Auto-reset: the new median becomes the pair's only one
+        store.commitSawBatch("p", "Decent Scale", sawEntry(20.0, 2.0, -7.0), true, 10, 50);
+        QCOMPARE(store.sawPairHistoryCount("p", "Decent Scale"), 1);
+        QCOMPARE(store.sawPool().size(), 13);
+    }
+
+    void recencyReads()
+    {
+        CalibrationStore store(dbPath());
+        for (int i = 0; i < 6; ++i)
+            store.commitSawBatch("a", "Decent Scale", sawEntry(i, 2.0, 0.0), false, 10, 50);
+        store.commitSawBatch("b", "Decent Scale", sawEntry(7.0, 2.0, 0.0), false, 10, 50);
+        store.commitSawBatch("c", "Bookoo", sawEntry(8.0, 2.0, 0.0, "Bookoo"), false, 10, 50);
+
+        const auto recent = store.recentSawPairEntries("a", "Decent Scale", 3);
+        QCOMPARE(recent.size(), 3);
+        QCOMPARE(recent[0].first, 5.0);
+        QCOMPARE(recent[2].first, 3.0);
+
+        QList<double> latest;
+        for (const QJsonObject& m : store.latestSawPairMedians("Decent Scale"))
+            latest.append(m["drip"].toDouble());
+        std::sort(latest.begin(), latest.end());
+        QCOMPARE(latest, QList<double>({5.0, 7.0}));
+
+        const QJsonObject all = store.allSawPairHistory();
+        QCOMPARE(all.size(), 3);
+        QCOMPARE(all["a::Decent Scale"].toArray().size(), 6);
+
+        store.clearSawPair("a", "Decent Scale");
+        QCOMPARE(store.sawPairHistoryCount("a", "Decent Scale"), 0);
+        QCOMPARE(store.sawPairHistoryCount("b", "Decent Scale"), 1);
+    }
+
+    void flowCalibration()
+    {
+        CalibrationStore store(dbPath());
+        store.setFlowCalibration("p", 1.1);
+        store.setFlowCalibration("p", 1.2);
+        store.setFlowCalibration("q", 0.9);
+        QCOMPARE(store.flowCalibrations().size(), 2);
+        QCOMPARE(store.flowCalibrations()["p"].toDouble(), 1.2);
+        store.removeFlowCalibration("q");
+        QVERIFY(!store.flowCalibrations().contains("q"));
+
+        store.appendFlowCalPendingIdeal("p", 1.0);
+        store.appendFlowCalPendingIdeal("p", 1.05);
+        QCOMPARE(store.flowCalPendingIdeals("p"), QVector<double>({1.0, 1.05}));
+        store.clearFlowCalPendingIdeals("p");
+        QVERIFY(store.flowCalPendingIdeals("p").isEmpty());
+    }
+
+    void importsLegacySettings()
+    {
+        SettingsStore legacy(m_dir.filePath("legacy.ini"), QSettings::IniFormat);
+        QJsonArray pool;
+        pool.append(sawEntry(1.0, 2.0, 0.0));
+        pool.append(sawEntry(2.0, 2.0, 0.0));
+        legacy.setValue("saw/learningHistory", QJsonDocument(pool).toJson());
+
+        QJsonObject median = sawEntry(3.0, 2.0, 0.0);
+        median["profile"] = "p";
+        median["batchSize"] = 5;
+        QJsonObject history;
+        history["p::Decent Scale"] = QJsonArray({median, median});
+        legacy.setValue("saw/perProfileHistory", QJsonDocument(history).toJson(QJsonDocument::Compact));
+
+        QJsonObject batch;
+        batch["p::Decent Scale"] = QJsonArray({sawEntry(4.0, 2.0, 0.0)});
+        legacy.setValue("saw/perProfileBatch", QJsonDocument(batch).toJson(QJsonDocument::Compact));
+
+        legacy.setValue("calibration/perProfileFlow", QByteArray(R"({"p": 1.15})"));
+        legacy.setValue("calibration/flowCalBatch", QByteArray(R"({"p": [1.1, 1.2]})"));
+        legacy.setValue("saw/globalBootstrapLag/Decent Scale", 0.6);
+
+        {
+            CalibrationStore store(dbPath());
+            store.importLegacySettings(legacy);
+
+            QCOMPARE(store.sawPool().size(), 2);
+            QCOMPARE(store.sawPool()[1].toObject()["drip"].toDouble(), 2.0);
+            QCOMPARE(store.sawPairHistoryCount("p", "Decent Scale"), 2);
+            QCOMPARE(store.sawPendingBatch("p", "Decent Scale").size(), 1);
+            QCOMPARE(store.flowCalibrations()["p"].toDouble(), 1.15);
+            QCOMPARE(store.flowCalPendingIdeals("p"), QVector<double>({1.1, 1.2}));
+        }
+
+        QVERIFY(!legacy.contains("saw/learningHistory"));
+        QVERIFY(!legacy.contains("saw/perProfileHistory"));
+        QVERIFY(!legacy.contains("saw/perProfileBatch"));
+        QVERIFY(!legacy.contains("calibration/perProfileFlow"));
+        QVERIFY(!legacy.contains("calibration/flowCalBatch"));
+        QVERIFY(legacy.contains("saw/globalBootstrapLag/Decent Scale"));  // Not part of the move
+
+        legacy.sync();
+        QSettings onDisk(m_dir.filePath("legacy.ini"), QSettings::IniFormat);
+        QVERIFY(!onDisk.contains("saw/perProfileHistory"));
+        QVERIFY(onDisk.contains("saw/globalBootstrapLag/Decent Scale"));
+
+        // Persisted, and a second import is a no-op
+        CalibrationStore reopened(dbPath());
+        reopened.importLegacySettings(legacy);
+        QCOMPARE(reopened.sawPool().size(), 2);
+        QCOMPARE(reopened.sawPairHistoryCount("p", "Decent Scale"), 2);
+        QCOMPARE(reopened.flowCalibrations()["p"].toDouble(), 1.15);
+    }
+
+    void clearAll()
+    {
+        CalibrationStore store(dbPath());
+        store.appendSawPoolEntry(sawEntry(1.0, 2.0, 0.0), 50);
+        store.appendSawPendingEntry("p", "Decent Scale", sawEntry(1.0, 2.0, 0.0));
+        store.setFlowCalibration("p", 1.1);
+        store.appendFlowCalPendingIdeal("p", 1.0);
+
+        store.clearSaw();
+        QVERIFY(store.sawPool().isEmpty());
+        QVERIFY(store.sawPendingBatch("p", "Decent Scale").isEmpty());
+        QCOMPARE(store.flowCalibrations().size(), 1);
+
+        store.clearAll();
+        QVERIFY(store.flowCalibrations().isEmpty());
+        QVERIFY(store.flowCalPendingIdeals("p").isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_CalibrationStore)
+
+#include "tst_calibrationstore.moc"
@@ -0,0 +1,130 @@
+#include <QtTest>
+
+#include "ai/curveindex.h"
+
+// Tests for CurveIndex lookups and window statistics, checked against linear scans.
+
+namespace {
+
+// Irregular spacing with a duplicate timestamp at t = 1.0
+QVector<QPointF> sampleCurve()
+{
+    return {
+        {0.0, 2.0}, {0.5, 4.0}, {1.0, 9.0}, {1.0, 1.0}, {1.75, 6.0},
+        {2.0, 3.0}, {3.0, 8.0}, {3.5, 5.0}, {4.0, 7.0}, {6.0, 0.5},
+    };
+}
+
+struct Scan {
+    qsizetype count = 0;
+    double mean = 0, stddev = 0, min = 0, max = 0;
+};
+
+Scan linearScan(const QVector<QPointF>& points, double t0, double t1)
+{
+    Scan s;
+    double sum = 0, sumSq = 0;
+    for (const auto& p : points) {
+        if (p.x() < t0 || p.x() > t1) continue;
+        if (s.count == 0) s.min = s.max = p.y();
+        s.min = std::min(s.min, p.y());
+        s.max = std::max(s.max, p.y());
+        sum += p.y();
+        sumSq += p.y() * p.y();
+        ++s.count;
+    }
+    if (s.count > 0) {
+        s.mean = sum / s.count;
+        s.stddev = std::sqrt(std::max(0.0, sumSq / s.count - s.mean * s.mean));
+    }
+    return s;
+}
+
+} // namespace
+
+class tst_CurveIndex : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stats_matchLinearScan_data()
+    {
+        QTest::addColumn<double>("t0");
+        QTest::addColumn<double>("t1");
+
+        QTest::newRow("whole curve") << -1.0 << 10.0;
+        QTest::newRow("single point") << 3.0 << 3.0;
+        QTest::newRow("duplicate timestamp") << 1.0 << 1.0;
+        QTest::newRow("inner window") << 0.5 << 3.5;
+        QTest::newRow("between samples") << 4.5 << 5.5;
+        QTest::newRow("before start") << -3.0 << -1.0;
+        QTest::newRow("past end") << 7.0 << 9.0;
+        QTest::newRow("inverted") << 3.0 << 1.0;
+    }
+
+    void stats_matchLinearScan()
+    {
+        QFETCH(double, t0);
+        QFETCH(double, t1);
+
+        const QVector<QPointF> curve = sampleCurve();
+        const CurveIndex index(curve);
+        const CurveIndex::Stats stats = index.stats(t0, t1);
+        const Scan expected = linearScan(curve, t0, t1);
+
+        QCOMPARE(stats.count, expected.count);
+        QCOMPARE(stats.mean, expected.mean);
+        QCOMPARE(stats.min, expected.min);
+        QCOMPARE(stats.max, expected.max);
+        QVERIFY(std::abs(stats.stddev - expected.stddev) < 1e-9);
+        QCOMPARE(index.mean(t0, t1), expected.mean);
+        QCOMPARE(index.min(t0, t1), expected.min);
+        QCOMPARE(index.max(t0, t1), expected.max);
+    }
+
+    void emptyCurve_isSafe()
+    {
+        const CurveIndex index{QVector<QPointF>()};
+        QVERIFY(index.isEmpty());
+        QCOMPARE(index.stats(0, 10).count, qsizetype(0));
+        QCOMPARE(index.mean(0, 10), 0.0);
+        QCOMPARE(CurveIndex::nearest({}, 1.0), qsizetype(-1));
+        QCOMPARE(CurveIndex::valueAtOrAfter({}, 1.0), 0.0);
+        QCOMPARE(CurveIndex::firstAtOrAfter({}, 1.0), qsizetype(0));
+        QCOMPARE(CurveIndex::lastAtOrBefore({}, 1.0), qsizetype(-1));
+    }
+
+    void nearest_prefersEarliestOnTies()
+    {
+        const QVector<QPointF> curve = sampleCurve();
+        QCOMPARE(CurveIndex::nearest(curve, -5.0), qsizetype(0));
+        QCOMPARE(CurveIndex::nearest(curve, 0.25), qsizetype(0));   // Midway: earlier wins
+        QCOMPARE(CurveIndex::nearest(curve, 0.3), qsizetype(1));
+        QCOMPARE(CurveIndex::nearest(curve, 1.1), qsizetype(2));    // First of the t = 1.0 pair
+        QCOMPARE(CurveIndex::nearest(curve, 1.0), qsizetype(2));
+        QCOMPARE(CurveIndex::nearest(curve, 5.5), qsizetype(9));
+        QCOMPARE(CurveIndex::nearest(curve, 99.0), qsizetype(9));
+    }
+
+    void valueAtOrAfter_matchesFirstAtOrAfterScan()
+    {
+        const QVector<QPointF> curve = sampleCurve();
+        QCOMPARE(CurveIndex::valueAtOrAfter(curve, -1.0), 2.0);
+        QCOMPARE(CurveIndex::valueAtOrAfter(curve, 0.75), 9.0);
+        QCOMPARE(CurveIndex::valueAtOrAfter(curve, 1.0), 9.0);
+        QCOMPARE(CurveIndex::valueAtOrAfter(curve, 3.2), 5.0);
+        QCOMPARE(CurveIndex::valueAtOrAfter(curve, 50.0), 0.5);  // Past the end: last value
+    }
+
+    void boundaries()
+    {
+        const QVector<QPointF> curve = sampleCurve();
+        QCOMPARE(CurveIndex::firstAtOrAfter(curve, 1.0), qsizetype(2));
+        QCOMPARE(CurveIndex::lastAtOrBefore(curve, 1.0), qsizetype(3));
+        QCOMPARE(CurveIndex::firstAtOrAfter(curve, 7.0), curve.size());
+        QCOMPARE(CurveIndex::lastAtOrBefore(curve, -1.0), qsizetype(-1));
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_CurveIndex)
+
+#include "tst_curveindex.moc"
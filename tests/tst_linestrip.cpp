@@ -0,0 +1,387 @@
+#include <QtTest>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+
+#include <algorithm>
+
+#include "rendering/fastsegmentseries.h"
+#include "rendering/linestrip.h"
+
+// Tests for LineStrip and FastSegmentSeries, the scene-graph geometry behind the
+// live shot graph: chunking, LOD decimation, rebake vs. matrix and dash patterns.
+
+namespace {
+
+using Vertex = QSGGeometry::ColoredPoint2D;
+constexpr int CHUNK = LineStrip::CHUNK_POINTS;
+
+QSGGeometry* chunkGeometry(QSGTransformNode& tnode, int k)
+{
+    return static_cast<QSGGeometryNode*>(tnode.childAtIndex(k))->geometry();
+}
+
+bool sameVertex(const Vertex& a, const Vertex& b)
+{
+    return a.x == b.x && a.y == b.y && a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Same child count and identical vertex data in every chunk
+bool sameGeometry(QSGTransformNode& a, QSGTransformNode& b)
+{
+    if (a.childCount() != b.childCount()) return false;
+    for (int k = 0; k < a.childCount(); ++k) {
+        QSGGeometry* ga = chunkGeometry(a, k);
+        QSGGeometry* gb = chunkGeometry(b, k);
+        if (ga->vertexCount() != gb->vertexCount()) return false;
+        for (int i = 0; i < ga->vertexCount(); ++i) {
+            if (!sameVertex(ga->vertexDataAsColoredPoint2D()[i], gb->vertexDataAsColoredPoint2D()[i]))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Centre of each vertex pair: the render point it was extruded from
+QVector<QPointF> stripCentres(QSGTransformNode& tnode, int renderCount)
+{
+    const int lastChunk = (renderCount - 2) / CHUNK;
+    QVector<QPointF> centres;
+    for (int r = 0; r < renderCount; ++r) {
+        const int k = std::min(r / CHUNK, lastChunk);
+        const Vertex* v = chunkGeometry(tnode, k)->vertexDataAsColoredPoint2D() + 2 * (r - k * CHUNK);
+        centres.append(QPointF((v[0].x + v[1].x) / 2.0, (v[0].y + v[1].y) / 2.0));
+    }
+    return centres;
+}
+
+bool closeTo(const QPointF& a, const QPointF& b)
+{
+    return std::abs(a.x() - b.x()) < 1e-3 && std::abs(a.y() - b.y()) < 1e-3;
+}
+
+} // namespace
+
+class tst_LineStrip : public QObject {
+    Q_OBJECT
+
+private:
+    // 1 data unit = 1 px across, y flipped
+    static LineStrip::Viewport unitViewport(double width)
+    {
+        return LineStrip::Viewport::fromAxes(0, width, 0, 100, width, 100);
+    }
+
+    static int renderCount(const LineStrip& strip) { return static_cast<int>(strip.m_render.size()); }
+    static bool decimated(const LineStrip& strip) { return strip.m_decimate; }
+
+    // Dash quads as (start, end) centre points, in order
+    static QVector<QPair<QPointF, QPointF>> quads(const FastSegmentSeries& series, QSGTransformNode& tnode)
+    {
+        QVector<QPair<QPointF, QPointF>> result;
+        for (int q = 0; q < series.m_quads; ++q) {
+            const Vertex* v = chunkGeometry(tnode, q / FastSegmentSeries::CHUNK_QUADS)->vertexDataAsColoredPoint2D()
+                              + (q % FastSegmentSeries::CHUNK_QUADS) * 6;
+            result.append({QPointF((v[2].x + v[3].x) / 2.0, (v[2].y + v[3].y) / 2.0),
+                           QPointF((v[4].x + v[5].x) / 2.0, (v[4].y + v[5].y) / 2.0)});
+        }
+        return result;
+    }
+
+    static void syncSeries(FastSegmentSeries& series, QSGTransformNode& tnode, const LineStrip::Viewport& viewport)
+    {
+        series.sync(&tnode, viewport);
+    }
+
+private slots:
+
+    // ===== LineStrip chunks =====
+
+    void chunksShareBoundaryPointAndEndInTerminator_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("two points") << 2;
+        QTest::newRow("one short of a full chunk") << CHUNK;
+        QTest::newRow("exactly one chunk") << CHUNK + 1;
+        QTest::newRow("one past the boundary") << CHUNK + 2;
+        QTest::newRow("two full chunks") << 2 * CHUNK + 1;
+    }
+
+    void chunksShareBoundaryPointAndEndInTerminator()
+    {
+        QFETCH(int, count);
+        LineStrip strip;
+        for (int i = 0; i < count; ++i)
+            strip.append(i, i % 50);
+        QSGTransformNode tnode;
+        strip.sync(&tnode, unitViewport(1000));
+
+        QVERIFY(!decimated(strip));
+        QCOMPARE(renderCount(strip), count);
+        const int lastChunk = (count - 2) / CHUNK;
+        QCOMPARE(tnode.childCount(), lastChunk + 1);
+
+        const QVector<QPointF> centres = stripCentres(tnode, count);
+        for (int i = 0; i < count; ++i) {
+            if (!closeTo(centres[i], QPointF(i, 100 - i % 50)))
+                QFAIL(qPrintable(QStringLiteral("point %1 drawn at %2,%3")
+                                     .arg(i).arg(centres[i].x()).arg(centres[i].y())));
+        }
+
+        for (int k = 0; k <= lastChunk; ++k) {
+            QSGGeometry* geometry = chunkGeometry(tnode, k);
+            const Vertex* v = geometry->vertexDataAsColoredPoint2D();
+            const int points = std::min(count, k * CHUNK + CHUNK + 1) - k * CHUNK;
+            QVERIFY(sameVertex(v[2 * points], v[2 * points - 1]));
+            for (int i = 2 * points + 1; i < geometry->vertexCount(); ++i)
+                QCOMPARE(v[i].a, uchar(0));
+            if (k > 0) {
+                const Vertex* previous = chunkGeometry(tnode, k - 1)->vertexDataAsColoredPoint2D();
+                QVERIFY(sameVertex(previous[2 * CHUNK], v[0]));
+                QVERIFY(sameVertex(previous[2 * CHUNK + 1], v[1]));
+            }
+        }
+    }
+
+    void incrementalAppendsMatchFullBuild_data()
+    {
+        QTest::addColumn<int>("batch");
+        QTest::newRow("sync every point") << 1;
+        QTest::newRow("sync every 5") << 5;
+        QTest::newRow("sync across a chunk") << 300;
+    }
+
+    void incrementalAppendsMatchFullBuild()
+    {
+        QFETCH(int, batch);
+        const auto viewport = unitViewport(1000);
+        const int count = 2 * CHUNK + 10;
+
+        QVector<QPointF> points;
+        LineStrip live;
+        QSGTransformNode liveNode;
+        for (int i = 0; i < count; ++i) {
+            points.append(QPointF(i, (i * 37) % 100));
+            live.append(points.last().x(), points.last().y());
+            if ((i + 1) % batch == 0)
+                live.sync(&liveNode, viewport);
+        }
+        live.sync(&liveNode, viewport);
+
+        LineStrip full;
+        full.setPoints(points);
+        QSGTransformNode fullNode;
+        full.sync(&fullNode, viewport);
+
+        QVERIFY(sameGeometry(liveNode, fullNode));
+    }
+
+    // ===== LineStrip decimation =====
+
+    void decimationStartsAboveTwoPointsPerPixel()
+    {
+        // Three points per pixel column over 100 px
+        const auto viewport = unitViewport(100);
+        LineStrip strip;
+        for (int i = 0; i < 200; ++i)
+            strip.append(i / 3.0, i % 7);
+        QSGTransformNode tnode;
+        strip.sync(&tnode, viewport);
+        QVERIFY(!decimated(strip));  // 200 points = 2 per pixel, not above
+        QCOMPARE(renderCount(strip), 200);
+
+        // One more point switches to min/max columns through a rebuild
+        strip.append(200 / 3.0, 0);
+        strip.sync(&tnode, viewport);
+        QVERIFY(decimated(strip));
+        QVERIFY(renderCount(strip) <= 2 * 68);
+    }
+
+    void decimationKeepsColumnExtremesInTimeOrder()
+    {
+        // Ten points per column; column 10 is flat, column 20 falls, column
+        // 30 rises, the rest zig-zag
+        QVector<QPointF> points;
+        for (int column = 0; column < 100; ++column) {
+            for (int j = 0; j < 10; ++j) {
+                double y = (column * 10 + j) * 37 % 101 * 0.9;
+                if (column == 10) y = 50;
+                if (column == 20) y = 90 - j * 5;
+                if (column == 30) y = 10 + j * 5;
+                points.append(QPointF(column + (j + 0.5) / 10.0, y));
+            }
+        }
+
+        // Reference: per column, the first lowest and first highest point
+        QVector<QPointF> expected;
+        for (int column = 0; column < 100; ++column) {
+            int minIndex = column * 10, maxIndex = column * 10;
+            for (int i = column * 10; i < column * 10 + 10; ++i) {
+                if (points[i].y() < points[minIndex].y()) minIndex = i;
+                if (points[i].y() > points[maxIndex].y()) maxIndex = i;
+            }
+            expected.append(points[std::min(minIndex, maxIndex)]);
+            if (minIndex != maxIndex)
+                expected.append(points[std::max(minIndex, maxIndex)]);
+        }
+
+        LineStrip strip;
+        strip.setPoints(points);
+        QSGTransformNode tnode;
+        strip.sync(&tnode, unitViewport(100));
+
+        QVERIFY(decimated(strip));
+        QCOMPARE(renderCount(strip), static_cast<int>(expected.size()));
+        const QVector<QPointF> centres = stripCentres(tnode, renderCount(strip));
+        for (qsizetype r = 0; r < expected.size(); ++r) {
+            if (!closeTo(centres[r], QPointF(expected[r].x(), 100 - expected[r].y())))
+                QFAIL(qPrintable(QStringLiteral("render point %1 is %2,%3, expected %4,%5")
+                                     .arg(r).arg(centres[r].x()).arg(centres[r].y())
+                                     .arg(expected[r].x()).arg(100 - expected[r].y())));
+        }
+
+        // Filling the open column later gives the same strip as one build
+        LineStrip live;
+        QSGTransformNode liveNode;
+        live.setPoints(points.mid(0, 605));
+        live.sync(&liveNode, unitViewport(100));
+        QVERIFY(decimated(live));
+        for (qsizetype i = 605; i < points.size(); ++i) {
+            live.append(points[i].x(), points[i].y());
+            if (i % 3 == 0)
+                live.sync(&liveNode, unitViewport(100));
+        }
+        live.sync(&liveNode, unitViewport(100));
+        QVERIFY(sameGeometry(liveNode, tnode));
+    }
+
+    // ===== Axis changes =====
+
+    void bakedTransformMapsWithinTolerance()
+    {
+        const auto bake = LineStrip::Viewport::fromAxes(0, 10, 0, 10, 100, 100);
+        QMatrix4x4 matrix;
+        QVERIFY(LineStrip::bakedTransform(bake, bake, &matrix));
+        QVERIFY(matrix.isIdentity());
+
+        // Data point (5, 4) is baked at (50, 60)
+        const QPointF baked(50, 60);
+        QVERIFY(LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(0, 10.5, 0, 10, 100, 100), &matrix));
+        QVERIFY(closeTo(matrix.map(baked), QPointF(5 * 100 / 10.5, 60)));
+        QVERIFY(LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(1, 11.5, -1, 9.5, 105, 100), &matrix));
+        QVERIFY(closeTo(matrix.map(baked), QPointF(40, 100 - 5 * 100 / 10.5)));
+
+        // Width 100 -> 109 / 92 stretches by less than 1.1 either way; 112 / 90 don't
+        QVERIFY(LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(0, 10, 0, 10, 109, 100), &matrix));
+        QVERIFY(LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(0, 10, 0, 10, 92, 100), &matrix));
+        QVERIFY(!LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(0, 10, 0, 10, 112, 100), &matrix));
+        QVERIFY(!LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(0, 10, 0, 10, 90, 100), &matrix));
+        QVERIFY(!LineStrip::bakedTransform(bake, LineStrip::Viewport::fromAxes(0, 12, 0, 10, 100, 100), &matrix));
+        QVERIFY(!LineStrip::bakedTransform(bake, LineStrip::Viewport(), &matrix));
+    }
+
+    void syncRebakesOnlyBeyondTolerance()
+    {
+        LineStrip strip;
+        for (int i = 0; i <= 10; ++i)
+            strip.append(i, i % 3);
+        QSGTransformNode tnode;
+        const auto bake = LineStrip::Viewport::fromAxes(0, 10, 0, 10, 100, 100);
+        strip.sync(&tnode, bake);
+
+        LineStrip reference;
+        for (int i = 0; i <= 10; ++i)
+            reference.append(i, i % 3);
+        QSGTransformNode referenceNode;
+        reference.sync(&referenceNode, bake);
+
+        // Within tolerance: same vertices, stretched by the matrix
+        strip.sync(&tnode, LineStrip::Viewport::fromAxes(0, 10.5, 0, 10, 100, 100));
+        QVERIFY(sameGeometry(tnode, referenceNode));
+        QVERIFY(!tnode.matrix().isIdentity());
+
+        // Beyond it: regenerated for the new axes, identity matrix
+        const auto wide = LineStrip::Viewport::fromAxes(0, 20, 0, 10, 100, 100);
+        strip.sync(&tnode, wide);
+        QVERIFY(tnode.matrix().isIdentity());
+        QVERIFY(!sameGeometry(tnode, referenceNode));
+        const QVector<QPointF> centres = stripCentres(tnode, renderCount(strip));
+        QVERIFY(closeTo(centres[10], QPointF(50, 100 - 10 * (10 % 3))));
+    }
+
+    // ===== FastSegmentSeries =====
+
+    void dashesCarryPhaseAcrossAppendsAndRestartPerSegment()
+    {
+        const auto viewport = unitViewport(100);
+        FastSegmentSeries series;
+        series.setLineWidth(2);
+        series.setStyle(Qt::DashLine);  // 4 on, 2 off, in line widths: 8 px / 4 px
+
+        QSGTransformNode tnode;
+        series.appendPoint(0, 50);
+        series.appendPoint(30, 50);
+        syncSeries(series, tnode, viewport);
+        series.appendPoint(40, 50);
+        syncSeries(series, tnode, viewport);
+        series.breakSegment();
+        series.appendPoint(50, 20);
+        series.appendPoint(60, 20);
+        syncSeries(series, tnode, viewport);
+
+        const QVector<QPair<double, double>> expectedX = {
+            {0, 8}, {12, 20}, {24, 30},  // First piece ends 6 px into a dash
+            {30, 32}, {36, 40},          // The dash continues after the append
+            {50, 58},                    // New segment: pattern restarts
+        };
+        const auto drawn = quads(series, tnode);
+        QCOMPARE(drawn.size(), expectedX.size());
+        for (qsizetype q = 0; q < drawn.size(); ++q) {
+            const double y = q < 5 ? 50 : 80;
+            QVERIFY(closeTo(drawn[q].first, QPointF(expectedX[q].first, y)));
+            QVERIFY(closeTo(drawn[q].second, QPointF(expectedX[q].second, y)));
+        }
+
+        FastSegmentSeries full;
+        full.setLineWidth(2);
+        full.setStyle(Qt::DashLine);
+        full.setSegments({{QPointF(0, 50), QPointF(30, 50), QPointF(40, 50)},
+                          {QPointF(50, 20), QPointF(60, 20)}});
+        QSGTransformNode fullNode;
+        syncSeries(full, fullNode, viewport);
+        QVERIFY(sameGeometry(tnode, fullNode));
+    }
+
+    void segmentChunksJoinAndTerminate()
+    {
+        // Solid: one quad per piece, 129 quads spill into a second chunk
+        FastSegmentSeries series;
+        for (int i = 0; i < FastSegmentSeries::CHUNK_QUADS + 2; ++i)
+            series.appendPoint(i * 0.5, 50);
+        QSGTransformNode tnode;
+        syncSeries(series, tnode, unitViewport(100));
+
+        QCOMPARE(series.m_quads, FastSegmentSeries::CHUNK_QUADS + 1);
+        QCOMPARE(tnode.childCount(), 2);
+        const auto drawn = quads(series, tnode);
+        for (qsizetype q = 0; q < drawn.size(); ++q) {
+            QVERIFY(closeTo(drawn[q].first, QPointF(q * 0.5, 50)));
+            QVERIFY(closeTo(drawn[q].second, QPointF((q + 1) * 0.5, 50)));
+        }
+
+        // Within a chunk each quad joins from the previous one's last vertex;
+        // every chunk ends in a terminator repeating its last vertex
+        const Vertex* first = chunkGeometry(tnode, 0)->vertexDataAsColoredPoint2D();
+        for (int slot = 1; slot < FastSegmentSeries::CHUNK_QUADS; ++slot)
+            QVERIFY(sameVertex(first[slot * 6], first[slot * 6 - 1]));
+        QVERIFY(sameVertex(first[FastSegmentSeries::CHUNK_QUADS * 6], first[FastSegmentSeries::CHUNK_QUADS * 6 - 1]));
+
+        const Vertex* second = chunkGeometry(tnode, 1)->vertexDataAsColoredPoint2D();
+        QVERIFY(sameVertex(second[0], second[2]));  // A chunk starts on its own first corner
+        QVERIFY(sameVertex(second[6], second[5]));
+        QCOMPARE(second[7].a, uchar(0));
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_LineStrip)
+
+#include "tst_linestrip.moc"
@@ -0,0 +1,276 @@
+#include <QtTest>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTemporaryDir>
+
+#include "history/postshotpipeline.h"
+#include "history/shothistorystorage.h"
+
+// PostShotPipeline: stage bodies driven one at a time, and the order in which
+// a submitted job moves through stages, analysisReady and the save.
+
+class tst_PostShotPipeline : public QObject {
+    Q_OBJECT
+
+private:
+    using Stage = PostShotPipeline::Stage;
+
+    QTemporaryDir m_tempDir;
+
+    // 5 Hz espresso shot: preinfusion to 8 s, 9 bar pour to 30 s, then
+    // `settlingSamples` zero-pressure samples while the scale settles.
+    static PostShotPipeline::Job makeJob(int settlingSamples = 0)
+    {
+        PostShotPipeline::Job job;
+        ShotSnapshot& shot = job.snapshot;
+        QVector<QPointF> pressureGoal;
+        for (int i = 0; i <= 150 + settlingSamples; ++i) {
+            const double t = i * 0.2;
+            const bool settling = i > 150;
+            const double p = settling ? 0.0 : (t < 8.0 ? 1.0 + t : 9.0);
+            shot.pressure.append(QPointF(t, p));
+            shot.flow.append(QPointF(t, settling ? 0.0 : 2.0));
+            shot.temperature.append(QPointF(t, 93.0));
+            shot.temperatureGoal.append(QPointF(t, 93.0));
+            shot.conductance.append(QPointF(t, settling ? 0.0 : 2.0 / p));
+            shot.weightFlowRate.append(QPointF(t, settling ? 0.5 : (i % 2 ? 1.6 : 2.4)));
+            shot.cumulativeWeight.append(QPointF(t, i * 0.24));
+            if (!settling) pressureGoal.append(QPointF(t, 9.0));
+        }
+        shot.weight = shot.cumulativeWeight;
+        shot.pressureGoalSegments = {pressureGoal};
+
+        HistoryPhaseMarker start;
+        start.label = QStringLiteral("Start");
+        HistoryPhaseMarker pour;
+        pour.time = 8.0;
+        pour.label = QStringLiteral("Pour");
+        pour.frameNumber = 1;
+        shot.phases = {start, pour};
+
+        job.save.uuid = QStringLiteral("00000000-0000-0000-0000-%1")
+                            .arg(++s_jobCounter, 12, 10, QLatin1Char('0'));
+        job.save.timestamp = 1700000000 + s_jobCounter;
+        job.save.profileName = QStringLiteral("Test Profile");
+        job.save.beverageType = QStringLiteral("espresso");
+        job.save.duration = 30.0;
+        job.save.finalWeight = 36.0;
+        job.save.doseWeight = 18.0;
+        return job;
+    }
+    static inline int s_jobCounter = 0;
+
+    // Records stage changes and result signals in emission order.
+    static void recordEvents(PostShotPipeline& pipeline, ShotHistoryStorage* storage,
+                             QStringList& events)
+    {
+        connect(&pipeline, &PostShotPipeline::stageChanged, &pipeline, [&events](Stage stage) {
+            events << QString::fromLatin1(QMetaEnum::fromType<Stage>().valueToKey(int(stage)));
+        });
+        connect(&pipeline, &PostShotPipeline::analysisReady, &pipeline, [&events]() {
+            events << QStringLiteral("analysisReady");
+        });
+        connect(&pipeline, &PostShotPipeline::jobFinished, &pipeline, [&events](qint64 shotId) {
+            events << QStringLiteral("jobFinished(%1)").arg(shotId > 0 ? 1 : shotId);
+        });
+        if (storage) {
+            connect(storage, &ShotHistoryStorage::shotSaved, &pipeline, [&events](qint64 shotId) {
+                events << QStringLiteral("shotSaved(%1)").arg(shotId > 0 ? 1 : shotId);
+            });
+        }
+    }
+
+    // ShotHistoryStorage::initialize() starts a background distinct-cache
+    // query; let it deliver before the storage is destroyed.
+    static void drainBackgroundWork()
+    {
+        for (int i = 0; i < 20; ++i) {
+            QCoreApplication::processEvents();
+            QThread::msleep(25);
+        }
+    }
+
+private slots:
+
+    void initTestCase()
+    {
+        QVERIFY(m_tempDir.isValid());
+    }
+
+    // ===== runStage() =====
+
+    void trimSettlingRunsBeforeSmoothing()
+    {
+        PostShotPipeline::Job job = makeJob(/*settlingSamples=*/10);
+        PostShotPipeline::StageOutput out;
+        PostShotPipeline::runStage(Stage::TrimSettling, job, out);
+        PostShotPipeline::runStage(Stage::SmoothWeightFlow, job, out);
+
+        // Neither the smoothed series nor the raw copy keeps settling samples.
+        QCOMPARE(job.snapshot.pressure.size(), qsizetype(151));
+        QCOMPARE(job.snapshot.weightFlowRate.size(), qsizetype(151));
+        QCOMPARE(job.snapshot.weightFlowRateRaw.size(), qsizetype(151));
+        QCOMPARE(job.snapshot.weightFlowRateRaw[40].y(), 2.4);
+        QVERIFY(job.snapshot.weightFlowRate[40].y() != 2.4);
+        // Cumulative weight keeps the settled value.
+        QCOMPARE(job.snapshot.cumulativeWeight.size(), qsizetype(161));
+    }
+
+    void processSeriesFalseSkipsTrimAndSmoothing()
+    {
+        PostShotPipeline::Job job = makeJob(/*settlingSamples=*/10);
+        job.processSeries = false;
+        PostShotPipeline::StageOutput out;
+        PostShotPipeline::runStage(Stage::TrimSettling, job, out);
+        PostShotPipeline::runStage(Stage::SmoothWeightFlow, job, out);
+
+        QCOMPARE(job.snapshot.pressure.size(), qsizetype(161));
+        QVERIFY(job.snapshot.weightFlowRateRaw.isEmpty());
+    }
+
+    void analysisStageFillsBadgesAndLines()
+    {
+        PostShotPipeline::Job job = makeJob();
+        PostShotPipeline::StageOutput out;
+        for (Stage stage : {Stage::TrimSettling, Stage::SmoothWeightFlow,
+                            Stage::ConductanceDerivative, Stage::PhaseSummaries,
+                            Stage::Analysis, Stage::Compress}) {
+            PostShotPipeline::runStage(stage, job, out);
+        }
+
+        QVERIFY(!job.snapshot.conductanceDerivative.isEmpty());
+        QVERIFY(!job.save.phaseSummariesJson.isEmpty());
+        QCOMPARE(job.save.phaseMarkers.size(), qsizetype(2));
+        QVERIFY(!out.analysis.lines.isEmpty());
+        QVERIFY(!out.analysis.detectors.verdictCategory.isEmpty());
+        QVERIFY(!job.save.compressedSamples.isEmpty());
+        QCOMPARE(job.save.sampleCount, 151);
+        QCOMPARE(out.shotId, qint64(-1));  // Save not run
+    }
+
+    // ===== submit() =====
+
+    void persistedJobRunsStagesInOrder()
+    {
+        QStringList events;
+        {
+            ShotHistoryStorage storage;
+            QVERIFY(storage.initialize(m_tempDir.path() + QStringLiteral("/order.db")));
+            PostShotPipeline pipeline(&storage);
+            recordEvents(pipeline, &storage, events);
+
+            bool seriesReady = false;
+            PostShotPipeline::Job job = makeJob(/*settlingSamples=*/5);
+            job.onSeriesReady = [&](const ShotSnapshot& processed, ShotSaveData& save) {
+                seriesReady = true;
+                QCOMPARE(pipeline.currentStage(), Stage::PublishSeries);
+                QCOMPARE(processed.pressure.size(), qsizetype(151));
+                save.debugLog = QStringLiteral("attached late");
+            };
+
+            QSignalSpy finished(&pipeline, &PostShotPipeline::jobFinished);
+            pipeline.submit(std::move(job));
+            QVERIFY(pipeline.isBusy());
+            QVERIFY(finished.wait(10000));
+            QVERIFY(seriesReady);
+            QVERIFY(finished.first().at(0).toLongLong() > 0);
+            drainBackgroundWork();
+        }
+
+        // analysisReady lands right after the Analysis stage, before the
+        // blob is compressed or the row is written.
+        const QStringList expected = {
+            QStringLiteral("TrimSettling"),
+            QStringLiteral("SmoothWeightFlow"),
+            QStringLiteral("ConductanceDerivative"),
+            QStringLiteral("PublishSeries"),
+            QStringLiteral("PhaseSummaries"),
+            QStringLiteral("Analysis"),
+            QStringLiteral("analysisReady"),
+            QStringLiteral("Compress"),
+            QStringLiteral("Save"),
+            QStringLiteral("shotSaved(1)"),
+            QStringLiteral("Idle"),
+            QStringLiteral("jobFinished(1)"),
+        };
+        QCOMPARE(events, expected);
+    }
+
+    void persistFalseStopsAfterPublishSeries()
+    {
+        QStringList events;
+        PostShotPipeline pipeline(nullptr);
+        recordEvents(pipeline, nullptr, events);
+
+        bool seriesReady = false;
+        PostShotPipeline::Job job = makeJob();
+        job.persist = false;
+        job.onSeriesReady = [&](const ShotSnapshot&, ShotSaveData&) { seriesReady = true; };
+
+        QSignalSpy finished(&pipeline, &PostShotPipeline::jobFinished);
+        pipeline.submit(std::move(job));
+        QVERIFY(finished.wait(5000));
+        QVERIFY(seriesReady);
+
+        const QStringList expected = {
+            QStringLiteral("TrimSettling"),
+            QStringLiteral("SmoothWeightFlow"),
+            QStringLiteral("ConductanceDerivative"),
+            QStringLiteral("PublishSeries"),
+            QStringLiteral("Idle"),
+            QStringLiteral("jobFinished(0)"),
+        };
+        QCOMPARE(events, expected);
+    }
+
+    void notAcceptingSavesReportsFailedSave()
+    {
+        // Never initialized: acceptingSaves() is false.
+        ShotHistoryStorage storage;
+        QVERIFY(!storage.acceptingSaves());
+        QStringList events;
+        PostShotPipeline pipeline(&storage);
+        recordEvents(pipeline, &storage, events);
+
+        QSignalSpy saved(&storage, &ShotHistoryStorage::shotSaved);
+        QSignalSpy finished(&pipeline, &PostShotPipeline::jobFinished);
+        pipeline.submit(makeJob());
+        QVERIFY(finished.wait(5000));
+
+        QCOMPARE(saved.count(), 1);
+        QCOMPARE(saved.first().at(0).toLongLong(), qint64(-1));
+        QCOMPARE(finished.first().at(0).toLongLong(), qint64(-1));
+        QVERIFY(!events.contains(QStringLiteral("Analysis")));
+        QVERIFY(!events.contains(QStringLiteral("Save")));
+    }
+
+    void finishJobClearsJobAndStartsNext()
+    {
+        PostShotPipeline pipeline(nullptr);
+        QSignalSpy busy(&pipeline, &PostShotPipeline::busyChanged);
+        QSignalSpy finished(&pipeline, &PostShotPipeline::jobFinished);
+
+        PostShotPipeline::Job first = makeJob();
+        first.persist = false;
+        PostShotPipeline::Job second = makeJob();
+        second.persist = false;
+        QStringList published;
+        first.onSeriesReady = [&](const ShotSnapshot&, ShotSaveData& save) { published << save.uuid; };
+        second.onSeriesReady = first.onSeriesReady;
+        const QStringList expectedOrder = {first.save.uuid, second.save.uuid};
+
+        pipeline.submit(std::move(first));
+        pipeline.submit(std::move(second));
+        QVERIFY(pipeline.isBusy());
+
+        QTRY_COMPARE_WITH_TIMEOUT(finished.count(), 2, 5000);
+        QCOMPARE(published, expectedOrder);
+        QVERIFY(!pipeline.isBusy());
+        QCOMPARE(pipeline.currentStage(), Stage::Idle);
+        // busy on/off once per job
+        QCOMPARE(busy.count(), 4);
+    }
+};
+
+QTEST_MAIN(tst_PostShotPipeline)
+#include "tst_postshotpipeline.moc"
@@ -0,0 +1,161 @@
+#include <QtTest>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "profile/profilecatalogindex.h"
+
+// Tests for ProfileCatalogIndex, the per-file metadata cache behind
+// ProfileManager::refreshProfiles().
+
+class tst_ProfileCatalogIndex : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    QString profilePath(const QString& name) const { return m_dir.filePath(name + ".json"); }
+
+    // Writes a profile and backdates it past the racy window unless told not to
+    QString writeProfile(const QString& name, const QString& title, const QDateTime& mtime = QDateTime())
+    {
+        QJsonObject obj;
+        obj["title"] = title;
+        obj["beverage_type"] = "espresso";
+        obj["legacy_profile_type"] = "settings_2a";
+        obj["profile_type"] = "settings_2c";
+        const QString path = profilePath(name);
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return path;
+        file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+        file.flush();  // So the write doesn't land after the backdated mtime
+        file.setFileTime(mtime.isValid() ? mtime : QDateTime::currentDateTime().addSecs(-3600),
+                         QFileDevice::FileModificationTime);
+        return path;
+    }
+
+    static void setMtime(const QString& path, const QDateTime& mtime)
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(mtime, QFileDevice::FileModificationTime));
+    }
+
+private slots:
+    void parsesOnceThenAnswersFromStat()
+    {
+        const QString a = writeProfile("a", "Blooming Espresso");
+        const QString b = writeProfile("b", "Adaptive");
+
+        ProfileCatalogIndex index;
+        const auto meta = index.lookup(a);
+        QVERIFY(meta.has_value());
+        QCOMPARE(meta->title, QString("Blooming Espresso"));
+        QCOMPARE(meta->beverageType, QString("espresso"));
+        QCOMPARE(meta->profileType, QString("settings_2a"));  // legacy_profile_type wins
+        QVERIFY(!meta->readOnly);
+        QVERIFY(index.lookup(b).has_value());
+        QCOMPARE(index.takeStats().parsed, 2);
+        QVERIFY(index.isDirty());
+
+        for (int i = 0; i < 3; ++i) {
+            QCOMPARE(index.lookup(a)->title, QString("Blooming Espresso"));
+            QCOMPARE(index.lookup(b)->title, QString("Adaptive"));
+        }
+        const auto stats = index.takeStats();
+        QCOMPARE(stats.statHits, 6);
+        QCOMPARE(stats.parsed, 0);
+        QCOMPARE(stats.hashHits, 0);
+    }
+
+    void touchedFilesAreHashedNotParsed()
+    {
+        const QString path = writeProfile("touched", "Londinium");
+        ProfileCatalogIndex index;
+        index.lookup(path);
+        index.takeStats();
+
+        // Same bytes, new mtime (a resave or a copy)
+        setMtime(path, QDateTime::currentDateTime().addSecs(-1800));
+        QCOMPARE(index.lookup(path)->title, QString("Londinium"));
+        auto stats = index.takeStats();
+        QCOMPARE(stats.hashHits, 1);
+        QCOMPARE(stats.parsed, 0);
+
+        // New content
+        writeProfile("touched", "Londinium R", QDateTime::currentDateTime().addSecs(-900));
+        QCOMPARE(index.lookup(path)->title, QString("Londinium R"));
+        QCOMPARE(index.takeStats().parsed, 1);
+    }
+
+    void racyEntriesAreRehashed()
+    {
+        // Just written: indexed within the racy window of its mtime
+        const QDateTime tick = QDateTime::currentDateTime();
+        const QString path = writeProfile("racy", "Turbo A", tick);
+        ProfileCatalogIndex index;
+        QCOMPARE(index.lookup(path)->title, QString("Turbo A"));
+
+        // Same size, same mtime, different content
+        writeProfile("racy", "Turbo B", tick);
+        QCOMPARE(index.lookup(path)->title, QString("Turbo B"));
+        auto stats = index.takeStats();
+        QCOMPARE(stats.parsed, 2);
+        QCOMPARE(stats.statHits, 0);
+    }
+
+    void saveLoadAndPrune()
+    {
+        const QString indexFile = m_dir.filePath("catalog.json");
+        const QString keep = writeProfile("keep", "Keep");
+        const QString gone = writeProfile("gone", "Gone");
+        {
+            ProfileCatalogIndex index;
+            index.lookup(keep);
+            index.lookup(gone);
+            QVERIFY(index.save(indexFile));
+        }
+
+        ProfileCatalogIndex loaded = ProfileCatalogIndex::load(indexFile);
+        QCOMPARE(loaded.size(), 2);
+        QVERIFY(!loaded.isDirty());
+        QCOMPARE(loaded.lookup(keep)->title, QString("Keep"));
+        QCOMPARE(loaded.takeStats().statHits, 1);
+
+        // "gone" deleted: not looked up this round, so pruned
+        QFile::remove(gone);
+        loaded.pruneUnvisited();
+        QCOMPARE(loaded.size(), 1);
+        QVERIFY(loaded.isDirty());
+
+        // Other format versions are ignored rather than misread
+        QFile file(indexFile);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(R"({"version": 999, "entries": [{"path": "x"}]})");
+        file.close();
+        QCOMPARE(ProfileCatalogIndex::load(indexFile).size(), 0);
+        QCOMPARE(ProfileCatalogIndex::load(m_dir.filePath("missing.json")).size(), 0);
+    }
+
+    void unreadableAndEmptyFiles()
+    {
+        ProfileCatalogIndex index;
+        QVERIFY(!index.lookup(profilePath("does_not_exist")).has_value());
+
+        QFile empty(profilePath("empty"));
+        QVERIFY(empty.open(QIODevice::WriteOnly));
+        empty.close();
+        QVERIFY(!index.lookup(profilePath("empty")).has_value());
+        QCOMPARE(index.takeStats().unreadable, 2);
+
+        const auto meta = ProfileCatalogIndex::parse(R"({"title": "Ro", "profile_type": "settings_2b", "read_only": 1})");
+        QCOMPARE(meta.profileType, QString("settings_2b"));
+        QVERIFY(meta.readOnly);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_ProfileCatalogIndex)
+
+#include "tst_profilecatalogindex.moc"
@@ -1170,6 +1170,32 @@ private slots:
         QVERIFY2(found, "Saved profile must appear in allProfiles() after refresh");
     }
 
+    void refreshProfilesEmitsCatalogDiff() {
+        McpTestFixture f;
+        QSignalSpy catalogSpy(&f.profileManager, &ProfileManager::profileCatalogChanged);
+        QSignalSpy listSpy(&f.profileManager, &ProfileManager::profilesChanged);
+
+        // Nothing on disk changed: no diff, no list rebuild
+        f.profileManager.refreshProfiles();
+        QCOMPARE(catalogSpy.count(), 0);
+        QCOMPARE(listSpy.count(), 0);
+
+        loadDFlowProfile(f, "D-Flow / DiffTest");
+        f.profileManager.saveProfile("diff_test");
+        f.profileManager.refreshProfiles();
+        QVERIFY(!catalogSpy.isEmpty());
+        bool added = false;
+        for (const QList<QVariant>& args : std::as_const(catalogSpy))
+            added = added || args.at(0).toStringList().contains("diff_test");
+        QVERIFY2(added, "Saved profile must be reported as added");
+        QVERIFY(!listSpy.isEmpty());
+
+        catalogSpy.clear();
+        QVERIFY(f.profileManager.deleteProfile("diff_test"));
+        QVERIFY(!catalogSpy.isEmpty());
+        QCOMPARE(catalogSpy.last().at(1).toStringList(), QStringList({"diff_test"}));
+    }
+
     void availableProfilesReturnsSortedList() {
         McpTestFixture f;
         // Create multiple profiles to ensure sorting can be verified
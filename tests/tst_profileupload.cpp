@@ -15,6 +15,10 @@
 // in the right order on the DE1. After this change, the profileUploaded()
 // signal carries a real verdict: true iff the FRAME_WRITE ACKs' leading
 // FrameToWrite bytes matched the sequence we queued, in order.
+//
+// A verified upload also becomes the DE1's known profile image: repeating it
+// sends nothing, and an edit sends the header plus only the changed frames.
+// Any failure, disconnect or direct frame write drops the image.
 
 class tst_ProfileUpload : public QObject {
     Q_OBJECT
@@ -372,6 +376,111 @@ private slots:
         QCOMPARE(args.at(0).toBool(), false);
         QCOMPARE(args.at(1).toString(), QStringLiteral("BLE disconnect during upload"));
     }
+
+    // ===== Delta upload against the last verified profile =====
+
+    void identicalUploadAfterVerifiedUploadIsSkipped() {
+        MockTransport transport;
+        DE1Device device;
+        device.setTransport(&transport);
+
+        QSignalSpy spy(&device, &DE1Device::profileUploaded);
+
+        device.uploadProfile(makeSimpleProfile());
+        transport.ackAllWritesInOrder();
+        QCOMPARE(spy.count(), 1);
+        transport.clearWrites();
+
+        device.uploadProfile(makeSimpleProfile());
+        QCOMPARE(transport.writes.size(), 0);
+        QCOMPARE(spy.count(), 2);
+        QCOMPARE(spy.at(1).at(0).toBool(), true);
+
+        // Start-espresso variant still starts the shot
+        device.uploadProfileAndStartEspresso(makeSimpleProfile());
+        QCOMPARE(transport.writes.size(), 1);
+        QCOMPARE(transport.writes.first().first, DE1::Characteristic::REQUESTED_STATE);
+        QCOMPARE(spy.count(), 3);
+        QCOMPARE(spy.at(2).at(0).toBool(), true);
+    }
+
+    void editedProfileSendsHeaderAndChangedFramesOnly() {
+        MockTransport transport;
+        DE1Device device;
+        device.setTransport(&transport);
+
+        QSignalSpy spy(&device, &DE1Device::profileUploaded);
+
+        device.uploadProfile(makeSimpleProfile());
+        transport.ackAllWritesInOrder();
+        transport.clearWrites();
+
+        Profile edited = makeSimpleProfile();
+        QList<ProfileFrame> steps = edited.steps();
+        steps[1].flow = 2.5;
+        edited.setSteps(steps);
+        device.uploadProfile(edited);
+
+        QCOMPARE(transport.writes.size(), 2);
+        QCOMPARE(transport.writes.at(0).first, DE1::Characteristic::HEADER_WRITE);
+        QCOMPARE(transport.writes.at(1).first, DE1::Characteristic::FRAME_WRITE);
+        QCOMPARE(static_cast<uint8_t>(transport.writes.at(1).second.at(0)), uint8_t(1));
+
+        // The partial upload verifies against the frames actually sent
+        transport.ackAllWritesInOrder();
+        QCOMPARE(spy.count(), 2);
+        QCOMPARE(spy.at(1).at(0).toBool(), true);
+
+        // ...and the edited profile is now the loaded one
+        transport.clearWrites();
+        device.uploadProfile(edited);
+        QCOMPARE(transport.writes.size(), 0);
+    }
+
+    void unverifiedUploadIsNotTrusted() {
+        MockTransport transport;
+        DE1Device device;
+        device.setTransport(&transport);
+
+        // No ACKs yet: the next upload supersedes and goes out in full
+        QTest::ignoreMessage(QtWarningMsg,
+            QRegularExpression("profile upload FAILED — superseded"));
+        device.uploadProfile(makeSimpleProfile());
+        transport.clearWrites();
+        device.uploadProfile(makeSimpleProfile());
+        QCOMPARE(transport.writes.size(), 4);
+    }
+
+    void disconnectDropsLoadedProfile() {
+        MockTransport transport;
+        DE1Device device;
+        device.setTransport(&transport);
+
+        device.uploadProfile(makeSimpleProfile());
+        transport.ackAllWritesInOrder();
+
+        transport.setConnectedSim(false);
+        transport.setConnectedSim(true);
+        transport.clearWrites();
+
+        device.uploadProfile(makeSimpleProfile());
+        QCOMPARE(transport.writes.size(), 4);
+    }
+
+    void directFrameWriteDropsLoadedProfile() {
+        MockTransport transport;
+        DE1Device device;
+        device.setTransport(&transport);
+
+        device.uploadProfile(makeSimpleProfile());
+        transport.ackAllWritesInOrder();
+
+        device.writeFrame(QByteArray(8, 0));
+        transport.clearWrites();
+
+        device.uploadProfile(makeSimpleProfile());
+        QCOMPARE(transport.writes.size(), 4);
+    }
 };
 
 QTEST_GUILESS_MAIN(tst_ProfileUpload)
@@ -0,0 +1,226 @@
+#include <QtTest>
+#include <QSignalSpy>
+#include <QSettings>
+
+#include "ble/arrivalclock.h"
+#include "ble/de1device.h"
+#include "ble/protocol/de1characteristics.h"
+#include "core/settingsstore.h"
+#include "machine/sawlatencytracker.h"
+#include "mocks/MockTransport.h"
+
+// Tests for stop-at-weight latency tracing in DE1Device and the per-scale
+// histograms in SawLatencyTracker.
+
+class tst_SawLatency : public QObject {
+    Q_OBJECT
+
+private:
+    struct TestFixture {
+        MockTransport transport;
+        DE1Device device;
+
+        TestFixture() {
+            device.setTransport(&transport);
+            notifyState(DE1::State::Espresso, DE1::SubState::Pouring);
+        }
+
+        void notifyState(DE1::State state, DE1::SubState subState, qint64 arrivalMs = 0) {
+            QByteArray data(2, 0);
+            data[0] = static_cast<char>(state);
+            data[1] = static_cast<char>(subState);
+            emit transport.dataReceived(DE1::Characteristic::STATE_INFO, data, arrivalMs);
+        }
+
+        void ackStop() {
+            emit transport.writeComplete(DE1::Characteristic::REQUESTED_STATE,
+                                         QByteArray(1, static_cast<char>(DE1::State::Idle)));
+        }
+    };
+
+    static SawLatencyTrace sawTrace() {
+        SawLatencyTrace trace;
+        const qint64 now = ArrivalClock::nowMs();
+        trace.arrivalMs = now - 30;
+        trace.processMs = now - 20;
+        trace.triggerMs = now - 19;
+        return trace;
+    }
+
+    SettingsStore& m_settings = SettingsStore::instance();
+    QVariant m_savedHistograms;
+
+private slots:
+    void initTestCase() {
+        m_savedHistograms = m_settings.value("saw/latencyHistograms");
+    }
+
+    void cleanupTestCase() {
+        if (m_savedHistograms.isValid())
+            m_settings.setValue("saw/latencyHistograms", m_savedHistograms);
+        else
+            m_settings.remove("saw/latencyHistograms");
+    }
+
+    void init() {
+        SawLatencyTracker().clear();
+    }
+
+    // ===== DE1Device tracing =====
+
+    void ackThenStateCompletesTrace() {
+        TestFixture f;
+        QSignalSpy spy(&f.device, &DE1Device::sawStopTraced);
+        const SawLatencyTrace sent = sawTrace();
+
+        f.device.stopOperationUrgent(sent);
+        QCOMPARE(f.transport.lastWriteData(), QByteArray(1, static_cast<char>(DE1::State::Idle)));
+        f.ackStop();
+        QCOMPARE(spy.count(), 0);  // DE1 hasn't reacted yet
+
+        f.notifyState(DE1::State::Idle, DE1::SubState::Ready);
+        QCOMPARE(spy.count(), 1);
+        const auto trace = spy.first().at(0).value<SawLatencyTrace>();
+        QCOMPARE(trace.arrivalMs, sent.arrivalMs);
+        QCOMPARE(trace.processMs, sent.processMs);
+        QCOMPARE(trace.triggerMs, sent.triggerMs);
+        QVERIFY(trace.writeMs >= sent.triggerMs);
+        QVERIFY(trace.ackMs >= trace.writeMs);
+        QVERIFY(trace.stateMs >= trace.writeMs);
+
+        // Later state changes don't trace again
+        f.notifyState(DE1::State::Sleep, DE1::SubState::Ready);
+        QCOMPARE(spy.count(), 1);
+    }
+
+    void stateBeforeAckCompletesTrace() {
+        TestFixture f;
+        QSignalSpy spy(&f.device, &DE1Device::sawStopTraced);
+
+        f.device.stopOperationUrgent(sawTrace());
+        f.notifyState(DE1::State::Espresso, DE1::SubState::Ending);
+        QCOMPARE(spy.count(), 0);
+        f.ackStop();
+        QCOMPARE(spy.count(), 1);
+        QVERIFY(spy.first().at(0).value<SawLatencyTrace>().complete());
+    }
+
+    void notificationFromBeforeWriteIgnored() {
+        TestFixture f;
+        QSignalSpy spy(&f.device, &DE1Device::sawStopTraced);
+
+        f.device.stopOperationUrgent(sawTrace());
+        f.ackStop();
+        // Stamped long before the write: it was already queued, not a reaction
+        f.notifyState(DE1::State::Espresso, DE1::SubState::Ending, 1);
+        QCOMPARE(spy.count(), 0);
+        f.notifyState(DE1::State::Idle, DE1::SubState::Ready);
+        QCOMPARE(spy.count(), 1);
+    }
+
+    void untracedStopEmitsNothing() {
+        TestFixture f;
+        QSignalSpy spy(&f.device, &DE1Device::sawStopTraced);
+
+        f.device.stopOperationUrgent();
+        f.ackStop();
+        f.notifyState(DE1::State::Idle, DE1::SubState::Ready);
+        QCOMPARE(spy.count(), 0);
+    }
+
+    // ===== SawLatencyTracker =====
+
+    void histogramBucketsAndPercentiles() {
+        SawLatencyTracker::Histogram h;
+        QCOMPARE(h.percentileMs(50), qint64(0));
+        h.add(0);
+        h.add(5);       // Bounds are inclusive
+        h.add(6);
+        h.add(2500);    // Overflow bucket
+        h.add(-3);      // Clamped to 0
+
+        QCOMPARE(h.count, quint32(5));
+        QCOMPARE(h.buckets[0], quint32(3));
+        QCOMPARE(h.buckets[1], quint32(1));
+        QCOMPARE(h.buckets[SawLatencyTracker::BUCKET_COUNT - 1], quint32(1));
+        QCOMPARE(h.maxMs, qint64(2500));
+        QCOMPARE(h.percentileMs(50), qint64(5));
+        QCOMPARE(h.percentileMs(80), qint64(10));
+        QCOMPARE(h.percentileMs(95), qint64(2500));
+    }
+
+    void traceSplitIntoStagesPerScale() {
+        SawLatencyTracker tracker;
+        SawLatencyTrace trace;
+        trace.arrivalMs = 1000;
+        trace.processMs = 1012;
+        trace.triggerMs = 1013;
+        trace.writeMs = 1020;
+        trace.ackMs = 1050;
+        trace.stateMs = 1090;
+        tracker.record("decent", trace);
+
+        const struct { SawLatencyTracker::Stage stage; qint64 ms; } expected[] = {
+            {SawLatencyTracker::Queue, 12}, {SawLatencyTracker::Decide, 1},
+            {SawLatencyTracker::Dispatch, 7}, {SawLatencyTracker::BleAck, 30},
+            {SawLatencyTracker::Machine, 70}, {SawLatencyTracker::Total, 90},
+        };
+        for (const auto& e : expected) {
+            const auto* h = tracker.histogram("decent", e.stage);
+            QVERIFY(h);
+            QCOMPARE(h->count, quint32(1));
+            QCOMPARE(h->sumMs, e.ms);
+        }
+        QVERIFY(!tracker.histogram("acaia", SawLatencyTracker::Total));
+
+        const QJsonObject json = tracker.toJson();
+        const QJsonObject total = json["scales"]["decent"]["stages"]["total"].toObject();
+        QCOMPARE(json["scales"]["decent"]["stops"].toInt(), 1);
+        QCOMPARE(total["p95Ms"].toInteger(), qint64(90));
+        QCOMPARE(json["bucketUpperMs"].toArray().size(), SawLatencyTracker::BUCKET_COUNT - 1);
+    }
+
+    void unstampedStagesSkipped() {
+        SawLatencyTracker tracker;
+        SawLatencyTrace trace;  // Reading without an arrival stamp
+        trace.processMs = 500;
+        trace.triggerMs = 501;
+        trace.writeMs = 510;
+        trace.ackMs = 520;
+        trace.stateMs = 560;
+        tracker.record("bookoo", trace);
+
+        QCOMPARE(tracker.histogram("bookoo", SawLatencyTracker::Queue)->count, quint32(0));
+        QCOMPARE(tracker.histogram("bookoo", SawLatencyTracker::Total)->count, quint32(0));
+        QCOMPARE(tracker.histogram("bookoo", SawLatencyTracker::Machine)->count, quint32(1));
+    }
+
+    void histogramsSurviveRestart() {
+        SawLatencyTrace trace;
+        trace.writeMs = 100;
+        trace.ackMs = 140;
+        trace.stateMs = 400;
+        {
+            SawLatencyTracker tracker;
+            tracker.record("felicita", trace);
+            tracker.record("felicita", trace);
+        }
+
+        // Not written through to disk per stop; the store's flush carries it
+        m_settings.sync();
+        QVERIFY(QSettings("DecentEspresso", "DE1Qt").contains("saw/latencyHistograms"));
+
+        SawLatencyTracker reloaded;
+        QCOMPARE(SawLatencyTracker::instance(), &reloaded);
+        const auto* h = reloaded.histogram("felicita", SawLatencyTracker::Machine);
+        QVERIFY(h);
+        QCOMPARE(h->count, quint32(2));
+        QCOMPARE(h->sumMs, qint64(600));
+        QCOMPARE(h->maxMs, qint64(300));
+        QCOMPARE(reloaded.toJson()["scales"]["felicita"]["stops"].toInt(), 2);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_SawLatency)
+
+#include "tst_sawlatency.moc"
@@ -0,0 +1,194 @@
+#include <QtTest>
+#include <QSignalSpy>
+#include <atomic>
+#include <memory>
+
+#include "ble/scaleingest.h"
+
+// Tests for ScaleIngest and IngestScaleBleTransport: scale transports on the
+// ingest thread, the weight fast path, and stopping with transports connected.
+
+namespace {
+
+const QBluetoothUuid kWeightUuid(QStringLiteral("0000fff4-0000-1000-8000-00805f9b34fb"));
+const QBluetoothUuid kButtonUuid(QStringLiteral("0000fff5-0000-1000-8000-00805f9b34fb"));
+
+// Test protocol: a weight packet is 'W' followed by the weight in grams
+bool decodeTestWeight(const QBluetoothUuid& uuid, const QByteArray& value, double* weight)
+{
+    if (uuid != kWeightUuid || value.size() != 2 || value[0] != 'W') return false;
+    *weight = static_cast<quint8>(value[1]);
+    return true;
+}
+
+QByteArray weightPacket(int grams)
+{
+    QByteArray packet("W");
+    packet.append(static_cast<char>(grams));
+    return packet;
+}
+
+} // namespace
+
+// Records what the proxy forwards; lives on the ingest thread once wrapped
+class MockScaleBleTransport : public ScaleBleTransport {
+    Q_OBJECT
+public:
+    void connectToDevice(const QString&, const QString&) override {
+        m_lastCallThread = QThread::currentThread();
+        m_connected = true;
+        emit connected();
+    }
+    void disconnectFromDevice() override {
+        m_lastCallThread = QThread::currentThread();
+        // Like CoreBluetooth's dispatch_sync onto the main queue
+        if (m_disconnectOnMainThread) {
+            QMetaObject::invokeMethod(QCoreApplication::instance(), [this]() {
+                m_disconnectThread = QThread::currentThread();
+            }, Qt::BlockingQueuedConnection);
+        }
+        ++m_disconnectCount;
+        m_connected = false;
+    }
+    void discoverServices() override {}
+    void discoverCharacteristics(const QBluetoothUuid&) override {}
+    void enableNotifications(const QBluetoothUuid&, const QBluetoothUuid&) override {}
+    void writeCharacteristic(const QBluetoothUuid&, const QBluetoothUuid&,
+                             const QByteArray&, WriteType = WriteType::WithResponse) override {
+        m_lastCallThread = QThread::currentThread();
+        ++m_writeCount;
+    }
+    void readCharacteristic(const QBluetoothUuid&, const QBluetoothUuid&) override {}
+    bool isConnected() const override { return m_connected; }
+
+    // Delivers a notification on the transport's own thread, as the BLE stack would
+    void notify(const QBluetoothUuid& uuid, const QByteArray& value, qint64 arrivalMs) {
+        QMetaObject::invokeMethod(this, [this, uuid, value, arrivalMs]() {
+            emit characteristicChanged(uuid, value, arrivalMs);
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    std::atomic<QThread*> m_lastCallThread{nullptr};
+    std::atomic<int> m_writeCount{0};
+    std::atomic<int> m_disconnectCount{0};
+    std::atomic<bool> m_connected{false};
+    bool m_disconnectOnMainThread = false;
+    std::atomic<QThread*> m_disconnectThread{nullptr};
+};
+
+class tst_ScaleIngest : public QObject {
+    Q_OBJECT
+
+private:
+    struct Reading {
+        double weight;
+        qint64 arrivalMs;
+        bool onIngestThread;
+    };
+
+private slots:
+    void callsRunOnIngestThread()
+    {
+        ScaleIngest ingest;
+        auto* mock = new MockScaleBleTransport;
+        std::unique_ptr<ScaleBleTransport> proxy(ingest.wrap(mock, nullptr));
+        QSignalSpy connectedSpy(proxy.get(), &ScaleBleTransport::connected);
+
+        QVERIFY(!proxy->isConnected());
+        proxy->connectToDevice(QStringLiteral("00:11:22:33:44:55"), QStringLiteral("Test"));
+        QTRY_COMPARE(connectedSpy.count(), 1);
+        QVERIFY(proxy->isConnected());
+        QCOMPARE(mock->m_lastCallThread.load(), ingest.ingestThread());
+
+        proxy->writeCharacteristic(kButtonUuid, kButtonUuid, QByteArray("x"));
+        QTRY_COMPARE(mock->m_writeCount.load(), 1);
+        QCOMPARE(mock->m_lastCallThread.load(), ingest.ingestThread());
+    }
+
+    void weightReachesSinkOnIngestThread()
+    {
+        ScaleIngest ingest;
+        QList<Reading> readings;  // Only appended while the main thread is blocked in notify()
+        ingest.setWeightSink([&readings, &ingest](double weight, qint64 arrivalMs) {
+            readings.append({weight, arrivalMs, QThread::currentThread() == ingest.ingestThread()});
+        });
+        auto* mock = new MockScaleBleTransport;
+        std::unique_ptr<ScaleBleTransport> proxy(ingest.wrap(mock, &decodeTestWeight));
+
+        mock->notify(kWeightUuid, weightPacket(10), 1000);
+        mock->notify(kWeightUuid, weightPacket(10), 1100);  // Unchanged: not a new reading
+        mock->notify(kWeightUuid, weightPacket(12), 1200);
+        mock->notify(kButtonUuid, QByteArray("W\x0f"), 1300);  // Not the weight characteristic
+
+        QCOMPARE(readings.size(), 2);
+        QCOMPARE(readings[0].weight, 10.0);
+        QCOMPARE(readings[0].arrivalMs, qint64(1000));
+        QVERIFY(readings[0].onIngestThread);
+        QCOMPARE(readings[1].weight, 12.0);
+        QCOMPARE(readings[1].arrivalMs, qint64(1200));
+    }
+
+    void busyMainThreadSeesOnlyNewestWeight()
+    {
+        ScaleIngest ingest;
+        auto* mock = new MockScaleBleTransport;
+        std::unique_ptr<ScaleBleTransport> proxy(ingest.wrap(mock, &decodeTestWeight));
+        QSignalSpy changed(proxy.get(), &ScaleBleTransport::characteristicChanged);
+
+        // The main thread doesn't run its event loop until all four are in
+        mock->notify(kWeightUuid, weightPacket(1), 1000);
+        mock->notify(kButtonUuid, QByteArray("b1"), 1050);
+        mock->notify(kWeightUuid, weightPacket(2), 1100);
+        mock->notify(kWeightUuid, weightPacket(3), 1200);
+        QCOMPARE(changed.count(), 0);
+
+        QTRY_COMPARE(changed.count(), 2);
+        QCoreApplication::processEvents();
+        QCOMPARE(changed.count(), 2);
+        QCOMPARE(changed[0].at(0).value<QBluetoothUuid>(), kButtonUuid);
+        QCOMPARE(changed[1].at(1).toByteArray(), weightPacket(3));
+        QCOMPARE(changed[1].at(2).toLongLong(), qint64(1200));
+    }
+
+    void stopDisconnectsOpenTransports()
+    {
+        ScaleIngest ingest;
+        auto* open = new MockScaleBleTransport;
+        auto* closed = new MockScaleBleTransport;
+        std::unique_ptr<ScaleBleTransport> openProxy(ingest.wrap(open, nullptr));
+        std::unique_ptr<ScaleBleTransport> closedProxy(ingest.wrap(closed, nullptr));
+        QSignalSpy connectedSpy(openProxy.get(), &ScaleBleTransport::connected);
+        openProxy->connectToDevice(QString(), QString());
+        QTRY_COMPARE(connectedSpy.count(), 1);
+
+        QCOMPARE(ScaleIngest::instance(), &ingest);
+        ingest.stop();
+        QVERIFY(!ingest.ingestThread()->isRunning());
+        QCOMPARE(open->m_disconnectCount.load(), 1);
+        QCOMPARE(open->m_lastCallThread.load(), ingest.ingestThread());
+        QCOMPARE(closed->m_disconnectCount.load(), 0);
+    }
+
+    void stopDoesNotDeadlockOnMainThreadDisconnect()
+    {
+        ScaleIngest ingest;
+        auto* mock = new MockScaleBleTransport;
+        mock->m_disconnectOnMainThread = true;
+        std::unique_ptr<ScaleBleTransport> proxy(ingest.wrap(mock, nullptr));
+        QSignalSpy connectedSpy(proxy.get(), &ScaleBleTransport::connected);
+        proxy->connectToDevice(QString(), QString());
+        QTRY_COMPARE(connectedSpy.count(), 1);
+
+        QElapsedTimer timer;
+        timer.start();
+        ingest.stop();
+        QVERIFY(timer.elapsed() < 1000);
+        QVERIFY(!ingest.ingestThread()->isRunning());
+        QCOMPARE(mock->m_disconnectCount.load(), 1);
+        QCOMPARE(mock->m_disconnectThread.load(), QThread::currentThread());
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_ScaleIngest)
+
+#include "tst_scaleingest.moc"
@@ -5,6 +5,12 @@
 
 #include "ble/scales/decentscale.h"
 #include "ble/scales/bookooscale.h"
+#include "ble/scales/acaiascale.h"
+#include "ble/scales/felicitascale.h"
+#include "ble/scales/hiroiascale.h"
+#include "ble/scales/difluidscale.h"
+#include "ble/scales/variaakuscale.h"
+#include "ble/protocol/framedstreamparser.h"
 #include "ble/transport/scalebletransport.h"
 #include "ble/protocol/de1characteristics.h"
 #include "ble/protocol/decentscaleprotocol.h"
@@ -16,6 +22,11 @@
 // de1app references:
 //   Decent: de1plus/scale.tcl proc decent_scale_parse_response
 //   Bookoo: de1plus/scale.tcl proc bookoo_parse_response
+//   Acaia, Felicita, Hiroia, Difluid: de1plus/scale.tcl *_parse_response
+//
+// Acaia, Decent, Bookoo and Varia Aku messages go through FramedStreamParser,
+// which must hand out each message exactly once however the stream is split
+// into notifications.
 
 // Minimal mock transport for watchdog tests
 class MockScaleBleTransport : public ScaleBleTransport {
@@ -85,6 +96,92 @@ private:
         return pkt;
     }
 
+    // Build a 7-byte Varia Aku message: FA, command, length, payload, XOR
+    static QByteArray buildVariaPacket(uint8_t command, const QByteArray& payload) {
+        QByteArray pkt;
+        pkt.append(static_cast<char>(0xFA));
+        pkt.append(static_cast<char>(command));
+        pkt.append(static_cast<char>(payload.size()));
+        pkt.append(payload);
+        uint8_t x = 0;
+        for (qsizetype i = 1; i < pkt.size(); i++) x ^= static_cast<uint8_t>(pkt[i]);
+        pkt.append(static_cast<char>(x));
+        return pkt;
+    }
+
+    // Varia weight: 3 bytes big-endian hundredths, 0x10 in the top nibble for negative
+    static QByteArray buildVariaWeightPacket(double grams) {
+        uint32_t raw = static_cast<uint32_t>(qRound(qAbs(grams) * 100.0));
+        QByteArray payload(3, 0);
+        payload[0] = static_cast<char>(((raw >> 16) & 0x0F) | (grams < 0 ? 0x10 : 0));
+        payload[1] = static_cast<char>((raw >> 8) & 0xFF);
+        payload[2] = static_cast<char>(raw & 0xFF);
+        return buildVariaPacket(0x01, payload);
+    }
+
+    // Build a 13-byte Acaia weight message (type 0x0C, event 5): weight in
+    // hundredths, unit byte 2, sign byte 0/2, unverified checksum
+    static QByteArray buildAcaiaWeightPacket(double grams) {
+        QByteArray pkt(13, 0);
+        pkt[0] = static_cast<char>(0xEF);
+        pkt[1] = static_cast<char>(0xDD);
+        pkt[2] = 0x0C;
+        pkt[3] = 8;
+        pkt[4] = 5;
+        uint32_t raw = static_cast<uint32_t>(qRound(qAbs(grams) * 100.0));
+        pkt[5] = static_cast<char>(raw & 0xFF);
+        pkt[6] = static_cast<char>((raw >> 8) & 0xFF);
+        pkt[7] = static_cast<char>((raw >> 16) & 0xFF);
+        pkt[9] = 2;
+        pkt[10] = static_cast<char>(grams < 0 ? 2 : 0);
+        return pkt;
+    }
+
+    // Build a Felicita weight packet: 01 02, sign, 6 ASCII digits (hundredths)
+    static QByteArray buildFelicitaPacket(const QByteArray& sign, const QByteArray& digits,
+                                          uint8_t battery = 0) {
+        QByteArray pkt = QByteArray::fromHex("0102") + sign + digits;
+        if (battery) {
+            pkt.append(QByteArray(15 - pkt.size(), 0));
+            pkt.append(static_cast<char>(battery));
+        }
+        return pkt;
+    }
+
+    struct TestFrame {
+        static constexpr std::array<uint8_t, 2> sync{{0xAA, 0x55}};
+        static constexpr int headerLength = 3;
+        static constexpr int maxFrameLength = 16;
+        static int frameLength(const uint8_t* header) { return header[2]; }
+        // Last byte is the sum of the others
+        static bool checksumValid(const uint8_t* frame, int length) {
+            uint8_t sum = 0;
+            for (int i = 0; i < length - 1; i++) sum += frame[i];
+            return sum == frame[length - 1];
+        }
+    };
+
+    static QByteArray buildTestFrame(const QByteArray& body) {
+        QByteArray frame = QByteArray::fromHex("AA55");
+        frame.append(static_cast<char>(body.size() + 4));
+        frame.append(body);
+        uint8_t sum = 0;
+        for (char c : frame) sum += static_cast<uint8_t>(c);
+        frame.append(static_cast<char>(sum));
+        return frame;
+    }
+
+    static QList<QByteArray> feedAll(FramedStreamParser<TestFrame>& parser,
+                                     const QList<QByteArray>& notifications) {
+        QList<QByteArray> frames;
+        for (const QByteArray& n : notifications) {
+            parser.feed(n, [&frames](const FrameView& f) {
+                frames.append(QByteArray(reinterpret_cast<const char*>(f.data), f.size));
+            });
+        }
+        return frames;
+    }
+
 private slots:
 
     // ==========================================
@@ -102,6 +199,21 @@ private slots:
         QCOMPARE(spy.last().at(0).toDouble(), 100.0);
     }
 
+    void decentWeightCarriesArrivalStamp() {
+        // The transport's arrival stamp rides along to WeightProcessor
+        DecentScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        scale.onCharacteristicChanged(Scale::Decent::READ, buildDecentWeightPacket(12.5), 424242);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(1).toLongLong(), qint64(424242));
+
+        // Unstamped readings get stamped by ScaleDevice instead of left at 0
+        scale.onCharacteristicChanged(Scale::Decent::READ, buildDecentWeightPacket(13.0));
+        QCOMPARE(spy.count(), 2);
+        QVERIFY(spy.last().at(1).toLongLong() > 0);
+    }
+
     void decentWeightZero() {
         DecentScale scale(nullptr);
         // First set to non-zero so the 0.0 packet triggers a change
@@ -234,6 +346,23 @@ private slots:
         QCOMPARE(spy.count(), 0);
     }
 
+    void decentDecodeWeightForIngest() {
+        // The ingest-thread decoder takes exactly the packets the parser
+        // turns into weight while checksums are enforced
+        double weight = 0;
+        QVERIFY(DecentScale::decodeWeight(Scale::Decent::READ, buildDecentWeightPacket(42.3), &weight));
+        QCOMPARE(weight, 42.3);
+        QVERIFY(DecentScale::decodeWeight(Scale::Decent::READ, buildDecentWeightPacket(-1.5), &weight));
+        QCOMPARE(weight, -1.5);
+
+        auto corrupt = buildDecentWeightPacket(42.0);
+        corrupt[6] = static_cast<char>(static_cast<uint8_t>(corrupt[6]) ^ 0xFF);
+        QVERIFY(!DecentScale::decodeWeight(Scale::Decent::READ, corrupt, &weight));
+        QVERIFY(!DecentScale::decodeWeight(Scale::Decent::READ, buildDecentPacket(0xAA, 0x01, 0x00, 0x00, 0x00), &weight));
+        QVERIFY(!DecentScale::decodeWeight(Scale::Decent::WRITE, buildDecentWeightPacket(42.0), &weight));
+        QVERIFY(!DecentScale::decodeWeight(Scale::Decent::READ, QByteArray(3, 0), &weight));
+    }
+
     void decentBadChecksumButtonDropped() {
         // Corrupt button packet should be dropped
         DecentScale scale(nullptr);
@@ -329,6 +458,47 @@ private slots:
         QCOMPARE(spy.last().at(0).toInt(), 60);
     }
 
+    void decentPacketSplitAcrossNotifications() {
+        DecentScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+        auto pkt = buildDecentWeightPacket(21.4);
+
+        scale.onCharacteristicChanged(Scale::Decent::READ, pkt.left(3), 100);
+        QCOMPARE(spy.count(), 0);
+        scale.onCharacteristicChanged(Scale::Decent::READ, pkt.mid(3), 130);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 21.4);
+        QCOMPARE(spy.last().at(1).toLongLong(), qint64(130));
+    }
+
+    void decentPackedPacketsAllDecoded() {
+        DecentScale scale(nullptr);
+        QSignalSpy weight(&scale, &ScaleDevice::weightChanged);
+        QSignalSpy button(&scale, &ScaleDevice::buttonPressed);
+
+        scale.onCharacteristicChanged(Scale::Decent::READ,
+                                      buildDecentWeightPacket(1.0)
+                                      + buildDecentPacket(0xAA, 0x02, 0x00, 0x00, 0x00)
+                                      + buildDecentWeightPacket(2.0));
+        QCOMPARE(weight.count(), 2);
+        QCOMPARE(weight.last().at(0).toDouble(), 2.0);
+        QCOMPARE(button.count(), 1);
+        QCOMPARE(button.last().at(0).toInt(), 2);
+    }
+
+    void decentResyncsAfterCorruptPacket() {
+        // A checksum failure skips the 0x03 and rescans, so a good packet
+        // right behind a corrupt one in the stream is still found
+        DecentScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        auto bad = buildDecentWeightPacket(9.0);
+        bad[6] = static_cast<char>(static_cast<uint8_t>(bad[6]) ^ 0xFF);
+        scale.onCharacteristicChanged(Scale::Decent::READ, bad.left(5) + buildDecentWeightPacket(33.3));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 33.3);
+    }
+
     // ==========================================
     // BookooScale: weight parsing
     // ==========================================
@@ -380,6 +550,44 @@ private slots:
         QCOMPARE(spy.last().at(0).toInt(), 80);
     }
 
+    void bookooDecodeWeightForIngest() {
+        double weight = 0;
+        QVERIFY(BookooScale::decodeWeight(Scale::Bookoo::STATUS, buildBookooPacket(-3.5), &weight));
+        QVERIFY(qAbs(weight - (-3.5)) < 0.02);
+        QVERIFY(!BookooScale::decodeWeight(Scale::Bookoo::CMD, buildBookooPacket(10.0), &weight));
+        QVERIFY(!BookooScale::decodeWeight(Scale::Bookoo::STATUS, QByteArray(5, 0), &weight));
+        // Only a whole frame is a reading on the ingest thread; the rest of
+        // a split one is reassembled by parseWeightData()
+        QVERIFY(!BookooScale::decodeWeight(Scale::Bookoo::STATUS, buildBookooPacket(10.0).left(12), &weight));
+    }
+
+    void bookooFrameSplitAcrossNotifications() {
+        BookooScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+        QSignalSpy battery(&scale, &ScaleDevice::batteryLevelChanged);
+        auto pkt = buildBookooPacket(36.25, 64);
+
+        scale.onCharacteristicChanged(Scale::Bookoo::STATUS, pkt.left(12), 200);
+        QCOMPARE(spy.count(), 0);
+        scale.onCharacteristicChanged(Scale::Bookoo::STATUS, pkt.mid(12), 220);
+        QCOMPARE(spy.count(), 1);
+        QVERIFY(qAbs(spy.last().at(0).toDouble() - 36.25) < 0.02);
+        QCOMPARE(spy.last().at(1).toLongLong(), qint64(220));
+        QCOMPARE(battery.last().at(0).toInt(), 64);
+    }
+
+    void bookooPackedFramesAllDecoded() {
+        BookooScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        // Junk in front is skipped up to the 03 0B sync
+        scale.onCharacteristicChanged(Scale::Bookoo::STATUS,
+                                      QByteArray::fromHex("0300FF") + buildBookooPacket(1.5) + buildBookooPacket(-2.0));
+        QCOMPARE(spy.count(), 2);
+        QVERIFY(qAbs(spy.first().at(0).toDouble() - 1.5) < 0.02);
+        QVERIFY(qAbs(spy.last().at(0).toDouble() - (-2.0)) < 0.02);
+    }
+
     // ==========================================
     // BookooScale: error handling
     // ==========================================
@@ -396,6 +604,264 @@ private slots:
         scale.onCharacteristicChanged(Scale::Bookoo::STATUS, QByteArray());
     }
 
+    // ==========================================
+    // FramedStreamParser
+    // ==========================================
+
+    void framedParserWholeAndPackedFrames() {
+        FramedStreamParser<TestFrame> parser;
+        QByteArray a = buildTestFrame("one");
+        QByteArray b = buildTestFrame("two");
+
+        QCOMPARE(feedAll(parser, {a}), QList<QByteArray>{a});
+        QCOMPARE(feedAll(parser, {a + b}), (QList<QByteArray>{a, b}));
+        QCOMPARE(parser.buffered(), 0);
+        QCOMPARE(parser.skippedBytes(), qint64(0));
+    }
+
+    void framedParserReassemblesSplitFrames() {
+        FramedStreamParser<TestFrame> parser;
+        QByteArray a = buildTestFrame("first");
+        QByteArray b = buildTestFrame("second");
+        QByteArray stream = a + b;
+
+        // Every split point, including inside the sync bytes and the header
+        for (int cut = 1; cut < stream.size(); cut++) {
+            parser.reset();
+            QCOMPARE(feedAll(parser, {stream.left(cut), stream.mid(cut)}), (QList<QByteArray>{a, b}));
+            QCOMPARE(parser.buffered(), 0);
+        }
+
+        // One byte per notification
+        parser.reset();
+        QList<QByteArray> bytes;
+        for (char c : stream) bytes.append(QByteArray(1, c));
+        QCOMPARE(feedAll(parser, bytes), (QList<QByteArray>{a, b}));
+    }
+
+    void framedParserResyncsAfterJunk() {
+        FramedStreamParser<TestFrame> parser;
+        QByteArray good = buildTestFrame("ok");
+        QByteArray corrupt = buildTestFrame("bad");
+        corrupt[4] = 'X';  // Checksum no longer matches
+
+        QByteArray stream = QByteArray("\x01\x02\xAA") + corrupt + good;
+        QCOMPARE(feedAll(parser, {stream}), QList<QByteArray>{good});
+        QCOMPARE(parser.skippedBytes(), qint64(3 + corrupt.size()));
+
+        // A sync followed by an impossible length is skipped too
+        parser.reset();
+        QCOMPARE(feedAll(parser, {QByteArray::fromHex("AA55FF") + good}), QList<QByteArray>{good});
+    }
+
+    void framedParserKeepsPartialSyncAtTail() {
+        FramedStreamParser<TestFrame> parser;
+        QByteArray frame = buildTestFrame("tail");
+
+        QVERIFY(feedAll(parser, {QByteArray("junk\xAA")}).isEmpty());
+        QCOMPARE(parser.buffered(), 1);
+        QCOMPARE(feedAll(parser, {frame.mid(1)}), QList<QByteArray>{frame});
+    }
+
+    void framedParserNotificationLargerThanBuffer() {
+        // More bytes than the parser's buffer holds, while a frame is pending
+        FramedStreamParser<TestFrame> parser;
+        QByteArray frame = buildTestFrame("x");
+        QByteArray stream;
+        for (int i = 0; i < 40; i++) stream += frame;
+
+        QList<QByteArray> frames = feedAll(parser, {stream.left(2), stream.mid(2)});
+        QCOMPARE(frames.size(), 40);
+        QCOMPARE(frames.last(), frame);
+        QCOMPARE(parser.buffered(), 0);
+    }
+
+    // ==========================================
+    // AcaiaScale: message framing
+    // ==========================================
+
+    void acaiaWeightWholeMessage() {
+        AcaiaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        scale.onCharacteristicChanged(Scale::AcaiaIPS::CHARACTERISTIC, buildAcaiaWeightPacket(18.25), 5000);
+
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 18.25);
+        QCOMPARE(spy.last().at(1).toLongLong(), qint64(5000));
+        QVERIFY(scale.isConnected());
+    }
+
+    void acaiaWeightSplitAcrossNotifications() {
+        AcaiaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+        QByteArray pkt = buildAcaiaWeightPacket(-1.5);
+
+        scale.onCharacteristicChanged(Scale::AcaiaIPS::CHARACTERISTIC, pkt.left(7), 100);
+        QCOMPARE(spy.count(), 0);
+        scale.onCharacteristicChanged(Scale::AcaiaIPS::CHARACTERISTIC, pkt.mid(7), 120);
+
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), -1.5);
+        QCOMPARE(spy.last().at(1).toLongLong(), qint64(120));
+    }
+
+    void acaiaPackedMessagesAllDecoded() {
+        // Two weights in one notification: the second used to be discarded
+        AcaiaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        scale.onCharacteristicChanged(Scale::AcaiaIPS::CHARACTERISTIC,
+                                      buildAcaiaWeightPacket(1.0) + buildAcaiaWeightPacket(2.0));
+
+        QCOMPARE(spy.count(), 2);
+        QCOMPARE(spy.last().at(0).toDouble(), 2.0);
+    }
+
+    void acaiaBatteryFromSettingsMessage() {
+        AcaiaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::batteryLevelChanged);
+
+        // EF DD 08 len payload[0] battery(0x80 flag set) ...
+        scale.onCharacteristicChanged(Scale::AcaiaIPS::CHARACTERISTIC,
+                                      QByteArray::fromHex("EFDD0803" "00" "C9" "00" "0000"));
+
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toInt(), 73);
+    }
+
+    // ==========================================
+    // VariaAkuScale: message framing
+    // ==========================================
+
+    void variaWeightAndBattery() {
+        VariaAkuScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+        QSignalSpy battery(&scale, &ScaleDevice::batteryLevelChanged);
+
+        scale.onCharacteristicChanged(Scale::VariaAku::STATUS, buildVariaWeightPacket(18.42), 700);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 18.42);
+        QCOMPARE(spy.last().at(1).toLongLong(), qint64(700));
+        QVERIFY(scale.isConnected());  // First weight confirms the connection
+
+        scale.onCharacteristicChanged(Scale::VariaAku::STATUS, buildVariaWeightPacket(-0.35));
+        QCOMPARE(spy.last().at(0).toDouble(), -0.35);
+
+        scale.onCharacteristicChanged(Scale::VariaAku::STATUS, buildVariaPacket(0x85, QByteArray(1, 55)));
+        QCOMPARE(battery.last().at(0).toInt(), 55);
+    }
+
+    void variaMessagesSplitAndPacked() {
+        VariaAkuScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+        QSignalSpy battery(&scale, &ScaleDevice::batteryLevelChanged);
+
+        // Battery and a weight in one notification, then a weight split in two
+        const QByteArray third = buildVariaWeightPacket(3.0);
+        scale.onCharacteristicChanged(Scale::VariaAku::STATUS,
+                                      buildVariaPacket(0x85, QByteArray(1, 90)) + buildVariaWeightPacket(2.0)
+                                      + third.left(4));
+        QCOMPARE(battery.count(), 1);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 2.0);
+
+        scale.onCharacteristicChanged(Scale::VariaAku::STATUS, third.mid(4));
+        QCOMPARE(spy.count(), 2);
+        QCOMPARE(spy.last().at(0).toDouble(), 3.0);
+
+        // Other characteristics are ignored
+        scale.onCharacteristicChanged(Scale::VariaAku::CMD, buildVariaWeightPacket(4.0));
+        QCOMPARE(spy.count(), 2);
+    }
+
+    // ==========================================
+    // Felicita, Hiroia, Difluid: weight parsing
+    // ==========================================
+
+    void felicitaWeight() {
+        FelicitaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+        QSignalSpy battery(&scale, &ScaleDevice::batteryLevelChanged);
+
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("+", "001834", 150));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 18.34);
+        QCOMPARE(battery.last().at(0).toInt(), 72);
+
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("-", "000250"));
+        QCOMPARE(spy.last().at(0).toDouble(), -2.5);
+
+        // Padding spaces are accepted, as QByteArray::toInt did
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("+", "  1200"));
+        QCOMPARE(spy.last().at(0).toDouble(), 12.0);
+    }
+
+    void felicitaMalformedWeightIgnored() {
+        FelicitaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("+", "12a400"));
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("+", "      "));
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("+", QByteArray("12\0\0" "34", 6)));
+        scale.onCharacteristicChanged(Scale::Felicita::CHARACTERISTIC, buildFelicitaPacket("+", "001"));
+        QCOMPARE(spy.count(), 0);
+    }
+
+    void hiroiaWeight() {
+        HiroiaScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        // 7-byte packet: the weight's top byte is implied zero
+        scale.onCharacteristicChanged(Scale::HiroiaJimmy::STATUS, QByteArray::fromHex("00000000B70000"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 18.3);
+
+        // Negative: 24-bit two's complement style, 0xFFFFFF - raw
+        scale.onCharacteristicChanged(Scale::HiroiaJimmy::STATUS, QByteArray::fromHex("00000000F6FFFF00"));
+        QCOMPARE(spy.last().at(0).toDouble(), -0.9);
+
+        scale.onCharacteristicChanged(Scale::HiroiaJimmy::STATUS, QByteArray::fromHex("000000"));
+        QCOMPARE(spy.count(), 2);
+    }
+
+    void difluidWeight() {
+        DifluidScale scale(nullptr);
+        QSignalSpy spy(&scale, &ScaleDevice::weightChanged);
+
+        QByteArray pkt(19, 0);
+        pkt[11] = 0x01;
+        pkt[12] = static_cast<char>(0x2C);  // 300 -> 30.0 g
+        scale.onCharacteristicChanged(Scale::DiFluid::CHARACTERISTIC, pkt);
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.last().at(0).toDouble(), 30.0);
+
+        // Out of range (any of the high bytes set) is dropped
+        pkt[5] = 0x01;
+        scale.onCharacteristicChanged(Scale::DiFluid::CHARACTERISTIC, pkt);
+        scale.onCharacteristicChanged(Scale::DiFluid::CHARACTERISTIC, pkt.left(18));
+        QCOMPARE(spy.count(), 1);
+    }
+
+    void framedParserThroughput() {
+        // A shot's worth of Acaia weight traffic, split the way some stacks
+        // deliver it: messages straddling notifications
+        QByteArray stream;
+        for (int i = 0; i < 1000; i++) stream += buildAcaiaWeightPacket(i / 10.0);
+        QList<QByteArray> notifications;
+        for (int pos = 0; pos < stream.size(); pos += 20) notifications.append(stream.mid(pos, 20));
+
+        FramedStreamParser<AcaiaFrame> parser;
+        int frames = 0;
+        QBENCHMARK {
+            parser.reset();
+            frames = 0;
+            for (const QByteArray& n : notifications)
+                parser.feed(n, [&frames](const FrameView&) { frames++; });
+        }
+        QCOMPARE(frames, 1000);
+    }
+
     // ==========================================
     // Cross-scale boundary tests
     // ==========================================
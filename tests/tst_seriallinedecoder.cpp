@@ -0,0 +1,151 @@
+#include <QtTest>
+
+#include "usb/seriallinedecoder.h"
+
+// Tests and benchmarks for SerialLineDecoder, the in-place USB-C serial line decoder.
+
+namespace {
+
+struct Decoded {
+    QList<QPair<char, QByteArray>> lines;
+    QStringList malformed;
+};
+
+qsizetype feed(SerialLineDecoder& decoder, const QByteArray& bytes, Decoded& out)
+{
+    return decoder.feed(bytes,
+        [&out](char letter, const QByteArray& payload) { out.lines.append({letter, payload}); },
+        [&out](const char* line, int length) { out.malformed.append(QString::fromLatin1(line, length)); });
+}
+
+// A SHOT_SAMPLE notification as the DE1 sends it over serial (19 bytes)
+const QByteArray kSampleLine = "[M]1A2B0045003C0FA00F00020A0B5C5D01020304\n";
+
+} // namespace
+
+class tst_SerialLineDecoder : public QObject {
+    Q_OBJECT
+
+private slots:
+    void wholeLines()
+    {
+        SerialLineDecoder decoder;
+        Decoded out;
+        QCOMPARE(feed(decoder, "[N]0204\r\n  [E]0480381C00000000\n\n", out), qsizetype(0));
+
+        QCOMPARE(out.lines.size(), 2);
+        QCOMPARE(out.lines[0].first, 'N');
+        QCOMPARE(out.lines[0].second, QByteArray::fromHex("0204"));
+        QCOMPARE(out.lines[1].first, 'E');
+        QCOMPARE(out.lines[1].second, QByteArray::fromHex("0480381C00000000"));
+        QVERIFY(out.malformed.isEmpty());
+        QCOMPARE(decoder.pendingBytes(), 0);
+    }
+
+    void linesSplitAcrossReads()
+    {
+        const QByteArray stream = kSampleLine + "[N]0204\n" + kSampleLine;
+        for (int chunk : {1, 3, 7, 20, 64}) {
+            SerialLineDecoder decoder;
+            Decoded out;
+            for (qsizetype pos = 0; pos < stream.size(); pos += chunk)
+                feed(decoder, stream.mid(pos, chunk), out);
+
+            QCOMPARE(out.lines.size(), 3);
+            QCOMPARE(out.lines[0].second, QByteArray::fromHex(kSampleLine.mid(3).trimmed()));
+            QCOMPARE(out.lines[1].second, QByteArray::fromHex("0204"));
+            QCOMPARE(out.lines[2].second, out.lines[0].second);
+        }
+    }
+
+    void hexMatchesFromHex_data()
+    {
+        QTest::addColumn<QByteArray>("hex");
+        QTest::newRow("empty") << QByteArray();
+        QTest::newRow("mixed case") << QByteArray("aBcDeF09");
+        QTest::newRow("odd length") << QByteArray("abc");
+        QTest::newRow("junk inside") << QByteArray("0g1 2:3");
+    }
+
+    void hexMatchesFromHex()
+    {
+        QFETCH(QByteArray, hex);
+        SerialLineDecoder decoder;
+        Decoded out;
+        feed(decoder, "[K]" + hex + "\n", out);
+        QCOMPARE(out.lines.size(), 1);
+        QCOMPARE(out.lines[0].second, QByteArray::fromHex(hex));
+    }
+
+    void payloadCopiesSurviveLaterLines()
+    {
+        // Callbacks that keep the payload get their own copy
+        SerialLineDecoder decoder;
+        Decoded out;
+        feed(decoder, "[A]1111\n[B]22\n", out);
+        QCOMPARE(out.lines[0].second, QByteArray::fromHex("1111"));
+        QCOMPARE(out.lines[1].second, QByteArray::fromHex("22"));
+    }
+
+    void malformedLinesReported()
+    {
+        SerialLineDecoder decoder;
+        Decoded out;
+        feed(decoder, "hello\n[M\n[MM]00\n", out);
+        QCOMPARE(out.malformed, QStringList({"hello", "[M", "[MM]00"}));
+        QVERIFY(out.lines.isEmpty());
+    }
+
+    void overlongLineDiscarded()
+    {
+        SerialLineDecoder decoder;
+        Decoded out;
+        const QByteArray garbage(SerialLineDecoder::MAX_LINE_LENGTH + 100, 'x');
+        QCOMPARE(feed(decoder, garbage, out), garbage.size());
+        QCOMPARE(feed(decoder, "yyyy\n[N]0204\n", out), qsizetype(4));
+        QCOMPARE(out.lines.size(), 1);
+        QCOMPARE(out.lines[0].first, 'N');
+        QVERIFY(out.malformed.isEmpty());
+
+        // Same when the partial line only overflows on a later read
+        feed(decoder, garbage.left(100), out);
+        QCOMPARE(feed(decoder, garbage + "\n[N]0204\n", out), 100 + garbage.size());
+        QCOMPARE(out.lines.size(), 2);
+    }
+
+    void decodePoll()
+    {
+        SerialLineDecoder decoder;
+        int lines = 0;
+        QBENCHMARK {
+            decoder.feed(kSampleLine,
+                [&lines](char, const QByteArray& payload) { lines += payload.size() > 0; },
+                [](const char*, int) {});
+        }
+        QVERIFY(lines > 0);
+    }
+
+    void decodePoll_qstringBaseline()
+    {
+        // What SerialTransport::processBuffer/processLine used to do per poll
+        QByteArray buffer;
+        int lines = 0;
+        QBENCHMARK {
+            buffer.append(kSampleLine);
+            qsizetype idx;
+            while ((idx = buffer.indexOf('\n')) != -1) {
+                const QString line = QString::fromLatin1(buffer.left(idx)).trimmed();
+                buffer.remove(0, idx + 1);
+                if (line.length() < 3 || line[0] != QLatin1Char('[') || line[2] != QLatin1Char(']'))
+                    continue;
+                const QByteArray payload = QByteArray::fromHex(line.mid(3).toLatin1());
+                lines += payload.size() > 0;
+            }
+        }
+        QVERIFY(lines > 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_SerialLineDecoder)
+
+#include "tst_seriallinedecoder.moc"
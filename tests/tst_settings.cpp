@@ -1,11 +1,13 @@
 #include <QtTest>
 #include <QSignalSpy>
+#include <QJsonObject>
 
 #include "core/settings.h"
 #include "core/settings_brew.h"
 #include "core/settings_dye.h"
 #include "core/settings_theme.h"
 #include "core/settings_visualizer.h"
+#include "core/settingsserializer.h"
 
 // Test Settings property round-trip and signal emission.
 // Settings uses QSettings("DecentEspresso", "DE1Qt") which reads/writes to
@@ -169,6 +171,116 @@ private slots:
         m_settings.dye()->setDyeBeanBrand(origBrand);
     }
 
+    // ==========================================
+    // Transactions (batched change notifications)
+    // ==========================================
+
+    void transactionEmitsOncePerChangedProperty() {
+        QSignalSpy weightSpy(m_settings.brew(), &SettingsBrew::targetWeightChanged);
+        QSignalSpy steamSpy(m_settings.brew(), &SettingsBrew::steamTemperatureChanged);
+        QSignalSpy scaleSpy(&m_settings, &Settings::scaleAddressChanged);
+
+        m_settings.beginTransaction("test");
+        QVERIFY(m_settings.inTransaction());
+        for (int i = 1; i <= 10; ++i)
+            m_settings.brew()->setTargetWeight(m_origTargetWeight + i);
+        m_settings.brew()->setSteamTemperature(m_origSteamTemp + 1);
+        m_settings.brew()->setSteamTemperature(m_origSteamTemp);  // Net no change
+        m_settings.setScaleAddress("AA:BB:CC:DD:EE:FF");
+        QCOMPARE(weightSpy.count(), 0);
+        QCOMPARE(scaleSpy.count(), 0);
+        QCOMPARE(m_settings.brew()->targetWeight(), m_origTargetWeight + 10);  // Reads see writes
+
+        m_settings.commitTransaction();
+        QVERIFY(!m_settings.inTransaction());
+        QCOMPARE(weightSpy.count(), 1);
+        QCOMPARE(steamSpy.count(), 0);
+        QCOMPARE(scaleSpy.count(), m_origScaleAddress == "AA:BB:CC:DD:EE:FF" ? 0 : 1);
+
+        const Settings::TransactionStats stats = m_settings.lastTransactionStats();
+        QCOMPARE(stats.label, QString("test"));
+        QVERIFY(stats.writes >= 12);
+        QVERIFY(stats.notifications < static_cast<int>(stats.writes));
+    }
+
+    void nestedTransactionsEmitAtOutermostCommit() {
+        QSignalSpy spy(m_settings.brew(), &SettingsBrew::targetWeightChanged);
+        {
+            Settings::Transaction outer(&m_settings, "outer");
+            {
+                Settings::Transaction inner(&m_settings, "inner");
+                m_settings.brew()->setTargetWeight(m_origTargetWeight + 3);
+            }
+            QCOMPARE(spy.count(), 0);
+        }
+        QCOMPARE(spy.count(), 1);
+    }
+
+    void transactionRunsCrossDomainReactionsInOrderAndDefersValueChanged() {
+        // defaultShotRating -> setDyeEspressoEnjoyment follows the write, not the commit
+        const int origEnjoyment = m_settings.dye()->dyeEspressoEnjoyment();
+        const int newRating = (m_origShotRating == 42) ? 43 : 42;
+        QSignalSpy valueSpy(&m_settings, &Settings::valueChanged);
+        QSignalSpy ratingSpy(m_settings.visualizer(), &SettingsVisualizer::defaultShotRatingChanged);
+
+        m_settings.beginTransaction();
+        m_settings.visualizer()->setDefaultShotRating(newRating);
+        QCOMPARE(m_settings.dye()->dyeEspressoEnjoyment(), newRating);
+        QCOMPARE(ratingSpy.count(), 0);
+        m_settings.setValue("test/transactionKey", 1);
+        m_settings.setValue("test/transactionKey", 2);
+        QCOMPARE(valueSpy.count(), 0);
+        m_settings.commitTransaction();
+
+        QCOMPARE(ratingSpy.count(), 1);
+        QCOMPARE(m_settings.dye()->dyeEspressoEnjoyment(), newRating);
+        QCOMPARE(valueSpy.count(), 1);
+        QCOMPARE(valueSpy.at(0).at(0).toString(), QString("test/transactionKey"));
+
+        m_settings.dye()->setDyeEspressoEnjoyment(origEnjoyment);
+    }
+
+    void importKeepsRestoredEnjoymentOverDefaultRating() {
+        // importFromJson sets the default rating before the dye block, in one
+        // transaction; the reaction to the rating must not clobber the
+        // enjoyment restored after it
+        const int origEnjoyment = m_settings.dye()->dyeEspressoEnjoyment();
+        const int rating = (m_origShotRating == 60) ? 61 : 60;
+        const int enjoyment = (origEnjoyment == 85) ? 86 : 85;
+
+        QJsonObject visualizer;
+        visualizer["defaultShotRating"] = rating;
+        QJsonObject dye;
+        dye["espressoEnjoyment"] = enjoyment;
+        QJsonObject json;
+        json["visualizer"] = visualizer;
+        json["dye"] = dye;
+        QVERIFY(SettingsSerializer::importFromJson(&m_settings, json));
+
+        QCOMPARE(m_settings.visualizer()->defaultShotRating(), rating);
+        QCOMPARE(m_settings.dye()->dyeEspressoEnjoyment(), enjoyment);
+
+        m_settings.dye()->setDyeEspressoEnjoyment(origEnjoyment);
+    }
+
+    void transactionPublishesOneSnapshotAtCommit() {
+        const auto before = m_settings.snapshot();
+        const double newWeight = (m_origTargetWeight == 36.0) ? 40.0 : 36.0;
+        const QString newBrand = (m_origDyeBeanBrand == "Snapshot Roasters") ? "Other Roasters" : "Snapshot Roasters";
+
+        m_settings.beginTransaction();
+        m_settings.brew()->setTargetWeight(newWeight);
+        m_settings.dye()->setDyeBeanBrand(newBrand);
+        QCOMPARE(m_settings.snapshot(), before);  // Nothing half-applied is published
+        m_settings.commitTransaction();
+
+        const auto after = m_settings.snapshot();
+        QVERIFY(after != before);
+        QVERIFY(after->revision() > before->revision());
+        QCOMPARE(after->get<QString>("dye/beanBrand"), newBrand);
+        QCOMPARE(before->get<QString>("dye/beanBrand"), m_origDyeBeanBrand);
+    }
+
     // ==========================================
     // Edge cases
     // ==========================================
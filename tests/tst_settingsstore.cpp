@@ -0,0 +1,231 @@
+#include <QtTest>
+#include <QSettings>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <thread>
+
+#include "core/settingsstore.h"
+
+// Tests for SettingsStore: in-memory reads and writes, debounced flushes to the
+// settings file, and published snapshots.
+
+class tst_SettingsStore : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    QString iniPath() const { return m_dir.filePath("settings.ini"); }
+
+private slots:
+    void init()
+    {
+        QFile::remove(iniPath());
+    }
+
+    void writesAreDebounced()
+    {
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+        store.setFlushDelay(50);
+
+        store.setValue("brew/targetWeight", 36.0);
+        QCOMPARE(store.value("brew/targetWeight").toDouble(), 36.0);
+        QVERIFY(store.contains("brew/targetWeight"));
+        QVERIFY(store.hasPendingWrites());
+        QVERIFY(!QSettings(iniPath(), QSettings::IniFormat).contains("brew/targetWeight"));
+
+        QTRY_COMPARE(store.batchesWritten(), 1);
+        QVERIFY(!store.hasPendingWrites());
+        QCOMPARE(QSettings(iniPath(), QSettings::IniFormat).value("brew/targetWeight").toDouble(), 36.0);
+    }
+
+    void burstIsOneBatch()
+    {
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+        store.setFlushDelay(100);
+
+        // A slider drag: hundreds of writes to a few keys
+        for (int i = 0; i <= 300; ++i) {
+            store.setValue("brew/steamTemperature", 130 + i % 30);
+            store.setValue("theme/fontScale", 1.0 + i / 1000.0);
+        }
+        QTRY_COMPARE(store.batchesWritten(), 1);
+        QTest::qWait(150);
+        QCOMPARE(store.batchesWritten(), 1);
+
+        QSettings onDisk(iniPath(), QSettings::IniFormat);
+        QCOMPARE(onDisk.value("brew/steamTemperature").toInt(), 130);
+        QCOMPARE(onDisk.value("theme/fontScale").toDouble(), 1.3);
+
+        // Same value again: nothing to write
+        store.setValue("brew/steamTemperature", 130);
+        QVERIFY(!store.hasPendingWrites());
+    }
+
+    void removeAndClear()
+    {
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+        store.setValue("knownScales/scales/size", 2);
+        store.setValue("knownScales/scales/1/address", "AA");
+        store.setValue("knownScales/scalesExtra", "kept");
+        store.setValue("mqtt/host", "broker");
+        store.sync();
+
+        // Group removal, then a write back into the group
+        store.remove("knownScales/scales");
+        QVERIFY(!store.contains("knownScales/scales/size"));
+        QVERIFY(store.contains("knownScales/scalesExtra"));
+        store.setValue("knownScales/scales/size", 0);
+
+        // Write then remove: the write never lands
+        store.setValue("mqtt/port", 1883);
+        store.remove("mqtt");
+        QVERIFY(!store.contains("mqtt/host"));
+        store.sync();
+
+        QSettings onDisk(iniPath(), QSettings::IniFormat);
+        QCOMPARE(onDisk.allKeys(), QStringList({"knownScales/scales/size", "knownScales/scalesExtra"}));
+        QCOMPARE(store.allKeys(), onDisk.allKeys());
+
+        store.clear();
+        store.setValue("device/uuid", "abc");
+        QCOMPARE(store.allKeys(), QStringList({"device/uuid"}));
+        store.sync();
+        QCOMPARE(QSettings(iniPath(), QSettings::IniFormat).allKeys(), QStringList({"device/uuid"}));
+    }
+
+    void syncAndDestructionPersist()
+    {
+        {
+            SettingsStore store(iniPath(), QSettings::IniFormat);
+            store.setValue("ai/provider", "openai");
+            store.setValue("brew/ratio", 2.0);
+            store.sync();
+            QVERIFY(!store.hasPendingWrites());
+            QCOMPARE(QSettings(iniPath(), QSettings::IniFormat).value("ai/provider").toString(), QString("openai"));
+
+            store.setValue("ai/provider", "anthropic");  // Left pending for the destructor
+        }
+
+        SettingsStore reopened(iniPath(), QSettings::IniFormat);
+        QCOMPARE(reopened.value("ai/provider").toString(), QString("anthropic"));
+        QCOMPARE(reopened.value("brew/ratio").toDouble(), 2.0);
+        QCOMPARE(reopened.value("missing", 7).toInt(), 7);
+    }
+
+    void otherWritersKeepTheirKeys()
+    {
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+
+        // A tracker with its own QSettings on the same file
+        QSettings tracker(iniPath(), QSettings::IniFormat);
+        tracker.setValue("steamHealth/sessions", 12);
+        tracker.sync();
+
+        store.setValue("brew/targetWeight", 40.0);
+        store.sync();
+
+        QSettings onDisk(iniPath(), QSettings::IniFormat);
+        QCOMPARE(onDisk.value("steamHealth/sessions").toInt(), 12);
+        QCOMPARE(onDisk.value("brew/targetWeight").toDouble(), 40.0);
+    }
+
+    void snapshotsAreImmutable()
+    {
+        {
+            QSettings seed(iniPath(), QSettings::IniFormat);
+            seed.setValue("brew/ratio", 2.0);
+            seed.setValue("mqtt/enabled", true);
+        }
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+
+        const auto loaded = store.snapshot();
+        QCOMPARE(loaded->get<double>("brew/ratio"), 2.0);  // "2" in the INI file
+        QCOMPARE(loaded->get<bool>("mqtt/enabled"), true);
+        QCOMPARE(loaded->get<double>("dye/beanWeight", 18.0), 18.0);
+
+        store.setValue("brew/ratio", 2.5);
+        store.remove("mqtt");
+        const auto changed = store.snapshot();
+        QVERIFY(changed->revision() > loaded->revision());
+        QCOMPARE(changed->get<double>("brew/ratio"), 2.5);
+        QVERIFY(!changed->contains("mqtt/enabled"));
+        QCOMPARE(loaded->get<double>("brew/ratio"), 2.0);
+        QVERIFY(loaded->contains("mqtt/enabled"));
+
+        // No change, no new snapshot
+        store.setValue("brew/ratio", 2.5);
+        QCOMPARE(store.snapshot(), changed);
+
+        store.holdSnapshots();
+        store.setValue("theme/primary", "#112233");
+        store.setValue("theme/accent", "#445566");
+        QCOMPARE(store.snapshot(), changed);
+        store.releaseSnapshots();
+        QCOMPARE(store.snapshot()->revision(), changed->revision() + 1);
+        QCOMPARE(store.snapshot()->get<QString>("theme/accent"), QString("#445566"));
+    }
+
+    void writeBurstPublishesOnce()
+    {
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+        const auto before = store.snapshot();
+        const auto fromOtherThread = [&store] {
+            std::shared_ptr<const SettingsSnapshot> snapshot;
+            std::thread([&] { snapshot = store.snapshot(); }).join();
+            return snapshot;
+        };
+
+        for (int i = 1; i <= 100; ++i)
+            store.setValue("brew/steamTemperature", i);
+        QCOMPARE(fromOtherThread(), before);  // Not until the event loop turns
+
+        QTRY_VERIFY(fromOtherThread() != before);
+        const auto published = fromOtherThread();
+        QCOMPARE(published->revision(), before->revision() + 1);
+        QCOMPARE(published->get<int>("brew/steamTemperature"), 100);
+
+        // On the store's thread, snapshot() never returns stale settings
+        store.setValue("brew/steamTemperature", 101);
+        QCOMPARE(store.snapshot()->get<int>("brew/steamTemperature"), 101);
+        QCOMPARE(store.snapshot()->revision(), published->revision() + 1);
+        QCoreApplication::processEvents();
+        QCOMPARE(fromOtherThread()->revision(), published->revision() + 1);
+    }
+
+    void snapshotReadsFromAnotherThread()
+    {
+        SettingsStore store(iniPath(), QSettings::IniFormat);
+        store.setValue("brew/steamTemperature", 0);
+
+        // A reader thread must see every counter value in order, never a torn map
+        std::atomic<bool> done{false};
+        std::atomic<bool> ordered{true};
+        std::thread reader([&] {
+            int last = -1;
+            while (!done.load()) {
+                const auto snapshot = store.snapshot();
+                const int value = snapshot->get<int>("brew/steamTemperature");
+                if (value < last || snapshot->get<int>("brew/steamTemperatureCopy", value) != value)
+                    ordered = false;
+                last = value;
+            }
+        });
+        for (int i = 1; i <= 2000; ++i) {
+            store.holdSnapshots();
+            store.setValue("brew/steamTemperature", i);
+            store.setValue("brew/steamTemperatureCopy", i);
+            store.releaseSnapshots();
+        }
+        done = true;
+        reader.join();
+
+        QVERIFY(ordered.load());
+        QCOMPARE(store.snapshot()->get<int>("brew/steamTemperature"), 2000);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_SettingsStore)
+
+#include "tst_settingsstore.moc"
@@ -4,6 +4,7 @@
 #include <QStringList>
 
 #include "models/shotdatamodel.h"
+#include "history/shotsnapshot.h"
 #include "controllers/shottimingcontroller.h"
 #include "ble/de1device.h"
 #include "mocks/MockScaleDevice.h"
@@ -101,6 +102,51 @@ private slots:
         }
     }
 
+    // ===== Post-shot snapshot hand-off =====
+
+    void snapshotTrimLeavesModelUntouchedUntilApplied() {
+        ShotDataModel model;
+        populateWithSettlingData(model, 50, 10);
+
+        ShotSnapshot processed = model.snapshot();
+        QVERIFY(processed.trimSettlingData());
+        QCOMPARE(processed.pressure.size(), 50);
+        // Worker-side processing must not leak into the live model
+        QCOMPARE(model.pressureData().size(), 60);
+
+        QVERIFY(model.applyProcessedSnapshot(processed));
+        QCOMPARE(model.pressureData().size(), 50);
+        QCOMPARE(model.flowData().size(), 50);
+    }
+
+    void applyRejectsSnapshotFromPreviousShot() {
+        ShotDataModel model;
+        populateWithSettlingData(model, 50, 10);
+        ShotSnapshot processed = model.snapshot();
+        processed.trimSettlingData();
+
+        // A new shot starts before the pipeline hands the series back
+        model.clear();
+        model.addSample(0.0, 2.0, 1.0, 93.0, 88.0, 2.0, 0.0, 93.0);
+
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Dropping processed snapshot from a previous shot"));
+        QVERIFY(!model.applyProcessedSnapshot(processed));
+        QCOMPARE(model.pressureData().size(), 1);
+    }
+
+    void snapshotCarriesPhaseMarkers() {
+        ShotDataModel model;
+        populateWithSettlingData(model, 10, 0);
+        model.addPhaseMarker(0.4, "Pour", 1, true, "pressure");
+
+        const ShotSnapshot snap = model.snapshot();
+        QCOMPARE(snap.phases.size(), 1);
+        QCOMPARE(snap.phases.first().label, QStringLiteral("Pour"));
+        QCOMPARE(snap.phases.first().frameNumber, 1);
+        QVERIFY(snap.phases.first().isFlowMode);
+        QCOMPARE(snap.phases.first().transitionReason, QStringLiteral("pressure"));
+    }
+
     // ===== ShotTimingController m_sawSettling flag =====
 
     void settlingFlagInitiallyFalse() {
@@ -1,6 +1,7 @@
 #include <QtTest>
 
 #include "ai/shotanalysis.h"
+#include "ai/liveshotanalysis.h"
 #include "history/shothistorystorage.h"
 #include "history/shotbadgeprojection.h"
 
@@ -69,6 +70,87 @@ private:
                  expected);
     }
 
+    // Synthetic shot fed to LiveShotAnalysis one sample at a time, the way
+    // MainController does: markers whose time has been reached go in before
+    // the sample, goals <= 0 mean "no goal". The End marker is delivered
+    // `endLagSec` after the stop time, as WeightProcessor::stopNow lands
+    // asynchronously.
+    struct LiveShot {
+        QVector<QPointF> pressure;
+        QVector<QPointF> flow;
+        QVector<double> pressureGoal;   // per sample, 0 = none
+        QVector<double> flowGoal;       // per sample, 0 = none
+        QList<HistoryPhaseMarker> phases;
+        double stopTime = -1.0;
+        double endLagSec = 0.4;
+        QString beverageType = QStringLiteral("espresso");
+        QStringList analysisFlags;
+    };
+
+    static void appendSample(LiveShot& shot, double t, double pressure, double flow,
+                             double pressureGoal, double flowGoal)
+    {
+        shot.pressure.append(QPointF(t, pressure));
+        shot.flow.append(QPointF(t, flow));
+        shot.pressureGoal.append(pressureGoal);
+        shot.flowGoal.append(flowGoal);
+    }
+
+    static void feedLive(LiveShotAnalysis& live, const LiveShot& shot)
+    {
+        qsizetype nextPhase = 0;
+        bool endSent = shot.stopTime < 0;
+        live.begin(shot.beverageType, shot.analysisFlags);
+        for (qsizetype i = 0; i < shot.pressure.size(); ++i) {
+            const double t = shot.pressure[i].x();
+            while (nextPhase < shot.phases.size() && shot.phases[nextPhase].time <= t + 1e-9)
+                live.addPhaseMarker(shot.phases[nextPhase++]);
+            if (!endSent && t >= shot.stopTime + shot.endLagSec - 1e-9) {
+                live.addPhaseMarker(phase(shot.stopTime, QStringLiteral("End"), -1));
+                endSent = true;
+            }
+            live.addSample(t, shot.pressure[i].y(), shot.flow[i].y(),
+                           shot.pressureGoal[i], shot.flowGoal[i]);
+        }
+    }
+
+    // 5 Hz espresso shot: 2 s preheat, flow-mode preinfusion from 2 s,
+    // pressure-mode pour from 8 s, stop at 30 s, two seconds of drip
+    // samples after. `shape` picks the puck behaviour in the pour.
+    enum class PourShape { Channel, Choked, Flat };
+    static LiveShot syntheticShot(PourShape shape)
+    {
+        LiveShot shot;
+        shot.phases = {
+            phase(2.0, QStringLiteral("Start"), 0),
+            phase(2.0, QStringLiteral("Preinfusion"), 0, /*isFlowMode=*/true),
+            phase(8.0, QStringLiteral("Pour"), 1, false, QStringLiteral("pressure")),
+        };
+        shot.stopTime = 30.0;
+        for (int i = 0; i <= 160; ++i) {
+            const double t = i * 0.2;
+            const double wobble = 0.03 * std::sin(t * 2.3);
+            if (t < 2.0) {
+                appendSample(shot, t, 0.0, 0.0, 0.0, 0.0);
+            } else if (t < 8.0) {
+                const double p = shape == PourShape::Flat ? 1.0 : 0.4 + (t - 2.0) * 0.5;
+                appendSample(shot, t, p + wobble, 4.0 + wobble, 0.0, 4.0);
+            } else if (t <= 32.0) {
+                double p = shape == PourShape::Flat ? 1.2 : std::min(9.0, 3.4 + (t - 8.0) * 2.0);
+                double f = 2.0;
+                if (shape == PourShape::Choked) f = 0.3;
+                if (shape == PourShape::Flat) f = 5.0;
+                if (shape == PourShape::Channel && t >= 15.0 && t < 16.6) {
+                    f = 3.6;    // flow surge under a small pressure dip
+                    p -= 0.5;
+                }
+                if (t > 30.0) { p *= 0.5; f *= 0.5; }
+                appendSample(shot, t, p + wobble, f + wobble, 9.0, 0.0);
+            }
+        }
+        return shot;
+    }
+
 private slots:
     void skipFirstFrameDetection()
     {
@@ -2042,6 +2124,67 @@ private slots:
         QVERIFY(t.grindIssueDetected);
         QVERIFY(t.skipFirstFrameDetected);
     }
+
+    // ---- LiveShotAnalysis: streaming detectors fire while the shot runs ----
+
+    void liveAnalysis_channelingShot_firesMidShot()
+    {
+        // Within a couple of seconds of the surge, well before the stop.
+        LiveShotAnalysis live;
+        QSignalSpy spy(&live, &LiveShotAnalysis::channelingDetected);
+        LiveShot shot = syntheticShot(PourShape::Channel);
+        shot.stopTime = -1.0;
+        while (!shot.pressure.isEmpty() && shot.pressure.last().x() > 19.0) {
+            shot.pressure.removeLast();
+            shot.flow.removeLast();
+            shot.pressureGoal.removeLast();
+            shot.flowGoal.removeLast();
+        }
+        feedLive(live, shot);
+        QVERIFY(spy.count() >= 1);
+        QVERIFY(live.isActive());
+        QVERIFY(live.channelingSeverity() != QStringLiteral("none"));
+        QVERIFY(live.channelingSpikeTime() >= 14.0 && live.channelingSpikeTime() <= 17.5);
+    }
+
+    void liveAnalysis_chokedPuck_firesMidShot()
+    {
+        LiveShotAnalysis live;
+        QSignalSpy spy(&live, &LiveShotAnalysis::grindIssueDetected);
+        feedLive(live, syntheticShot(PourShape::Choked));
+        QVERIFY(spy.count() >= 1);
+        QCOMPARE(spy.first().at(0).toString(), QStringLiteral("chokedPuck"));
+    }
+
+    void liveAnalysis_pourNotPressurizing_firesOnce()
+    {
+        LiveShotAnalysis live;
+        QSignalSpy spy(&live, &LiveShotAnalysis::pourNotPressurizingDetected);
+        feedLive(live, syntheticShot(PourShape::Flat));
+        QCOMPARE(spy.count(), 1);
+        QVERIFY(live.pourNotPressurizing());
+    }
+
+    void liveAnalysis_nonEspresso_staysQuiet()
+    {
+        LiveShot shot = syntheticShot(PourShape::Channel);
+        shot.beverageType = QStringLiteral("filter");
+        LiveShotAnalysis live;
+        QSignalSpy spy(&live, &LiveShotAnalysis::channelingDetected);
+        feedLive(live, shot);
+        QCOMPARE(spy.count(), 0);
+    }
+
+    void liveAnalysis_end_deactivates()
+    {
+        LiveShotAnalysis live;
+        QSignalSpy spy(&live, &LiveShotAnalysis::activeChanged);
+        feedLive(live, syntheticShot(PourShape::Channel));
+        QVERIFY(live.isActive());
+        live.end();
+        QVERIFY(!live.isActive());
+        QCOMPARE(spy.count(), 2);
+    }
 };
 
 QTEST_MAIN(tst_ShotAnalysis)
@@ -0,0 +1,105 @@
+#include <QtTest>
+
+#include "history/shotrecordcache.h"
+
+// Tests for ShotRecordCache, the decoded-shot LRU: shared hits, byte-budget
+// eviction, stale loads after invalidation, and hit/miss counters.
+
+namespace {
+
+std::shared_ptr<const ShotRecord> makeRecord(qint64 id, int samples = 100)
+{
+    auto record = std::make_shared<ShotRecord>();
+    record->summary.id = id;
+    for (int i = 0; i < samples; ++i) {
+        record->pressure.append(QPointF(i * 0.1, 9.0));
+        record->flow.append(QPointF(i * 0.1, 2.0));
+    }
+    return record;
+}
+
+} // namespace
+
+class tst_ShotRecordLru : public QObject {
+    Q_OBJECT
+
+private slots:
+    void insertedRecord_isSharedOnFind()
+    {
+        ShotRecordCache cache;
+        auto record = makeRecord(1);
+        cache.insert(cache.revision(1), record);
+
+        QVERIFY(cache.contains(1));
+        QCOMPARE(cache.find(1).get(), record.get());
+        QVERIFY(!cache.find(2));
+    }
+
+    void budget_evictsLeastRecentlyUsed()
+    {
+        const qsizetype cost = ShotRecordCache::estimateCost(*makeRecord(1));
+        ShotRecordCache cache(cost * 2);
+
+        cache.insert(cache.revision(1), makeRecord(1));
+        cache.insert(cache.revision(2), makeRecord(2));
+        QVERIFY(cache.find(1));  // 2 is now the least recently used
+
+        cache.insert(cache.revision(3), makeRecord(3));
+        QVERIFY(cache.contains(1));
+        QVERIFY(!cache.contains(2));
+        QVERIFY(cache.contains(3));
+    }
+
+    void staleRevision_isDropped()
+    {
+        ShotRecordCache cache;
+        const quint64 revision1 = cache.revision(1);
+        const quint64 revision2 = cache.revision(2);
+        cache.invalidate(1);  // A write to shot 1 lands while both loads are reading
+
+        cache.insert(revision1, makeRecord(1));
+        QVERIFY(!cache.contains(1));
+        cache.insert(revision2, makeRecord(2));
+        QVERIFY(cache.contains(2));
+
+        cache.insert(cache.revision(1), makeRecord(1));
+        QVERIFY(cache.contains(1));
+
+        const quint64 beforeAll = cache.revision(3);
+        cache.invalidateAll();
+        QVERIFY(!cache.contains(1));
+        QVERIFY(!cache.contains(2));
+        cache.insert(beforeAll, makeRecord(3));
+        QVERIFY(!cache.contains(3));
+        QCOMPARE(cache.stats().staleDrops, quint64(2));
+    }
+
+    void stats_countLookups()
+    {
+        ShotRecordCache cache;
+        QVERIFY(!cache.find(1));
+        cache.insert(cache.revision(1), makeRecord(1));
+        QVERIFY(cache.find(1));
+        QVERIFY(cache.find(1));
+        QVERIFY(cache.contains(1));  // Not a lookup
+
+        const ShotRecordCache::Stats stats = cache.stats();
+        QCOMPARE(stats.hits, quint64(2));
+        QCOMPARE(stats.misses, quint64(1));
+        QCOMPARE(stats.inserts, quint64(1));
+        QCOMPARE(stats.entries, qsizetype(1));
+        QCOMPARE(stats.costBytes, ShotRecordCache::estimateCost(*makeRecord(1)));
+        QCOMPARE(stats.budgetBytes, ShotRecordCache::DEFAULT_BUDGET_BYTES);
+    }
+
+    void failedLoad_isNotCached()
+    {
+        ShotRecordCache cache;
+        cache.insert(cache.revision(0), makeRecord(0));
+        QVERIFY(!cache.contains(0));
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_ShotRecordLru)
+
+#include "tst_shotrecordlru.moc"
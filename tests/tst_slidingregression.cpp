@@ -0,0 +1,220 @@
+#include <QtTest>
+#include <QRandomGenerator>
+
+#include "machine/slidingregression.h"
+
+// Tests and benchmarks for WeightRing and WindowFit, the sliding least-squares
+// flow rate behind WeightProcessor, checked against a from-scratch regression.
+
+namespace {
+
+struct Reference {
+    int count = 0;
+    qint64 spanMs = 0;
+    double slope = 0;
+};
+
+// Least squares over the readings within windowMs of the last one, summed
+// two-pass from scratch — what WindowFit must agree with
+Reference referenceFit(const QList<WeightSample>& samples, int windowMs)
+{
+    Reference r;
+    if (samples.isEmpty()) return r;
+    const qint64 cutoff = samples.last().timestamp - windowMs;
+    qsizetype start = samples.size() - 1;
+    while (start > 0 && samples[start - 1].timestamp >= cutoff) --start;
+
+    r.count = static_cast<int>(samples.size() - start);
+    r.spanMs = samples.last().timestamp - samples[start].timestamp;
+    if (r.count < 2) return r;
+
+    const qint64 t0 = samples[start].timestamp;
+    double meanT = 0, meanW = 0;
+    for (qsizetype i = start; i < samples.size(); ++i) {
+        meanT += (samples[i].timestamp - t0) / 1000.0;
+        meanW += samples[i].weight;
+    }
+    meanT /= r.count;
+    meanW /= r.count;
+    double ctt = 0, ctw = 0;
+    for (qsizetype i = start; i < samples.size(); ++i) {
+        const double t = (samples[i].timestamp - t0) / 1000.0 - meanT;
+        ctt += t * t;
+        ctw += t * (samples[i].weight - meanW);
+    }
+    r.slope = (r.count * ctt > 1e-12) ? ctw / ctt : 0.0;
+    return r;
+}
+
+void trim(QList<WeightSample>& samples, qint64 maxAgeMs)
+{
+    while (!samples.isEmpty() && samples.last().timestamp - samples.first().timestamp > maxAgeMs)
+        samples.removeFirst();
+}
+
+} // namespace
+
+class tst_SlidingRegression : public QObject {
+    Q_OBJECT
+
+private slots:
+    void ringKeepsTrailingSecond()
+    {
+        WeightRing ring;
+        QVERIFY(ring.isEmpty());
+        for (int i = 0; i < 20; ++i)
+            ring.append(i * 100, i, 1000);
+
+        // 900..1900 ms: readings 9 to 19 (exactly 1000 ms apart is kept)
+        QCOMPARE(ring.size(), 11);
+        QCOMPARE(ring.at(0).timestamp, qint64(900));
+        QCOMPARE(ring.last().weight, 19.0);
+        QCOMPARE(ring.endSeq() - ring.beginSeq(), quint64(11));
+
+        ring.clear();
+        QVERIFY(ring.isEmpty());
+        QCOMPARE(ring.beginSeq(), quint64(20));
+    }
+
+    void ringCapsAtCapacity()
+    {
+        // Faster than CAPACITY readings per second: oldest go first
+        WeightRing ring;
+        for (int i = 0; i < 3 * WeightRing::CAPACITY; ++i)
+            ring.append(i, i, 1000);
+        QCOMPARE(ring.size(), WeightRing::CAPACITY);
+        QCOMPARE(ring.at(0).weight, double(2 * WeightRing::CAPACITY));
+    }
+
+    void matchesReferenceFit_data()
+    {
+        QTest::addColumn<int>("meanIntervalMs");
+        QTest::addColumn<int>("jitterMs");
+        QTest::newRow("Decent 5Hz") << 200 << 40;
+        QTest::newRow("Bookoo 2Hz") << 500 << 80;
+        QTest::newRow("Acaia 10Hz") << 100 << 30;
+        QTest::newRow("batched (repeated stamps)") << 60 << 60;
+        QTest::newRow("over capacity") << 5 << 5;
+    }
+
+    void matchesReferenceFit()
+    {
+        QFETCH(int, meanIntervalMs);
+        QFETCH(int, jitterMs);
+
+        QRandomGenerator rng(42);
+        WeightRing ring;
+        WindowFit longFit, shortFit;
+        QList<WeightSample> reference;
+        qint64 t = 1'700'000'000'000;  // Epoch-sized stamps, as the de-jitter produces
+        double weight = 0;
+
+        for (int i = 0; i < 5000; ++i) {
+            const int lo = qMax(0, meanIntervalMs - jitterMs);
+            t += lo + static_cast<int>(rng.bounded(meanIntervalMs + jitterMs - lo + 1));
+            weight += 0.4 + (rng.generateDouble() - 0.5) * 0.3;
+
+            if (i % 700 == 699) {  // Tare / oscillation recovery
+                ring.clear();
+                reference.clear();
+                weight = 0;
+            }
+
+            ring.append(t, weight, 1000);
+            reference.append({t, weight});
+            trim(reference, 1000);
+            while (reference.size() > WeightRing::CAPACITY) reference.removeFirst();
+            QCOMPARE(ring.size(), int(reference.size()));
+
+            // Adaptive short window as WeightProcessor computes it
+            int shortWindowMs = 500;
+            if (ring.size() >= 3)
+                shortWindowMs = qBound(500, int(ring.last().timestamp - ring.at(ring.size() - 3).timestamp) + 50, 1000);
+
+            longFit.update(ring, 1000);
+            shortFit.update(ring, shortWindowMs);
+
+            for (auto [fit, windowMs] : {std::pair{&longFit, 1000}, std::pair{&shortFit, shortWindowMs}}) {
+                const Reference expected = referenceFit(reference, windowMs);
+                QCOMPARE(fit->count(), expected.count);
+                QCOMPARE(fit->spanMs(), expected.spanMs);
+                if (qAbs(fit->slope() - expected.slope) > 1e-6 * qMax(1.0, qAbs(expected.slope)))
+                    QFAIL(qPrintable(QStringLiteral("reading %1: slope %2, expected %3")
+                                         .arg(i).arg(fit->slope(), 0, 'g', 12).arg(expected.slope, 0, 'g', 12)));
+            }
+        }
+    }
+
+    void windowGrowsBack()
+    {
+        // Shrinking then lengthening the window takes back readings still in the ring
+        WeightRing ring;
+        WindowFit fit;
+        for (int i = 0; i < 10; ++i) ring.append(i * 100, i * 0.2, 1000);
+        fit.update(ring, 300);
+        QCOMPARE(fit.count(), 4);
+        fit.update(ring, 1000);
+        QCOMPARE(fit.count(), 10);
+        QCOMPARE(fit.spanMs(), qint64(900));
+        QVERIFY(qAbs(fit.slope() - 2.0) < 1e-9);
+    }
+
+    void degenerateWindows()
+    {
+        WeightRing ring;
+        WindowFit fit;
+        fit.update(ring, 1000);
+        QCOMPARE(fit.slope(), 0.0);
+
+        ring.append(1000, 5.0, 1000);
+        fit.update(ring, 1000);
+        QCOMPARE(fit.count(), 1);
+        QCOMPARE(fit.slope(), 0.0);
+
+        // Same timestamp (uncalibrated batched readings)
+        ring.append(1000, 6.0, 1000);
+        fit.update(ring, 1000);
+        QCOMPARE(fit.count(), 2);
+        QCOMPARE(fit.slope(), 0.0);
+
+        ring.clear();
+        fit.update(ring, 1000);
+        QCOMPARE(fit.count(), 0);
+        QCOMPARE(fit.spanMs(), qint64(0));
+    }
+
+    void perReading()
+    {
+        WeightRing ring;
+        WindowFit longFit, shortFit;
+        qint64 t = 0;
+        double sum = 0;
+        QBENCHMARK {
+            t += 100;
+            ring.append(t, t * 0.002, 1000);
+            longFit.update(ring, 1000);
+            shortFit.update(ring, 500);
+            sum += longFit.slope() + shortFit.slope();
+        }
+        QVERIFY(sum >= 0);
+    }
+
+    void perReading_rescanBaseline()
+    {
+        // What computeLSLR did: re-sum each window over a QList every reading
+        QList<WeightSample> samples;
+        qint64 t = 0;
+        double sum = 0;
+        QBENCHMARK {
+            t += 100;
+            samples.append({t, t * 0.002});
+            trim(samples, 1000);
+            sum += referenceFit(samples, 1000).slope + referenceFit(samples, 500).slope;
+        }
+        QVERIFY(sum >= 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(tst_SlidingRegression)
+
+#include "tst_slidingregression.moc"
@@ -91,6 +91,49 @@ private slots:
                  qPrintable(QString("Rising 2g/s should give ~2.0 flow, got %1").arg(flowRate)));
     }
 
+    void arrivalStampsSurviveBurstDelivery() {
+        // A busy main thread hands the worker a whole second of readings at
+        // once. The transport's arrival stamps keep them 200ms apart, so LSLR
+        // sees the real flow even before the de-jitter has calibrated.
+        WeightProcessor wp;
+        installFakeClock(wp);
+        QSignalSpy spy(&wp, &WeightProcessor::flowRatesReady);
+
+        const qint64 firstArrival = m_fakeClock;
+        for (int i = 0; i < 8; i++)
+            wp.processWeight(2.0 * (i * 0.2), firstArrival + i * 200);
+        // m_fakeClock never advanced: processing time is identical for all
+
+        QCOMPARE(spy.count(), 8);
+        double flowRate = spy.last().at(1).toDouble();
+        QVERIFY2(flowRate > 1.5 && flowRate < 2.5,
+                 qPrintable(QString("Stamped 2g/s burst should give ~2.0 flow, got %1").arg(flowRate)));
+    }
+
+    void ingestAndMainCopiesProcessedOnce() {
+        // A decoded scale hands each reading over twice: from the ingest thread,
+        // then again from the main thread's weightChanged. Late copies and
+        // anything older than what was already taken are dropped.
+        WeightProcessor wp;
+        installFakeClock(wp);
+        QSignalSpy spy(&wp, &WeightProcessor::flowRatesReady);
+
+        const qint64 t0 = m_fakeClock;
+        wp.processWeight(1.0, t0);
+        wp.processWeight(1.4, t0 + 200);
+        wp.processWeight(1.0, t0);          // Main-thread copy of the first
+        wp.processWeight(1.4, t0 + 200);    // ...and of the second
+        QCOMPARE(spy.count(), 2);
+
+        // A different reading stamped in the same millisecond is still new
+        wp.processWeight(1.5, t0 + 200);
+        QCOMPARE(spy.count(), 3);
+
+        // Unstamped readings are never treated as repeats
+        wp.processWeight(1.5);
+        QCOMPARE(spy.count(), 4);
+    }
+
     void negativeWeightClampedToZero() {
         WeightProcessor wp;
         installFakeClock(wp);
@@ -29,21 +29,40 @@
 //
 // Tuning flags override OLD's defaults so a parameter sweep can compare
 // {sigma, recency} configurations against the baseline OLD on the same corpus.
+//
+// Sweep mode runs that comparison over a whole parameter space in one process:
+//   ./saw_replay --corpus PATH --sweep {grid,random} [--samples N] [--seed N]
+//                [--jobs N] [--out results.{json,csv}] [--top N]
+//                --variant old,lowess --mode legacy,warmup
+//                --sigma 0.1:3.0:0.05 --recency-max 5,10,15 ...
+// --variant/--mode take comma lists; each numeric flag takes a value, a comma
+// list, or an inclusive lo:hi:step range. Grid walks the full product; random
+// draws --samples configurations (uniform within ranges, seeded). The corpus is
+// parsed once and shared read-only by all worker threads; results are ranked by
+// the candidate's overall MAE with per-flow-bucket MAE alongside, and the
+// production defaults are replayed once as the baseline.
 
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QRandomGenerator>
 #include <QString>
 #include <QTextStream>
+#include <QThread>
 #include <QVector>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -455,6 +474,292 @@ QVector<Entry> entriesForVariant(const QString& pairKey, const QString& scale,
     return buildBootstrapPool(pairStates, legacyGlobalPool, scale);
 }
 
+// --- Replay ---------------------------------------------------------------
+struct ReplayConfig {
+    QString variant = QStringLiteral("old");
+    QString mode = QStringLiteral("legacy");
+    Tuning tuning;
+    int warmupThreshold = 2;
+};
+
+struct Bucket {
+    double oldAbsSum = 0, newAbsSum = 0;
+    double oldWorst = 0, newWorst = 0;
+    int n = 0;
+
+    void add(double oldAbs, double newAbs) {
+        oldAbsSum += oldAbs;
+        newAbsSum += newAbs;
+        oldWorst = std::max(oldWorst, oldAbs);
+        newWorst = std::max(newWorst, newAbs);
+        n += 1;
+    }
+    double oldMae() const { return n ? oldAbsSum / n : 0.0; }
+    double newMae() const { return n ? newAbsSum / n : 0.0; }
+};
+
+struct ReplayResult {
+    Bucket overall, low, mid, high;
+    QHash<QString, Bucket> withinPair;  // shot1 / shots2-5 / shots6-10 / shots11+
+    QHash<QString, Bucket> bySource;    // perPair / pendingBatch / globalBootstrap / scaleDefault
+    int clampHits = 0;
+    int newBeatsOld = 0;
+};
+
+// Runs the whole corpus through OLD and the configured variant. Touches
+// nothing but its own state and the (read-only) shots, so sweep workers can
+// call it concurrently on one shared corpus. perShot, if set, gets one
+// tab-separated row per shot.
+ReplayResult replay(const QVector<Shot>& shots, const ReplayConfig& cfg, QTextStream* perShot) {
+    ReplayResult r;
+    const Tuning& t = cfg.tuning;
+
+    // --- Per-pair simulation -------------------------------------------
+    QHash<QString, PairState> pairStates;
+    QVector<Entry> legacyGlobalPool;  // mirrors saw/learningHistory; appended every shot, capped at 50
+
+    for (const auto& s : shots) {
+        const QString pairKey = s.profile + QStringLiteral("::") + s.scale;
+        const int pairIdxBefore = pairStates.value(pairKey).totalShots + 1;
+
+        // OLD prediction (always the OLD model, regardless of --variant)
+        const PredictResult oldR = predictWithMode(pairKey, s.scale, s.flow,
+                                                   pairStates, legacyGlobalPool, cfg.mode, t,
+                                                   cfg.warmupThreshold);
+
+        // NEW prediction: same entry set OLD would use, but run through the chosen variant
+        const QVector<Entry> entries = entriesForVariant(pairKey, s.scale,
+                                                          pairStates, legacyGlobalPool, cfg.mode,
+                                                          cfg.warmupThreshold);
+        const bool conv = !entries.isEmpty() && isConvergedEntries(entries);
+        VariantResult newR;
+        if (entries.isEmpty()) {
+            newR.drip = std::min(s.flow * (sensorLag(s.scale) + 0.1), 8.0);
+            newR.source = "lagFallback";
+        } else {
+            newR = predictVariantOnEntries(entries, s.scale, s.flow, cfg.variant, t, conv);
+        }
+
+        const double oldErr = oldR.drip - s.drip;
+        const double newErr = newR.drip - s.drip;
+        const double oldAbs = std::abs(oldErr);
+        const double newAbs = std::abs(newErr);
+
+        if (perShot) {
+            *perShot << s.id << "\t" << pairIdxBefore << "\t" << s.flow << "\t" << s.drip << "\t"
+                     << oldR.drip << "\t" << newR.drip << "\t"
+                     << oldErr << "\t" << newErr << "\t"
+                     << oldR.source << "\t" << flowBucket(s.flow) << "\n";
+        }
+
+        r.overall.add(oldAbs, newAbs);
+        const QString fbk = flowBucket(s.flow);
+        if (fbk == "low") r.low.add(oldAbs, newAbs);
+        else if (fbk == "mid") r.mid.add(oldAbs, newAbs);
+        else r.high.add(oldAbs, newAbs);
+
+        r.withinPair[withinPairBucket(pairIdxBefore)].add(oldAbs, newAbs);
+        r.bySource[oldR.source].add(oldAbs, newAbs);
+
+        if (newR.source == "regression"
+            && (newR.a == 0.0 || newR.a == 5.0 || newR.b == -2.0 || newR.b == 2.0)) {
+            ++r.clampHits;
+        }
+        if (newAbs < oldAbs) ++r.newBeatsOld;
+
+        // Update state for next shot
+        Entry e;
+        e.drip = s.drip;
+        e.flow = s.flow;
+        e.scale = s.scale;
+        e.overshoot = s.overshoot;
+        updatePairState(pairStates, pairKey, e);
+        legacyGlobalPool.append(e);
+        if (legacyGlobalPool.size() > 50) legacyGlobalPool.removeFirst();
+    }
+    return r;
+}
+
+bool loadCorpus(const QString& path, QVector<Shot>& shots) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        qWarning() << "cannot open" << f.fileName();
+        return false;
+    }
+    QJsonParseError err;
+    auto doc = QJsonDocument::fromJson(f.readAll(), &err);
+    if (err.error != QJsonParseError::NoError) {
+        qWarning() << "json parse error:" << err.errorString();
+        return false;
+    }
+    auto shotsArr = doc.object().value("shots").toArray();
+    if (shotsArr.isEmpty()) {
+        qWarning() << "no shots in corpus";
+        return false;
+    }
+    shots.reserve(shotsArr.size());
+    for (const auto& v : shotsArr) {
+        auto o = v.toObject();
+        Shot s;
+        s.id = o.value("id").toInt();
+        s.ts = o.value("ts").toString();
+        s.profile = o.value("profile").toString();
+        s.scale = o.value("scale").toString();
+        s.flow = o.value("flow").toDouble();
+        s.drip = o.value("drip").toDouble();
+        s.overshoot = o.value("overshoot").toDouble();
+        s.livePredicted = o.value("live_predicted").toDouble();
+        shots.append(s);
+    }
+    return true;
+}
+
+// --- Sweep ----------------------------------------------------------------
+// A swept numeric flag: one value ("1.5"), a list ("0.2,0.25,0.3") or an
+// inclusive range ("0.1:3.0:0.05"). Grid search walks every value; random
+// search draws uniformly between lo and hi of a range, or picks from a list.
+struct ParamSpec {
+    QVector<double> values;
+    bool isRange = false;
+    double lo = 0.0;
+    double hi = 0.0;
+};
+
+bool parseParamSpec(const QString& text, ParamSpec& spec) {
+    bool ok = true;
+    if (text.contains(':')) {
+        const QStringList parts = text.split(':');
+        if (parts.size() != 3) return false;
+        bool okLo, okHi, okStep;
+        const double lo = parts[0].toDouble(&okLo);
+        const double hi = parts[1].toDouble(&okHi);
+        const double step = parts[2].toDouble(&okStep);
+        if (!okLo || !okHi || !okStep || step <= 0.0 || hi < lo) return false;
+        spec.isRange = true;
+        spec.lo = lo;
+        spec.hi = hi;
+        // Index-based so 0.1:0.3:0.05 lands on 0.3 rather than drifting past it
+        const int steps = static_cast<int>(std::floor((hi - lo) / step + 1e-9));
+        for (int i = 0; i <= steps; ++i) spec.values.append(lo + i * step);
+        return true;
+    }
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        spec.values.append(part.trimmed().toDouble(&ok));
+        if (!ok) return false;
+    }
+    if (spec.values.isEmpty()) return false;
+    spec.lo = *std::min_element(spec.values.cbegin(), spec.values.cend());
+    spec.hi = *std::max_element(spec.values.cbegin(), spec.values.cend());
+    return true;
+}
+
+double sampleParam(const ParamSpec& spec, QRandomGenerator& rng) {
+    if (spec.isRange) return spec.lo + rng.generateDouble() * (spec.hi - spec.lo);
+    return spec.values[static_cast<qsizetype>(rng.bounded(static_cast<quint32>(spec.values.size())))];
+}
+
+struct SweepResult {
+    ReplayConfig config;
+    ReplayResult result;
+};
+
+// Replays every config over the shared corpus on `jobs` threads. Workers
+// claim the next config from a shared counter, so a thread that drew cheap
+// configs (old) keeps going while another is still in a lowess one; results
+// land in their config's slot, so the output doesn't depend on scheduling.
+QVector<SweepResult> runSweep(const QVector<Shot>& shots, const QVector<ReplayConfig>& configs, int jobs) {
+    QVector<SweepResult> results(configs.size());
+    SweepResult* dest = results.data();  // Detached once here, written per-index by the workers
+    std::atomic<qsizetype> next{0};
+    std::atomic<qsizetype> done{0};
+    const qsizetype total = configs.size();
+
+    auto worker = [&]() {
+        for (qsizetype i = next.fetch_add(1); i < total; i = next.fetch_add(1)) {
+            dest[i].config = configs[i];
+            dest[i].result = replay(shots, configs[i], nullptr);
+            const qsizetype finished = done.fetch_add(1) + 1;
+            if (total >= 100 && finished % (total / 10) == 0)
+                fprintf(stderr, "sweep: %lld/%lld configurations\n",
+                        static_cast<long long>(finished), static_cast<long long>(total));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const int n = static_cast<int>(std::min<qsizetype>(jobs, total));
+    threads.reserve(n);
+    for (int i = 0; i < n; ++i) threads.emplace_back(worker);
+    for (auto& th : threads) th.join();
+    return results;
+}
+
+QJsonObject bucketJson(const Bucket& b) {
+    QJsonObject o;
+    o["n"] = b.n;
+    o["mae"] = b.newMae();
+    o["worst"] = b.newWorst;
+    o["old_mae"] = b.oldMae();
+    return o;
+}
+
+bool writeSweepJson(const QString& path, const QString& corpus, const QString& method,
+                    const ReplayResult& baseline, const QVector<SweepResult>& ranked) {
+    QJsonArray rows;
+    for (qsizetype i = 0; i < ranked.size(); ++i) {
+        const SweepResult& sr = ranked[i];
+        const ReplayResult& r = sr.result;
+        QJsonObject row;
+        row["rank"] = static_cast<int>(i + 1);
+        row["variant"] = sr.config.variant;
+        row["mode"] = sr.config.mode;
+        row["sigma"] = sr.config.tuning.sigma;
+        row["recency_max"] = sr.config.tuning.recencyMax;
+        row["recency_min_converged"] = sr.config.tuning.recencyMinConverged;
+        row["recency_min_unconverged"] = sr.config.tuning.recencyMinUnconverged;
+        row["warmup_threshold"] = sr.config.warmupThreshold;
+        row["overall"] = bucketJson(r.overall);
+        row["low"] = bucketJson(r.low);
+        row["mid"] = bucketJson(r.mid);
+        row["high"] = bucketJson(r.high);
+        row["new_beats_old"] = r.newBeatsOld;
+        row["clamp_hits"] = r.clampHits;
+        rows.append(row);
+    }
+    QJsonObject root;
+    root["corpus"] = corpus;
+    root["method"] = method;
+    root["configurations"] = static_cast<int>(ranked.size());
+    root["baseline"] = bucketJson(baseline.overall);
+    root["results"] = rows;
+
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    f.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+bool writeSweepCsv(const QString& path, const QVector<SweepResult>& ranked) {
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) return false;
+    QTextStream csv(&f);
+    csv.setRealNumberPrecision(6);
+    csv << "rank,variant,mode,sigma,recency_max,recency_min_converged,recency_min_unconverged,"
+           "warmup_threshold,n,mae_overall,mae_low,mae_mid,mae_high,worst_overall,"
+           "old_mae_overall,new_beats_old,clamp_hits\n";
+    for (qsizetype i = 0; i < ranked.size(); ++i) {
+        const ReplayConfig& c = ranked[i].config;
+        const ReplayResult& r = ranked[i].result;
+        csv << (i + 1) << "," << c.variant << "," << c.mode << ","
+            << c.tuning.sigma << "," << c.tuning.recencyMax << ","
+            << c.tuning.recencyMinConverged << "," << c.tuning.recencyMinUnconverged << ","
+            << c.warmupThreshold << "," << r.overall.n << ","
+            << r.overall.newMae() << "," << r.low.newMae() << "," << r.mid.newMae() << ","
+            << r.high.newMae() << "," << r.overall.newWorst << ","
+            << r.overall.oldMae() << "," << r.newBeatsOld << "," << r.clampHits << "\n";
+    }
+    return true;
+}
+
 }  // namespace
 
 int main(int argc, char* argv[])
@@ -491,195 +796,245 @@ int main(int argc, char* argv[])
     QCommandLineOption warmupThreshOpt("warmup-threshold",
         "Min pending-batch entries before warmup fires (default 2).", "value", "2");
     parser.addOption(warmupThreshOpt);
+    QCommandLineOption sweepOpt("sweep",
+        "Parameter sweep: 'grid' or 'random'. Variant/mode take comma lists and the "
+        "numeric flags take lists or lo:hi:step ranges.", "method");
+    parser.addOption(sweepOpt);
+    QCommandLineOption samplesOpt("samples", "Configurations to draw in a random sweep (default 1000).",
+                                  "count", "1000");
+    parser.addOption(samplesOpt);
+    QCommandLineOption seedOpt("seed", "Random sweep seed (default 1).", "value", "1");
+    parser.addOption(seedOpt);
+    QCommandLineOption jobsOpt({"j", "jobs"}, "Sweep worker threads (default: all cores).", "count");
+    parser.addOption(jobsOpt);
+    QCommandLineOption outOpt({"o", "out"},
+        "Sweep results file, ranked by overall MAE; .json or .csv.", "path");
+    parser.addOption(outOpt);
+    QCommandLineOption topOpt("top", "Sweep rows to print (default 20).", "count", "20");
+    parser.addOption(topOpt);
     parser.process(app);
 
     if (!parser.isSet(corpusOpt)) {
         qWarning() << "--corpus <path> is required";
         return 2;
     }
-    const QString variant = parser.value(variantOpt);
-    if (variant != "linear" && variant != "mad" && variant != "lowess" && variant != "old") {
-        qWarning() << "--variant must be linear|mad|lowess|old, got" << variant;
+    if (parser.isSet(sweepOpt)) {
+        const QString method = parser.value(sweepOpt);
+        if (method != "grid" && method != "random") {
+            qWarning() << "--sweep must be grid|random, got" << method;
+            return 2;
+        }
+
+        const QStringList variants = parser.value(variantOpt).split(',', Qt::SkipEmptyParts);
+        for (const QString& v : variants) {
+            if (v != "linear" && v != "mad" && v != "lowess" && v != "old") {
+                qWarning() << "--variant must be linear|mad|lowess|old, got" << v;
+                return 2;
+            }
+        }
+        const QStringList modes = parser.value(modeOpt).split(',', Qt::SkipEmptyParts);
+        for (const QString& m : modes) {
+            if (m != "legacy" && m != "warmup") {
+                qWarning() << "--mode must be legacy|warmup, got" << m;
+                return 2;
+            }
+        }
+        if (variants.isEmpty() || modes.isEmpty()) {
+            qWarning() << "--variant and --mode need at least one value";
+            return 2;
+        }
+
+        ParamSpec sigma, rmax, rminC, rminU, warmup;
+        const std::pair<const QCommandLineOption*, ParamSpec*> specs[] = {
+            {&sigmaOpt, &sigma}, {&rmaxOpt, &rmax}, {&rminCOpt, &rminC},
+            {&rminUOpt, &rminU}, {&warmupThreshOpt, &warmup}};
+        for (const auto& [opt, spec] : specs) {
+            if (!parseParamSpec(parser.value(*opt), *spec)) {
+                qWarning() << "--" + opt->names().constLast()
+                           << "expects a value, a comma list or lo:hi:step, got" << parser.value(*opt);
+                return 2;
+            }
+        }
+        for (double w : warmup.values) {
+            if (w < 2 || w > kBatchSize || w != std::floor(w)) {
+                qWarning() << "--warmup-threshold values must be integers in [2," << kBatchSize << "]";
+                return 2;
+            }
+        }
+        warmup.isRange = false;  // Integer-valued: random search picks, never interpolates
+
+        QVector<ReplayConfig> configs;
+        if (method == "grid") {
+            const qsizetype total = variants.size() * modes.size() * sigma.values.size()
+                * rmax.values.size() * rminC.values.size() * rminU.values.size()
+                * warmup.values.size();
+            if (total > 5'000'000) {
+                qWarning() << "grid has" << total << "configurations; narrow it or use --sweep random";
+                return 2;
+            }
+            configs.reserve(total);
+            for (const QString& v : variants)
+            for (const QString& m : modes)
+            for (double s : sigma.values)
+            for (double rx : rmax.values)
+            for (double rc : rminC.values)
+            for (double ru : rminU.values)
+            for (double w : warmup.values) {
+                ReplayConfig c;
+                c.variant = v;
+                c.mode = m;
+                c.tuning = {s, rx, rc, ru};
+                c.warmupThreshold = static_cast<int>(w);
+                configs.append(c);
+            }
+        } else {
+            const int samples = parser.value(samplesOpt).toInt();
+            if (samples < 1) {
+                qWarning() << "--samples must be positive";
+                return 2;
+            }
+            // Drawn up front on one generator so a seed always names the same set
+            QRandomGenerator rng(parser.value(seedOpt).toUInt());
+            configs.reserve(samples);
+            for (int i = 0; i < samples; ++i) {
+                ReplayConfig c;
+                c.variant = variants[rng.bounded(static_cast<quint32>(variants.size()))];
+                c.mode = modes[rng.bounded(static_cast<quint32>(modes.size()))];
+                c.tuning.sigma = sampleParam(sigma, rng);
+                c.tuning.recencyMax = sampleParam(rmax, rng);
+                c.tuning.recencyMinConverged = sampleParam(rminC, rng);
+                c.tuning.recencyMinUnconverged = sampleParam(rminU, rng);
+                c.warmupThreshold = static_cast<int>(sampleParam(warmup, rng));
+                configs.append(c);
+            }
+        }
+
+        QVector<Shot> shots;
+        if (!loadCorpus(parser.value(corpusOpt), shots)) return 2;
+
+        const int jobs = parser.isSet(jobsOpt) ? parser.value(jobsOpt).toInt()
+                                               : QThread::idealThreadCount();
+        if (jobs < 1) {
+            qWarning() << "--jobs must be positive";
+            return 2;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QVector<SweepResult> results = runSweep(shots, configs, jobs);
+        const ReplayResult baseline = replay(shots, ReplayConfig{}, nullptr);
+
+        // Rank by the candidate's overall MAE; ties keep generation order
+        std::stable_sort(results.begin(), results.end(), [](const SweepResult& a, const SweepResult& b) {
+            return a.result.overall.newMae() < b.result.overall.newMae();
+        });
+
+        if (parser.isSet(outOpt)) {
+            const QString outPath = parser.value(outOpt);
+            const bool ok = outPath.endsWith(".csv", Qt::CaseInsensitive)
+                ? writeSweepCsv(outPath, results)
+                : writeSweepJson(outPath, parser.value(corpusOpt), method, baseline, results);
+            if (!ok) {
+                qWarning() << "cannot write" << outPath;
+                return 2;
+            }
+        }
+
+        QTextStream out(stdout);
+        out.setRealNumberPrecision(4);
+        out.setRealNumberNotation(QTextStream::FixedNotation);
+        const QString tag = parser.value(tagOpt);
+        out << "# tag=" << (tag.isEmpty() ? "(none)" : tag)
+            << " sweep=" << method << " configurations=" << configs.size()
+            << " shots=" << shots.size() << " jobs=" << jobs
+            << " elapsed=" << timer.elapsed() / 1000.0 << "s"
+            << " baseline_mae=" << baseline.overall.newMae() << "\n";
+        out << "rank\tvariant\tmode\tsigma\trmax\trminC\trminU\twarmup\tmae\tlow\tmid\thigh\n";
+        const qsizetype top = std::min<qsizetype>(parser.value(topOpt).toInt(), results.size());
+        for (qsizetype i = 0; i < top; ++i) {
+            const ReplayConfig& c = results[i].config;
+            const ReplayResult& r = results[i].result;
+            out << (i + 1) << "\t" << c.variant << "\t" << c.mode << "\t"
+                << c.tuning.sigma << "\t" << c.tuning.recencyMax << "\t"
+                << c.tuning.recencyMinConverged << "\t" << c.tuning.recencyMinUnconverged << "\t"
+                << c.warmupThreshold << "\t" << r.overall.newMae() << "\t"
+                << r.low.newMae() << "\t" << r.mid.newMae() << "\t" << r.high.newMae() << "\n";
+        }
+        out.flush();
+        return 0;
+    }
+
+    ReplayConfig cfg;
+    cfg.variant = parser.value(variantOpt);
+    if (cfg.variant != "linear" && cfg.variant != "mad" && cfg.variant != "lowess" && cfg.variant != "old") {
+        qWarning() << "--variant must be linear|mad|lowess|old, got" << cfg.variant;
         return 2;
     }
-    const QString mode = parser.value(modeOpt);
-    if (mode != "legacy" && mode != "warmup") {
-        qWarning() << "--mode must be legacy|warmup, got" << mode;
+    cfg.mode = parser.value(modeOpt);
+    if (cfg.mode != "legacy" && cfg.mode != "warmup") {
+        qWarning() << "--mode must be legacy|warmup, got" << cfg.mode;
         return 2;
     }
 
-    Tuning t;
+    Tuning& t = cfg.tuning;
     t.sigma = parser.value(sigmaOpt).toDouble();
     t.recencyMax = parser.value(rmaxOpt).toDouble();
     t.recencyMinConverged = parser.value(rminCOpt).toDouble();
     t.recencyMinUnconverged = parser.value(rminUOpt).toDouble();
     const QString tag = parser.value(tagOpt);
-    const int warmupThreshold = parser.value(warmupThreshOpt).toInt();
-    if (warmupThreshold < 2 || warmupThreshold > kBatchSize) {
-        qWarning() << "--warmup-threshold must be in [2," << kBatchSize << "], got" << warmupThreshold;
+    cfg.warmupThreshold = parser.value(warmupThreshOpt).toInt();
+    if (cfg.warmupThreshold < 2 || cfg.warmupThreshold > kBatchSize) {
+        qWarning() << "--warmup-threshold must be in [2," << kBatchSize << "], got" << cfg.warmupThreshold;
         return 2;
     }
 
     // --- Load corpus ---------------------------------------------------
-    QFile f(parser.value(corpusOpt));
-    if (!f.open(QIODevice::ReadOnly)) {
-        qWarning() << "cannot open" << f.fileName();
-        return 2;
-    }
-    QJsonParseError err;
-    auto doc = QJsonDocument::fromJson(f.readAll(), &err);
-    if (err.error != QJsonParseError::NoError) {
-        qWarning() << "json parse error:" << err.errorString();
-        return 2;
-    }
-    auto shotsArr = doc.object().value("shots").toArray();
-    if (shotsArr.isEmpty()) {
-        qWarning() << "no shots in corpus";
-        return 2;
-    }
     QVector<Shot> shots;
-    shots.reserve(shotsArr.size());
-    for (const auto& v : shotsArr) {
-        auto o = v.toObject();
-        Shot s;
-        s.id = o.value("id").toInt();
-        s.ts = o.value("ts").toString();
-        s.profile = o.value("profile").toString();
-        s.scale = o.value("scale").toString();
-        s.flow = o.value("flow").toDouble();
-        s.drip = o.value("drip").toDouble();
-        s.overshoot = o.value("overshoot").toDouble();
-        s.livePredicted = o.value("live_predicted").toDouble();
-        shots.append(s);
-    }
+    if (!loadCorpus(parser.value(corpusOpt), shots)) return 2;
 
     QTextStream out(stdout);
     out.setRealNumberPrecision(4);
     out.setRealNumberNotation(QTextStream::FixedNotation);
 
     out << "# tag=" << (tag.isEmpty() ? "(none)" : tag)
-        << " variant=" << variant << " mode=" << mode
+        << " variant=" << cfg.variant << " mode=" << cfg.mode
         << " sigma=" << t.sigma
         << " recency=" << t.recencyMax << "→[" << t.recencyMinConverged << "/" << t.recencyMinUnconverged << "]"
         << "\n";
     out << "shot_id\tpair_idx\tflow\tactual\told_pred\tnew_pred\told_err\tnew_err\tsource\tbucket\n";
 
-    // --- Aggregate accumulators ----------------------------------------
-    struct Bucket {
-        double oldAbsSum = 0, newAbsSum = 0;
-        double oldWorst = 0, newWorst = 0;
-        int n = 0;
-    };
-    Bucket overall, low, mid, high;
-    QHash<QString, Bucket> withinPair;     // shot1 / shots2-5 / shots6-10 / shots11+
-    QHash<QString, Bucket> bySource;       // perPair / pendingBatch / globalBootstrap / scaleDefault
-
-    auto upd = [&](Bucket& b, double oldAbs, double newAbs) {
-        b.oldAbsSum += oldAbs;
-        b.newAbsSum += newAbs;
-        b.oldWorst = std::max(b.oldWorst, oldAbs);
-        b.newWorst = std::max(b.newWorst, newAbs);
-        b.n += 1;
-    };
-
-    // --- Per-pair simulation -------------------------------------------
-    QHash<QString, PairState> pairStates;
-    QVector<Entry> legacyGlobalPool;  // mirrors saw/learningHistory; appended every shot, capped at 50
-
-    int clampHits = 0;
-    int newBeatsOld = 0;
-
-    for (const auto& s : shots) {
-        const QString pairKey = s.profile + QStringLiteral("::") + s.scale;
-        const int pairIdxBefore = pairStates.value(pairKey).totalShots + 1;
-
-        // OLD prediction (always the OLD model, regardless of --variant)
-        const PredictResult oldR = predictWithMode(pairKey, s.scale, s.flow,
-                                                   pairStates, legacyGlobalPool, mode, t,
-                                                   warmupThreshold);
-
-        // NEW prediction: same entry set OLD would use, but run through the chosen variant
-        const QVector<Entry> entries = entriesForVariant(pairKey, s.scale,
-                                                          pairStates, legacyGlobalPool, mode,
-                                                          warmupThreshold);
-        const bool conv = !entries.isEmpty() && isConvergedEntries(entries);
-        VariantResult newR;
-        if (entries.isEmpty()) {
-            newR.drip = std::min(s.flow * (sensorLag(s.scale) + 0.1), 8.0);
-            newR.source = "lagFallback";
-        } else {
-            newR = predictVariantOnEntries(entries, s.scale, s.flow, variant, t, conv);
-        }
-
-        const double oldErr = oldR.drip - s.drip;
-        const double newErr = newR.drip - s.drip;
-        const double oldAbs = std::abs(oldErr);
-        const double newAbs = std::abs(newErr);
-
-        out << s.id << "\t" << pairIdxBefore << "\t" << s.flow << "\t" << s.drip << "\t"
-            << oldR.drip << "\t" << newR.drip << "\t"
-            << oldErr << "\t" << newErr << "\t"
-            << oldR.source << "\t" << flowBucket(s.flow) << "\n";
-
-        upd(overall, oldAbs, newAbs);
-        const QString fbk = flowBucket(s.flow);
-        if (fbk == "low") upd(low, oldAbs, newAbs);
-        else if (fbk == "mid") upd(mid, oldAbs, newAbs);
-        else upd(high, oldAbs, newAbs);
-
-        upd(withinPair[withinPairBucket(pairIdxBefore)], oldAbs, newAbs);
-        upd(bySource[oldR.source], oldAbs, newAbs);
-
-        if (newR.source == "regression"
-            && (newR.a == 0.0 || newR.a == 5.0 || newR.b == -2.0 || newR.b == 2.0)) {
-            ++clampHits;
-        }
-        if (newAbs < oldAbs) ++newBeatsOld;
-
-        // Update state for next shot
-        Entry e;
-        e.drip = s.drip;
-        e.flow = s.flow;
-        e.scale = s.scale;
-        e.overshoot = s.overshoot;
-        updatePairState(pairStates, pairKey, e);
-        legacyGlobalPool.append(e);
-        if (legacyGlobalPool.size() > 50) legacyGlobalPool.removeFirst();
-    }
-
-    auto maeOld = [](const Bucket& b) { return b.n ? b.oldAbsSum / b.n : 0.0; };
-    auto maeNew = [](const Bucket& b) { return b.n ? b.newAbsSum / b.n : 0.0; };
+    const ReplayResult r = replay(shots, cfg, &out);
 
     out << "\n=== Aggregate by flow bucket ===\n";
     out << "bucket\tn\told_mae\tnew_mae\told_worst\tnew_worst\tdelta_mae\n";
     auto row = [&](const QString& name, const Bucket& b) {
-        out << name << "\t" << b.n << "\t" << maeOld(b) << "\t" << maeNew(b)
+        out << name << "\t" << b.n << "\t" << b.oldMae() << "\t" << b.newMae()
             << "\t" << b.oldWorst << "\t" << b.newWorst
-            << "\t" << (maeNew(b) - maeOld(b)) << "\n";
+            << "\t" << (b.newMae() - b.oldMae()) << "\n";
     };
-    row("overall", overall);
-    row("low (<1.5)", low);
-    row("mid [1.5,3)", mid);
-    row("high (>=3)", high);
+    row("overall", r.overall);
+    row("low (<1.5)", r.low);
+    row("mid [1.5,3)", r.mid);
+    row("high (>=3)", r.high);
 
     out << "\n=== Aggregate by within-pair shot index ===\n";
     out << "bucket\tn\told_mae\tnew_mae\n";
     for (const auto& key : {QStringLiteral("shot1"), QStringLiteral("shots2-5"),
                             QStringLiteral("shots6-10"), QStringLiteral("shots11+")}) {
-        const Bucket& b = withinPair[key];
-        out << key << "\t" << b.n << "\t" << maeOld(b) << "\t" << maeNew(b) << "\n";
+        const Bucket& b = r.withinPair[key];
+        out << key << "\t" << b.n << "\t" << b.oldMae() << "\t" << b.newMae() << "\n";
     }
 
     out << "\n=== Aggregate by source (selected by --mode) ===\n";
     out << "source\tn\told_mae\n";
     for (const auto& key : {QStringLiteral("perPair"), QStringLiteral("pendingBatch"),
                             QStringLiteral("globalBootstrap"), QStringLiteral("scaleDefault")}) {
-        const Bucket& b = bySource[key];
-        out << key << "\t" << b.n << "\t" << maeOld(b) << "\n";
+        const Bucket& b = r.bySource[key];
+        out << key << "\t" << b.n << "\t" << b.oldMae() << "\n";
     }
 
-    out << "\nclamp_hits=" << clampHits << " of " << overall.n
-        << " | shots_where_new_beats_old=" << newBeatsOld << " of " << overall.n << "\n";
+    out << "\nclamp_hits=" << r.clampHits << " of " << r.overall.n
+        << " | shots_where_new_beats_old=" << r.newBeatsOld << " of " << r.overall.n << "\n";
     out.flush();
     return 0;
 }